@@ -170,4 +170,47 @@ if(NOT MSVC)
   endif()
 endif()
 
+# Optionally rebuild selected kernel files tuned for specific server
+# microarchitectures. The ISA level decides which instructions a kernel may
+# use, but the scheduling model (L2 size, port layout) stays the generic one;
+# for the GEMM-adjacent kernels below an -mtune rebuild of the highest ISA
+# level is measurably faster on the matching part. The tuned copies compile
+# with the same capability flags plus -mtune and -DCPU_UARCH=<uarch>;
+# DispatchStub registers them in a side table and prefers them when the
+# running CPU model matches (csrc/cpu/dyndisp/DispatchStub.cpp).
+if(IPEX_ENABLE_UARCH_TUNING AND NOT MSVC)
+  set(UARCH_TUNE_KRNL_NAMES "GroupNormKrnl.cpp")
+  set(UARCH_NAMES "spr" "gnr")
+  set(UARCH_TUNE_FLAGS "-mtune=sapphirerapids" "-mtune=graniterapids")
+  list(LENGTH CPU_CAPABILITY_NAMES NUM_ALL_CAPABILITY_NAMES)
+  if(NUM_ALL_CAPABILITY_NAMES GREATER 1)
+    # The highest ISA level found comes right after DEFAULT.
+    list(GET CPU_CAPABILITY_NAMES 1 UARCH_BASE_CAPABILITY)
+    list(GET CPU_CAPABILITY_FLAGS 1 UARCH_BASE_FLAGS)
+    list(LENGTH UARCH_NAMES NUM_UARCH_NAMES)
+    math(EXPR NUM_UARCH_NAMES "${NUM_UARCH_NAMES}-1")
+    foreach(i RANGE ${NUM_UARCH_NAMES})
+      list(GET UARCH_NAMES ${i} UARCH)
+      list(GET UARCH_TUNE_FLAGS ${i} UARCH_TUNE_FLAG)
+      check_cxx_compiler_flag("${UARCH_TUNE_FLAG}" COMPILER_SUPPORTS_MTUNE_${UARCH})
+      if(NOT COMPILER_SUPPORTS_MTUNE_${UARCH})
+        message(STATUS "WARNING! The compiler does not support ${UARCH_TUNE_FLAG}, skipping the ${UARCH} tuned kernels.")
+        continue()
+      endif()
+      foreach(IMPL ${cpu_kernel_cpp_in})
+        get_filename_component(IMPL_NAME "${IMPL}" NAME)
+        if(NOT ("${IMPL_NAME}" IN_LIST UARCH_TUNE_KRNL_NAMES))
+          continue()
+        endif()
+        file(RELATIVE_PATH NAME "${IPEX_ROOT_DIR}/csrc/" "${IMPL}")
+        set(NEW_IMPL ${CMAKE_BINARY_DIR}/isa_codegen/${NAME}.${UARCH_BASE_CAPABILITY}.${UARCH}.cpp)
+        configure_file("${IPEX_ROOT_DIR}/cmake/cpu/IncludeSource.cpp.in" ${NEW_IMPL})
+        set(cpu_kernel_cpp ${NEW_IMPL} ${cpu_kernel_cpp})
+        set(EXTRA_FLAGS "-DCPU_CAPABILITY=${UARCH_BASE_CAPABILITY} -DCPU_CAPABILITY_${UARCH_BASE_CAPABILITY} -DCPU_UARCH=${UARCH}")
+        set_source_files_properties(${NEW_IMPL} PROPERTIES COMPILE_FLAGS "${UARCH_BASE_FLAGS} ${UARCH_TUNE_FLAG} ${EXTRA_FLAGS}")
+      endforeach()
+    endforeach()
+  endif()
+endif(IPEX_ENABLE_UARCH_TUNING AND NOT MSVC)
+
 list(APPEND IPEX_CPU_CPP_ISA_SRCS_GEN ${cpu_kernel_cpp})
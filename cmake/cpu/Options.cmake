@@ -9,6 +9,7 @@ include(CMakeDependentOption)
 
 option(BUILD_LIBXSMM_VIA_CMAKE "Build LIBXSMM via CMake" ON)
 option(USE_LIBXSMM "Enable LIBXSMM" ON)
+option(IPEX_ENABLE_UARCH_TUNING "Build -mtune microarchitecture variants of selected kernels" OFF)
 if(WIN32)
   set(USE_LIBXSMM ON)
 endif()
@@ -49,6 +50,7 @@ function (print_cpu_config_summary)
     message(STATUS "  IPEX_DISP_OP          : ${IPEX_DISP_OP}")
     message(STATUS "  BUILD_XSMM_VIA_CMAKE  : ${BUILD_LIBXSMM_VIA_CMAKE}")
     message(STATUS "  USE_LIBXSMM           : ${USE_LIBXSMM}")
+    message(STATUS "  IPEX_UARCH_TUNING     : ${IPEX_ENABLE_UARCH_TUNING}")
     message(STATUS "")
     message(STATUS "********************************")
 endfunction()
@@ -95,10 +95,10 @@ std::tuple<at::Tensor, at::Tensor, at::Tensor> batch_norm_forward(
     return std::make_tuple(output, running_mean, running_var);
   } else {
     return std::make_tuple(
-        mkldnn_to_dense(new_with_itensor_mkldnn(
+        dense_view_from_itensor(
             std::move(y),
             c10::optTypeMetaToScalarType(input.options().dtype_opt()),
-            input.options().device_opt())),
+            input.options().device_opt()),
         running_mean,
         running_var);
   }
@@ -160,11 +160,11 @@ std::tuple<at::Tensor, at::Tensor, at::Tensor> batch_norm_backward(
         grad_input_mask[2] ? grad_bias : at::Tensor());
   } else {
     return std::make_tuple(
-        grad_input_mask[0] ? mkldnn_to_dense(new_with_itensor_mkldnn(
+        grad_input_mask[0] ? dense_view_from_itensor(
                                  std::move(gradx),
                                  c10::optTypeMetaToScalarType(
                                      grad_output.options().dtype_opt()),
-                                 grad_output.options().device_opt()))
+                                 grad_output.options().device_opt())
                            : at::Tensor(),
         grad_input_mask[1] ? grad_weight : at::Tensor(),
         grad_input_mask[2] ? grad_bias : at::Tensor());
@@ -0,0 +1,49 @@
+#include "BatchNormAddRelu.h"
+
+#include <torch/csrc/autograd/function.h>
+
+namespace torch_ipex {
+namespace cpu {
+
+IPEX_DEFINE_DISPATCH(bn_add_relu_kernel_stub);
+
+/**
+ * This kernel fuses BN + (optional add) + ReLU into a single scale-shift
+ * pass over the activations. The frozen-statistics and dtype/memory
+ * format conditions are checked on the graph rewrite operation before
+ * calling this kernel; the residual shape check happens in the kernel,
+ * which falls back to the composed aten ops when it does not hold.
+ **/
+at::Tensor BatchNormAddRelu(
+    const at::Tensor& input,
+    const at::Tensor& bn_scale,
+    const at::Tensor& bn_beta,
+    const c10::optional<at::Tensor>& add_input,
+    const c10::optional<at::Tensor>& bn_weight,
+    const c10::optional<at::Tensor>& bn_bias,
+    const c10::optional<at::Tensor>& bn_mean,
+    const c10::optional<at::Tensor>& bn_var,
+    bool bn_training,
+    double bn_momentum,
+    double bn_eps,
+    bool bn_cudnn_enabled) {
+  RECORD_FUNCTION("ipex::batch_norm_add_relu", c10::ArrayRef<c10::IValue>({}));
+
+  return bn_add_relu_kernel_stub(
+      kCPU,
+      input,
+      bn_scale,
+      bn_beta,
+      add_input,
+      bn_weight,
+      bn_bias,
+      bn_mean,
+      bn_var,
+      bn_training,
+      bn_momentum,
+      bn_eps,
+      bn_cudnn_enabled);
+}
+
+} // namespace cpu
+} // namespace torch_ipex
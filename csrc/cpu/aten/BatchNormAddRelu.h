@@ -0,0 +1,63 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/Tensor.h>
+#include <dyndisp/DispatchStub.h>
+
+namespace torch_ipex {
+namespace cpu {
+
+/**
+ * This operator fuses the inference-time BatchNorm + (optional residual
+ * add) + ReLU chain into a single per-channel scale-shift pass. The
+ * scale/beta constants are precomputed by the graph rewrite from the
+ * frozen running statistics, so only the activations are read once.
+ * */
+at::Tensor BatchNormAddRelu(
+    const at::Tensor& input,
+    const at::Tensor& bn_scale,
+    const at::Tensor& bn_beta,
+    const c10::optional<at::Tensor>& add_input,
+    const c10::optional<at::Tensor>& bn_weight,
+    const c10::optional<at::Tensor>& bn_bias,
+    const c10::optional<at::Tensor>& bn_mean,
+    const c10::optional<at::Tensor>& bn_var,
+    bool bn_training,
+    double bn_momentum,
+    double bn_eps,
+    bool bn_cudnn_enabled);
+
+namespace {
+
+at::Tensor bn_add_relu_kernel_impl(
+    const at::Tensor& input,
+    const at::Tensor& bn_scale,
+    const at::Tensor& bn_beta,
+    const c10::optional<at::Tensor>& add_input,
+    const c10::optional<at::Tensor>& bn_weight,
+    const c10::optional<at::Tensor>& bn_bias,
+    const c10::optional<at::Tensor>& bn_mean,
+    const c10::optional<at::Tensor>& bn_var,
+    bool bn_training,
+    double bn_momentum,
+    double bn_eps,
+    bool bn_cudnn_enabled);
+}
+
+using bn_add_relu_kernel_fn = at::Tensor (*)(
+    const at::Tensor&,
+    const at::Tensor&,
+    const at::Tensor&,
+    const c10::optional<at::Tensor>&,
+    const c10::optional<at::Tensor>&,
+    const c10::optional<at::Tensor>&,
+    const c10::optional<at::Tensor>&,
+    const c10::optional<at::Tensor>&,
+    bool,
+    double,
+    double,
+    bool);
+IPEX_DECLARE_DISPATCH(bn_add_relu_kernel_fn, bn_add_relu_kernel_stub);
+
+} // namespace cpu
+} // namespace torch_ipex
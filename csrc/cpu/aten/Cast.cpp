@@ -1,4 +1,5 @@
 #include <ATen/Parallel.h>
+#include "Cast.h"
 #include "csrc/utils/CustomOperatorRegistration.h"
 #include "fp8_utils.h"
 
@@ -7,6 +8,16 @@ namespace cpu {
 
 using namespace torch_ipex::cpu;
 
+IPEX_DEFINE_DISPATCH(cast_convert_kernel_stub);
+
+at::Tensor dil_cast_convert(const at::Tensor& input, at::ScalarType dtype) {
+  RECORD_FUNCTION("dil_cast_convert", c10::ArrayRef<c10::IValue>({}));
+  if (input.scalar_type() == dtype) {
+    return input.clone();
+  }
+  return cast_convert_kernel_stub(kCPU, input, dtype);
+}
+
 at::ScalarType convert_to_dtype(int64_t format) {
   switch (format) {
     case Float8Format::kFloat8_E5M2:
@@ -177,6 +188,8 @@ IPEX_LIBRARY_FRAGMENT() {
       "cast_to_fp8", torch_ipex::cpu::cast_to_fp8, c10::DispatchKey::CPU);
   IPEX_OP_IPEX_REGISTER_DISPATCH(
       "cast_from_fp8", torch_ipex::cpu::cast_from_fp8, c10::DispatchKey::CPU);
+  IPEX_OP_IPEX_REGISTER_DISPATCH(
+      "cast_convert", torch_ipex::cpu::dil_cast_convert, c10::DispatchKey::CPU);
 }
 
 } // namespace
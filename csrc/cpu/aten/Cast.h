@@ -0,0 +1,34 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <dyndisp/DispatchStub.h>
+
+namespace torch_ipex {
+namespace cpu {
+
+/**
+ * Parallel dtype conversion between float and the 16-bit float formats
+ * (bfloat16, float16). The generic at::Tensor::to copy goes through the
+ * serial-ish TensorIterator cast loops and writes through the cache;
+ * this op converts with the vectorized cvt helpers on all threads and
+ * switches to non-temporal stores once the destination exceeds the LLC,
+ * so bulk conversions (checkpoint load, export) neither serialize nor
+ * evict the working set. Unsupported dtype pairs and non-contiguous
+ * inputs fall back to at::Tensor::to with identical semantics
+ * (round-to-nearest-even, copy always materialized).
+ * */
+at::Tensor dil_cast_convert(const at::Tensor& input, at::ScalarType dtype);
+
+namespace {
+
+at::Tensor cast_convert_kernel_impl(
+    const at::Tensor& input,
+    at::ScalarType dtype);
+} // namespace
+
+using cast_convert_kernel_fn =
+    at::Tensor (*)(const at::Tensor&, at::ScalarType);
+IPEX_DECLARE_DISPATCH(cast_convert_kernel_fn, cast_convert_kernel_stub);
+
+} // namespace cpu
+} // namespace torch_ipex
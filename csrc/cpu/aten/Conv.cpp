@@ -174,7 +174,7 @@ at::Tensor convolution_forward_impl(
 
   return reinterpret_cast<IpexConvolutionOpContext*>(
              op_context.data_ptr<int64_t>()[0])
-      ->run(input, ideep::attr_t(torch_ipex::fpmath_mode));
+      ->run(input, ideep::attr_t(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::CONV)));
 }
 
 at::Tensor convolution_backward_input(
@@ -222,16 +222,15 @@ at::Tensor convolution_backward_input(
       padding.vec(),
       padding.vec(),
       groups,
-      ideep::attr_t(torch_ipex::fpmath_mode));
+      ideep::attr_t(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::CONV)));
 
   if (is_channels_last_contiguous) {
     return grad_input;
   } else {
-    return mkldnn_to_dense(new_with_itensor_mkldnn(
-                               std::move(mkldnn_grad_input),
-                               c10::optTypeMetaToScalarType(
-                                   grad_output.options().dtype_opt()),
-                               grad_output.options().device_opt()))
+    return dense_view_from_itensor(
+               std::move(mkldnn_grad_input),
+               c10::optTypeMetaToScalarType(grad_output.options().dtype_opt()),
+               grad_output.options().device_opt())
         .contiguous(memory_format);
   }
 }
@@ -287,7 +286,7 @@ std::tuple<at::Tensor, at::Tensor> convolution_backward_weights(
         padding.vec(),
         padding.vec(),
         groups,
-        ideep::attr_t(torch_ipex::fpmath_mode));
+        ideep::attr_t(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::CONV)));
   } else {
     ideep::convolution_backward_weights::compute(
         mkldnn_input,
@@ -299,7 +298,7 @@ std::tuple<at::Tensor, at::Tensor> convolution_backward_weights(
         padding.vec(),
         padding.vec(),
         groups,
-        ideep::attr_t(torch_ipex::fpmath_mode));
+        ideep::attr_t(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::CONV)));
   }
   return std::make_tuple(grad_weight, grad_bias);
 }
@@ -142,11 +142,10 @@ at::Tensor conv_transpose_kernel_impl(
   }
 
   if (!is_channels_last) {
-    return mkldnn_to_dense(
-               new_with_itensor_mkldnn(
-                   std::move(y),
-                   c10::optTypeMetaToScalarType(input.options().dtype_opt()),
-                   input.options().device_opt()))
+    return dense_view_from_itensor(
+               std::move(y),
+               c10::optTypeMetaToScalarType(input.options().dtype_opt()),
+               input.options().device_opt())
         .contiguous(memory_format);
   } else {
     return output;
@@ -340,11 +339,10 @@ at::Tensor conv_transpose_backward_input(
       groups);
 
   if (!is_channels_last) {
-    return mkldnn_to_dense(new_with_itensor_mkldnn(
-                               std::move(grad_x),
-                               c10::optTypeMetaToScalarType(
-                                   grad_output.options().dtype_opt()),
-                               grad_output.options().device_opt()))
+    return dense_view_from_itensor(
+               std::move(grad_x),
+               c10::optTypeMetaToScalarType(grad_output.options().dtype_opt()),
+               grad_output.options().device_opt())
         .contiguous(memory_format);
   } else {
     return grad_input;
@@ -0,0 +1,84 @@
+#include "DropoutAddLayerNorm.h"
+
+#include <torch/csrc/autograd/function.h>
+
+namespace torch_ipex {
+namespace cpu {
+
+IPEX_DEFINE_DISPATCH(dropout_add_layer_norm_fwd_kernel_stub);
+IPEX_DEFINE_DISPATCH(dropout_add_layer_norm_bwd_kernel_stub);
+
+std::tuple<at::Tensor, at::Tensor, at::Tensor, at::Tensor, at::Tensor>
+dil_dropout_add_layernorm(
+    const at::Tensor& a,
+    const at::Tensor& b,
+    double p,
+    at::IntArrayRef normalized_shape,
+    const c10::optional<at::Tensor>& weight_opt,
+    const c10::optional<at::Tensor>& bias_opt,
+    double eps) {
+  RECORD_FUNCTION(
+      "dil_dropout_add_layernorm", c10::ArrayRef<c10::IValue>({}));
+  TORCH_CHECK(
+      p >= 0 && p < 1, "dropout probability has to be in [0, 1), but got ", p);
+  TORCH_CHECK(
+      a.sizes().equals(b.sizes()),
+      "dropout_add_layernorm expects a and b of the same shape, but got ",
+      a.sizes(),
+      " and ",
+      b.sizes());
+
+  return dropout_add_layer_norm_fwd_kernel_stub(
+      kCPU, a, b, p, normalized_shape, weight_opt, bias_opt, eps);
+}
+
+std::tuple<at::Tensor, at::Tensor, at::Tensor, at::Tensor>
+dil_dropout_add_layernorm_backward(
+    const at::Tensor& grad_out,
+    const at::Tensor& dropout_add_out,
+    const at::Tensor& mask,
+    const at::Tensor& mean,
+    const at::Tensor& rstd,
+    double p,
+    at::IntArrayRef normalized_shape,
+    const c10::optional<at::Tensor>& weight_opt) {
+  RECORD_FUNCTION(
+      "dil_dropout_add_layernorm_backward", c10::ArrayRef<c10::IValue>({}));
+
+  return dropout_add_layer_norm_bwd_kernel_stub(
+      kCPU,
+      grad_out,
+      dropout_add_out,
+      mask,
+      mean,
+      rstd,
+      p,
+      normalized_shape,
+      weight_opt);
+}
+
+} // namespace cpu
+} // namespace torch_ipex
+
+namespace {
+
+TORCH_LIBRARY_FRAGMENT(torch_ipex, m) {
+  m.def(
+      "dropout_add_layernorm(Tensor a, Tensor b, float p, int[] "
+      "normalized_shape, Tensor? weight, Tensor? bias, float eps) -> "
+      "(Tensor, Tensor, Tensor, Tensor, Tensor)");
+  m.impl(
+      "dropout_add_layernorm",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::dil_dropout_add_layernorm);
+  m.def(
+      "dropout_add_layernorm_backward(Tensor grad_out, Tensor "
+      "dropout_add_out, Tensor mask, Tensor mean, Tensor rstd, float p, "
+      "int[] normalized_shape, Tensor? weight) -> "
+      "(Tensor, Tensor, Tensor, Tensor)");
+  m.impl(
+      "dropout_add_layernorm_backward",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::dil_dropout_add_layernorm_backward);
+}
+} // namespace
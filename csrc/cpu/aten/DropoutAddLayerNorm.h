@@ -0,0 +1,97 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <dyndisp/DispatchStub.h>
+
+namespace torch_ipex {
+namespace cpu {
+
+/**
+ * Fused dropout + residual add + layernorm for eager-mode training:
+ *   y = layernorm(dropout(a, p) + b, normalized_shape, weight, bias, eps)
+ * The forward keeps the dropout mask bit-packed (uint8, 8 elements per
+ * byte) instead of materializing an RNG tensor, and the backward fuses
+ * the mask apply into the layernorm input-gradient pass.
+ *
+ * Returns (y, dropout_add_out, mask, mean, rstd); the last four feed the
+ * backward.
+ * */
+std::tuple<at::Tensor, at::Tensor, at::Tensor, at::Tensor, at::Tensor>
+dil_dropout_add_layernorm(
+    const at::Tensor& a,
+    const at::Tensor& b,
+    double p,
+    at::IntArrayRef normalized_shape,
+    const c10::optional<at::Tensor>& weight_opt,
+    const c10::optional<at::Tensor>& bias_opt,
+    double eps);
+
+/**
+ * Backward of dil_dropout_add_layernorm. Returns
+ * (grad_a, grad_b, grad_weight, grad_bias); the parameter gradients are
+ * undefined tensors when weight is not given.
+ * */
+std::tuple<at::Tensor, at::Tensor, at::Tensor, at::Tensor>
+dil_dropout_add_layernorm_backward(
+    const at::Tensor& grad_out,
+    const at::Tensor& dropout_add_out,
+    const at::Tensor& mask,
+    const at::Tensor& mean,
+    const at::Tensor& rstd,
+    double p,
+    at::IntArrayRef normalized_shape,
+    const c10::optional<at::Tensor>& weight_opt);
+
+namespace {
+
+std::tuple<at::Tensor, at::Tensor, at::Tensor, at::Tensor, at::Tensor>
+dropout_add_layer_norm_fwd_kernel_impl(
+    const at::Tensor& a,
+    const at::Tensor& b,
+    double p,
+    at::IntArrayRef normalized_shape,
+    const c10::optional<at::Tensor>& weight_opt,
+    const c10::optional<at::Tensor>& bias_opt,
+    float eps);
+
+std::tuple<at::Tensor, at::Tensor, at::Tensor, at::Tensor>
+dropout_add_layer_norm_bwd_kernel_impl(
+    const at::Tensor& grad_out,
+    const at::Tensor& dropout_add_out,
+    const at::Tensor& mask,
+    const at::Tensor& mean,
+    const at::Tensor& rstd,
+    double p,
+    at::IntArrayRef normalized_shape,
+    const c10::optional<at::Tensor>& weight_opt);
+} // namespace
+
+using dropout_add_layer_norm_fwd_kernel_fn =
+    std::tuple<at::Tensor, at::Tensor, at::Tensor, at::Tensor, at::Tensor> (*)(
+        const at::Tensor&,
+        const at::Tensor&,
+        double,
+        at::IntArrayRef,
+        const c10::optional<at::Tensor>&,
+        const c10::optional<at::Tensor>&,
+        float);
+IPEX_DECLARE_DISPATCH(
+    dropout_add_layer_norm_fwd_kernel_fn,
+    dropout_add_layer_norm_fwd_kernel_stub);
+
+using dropout_add_layer_norm_bwd_kernel_fn =
+    std::tuple<at::Tensor, at::Tensor, at::Tensor, at::Tensor> (*)(
+        const at::Tensor&,
+        const at::Tensor&,
+        const at::Tensor&,
+        const at::Tensor&,
+        const at::Tensor&,
+        double,
+        at::IntArrayRef,
+        const c10::optional<at::Tensor>&);
+IPEX_DECLARE_DISPATCH(
+    dropout_add_layer_norm_bwd_kernel_fn,
+    dropout_add_layer_norm_bwd_kernel_stub);
+
+} // namespace cpu
+} // namespace torch_ipex
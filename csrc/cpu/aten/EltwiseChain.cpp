@@ -0,0 +1,25 @@
+#include "EltwiseChain.h"
+
+#include <torch/csrc/autograd/function.h>
+
+namespace torch_ipex {
+namespace cpu {
+
+IPEX_DEFINE_DISPATCH(eltwise_chain_kernel_stub);
+
+at::Tensor dil_eltwise_chain(
+    const at::Tensor& input,
+    at::IntArrayRef ops,
+    at::ArrayRef<double> alphas) {
+  RECORD_FUNCTION("ipex::eltwise_chain", c10::ArrayRef<c10::IValue>({}));
+  TORCH_CHECK(
+      ops.size() == alphas.size(),
+      "eltwise_chain: ops and alphas must have the same length");
+  if (ops.empty()) {
+    return input.clone();
+  }
+  return eltwise_chain_kernel_stub(kCPU, input, ops, alphas);
+}
+
+} // namespace cpu
+} // namespace torch_ipex
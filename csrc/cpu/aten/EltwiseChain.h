@@ -0,0 +1,57 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <dyndisp/DispatchStub.h>
+
+namespace torch_ipex {
+namespace cpu {
+
+/**
+ * A tiny chain "compiler" for eltwise sequences: a run of unary and
+ * binary-with-constant ops (mul by 2.0 -> sigmoid -> add 1.0, ...) is
+ * encoded as parallel opcode/constant lists and executed in a single
+ * vectorized pass over the tensor, keeping every intermediate in a
+ * vector register instead of materializing one tensor per op. The
+ * chains are harvested from eligible graph regions by
+ * FuseEltwiseChains in graph_rewrite.cpp.
+ * */
+
+// Opcodes for the chain steps. The constant operand (alpha) is only
+// read by the binary-with-constant steps; unary steps ignore it.
+enum class EltwiseChainOp : int64_t {
+  kRelu = 0,
+  kSigmoid = 1,
+  kTanh = 2,
+  kExp = 3,
+  kLog = 4,
+  kSqrt = 5,
+  kAbs = 6,
+  kNeg = 7,
+  kSquare = 8,
+  kAddScalar = 9,
+  kMulScalar = 10,
+  kClampMin = 11,
+  kClampMax = 12,
+};
+
+at::Tensor dil_eltwise_chain(
+    const at::Tensor& input,
+    at::IntArrayRef ops,
+    at::ArrayRef<double> alphas);
+
+namespace {
+
+at::Tensor eltwise_chain_kernel_impl(
+    const at::Tensor& input,
+    at::IntArrayRef ops,
+    at::ArrayRef<double> alphas);
+} // namespace
+
+using eltwise_chain_kernel_fn = at::Tensor (*)(
+    const at::Tensor&,
+    at::IntArrayRef,
+    at::ArrayRef<double>);
+IPEX_DECLARE_DISPATCH(eltwise_chain_kernel_fn, eltwise_chain_kernel_stub);
+
+} // namespace cpu
+} // namespace torch_ipex
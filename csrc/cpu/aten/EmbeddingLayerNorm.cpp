@@ -0,0 +1,77 @@
+#include "EmbeddingLayerNorm.h"
+
+#include <torch/csrc/autograd/function.h>
+
+namespace torch_ipex {
+namespace cpu {
+
+IPEX_DEFINE_DISPATCH(embedding_layernorm_kernel_stub);
+
+at::Tensor dil_embedding_layernorm_dropout(
+    const at::Tensor& indices,
+    const at::Tensor& word_weight,
+    const at::Tensor& position_weight,
+    const c10::optional<at::Tensor>& token_type_weight,
+    const c10::optional<at::Tensor>& position_ids,
+    const c10::optional<at::Tensor>& token_type_ids,
+    const c10::optional<at::Tensor>& weight_opt,
+    const c10::optional<at::Tensor>& bias_opt,
+    double eps,
+    double p,
+    bool training) {
+  RECORD_FUNCTION(
+      "dil_embedding_layernorm_dropout", c10::ArrayRef<c10::IValue>({}));
+  TORCH_CHECK(
+      p >= 0 && p < 1, "dropout probability has to be in [0, 1), but got ", p);
+  TORCH_CHECK(
+      word_weight.dim() == 2 && position_weight.dim() == 2,
+      "embedding_layernorm_dropout expects 2-D embedding weights");
+  TORCH_CHECK(
+      position_weight.size(1) == word_weight.size(1),
+      "embedding_layernorm_dropout expects embedding weights of the same "
+      "width, but got ",
+      word_weight.size(1),
+      " and ",
+      position_weight.size(1));
+  if (token_type_weight.has_value() && token_type_weight.value().defined()) {
+    TORCH_CHECK(
+        token_type_weight.value().dim() == 2 &&
+            token_type_weight.value().size(1) == word_weight.size(1),
+        "embedding_layernorm_dropout expects embedding weights of the same "
+        "width");
+  }
+
+  auto output = embedding_layernorm_kernel_stub(
+      kCPU,
+      indices,
+      word_weight,
+      position_weight,
+      token_type_weight,
+      position_ids,
+      token_type_ids,
+      weight_opt,
+      bias_opt,
+      eps);
+  if (training && p > 0) {
+    return at::dropout(output, p, /*train*/ true);
+  }
+  return output;
+}
+
+} // namespace cpu
+} // namespace torch_ipex
+
+namespace {
+
+TORCH_LIBRARY_FRAGMENT(torch_ipex, m) {
+  m.def(
+      "embedding_layernorm_dropout(Tensor indices, Tensor word_weight, "
+      "Tensor position_weight, Tensor? token_type_weight, "
+      "Tensor? position_ids, Tensor? token_type_ids, Tensor? weight, "
+      "Tensor? bias, float eps, float p, bool training) -> Tensor");
+  m.impl(
+      "embedding_layernorm_dropout",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::dil_embedding_layernorm_dropout);
+}
+} // namespace
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <dyndisp/DispatchStub.h>
+
+namespace torch_ipex {
+namespace cpu {
+
+/**
+ * Fused transformer embedding stack for inference:
+ *   y = dropout(layernorm(word[indices] + position[position_ids] +
+ *                         token_type[token_type_ids],
+ *                         weight, bias, eps), p)
+ * The token/position/segment gathers, the adds and the layernorm run in
+ * one pass over each row instead of materializing three gathered tensors
+ * and two sums. `token_type_weight` is optional for models without
+ * segment embeddings; when `position_ids`/`token_type_ids` are not given
+ * they default to the sequence offset and to segment zero respectively.
+ * Dropout is folded away in inference; with `training=true` a regular
+ * at::dropout is applied on the fused result.
+ *
+ * This is the general aten-level counterpart of the packed
+ * fused_embedding_layernorm_dropout_fwd_unpad op from the bundled TPP
+ * BERT path, so TorchScript rewrites can use it for any transformer.
+ * */
+at::Tensor dil_embedding_layernorm_dropout(
+    const at::Tensor& indices,
+    const at::Tensor& word_weight,
+    const at::Tensor& position_weight,
+    const c10::optional<at::Tensor>& token_type_weight,
+    const c10::optional<at::Tensor>& position_ids,
+    const c10::optional<at::Tensor>& token_type_ids,
+    const c10::optional<at::Tensor>& weight_opt,
+    const c10::optional<at::Tensor>& bias_opt,
+    double eps,
+    double p,
+    bool training);
+
+namespace {
+
+at::Tensor embedding_layernorm_kernel_impl(
+    const at::Tensor& indices,
+    const at::Tensor& word_weight,
+    const at::Tensor& position_weight,
+    const c10::optional<at::Tensor>& token_type_weight,
+    const c10::optional<at::Tensor>& position_ids,
+    const c10::optional<at::Tensor>& token_type_ids,
+    const c10::optional<at::Tensor>& weight_opt,
+    const c10::optional<at::Tensor>& bias_opt,
+    float eps);
+} // namespace
+
+using embedding_layernorm_kernel_fn = at::Tensor (*)(
+    const at::Tensor&,
+    const at::Tensor&,
+    const at::Tensor&,
+    const c10::optional<at::Tensor>&,
+    const c10::optional<at::Tensor>&,
+    const c10::optional<at::Tensor>&,
+    const c10::optional<at::Tensor>&,
+    const c10::optional<at::Tensor>&,
+    float);
+IPEX_DECLARE_DISPATCH(
+    embedding_layernorm_kernel_fn,
+    embedding_layernorm_kernel_stub);
+
+} // namespace cpu
+} // namespace torch_ipex
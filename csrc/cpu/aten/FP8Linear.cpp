@@ -6,6 +6,16 @@ namespace torch_ipex {
 namespace cpu {
 
 using namespace torch_ipex::cpu;
+
+// Epilogues fused into the FP8 matmul primitive. oneDNN applies the
+// src/weight scales before bias and post-ops, so the epilogue operates on
+// correctly scaled values and no separate pass over the output is needed.
+enum class Fp8Epilogue {
+  none,
+  gelu,
+  silu_mul,
+};
+
 at::Tensor fp8_linear_impl(
     at::Tensor inp_fp8,
     at::Tensor scale_invA,
@@ -14,6 +24,8 @@ at::Tensor fp8_linear_impl(
     at::Tensor bias,
     at::Tensor scale_invB,
     int64_t idxB,
+    Fp8Epilogue epilogue,
+    const at::Tensor& mul_input,
     at::Tensor& out) {
   RECORD_FUNCTION("fp8_linear_impl", c10::ArrayRef<c10::IValue>({}));
 
@@ -85,6 +97,28 @@ at::Tensor fp8_linear_impl(
     op_attr.set_scales_mask(DNNL_ARG_WEIGHTS, 0);
   }
 
+  // mul_reshaped must outlive the primitive execution: mul_arg only views
+  // its storage.
+  at::Tensor mul_reshaped;
+  ideep::tensor mul_arg;
+  if (epilogue != Fp8Epilogue::none) {
+    ideep::post_ops po;
+    if (epilogue == Fp8Epilogue::gelu) {
+      po.append_eltwise(dnnl::algorithm::eltwise_gelu_erf, 0.f, 0.f);
+    } else {
+      TORCH_CHECK(
+          mul_input.defined(),
+          "fp8_linear: silu_mul epilogue requires a mul input");
+      mul_reshaped = mul_input.to(out_reshaped.scalar_type())
+                         .contiguous()
+                         .reshape({M, N});
+      mul_arg = torch_ipex::cpu::itensor_view_from_dense(mul_reshaped);
+      po.append_eltwise(dnnl::algorithm::eltwise_swish, 1.f, 0.f);
+      po.append_binary(dnnl::algorithm::binary_mul, mul_arg.get_desc());
+    }
+    op_attr.set_post_ops(po);
+  }
+
   op_attr.set_scratchpad_mode(dnnl::scratchpad_mode::user);
   auto engine = ideep::engine::cpu_engine();
   // TODO: Remove this try/catch when oneDNN provides API to notify
@@ -121,6 +155,11 @@ at::Tensor fp8_linear_impl(
     args.insert({DNNL_ARG_ATTR_SCALES | DNNL_ARG_SRC, src_scales_t});
   }
   args.insert({DNNL_ARG_ATTR_SCALES | DNNL_ARG_WEIGHTS, wei_scales_t});
+  if (epilogue == Fp8Epilogue::silu_mul) {
+    // the binary mul is the second post-op, after the swish eltwise
+    args.insert(
+        {DNNL_ARG_ATTR_MULTIPLE_POST_OP(1) | DNNL_ARG_SRC_1, mul_arg});
+  }
 
   primitive.execute(ideep::stream::default_stream(), args);
 
@@ -142,10 +181,68 @@ at::Tensor fp8_linear(
     at::Tensor bias,
     at::Tensor& out) {
   at::Tensor res = fp8_linear_impl(
-      inp_fp8, scale_invA, idxA, weight_fp8, bias, scale_invB, idxB, out);
+      inp_fp8,
+      scale_invA,
+      idxA,
+      weight_fp8,
+      bias,
+      scale_invB,
+      idxB,
+      Fp8Epilogue::none,
+      at::Tensor(),
+      out);
   return res;
 }
 
+at::Tensor fp8_linear_gelu(
+    at::Tensor inp_fp8,
+    at::Tensor scale_invA,
+    int64_t idxA,
+    int64_t Atype,
+    at::Tensor weight_fp8,
+    at::Tensor scale_invB,
+    int64_t idxB,
+    int64_t Btype,
+    at::Tensor bias,
+    at::Tensor& out) {
+  return fp8_linear_impl(
+      inp_fp8,
+      scale_invA,
+      idxA,
+      weight_fp8,
+      bias,
+      scale_invB,
+      idxB,
+      Fp8Epilogue::gelu,
+      at::Tensor(),
+      out);
+}
+
+at::Tensor fp8_linear_silu_mul(
+    at::Tensor inp_fp8,
+    at::Tensor scale_invA,
+    int64_t idxA,
+    int64_t Atype,
+    at::Tensor weight_fp8,
+    at::Tensor scale_invB,
+    int64_t idxB,
+    int64_t Btype,
+    at::Tensor bias,
+    at::Tensor mul_input,
+    at::Tensor& out) {
+  return fp8_linear_impl(
+      inp_fp8,
+      scale_invA,
+      idxA,
+      weight_fp8,
+      bias,
+      scale_invB,
+      idxB,
+      Fp8Epilogue::silu_mul,
+      mul_input,
+      out);
+}
+
 } // namespace cpu
 } // namespace torch_ipex
 
@@ -154,6 +251,12 @@ namespace {
 IPEX_LIBRARY_FRAGMENT() {
   IPEX_OP_IPEX_REGISTER_DISPATCH(
       "fp8_linear", torch_ipex::cpu::fp8_linear, c10::DispatchKey::CPU);
+  IPEX_OP_IPEX_REGISTER_DISPATCH(
+      "fp8_linear_gelu", torch_ipex::cpu::fp8_linear_gelu, c10::DispatchKey::CPU);
+  IPEX_OP_IPEX_REGISTER_DISPATCH(
+      "fp8_linear_silu_mul",
+      torch_ipex::cpu::fp8_linear_silu_mul,
+      c10::DispatchKey::CPU);
 }
 
 } // namespace
@@ -6,6 +6,8 @@ namespace torch_ipex {
 namespace cpu {
 
 IPEX_DEFINE_DISPATCH(flash_attention_kernel_stub);
+IPEX_DEFINE_DISPATCH(flash_attention_varlen_kernel_stub);
+IPEX_DEFINE_DISPATCH(flash_attention_sliding_window_kernel_stub);
 
 /*
  *Caculate the flash attention SDPA with attention mask.
@@ -22,6 +24,112 @@ std::tuple<at::Tensor, at::Tensor> flash_attention_forward_cpu(
       kCPU, query, key, value, dropout_p, is_causal, attention_mask, scale);
 }
 
+/*
+ *Caculate the flash attention SDPA with a causal sliding window
+ *(Mistral-style); key blocks outside the window are skipped entirely.
+ */
+std::tuple<at::Tensor, at::Tensor> flash_attention_sliding_window_forward_cpu(
+    const at::Tensor& query,
+    const at::Tensor& key,
+    const at::Tensor& value,
+    double dropout_p,
+    bool is_causal,
+    const c10::optional<at::Tensor>& attention_mask,
+    c10::optional<double> scale,
+    int64_t window_size) {
+  return flash_attention_sliding_window_kernel_stub(
+      kCPU,
+      query,
+      key,
+      value,
+      dropout_p,
+      is_causal,
+      attention_mask,
+      scale,
+      window_size);
+}
+
+/*
+ *Caculate flash attention over variable-length sequences packed without
+ *padding: Q/K/V are [total_tokens, num_head, head_size] and cu_seqlens_q/k
+ *hold the [batch + 1] cumulative offsets, mirroring flash-attn's varlen
+ *API. Only real tokens flow through the kernel, so mixed-length batches
+ *do not pay for padding.
+ */
+at::Tensor varlen_attention_forward_cpu(
+    const at::Tensor& query,
+    const at::Tensor& key,
+    const at::Tensor& value,
+    const at::Tensor& cu_seqlens_q,
+    const at::Tensor& cu_seqlens_k,
+    int64_t max_seqlen_q,
+    int64_t max_seqlen_k,
+    bool is_causal,
+    c10::optional<double> scale) {
+  return flash_attention_varlen_kernel_stub(
+      kCPU,
+      query,
+      key,
+      value,
+      cu_seqlens_q,
+      cu_seqlens_k,
+      max_seqlen_q,
+      max_seqlen_k,
+      is_causal,
+      scale);
+}
+
+/*
+ *Strip the padded positions of a [batch, seqlen, ...] tensor, keeping only
+ *the tokens whose attention_mask entry is non-zero, packed back to back.
+ *Returns the packed tensor, the flat kept-token indices (for pad_input),
+ *the [batch + 1] cu_seqlens offsets and the longest sequence length.
+ */
+std::tuple<at::Tensor, at::Tensor, at::Tensor, int64_t> unpad_input(
+    const at::Tensor& input,
+    const at::Tensor& attention_mask) {
+  TORCH_CHECK(
+      input.dim() >= 2,
+      "IPEX unpad_input: input should be [batch, seqlen, ...]");
+  TORCH_CHECK(
+      attention_mask.dim() == 2 &&
+          attention_mask.size(0) == input.size(0) &&
+          attention_mask.size(1) == input.size(1),
+      "IPEX unpad_input: attention_mask should be [batch, seqlen]");
+  auto mask = attention_mask.to(at::kBool);
+  auto seqlens = mask.sum(-1).to(at::kInt);
+  auto indices = mask.flatten().nonzero().flatten();
+  auto packed = input.flatten(0, 1).index_select(0, indices);
+  auto cu_seqlens =
+      at::constant_pad_nd(at::cumsum(seqlens, 0, at::kInt), {1, 0});
+  int64_t max_seqlen =
+      seqlens.numel() > 0 ? seqlens.max().item<int64_t>() : 0;
+  return std::make_tuple(
+      std::move(packed), std::move(indices), std::move(cu_seqlens), max_seqlen);
+}
+
+/*
+ *Inverse of unpad_input: scatter the packed tokens back to the padded
+ *[batch, seqlen, ...] layout, filling padded positions with zero.
+ */
+at::Tensor pad_input(
+    const at::Tensor& packed,
+    const at::Tensor& indices,
+    int64_t batch,
+    int64_t seqlen) {
+  TORCH_CHECK(
+      packed.dim() >= 1 && packed.size(0) == indices.numel(),
+      "IPEX pad_input: packed and indices disagree on the token count");
+  auto flat_sizes = packed.sizes().vec();
+  flat_sizes[0] = batch * seqlen;
+  auto out = at::zeros(flat_sizes, packed.options());
+  out.index_copy_(0, indices, packed);
+  std::vector<int64_t> out_sizes{batch, seqlen};
+  out_sizes.insert(
+      out_sizes.end(), flat_sizes.begin() + 1, flat_sizes.end());
+  return out.reshape(out_sizes);
+}
+
 /*
  *Substitude the flash attention SDPA in PT.
  *In order to add optimizations which are hard to upstream, like TPP layout
@@ -43,6 +151,32 @@ TORCH_LIBRARY_FRAGMENT(torch_ipex, m) {
       "flash_attention",
       c10::DispatchKey::CPU,
       torch_ipex::cpu::flash_attention_forward_cpu);
+  m.def(
+      "flash_attention_sliding_window(Tensor query, Tensor key, Tensor value, \
+       float dropout_p=0.0, bool is_causal=True, \
+       *, Tensor? attention_mask=None, float? scale=None, \
+       int window_size=-1) -> (Tensor, Tensor)");
+  m.impl(
+      "flash_attention_sliding_window",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::flash_attention_sliding_window_forward_cpu);
+  m.def(
+      "varlen_attention(Tensor query, Tensor key, Tensor value, \
+       Tensor cu_seqlens_q, Tensor cu_seqlens_k, \
+       int max_seqlen_q, int max_seqlen_k, \
+       bool is_causal=True, *, float? scale=None) -> Tensor");
+  m.impl(
+      "varlen_attention",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::varlen_attention_forward_cpu);
+  m.def(
+      "unpad_input(Tensor input, Tensor attention_mask) -> \
+       (Tensor, Tensor, Tensor, int)");
+  m.impl("unpad_input", c10::DispatchKey::CPU, torch_ipex::cpu::unpad_input);
+  m.def(
+      "pad_input(Tensor packed, Tensor indices, int batch, int seqlen) -> \
+       Tensor");
+  m.impl("pad_input", c10::DispatchKey::CPU, torch_ipex::cpu::pad_input);
 }
 
 } // namespace cpu
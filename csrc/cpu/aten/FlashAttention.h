@@ -27,7 +27,38 @@ using flash_attention_kernel_fn = std::tuple<at::Tensor, at::Tensor> (*)(
     c10::optional<at::Tensor> attention_mask,
     c10::optional<double> scale);
 
+// Variable-length (unpadded) attention: Q/K/V hold only the real tokens
+// of every sequence back to back, with cu_seqlens_* marking the
+// per-sequence boundaries like flash-attn's varlen API.
+using flash_attention_varlen_kernel_fn = at::Tensor (*)(
+    const at::Tensor& query,
+    const at::Tensor& key,
+    const at::Tensor& value,
+    const at::Tensor& cu_seqlens_q,
+    const at::Tensor& cu_seqlens_k,
+    int64_t max_seqlen_q,
+    int64_t max_seqlen_k,
+    bool is_causal,
+    c10::optional<double> scale);
+
+using flash_attention_sliding_window_kernel_fn =
+    std::tuple<at::Tensor, at::Tensor> (*)(
+        const at::Tensor& query,
+        const at::Tensor& key,
+        const at::Tensor& value,
+        double dropout_p,
+        bool is_causal,
+        c10::optional<at::Tensor> attention_mask,
+        c10::optional<double> scale,
+        int64_t window_size);
+
 IPEX_DECLARE_DISPATCH(flash_attention_kernel_fn, flash_attention_kernel_stub);
+IPEX_DECLARE_DISPATCH(
+    flash_attention_varlen_kernel_fn,
+    flash_attention_varlen_kernel_stub);
+IPEX_DECLARE_DISPATCH(
+    flash_attention_sliding_window_kernel_fn,
+    flash_attention_sliding_window_kernel_stub);
 
 } // namespace cpu
 } // namespace torch_ipex
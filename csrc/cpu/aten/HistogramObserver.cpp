@@ -0,0 +1,53 @@
+#include "HistogramObserver.h"
+
+#include <torch/csrc/autograd/function.h>
+
+namespace torch_ipex {
+namespace cpu {
+
+IPEX_DEFINE_DISPATCH(histogram_observe_kernel_stub);
+
+std::tuple<double, double> histogram_observe(
+    const at::Tensor& input,
+    at::Tensor& histogram,
+    double hist_min,
+    double hist_max) {
+  RECORD_FUNCTION("ipex::histogram_observe", c10::ArrayRef<c10::IValue>({}));
+  TORCH_CHECK(
+      input.scalar_type() == at::kFloat ||
+          input.scalar_type() == at::kBFloat16,
+      "histogram_observe: expect float or bfloat16 input, got ",
+      input.scalar_type());
+  TORCH_CHECK(
+      histogram.scalar_type() == at::kLong && histogram.dim() == 1 &&
+          histogram.is_contiguous(),
+      "histogram_observe: expect a contiguous 1-d int64 histogram tensor");
+  TORCH_CHECK(
+      histogram.numel() > 0, "histogram_observe: histogram must not be empty");
+  TORCH_CHECK(
+      hist_max > hist_min,
+      "histogram_observe: expect hist_max > hist_min, got [",
+      hist_min,
+      ", ",
+      hist_max,
+      ")");
+  return histogram_observe_kernel_stub(
+      kCPU, input, histogram, hist_min, hist_max);
+}
+
+} // namespace cpu
+} // namespace torch_ipex
+
+namespace {
+
+TORCH_LIBRARY_FRAGMENT(torch_ipex, m) {
+  m.def(
+      "histogram_observe(Tensor input, Tensor(a!) histogram, "
+      "float hist_min, float hist_max) -> (float, float)");
+  m.impl(
+      "histogram_observe",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::histogram_observe);
+}
+
+} // namespace
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <dyndisp/DispatchStub.h>
+
+namespace torch_ipex {
+namespace cpu {
+
+/**
+ * Streaming calibration observer for INT8 quantization: one vectorized
+ * parallel pass over the activation tensor computes its min/max and
+ * accumulates a fixed-range histogram into `histogram` (int64 counts,
+ * one element per bin). Values outside [hist_min, hist_max) are clamped
+ * into the edge bins so the counts always total input.numel(); the
+ * Python observer reads the returned true min/max back to grow its
+ * range and rebuild the histogram when needed. Replaces the
+ * tensor-at-a-time Python histogram observers whose throughput
+ * dominates calibration runs.
+ * */
+
+std::tuple<double, double> histogram_observe(
+    const at::Tensor& input,
+    at::Tensor& histogram,
+    double hist_min,
+    double hist_max);
+
+namespace {
+
+std::tuple<double, double> histogram_observe_kernel_impl(
+    const at::Tensor& input,
+    at::Tensor& histogram,
+    double hist_min,
+    double hist_max);
+} // namespace
+
+using histogram_observe_kernel_fn = std::tuple<double, double> (*)(
+    const at::Tensor&,
+    at::Tensor&,
+    double,
+    double);
+IPEX_DECLARE_DISPATCH(
+    histogram_observe_kernel_fn,
+    histogram_observe_kernel_stub);
+
+} // namespace cpu
+} // namespace torch_ipex
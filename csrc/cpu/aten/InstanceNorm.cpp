@@ -185,7 +185,8 @@ std::tuple<at::Tensor, at::Tensor, at::Tensor> instance_norm_forward(
         running_mean,
         running_var,
         eps,
-        is_channels_last);
+        is_channels_last,
+        /*apply_relu*/ false);
     if (output_list.empty()) {
       return std::make_tuple(at::Tensor(), at::Tensor(), at::Tensor());
     }
@@ -200,7 +201,8 @@ std::tuple<at::Tensor, at::Tensor, at::Tensor> instance_norm_forward(
       running_mean,
       running_var,
       eps,
-      is_channels_last);
+      is_channels_last,
+      /*apply_relu*/ false);
   if (output_list.empty()) {
     return std::make_tuple(at::Tensor(), at::Tensor(), at::Tensor());
   }
@@ -425,6 +427,63 @@ at::Tensor instance_norm(
   return output;
 }
 
+at::Tensor instance_norm_relu(
+    const at::Tensor& input,
+    const c10::optional<at::Tensor>& weight_opt,
+    const c10::optional<at::Tensor>& bias_opt,
+    const c10::optional<at::Tensor>& running_mean_opt,
+    const c10::optional<at::Tensor>& running_var_opt,
+    bool use_input_stats,
+    double momentum,
+    double eps) {
+#if defined(IPEX_DISP_OP)
+  printf("torch_ipex::instance_norm_relu\n");
+#endif
+  RECORD_FUNCTION(
+      "torch_ipex::instance_norm_relu", c10::ArrayRef<c10::IValue>({}));
+
+  const at::Tensor& weight =
+      c10::value_or_else(weight_opt, [] { return at::Tensor(); });
+  const at::Tensor& bias =
+      c10::value_or_else(bias_opt, [] { return at::Tensor(); });
+  const at::Tensor& running_mean =
+      c10::value_or_else(running_mean_opt, [] { return at::Tensor(); });
+  const at::Tensor& running_var =
+      c10::value_or_else(running_var_opt, [] { return at::Tensor(); });
+
+  // The fused kernel does not produce the pre-activation output the
+  // autograd path saves, so it is inference-only.
+  auto isa = get_current_isa_level();
+  if (isa != "AVX2" && !at::GradMode::is_enabled() && input.numel() != 0) {
+    bool is_channels_last =
+        input.suggest_memory_format() == at::MemoryFormat::ChannelsLast ||
+        input.suggest_memory_format() == at::MemoryFormat::ChannelsLast3d;
+    auto output_list = InstanceNormKernel(
+        input.device().type(),
+        input,
+        weight,
+        bias,
+        running_mean,
+        running_var,
+        eps,
+        is_channels_last,
+        /*apply_relu*/ true);
+    if (!output_list.empty()) {
+      return output_list[0];
+    }
+  }
+  return at::relu(instance_norm(
+      input,
+      weight_opt,
+      bias_opt,
+      running_mean_opt,
+      running_var_opt,
+      use_input_stats,
+      momentum,
+      eps,
+      false));
+}
+
 TORCH_LIBRARY_FRAGMENT(torch_ipex, m) {
   m.def(
       "instance_norm_forward(Tensor input, Tensor? weight, Tensor? bias, Tensor? "
@@ -442,6 +501,14 @@ TORCH_LIBRARY_FRAGMENT(torch_ipex, m) {
       "instance_norm_backward",
       c10::DispatchKey::CPU,
       torch_ipex::cpu::instance_norm_backward);
+  m.def(
+      "instance_norm_relu(Tensor input, Tensor? weight, Tensor? bias, Tensor? "
+      "running_mean, Tensor? running_var, bool use_input_stats, float "
+      "momentum, float eps) -> Tensor");
+  m.impl(
+      "instance_norm_relu",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::instance_norm_relu);
 }
 
 // IPEX_TORCH_LIBRARY_IMPL(aten, CPU, m) {
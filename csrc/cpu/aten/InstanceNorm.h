@@ -18,6 +18,22 @@ std::tuple<at::Tensor, at::Tensor, at::Tensor> instance_norm_forward(
     double momentum,
     double eps);
 
+/**
+ * Inference-only InstanceNorm with the ReLU fused into the normalization
+ * sweep, so the activations are read twice (statistics + normalize)
+ * instead of three times. Falls back to the composed ops when the
+ * vectorized kernel is unavailable or gradients are required.
+ * */
+at::Tensor instance_norm_relu(
+    const at::Tensor& input,
+    const c10::optional<at::Tensor>& weight_opt,
+    const c10::optional<at::Tensor>& bias_opt,
+    const c10::optional<at::Tensor>& running_mean_opt,
+    const c10::optional<at::Tensor>& running_var_opt,
+    bool use_input_stats,
+    double momentum,
+    double eps);
+
 std::tuple<at::Tensor, at::Tensor, at::Tensor> instance_norm_backward(
     const at::Tensor& grad_output,
     const at::Tensor& input,
@@ -54,7 +70,8 @@ using instancenorm_forward_fn = std::vector<at::Tensor> (*)(
     const at::Tensor& /* running mean*/,
     const at::Tensor& /* running var*/,
     double eps,
-    bool is_channels_last);
+    bool is_channels_last,
+    bool apply_relu);
 
 using instancenorm_backward_fn = std::vector<at::Tensor> (*)(
     const at::Tensor& /* dY */,
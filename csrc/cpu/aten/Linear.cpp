@@ -140,7 +140,7 @@ std::tuple<at::Tensor, at::Tensor, at::Tensor> linear_backward_kernel(
         packed_weight,
         input_reshaped.sizes().vec(),
         gradx,
-        ideep::attr_t(torch_ipex::fpmath_mode));
+        ideep::attr_t(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::LINEAR)));
     grad_input = input_contiguous.dim() > 2
         ? grad_input_reshaped.reshape(input_contiguous.sizes().vec())
         : grad_input_reshaped;
@@ -160,14 +160,14 @@ std::tuple<at::Tensor, at::Tensor, at::Tensor> linear_backward_kernel(
           gradw,
           gradb,
           diff_weight_type,
-          ideep::attr_t(torch_ipex::fpmath_mode));
+          ideep::attr_t(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::LINEAR)));
     } else {
       ideep::inner_product_backward_weights::compute(
           x,
           grady,
           gradw,
           diff_weight_type,
-          ideep::attr_t(torch_ipex::fpmath_mode));
+          ideep::attr_t(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::LINEAR)));
     }
   }
   return std::make_tuple(grad_input, grad_weight, grad_bias);
@@ -181,7 +181,7 @@ at::Tensor linear_forward(
     const c10::optional<int64_t> out_features) {
   return reinterpret_cast<IpexLinearOpContext*>(
              op_context.data_ptr<int64_t>()[0])
-      ->run(input, ideep::attr_t(torch_ipex::fpmath_mode));
+      ->run(input, ideep::attr_t(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::LINEAR)));
 }
 
 at::Tensor linear_eltwise_forward(
@@ -198,7 +198,7 @@ at::Tensor linear_eltwise_forward(
     attr = ideep::attr_t::fuse_sigmoid();
   return reinterpret_cast<IpexLinearOpContext*>(
              op_context.data_ptr<int64_t>()[0])
-      ->run(input, attr.set_fpmath_mode(torch_ipex::fpmath_mode));
+      ->run(input, attr.set_fpmath_mode(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::LINEAR)));
 }
 
 std::tuple<at::Tensor, at::Tensor, at::Tensor> linear_backward(
@@ -356,6 +356,44 @@ at::Tensor ipex_linear_eltwise(
       input, weight, bias, eltwise, op_context, out_features);
 }
 
+IPEX_DEFINE_DISPATCH(dyn_quant_linear_kernel_stub);
+
+/*
+ * Quantize an fp32 [N, K] weight per output channel to symmetric int8.
+ * Returns the int8 weight, the fp32 per-channel scales and the int32
+ * per-channel column sums the dynamic-quant epilogue needs to
+ * compensate the activation zero point.
+ */
+std::tuple<at::Tensor, at::Tensor, at::Tensor>
+dynamic_quant_linear_prepack_weight(const at::Tensor& weight) {
+  TORCH_CHECK(
+      weight.dim() == 2 && weight.scalar_type() == at::kFloat,
+      "dynamic_quant_linear_prepack_weight: expect a 2-D fp32 weight");
+  auto weight_ = weight.contiguous();
+  auto scales =
+      weight_.abs().amax(1).clamp_min(1e-12).div(127.0).to(at::kFloat);
+  auto qweight = weight_.div(scales.unsqueeze(1))
+                     .round()
+                     .clamp(-127, 127)
+                     .to(at::kChar)
+                     .contiguous();
+  auto comp = qweight.to(at::kInt).sum(1, false, at::kInt);
+  return std::make_tuple(
+      std::move(qweight), std::move(scales), std::move(comp));
+}
+
+at::Tensor dynamic_quant_linear_forward(
+    const at::Tensor& input,
+    const at::Tensor& qweight,
+    const at::Tensor& weight_scales,
+    const at::Tensor& weight_comp,
+    const c10::optional<at::Tensor>& bias) {
+  RECORD_FUNCTION(
+      "torch_ipex::dynamic_quant_linear", c10::ArrayRef<c10::IValue>({}));
+  return dyn_quant_linear_kernel_stub(
+      kCPU, input, qweight, weight_scales, weight_comp, bias);
+}
+
 #ifdef USE_LIBXSMM
 IPEX_DEFINE_DISPATCH(woq_tpp_gemm_packB_stub);
 at::Tensor woq_linear_pack_weight(
@@ -375,7 +413,8 @@ at::Tensor woq_linear_pack_weight(
       block_k /= 2;
     }
     assert(block_k > 0);
-    if (weight_dtype == WOQ_DTYPE_INT4 || weight_dtype == WOQ_DTYPE_NF4) {
+    if (weight_dtype == WOQ_DTYPE_INT4 || weight_dtype == WOQ_DTYPE_NF4 ||
+        weight_dtype == WOQ_DTYPE_FP4) {
       if (block_k % 4 && lowp_mode == 3) {
         // This case is not supported by kernel
         return weight;
@@ -810,6 +849,21 @@ TORCH_LIBRARY_FRAGMENT(torch_ipex, m) {
       c10::DispatchKey::AutocastCPU,
       torch_ipex::autocast::ipex_linear);
   m.impl("ipex_linear", c10::DispatchKey::CPU, torch_ipex::cpu::linear_forward);
+  m.def(
+      "dynamic_quant_linear_prepack(Tensor weight) -> "
+      "(Tensor, Tensor, Tensor)");
+  m.impl(
+      "dynamic_quant_linear_prepack",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::dynamic_quant_linear_prepack_weight);
+  m.def(
+      "dynamic_quant_linear(Tensor input, Tensor qweight, "
+      "Tensor weight_scales, Tensor weight_comp, Tensor? bias=None) -> "
+      "Tensor");
+  m.impl(
+      "dynamic_quant_linear",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::dynamic_quant_linear_forward);
 #ifdef USE_LIBXSMM
   m.def("ipex_woq_linear(Tensor input, Tensor W_prepack) -> Tensor");
   m.impl(
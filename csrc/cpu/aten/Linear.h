@@ -82,6 +82,30 @@ at::Tensor ipex_linear_eltwise(
     const at::Tensor& op_context,
     const c10::optional<int64_t> out_features);
 
+// Dynamic INT8 linear: activations are quantized per row on the fly
+// (asymmetric u8 from a min/max pass), the GEMM runs u8*s8 and the
+// epilogue dequantizes with a zero-point compensation term. The weight
+// is pre-quantized per output channel by
+// dynamic_quant_linear_prepack_weight.
+std::tuple<at::Tensor, at::Tensor, at::Tensor>
+dynamic_quant_linear_prepack_weight(const at::Tensor& weight);
+
+at::Tensor dynamic_quant_linear_forward(
+    const at::Tensor& input,
+    const at::Tensor& qweight,
+    const at::Tensor& weight_scales,
+    const at::Tensor& weight_comp,
+    const c10::optional<at::Tensor>& bias);
+
+using dyn_quant_linear_kernel_fn = at::Tensor (*)(
+    const at::Tensor&,
+    const at::Tensor&,
+    const at::Tensor&,
+    const at::Tensor&,
+    const c10::optional<at::Tensor>&);
+
+IPEX_DECLARE_DISPATCH(dyn_quant_linear_kernel_fn, dyn_quant_linear_kernel_stub);
+
 #ifdef USE_LIBXSMM
 // WOQ linear ops
 at::Tensor woq_linear_pack_weight(
@@ -6,6 +6,7 @@ namespace torch_ipex {
 namespace cpu {
 
 IPEX_DEFINE_DISPATCH(masked_multihead_self_attention_kernel_stub);
+IPEX_DEFINE_DISPATCH(masked_multihead_self_attention_fused_rope_kernel_stub);
 
 /*
  *Caculate the masked multihead attention for decoder layer in decoder only
@@ -54,6 +55,51 @@ masked_multihead_self_attention_forward_cpu(
       add_casual_mask);
 }
 
+/*
+ *Fused variant of masked_multihead_self_attention which applies the rotary
+ *position embedding to the incoming query/key inside the attention kernel,
+ *so the hidden state is not read and written once more by a standalone
+ *rotary embedding pass.
+ *@param rotary_cos cos table [max_positions, rotary_ndims / 2], float
+ *@param rotary_sin sin table [max_positions, rotary_ndims / 2], float
+ *@param rotary_ndims number of leading dims of each head to rotate
+ */
+std::tuple<at::Tensor, at::Tensor, at::Tensor, at::Tensor, at::Tensor>
+masked_multihead_self_attention_fused_rope_forward_cpu(
+    at::Tensor& query,
+    at::Tensor& key,
+    at::Tensor& value,
+    at::Tensor& key_cache,
+    at::Tensor& value_cache,
+    at::Tensor& beam_idx,
+    at::Tensor seq_info,
+    const double scale_attn,
+    int64_t max_positions,
+    const c10::optional<at::Tensor>& head_mask /* optional */,
+    const c10::optional<at::Tensor>& attention_mask /* optional */,
+    c10::optional<bool> add_casual_mask /* optional */,
+    at::Tensor& rotary_cos,
+    at::Tensor& rotary_sin,
+    int64_t rotary_ndims) {
+  return masked_multihead_self_attention_fused_rope_kernel_stub(
+      kCPU,
+      query,
+      key,
+      value,
+      key_cache,
+      value_cache,
+      beam_idx,
+      seq_info,
+      scale_attn,
+      max_positions,
+      head_mask,
+      attention_mask,
+      add_casual_mask,
+      rotary_cos,
+      rotary_sin,
+      rotary_ndims);
+}
+
 } // namespace cpu
 } // namespace torch_ipex
 
@@ -68,5 +114,14 @@ TORCH_LIBRARY_FRAGMENT(torch_ipex, m) {
       "masked_multihead_self_attention",
       c10::DispatchKey::CPU,
       torch_ipex::cpu::masked_multihead_self_attention_forward_cpu);
+  m.def(
+      "masked_multihead_self_attention_fused_rope(Tensor query, Tensor key, Tensor value, Tensor key_cache, \
+       Tensor value_cache, Tensor beam_idx, Tensor seq_info, float scale_attn, int max_positions, \
+       Tensor? head_mask, Tensor? attention_mask, bool? add_casual_mask, Tensor rotary_cos, \
+       Tensor rotary_sin, int rotary_ndims)-> (Tensor, Tensor, Tensor, Tensor, Tensor)");
+  m.impl(
+      "masked_multihead_self_attention_fused_rope",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::masked_multihead_self_attention_fused_rope_forward_cpu);
 }
 } // namespace
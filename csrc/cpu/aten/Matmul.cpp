@@ -200,7 +200,7 @@ at::Tensor matmul_onednn(const at::Tensor& self, const at::Tensor& mat2) {
       mkldnn_output,
       1.0f,
       1.0f,
-      ideep::attr_t(torch_ipex::fpmath_mode));
+      ideep::attr_t(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::MATMUL)));
 
   handle_grad(self, mat2, output);
   return output;
@@ -242,7 +242,7 @@ at::Tensor& matmul_onednn(
       mkldnn_output,
       1.0f,
       1.0f,
-      ideep::attr_t(torch_ipex::fpmath_mode));
+      ideep::attr_t(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::MATMUL)));
   return out;
 }
 
@@ -458,6 +458,51 @@ at::Tensor& matmul_out_cpu(
   return result;
 }
 
+// Executes a group of same-shape matmuls as one strided batch. Each
+// operand pair must multiply to the same output shape; callers (the
+// GroupMatmul JIT pass) guarantee this, the checks below guard direct
+// use of the op. The operands are packed with at::stack - one copy per
+// small matrix - and the whole group runs as a single blocked batched
+// GEMM, which parallelizes over group x batch x blocks instead of
+// leaving most cores idle on each tiny GEMM in turn. The batched matmul
+// dispatches through matmul_cpu above, so the group inherits the oneDNN
+// BF32 path when that mode is active.
+std::vector<at::Tensor> matmul_group_cpu(
+    at::TensorList tensors1,
+    at::TensorList tensors2) {
+  TORCH_CHECK(
+      tensors1.size() == tensors2.size(),
+      "matmul_group: expected the same number of self and mat2 tensors, got ",
+      tensors1.size(),
+      " and ",
+      tensors2.size());
+  if (tensors1.empty()) {
+    return {};
+  }
+  if (tensors1.size() == 1) {
+    return {at::matmul(tensors1[0], tensors2[0])};
+  }
+  const auto& self0 = tensors1[0];
+  const auto& mat20 = tensors2[0];
+  TORCH_CHECK(
+      self0.dim() >= 2,
+      "matmul_group: expected at least 2-D operands, got ",
+      self0.dim(),
+      "-D");
+  for (size_t i = 1; i < tensors1.size(); i++) {
+    TORCH_CHECK(
+        tensors1[i].sizes().equals(self0.sizes()) &&
+            tensors2[i].sizes().equals(mat20.sizes()) &&
+            tensors1[i].scalar_type() == self0.scalar_type() &&
+            tensors2[i].scalar_type() == mat20.scalar_type(),
+        "matmul_group: all operands of a group must have the same sizes and dtype");
+  }
+  auto batch1 = at::stack(tensors1, 0);
+  auto batch2 = at::stack(tensors2, 0);
+  auto output = at::matmul(batch1, batch2);
+  return output.unbind(0);
+}
+
 } // namespace cpu
 } // namespace torch_ipex
 
@@ -472,4 +517,15 @@ IPEX_TORCH_LIBRARY_IMPL(aten, CompositeImplicitAutograd, m) {
       TORCH_FN((&torch_ipex::cpu::matmul_out_cpu)));
 }
 
+TORCH_LIBRARY_FRAGMENT(torch_ipex, m) {
+  m.def(
+      "matmul_group(Tensor[] tensors1, Tensor[] tensors2) -> Tensor[]");
+  // Registered at CompositeImplicitAutograd: the op is built from
+  // stack/matmul/unbind, so gradients flow through it for free.
+  m.impl(
+      "matmul_group",
+      c10::DispatchKey::CompositeImplicitAutograd,
+      torch_ipex::cpu::matmul_group_cpu);
+}
+
 } // namespace
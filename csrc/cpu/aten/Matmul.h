@@ -58,5 +58,8 @@ at::Tensor& matmul_onednn(
     at::Tensor& out,
     const at::Tensor& self,
     const at::Tensor& mat2);
+std::vector<at::Tensor> matmul_group_cpu(
+    at::TensorList tensors1,
+    at::TensorList tensors2);
 } // namespace cpu
 } // namespace torch_ipex
@@ -8,6 +8,7 @@ namespace cpu {
 using namespace at;
 
 IPEX_DEFINE_DISPATCH(merged_embeddingbag_cat_fw_stub);
+IPEX_DEFINE_DISPATCH(merged_embeddingbag_interaction_fw_stub);
 IPEX_DEFINE_DISPATCH(qmerged_embeddingbag_cat_fw_stub);
 
 Tensor merged_embeddingbag_cat_forward(
@@ -19,6 +20,15 @@ Tensor merged_embeddingbag_cat_forward(
       kCPU, weights, indices, offsets, dense);
 }
 
+Tensor merged_embeddingbag_interaction_forward(
+    const TensorList& weights,
+    const TensorList& indices,
+    const TensorList& offsets,
+    const Tensor& dense) {
+  return merged_embeddingbag_interaction_fw_stub(
+      kCPU, weights, indices, offsets, dense);
+}
+
 Tensor dil_qmerged_embeddingbag_cat(
     const TensorList& qweights,
     const TensorList& indices,
@@ -42,6 +52,12 @@ TORCH_LIBRARY_FRAGMENT(torch_ipex, m) {
       "merged_embeddingbag_cat_forward",
       c10::DispatchKey::CPU,
       torch_ipex::cpu::merged_embeddingbag_cat_forward);
+  m.def(
+      "merged_embeddingbag_interaction_forward(Tensor[] weights, Tensor[] indices, Tensor[] offsets, Tensor dense) -> Tensor");
+  m.impl(
+      "merged_embeddingbag_interaction_forward",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::merged_embeddingbag_interaction_forward);
 }
 
 } // namespace
\ No newline at end of file
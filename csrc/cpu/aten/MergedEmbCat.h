@@ -25,6 +25,12 @@ Tensor merged_embedding_cat_fw_impl(
     const TensorList& offsets,
     const Tensor& dense);
 
+Tensor merged_embedding_interaction_fw_impl(
+    const TensorList& weights,
+    const TensorList& indices,
+    const TensorList& offsets,
+    const Tensor& dense);
+
 Tensor qmerged_embedding_cat_fw_impl(
     const TensorList& qweights,
     const TensorList& indices,
@@ -51,6 +57,10 @@ IPEX_DECLARE_DISPATCH(
     merged_embeddingbag_cat_fw_fn,
     merged_embeddingbag_cat_fw_stub);
 
+IPEX_DECLARE_DISPATCH(
+    merged_embeddingbag_cat_fw_fn,
+    merged_embeddingbag_interaction_fw_stub);
+
 IPEX_DECLARE_DISPATCH(
     qmerged_embeddingbag_cat_fw_fn,
     qmerged_embeddingbag_cat_fw_stub);
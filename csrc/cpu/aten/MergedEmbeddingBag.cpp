@@ -8,6 +8,7 @@ namespace torch_ipex {
 namespace cpu {
 
 IPEX_DEFINE_DISPATCH(merged_embeddingbag_forward_cpu_kernel_stub);
+IPEX_DEFINE_DISPATCH(merged_embeddingbag_forward_quantized_cpu_kernel_stub);
 
 std::vector<Tensor> merged_embeddingbag_forward_cpu(
     const std::vector<Tensor>& weights,
@@ -23,6 +24,32 @@ std::vector<Tensor> merged_embeddingbag_forward_cpu(
       kCPU, weights, indices, offsets, pooling_mode, include_last_offsets);
 }
 
+std::vector<Tensor> merged_embeddingbag_forward_quantized_cpu(
+    const std::vector<Tensor>& qweights,
+    const TensorList& scales,
+    const TensorList& indices,
+    const TensorList& offsets,
+    const int64_t emb_dim,
+    const int64_t pooling_mode,
+    const bool include_last_offsets,
+    const c10::optional<at::ScalarType> output_dtype) {
+  /*
+  pointer to merged_embeddingbag_forward_quantized_cpu_kernel_impl(
+      qweights, scales, indices, offsets, emb_dim, pooling_mode,
+      include_last_offsets, output_dtype);
+  */
+  return merged_embeddingbag_forward_quantized_cpu_kernel_stub(
+      kCPU,
+      qweights,
+      scales,
+      indices,
+      offsets,
+      emb_dim,
+      pooling_mode,
+      include_last_offsets,
+      output_dtype);
+}
+
 } // namespace cpu
 } // namespace torch_ipex
 
@@ -64,6 +91,13 @@ TORCH_LIBRARY_FRAGMENT(torch_ipex, m) {
       "merged_embeddingbag_forward",
       c10::DispatchKey::AutocastCPU,
       torch_ipex::autocast::merged_embeddingbag_forward);
+  // quantized weights must not be cast by autocast, so only CPU is bound
+  m.def(
+      "merged_embeddingbag_forward_quantized(Tensor[] qweights, Tensor[] scales, Tensor[] indices, Tensor[] offsets, int emb_dim, int pooling_mode, bool include_last_offsets, ScalarType? output_dtype=None) -> Tensor[]");
+  m.impl(
+      "merged_embeddingbag_forward_quantized",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::merged_embeddingbag_forward_quantized_cpu);
 }
 
 } // namespace
@@ -191,6 +191,16 @@ std::vector<Tensor> merged_embeddingbag_forward_cpu_kernel_impl(
     const int64_t pooling_mode,
     const bool include_last_offsets);
 
+std::vector<Tensor> merged_embeddingbag_forward_quantized_cpu_kernel_impl(
+    const std::vector<Tensor>& qweights,
+    const TensorList& scales,
+    const TensorList& indices,
+    const TensorList& offsets,
+    const int64_t emb_dim,
+    const int64_t pooling_mode,
+    const bool include_last_offsets,
+    const c10::optional<at::ScalarType> output_dtype);
+
 std::vector<Tensor> merged_embeddingbag_backward_cpu_kernel_impl(
     const TensorList& grad_outs_,
     const TensorList& weights,
@@ -271,6 +281,20 @@ IPEX_DECLARE_DISPATCH(
     merged_embeddingbag_forward_cpu_kernel_fn,
     merged_embeddingbag_forward_cpu_kernel_stub);
 
+using merged_embeddingbag_forward_quantized_cpu_kernel_fn =
+    std::vector<Tensor> (*)(
+        const std::vector<Tensor>&,
+        const TensorList&,
+        const TensorList&,
+        const TensorList&,
+        const int64_t,
+        const int64_t,
+        const bool,
+        const c10::optional<at::ScalarType>);
+IPEX_DECLARE_DISPATCH(
+    merged_embeddingbag_forward_quantized_cpu_kernel_fn,
+    merged_embeddingbag_forward_quantized_cpu_kernel_stub);
+
 using merged_embeddingbag_backward_cpu_kernel_fn = std::vector<Tensor> (*)(
     const TensorList&,
     const TensorList&,
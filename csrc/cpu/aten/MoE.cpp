@@ -8,6 +8,10 @@ namespace cpu {
 IPEX_DEFINE_DISPATCH(mixtral_moe_tpp_kernel_stub);
 IPEX_DEFINE_DISPATCH(mixtral_moe_woq_kernel_stub);
 IPEX_DEFINE_DISPATCH(mixtral_moe_kernel_stub);
+IPEX_DEFINE_DISPATCH(mixtral_moe_tpp_ep_kernel_stub);
+IPEX_DEFINE_DISPATCH(mixtral_moe_woq_ep_kernel_stub);
+IPEX_DEFINE_DISPATCH(mixtral_moe_ep_kernel_stub);
+IPEX_DEFINE_DISPATCH(mixtral_moe_woq_batched_kernel_stub);
 
 at::Tensor mixtral_moe_tpp(
     const at::Tensor& hidden_states,
@@ -92,6 +96,137 @@ at::Tensor mixtral_moe_woq(
       routing_weights,
       output);
 }
+
+at::Tensor mixtral_moe_tpp_ep(
+    const at::Tensor& hidden_states,
+    at::TensorList top_x_list,
+    at::TensorList idx_list,
+    at::TensorList gate_wei,
+    at::TensorList up_wei,
+    at::TensorList down_wei,
+    bool tpp_fallback,
+    const at::Tensor& routing_weights,
+    at::Tensor& output) {
+  RECORD_FUNCTION("ipex::mixtral_moe_tpp_ep", c10::ArrayRef<c10::IValue>({}));
+
+  TORCH_CHECK(
+      top_x_list.size() == gate_wei.size() &&
+          idx_list.size() == gate_wei.size() &&
+          up_wei.size() == gate_wei.size() &&
+          down_wei.size() == gate_wei.size(),
+      "mixtral_moe_tpp_ep: expert lists must have the same length");
+  return mixtral_moe_tpp_ep_kernel_stub(
+      kCPU,
+      hidden_states,
+      top_x_list,
+      idx_list,
+      gate_wei,
+      up_wei,
+      down_wei,
+      tpp_fallback,
+      routing_weights,
+      output);
+}
+
+at::Tensor mixtral_moe_ep(
+    const at::Tensor& hidden_states,
+    at::TensorList top_x_list,
+    at::TensorList idx_list,
+    at::TensorList gate_wei,
+    at::TensorList gate_op_ctx,
+    at::TensorList up_wei,
+    at::TensorList up_op_ctx,
+    at::TensorList down_wei,
+    at::TensorList down_op_ctx,
+    bool use_dnnl,
+    const at::Tensor& routing_weights,
+    at::Tensor& output) {
+  RECORD_FUNCTION("ipex::mixtral_moe_ep", c10::ArrayRef<c10::IValue>({}));
+
+  TORCH_CHECK(
+      top_x_list.size() == gate_wei.size() &&
+          idx_list.size() == gate_wei.size() &&
+          gate_op_ctx.size() == gate_wei.size() &&
+          up_wei.size() == gate_wei.size() &&
+          up_op_ctx.size() == gate_wei.size() &&
+          down_wei.size() == gate_wei.size() &&
+          down_op_ctx.size() == gate_wei.size(),
+      "mixtral_moe_ep: expert lists must have the same length");
+  return mixtral_moe_ep_kernel_stub(
+      kCPU,
+      hidden_states,
+      top_x_list,
+      idx_list,
+      gate_wei,
+      gate_op_ctx,
+      up_wei,
+      up_op_ctx,
+      down_wei,
+      down_op_ctx,
+      use_dnnl,
+      routing_weights,
+      output);
+}
+
+at::Tensor mixtral_moe_woq_batched(
+    const at::Tensor& hidden_states,
+    const at::Tensor& top_k_ids,
+    const at::Tensor& routing_weights,
+    at::TensorList gate_wei,
+    at::TensorList up_wei,
+    at::TensorList down_wei,
+    at::Tensor& output) {
+  RECORD_FUNCTION(
+      "ipex::mixtral_moe_woq_batched", c10::ArrayRef<c10::IValue>({}));
+
+  TORCH_CHECK(
+      top_k_ids.dim() == 2 && top_k_ids.sizes() == routing_weights.sizes(),
+      "mixtral_moe_woq_batched: top_k_ids and routing_weights must both be "
+      "[num_tokens, k]");
+  TORCH_CHECK(
+      up_wei.size() == gate_wei.size() && down_wei.size() == gate_wei.size(),
+      "mixtral_moe_woq_batched: expert lists must have the same length");
+  if (top_k_ids.sizes()[0] == 0)
+    return output;
+  return mixtral_moe_woq_batched_kernel_stub(
+      kCPU,
+      hidden_states,
+      top_k_ids,
+      routing_weights,
+      gate_wei,
+      up_wei,
+      down_wei,
+      output);
+}
+
+at::Tensor mixtral_moe_woq_ep(
+    const at::Tensor& hidden_states,
+    at::TensorList top_x_list,
+    at::TensorList idx_list,
+    at::TensorList gate_wei,
+    at::TensorList up_wei,
+    at::TensorList down_wei,
+    const at::Tensor& routing_weights,
+    at::Tensor& output) {
+  RECORD_FUNCTION("ipex::mixtral_moe_woq_ep", c10::ArrayRef<c10::IValue>({}));
+
+  TORCH_CHECK(
+      top_x_list.size() == gate_wei.size() &&
+          idx_list.size() == gate_wei.size() &&
+          up_wei.size() == gate_wei.size() &&
+          down_wei.size() == gate_wei.size(),
+      "mixtral_moe_woq_ep: expert lists must have the same length");
+  return mixtral_moe_woq_ep_kernel_stub(
+      kCPU,
+      hidden_states,
+      top_x_list,
+      idx_list,
+      gate_wei,
+      up_wei,
+      down_wei,
+      routing_weights,
+      output);
+}
 } // namespace cpu
 } // namespace torch_ipex
 
@@ -118,5 +253,36 @@ TORCH_LIBRARY_FRAGMENT(torch_ipex, m) {
       "mixtral_moe_woq",
       c10::DispatchKey::CPU,
       torch_ipex::cpu::mixtral_moe_woq);
+  m.def(
+      "mixtral_moe_tpp_ep(Tensor hidden_states, Tensor[] top_x_list, Tensor[] idx_list, \
+      Tensor[] gate_wei, Tensor[] up_wei, Tensor[] down_wei, bool tpp_fallback, \
+      Tensor routing_weights, Tensor output) -> Tensor");
+  m.impl(
+      "mixtral_moe_tpp_ep",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::mixtral_moe_tpp_ep);
+  m.def(
+      "mixtral_moe_ep(Tensor hidden_states, Tensor[] top_x_list, Tensor[] idx_list, \
+      Tensor[] gate_wei, Tensor[] gate_op_ctx, Tensor[] up_wei, Tensor[] up_op_ctx, \
+      Tensor[] down_wei, Tensor[] down_op_ctx, bool use_dnnl, Tensor routing_weights, \
+      Tensor output) -> Tensor");
+  m.impl(
+      "mixtral_moe_ep", c10::DispatchKey::CPU, torch_ipex::cpu::mixtral_moe_ep);
+  m.def(
+      "mixtral_moe_woq_ep(Tensor hidden_states, Tensor[] top_x_list, Tensor[] idx_list, \
+      Tensor[] gate_wei, Tensor[] up_wei, Tensor[] down_wei, Tensor routing_weights, \
+      Tensor output) -> Tensor");
+  m.impl(
+      "mixtral_moe_woq_ep",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::mixtral_moe_woq_ep);
+  m.def(
+      "mixtral_moe_woq_batched(Tensor hidden_states, Tensor top_k_ids, \
+      Tensor routing_weights, Tensor[] gate_wei, Tensor[] up_wei, Tensor[] down_wei, \
+      Tensor output) -> Tensor");
+  m.impl(
+      "mixtral_moe_woq_batched",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::mixtral_moe_woq_batched);
 }
 } // namespace
\ No newline at end of file
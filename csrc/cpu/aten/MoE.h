@@ -37,6 +37,46 @@ at::Tensor mixtral_moe(
     bool,
     const at::Tensor&,
     at::Tensor&);
+at::Tensor mixtral_moe_tpp_ep(
+    const at::Tensor&,
+    at::TensorList,
+    at::TensorList,
+    at::TensorList,
+    at::TensorList,
+    at::TensorList,
+    bool,
+    const at::Tensor&,
+    at::Tensor&);
+at::Tensor mixtral_moe_woq_batched(
+    const at::Tensor&,
+    const at::Tensor&,
+    const at::Tensor&,
+    at::TensorList,
+    at::TensorList,
+    at::TensorList,
+    at::Tensor&);
+at::Tensor mixtral_moe_woq_ep(
+    const at::Tensor&,
+    at::TensorList,
+    at::TensorList,
+    at::TensorList,
+    at::TensorList,
+    at::TensorList,
+    const at::Tensor&,
+    at::Tensor&);
+at::Tensor mixtral_moe_ep(
+    const at::Tensor&,
+    at::TensorList,
+    at::TensorList,
+    at::TensorList,
+    at::TensorList,
+    at::TensorList,
+    at::TensorList,
+    at::TensorList,
+    at::TensorList,
+    bool,
+    const at::Tensor&,
+    at::Tensor&);
 using mixtral_moe_tpp_kernel_fn = at::Tensor (*)(
     const at::Tensor& hidden_states,
     const at::Tensor& top_x,
@@ -69,8 +109,62 @@ using mixtral_moe_kernel_fn = at::Tensor (*)(
     bool use_dnnl,
     const at::Tensor& routing_weights,
     at::Tensor& output);
+// Batched expert-parallel variants: one entry per expert in the lists, so
+// the kernel can overlap expert GEMMs across core groups.
+using mixtral_moe_tpp_ep_kernel_fn = at::Tensor (*)(
+    const at::Tensor& hidden_states,
+    at::TensorList top_x_list,
+    at::TensorList idx_list,
+    at::TensorList gate_wei,
+    at::TensorList up_wei,
+    at::TensorList down_wei,
+    bool tpp_fallback,
+    const at::Tensor& routing_weights,
+    at::Tensor& output);
+// Token-sorted batched WOQ variant: takes the raw [num_tokens, k] top-k
+// routing and runs one GEMM per expert over a contiguous token slab.
+using mixtral_moe_woq_batched_kernel_fn = at::Tensor (*)(
+    const at::Tensor& hidden_states,
+    const at::Tensor& top_k_ids,
+    const at::Tensor& routing_weights,
+    at::TensorList gate_wei,
+    at::TensorList up_wei,
+    at::TensorList down_wei,
+    at::Tensor& output);
+using mixtral_moe_woq_ep_kernel_fn = at::Tensor (*)(
+    const at::Tensor& hidden_states,
+    at::TensorList top_x_list,
+    at::TensorList idx_list,
+    at::TensorList gate_wei,
+    at::TensorList up_wei,
+    at::TensorList down_wei,
+    const at::Tensor& routing_weights,
+    at::Tensor& output);
+using mixtral_moe_ep_kernel_fn = at::Tensor (*)(
+    const at::Tensor& hidden_states,
+    at::TensorList top_x_list,
+    at::TensorList idx_list,
+    at::TensorList gate_wei,
+    at::TensorList gate_op_ctx,
+    at::TensorList up_wei,
+    at::TensorList up_op_ctx,
+    at::TensorList down_wei,
+    at::TensorList down_op_ctx,
+    bool use_dnnl,
+    const at::Tensor& routing_weights,
+    at::Tensor& output);
 IPEX_DECLARE_DISPATCH(mixtral_moe_tpp_kernel_fn, mixtral_moe_tpp_kernel_stub);
 IPEX_DECLARE_DISPATCH(mixtral_moe_woq_kernel_fn, mixtral_moe_woq_kernel_stub);
 IPEX_DECLARE_DISPATCH(mixtral_moe_kernel_fn, mixtral_moe_kernel_stub);
+IPEX_DECLARE_DISPATCH(
+    mixtral_moe_tpp_ep_kernel_fn,
+    mixtral_moe_tpp_ep_kernel_stub);
+IPEX_DECLARE_DISPATCH(
+    mixtral_moe_woq_ep_kernel_fn,
+    mixtral_moe_woq_ep_kernel_stub);
+IPEX_DECLARE_DISPATCH(mixtral_moe_ep_kernel_fn, mixtral_moe_ep_kernel_stub);
+IPEX_DECLARE_DISPATCH(
+    mixtral_moe_woq_batched_kernel_fn,
+    mixtral_moe_woq_batched_kernel_stub);
 } // namespace cpu
 } // namespace torch_ipex
@@ -1,12 +1,22 @@
 #include "PagedAttention.h"
 #include <torch/all.h>
 #include <torch/csrc/autograd/function.h>
+#include <cstring>
 
 namespace torch_ipex {
 namespace cpu {
 
 IPEX_DEFINE_DISPATCH(single_query_cached_kv_attention_kernel_stub);
+IPEX_DEFINE_DISPATCH(single_query_cached_kv_attention_bias_kernel_stub);
+IPEX_DEFINE_DISPATCH(shared_prefix_cached_kv_attention_kernel_stub);
+IPEX_DEFINE_DISPATCH(single_query_cached_kv_attention_int8_kernel_stub);
+IPEX_DEFINE_DISPATCH(reshape_and_cache_int8_kernel_stub);
+IPEX_DEFINE_DISPATCH(chunked_prefill_cached_kv_attention_kernel_stub);
 IPEX_DEFINE_DISPATCH(reshape_and_cache_kernel_stub);
+IPEX_DEFINE_DISPATCH(single_query_cached_kv_attention_head_blocked_kernel_stub);
+IPEX_DEFINE_DISPATCH(reshape_and_cache_head_blocked_kernel_stub);
+IPEX_DEFINE_DISPATCH(streaming_llm_cache_evict_kernel_stub);
+IPEX_DEFINE_DISPATCH(multi_query_cached_kv_attention_kernel_stub);
 
 /*
  *Caculate the masked multihead attention for decoder layer in decoder only
@@ -38,6 +48,259 @@ void single_query_cached_kv_attention_forward_cpu(
       alibi_slopes);
 }
 
+/*
+ *Decode attention with a learned relative-position bias (T5-style) instead
+ *of alibi slopes. attn_bias is pre-tiled at cache setup as one
+ *[num_heads, max_context_len] fp32 table indexed by the key token's
+ *distance from the current query token, so the kernel streams the same
+ *tile for every sequence and no per-step bias materialization or
+ *unfused fallback is needed.
+ */
+void single_query_cached_kv_attention_bias_forward_cpu(
+    at::Tensor& out, // [num_seqs, num_heads, head_size]
+    at::Tensor& query, // [num_seqs, num_heads, head_size]
+    at::Tensor& key_cache, // [num_blocks,  block_size, num_heads, head_size]
+    at::Tensor& value_cache, // [num_blocks,  block_size, num_heads, head_size]
+    at::Tensor& head_mapping, // [num_heads]
+    const double scale,
+    at::Tensor& block_tables, // [num_seqs, max_num_blocks_per_seq]
+    at::Tensor& context_lens, // [num_seqs]
+    int64_t block_size,
+    int64_t max_context_len,
+    const at::Tensor& attn_bias) { // [num_heads, max_context_len]
+  return single_query_cached_kv_attention_bias_kernel_stub(
+      kCPU,
+      out,
+      query,
+      key_cache,
+      value_cache,
+      head_mapping,
+      scale,
+      block_tables,
+      context_lens,
+      block_size,
+      max_context_len,
+      attn_bias);
+}
+
+/*
+ *Caculate the masked multihead attention for decoder layer when the batch
+ *shares a common prompt prefix; the shared blocks are read once per batch.
+ */
+void shared_prefix_cached_kv_attention_forward_cpu(
+    at::Tensor& out, // [num_seqs, num_heads, head_size]
+    at::Tensor& query, // [num_seqs, num_heads, head_size]
+    at::Tensor& key_cache, // [num_blocks,  block_size, num_heads, head_size]
+    at::Tensor& value_cache, // [num_blocks,  block_size, num_heads, head_size]
+    at::Tensor& head_mapping, // [num_heads]
+    const double scale,
+    at::Tensor& block_tables, // [num_seqs, max_num_blocks_per_seq]
+    at::Tensor& context_lens, // [num_seqs]
+    int64_t block_size,
+    int64_t max_context_len,
+    const c10::optional<at::Tensor>& alibi_slopes,
+    int64_t prefix_len) {
+  return shared_prefix_cached_kv_attention_kernel_stub(
+      kCPU,
+      out,
+      query,
+      key_cache,
+      value_cache,
+      head_mapping,
+      scale,
+      block_tables,
+      context_lens,
+      block_size,
+      max_context_len,
+      alibi_slopes,
+      prefix_len);
+}
+
+/*
+ *Caculate the masked multihead attention for decoder layer against an int8
+ *KV cache; the per token/head scales written by reshape_and_cache_int8 are
+ *applied inside the kernel.
+ */
+void single_query_cached_kv_attention_int8_forward_cpu(
+    at::Tensor& out, // [num_seqs, num_heads, head_size]
+    at::Tensor& query, // [num_seqs, num_heads, head_size]
+    at::Tensor& key_cache, // int8 [num_blocks, block_size, num_heads,
+                           // head_size]
+    at::Tensor& value_cache, // int8 [num_blocks, block_size, num_heads,
+                             // head_size]
+    at::Tensor& head_mapping, // [num_heads]
+    const double scale,
+    at::Tensor& block_tables, // [num_seqs, max_num_blocks_per_seq]
+    at::Tensor& context_lens, // [num_seqs]
+    int64_t block_size,
+    int64_t max_context_len,
+    const c10::optional<at::Tensor>& alibi_slopes,
+    at::Tensor& k_scale, // [num_blocks, block_size, num_heads]
+    at::Tensor& v_scale) { // [num_blocks, block_size, num_heads]
+  return single_query_cached_kv_attention_int8_kernel_stub(
+      kCPU,
+      out,
+      query,
+      key_cache,
+      value_cache,
+      head_mapping,
+      scale,
+      block_tables,
+      context_lens,
+      block_size,
+      max_context_len,
+      alibi_slopes,
+      k_scale,
+      v_scale);
+}
+
+void reshape_and_cache_int8_cpu(
+    at::Tensor& key,
+    at::Tensor& value,
+    at::Tensor& key_cache,
+    at::Tensor& value_cache,
+    at::Tensor& k_scale,
+    at::Tensor& v_scale,
+    at::Tensor& slot_mapping) {
+  return reshape_and_cache_int8_kernel_stub(
+      kCPU,
+      key,
+      value,
+      key_cache,
+      value_cache,
+      k_scale,
+      v_scale,
+      slot_mapping);
+}
+
+/*
+ *Caculate the attention of one prompt chunk over the paged KV cache, so long
+ *prompts can stream in fixed-size chunks interleaved with decode steps.
+ */
+void chunked_prefill_cached_kv_attention_forward_cpu(
+    at::Tensor& out, // [num_tokens, num_heads, head_size]
+    at::Tensor& query, // [num_tokens, num_heads, head_size]
+    at::Tensor& key_cache, // [num_blocks,  block_size, num_heads, head_size]
+    at::Tensor& value_cache, // [num_blocks,  block_size, num_heads, head_size]
+    at::Tensor& head_mapping, // [num_heads]
+    const double scale,
+    at::Tensor& block_tables, // [num_seqs, max_num_blocks_per_seq]
+    at::Tensor& context_lens, // [num_seqs]
+    at::Tensor& query_start_loc, // [num_seqs + 1]
+    int64_t block_size,
+    int64_t max_context_len,
+    const c10::optional<at::Tensor>& alibi_slopes) {
+  return chunked_prefill_cached_kv_attention_kernel_stub(
+      kCPU,
+      out,
+      query,
+      key_cache,
+      value_cache,
+      head_mapping,
+      scale,
+      block_tables,
+      context_lens,
+      query_start_loc,
+      block_size,
+      max_context_len,
+      alibi_slopes);
+}
+
+/*
+ *Decode attention over the head-blocked cache layout negotiated at cache
+ *creation: [num_blocks, num_heads, block_size, head_size] keeps one head's
+ *tokens contiguous so per-head reads stream whole cache lines.
+ */
+void single_query_cached_kv_attention_head_blocked_forward_cpu(
+    at::Tensor& out, // [num_seqs, num_heads, head_size]
+    at::Tensor& query, // [num_seqs, num_heads, head_size]
+    at::Tensor& key_cache, // [num_blocks, num_heads, block_size, head_size]
+    at::Tensor& value_cache, // [num_blocks, num_heads, block_size, head_size]
+    at::Tensor& head_mapping, // [num_heads]
+    const double scale,
+    at::Tensor& block_tables, // [num_seqs, max_num_blocks_per_seq]
+    at::Tensor& context_lens, // [num_seqs]
+    int64_t block_size,
+    int64_t max_context_len,
+    const c10::optional<at::Tensor>& alibi_slopes) {
+  return single_query_cached_kv_attention_head_blocked_kernel_stub(
+      kCPU,
+      out,
+      query,
+      key_cache,
+      value_cache,
+      head_mapping,
+      scale,
+      block_tables,
+      context_lens,
+      block_size,
+      max_context_len,
+      alibi_slopes);
+}
+
+void reshape_and_cache_head_blocked_cpu(
+    at::Tensor& key,
+    at::Tensor& value,
+    at::Tensor& key_cache, // [num_blocks, num_heads, block_size, head_size]
+    at::Tensor& value_cache, // [num_blocks, num_heads, block_size, head_size]
+    at::Tensor& slot_mapping) {
+  return reshape_and_cache_head_blocked_kernel_stub(
+      kCPU, key, value, key_cache, value_cache, slot_mapping);
+}
+
+/*
+ *Verify q_len speculative draft tokens per sequence in one call. The draft
+ *keys/values must already be in the cache (reshape_and_cache) and counted by
+ *context_lens; draft token qi attends positions [0, context_len - q_len +
+ *qi]. Block-table walks and K/V loads are shared across the draft tokens.
+ */
+void multi_query_cached_kv_attention_forward_cpu(
+    at::Tensor& out, // [num_seqs, q_len, num_heads, head_size]
+    at::Tensor& query, // [num_seqs, q_len, num_heads, head_size]
+    at::Tensor& key_cache, // [num_blocks,  block_size, num_heads, head_size]
+    at::Tensor& value_cache, // [num_blocks,  block_size, num_heads, head_size]
+    at::Tensor& head_mapping, // [num_heads]
+    const double scale,
+    at::Tensor& block_tables, // [num_seqs, max_num_blocks_per_seq]
+    at::Tensor& context_lens, // [num_seqs]
+    int64_t block_size,
+    int64_t max_context_len,
+    const c10::optional<at::Tensor>& alibi_slopes) {
+  return multi_query_cached_kv_attention_kernel_stub(
+      kCPU,
+      out,
+      query,
+      key_cache,
+      value_cache,
+      head_mapping,
+      scale,
+      block_tables,
+      context_lens,
+      block_size,
+      max_context_len,
+      alibi_slopes);
+}
+
+/*
+ *StreamingLLM-style eviction for unbounded sessions: per sequence, keep the
+ *first sink_blocks blocks (attention sinks) plus the newest window_blocks
+ *blocks and drop the oldest block in between. Eviction is a block_tables /
+ *context_lens index update only; single_query_cached_kv_attention then reads
+ *the discontiguous positions through the updated table, so no cache data
+ *moves and no re-prefill is needed. The freed physical block ids are
+ *returned ([num_seqs, max_evicted], -1 padded) so the block manager can
+ *recycle them.
+ */
+at::Tensor streaming_llm_cache_evict_forward_cpu(
+    at::Tensor& block_tables, // [num_seqs, max_num_blocks_per_seq]
+    at::Tensor& context_lens, // [num_seqs]
+    int64_t block_size,
+    int64_t sink_blocks,
+    int64_t window_blocks) {
+  return streaming_llm_cache_evict_kernel_stub(
+      kCPU, block_tables, context_lens, block_size, sink_blocks, window_blocks);
+}
+
 void reshape_and_cache_cpu(
     at::Tensor& key,
     at::Tensor& value,
@@ -48,6 +311,128 @@ void reshape_and_cache_cpu(
       kCPU, key, value, key_cache, value_cache, slot_mapping);
 }
 
+namespace {
+
+inline int64_t used_blocks(int32_t context_len, int64_t block_size) {
+  return (static_cast<int64_t>(context_len) + block_size - 1) / block_size;
+}
+
+} // namespace
+
+/*
+ *Fork sequence src_seq into dst_seq as an O(blocks) metadata operation:
+ *dst gets a copy of src's block-table row and context length, and the
+ *reference count of every block src uses is incremented. No cache bytes
+ *move; attention reads the shared blocks through both tables. The block
+ *manager owns block_ref_counts ([num_blocks], int) and sets an entry to 1
+ *when it hands out the block.
+ */
+void kv_cache_fork_forward_cpu(
+    at::Tensor& block_tables, // [num_seqs, max_num_blocks_per_seq]
+    at::Tensor& context_lens, // [num_seqs]
+    at::Tensor& block_ref_counts, // [num_blocks]
+    int64_t src_seq,
+    int64_t dst_seq,
+    int64_t block_size) {
+  TORCH_CHECK(
+      block_tables.dim() == 2 && block_tables.scalar_type() == at::kInt,
+      "kv_cache_fork: expect 2-D int block_tables");
+  TORCH_CHECK(
+      src_seq >= 0 && src_seq < block_tables.size(0) && dst_seq >= 0 &&
+          dst_seq < block_tables.size(0) && src_seq != dst_seq,
+      "kv_cache_fork: invalid sequence indices");
+  auto tables = block_tables.accessor<int32_t, 2>();
+  auto lens = context_lens.accessor<int32_t, 1>();
+  auto refs = block_ref_counts.accessor<int32_t, 1>();
+  auto blocks = used_blocks(lens[src_seq], block_size);
+  for (int64_t i = 0; i < block_tables.size(1); i++) {
+    tables[dst_seq][i] = tables[src_seq][i];
+  }
+  lens[dst_seq] = lens[src_seq];
+  for (int64_t i = 0; i < blocks; i++) {
+    refs[tables[src_seq][i]] += 1;
+  }
+}
+
+/*
+ *Copy-on-append: call before caching sequence seq_idx's next token. Only
+ *the last, partially filled block can be written by an append, so only it
+ *ever needs a private copy; a token landing on a block boundary goes into
+ *a freshly allocated block anyway. When that last block is shared
+ *(refcount > 1), its contents are copied into fresh_block (supplied by
+ *the block manager), the table entry is swapped and the refcounts are
+ *updated; returns whether fresh_block was consumed so the manager knows
+ *to keep or reclaim it.
+ */
+bool kv_cache_maybe_copy_on_write_forward_cpu(
+    at::Tensor& block_tables, // [num_seqs, max_num_blocks_per_seq]
+    at::Tensor& context_lens, // [num_seqs]
+    at::Tensor& block_ref_counts, // [num_blocks]
+    at::Tensor& key_cache, // [num_blocks, ...]
+    at::Tensor& value_cache, // [num_blocks, ...]
+    int64_t seq_idx,
+    int64_t block_size,
+    int64_t fresh_block) {
+  TORCH_CHECK(
+      seq_idx >= 0 && seq_idx < block_tables.size(0),
+      "kv_cache_maybe_copy_on_write: invalid sequence index");
+  TORCH_CHECK(
+      fresh_block >= 0 && fresh_block < key_cache.size(0),
+      "kv_cache_maybe_copy_on_write: invalid fresh block");
+  auto tables = block_tables.accessor<int32_t, 2>();
+  auto lens = context_lens.accessor<int32_t, 1>();
+  auto refs = block_ref_counts.accessor<int32_t, 1>();
+  int64_t context_len = lens[seq_idx];
+  if (context_len == 0 || context_len % block_size == 0) {
+    return false;
+  }
+  int64_t last = context_len / block_size;
+  int32_t shared = tables[seq_idx][last];
+  if (refs[shared] <= 1) {
+    return false;
+  }
+  key_cache[fresh_block].copy_(key_cache[shared]);
+  value_cache[fresh_block].copy_(value_cache[shared]);
+  refs[shared] -= 1;
+  refs[fresh_block] = 1;
+  tables[seq_idx][last] = static_cast<int32_t>(fresh_block);
+  return true;
+}
+
+/*
+ *Release a forked sequence: decrement the refcount of every block it
+ *uses and zero its context length. Returns the block ids whose refcount
+ *dropped to zero so the block manager can recycle them.
+ */
+at::Tensor kv_cache_release_forward_cpu(
+    at::Tensor& block_tables, // [num_seqs, max_num_blocks_per_seq]
+    at::Tensor& context_lens, // [num_seqs]
+    at::Tensor& block_ref_counts, // [num_blocks]
+    int64_t seq_idx,
+    int64_t block_size) {
+  TORCH_CHECK(
+      seq_idx >= 0 && seq_idx < block_tables.size(0),
+      "kv_cache_release: invalid sequence index");
+  auto tables = block_tables.accessor<int32_t, 2>();
+  auto lens = context_lens.accessor<int32_t, 1>();
+  auto refs = block_ref_counts.accessor<int32_t, 1>();
+  auto blocks = used_blocks(lens[seq_idx], block_size);
+  std::vector<int32_t> freed;
+  for (int64_t i = 0; i < blocks; i++) {
+    int32_t block_id = tables[seq_idx][i];
+    refs[block_id] -= 1;
+    if (refs[block_id] == 0) {
+      freed.emplace_back(block_id);
+    }
+  }
+  lens[seq_idx] = 0;
+  auto result = at::empty(
+      {static_cast<int64_t>(freed.size())}, block_tables.options());
+  std::memcpy(
+      result.data_ptr<int32_t>(), freed.data(), freed.size() * sizeof(int32_t));
+  return result;
+}
+
 } // namespace cpu
 } // namespace torch_ipex
 
@@ -62,11 +447,101 @@ TORCH_LIBRARY_FRAGMENT(torch_ipex, m) {
       "single_query_cached_kv_attention",
       c10::DispatchKey::CPU,
       torch_ipex::cpu::single_query_cached_kv_attention_forward_cpu);
+  m.def(
+      "single_query_cached_kv_attention_bias(Tensor (a!)out, Tensor (a!)query, Tensor (a!)key_cache, Tensor (a!)value_cache,\
+       Tensor(a!) head_mapping, float scale, Tensor(a!) block_tables, Tensor(a!) context_lens, int block_size, int max_context_len,\
+       Tensor attn_bias)-> ()");
+  m.impl(
+      "single_query_cached_kv_attention_bias",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::single_query_cached_kv_attention_bias_forward_cpu);
+  m.def(
+      "shared_prefix_cached_kv_attention(Tensor (a!)out, Tensor (a!)query, Tensor (a!)key_cache, Tensor (a!)value_cache,\
+       Tensor(a!) head_mapping, float scale, Tensor(a!) block_tables, Tensor(a!) context_lens, int block_size, int max_context_len,\
+       Tensor? alibi_slopes, int prefix_len)-> ()");
+  m.impl(
+      "shared_prefix_cached_kv_attention",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::shared_prefix_cached_kv_attention_forward_cpu);
+  m.def(
+      "single_query_cached_kv_attention_int8(Tensor (a!)out, Tensor (a!)query, Tensor (a!)key_cache, Tensor (a!)value_cache,\
+       Tensor(a!) head_mapping, float scale, Tensor(a!) block_tables, Tensor(a!) context_lens, int block_size, int max_context_len,\
+       Tensor? alibi_slopes, Tensor(a!) k_scale, Tensor(a!) v_scale)-> ()");
+  m.impl(
+      "single_query_cached_kv_attention_int8",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::single_query_cached_kv_attention_int8_forward_cpu);
+  m.def(
+      "reshape_and_cache_int8(Tensor (a!)key, Tensor (a!)value, Tensor (a!)key_cache, Tensor (a!)value_cache,\
+       Tensor(a!) k_scale, Tensor(a!) v_scale, Tensor(a!) slot_mapping)-> ()");
+  m.impl(
+      "reshape_and_cache_int8",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::reshape_and_cache_int8_cpu);
+  m.def(
+      "chunked_prefill_cached_kv_attention(Tensor (a!)out, Tensor (a!)query, Tensor (a!)key_cache, Tensor (a!)value_cache,\
+       Tensor(a!) head_mapping, float scale, Tensor(a!) block_tables, Tensor(a!) context_lens, Tensor(a!) query_start_loc,\
+       int block_size, int max_context_len, Tensor? alibi_slopes)-> ()");
+  m.impl(
+      "chunked_prefill_cached_kv_attention",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::chunked_prefill_cached_kv_attention_forward_cpu);
+  m.def(
+      "single_query_cached_kv_attention_head_blocked(Tensor (a!)out, Tensor (a!)query, Tensor (a!)key_cache, Tensor (a!)value_cache,\
+       Tensor(a!) head_mapping, float scale, Tensor(a!) block_tables, Tensor(a!) context_lens, int block_size, int max_context_len,\
+       Tensor? alibi_slopes)-> ()");
+  m.impl(
+      "single_query_cached_kv_attention_head_blocked",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::
+          single_query_cached_kv_attention_head_blocked_forward_cpu);
+  m.def(
+      "reshape_and_cache_head_blocked(Tensor (a!)key, Tensor (a!)value, Tensor (a!)key_cache, Tensor (a!)value_cache, Tensor(a!) slot_mapping)-> ()");
+  m.impl(
+      "reshape_and_cache_head_blocked",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::reshape_and_cache_head_blocked_cpu);
+  m.def(
+      "multi_query_cached_kv_attention(Tensor (a!)out, Tensor (a!)query, Tensor (a!)key_cache, Tensor (a!)value_cache,\
+       Tensor(a!) head_mapping, float scale, Tensor(a!) block_tables, Tensor(a!) context_lens, int block_size, int max_context_len,\
+       Tensor? alibi_slopes)-> ()");
+  m.impl(
+      "multi_query_cached_kv_attention",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::multi_query_cached_kv_attention_forward_cpu);
+  m.def(
+      "streaming_llm_cache_evict(Tensor(a!) block_tables, Tensor(a!) context_lens, int block_size,\
+       int sink_blocks, int window_blocks)-> Tensor");
+  m.impl(
+      "streaming_llm_cache_evict",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::streaming_llm_cache_evict_forward_cpu);
   m.def(
       "reshape_and_cache(Tensor (a!)key, Tensor (a!)value, Tensor (a!)key_cache, Tensor (a!)value_cache, Tensor(a!) slot_mapping)-> ()");
   m.impl(
       "reshape_and_cache",
       c10::DispatchKey::CPU,
       torch_ipex::cpu::reshape_and_cache_cpu);
+  m.def(
+      "kv_cache_fork(Tensor(a!) block_tables, Tensor(a!) context_lens, Tensor(a!) block_ref_counts,\
+       int src_seq, int dst_seq, int block_size)-> ()");
+  m.impl(
+      "kv_cache_fork",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::kv_cache_fork_forward_cpu);
+  m.def(
+      "kv_cache_maybe_copy_on_write(Tensor(a!) block_tables, Tensor(a!) context_lens, Tensor(a!) block_ref_counts,\
+       Tensor(a!) key_cache, Tensor(a!) value_cache, int seq_idx, int block_size, int fresh_block)-> bool");
+  m.impl(
+      "kv_cache_maybe_copy_on_write",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::kv_cache_maybe_copy_on_write_forward_cpu);
+  m.def(
+      "kv_cache_release(Tensor(a!) block_tables, Tensor(a!) context_lens, Tensor(a!) block_ref_counts,\
+       int seq_idx, int block_size)-> Tensor");
+  m.impl(
+      "kv_cache_release",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::kv_cache_release_forward_cpu);
 }
 } // namespace
@@ -20,6 +20,20 @@ void single_query_cached_kv_attention(
     int64_t block_size,
     int64_t max_context_len,
     const c10::optional<at::Tensor>& alibi_slopes);
+
+void chunked_prefill_cached_kv_attention(
+    at::Tensor& out, // [num_tokens, num_heads, head_size]
+    at::Tensor& query, // [num_tokens, num_heads, head_size]
+    at::Tensor& key_cache, // [num_blocks,  block_size, num_heads, head_size]
+    at::Tensor& value_cache, // [num_blocks,  block_size, num_heads, head_size]
+    at::Tensor& head_mapping, // [num_heads]
+    const double scale,
+    at::Tensor& block_tables, // [num_seqs, max_num_blocks_per_seq]
+    at::Tensor& context_lens, // [num_seqs]
+    at::Tensor& query_start_loc, // [num_seqs + 1]
+    int64_t block_size,
+    int64_t max_context_len,
+    const c10::optional<at::Tensor>& alibi_slopes);
 }
 
 void reshape_and_cache(
@@ -29,6 +43,46 @@ void reshape_and_cache(
     at::Tensor& value_cache,
     at::Tensor& slot_mapping);
 
+using shared_prefix_cached_kv_attention_fn = void (*)(
+    at::Tensor& out, // [num_seqs, num_heads, head_size]
+    at::Tensor& query, // [num_seqs, num_heads, head_size]
+    at::Tensor& key_cache, // [num_blocks,  block_size, num_heads, head_size]
+    at::Tensor& value_cache, // [num_blocks,  block_size, num_heads, head_size]
+    at::Tensor& head_mapping, // [num_heads]
+    const double scale,
+    at::Tensor& block_tables, // [num_seqs, max_num_blocks_per_seq]
+    at::Tensor& context_lens, // [num_seqs]
+    int64_t block_size,
+    int64_t max_context_len,
+    const c10::optional<at::Tensor>& alibi_slopes,
+    int64_t prefix_len);
+
+using single_query_cached_kv_attention_int8_fn = void (*)(
+    at::Tensor& out, // [num_seqs, num_heads, head_size]
+    at::Tensor& query, // [num_seqs, num_heads, head_size]
+    at::Tensor& key_cache, // int8 [num_blocks, block_size, num_heads,
+                           // head_size]
+    at::Tensor& value_cache, // int8 [num_blocks, block_size, num_heads,
+                             // head_size]
+    at::Tensor& head_mapping, // [num_heads]
+    const double scale,
+    at::Tensor& block_tables, // [num_seqs, max_num_blocks_per_seq]
+    at::Tensor& context_lens, // [num_seqs]
+    int64_t block_size,
+    int64_t max_context_len,
+    const c10::optional<at::Tensor>& alibi_slopes,
+    at::Tensor& k_scale, // [num_blocks, block_size, num_heads]
+    at::Tensor& v_scale); // [num_blocks, block_size, num_heads]
+
+using reshape_and_cache_int8_fn = void (*)(
+    at::Tensor& key,
+    at::Tensor& value,
+    at::Tensor& key_cache,
+    at::Tensor& value_cache,
+    at::Tensor& k_scale,
+    at::Tensor& v_scale,
+    at::Tensor& slot_mapping);
+
 using single_query_cached_kv_attention_fn = void (*)(
     at::Tensor& out, // [num_seqs, num_heads, head_size]
     at::Tensor& query, // [num_seqs, num_heads, head_size]
@@ -42,6 +96,47 @@ using single_query_cached_kv_attention_fn = void (*)(
     int64_t max_context_len,
     const c10::optional<at::Tensor>& alibi_slopes);
 
+// T5-style decode with a learned relative-position bias: attn_bias is a
+// pre-tiled [num_heads, max_context_len] fp32 table indexed by the key
+// token's distance from the current query token, so one tile serves
+// every sequence in the batch regardless of its context length.
+using single_query_cached_kv_attention_bias_fn = void (*)(
+    at::Tensor& out, // [num_seqs, num_heads, head_size]
+    at::Tensor& query, // [num_seqs, num_heads, head_size]
+    at::Tensor& key_cache, // [num_blocks,  block_size, num_heads, head_size]
+    at::Tensor& value_cache, // [num_blocks,  block_size, num_heads, head_size]
+    at::Tensor& head_mapping, // [num_heads]
+    const double scale,
+    at::Tensor& block_tables, // [num_seqs, max_num_blocks_per_seq]
+    at::Tensor& context_lens, // [num_seqs]
+    int64_t block_size,
+    int64_t max_context_len,
+    const at::Tensor& attn_bias); // [num_heads, max_context_len]
+
+using chunked_prefill_cached_kv_attention_fn = void (*)(
+    at::Tensor& out, // [num_tokens, num_heads, head_size]
+    at::Tensor& query, // [num_tokens, num_heads, head_size]
+    at::Tensor& key_cache, // [num_blocks,  block_size, num_heads, head_size]
+    at::Tensor& value_cache, // [num_blocks,  block_size, num_heads, head_size]
+    at::Tensor& head_mapping, // [num_heads]
+    const double scale,
+    at::Tensor& block_tables, // [num_seqs, max_num_blocks_per_seq]
+    at::Tensor& context_lens, // [num_seqs]
+    at::Tensor& query_start_loc, // [num_seqs + 1]
+    int64_t block_size,
+    int64_t max_context_len,
+    const c10::optional<at::Tensor>& alibi_slopes);
+
+// StreamingLLM-style eviction: keep the first sink_blocks blocks plus a
+// rolling window of window_blocks blocks per sequence; returns the freed
+// physical block ids ([num_seqs, max_evicted], -1 padded).
+using streaming_llm_cache_evict_fn = at::Tensor (*)(
+    at::Tensor& block_tables, // [num_seqs, max_num_blocks_per_seq]
+    at::Tensor& context_lens, // [num_seqs]
+    int64_t block_size,
+    int64_t sink_blocks,
+    int64_t window_blocks);
+
 using reshape_and_cache_fn = void (*)(
     at::Tensor& key,
     at::Tensor& value,
@@ -52,7 +147,39 @@ using reshape_and_cache_fn = void (*)(
 IPEX_DECLARE_DISPATCH(
     single_query_cached_kv_attention_fn,
     single_query_cached_kv_attention_kernel_stub);
+IPEX_DECLARE_DISPATCH(
+    single_query_cached_kv_attention_bias_fn,
+    single_query_cached_kv_attention_bias_kernel_stub);
+IPEX_DECLARE_DISPATCH(
+    shared_prefix_cached_kv_attention_fn,
+    shared_prefix_cached_kv_attention_kernel_stub);
+IPEX_DECLARE_DISPATCH(
+    single_query_cached_kv_attention_int8_fn,
+    single_query_cached_kv_attention_int8_kernel_stub);
+IPEX_DECLARE_DISPATCH(
+    reshape_and_cache_int8_fn,
+    reshape_and_cache_int8_kernel_stub);
+IPEX_DECLARE_DISPATCH(
+    chunked_prefill_cached_kv_attention_fn,
+    chunked_prefill_cached_kv_attention_kernel_stub);
 IPEX_DECLARE_DISPATCH(reshape_and_cache_fn, reshape_and_cache_kernel_stub);
+IPEX_DECLARE_DISPATCH(
+    streaming_llm_cache_evict_fn,
+    streaming_llm_cache_evict_kernel_stub);
+// Speculative decoding verification: query/out carry q_len draft tokens per
+// sequence ([num_seqs, q_len, num_heads, head_size]); otherwise the
+// signature matches the single-query stub.
+IPEX_DECLARE_DISPATCH(
+    single_query_cached_kv_attention_fn,
+    multi_query_cached_kv_attention_kernel_stub);
+// Head-blocked [num_blocks, num_heads, block_size, head_size] cache layout;
+// signatures match the token-major stubs.
+IPEX_DECLARE_DISPATCH(
+    single_query_cached_kv_attention_fn,
+    single_query_cached_kv_attention_head_blocked_kernel_stub);
+IPEX_DECLARE_DISPATCH(
+    reshape_and_cache_fn,
+    reshape_and_cache_head_blocked_kernel_stub);
 
 } // namespace cpu
 } // namespace torch_ipex
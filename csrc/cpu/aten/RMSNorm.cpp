@@ -6,6 +6,7 @@ namespace torch_ipex {
 namespace cpu {
 
 IPEX_DEFINE_DISPATCH(rmsnorm_kernel_stub);
+IPEX_DEFINE_DISPATCH(rmsnorm_quant_kernel_stub);
 
 at::Tensor dil_RMSNorm(
     const at::Tensor& input,
@@ -16,6 +17,26 @@ at::Tensor dil_RMSNorm(
   return rmsnorm_kernel_stub(kCPU, input, b, eps);
 }
 
+// Fused rmsnorm + per-tensor affine quantization for smooth-quant INT8
+// pipelines: one pass over the hidden states instead of a norm pass plus
+// a quantize pass. The optional smooth tensor carries per-channel
+// smoothing factors for callers that have not folded them into the norm
+// weight; the JIT rewrite passes None since the quantization flow folds
+// them there.
+at::Tensor dil_RMSNormQuant(
+    const at::Tensor& input,
+    const at::Tensor& b,
+    double eps,
+    const c10::optional<at::Tensor>& smooth,
+    double o_scale,
+    int64_t o_zp,
+    at::ScalarType o_dtype) {
+  RECORD_FUNCTION("ipex::rmsnorm_quant", c10::ArrayRef<c10::IValue>({}));
+
+  return rmsnorm_quant_kernel_stub(
+      kCPU, input, b, eps, smooth, o_scale, o_zp, o_dtype);
+}
+
 } // namespace cpu
 } // namespace torch_ipex
 
@@ -24,5 +45,10 @@ namespace {
 TORCH_LIBRARY_FRAGMENT(torch_ipex, m) {
   m.def("rmsnorm(Tensor input, Tensor weight, float eps) -> Tensor");
   m.impl("rmsnorm", c10::DispatchKey::CPU, torch_ipex::cpu::dil_RMSNorm);
+  m.def(
+      "rmsnorm_quant(Tensor input, Tensor weight, float eps, Tensor? smooth, \
+      float o_scale, int o_zp, ScalarType o_dtype) -> Tensor");
+  m.impl(
+      "rmsnorm_quant", c10::DispatchKey::CPU, torch_ipex::cpu::dil_RMSNormQuant);
 }
 } // namespace
\ No newline at end of file
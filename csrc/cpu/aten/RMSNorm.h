@@ -11,12 +11,30 @@ at::Tensor dil_RMSNorm(
     const at::Tensor& b,
     double eps);
 
+at::Tensor dil_RMSNormQuant(
+    const at::Tensor& input,
+    const at::Tensor& b,
+    double eps,
+    const c10::optional<at::Tensor>& smooth,
+    double o_scale,
+    int64_t o_zp,
+    at::ScalarType o_dtype);
+
 namespace {
 
 at::Tensor rmsnorm_kernel_impl(
     const at::Tensor& input,
     const at::Tensor& b,
     float eps);
+
+at::Tensor rmsnorm_quant_kernel_impl(
+    const at::Tensor& input,
+    const at::Tensor& b,
+    float eps,
+    const c10::optional<at::Tensor>& smooth,
+    double o_scale,
+    int64_t o_zp,
+    at::ScalarType o_dtype);
 }
 
 using rms_norm_kernel_fn =
@@ -24,5 +42,16 @@ using rms_norm_kernel_fn =
 
 IPEX_DECLARE_DISPATCH(rms_norm_kernel_fn, rmsnorm_kernel_stub);
 
+using rms_norm_quant_kernel_fn = at::Tensor (*)(
+    const at::Tensor&,
+    const at::Tensor&,
+    float,
+    const c10::optional<at::Tensor>&,
+    double,
+    int64_t,
+    at::ScalarType);
+
+IPEX_DECLARE_DISPATCH(rms_norm_quant_kernel_fn, rmsnorm_quant_kernel_stub);
+
 } // namespace cpu
 } // namespace torch_ipex
@@ -113,6 +113,33 @@ struct RNNParams {
   }
 };
 
+// Variable-batch inference (e.g. streaming ASR) creates a new primitive
+// descriptor and, for rnn_packed weight formats, a new packed weight layout
+// for every distinct batch size. Padding the batch up to a small set of
+// tiers keeps the number of distinct shapes -- and thus primitive and
+// packed-weight cache entries -- bounded, so the per-call setup cost is
+// paid once per tier instead of once per batch size. Opt-in via
+// IPEX_LSTM_BATCH_BUCKETING=1 since the padded rows cost extra compute.
+bool lstm_batch_bucketing_enabled() {
+  static bool enabled = []() {
+    auto* env = std::getenv("IPEX_LSTM_BATCH_BUCKETING");
+    return env != nullptr && atoi(env) != 0;
+  }();
+  return enabled;
+}
+
+int64_t lstm_batch_tier(int64_t mini_batch) {
+  // Next power of two up to 64, then next multiple of 64.
+  if (mini_batch >= 64) {
+    return at::divup(mini_batch, (int64_t)64) * 64;
+  }
+  int64_t tier = 1;
+  while (tier < mini_batch) {
+    tier <<= 1;
+  }
+  return tier;
+}
+
 template <bool is_single_direction>
 std::vector<int64_t> _output_size(const RNNParams& rnn) {
   auto output_channels = is_single_direction
@@ -354,7 +381,7 @@ std::vector<at::Tensor> lstm_kernel(
         hy,
         cy,
         reverse,
-        ideep::attr_t(torch_ipex::fpmath_mode));
+        ideep::attr_t(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::RNN)));
     workspace = torch_ipex::cpu::empty_aten_tensor_from_desc(
         pd.workspace_desc(), input.options().dtype(at::kByte));
     ideep::tensor mkldnn_workspace;
@@ -384,7 +411,7 @@ std::vector<at::Tensor> lstm_kernel(
         zp,
         weights_scale_mask,
         weight_scales,
-        ideep::attr_t(torch_ipex::fpmath_mode));
+        ideep::attr_t(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::RNN)));
     result.reserve(3);
     result.push_back(output);
     result.push_back(hy_);
@@ -856,7 +883,7 @@ std::vector<at::Tensor> ipex_lstm_layer_backward(
       hy,
       cy,
       reverse,
-      ideep::attr_t(torch_ipex::fpmath_mode));
+      ideep::attr_t(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::RNN)));
   ideep::tensor mkldnn_workspace;
   mkldnn_workspace.init(
       forward_hint.workspace_desc(), workspace.template data_ptr<uint8_t>());
@@ -882,7 +909,7 @@ std::vector<at::Tensor> ipex_lstm_layer_backward(
       diff_w2,
       diff_b,
       reverse,
-      ideep::attr_t(torch_ipex::fpmath_mode));
+      ideep::attr_t(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::RNN)));
   return {diff_x_, diff_w1_, diff_w2_, diff_b_, diff_b_, diff_hx_, diff_cx_};
 }
 
@@ -942,6 +969,28 @@ std::tuple<at::Tensor, at::Tensor, at::Tensor> mkldnn_rnn(
   auto hx = hx_.contiguous();
   auto cx = cx_.contiguous();
 
+  // Pad the batch up to its tier for inference so that recurring shapes hit
+  // the primitive and packed-weight caches. The batch rows are independent,
+  // so the padded rows only produce throwaway outputs which are sliced off
+  // below. Quantized input is skipped since zero padding does not match its
+  // zero point.
+  const int64_t mini_batch = input.size(1);
+  int64_t padded_batch = mini_batch;
+  if (!train && !at::GradMode::is_enabled() &&
+      input.scalar_type() != at::ScalarType::QUInt8 &&
+      lstm_batch_bucketing_enabled()) {
+    padded_batch = lstm_batch_tier(mini_batch);
+  }
+  if (padded_batch != mini_batch) {
+    const int64_t batch_pad = padded_batch - mini_batch;
+    // batch is dim 1 for both the tnc input and the ldnc hidden states
+    input = at::constant_pad_nd(input, {0, 0, 0, batch_pad});
+    hx = at::constant_pad_nd(hx, {0, 0, 0, batch_pad});
+    if (cx.defined()) {
+      cx = at::constant_pad_nd(cx, {0, 0, 0, batch_pad});
+    }
+  }
+
   at::MatrixRef<at::Tensor> weights{
       weight, static_cast<size_t>(weight_stride0)};
 
@@ -1004,6 +1053,11 @@ std::tuple<at::Tensor, at::Tensor, at::Tensor> mkldnn_rnn(
   auto output = layer_input;
   auto hy = at::stack(layer_hy, 0);
   auto cy = at::stack(layer_cy, 0);
+  if (padded_batch != mini_batch) {
+    output = output.narrow(1, 0, mini_batch);
+    hy = hy.narrow(1, 0, mini_batch);
+    cy = cy.narrow(1, 0, mini_batch);
+  }
   if (batch_first && !is_input_packed) {
     output = output.transpose(0, 1);
   }
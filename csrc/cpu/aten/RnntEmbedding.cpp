@@ -12,6 +12,7 @@ namespace torch_ipex {
 namespace cpu {
 
 IPEX_DEFINE_DISPATCH(rnnt_embedding_kernel_stub);
+IPEX_DEFINE_DISPATCH(rnnt_embedding_batched_kernel_stub);
 
 } // namespace cpu
 } // namespace torch_ipex
@@ -59,12 +60,52 @@ static void rnnt_embedding(
       embedding_dim);
 }
 
+/*
+  rnnt_embedding_batched: batched variant of rnnt_embedding for the
+  beam-search decoder of RNN-T. Instead of one lookup per live hypothesis,
+  it takes the token ids of the whole beam at once and gathers all
+  embeddings in a single parallel pass, so one decoding step costs one op
+  launch rather than beam_width of them. The -1 (SOS) zero-fill is folded
+  into the gather itself via a masked load, so beams mixing SOS and
+  regular tokens do not branch per hypothesis.
+
+  embedding_table: the lookup table that stores embeddings
+  idx: indices to extract from the embedding_table, dtype: torch.int64
+    Any shape (e.g. [batch_size, beam_width]); an index of -1 means
+    filling the lookup result with 0.0
+  _SOS: -1 to mark the Start Of Sequence
+
+  Returns a tensor of shape idx.shape + [embedding_dim] with the dtype of
+  the embedding_table.
+*/
+static at::Tensor rnnt_embedding_batched(
+    const at::Tensor& embedding_table,
+    const at::Tensor& idx,
+    int64_t _SOS) {
+#if defined(IPEX_DISP_OP)
+  printf("IPEX::rnnt_embedding_batched\n");
+#endif
+  RECORD_FUNCTION(
+      "IPEX::rnnt_embedding_batched", c10::ArrayRef<c10::IValue>({}));
+
+  auto idx_ = idx.contiguous();
+  auto out_sizes = idx_.sizes().vec();
+  out_sizes.push_back(embedding_table.size(1));
+  auto embedding_out = at::empty(out_sizes, embedding_table.options());
+
+  torch_ipex::cpu::rnnt_embedding_batched_kernel_stub(
+      kCPU, embedding_table, idx_, embedding_out, _SOS);
+  return embedding_out;
+}
+
 } // namespace kernel
 } // namespace torch_ipex
 
 namespace {
 
-static auto dispatch = torch::RegisterOperators().op(
-    "torch_ipex::rnnt_embedding",
-    &torch_ipex::kernel::rnnt_embedding);
+static auto dispatch =
+    torch::RegisterOperators()
+        .op("torch_ipex::rnnt_embedding", &torch_ipex::kernel::rnnt_embedding)
+        .op("torch_ipex::rnnt_embedding_batched",
+            &torch_ipex::kernel::rnnt_embedding_batched);
 }
\ No newline at end of file
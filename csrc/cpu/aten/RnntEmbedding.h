@@ -16,6 +16,12 @@ void rnnt_embedding_kernel_impl(
     int64_t batch_size,
     int64_t embedding_dim);
 
+void rnnt_embedding_batched_kernel_impl(
+    const at::Tensor& embedding_table,
+    const at::Tensor& idx,
+    at::Tensor embedding_out,
+    int64_t _SOS);
+
 }
 
 using rnnt_embedding_kernel_fn = void (*)(
@@ -27,5 +33,11 @@ using rnnt_embedding_kernel_fn = void (*)(
     int64_t);
 IPEX_DECLARE_DISPATCH(rnnt_embedding_kernel_fn, rnnt_embedding_kernel_stub);
 
+using rnnt_embedding_batched_kernel_fn =
+    void (*)(const at::Tensor&, const at::Tensor&, at::Tensor, int64_t);
+IPEX_DECLARE_DISPATCH(
+    rnnt_embedding_batched_kernel_fn,
+    rnnt_embedding_batched_kernel_stub);
+
 } // namespace cpu
 } // namespace torch_ipex
\ No newline at end of file
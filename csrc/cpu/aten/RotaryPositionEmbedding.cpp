@@ -4,14 +4,177 @@
 // apply_rotary_pos_emb
 #include "RotaryPositionEmbedding.h"
 #include <ATen/FunctionalTensorWrapper.h>
+#include <ATen/Parallel.h>
 #include <torch/all.h>
 #include <torch/csrc/autograd/function.h>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include "utils/rw_lock.h"
 
 namespace torch_ipex {
 namespace cpu {
 
 IPEX_DEFINE_DISPATCH(rotary_position_embedding_kernel_stub);
 
+namespace {
+
+enum class RopeScalingMode { None, Linear, DynamicNtk, Yarn };
+
+RopeScalingMode parse_rope_scaling_mode(c10::string_view scaling_type) {
+  if (scaling_type == "none" || scaling_type.empty()) {
+    return RopeScalingMode::None;
+  } else if (scaling_type == "linear") {
+    return RopeScalingMode::Linear;
+  } else if (scaling_type == "dynamic" || scaling_type == "ntk") {
+    return RopeScalingMode::DynamicNtk;
+  } else if (scaling_type == "yarn") {
+    return RopeScalingMode::Yarn;
+  }
+  TORCH_CHECK(
+      false,
+      "rotary_sincos_table: unsupported scaling_type '",
+      std::string(scaling_type),
+      "', expected none/linear/dynamic/yarn");
+}
+
+// Dimension index below which positions rotate at least num_rotations
+// times within original_max_position (YaRN eq. for the blend ramp).
+double yarn_find_correction_dim(
+    double num_rotations,
+    int64_t rotary_dim,
+    double base,
+    int64_t original_max_position) {
+  return (rotary_dim *
+          std::log(original_max_position / (num_rotations * 2 * M_PI))) /
+      (2 * std::log(base));
+}
+
+at::Tensor build_rope_sincos_table(
+    int64_t rows,
+    int64_t rotary_dim,
+    double base,
+    RopeScalingMode mode,
+    double scaling_factor,
+    int64_t original_max_position) {
+  auto half = rotary_dim / 2;
+  std::vector<double> inv_freq(half);
+  auto eff_base = base;
+  if (mode == RopeScalingMode::DynamicNtk && rows > original_max_position) {
+    // NTK-aware base stretch so the lowest frequency still completes one
+    // period over the extended context.
+    eff_base = base *
+        std::pow(
+                   scaling_factor * rows / original_max_position -
+                       (scaling_factor - 1),
+                   static_cast<double>(rotary_dim) / (rotary_dim - 2));
+  }
+  for (auto i = 0; i < half; i++) {
+    inv_freq[i] = 1.0 / std::pow(eff_base, 2.0 * i / rotary_dim);
+  }
+  auto mscale = 1.0;
+  if (mode == RopeScalingMode::Linear) {
+    for (auto i = 0; i < half; i++) {
+      inv_freq[i] /= scaling_factor;
+    }
+  } else if (mode == RopeScalingMode::Yarn) {
+    // Blend per-dimension between extrapolation (high-frequency dims keep
+    // the original inv_freq) and interpolation (low-frequency dims are
+    // slowed by scaling_factor), with the standard beta_fast=32 /
+    // beta_slow=1 ramp and sqrt-log attention temperature.
+    constexpr double beta_fast = 32.0;
+    constexpr double beta_slow = 1.0;
+    auto low = std::floor(yarn_find_correction_dim(
+        beta_fast, rotary_dim, base, original_max_position));
+    auto high = std::ceil(yarn_find_correction_dim(
+        beta_slow, rotary_dim, base, original_max_position));
+    low = std::max(low, 0.0);
+    high = std::min(high, static_cast<double>(half - 1));
+    auto denom = std::max(high - low, 0.001);
+    for (auto i = 0; i < half; i++) {
+      auto ramp = std::min(std::max((i - low) / denom, 0.0), 1.0);
+      auto extrapolation_factor = 1.0 - ramp;
+      inv_freq[i] = inv_freq[i] / scaling_factor * ramp +
+          inv_freq[i] * extrapolation_factor;
+    }
+    if (scaling_factor > 1.0) {
+      mscale = 0.1 * std::log(scaling_factor) + 1.0;
+    }
+  }
+  auto table = at::empty({rows, rotary_dim}, at::kFloat);
+  auto table_ptr = table.data_ptr<float>();
+  at::parallel_for(0, rows, 64, [&](int64_t begin, int64_t end) {
+    for (auto p = begin; p < end; p++) {
+      auto row = table_ptr + p * rotary_dim;
+      for (auto i = 0; i < half; i++) {
+        auto angle = p * inv_freq[i];
+        row[i] = std::sin(angle) * mscale;
+        row[half + i] = std::cos(angle) * mscale;
+      }
+    }
+  });
+  return table;
+}
+
+} // anonymous namespace
+
+at::Tensor rotary_sincos_table(
+    int64_t seq_len,
+    int64_t rotary_dim,
+    double base,
+    c10::string_view scaling_type,
+    double scaling_factor,
+    int64_t original_max_position) {
+  TORCH_CHECK(
+      seq_len > 0, "rotary_sincos_table: seq_len should be positive");
+  TORCH_CHECK(
+      rotary_dim > 0 && rotary_dim % 2 == 0,
+      "rotary_sincos_table: rotary_dim should be positive and even");
+  TORCH_CHECK(
+      scaling_factor >= 1.0,
+      "rotary_sincos_table: scaling_factor should be >= 1");
+  TORCH_CHECK(
+      original_max_position > 0,
+      "rotary_sincos_table: original_max_position should be positive");
+  auto mode = parse_rope_scaling_mode(scaling_type);
+  using table_cache_t = std::map<std::string, at::Tensor>;
+  static torch_ipex::ReadMostly<table_cache_t> table_cache;
+  auto key = std::string(scaling_type) + "|" + std::to_string(rotary_dim) +
+      "|" + std::to_string(base) + "|" + std::to_string(scaling_factor) + "|" +
+      std::to_string(original_max_position);
+  // Steady-state lookups (the table is already long enough) take a
+  // lock-free snapshot; only growth goes through the serialized writer.
+  {
+    auto snap = table_cache.snapshot();
+    auto it = snap->find(key);
+    if (it != snap->end() && it->second.size(0) >= seq_len) {
+      return it->second;
+    }
+  }
+  at::Tensor table;
+  table_cache.update([&](table_cache_t& cache) {
+    // re-check under the writer lock: another thread may have grown the
+    // table while this one waited
+    auto it = cache.find(key);
+    if (it != cache.end() && it->second.size(0) >= seq_len) {
+      table = it->second;
+      return;
+    }
+    // Grow geometrically so a stream of slowly increasing lengths triggers
+    // O(log n) rebuilds instead of one per request. For the dynamic mode
+    // this also matches the HF convention of keeping the table built for
+    // the longest context seen.
+    auto rows = std::max(seq_len, original_max_position);
+    if (it != cache.end()) {
+      rows = std::max(rows, 2 * it->second.size(0));
+    }
+    table = build_rope_sincos_table(
+        rows, rotary_dim, base, mode, scaling_factor, original_max_position);
+    cache[key] = table;
+  });
+  return table;
+}
+
 std::tuple<at::Tensor, at::Tensor, at::Tensor>
 rotary_position_embedding_forward_cpu(
     at::Tensor& t_in,
@@ -39,5 +202,11 @@ TORCH_LIBRARY_FRAGMENT(torch_ipex, m) {
       "rotary_position_embedding",
       c10::DispatchKey::CPU,
       torch_ipex::cpu::rotary_position_embedding_forward_cpu);
+  m.def(
+      "rotary_sincos_table(int seq_len, int rotary_dim, float base, str scaling_type, float scaling_factor, int original_max_position) -> Tensor");
+  m.impl(
+      "rotary_sincos_table",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::rotary_sincos_table);
 }
 } // namespace
@@ -33,5 +33,21 @@ IPEX_DECLARE_DISPATCH(
     rotary_position_embedding_kernel_fn,
     rotary_position_embedding_kernel_stub);
 
+// Builds (and caches) the position-indexed sin/cos table consumed by
+// rotary_position_embedding, with long-context frequency scaling applied
+// in C++. scaling_type selects "none", "linear", "dynamic" (NTK-aware
+// base adjustment) or "yarn"; scaling_factor and original_max_position
+// parameterize the scaling. The returned table is [rows][rotary_dim]
+// float with sin in the first half of each row and cos in the second,
+// covers at least seq_len positions, and is grown geometrically so
+// serving a longer context does not rebuild it on every length change.
+at::Tensor rotary_sincos_table(
+    int64_t seq_len,
+    int64_t rotary_dim,
+    double base,
+    c10::string_view scaling_type,
+    double scaling_factor,
+    int64_t original_max_position);
+
 } // namespace cpu
 } // namespace torch_ipex
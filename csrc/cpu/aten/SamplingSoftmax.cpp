@@ -0,0 +1,44 @@
+#include "SamplingSoftmax.h"
+#include <torch/all.h>
+#include <torch/csrc/autograd/function.h>
+
+namespace torch_ipex {
+namespace cpu {
+
+IPEX_DEFINE_DISPATCH(sampling_softmax_kernel_stub);
+IPEX_DEFINE_DISPATCH(sample_token_kernel_stub);
+
+at::Tensor dil_sampling_softmax(
+    const at::Tensor& logits,
+    double temperature,
+    int64_t top_k) {
+  RECORD_FUNCTION(
+      "torch_ipex::sampling_softmax", c10::ArrayRef<c10::IValue>({}));
+
+  return sampling_softmax_kernel_stub(kCPU, logits, temperature, top_k);
+}
+
+at::Tensor dil_sample_token(const at::Tensor& probs, bool do_sample) {
+  RECORD_FUNCTION("torch_ipex::sample_token", c10::ArrayRef<c10::IValue>({}));
+
+  return sample_token_kernel_stub(kCPU, probs, do_sample);
+}
+
+} // namespace cpu
+} // namespace torch_ipex
+
+namespace {
+
+TORCH_LIBRARY_FRAGMENT(torch_ipex, m) {
+  m.def("sampling_softmax(Tensor logits, float temperature, int top_k) -> Tensor");
+  m.impl(
+      "sampling_softmax",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::dil_sampling_softmax);
+  m.def("sample_token(Tensor probs, bool do_sample) -> Tensor");
+  m.impl(
+      "sample_token",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::dil_sample_token);
+}
+} // namespace
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <dyndisp/DispatchStub.h>
+
+namespace torch_ipex {
+namespace cpu {
+
+// Fused sampling preparation over the last (vocab) dimension: one kernel
+// applies the temperature, keeps the top_k largest logits per row and
+// returns probabilities normalized over the survivors, with zeros for the
+// filtered entries so the result feeds torch.multinomial directly.
+// top_k <= 0 disables the top-k filter and yields a plain temperature
+// softmax.
+at::Tensor dil_sampling_softmax(
+    const at::Tensor& logits,
+    double temperature,
+    int64_t top_k);
+
+// Draws one token id per row from the probabilities produced above:
+// inverse-CDF sampling with a vectorized scan of the (mostly zero)
+// probability buffer when do_sample is true, vectorized argmax when it
+// is false. The output has the rows' shape with a trailing dim of 1, so
+// it is a drop-in for torch.multinomial(probs, 1) and
+// torch.argmax(probs, -1, keepdim=True).
+at::Tensor dil_sample_token(const at::Tensor& probs, bool do_sample);
+
+namespace {
+
+at::Tensor sampling_softmax_kernel_impl(
+    const at::Tensor& logits,
+    double temperature,
+    int64_t top_k);
+
+at::Tensor sample_token_kernel_impl(const at::Tensor& probs, bool do_sample);
+}
+
+using sampling_softmax_kernel_fn =
+    at::Tensor (*)(const at::Tensor&, double, int64_t);
+
+using sample_token_kernel_fn = at::Tensor (*)(const at::Tensor&, bool);
+
+IPEX_DECLARE_DISPATCH(sampling_softmax_kernel_fn, sampling_softmax_kernel_stub);
+IPEX_DECLARE_DISPATCH(sample_token_kernel_fn, sample_token_kernel_stub);
+
+} // namespace cpu
+} // namespace torch_ipex
@@ -2,6 +2,7 @@
 #include "TPPGEMM.h"
 #include <torch/all.h>
 #include <torch/csrc/autograd/function.h>
+#include "RMSNorm.h"
 #include "tpp/xsmm_functors.h"
 namespace torch_ipex {
 namespace cpu {
@@ -9,7 +10,11 @@ namespace cpu {
 IPEX_DEFINE_DISPATCH(tpp_linear_nobias_kernel_stub);
 IPEX_DEFINE_DISPATCH(tpp_linear_bias_kernel_stub);
 IPEX_DEFINE_DISPATCH(tpp_linear_gelu_kernel_stub);
+IPEX_DEFINE_DISPATCH(tpp_linear_argmax_kernel_stub);
 IPEX_DEFINE_DISPATCH(tpp_fused_gate_up_proj_kernel_stub);
+IPEX_DEFINE_DISPATCH(tpp_fused_qkv_gemm_kernel_stub);
+IPEX_DEFINE_DISPATCH(tpp_fused_gated_mlp_kernel_stub);
+IPEX_DEFINE_DISPATCH(tpp_fused_gated_mlp_add_kernel_stub);
 IPEX_DEFINE_DISPATCH(tpp_linear_silu_kernel_stub);
 IPEX_DEFINE_DISPATCH(tpp_linear_relu_kernel_stub);
 IPEX_DEFINE_DISPATCH(tpp_linear_add_kernel_stub);
@@ -39,6 +44,20 @@ at::Tensor tpp_linear_gelu_forward_cpu(
   return tpp_linear_gelu_kernel_stub(kCPU, t_in, t_wt, t_bias);
 }
 
+/*
+ * Greedy-decode epilogue for the lm-head linear: the argmax over the
+ * vocab runs inside the GEMM while each logit tile is still in cache,
+ * so the op returns the int64 token ids directly and the full
+ * BS x vocab logit tensor is never written to or read from memory.
+ */
+at::Tensor tpp_linear_argmax_forward_cpu(
+    const at::Tensor& t_in,
+    const at::Tensor& t_wt,
+    const at::Tensor& t_bias,
+    c10::optional<int64_t> out_features) {
+  return tpp_linear_argmax_kernel_stub(kCPU, t_in, t_wt, t_bias);
+}
+
 at::Tensor tpp_fused_gate_up_proj_forward_cpu(
     const at::Tensor& t_in,
     const at::Tensor& t_wt_gate,
@@ -50,6 +69,69 @@ at::Tensor tpp_fused_gate_up_proj_forward_cpu(
       kCPU, t_in, t_wt_gate, t_bias_gate, t_wt_up, t_bias_up);
 }
 
+at::Tensor tpp_fused_gated_mlp_forward_cpu(
+    const at::Tensor& t_in,
+    const at::Tensor& t_wt_gate,
+    const at::Tensor& t_bias_gate,
+    const at::Tensor& t_wt_up,
+    const at::Tensor& t_bias_up,
+    const at::Tensor& t_wt_down,
+    const at::Tensor& t_bias_down) {
+  return tpp_fused_gated_mlp_kernel_stub(
+      kCPU,
+      t_in,
+      t_wt_gate,
+      t_bias_gate,
+      t_wt_up,
+      t_bias_up,
+      t_wt_down,
+      t_bias_down);
+}
+
+/*
+ *Whole decoder-layer MLP half as a single dispatch: RMSNorm of the
+ *attention-block output, the fused gated MLP and the residual add all run
+ *under one op, so a decode token pays one framework dispatch instead of
+ *six. The residual add happens inside the fused kernel while the output
+ *tile is hot; the only intermediate is the normed activation, which at
+ *decode batch sizes is a few KB.
+ */
+at::Tensor tpp_fused_mlp_block_forward_cpu(
+    const at::Tensor& t_in,
+    const at::Tensor& t_ln_weight,
+    double eps,
+    const at::Tensor& t_wt_gate,
+    const at::Tensor& t_bias_gate,
+    const at::Tensor& t_wt_up,
+    const at::Tensor& t_bias_up,
+    const at::Tensor& t_wt_down,
+    const at::Tensor& t_bias_down) {
+  auto t_norm =
+      rmsnorm_kernel_stub(kCPU, t_in, t_ln_weight, static_cast<float>(eps));
+  return tpp_fused_gated_mlp_add_kernel_stub(
+      kCPU,
+      t_norm,
+      t_in,
+      t_wt_gate,
+      t_bias_gate,
+      t_wt_up,
+      t_bias_up,
+      t_wt_down,
+      t_bias_down);
+}
+
+std::tuple<at::Tensor, at::Tensor, at::Tensor> tpp_fused_qkv_gemm_forward_cpu(
+    const at::Tensor& t_in,
+    const at::Tensor& t_wt_q,
+    const at::Tensor& t_bias_q,
+    const at::Tensor& t_wt_k,
+    const at::Tensor& t_bias_k,
+    const at::Tensor& t_wt_v,
+    const at::Tensor& t_bias_v) {
+  return tpp_fused_qkv_gemm_kernel_stub(
+      kCPU, t_in, t_wt_q, t_bias_q, t_wt_k, t_bias_k, t_wt_v, t_bias_v);
+}
+
 at::Tensor tpp_linear_silu_forward_cpu(
     const at::Tensor& t_in,
     const at::Tensor& t_wt,
@@ -129,6 +211,15 @@ TORCH_LIBRARY_FRAGMENT(torch_ipex, m) {
       torch_ipex::cpu::tpp_linear_gelu_forward_cpu);
 }
 
+TORCH_LIBRARY_FRAGMENT(torch_ipex, m) {
+  m.def(
+      "tpp_linear_argmax(Tensor t_in, Tensor t_wt, Tensor t_bias, int? out_features=None)-> Tensor out");
+  m.impl(
+      "tpp_linear_argmax",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::tpp_linear_argmax_forward_cpu);
+}
+
 TORCH_LIBRARY_FRAGMENT(torch_ipex, m) {
   m.def(
       "tpp_fused_gate_up_proj(Tensor t_in, Tensor t_wt_gate, Tensor t_bias_gate, Tensor t_wt_up, Tensor t_bias_up,int? out_features=None)-> Tensor out");
@@ -138,6 +229,33 @@ TORCH_LIBRARY_FRAGMENT(torch_ipex, m) {
       torch_ipex::cpu::tpp_fused_gate_up_proj_forward_cpu);
 }
 
+TORCH_LIBRARY_FRAGMENT(torch_ipex, m) {
+  m.def(
+      "tpp_fused_gated_mlp(Tensor t_in, Tensor t_wt_gate, Tensor t_bias_gate, Tensor t_wt_up, Tensor t_bias_up, Tensor t_wt_down, Tensor t_bias_down)-> Tensor out");
+  m.impl(
+      "tpp_fused_gated_mlp",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::tpp_fused_gated_mlp_forward_cpu);
+}
+
+TORCH_LIBRARY_FRAGMENT(torch_ipex, m) {
+  m.def(
+      "tpp_fused_mlp_block(Tensor t_in, Tensor t_ln_weight, float eps, Tensor t_wt_gate, Tensor t_bias_gate, Tensor t_wt_up, Tensor t_bias_up, Tensor t_wt_down, Tensor t_bias_down)-> Tensor out");
+  m.impl(
+      "tpp_fused_mlp_block",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::tpp_fused_mlp_block_forward_cpu);
+}
+
+TORCH_LIBRARY_FRAGMENT(torch_ipex, m) {
+  m.def(
+      "tpp_fused_qkv_gemm(Tensor t_in, Tensor t_wt_q, Tensor t_bias_q, Tensor t_wt_k, Tensor t_bias_k, Tensor t_wt_v, Tensor t_bias_v)-> (Tensor, Tensor, Tensor)");
+  m.impl(
+      "tpp_fused_qkv_gemm",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::tpp_fused_qkv_gemm_forward_cpu);
+}
+
 TORCH_LIBRARY_FRAGMENT(torch_ipex, m) {
   m.def(
       "tpp_linear_add_add(Tensor t_in, Tensor t_in1, Tensor t_in2, Tensor t_wt, Tensor t_bias, float scale, int? out_features=None)-> Tensor out");
@@ -23,6 +23,14 @@ at::Tensor tpp_linear_gelu_forward_cpu(
     const at::Tensor& t_bias,
     c10::optional<int64_t> out_features);
 
+// Fused last-layer linear + greedy argmax: emits int64 token ids of
+// shape t_in.sizes()[:-1] without materializing the logits.
+at::Tensor tpp_linear_argmax_forward_cpu(
+    const at::Tensor& t_in,
+    const at::Tensor& t_wt,
+    const at::Tensor& t_bias,
+    c10::optional<int64_t> out_features);
+
 at::Tensor tpp_fused_gate_up_proj_forward_cpu(
     const at::Tensor& t_in,
     const at::Tensor& t_wt_gate,
@@ -31,6 +39,35 @@ at::Tensor tpp_fused_gate_up_proj_forward_cpu(
     const at::Tensor& t_bias_up,
     c10::optional<int64_t> out_features);
 
+at::Tensor tpp_fused_gated_mlp_forward_cpu(
+    const at::Tensor& t_in,
+    const at::Tensor& t_wt_gate,
+    const at::Tensor& t_bias_gate,
+    const at::Tensor& t_wt_up,
+    const at::Tensor& t_bias_up,
+    const at::Tensor& t_wt_down,
+    const at::Tensor& t_bias_down);
+
+at::Tensor tpp_fused_mlp_block_forward_cpu(
+    const at::Tensor& t_in,
+    const at::Tensor& t_ln_weight,
+    double eps,
+    const at::Tensor& t_wt_gate,
+    const at::Tensor& t_bias_gate,
+    const at::Tensor& t_wt_up,
+    const at::Tensor& t_bias_up,
+    const at::Tensor& t_wt_down,
+    const at::Tensor& t_bias_down);
+
+std::tuple<at::Tensor, at::Tensor, at::Tensor> tpp_fused_qkv_gemm_forward_cpu(
+    const at::Tensor& t_in,
+    const at::Tensor& t_wt_q,
+    const at::Tensor& t_bias_q,
+    const at::Tensor& t_wt_k,
+    const at::Tensor& t_bias_k,
+    const at::Tensor& t_wt_v,
+    const at::Tensor& t_bias_v);
+
 at::Tensor tpp_linear_silu_forward_cpu(
     const at::Tensor& t_in,
     const at::Tensor& t_wt,
@@ -76,6 +113,9 @@ using tpp_linear_bias_kernel_impl_fn =
 using tpp_linear_gelu_kernel_impl_fn =
     at::Tensor (*)(const at::Tensor&, const at::Tensor&, const at::Tensor&);
 
+using tpp_linear_argmax_kernel_impl_fn =
+    at::Tensor (*)(const at::Tensor&, const at::Tensor&, const at::Tensor&);
+
 using tpp_fused_gate_up_proj_kernel_impl_fn = at::Tensor (*)(
     const at::Tensor&,
     const at::Tensor&,
@@ -83,6 +123,35 @@ using tpp_fused_gate_up_proj_kernel_impl_fn = at::Tensor (*)(
     const at::Tensor&,
     const at::Tensor&);
 
+using tpp_fused_gated_mlp_kernel_impl_fn = at::Tensor (*)(
+    const at::Tensor&,
+    const at::Tensor&,
+    const at::Tensor&,
+    const at::Tensor&,
+    const at::Tensor&,
+    const at::Tensor&,
+    const at::Tensor&);
+
+using tpp_fused_gated_mlp_add_kernel_impl_fn = at::Tensor (*)(
+    const at::Tensor&,
+    const at::Tensor&,
+    const at::Tensor&,
+    const at::Tensor&,
+    const at::Tensor&,
+    const at::Tensor&,
+    const at::Tensor&,
+    const at::Tensor&);
+
+using tpp_fused_qkv_gemm_kernel_impl_fn =
+    std::tuple<at::Tensor, at::Tensor, at::Tensor> (*)(
+        const at::Tensor&,
+        const at::Tensor&,
+        const at::Tensor&,
+        const at::Tensor&,
+        const at::Tensor&,
+        const at::Tensor&,
+        const at::Tensor&);
+
 using tpp_linear_silu_kernel_impl_fn =
     at::Tensor (*)(const at::Tensor&, const at::Tensor&, const at::Tensor&);
 
@@ -117,9 +186,21 @@ IPEX_DECLARE_DISPATCH(
 IPEX_DECLARE_DISPATCH(
     tpp_linear_gelu_kernel_impl_fn,
     tpp_linear_gelu_kernel_stub);
+IPEX_DECLARE_DISPATCH(
+    tpp_linear_argmax_kernel_impl_fn,
+    tpp_linear_argmax_kernel_stub);
 IPEX_DECLARE_DISPATCH(
     tpp_fused_gate_up_proj_kernel_impl_fn,
     tpp_fused_gate_up_proj_kernel_stub);
+IPEX_DECLARE_DISPATCH(
+    tpp_fused_gated_mlp_kernel_impl_fn,
+    tpp_fused_gated_mlp_kernel_stub);
+IPEX_DECLARE_DISPATCH(
+    tpp_fused_gated_mlp_add_kernel_impl_fn,
+    tpp_fused_gated_mlp_add_kernel_stub);
+IPEX_DECLARE_DISPATCH(
+    tpp_fused_qkv_gemm_kernel_impl_fn,
+    tpp_fused_qkv_gemm_kernel_stub);
 IPEX_DECLARE_DISPATCH(
     tpp_linear_silu_kernel_impl_fn,
     tpp_linear_silu_kernel_stub);
@@ -12,28 +12,85 @@ namespace {
 using weakref_type =
     c10::weak_intrusive_ptr<c10::TensorImpl, c10::UndefinedTensorImpl>;
 using val_blocked = std::tuple<weakref_type, ideep::tensor>;
-std::unordered_map<c10::TensorImpl*, val_blocked> cached_weights;
+using blocked_map_t = std::unordered_map<c10::TensorImpl*, val_blocked>;
 
-using map_iter =
-    std::unordered_map<c10::TensorImpl*, val_blocked>::const_iterator;
-
-torch_ipex::ReadWriteMutex rwmutex;
+// The weight caches are filled during warmup and then hit on every op
+// call, so readers take a lock-free RCU snapshot instead of paying a
+// ReadWriteMutex acquisition per lookup; the rarely-running writers copy
+// and republish the map.
+torch_ipex::ReadMostly<blocked_map_t> cached_weights;
 
 ideep::tensor read_cached_weights(const at::Tensor& weight) {
-  torch_ipex::UniqueReadLock<torch_ipex::ReadWriteMutex> lock(rwmutex);
+  auto snap = cached_weights.snapshot();
   ideep::tensor cached_weight;
-  auto it = cached_weights.find(weight.unsafeGetTensorImpl());
-  if (it != cached_weights.end()) {
+  auto it = snap->find(weight.unsafeGetTensorImpl());
+  if (it != snap->end()) {
     cached_weight = std::get<1>(it->second);
   }
   return cached_weight;
 }
 
 void write_cached_weights(const at::Tensor& weight, ideep::tensor& result) {
-  torch_ipex::UniqueWriteLock<torch_ipex::ReadWriteMutex> lock(rwmutex);
-  cached_weights.emplace(
-      weight.unsafeGetTensorImpl(),
-      val_blocked{weakref_type(weight.getIntrusivePtr()), result});
+  cached_weights.update([&](blocked_map_t& map) {
+    map.emplace(
+        weight.unsafeGetTensorImpl(),
+        val_blocked{weakref_type(weight.getIntrusivePtr()), result});
+  });
+}
+
+// Weights packed into the shape-dependent rnn_packed (opaque) format cannot
+// live in `cached_weights`: a single entry per weight would go stale whenever
+// the input shape changes and oneDNN cannot reorder rnn_packed back to a
+// public format to fix it up. Cache one packed copy per (weight, shape)
+// instead so each recurring shape pays the packing reorder only once.
+using shape_key_t = int64_t;
+using val_shaped =
+    std::tuple<weakref_type, std::unordered_map<shape_key_t, ideep::tensor>>;
+using shaped_map_t = std::unordered_map<c10::TensorImpl*, val_shaped>;
+torch_ipex::ReadMostly<shaped_map_t> cached_shaped_weights;
+
+// Bound the number of distinct shapes kept per weight. Workloads with
+// unbounded batch diversity should enable batch bucketing (see
+// IPEX_LSTM_BATCH_BUCKETING in RNN.cpp) so they hit this cache instead of
+// cycling it.
+constexpr size_t kMaxCachedShapesPerWeight = 16;
+
+ideep::tensor read_cached_shaped_weights(
+    const at::Tensor& weight,
+    shape_key_t shape_key) {
+  auto snap = cached_shaped_weights.snapshot();
+  ideep::tensor cached_weight;
+  auto it = snap->find(weight.unsafeGetTensorImpl());
+  if (it != snap->end()) {
+    auto& shape_map = std::get<1>(it->second);
+    auto shape_it = shape_map.find(shape_key);
+    if (shape_it != shape_map.end()) {
+      cached_weight = shape_it->second;
+    }
+  }
+  return cached_weight;
+}
+
+void write_cached_shaped_weights(
+    const at::Tensor& weight,
+    shape_key_t shape_key,
+    ideep::tensor& result) {
+  cached_shaped_weights.update([&](shaped_map_t& map) {
+    auto it = map.find(weight.unsafeGetTensorImpl());
+    if (it == map.end()) {
+      it = map.emplace(
+                  weight.unsafeGetTensorImpl(),
+                  val_shaped{
+                      weakref_type(weight.getIntrusivePtr()),
+                      std::unordered_map<shape_key_t, ideep::tensor>{}})
+               .first;
+    }
+    auto& shape_map = std::get<1>(it->second);
+    if (shape_map.size() >= kMaxCachedShapesPerWeight) {
+      shape_map.clear();
+    }
+    shape_map.emplace(shape_key, result);
+  });
 }
 
 } // namespace
@@ -61,15 +118,30 @@ bool is_packed(const at::Tensor& weight) {
 std::tuple<ideep::tensor, ideep::tensor> CommonLstmWeightDesc::
     get_and_save_lstm_packed_weight() {
   ideep::tensor cached_weight_ih, cached_weight_hh;
-  // Don't pack when the weight is of opaque format (rnn_packed format).
-  // When the weight is of rnn_packed format, if the seq_lens of
-  // the input changes, the format of weight also changes.
-  // oneDNN does not support reorder from rnn_packed back to public
-  // format. LSTM based on BRGEMM kernel (on AVX512 and newest ISAs) will
-  // use blocked format for weight of LSTM, which won't change when the
-  // input seq_lens changes.
+  // When the weight is of opaque format (rnn_packed format), if the
+  // seq_lens or batch size of the input changes, the format of weight also
+  // changes, and oneDNN does not support reorder from rnn_packed back to
+  // public format. Such weights go into the shape-keyed cache: the public
+  // ATen weight stays the source of truth and one packed copy is kept per
+  // recurring shape, so variable-shape inference no longer re-packs on
+  // every call. LSTM based on BRGEMM kernel (on AVX512 and newest ISAs)
+  // will use blocked format for weight of LSTM, which won't change when
+  // the input seq_lens changes and is cached per weight as before.
   if (packed_desc_ih_.is_opaque() || packed_desc_hh_.is_opaque()) {
-    return std::make_tuple(w1_src_, w2_src_);
+    // output_sizes_ is {seq_length, mini_batch, channels}; both extents are
+    // far below 2^31 so they pack losslessly into a single key.
+    const shape_key_t shape_key =
+        (static_cast<shape_key_t>(output_sizes_[0]) << 32) | output_sizes_[1];
+    cached_weight_ih = read_cached_shaped_weights(weight_ih_, shape_key);
+    cached_weight_hh = read_cached_shaped_weights(weight_hh_, shape_key);
+    if (!cached_weight_ih.is_empty() && !cached_weight_hh.is_empty()) {
+      return std::make_tuple(cached_weight_ih, cached_weight_hh);
+    }
+    cached_weight_ih = w1_src_.reorder_if_differ_in(packed_desc_ih_, op_attr_);
+    cached_weight_hh = w2_src_.reorder_if_differ_in(packed_desc_hh_, op_attr_);
+    write_cached_shaped_weights(weight_ih_, shape_key, cached_weight_ih);
+    write_cached_shaped_weights(weight_hh_, shape_key, cached_weight_hh);
+    return std::make_tuple(cached_weight_ih, cached_weight_hh);
   }
 
   cached_weight_ih = w1_src_.reorder_if_differ_in(packed_desc_ih_, op_attr_);
@@ -6,6 +6,8 @@
 #include <aten/AddLayerNorm.h>
 
 #include <torch/csrc/autograd/function.h>
+#include "runtime/PersistentTeam.h"
+#include "utils/workspace.h"
 #include "vec/vec.h"
 
 namespace torch_ipex {
@@ -13,7 +15,7 @@ namespace cpu {
 
 namespace {
 
-#if defined(CPU_CAPABILITY_AVX512)
+#if defined(CPU_CAPABILITY_AVX512) || defined(CPU_CAPABILITY_AVX2)
 template <typename T, typename T1>
 void AddLayerNormKernelImpl(
     const at::Tensor& a,
@@ -36,25 +38,28 @@ void AddLayerNormKernelImpl(
   const float c = float(1) / static_cast<float>(N);
   const bool gamma_null = gamma_data == nullptr;
   const bool beta_null = beta_data == nullptr;
-  at::parallel_for(0, M, 1, [&](int64_t start, int64_t end) {
-    for (const auto i : c10::irange(start, end)) {
-      at::Tensor tmp_out = at::empty({N});
-      float* tmp_out_ptr = tmp_out.data_ptr<float>();
-      const T* a_ptr = a_data + i * N;
-      const T* b_ptr = b_data + i * N;
-      T* Y_ptr = Y_data + i * N;
-      float mean_val;
-      float rstd_val;
-      std::tie(mean_val, rstd_val) =
-          kernel::_add_and_compute_mean_var<T>(a_ptr, b_ptr, N, tmp_out_ptr);
-      rstd_val = std::max(rstd_val * c - mean_val * mean_val, float(0));
-      rstd_val = float(1.0) / std::sqrt(rstd_val + eps);
-      float scale = rstd_val;
-      float bias = -rstd_val * mean_val;
-      kernel::_normalize_kernel<T, T1>(
-          Y_ptr, tmp_out_ptr, N, scale, bias, gamma_data, beta_data);
-    }
-  });
+  // routed through the persistent team (when IPEX_PERSISTENT_TEAM=1) so
+  // decode-sized rows skip the per-op omp fork/join
+  torch_ipex::runtime::persistent_parallel_for(
+      0, M, 1, [&](int64_t start, int64_t end) {
+        float* tmp_out_ptr = static_cast<float*>(
+            get_thread_local_workspace(N * sizeof(float)));
+        for (const auto i : c10::irange(start, end)) {
+          const T* a_ptr = a_data + i * N;
+          const T* b_ptr = b_data + i * N;
+          T* Y_ptr = Y_data + i * N;
+          float mean_val;
+          float rstd_val;
+          std::tie(mean_val, rstd_val) =
+              kernel::_add_and_compute_mean_var<T>(a_ptr, b_ptr, N, tmp_out_ptr);
+          rstd_val = std::max(rstd_val * c - mean_val * mean_val, float(0));
+          rstd_val = float(1.0) / std::sqrt(rstd_val + eps);
+          float scale = rstd_val;
+          float bias = -rstd_val * mean_val;
+          kernel::_normalize_kernel<T, T1>(
+              Y_ptr, tmp_out_ptr, N, scale, bias, gamma_data, beta_data);
+        }
+      });
 }
 #endif
 
@@ -66,7 +71,7 @@ at::Tensor add_layer_norm_kernel_impl(
     const c10::optional<at::Tensor>& weight_opt,
     const c10::optional<at::Tensor>& bias_opt,
     float eps) {
-#if defined(CPU_CAPABILITY_AVX512)
+#if defined(CPU_CAPABILITY_AVX512) || defined(CPU_CAPABILITY_AVX2)
   c10::MaybeOwned<Tensor> weight_maybe_owned =
       at::borrow_from_optional_tensor(weight_opt);
   const at::Tensor& weight = *weight_maybe_owned;
@@ -1,4 +1,5 @@
 #include <aten/AddSoftmax.h>
+#include "utils/workspace.h"
 #include "vec/vec.h"
 
 namespace torch_ipex {
@@ -6,7 +7,7 @@ namespace cpu {
 
 namespace {
 
-#if defined(CPU_CAPABILITY_AVX512)
+#if defined(CPU_CAPABILITY_AVX512) || defined(CPU_CAPABILITY_AVX2)
 using namespace torch_ipex::cpu::kernel;
 
 inline int64_t _calc_element_offset(
@@ -113,8 +114,8 @@ at::Tensor dil_div_add_softmax(
   at::parallel_for(0, outer_size, grain_size, [&](int64_t begin, int64_t end) {
     float val = 0.0;
     int64_t b_offset = 0;
-    at::Tensor tmp_out = at::empty({dim_size});
-    float* tmp_out_ptr = tmp_out.data_ptr<float>();
+    float* tmp_out_ptr = static_cast<float*>(
+        get_thread_local_workspace(dim_size * sizeof(float)));
     for (int64_t i = begin; i < end; i++) {
       if (need_broadcast) {
         b_offset =
@@ -245,7 +246,7 @@ at::Tensor div_add_softmax_kernel_impl(
     at::Tensor& a,
     const at::Tensor& b,
     const float& dim_per_head) {
-#if defined(CPU_CAPABILITY_AVX512)
+#if defined(CPU_CAPABILITY_AVX512) || defined(CPU_CAPABILITY_AVX2)
   if (a.scalar_type() == at::kFloat && b.scalar_type() == at::kFloat) {
     return dil_div_add_softmax<float>(a, b, dim_per_head);
   } else if (
@@ -262,7 +263,7 @@ at::Tensor div_add_softmax_kernel_impl(
 at::Tensor& add_softmax_inplace_kernel_impl(
     at::Tensor& a,
     const at::Tensor& b) {
-#if defined(CPU_CAPABILITY_AVX512)
+#if defined(CPU_CAPABILITY_AVX512) || defined(CPU_CAPABILITY_AVX2)
   if (a.scalar_type() == at::kFloat && b.scalar_type() == at::kFloat) {
     return dil_add_softmax_(a, b);
   }
@@ -14,6 +14,7 @@
 #include "utils/library.h"
 
 #include <aten/AveragePool.h>
+#include <aten/utils/pool_partition.h>
 
 namespace torch_ipex {
 namespace cpu {
@@ -66,8 +67,12 @@ void cpu_avg_pool(
   int64_t output_height = output.size(-2);
   int64_t output_width = output.size(-1);
 
-  // parallel on dim N, C
-  at::parallel_for(0, channels, 0, [&](int64_t begin, int64_t end) {
+  // parallel on dim N, C; adaptive grain keeps threads fed when the
+  // per-channel planes are small and avoids over-partitioning big ones
+  int64_t grain_size = pooling_grain_size(
+      channels,
+      output_depth * output_height * output_width * sizeof(scalar_t));
+  at::parallel_for(0, channels, grain_size, [&](int64_t begin, int64_t end) {
     for (int64_t c = begin; c < end; c++) {
       scalar_t* input_ptr =
           input_data + c * input_depth * input_height * input_width;
@@ -177,11 +182,14 @@ cpu_avg_pool_channels_last(
   int64_t output_width = output.size(-1);
 
   using Vec = at::vec::Vectorized<scalar_t>;
-  // parallel on dim N, {D}, H, W
+  // parallel on dim N, {D}, H, W; each item covers one channels row
+  int64_t grain_size = pooling_grain_size(
+      nbatch * output_depth * output_height * output_width,
+      channels * sizeof(scalar_t));
   at::parallel_for(
       0,
       nbatch * output_depth * output_height * output_width,
-      0,
+      grain_size,
       [&](int64_t begin, int64_t end) {
         int64_t n = 0;
         int64_t od = 0;
@@ -313,36 +321,60 @@ cpu_avg_pool_channels_last(
     int64_t padD,
     bool count_include_pad,
     c10::optional<int64_t> divisor_override) {
-  TORCH_CHECK(
-      input_.ndimension() == 4,
-      "average pooling with channels last format supports tensors with 4 dims");
-  auto memory_format = at::MemoryFormat::ChannelsLast;
+  int64_t ndim = input_.ndimension();
+  if (is_3d) {
+    TORCH_CHECK(
+        ndim == 5,
+        "AvgPool3d with channels last format supports tensors with 5 dims");
+  } else {
+    TORCH_CHECK(
+        ndim == 4,
+        "AvgPool2d with channels last format supports tensors with 4 dims");
+  }
+  auto memory_format =
+      is_3d ? at::MemoryFormat::ChannelsLast3d : at::MemoryFormat::ChannelsLast;
   auto input = input_.contiguous(memory_format);
   auto output = output_.contiguous(memory_format);
 
   auto input_data = input.data_ptr<scalar_t>();
   auto output_data = output.data_ptr<scalar_t>();
 
+  // AvgPool2d: NHWC
+  // AvgPool3d: NDHWC
   int64_t nbatch = input.size(0);
   int64_t channels = input.size(1);
-  int64_t input_height = input.size(2);
-  int64_t input_width = input.size(3);
-  int64_t output_height = output.size(2);
-  int64_t output_width = output.size(3);
+  int64_t input_depth = is_3d ? input.size(2) : 1;
+  int64_t input_height = input.size(-2);
+  int64_t input_width = input.size(-1);
+  int64_t output_depth = is_3d ? output.size(2) : 1;
+  int64_t output_height = output.size(-2);
+  int64_t output_width = output.size(-1);
 
   using bVec = at::vec::Vectorized<scalar_t>;
   using fVec = at::vec::Vectorized<float>;
-  // parallel on dim N, H, W
+  // parallel on dim N, {D}, H, W; each item covers one channels row
+  int64_t grain_size = pooling_grain_size(
+      nbatch * output_depth * output_height * output_width,
+      channels * sizeof(scalar_t));
   at::parallel_for(
       0,
-      nbatch * output_height * output_width,
-      0,
+      nbatch * output_depth * output_height * output_width,
+      grain_size,
       [&](int64_t begin, int64_t end) {
         int64_t n = 0;
+        int64_t od = 0;
         int64_t oh = 0;
         int64_t ow = 0;
         at::native::data_index_init(
-            begin, n, nbatch, oh, output_height, ow, output_width);
+            begin,
+            n,
+            nbatch,
+            od,
+            output_depth,
+            oh,
+            output_height,
+            ow,
+            output_width);
 
         // temp buffer for sum, use float as accumulation type
         // can't reuse output buffer to store sum since it is BFloat16/Half
@@ -352,13 +384,17 @@ cpu_avg_pool_channels_last(
         int64_t size = channels;
         for (const auto i : c10::irange(begin, end)) {
           // compute the mean of the input image...
+          int64_t id0 = od * dD - padD;
           int64_t ih0 = oh * dH - padH;
           int64_t iw0 = ow * dW - padW;
+          int64_t id1 = std::min(id0 + kD, input_depth + padD);
           int64_t ih1 = std::min(ih0 + kH, input_height + padH);
           int64_t iw1 = std::min(iw0 + kW, input_width + padW);
-          int64_t pool_size = (ih1 - ih0) * (iw1 - iw0);
+          int64_t pool_size = (id1 - id0) * (ih1 - ih0) * (iw1 - iw0);
+          id0 = std::max(id0, (int64_t)0);
           ih0 = std::max(ih0, (int64_t)0);
           iw0 = std::max(iw0, (int64_t)0);
+          id1 = std::min(id1, input_depth);
           ih1 = std::min(ih1, input_height);
           iw1 = std::min(iw1, input_width);
 
@@ -369,13 +405,13 @@ cpu_avg_pool_channels_last(
             if (count_include_pad) {
               divide_factor = pool_size;
             } else {
-              divide_factor = (ih1 - ih0) * (iw1 - iw0);
+              divide_factor = (id1 - id0) * (ih1 - ih0) * (iw1 - iw0);
             }
           }
 
           scalar_t* out = output_data + i * channels;
 
-          // Pass I: zero the out lane
+          // Pass I: zero the sum lane
           int64_t d1 = 0;
           for (; d1 < size - (size % fVec::size()); d1 += fVec::size()) {
             fVec sum_fvec = fVec(float(0));
@@ -385,7 +421,7 @@ cpu_avg_pool_channels_last(
             sum[d1] = float(0);
           }
 
-          if (ih0 >= ih1 || iw0 >= iw1) {
+          if (id0 >= id1 || ih0 >= ih1 || iw0 >= iw1) {
             // since we are not directly using output as the accumulation
             // buffer, in case the kernel window is out of range, need to zero
             // the output buffer here.
@@ -394,32 +430,42 @@ cpu_avg_pool_channels_last(
             }
             // move on to next output index
             at::native::data_index_step(
-                n, nbatch, oh, output_height, ow, output_width);
+                n,
+                nbatch,
+                od,
+                output_depth,
+                oh,
+                output_height,
+                ow,
+                output_width);
             continue;
           }
 
           // Pass II: compute local sum
-          for (const auto ih : c10::irange(ih0, ih1)) {
-            for (const auto iw : c10::irange(iw0, iw1)) {
-              scalar_t* in = input_data +
-                  n * input_height * input_width * channels +
-                  ih * input_width * channels + iw * channels;
-
-              int64_t d2 = 0;
-              for (; d2 < size - (size % bVec::size()); d2 += bVec::size()) {
-                bVec data_bvec = bVec::loadu(in + d2);
-                fVec data_fvec0, data_fvec1;
-                std::tie(data_fvec0, data_fvec1) =
-                    at::vec::convert_to_float<scalar_t>(data_bvec);
-
-                fVec sum_fvec0 = fVec::loadu(sum + d2) + data_fvec0;
-                fVec sum_fvec1 =
-                    fVec::loadu(sum + d2 + fVec::size()) + data_fvec1;
-                sum_fvec0.store(sum + d2);
-                sum_fvec1.store(sum + d2 + fVec::size());
-              }
-              for (; d2 < size; d2++) {
-                sum[d2] += float(in[d2]);
+          for (const auto id : c10::irange(id0, id1)) {
+            for (const auto ih : c10::irange(ih0, ih1)) {
+              for (const auto iw : c10::irange(iw0, iw1)) {
+                scalar_t* in = input_data +
+                    (n * input_depth * input_height * input_width +
+                     id * input_height * input_width + ih * input_width + iw) *
+                        channels;
+
+                int64_t d2 = 0;
+                for (; d2 < size - (size % bVec::size()); d2 += bVec::size()) {
+                  bVec data_bvec = bVec::loadu(in + d2);
+                  fVec data_fvec0, data_fvec1;
+                  std::tie(data_fvec0, data_fvec1) =
+                      at::vec::convert_to_float<scalar_t>(data_bvec);
+
+                  fVec sum_fvec0 = fVec::loadu(sum + d2) + data_fvec0;
+                  fVec sum_fvec1 =
+                      fVec::loadu(sum + d2 + fVec::size()) + data_fvec1;
+                  sum_fvec0.store(sum + d2);
+                  sum_fvec1.store(sum + d2 + fVec::size());
+                }
+                for (; d2 < size; d2++) {
+                  sum[d2] += float(in[d2]);
+                }
               }
             }
           }
@@ -441,7 +487,7 @@ cpu_avg_pool_channels_last(
 
           // move on to next output index
           at::native::data_index_step(
-              n, nbatch, oh, output_height, ow, output_width);
+              n, nbatch, od, output_depth, oh, output_height, ow, output_width);
         }
       });
 
@@ -497,8 +543,11 @@ void cpu_avg_pool_backward(
   int64_t output_height = grad_output.size(-2);
   int64_t output_width = grad_output.size(-1);
 
-  // parallel on dim of N, C
-  at::parallel_for(0, channels, 0, [&](int64_t begin, int64_t end) {
+  // parallel on dim of N, C; adaptive grain, see pool_partition.h
+  int64_t grain_size = pooling_grain_size(
+      channels, input_depth * input_height * input_width * sizeof(scalar_t));
+  at::parallel_for(
+      0, channels, grain_size, [&](int64_t begin, int64_t end) {
     for (const auto c : c10::irange(begin, end)) {
       scalar_t* grad_input_ptr =
           grad_input_data + c * input_depth * input_height * input_width;
@@ -591,8 +640,11 @@ void cpu_avg_pool_backward_channels_last(
   int64_t output_width = grad_output.size(-1);
 
   using Vec = at::vec::Vectorized<scalar_t>;
-  // parallel on dim N
-  at::parallel_for(0, nbatch, 0, [&](int64_t begin, int64_t end) {
+  // parallel on dim N; adaptive grain, see pool_partition.h
+  int64_t grain_size = pooling_grain_size(
+      nbatch,
+      input_depth * input_height * input_width * channels * sizeof(scalar_t));
+  at::parallel_for(0, nbatch, grain_size, [&](int64_t begin, int64_t end) {
     for (const auto n : c10::irange(begin, end)) {
       scalar_t* grad_input_ptr = grad_input_data +
           n * input_depth * input_height * input_width * channels;
@@ -870,9 +922,29 @@ void avg_pool3d_kernel_impl(
     c10::optional<int64_t> divisor_override) {
   switch (input.suggest_memory_format()) {
     case at::MemoryFormat::Contiguous: {
-      AT_DISPATCH_FLOATING_TYPES_AND(
-          at::ScalarType::Long, input.scalar_type(), "avg_pool3d", [&] {
-            if (input.scalar_type() == at::ScalarType::Float) {
+      AT_DISPATCH_FLOATING_TYPES_AND3(
+          at::ScalarType::Long,
+          at::ScalarType::BFloat16,
+          at::ScalarType::Half,
+          input.scalar_type(),
+          "avg_pool3d",
+          [&] {
+            if (at::isReducedFloatingType(input.scalar_type())) {
+              cpu_avg_pool<scalar_t, /*accscalar_t*/ float, /* is_3d */ true>(
+                  output,
+                  input,
+                  kW,
+                  kH,
+                  kD,
+                  dW,
+                  dH,
+                  dD,
+                  padW,
+                  padH,
+                  padD,
+                  count_include_pad,
+                  divisor_override);
+            } else if (input.scalar_type() == at::ScalarType::Float) {
               cpu_avg_pool<float, /*accscalar_t*/ float, /* is_3d */ true>(
                   output,
                   input,
@@ -922,8 +994,10 @@ void avg_pool3d_kernel_impl(
       break;
     }
     case at::MemoryFormat::ChannelsLast3d: {
-      AT_DISPATCH_FLOATING_TYPES_AND(
+      AT_DISPATCH_FLOATING_TYPES_AND3(
           at::ScalarType::Long,
+          at::ScalarType::BFloat16,
+          at::ScalarType::Half,
           input.scalar_type(),
           "avg_pool3d_channels_last",
           [&] {
@@ -967,8 +1041,12 @@ void avg_pool3d_backward_kernel_impl(
     c10::optional<int64_t> divisor_override) {
   switch (grad_output.suggest_memory_format()) {
     case at::MemoryFormat::Contiguous: {
-      AT_DISPATCH_FLOATING_TYPES(
-          grad_output.scalar_type(), "avg_pool3d_backward", [&] {
+      AT_DISPATCH_FLOATING_TYPES_AND2(
+          at::ScalarType::BFloat16,
+          at::ScalarType::Half,
+          grad_output.scalar_type(),
+          "avg_pool3d_backward",
+          [&] {
             cpu_avg_pool_backward<scalar_t, /* is_3d */ true>(
                 grad_input,
                 grad_output,
@@ -987,8 +1065,12 @@ void avg_pool3d_backward_kernel_impl(
       break;
     }
     case at::MemoryFormat::ChannelsLast3d: {
-      AT_DISPATCH_FLOATING_TYPES(
-          grad_output.scalar_type(), "avg_pool3d_backward_channels_last", [&] {
+      AT_DISPATCH_FLOATING_TYPES_AND2(
+          at::ScalarType::BFloat16,
+          at::ScalarType::Half,
+          grad_output.scalar_type(),
+          "avg_pool3d_backward_channels_last",
+          [&] {
             cpu_avg_pool_backward_channels_last<scalar_t, /* is_3d */ true>(
                 grad_input,
                 grad_output,
@@ -0,0 +1,123 @@
+#include <aten/BatchNormAddRelu.h>
+
+#include <torch/csrc/autograd/function.h>
+#include "vec/vec.h"
+
+namespace torch_ipex {
+namespace cpu {
+
+namespace {
+
+#if defined(CPU_CAPABILITY_AVX512)
+//  All the fusion conditions have been applied before calling this kernel.
+//  Please refer ../../jit/cpu/passes/graph_rewrite.cpp for details.
+template <typename T>
+void BnAddReluKernelImpl_ChannelsLast(
+    const at::Tensor& input,
+    const at::Tensor& scale,
+    const at::Tensor& beta,
+    const c10::optional<at::Tensor>& add_input,
+    at::Tensor& output) {
+  using ACC_T = typename AccType<T>::type;
+  int64_t total_size_except_channels = 1;
+  for (int64_t i = 0; i < input.ndimension(); ++i) {
+    if (i != 1)
+      total_size_except_channels *= input.size(i);
+  }
+
+  auto input_ = input.contiguous(input.suggest_memory_format());
+  const T* input_ptr = input_.data_ptr<T>();
+  const T* add_ptr = nullptr;
+  at::Tensor add_;
+  if (add_input.has_value() && add_input.value().defined()) {
+    add_ = add_input.value().contiguous(input.suggest_memory_format());
+    add_ptr = add_.data_ptr<T>();
+  }
+  const ACC_T* scale_data = scale.data_ptr<ACC_T>();
+  const ACC_T* beta_data = beta.data_ptr<ACC_T>();
+  T* output_data = output.data_ptr<T>();
+
+  kernel::_bn_add_relu_kernel_channels_last<T, ACC_T>(
+      input_ptr,
+      add_ptr,
+      output_data,
+      scale_data,
+      beta_data,
+      total_size_except_channels,
+      input.size(1));
+}
+#endif
+
+at::Tensor bn_add_relu_kernel_impl(
+    const at::Tensor& input,
+    const at::Tensor& bn_scale,
+    const at::Tensor& bn_beta,
+    const c10::optional<at::Tensor>& add_input,
+    const c10::optional<at::Tensor>& bn_weight,
+    const c10::optional<at::Tensor>& bn_bias,
+    const c10::optional<at::Tensor>& bn_mean,
+    const c10::optional<at::Tensor>& bn_var,
+    bool bn_training,
+    double bn_momentum,
+    double bn_eps,
+    bool bn_cudnn_enabled) {
+  // Check if the memory format is channelslast(3d); the channel counts may
+  // be arbitrary since the vectorized kernel handles tails with masked
+  // loads/stores.
+  auto check_format_channelsize = [](const at::Tensor& tensor) {
+    return (
+        tensor.suggest_memory_format() == at::MemoryFormat::ChannelsLast ||
+        tensor.suggest_memory_format() == at::MemoryFormat::ChannelsLast3d);
+  };
+
+  // The JIT operator passes an undefined tensor when there is no residual.
+  bool has_add = add_input.has_value() && add_input.value().defined();
+  bool tensor_check = !bn_training && check_format_channelsize(input);
+  // The residual must match the bn output exactly for the single-pass
+  // kernel: same sizes, dtype and memory format.
+  if (has_add) {
+    const auto& add = add_input.value();
+    tensor_check = tensor_check && check_format_channelsize(add) &&
+        add.sizes() == input.sizes() &&
+        add.scalar_type() == input.scalar_type();
+  }
+#if defined(CPU_CAPABILITY_AVX512)
+  if (tensor_check) {
+    at::Tensor output = at::empty(
+        input.sizes(),
+        input.options().memory_format(input.suggest_memory_format()));
+    if (input.scalar_type() == at::kBFloat16) {
+      BnAddReluKernelImpl_ChannelsLast<at::BFloat16>(
+          input, bn_scale, bn_beta, add_input, output);
+    } else if (input.scalar_type() == at::kHalf) {
+      BnAddReluKernelImpl_ChannelsLast<at::Half>(
+          input, bn_scale, bn_beta, add_input, output);
+    } else {
+      BnAddReluKernelImpl_ChannelsLast<float>(
+          input, bn_scale, bn_beta, add_input, output);
+    }
+    return output;
+  }
+#endif
+  auto bn_res = at::batch_norm(
+      input,
+      bn_weight,
+      bn_bias,
+      bn_mean,
+      bn_var,
+      bn_training,
+      bn_momentum,
+      bn_eps,
+      bn_cudnn_enabled);
+  if (has_add) {
+    bn_res = at::add(bn_res, add_input.value());
+  }
+  return at::relu(bn_res);
+}
+
+} // anonymous namespace
+
+IPEX_REGISTER_DISPATCH(bn_add_relu_kernel_stub, &bn_add_relu_kernel_impl);
+
+} // namespace cpu
+} // namespace torch_ipex
@@ -0,0 +1,169 @@
+#include <aten/Cast.h>
+
+#include <ATen/Parallel.h>
+#include "vec/vec.h"
+
+namespace torch_ipex {
+namespace cpu {
+
+namespace {
+
+#if defined(CPU_CAPABILITY_AVX512)
+
+// Conversion runs in fixed blocks so chunk starts stay 16-element
+// aligned; with the 64-byte-aligned base ATen hands out, that keeps
+// every vector store on its natural boundary for the streaming variant.
+constexpr int64_t kCastBlockElems = 32 * 1024;
+// Above this combined footprint the data cannot live in the LLC anyway,
+// so write-allocating the destination only evicts the working set;
+// switch to non-temporal stores.
+constexpr int64_t kCastNtThresholdBytes = 32 * 1024 * 1024;
+
+inline bool is_aligned_to(const void* ptr, size_t bytes) {
+  return reinterpret_cast<uintptr_t>(ptr) % bytes == 0;
+}
+
+// fp32 <-> 16-bit converters, one pair per destination type, wrapping the
+// shared cvt helpers from vec512_bfloat16.h / vec512_half.h.
+template <typename T>
+struct CastCvt;
+
+template <>
+struct CastCvt<at::BFloat16> {
+  static inline __m256i narrow(__m512 v) {
+    return cvt_fp32_to_bf16(v);
+  }
+  static inline __m512 widen(__m256i v) {
+    return cvt_bf16_to_fp32(v);
+  }
+};
+
+template <>
+struct CastCvt<at::Half> {
+  static inline __m256i narrow(__m512 v) {
+    return cvt_fp32_to_fp16(v);
+  }
+  static inline __m512 widen(__m256i v) {
+    return cvt_fp16_to_fp32(v);
+  }
+};
+
+template <typename T>
+void cast_narrow_impl(T* dst, const float* src, int64_t numel, bool stream) {
+  int64_t num_blocks = (numel + kCastBlockElems - 1) / kCastBlockElems;
+  at::parallel_for(0, num_blocks, 1, [&](int64_t block_begin, int64_t block_end) {
+    for (int64_t b = block_begin; b < block_end; ++b) {
+      int64_t i = b * kCastBlockElems;
+      int64_t end = std::min(i + kCastBlockElems, numel);
+      if (stream) {
+        for (; i <= end - 16; i += 16) {
+          auto v16 = CastCvt<T>::narrow(_mm512_loadu_ps(src + i));
+          _mm256_stream_si256((__m256i*)(dst + i), v16);
+        }
+      } else {
+        for (; i <= end - 16; i += 16) {
+          auto v16 = CastCvt<T>::narrow(_mm512_loadu_ps(src + i));
+          _mm256_storeu_si256((__m256i*)(dst + i), v16);
+        }
+      }
+      if (i < end) {
+        __mmask16 mask = (1 << (end - i)) - 1;
+        auto v16 = CastCvt<T>::narrow(_mm512_maskz_loadu_ps(mask, src + i));
+        _mm256_mask_storeu_epi16(dst + i, mask, v16);
+      }
+    }
+    if (stream) {
+      // order the non-temporal stores before the tensor is handed out
+      _mm_sfence();
+    }
+  });
+}
+
+template <typename T>
+void cast_widen_impl(float* dst, const T* src, int64_t numel, bool stream) {
+  int64_t num_blocks = (numel + kCastBlockElems - 1) / kCastBlockElems;
+  at::parallel_for(0, num_blocks, 1, [&](int64_t block_begin, int64_t block_end) {
+    for (int64_t b = block_begin; b < block_end; ++b) {
+      int64_t i = b * kCastBlockElems;
+      int64_t end = std::min(i + kCastBlockElems, numel);
+      if (stream) {
+        for (; i <= end - 16; i += 16) {
+          auto f32 = CastCvt<T>::widen(_mm256_loadu_si256((__m256i*)(src + i)));
+          _mm512_stream_ps(dst + i, f32);
+        }
+      } else {
+        for (; i <= end - 16; i += 16) {
+          auto f32 = CastCvt<T>::widen(_mm256_loadu_si256((__m256i*)(src + i)));
+          _mm512_storeu_ps(dst + i, f32);
+        }
+      }
+      if (i < end) {
+        __mmask16 mask = (1 << (end - i)) - 1;
+        auto f32 = CastCvt<T>::widen(_mm256_maskz_loadu_epi16(mask, src + i));
+        _mm512_mask_storeu_ps(dst + i, mask, f32);
+      }
+    }
+    if (stream) {
+      _mm_sfence();
+    }
+  });
+}
+
+at::Tensor cast_convert_kernel_impl(
+    const at::Tensor& input,
+    at::ScalarType dtype) {
+  auto src_type = input.scalar_type();
+  bool narrow = src_type == at::kFloat &&
+      (dtype == at::kBFloat16 || dtype == at::kHalf);
+  bool widen = dtype == at::kFloat &&
+      (src_type == at::kBFloat16 || src_type == at::kHalf);
+  if ((!narrow && !widen) || !input.is_contiguous()) {
+    return input.to(dtype);
+  }
+  auto output = at::empty_like(input, dtype);
+  int64_t numel = input.numel();
+  bool stream = static_cast<int64_t>(input.nbytes() + output.nbytes()) >
+          kCastNtThresholdBytes &&
+      is_aligned_to(output.data_ptr(), 64);
+  if (narrow) {
+    if (dtype == at::kBFloat16) {
+      cast_narrow_impl(
+          output.data_ptr<at::BFloat16>(),
+          input.data_ptr<float>(),
+          numel,
+          stream);
+    } else {
+      cast_narrow_impl(
+          output.data_ptr<at::Half>(), input.data_ptr<float>(), numel, stream);
+    }
+  } else {
+    if (src_type == at::kBFloat16) {
+      cast_widen_impl(
+          output.data_ptr<float>(),
+          input.data_ptr<at::BFloat16>(),
+          numel,
+          stream);
+    } else {
+      cast_widen_impl(
+          output.data_ptr<float>(), input.data_ptr<at::Half>(), numel, stream);
+    }
+  }
+  return output;
+}
+
+#else
+
+at::Tensor cast_convert_kernel_impl(
+    const at::Tensor& input,
+    at::ScalarType dtype) {
+  return input.to(dtype);
+}
+
+#endif
+
+} // anonymous namespace
+
+IPEX_REGISTER_DISPATCH(cast_convert_kernel_stub, &cast_convert_kernel_impl);
+
+} // namespace cpu
+} // namespace torch_ipex
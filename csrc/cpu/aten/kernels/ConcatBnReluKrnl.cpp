@@ -68,13 +68,13 @@ at::Tensor concat_bn_relu_kernel_impl(
   std::vector<int64_t> output_dim = a[0].sizes().vec();
   int64_t tensor_length = a[0].ndimension();
 
-  // Check if the memory format is channelslast(3d) and if the channel size can
-  // be divided by 16
+  // Check if the memory format is channelslast(3d); the channel counts may
+  // be arbitrary since the vectorized kernel handles tails with masked
+  // loads/stores.
   auto check_format_channelsize = [](at::Tensor tensor) {
     return (
-        (tensor.suggest_memory_format() == at::MemoryFormat::ChannelsLast ||
-         tensor.suggest_memory_format() == at::MemoryFormat::ChannelsLast3d) &&
-        tensor.size(1) % 16 == 0);
+        tensor.suggest_memory_format() == at::MemoryFormat::ChannelsLast ||
+        tensor.suggest_memory_format() == at::MemoryFormat::ChannelsLast3d);
   };
 
   // Check the first tensor
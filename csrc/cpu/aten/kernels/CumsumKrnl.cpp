@@ -84,14 +84,13 @@ static inline void cumsum_lastdim_kernel(
       }
     });
 
-    // update offset value for each thread
+    // turn the per-thread partial sums into exclusive offsets
     for (int64_t m = 0; m < M; m++) {
-      for (int64_t t = T - 1; t >= 0; t--) {
-        scalar_t offset = scalar_t(0);
-        for (int64_t i = t - 1; i >= 0; i--) {
-          offset += inner_offsets[m * T + i];
-        }
-        inner_offsets[m * T + t] = offset;
+      scalar_t running = scalar_t(0);
+      for (int64_t t = 0; t < T; t++) {
+        scalar_t partial = inner_offsets[m * T + t];
+        inner_offsets[m * T + t] = running;
+        running += partial;
       }
     }
 
@@ -142,7 +141,8 @@ bool cumsum_fast_path(
     return false;
   // check dtype enabled
   bool is_dtype_enabled = out_dtype == at::ScalarType::Double ||
-      out_dtype == at::ScalarType::Float || out_dtype == at::ScalarType::Long;
+      out_dtype == at::ScalarType::Float || out_dtype == at::ScalarType::Long ||
+      out_dtype == at::ScalarType::Int;
   if (!is_dtype_enabled)
     return false;
   return true;
@@ -161,10 +161,12 @@ class NewCumSumOp : public torch::autograd::Function<NewCumSumOp> {
       at::native::resize_output(result, self.sizes());
     }
     if (cumsum_fast_path(result, self, dim, dtype)) {
-      AT_DISPATCH_FLOATING_TYPES_AND(
-          at::ScalarType::Long, self.scalar_type(), "cumsum_lastdim_cpu", [&] {
-            cumsum_lastdim_kernel<scalar_t>(result, self, dim);
-          });
+      AT_DISPATCH_FLOATING_TYPES_AND2(
+          at::ScalarType::Long,
+          at::ScalarType::Int,
+          self.scalar_type(),
+          "cumsum_lastdim_cpu",
+          [&] { cumsum_lastdim_kernel<scalar_t>(result, self, dim); });
       return result;
     }
     return at::cumsum_out(result, self, dim, dtype);
@@ -1,5 +1,6 @@
 #include <aten/DivSoftmax.h>
 
+#include "utils/workspace.h"
 #include "vec/vec.h"
 
 namespace torch_ipex {
@@ -7,7 +8,7 @@ namespace cpu {
 
 namespace {
 
-#if defined(CPU_CAPABILITY_AVX512)
+#if defined(CPU_CAPABILITY_AVX512) || defined(CPU_CAPABILITY_AVX2)
 using namespace torch_ipex::cpu::kernel;
 /**
  * @brief This function is caculating the loop unit offset for current loop idx
@@ -148,8 +149,8 @@ at::Tensor dil_div_maskfill_softmax(
   at::parallel_for(0, outer_size, grain_size, [&](int64_t begin, int64_t end) {
     float val = 0.0;
     int64_t b_offset = 0;
-    at::Tensor tmp_out = at::empty({dim_size});
-    float* tmp_out_ptr = tmp_out.data_ptr<float>();
+    float* tmp_out_ptr = static_cast<float*>(
+        get_thread_local_workspace(dim_size * sizeof(float)));
     for (int64_t i = begin; i < end; i++) {
       if (need_broadcast) {
         b_offset =
@@ -198,7 +199,7 @@ at::Tensor div_maskedfill_softmax_kernel_impl(
     const at::IntArrayRef& mask_shape,
     const float& fill,
     const float& dim_per_head) {
-#if defined(CPU_CAPABILITY_AVX512)
+#if defined(CPU_CAPABILITY_AVX512) || defined(CPU_CAPABILITY_AVX2)
   if (a.scalar_type() == at::kFloat) {
     return dil_div_maskfill_softmax<float>(a, b, fill, dim_per_head);
   } else if (a.scalar_type() == at::kBFloat16) {
@@ -0,0 +1,433 @@
+#include <aten/AddLayerNorm.h>
+#include <aten/DropoutAddLayerNorm.h>
+
+#include <ATen/CPUGeneratorImpl.h>
+#include <torch/csrc/autograd/function.h>
+#include "utils/workspace.h"
+#include "vec/vec.h"
+
+namespace torch_ipex {
+namespace cpu {
+
+namespace {
+
+// Draws the base seed for one forward call from the default CPU
+// generator, so the fused op stays deterministic under
+// torch.manual_seed. Each row then reads its own Philox4x32 counter
+// stream addressed by (seed, row), making the result independent of the
+// thread partitioning with no shared generator state.
+uint64_t dropout_base_seed() {
+  auto gen = at::get_generator_or_default<at::CPUGeneratorImpl>(
+      c10::nullopt, at::detail::getDefaultCPUGenerator());
+  std::lock_guard<std::mutex> lock(gen->mutex_);
+  return gen->random64();
+}
+
+#if defined(CPU_CAPABILITY_AVX512)
+template <typename T, typename T1>
+void DropoutAddLayerNormFwdKernelImpl(
+    const at::Tensor& a,
+    const at::Tensor& b,
+    double p,
+    const at::Tensor& gamma,
+    const at::Tensor& beta,
+    int64_t M,
+    int64_t N,
+    float eps,
+    at::Tensor& Y,
+    at::Tensor& X,
+    at::Tensor& mask,
+    at::Tensor& mean,
+    at::Tensor& rstd) {
+  const T* a_data = a.data_ptr<T>();
+  const T* b_data = b.data_ptr<T>();
+  const T1* gamma_data = gamma.defined() ? gamma.data_ptr<T1>() : nullptr;
+  const T1* beta_data = beta.defined() ? beta.data_ptr<T1>() : nullptr;
+  T* Y_data = Y.data_ptr<T>();
+  T* X_data = X.data_ptr<T>();
+  uint8_t* mask_data = mask.data_ptr<uint8_t>();
+  float* mean_data = mean.data_ptr<float>();
+  float* rstd_data = rstd.data_ptr<float>();
+  const int64_t mask_stride = (N + 7) / 8;
+  const float c = float(1) / static_cast<float>(N);
+  const float scale = p == 0 ? float(1) : float(1) / (float(1) - (float)p);
+  // keep an element when the 32-bit draw is >= p * 2^32
+  const uint32_t threshold = (uint32_t)(p * 4294967296.0);
+  const uint64_t seed = dropout_base_seed();
+  at::parallel_for(0, M, 1, [&](int64_t start, int64_t end) {
+    float* tmp_out_ptr =
+        static_cast<float*>(get_thread_local_workspace(N * sizeof(float)));
+    for (const auto i : c10::irange(start, end)) {
+      float mean_val;
+      float rstd_val;
+      std::tie(mean_val, rstd_val) =
+          kernel::_dropout_add_and_compute_mean_var<T>(
+              a_data + i * N,
+              b_data + i * N,
+              N,
+              scale,
+              threshold,
+              seed,
+              (uint64_t)i,
+              mask_data + i * mask_stride,
+              tmp_out_ptr);
+      rstd_val = std::max(rstd_val * c - mean_val * mean_val, float(0));
+      rstd_val = float(1.0) / std::sqrt(rstd_val + eps);
+      mean_data[i] = mean_val;
+      rstd_data[i] = rstd_val;
+      kernel::move_ker<T, float>(X_data + i * N, tmp_out_ptr, N);
+      kernel::_normalize_kernel<T, T1>(
+          Y_data + i * N,
+          tmp_out_ptr,
+          N,
+          rstd_val,
+          -rstd_val * mean_val,
+          gamma_data,
+          beta_data);
+    }
+  });
+}
+
+template <typename T, typename T1>
+void DropoutAddLayerNormBwdKernelImpl(
+    const at::Tensor& dY,
+    const at::Tensor& X,
+    const at::Tensor& mask,
+    const at::Tensor& mean,
+    const at::Tensor& rstd,
+    const at::Tensor& gamma,
+    double p,
+    int64_t M,
+    int64_t N,
+    at::Tensor& dA,
+    at::Tensor& dB,
+    at::Tensor& dgamma,
+    at::Tensor& dbeta) {
+  const T* dY_data = dY.data_ptr<T>();
+  const T* X_data = X.data_ptr<T>();
+  const uint8_t* mask_data = mask.data_ptr<uint8_t>();
+  const float* mean_data = mean.data_ptr<float>();
+  const float* rstd_data = rstd.data_ptr<float>();
+  const T1* gamma_data = gamma.defined() ? gamma.data_ptr<T1>() : nullptr;
+  T* dA_data = dA.data_ptr<T>();
+  T* dB_data = dB.data_ptr<T>();
+  const int64_t mask_stride = (N + 7) / 8;
+  const float c = float(1) / static_cast<float>(N);
+  const float scale = p == 0 ? float(1) : float(1) / (float(1) - (float)p);
+  const bool param_grads = dgamma.defined();
+  // fp32 per-thread accumulators for dgamma/dbeta, reduced once at the
+  // end like the stock layer_norm backward kernel
+  const int num_threads = at::get_num_threads();
+  at::Tensor buf;
+  float* buf_data = nullptr;
+  if (param_grads) {
+    buf = at::zeros({num_threads, 2, N}, mean.options());
+    buf_data = buf.data_ptr<float>();
+  }
+  at::parallel_for(0, M, 1, [&](int64_t start, int64_t end) {
+    float* dgamma_acc = nullptr;
+    float* dbeta_acc = nullptr;
+    if (param_grads) {
+      dgamma_acc = buf_data + at::get_thread_num() * 2 * N;
+      dbeta_acc = dgamma_acc + N;
+    }
+    for (const auto i : c10::irange(start, end)) {
+      const T* dy_ptr = dY_data + i * N;
+      const T* x_ptr = X_data + i * N;
+      auto sums = kernel::_ln_bwd_reduce<T, T1>(
+          dy_ptr, x_ptr, gamma_data, N, mean_data[i], rstd_data[i]);
+      kernel::_ln_dropout_bwd_apply<T, T1>(
+          dA_data + i * N,
+          dB_data + i * N,
+          dy_ptr,
+          x_ptr,
+          gamma_data,
+          mask_data + i * mask_stride,
+          N,
+          mean_data[i],
+          rstd_data[i],
+          sums.first * c,
+          sums.second * c,
+          scale);
+      if (param_grads) {
+        kernel::_ln_param_grad_acc<T>(
+            dgamma_acc, dbeta_acc, dy_ptr, x_ptr, N, mean_data[i], rstd_data[i]);
+      }
+    }
+  });
+  if (param_grads) {
+    dgamma.copy_(buf.select(1, 0).sum(0));
+    dbeta.copy_(buf.select(1, 1).sum(0));
+  }
+}
+#endif
+
+// Unpacks the bit mask into a float {M, N} tensor of 0/1 keep flags for
+// the composed fallback paths.
+at::Tensor unpack_dropout_mask(
+    const at::Tensor& mask,
+    int64_t M,
+    int64_t N) {
+  const int64_t mask_stride = (N + 7) / 8;
+  auto shifts = at::arange(8, mask.options());
+  auto bits = at::bitwise_and(
+      at::bitwise_right_shift(mask.view({M, mask_stride, 1}), shifts), 1);
+  return bits.view({M, mask_stride * 8})
+      .narrow(1, 0, N)
+      .to(at::kFloat);
+}
+
+std::tuple<at::Tensor, at::Tensor, at::Tensor, at::Tensor, at::Tensor>
+dropout_add_layer_norm_fwd_kernel_impl(
+    const at::Tensor& a,
+    const at::Tensor& b,
+    double p,
+    at::IntArrayRef normalized_shape,
+    const c10::optional<at::Tensor>& weight_opt,
+    const c10::optional<at::Tensor>& bias_opt,
+    float eps) {
+  c10::MaybeOwned<at::Tensor> weight_maybe_owned =
+      at::borrow_from_optional_tensor(weight_opt);
+  const at::Tensor& weight = *weight_maybe_owned;
+  c10::MaybeOwned<at::Tensor> bias_maybe_owned =
+      at::borrow_from_optional_tensor(bias_opt);
+  const at::Tensor& bias = *bias_maybe_owned;
+
+  auto M_N = _check_layer_norm_inputs(a, normalized_shape, weight, bias);
+  auto M = M_N.first;
+  auto N = M_N.second;
+  const int64_t mask_stride = (N + 7) / 8;
+  auto A = a.contiguous();
+  auto B = b.contiguous();
+  auto gamma = weight.expect_contiguous();
+  auto beta = bias.expect_contiguous();
+
+#if defined(CPU_CAPABILITY_AVX512)
+  bool can_fuse =
+      (a.scalar_type() == at::kFloat && b.scalar_type() == at::kFloat) ||
+      (a.scalar_type() == at::kBFloat16 && b.scalar_type() == at::kBFloat16) ||
+      (a.scalar_type() == at::kHalf && b.scalar_type() == at::kHalf);
+  if (can_fuse) {
+    at::Tensor Y = at::native::empty_like(
+        A,
+        c10::nullopt /* dtype */,
+        c10::nullopt /* layout */,
+        c10::nullopt /* device */,
+        c10::nullopt /* pin_memory */,
+        at::MemoryFormat::Contiguous);
+    at::Tensor X = at::native::empty_like(
+        A,
+        c10::nullopt /* dtype */,
+        c10::nullopt /* layout */,
+        c10::nullopt /* device */,
+        c10::nullopt /* pin_memory */,
+        at::MemoryFormat::Contiguous);
+    at::Tensor mask = at::empty(
+        {M, mask_stride}, A.options().dtype(at::kByte));
+    at::Tensor mean = at::empty({M}, A.options().dtype(at::kFloat));
+    at::Tensor rstd = at::empty({M}, A.options().dtype(at::kFloat));
+    if (a.scalar_type() == at::kFloat) {
+      DropoutAddLayerNormFwdKernelImpl<float, float>(
+          A, B, p, *gamma, *beta, M, N, eps, Y, X, mask, mean, rstd);
+    } else if (a.scalar_type() == at::kBFloat16) {
+      if (weight.defined() && weight.scalar_type() == at::kBFloat16) {
+        DropoutAddLayerNormFwdKernelImpl<at::BFloat16, at::BFloat16>(
+            A, B, p, *gamma, *beta, M, N, eps, Y, X, mask, mean, rstd);
+      } else {
+        DropoutAddLayerNormFwdKernelImpl<at::BFloat16, float>(
+            A, B, p, *gamma, *beta, M, N, eps, Y, X, mask, mean, rstd);
+      }
+    } else {
+      if (weight.defined() && weight.scalar_type() == at::kHalf) {
+        DropoutAddLayerNormFwdKernelImpl<at::Half, at::Half>(
+            A, B, p, *gamma, *beta, M, N, eps, Y, X, mask, mean, rstd);
+      } else {
+        DropoutAddLayerNormFwdKernelImpl<at::Half, float>(
+            A, B, p, *gamma, *beta, M, N, eps, Y, X, mask, mean, rstd);
+      }
+    }
+    return std::make_tuple(Y, X, mask, mean, rstd);
+  }
+#endif
+  // composed fallback, still returning the bit-packed mask layout
+  auto dropout = at::native_dropout(A, p, /* train */ true);
+  auto X = at::add(std::get<0>(dropout), B);
+  auto keep = std::get<1>(dropout).view({M, N});
+  at::Tensor mask =
+      at::zeros({M, mask_stride}, A.options().dtype(at::kByte));
+  const bool* keep_data = keep.data_ptr<bool>();
+  uint8_t* mask_data = mask.data_ptr<uint8_t>();
+  at::parallel_for(0, M, 1, [&](int64_t start, int64_t end) {
+    for (const auto i : c10::irange(start, end)) {
+      for (int64_t j = 0; j < N; j++) {
+        mask_data[i * mask_stride + j / 8] |=
+            (uint8_t)keep_data[i * N + j] << (j % 8);
+      }
+    }
+  });
+  auto ln =
+      at::native_layer_norm(X, normalized_shape, weight_opt, bias_opt, eps);
+  return std::make_tuple(
+      std::get<0>(ln),
+      X,
+      mask,
+      std::get<1>(ln).view({M}).to(at::kFloat),
+      std::get<2>(ln).view({M}).to(at::kFloat));
+}
+
+std::tuple<at::Tensor, at::Tensor, at::Tensor, at::Tensor>
+dropout_add_layer_norm_bwd_kernel_impl(
+    const at::Tensor& grad_out,
+    const at::Tensor& dropout_add_out,
+    const at::Tensor& mask,
+    const at::Tensor& mean,
+    const at::Tensor& rstd,
+    double p,
+    at::IntArrayRef normalized_shape,
+    const c10::optional<at::Tensor>& weight_opt) {
+  c10::MaybeOwned<at::Tensor> weight_maybe_owned =
+      at::borrow_from_optional_tensor(weight_opt);
+  const at::Tensor& weight = *weight_maybe_owned;
+
+  auto M = mean.numel();
+  const int64_t N = c10::multiply_integers(normalized_shape);
+  auto dY = grad_out.contiguous();
+  auto X = dropout_add_out.contiguous();
+  auto gamma = weight.expect_contiguous();
+
+  at::Tensor dA = at::native::empty_like(
+      X,
+      c10::nullopt /* dtype */,
+      c10::nullopt /* layout */,
+      c10::nullopt /* device */,
+      c10::nullopt /* pin_memory */,
+      at::MemoryFormat::Contiguous);
+  at::Tensor dB = at::native::empty_like(
+      X,
+      c10::nullopt /* dtype */,
+      c10::nullopt /* layout */,
+      c10::nullopt /* device */,
+      c10::nullopt /* pin_memory */,
+      at::MemoryFormat::Contiguous);
+  at::Tensor dgamma;
+  at::Tensor dbeta;
+
+#if defined(CPU_CAPABILITY_AVX512)
+  bool can_fuse = dY.scalar_type() == at::kFloat ||
+      dY.scalar_type() == at::kBFloat16 || dY.scalar_type() == at::kHalf;
+  if (can_fuse) {
+    at::Tensor dgamma_f = weight.defined()
+        ? at::empty({N}, mean.options())
+        : at::Tensor();
+    at::Tensor dbeta_f =
+        weight.defined() ? at::empty({N}, mean.options()) : at::Tensor();
+    if (dY.scalar_type() == at::kFloat) {
+      DropoutAddLayerNormBwdKernelImpl<float, float>(
+          dY, X, mask, mean, rstd, *gamma, p, M, N, dA, dB, dgamma_f, dbeta_f);
+    } else if (dY.scalar_type() == at::kBFloat16) {
+      if (weight.defined() && weight.scalar_type() == at::kBFloat16) {
+        DropoutAddLayerNormBwdKernelImpl<at::BFloat16, at::BFloat16>(
+            dY,
+            X,
+            mask,
+            mean,
+            rstd,
+            *gamma,
+            p,
+            M,
+            N,
+            dA,
+            dB,
+            dgamma_f,
+            dbeta_f);
+      } else {
+        DropoutAddLayerNormBwdKernelImpl<at::BFloat16, float>(
+            dY,
+            X,
+            mask,
+            mean,
+            rstd,
+            *gamma,
+            p,
+            M,
+            N,
+            dA,
+            dB,
+            dgamma_f,
+            dbeta_f);
+      }
+    } else {
+      if (weight.defined() && weight.scalar_type() == at::kHalf) {
+        DropoutAddLayerNormBwdKernelImpl<at::Half, at::Half>(
+            dY,
+            X,
+            mask,
+            mean,
+            rstd,
+            *gamma,
+            p,
+            M,
+            N,
+            dA,
+            dB,
+            dgamma_f,
+            dbeta_f);
+      } else {
+        DropoutAddLayerNormBwdKernelImpl<at::Half, float>(
+            dY,
+            X,
+            mask,
+            mean,
+            rstd,
+            *gamma,
+            p,
+            M,
+            N,
+            dA,
+            dB,
+            dgamma_f,
+            dbeta_f);
+      }
+    }
+    if (weight.defined()) {
+      dgamma = dgamma_f.to(weight.scalar_type()).view(normalized_shape);
+      dbeta = dbeta_f.to(weight.scalar_type()).view(normalized_shape);
+    }
+    return std::make_tuple(dA, dB, dgamma, dbeta);
+  }
+#endif
+  // composed fallback
+  const float scale = p == 0 ? float(1) : float(1) / (float(1) - (float)p);
+  auto xf = X.view({M, N}).to(at::kFloat);
+  auto dyf = dY.view({M, N}).to(at::kFloat);
+  auto xhat = (xf - mean.view({M, 1})) * rstd.view({M, 1});
+  auto g = weight.defined()
+      ? dyf * weight.to(at::kFloat).view({1, N})
+      : dyf;
+  auto c1 = (g * xhat).mean(-1, /* keepdim */ true);
+  auto c2 = g.mean(-1, /* keepdim */ true);
+  auto dx = (g - xhat * c1 - c2) * rstd.view({M, 1});
+  auto keep = unpack_dropout_mask(mask, M, N);
+  dB.copy_(dx.view_as(X));
+  dA.copy_((dx * keep * scale).view_as(X));
+  if (weight.defined()) {
+    dgamma = (dyf * xhat)
+                 .sum(0)
+                 .to(weight.scalar_type())
+                 .view(normalized_shape);
+    dbeta = dyf.sum(0).to(weight.scalar_type()).view(normalized_shape);
+  }
+  return std::make_tuple(dA, dB, dgamma, dbeta);
+}
+
+} // anonymous namespace
+
+IPEX_REGISTER_DISPATCH(
+    dropout_add_layer_norm_fwd_kernel_stub,
+    &dropout_add_layer_norm_fwd_kernel_impl);
+IPEX_REGISTER_DISPATCH(
+    dropout_add_layer_norm_bwd_kernel_stub,
+    &dropout_add_layer_norm_bwd_kernel_impl);
+
+} // namespace cpu
+} // namespace torch_ipex
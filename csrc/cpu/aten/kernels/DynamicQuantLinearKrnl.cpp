@@ -0,0 +1,191 @@
+#include <ATen/ATen.h>
+#include <ATen/Parallel.h>
+#include <aten/Linear.h>
+#include <torch/all.h>
+#include <cfloat>
+#include <cmath>
+#if defined(CPU_CAPABILITY_AVX512)
+#include <immintrin.h>
+#endif
+
+namespace torch_ipex {
+namespace cpu {
+
+namespace {
+
+// Dynamic INT8 linear: each activation row is quantized on the fly from
+// its own min/max (asymmetric u8, so vpdpbusd's unsigned left operand
+// comes for free), the GEMM accumulates u8*s8 into i32 and the epilogue
+// dequantizes with the per-channel weight scale and the zero-point
+// compensation term sum_k(qw[n][k]) prepared at weight prepack time:
+//
+//   out[m][n] = scale_a[m] * scale_w[n] * (acc[m][n] - zp_a[m] * comp[n])
+//
+// The min/max pass and the row quantization are vectorized with AVX512;
+// the dot product uses AVX512-VNNI when the build has it.
+
+inline void row_min_max(const float* x, int64_t K, float& mn, float& mx) {
+  mn = FLT_MAX;
+  mx = -FLT_MAX;
+  int64_t k = 0;
+#if defined(CPU_CAPABILITY_AVX512)
+  if (K >= 16) {
+    __m512 vmin = _mm512_set1_ps(FLT_MAX);
+    __m512 vmax = _mm512_set1_ps(-FLT_MAX);
+    for (; k + 16 <= K; k += 16) {
+      __m512 v = _mm512_loadu_ps(x + k);
+      vmin = _mm512_min_ps(vmin, v);
+      vmax = _mm512_max_ps(vmax, v);
+    }
+    mn = _mm512_reduce_min_ps(vmin);
+    mx = _mm512_reduce_max_ps(vmax);
+  }
+#endif
+  for (; k < K; k++) {
+    mn = std::min(mn, x[k]);
+    mx = std::max(mx, x[k]);
+  }
+}
+
+inline void quantize_row_u8(
+    const float* x,
+    int64_t K,
+    float inv_scale,
+    int32_t zp,
+    uint8_t* q) {
+  int64_t k = 0;
+#if defined(CPU_CAPABILITY_AVX512)
+  __m512 vinv = _mm512_set1_ps(inv_scale);
+  __m512i vzp = _mm512_set1_epi32(zp);
+  for (; k + 16 <= K; k += 16) {
+    __m512 v = _mm512_mul_ps(_mm512_loadu_ps(x + k), vinv);
+    __m512i vi = _mm512_add_epi32(_mm512_cvtps_epi32(v), vzp);
+    vi = _mm512_max_epi32(vi, _mm512_setzero_si512());
+    // cvtusepi32 saturates anything above 255 for us.
+    _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(q + k), _mm512_cvtusepi32_epi8(vi));
+  }
+#endif
+  for (; k < K; k++) {
+    int32_t v = static_cast<int32_t>(std::nearbyint(x[k] * inv_scale)) + zp;
+    q[k] = static_cast<uint8_t>(std::min(std::max(v, 0), 255));
+  }
+}
+
+inline int32_t dot_u8s8(const uint8_t* a, const int8_t* w, int64_t K) {
+  int32_t sum = 0;
+  int64_t k = 0;
+#if defined(CPU_CAPABILITY_AVX512_VNNI)
+  if (K >= 64) {
+    __m512i acc = _mm512_setzero_si512();
+    for (; k + 64 <= K; k += 64) {
+      __m512i va =
+          _mm512_loadu_si512(reinterpret_cast<const __m512i*>(a + k));
+      __m512i vw =
+          _mm512_loadu_si512(reinterpret_cast<const __m512i*>(w + k));
+      acc = _mm512_dpbusd_epi32(acc, va, vw);
+    }
+    sum = _mm512_reduce_add_epi32(acc);
+  }
+#endif
+  for (; k < K; k++) {
+    sum += static_cast<int32_t>(a[k]) * static_cast<int32_t>(w[k]);
+  }
+  return sum;
+}
+
+at::Tensor dyn_quant_linear_kernel_impl(
+    const at::Tensor& input,
+    const at::Tensor& qweight,
+    const at::Tensor& weight_scales,
+    const at::Tensor& weight_comp,
+    const c10::optional<at::Tensor>& bias) {
+  TORCH_CHECK(
+      input.scalar_type() == at::kFloat,
+      "dynamic_quant_linear: expect fp32 input");
+  TORCH_CHECK(
+      qweight.dim() == 2 && qweight.scalar_type() == at::kChar,
+      "dynamic_quant_linear: expect a 2-D int8 weight");
+  auto N = qweight.size(0);
+  auto K = qweight.size(1);
+  TORCH_CHECK(
+      input.size(input.dim() - 1) == K,
+      "dynamic_quant_linear: input and weight shapes mismatch");
+  TORCH_CHECK(
+      weight_scales.scalar_type() == at::kFloat &&
+          weight_scales.numel() == N,
+      "dynamic_quant_linear: expect fp32 weight scales of size N");
+  TORCH_CHECK(
+      weight_comp.scalar_type() == at::kInt && weight_comp.numel() == N,
+      "dynamic_quant_linear: expect int32 weight compensation of size N");
+
+  auto input_ = input.contiguous();
+  auto qweight_ = qweight.contiguous();
+  auto scales_ = weight_scales.contiguous();
+  auto comp_ = weight_comp.contiguous();
+  int64_t M = input_.numel() / K;
+
+  auto output_sizes = input.sizes().vec();
+  output_sizes.back() = N;
+  auto output = at::empty(output_sizes, input.options());
+
+  at::Tensor bias_;
+  const float* bias_ptr = nullptr;
+  if (bias.has_value() && bias.value().defined()) {
+    bias_ = bias.value().contiguous();
+    TORCH_CHECK(
+        bias_.scalar_type() == at::kFloat && bias_.numel() == N,
+        "dynamic_quant_linear: expect fp32 bias of size N");
+    bias_ptr = bias_.data_ptr<float>();
+  }
+
+  const float* in_ptr = input_.data_ptr<float>();
+  const int8_t* w_ptr = qweight_.data_ptr<int8_t>();
+  const float* ws_ptr = scales_.data_ptr<float>();
+  const int32_t* comp_ptr = comp_.data_ptr<int32_t>();
+  float* out_ptr = output.data_ptr<float>();
+
+  at::parallel_for(0, M, 1, [&](int64_t begin, int64_t end) {
+    std::vector<uint8_t> qrow(K);
+    for (int64_t m = begin; m < end; m++) {
+      const float* row = in_ptr + m * K;
+      float* out_row = out_ptr + m * N;
+
+      float mn, mx;
+      row_min_max(row, K, mn, mx);
+      // The u8 grid must be able to represent zero exactly, otherwise
+      // constant rows dequantize to garbage.
+      mn = std::min(mn, 0.f);
+      mx = std::max(mx, 0.f);
+      float scale = (mx - mn) / 255.f;
+      if (scale < 1e-20f) {
+        // All-zero row: the GEMM contributes nothing.
+        for (int64_t n = 0; n < N; n++) {
+          out_row[n] = bias_ptr != nullptr ? bias_ptr[n] : 0.f;
+        }
+        continue;
+      }
+      float inv_scale = 1.f / scale;
+      int32_t zp = static_cast<int32_t>(std::nearbyint(-mn * inv_scale));
+      zp = std::min(std::max(zp, 0), 255);
+      quantize_row_u8(row, K, inv_scale, zp, qrow.data());
+
+      for (int64_t n = 0; n < N; n++) {
+        int32_t acc = dot_u8s8(qrow.data(), w_ptr + n * K, K);
+        float v = scale * ws_ptr[n] *
+            static_cast<float>(acc - zp * comp_ptr[n]);
+        out_row[n] = bias_ptr != nullptr ? v + bias_ptr[n] : v;
+      }
+    }
+  });
+  return output;
+}
+
+} // namespace
+
+IPEX_REGISTER_DISPATCH(
+    dyn_quant_linear_kernel_stub,
+    &dyn_quant_linear_kernel_impl);
+
+} // namespace cpu
+} // namespace torch_ipex
@@ -0,0 +1,342 @@
+#include <aten/EltwiseChain.h>
+
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec/functional.h>
+#include <ATen/cpu/vec/vec.h>
+#include "utils/math_precision.h"
+
+namespace torch_ipex {
+namespace cpu {
+
+namespace {
+
+using fVec = at::vec::Vectorized<float>;
+
+// Order-7 Lambert continued-fraction (Pade) tanh used by the LOW
+// precision class: no exp, absolute error below ~1e-4 after clamping,
+// roughly 2x faster than the full-precision lane tanh. HIGH and MEDIUM
+// keep the accurate routines, so default numerics are unchanged.
+inline fVec tanh_approx_vec(fVec x) {
+  fVec x2 = x * x;
+  fVec numerator = x *
+      (fVec(135135.f) +
+       x2 * (fVec(17325.f) + x2 * (fVec(378.f) + x2)));
+  fVec denominator = fVec(135135.f) +
+      x2 * (fVec(62370.f) + x2 * (fVec(3150.f) + x2 * fVec(28.f)));
+  return at::vec::minimum(
+      at::vec::maximum(numerator / denominator, fVec(-1.f)), fVec(1.f));
+}
+
+inline float tanh_approx_scalar(float x) {
+  float x2 = x * x;
+  float numerator = x * (135135.f + x2 * (17325.f + x2 * (378.f + x2)));
+  float denominator = 135135.f + x2 * (62370.f + x2 * (3150.f + x2 * 28.f));
+  return std::min(std::max(numerator / denominator, -1.f), 1.f);
+}
+
+// Conversion pair for the reduced floating point types; the chain math
+// itself always runs on fp32 lanes.
+template <typename T>
+struct ChainVecCvt;
+
+template <>
+struct ChainVecCvt<at::BFloat16> {
+  static inline std::tuple<fVec, fVec> to_float(
+      const at::vec::Vectorized<at::BFloat16>& v) {
+    return at::vec::convert_bfloat16_float(v);
+  }
+  static inline at::vec::Vectorized<at::BFloat16> from_float(
+      const fVec& a,
+      const fVec& b) {
+    return at::vec::convert_float_bfloat16(a, b);
+  }
+};
+
+template <>
+struct ChainVecCvt<at::Half> {
+  static inline std::tuple<fVec, fVec> to_float(
+      const at::vec::Vectorized<at::Half>& v) {
+    return at::vec::convert_half_float(v);
+  }
+  static inline at::vec::Vectorized<at::Half> from_float(
+      const fVec& a,
+      const fVec& b) {
+    return at::vec::convert_float_half(a, b);
+  }
+};
+
+// The "compiled" chain: the opcode list is interpreted once per vector
+// register, so the whole sequence costs a single load and store per
+// element regardless of its length.
+inline fVec apply_chain_vec(
+    fVec v,
+    at::IntArrayRef ops,
+    at::ArrayRef<double> alphas,
+    MathPrecisionClass precision) {
+  for (size_t i = 0; i < ops.size(); ++i) {
+    switch (static_cast<EltwiseChainOp>(ops[i])) {
+      case EltwiseChainOp::kRelu:
+        v = at::vec::maximum(v, fVec(0.f));
+        break;
+      case EltwiseChainOp::kSigmoid:
+        if (precision == MathPrecisionClass::LOW) {
+          v = fVec(0.5f) + fVec(0.5f) * tanh_approx_vec(v * fVec(0.5f));
+        } else {
+          v = fVec(1.f) / (fVec(1.f) + v.neg().exp());
+        }
+        break;
+      case EltwiseChainOp::kTanh:
+        v = precision == MathPrecisionClass::LOW ? tanh_approx_vec(v)
+                                                 : v.tanh();
+        break;
+      case EltwiseChainOp::kExp:
+        v = v.exp();
+        break;
+      case EltwiseChainOp::kLog:
+        v = v.log();
+        break;
+      case EltwiseChainOp::kSqrt:
+        v = v.sqrt();
+        break;
+      case EltwiseChainOp::kAbs:
+        v = v.abs();
+        break;
+      case EltwiseChainOp::kNeg:
+        v = v.neg();
+        break;
+      case EltwiseChainOp::kSquare:
+        v = v * v;
+        break;
+      case EltwiseChainOp::kAddScalar:
+        v = v + fVec(static_cast<float>(alphas[i]));
+        break;
+      case EltwiseChainOp::kMulScalar:
+        v = v * fVec(static_cast<float>(alphas[i]));
+        break;
+      case EltwiseChainOp::kClampMin:
+        v = at::vec::maximum(v, fVec(static_cast<float>(alphas[i])));
+        break;
+      case EltwiseChainOp::kClampMax:
+        v = at::vec::minimum(v, fVec(static_cast<float>(alphas[i])));
+        break;
+      default:
+        TORCH_CHECK(false, "eltwise_chain: unknown opcode ", ops[i]);
+    }
+  }
+  return v;
+}
+
+inline float apply_chain_scalar(
+    float x,
+    at::IntArrayRef ops,
+    at::ArrayRef<double> alphas,
+    MathPrecisionClass precision) {
+  for (size_t i = 0; i < ops.size(); ++i) {
+    switch (static_cast<EltwiseChainOp>(ops[i])) {
+      case EltwiseChainOp::kRelu:
+        x = std::max(x, 0.f);
+        break;
+      case EltwiseChainOp::kSigmoid:
+        if (precision == MathPrecisionClass::LOW) {
+          x = 0.5f + 0.5f * tanh_approx_scalar(0.5f * x);
+        } else {
+          x = 1.f / (1.f + std::exp(-x));
+        }
+        break;
+      case EltwiseChainOp::kTanh:
+        x = precision == MathPrecisionClass::LOW ? tanh_approx_scalar(x)
+                                                 : std::tanh(x);
+        break;
+      case EltwiseChainOp::kExp:
+        x = std::exp(x);
+        break;
+      case EltwiseChainOp::kLog:
+        x = std::log(x);
+        break;
+      case EltwiseChainOp::kSqrt:
+        x = std::sqrt(x);
+        break;
+      case EltwiseChainOp::kAbs:
+        x = std::abs(x);
+        break;
+      case EltwiseChainOp::kNeg:
+        x = -x;
+        break;
+      case EltwiseChainOp::kSquare:
+        x = x * x;
+        break;
+      case EltwiseChainOp::kAddScalar:
+        x = x + static_cast<float>(alphas[i]);
+        break;
+      case EltwiseChainOp::kMulScalar:
+        x = x * static_cast<float>(alphas[i]);
+        break;
+      case EltwiseChainOp::kClampMin:
+        x = std::max(x, static_cast<float>(alphas[i]));
+        break;
+      case EltwiseChainOp::kClampMax:
+        x = std::min(x, static_cast<float>(alphas[i]));
+        break;
+      default:
+        TORCH_CHECK(false, "eltwise_chain: unknown opcode ", ops[i]);
+    }
+  }
+  return x;
+}
+
+void eltwise_chain_float(
+    float* out,
+    const float* in,
+    int64_t begin,
+    int64_t end,
+    at::IntArrayRef ops,
+    at::ArrayRef<double> alphas,
+    MathPrecisionClass precision) {
+  int64_t d = begin;
+  for (; d + fVec::size() <= end; d += fVec::size()) {
+    apply_chain_vec(fVec::loadu(in + d), ops, alphas, precision)
+        .store(out + d);
+  }
+  for (; d < end; ++d) {
+    out[d] = apply_chain_scalar(in[d], ops, alphas, precision);
+  }
+}
+
+template <typename T>
+void eltwise_chain_reduced(
+    T* out,
+    const T* in,
+    int64_t begin,
+    int64_t end,
+    at::IntArrayRef ops,
+    at::ArrayRef<double> alphas,
+    MathPrecisionClass precision) {
+  using bVec = at::vec::Vectorized<T>;
+  int64_t d = begin;
+  for (; d + bVec::size() <= end; d += bVec::size()) {
+    fVec x0, x1;
+    std::tie(x0, x1) = ChainVecCvt<T>::to_float(bVec::loadu(in + d));
+    x0 = apply_chain_vec(x0, ops, alphas, precision);
+    x1 = apply_chain_vec(x1, ops, alphas, precision);
+    ChainVecCvt<T>::from_float(x0, x1).store(out + d);
+  }
+  for (; d < end; ++d) {
+    out[d] = static_cast<T>(apply_chain_scalar(
+        static_cast<float>(in[d]), ops, alphas, precision));
+  }
+}
+
+// Composed-aten fallback: replay the chain step by step with the ops it
+// was harvested from, so unsupported dtypes and layouts keep identical
+// semantics (including type promotion).
+at::Tensor apply_chain_fallback(
+    const at::Tensor& input,
+    at::IntArrayRef ops,
+    at::ArrayRef<double> alphas) {
+  at::Tensor x = input;
+  for (size_t i = 0; i < ops.size(); ++i) {
+    switch (static_cast<EltwiseChainOp>(ops[i])) {
+      case EltwiseChainOp::kRelu:
+        x = at::relu(x);
+        break;
+      case EltwiseChainOp::kSigmoid:
+        x = at::sigmoid(x);
+        break;
+      case EltwiseChainOp::kTanh:
+        x = at::tanh(x);
+        break;
+      case EltwiseChainOp::kExp:
+        x = at::exp(x);
+        break;
+      case EltwiseChainOp::kLog:
+        x = at::log(x);
+        break;
+      case EltwiseChainOp::kSqrt:
+        x = at::sqrt(x);
+        break;
+      case EltwiseChainOp::kAbs:
+        x = at::abs(x);
+        break;
+      case EltwiseChainOp::kNeg:
+        x = at::neg(x);
+        break;
+      case EltwiseChainOp::kSquare:
+        x = at::square(x);
+        break;
+      case EltwiseChainOp::kAddScalar:
+        x = at::add(x, alphas[i]);
+        break;
+      case EltwiseChainOp::kMulScalar:
+        x = at::mul(x, alphas[i]);
+        break;
+      case EltwiseChainOp::kClampMin:
+        x = at::clamp_min(x, alphas[i]);
+        break;
+      case EltwiseChainOp::kClampMax:
+        x = at::clamp_max(x, alphas[i]);
+        break;
+      default:
+        TORCH_CHECK(false, "eltwise_chain: unknown opcode ", ops[i]);
+    }
+  }
+  return x;
+}
+
+at::Tensor eltwise_chain_kernel_impl(
+    const at::Tensor& input,
+    at::IntArrayRef ops,
+    at::ArrayRef<double> alphas) {
+  auto scalar_type = input.scalar_type();
+  bool vectorizable = input.is_non_overlapping_and_dense() &&
+      (scalar_type == at::kFloat || scalar_type == at::kBFloat16 ||
+       scalar_type == at::kHalf);
+  if (!vectorizable) {
+    return apply_chain_fallback(input, ops, alphas);
+  }
+  // empty_like preserves the dense strides, so input and output can be
+  // walked with the same flat index whatever the memory format.
+  auto output = at::empty_like(input);
+  int64_t numel = input.numel();
+  // Resolve the precision scope here: it is thread-local and the
+  // parallel_for workers are not the thread that entered the scope.
+  auto precision = get_math_precision();
+  at::parallel_for(
+      0, numel, at::internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+        if (scalar_type == at::kFloat) {
+          eltwise_chain_float(
+              output.data_ptr<float>(),
+              input.data_ptr<float>(),
+              begin,
+              end,
+              ops,
+              alphas,
+              precision);
+        } else if (scalar_type == at::kBFloat16) {
+          eltwise_chain_reduced<at::BFloat16>(
+              output.data_ptr<at::BFloat16>(),
+              input.data_ptr<at::BFloat16>(),
+              begin,
+              end,
+              ops,
+              alphas,
+              precision);
+        } else {
+          eltwise_chain_reduced<at::Half>(
+              output.data_ptr<at::Half>(),
+              input.data_ptr<at::Half>(),
+              begin,
+              end,
+              ops,
+              alphas,
+              precision);
+        }
+      });
+  return output;
+}
+
+} // anonymous namespace
+
+IPEX_REGISTER_DISPATCH(eltwise_chain_kernel_stub, &eltwise_chain_kernel_impl);
+
+} // namespace cpu
+} // namespace torch_ipex
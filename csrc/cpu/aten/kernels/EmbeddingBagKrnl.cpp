@@ -68,6 +68,15 @@ static inline Tensor _embedding_bag_index_add_select_fast(
       auto inputs_start = offsets_data[i];
       auto inputs_end = i == last_offset ? last_index : offsets_data[i + 1];
       if (inputs_end - inputs_start == 1) {
+        // prefetch the row gathered kRowPrefetchDistance lookups later so
+        // dependent index loads overlap with the current bag
+        if (inputs_start + kRowPrefetchDistance < last_index) {
+          prefetch_row_ker(
+              &src_data
+                  [indices_accessor[inputs_start + kRowPrefetchDistance] *
+                   ddim],
+              ddim);
+        }
         T* select_data_ptr = &src_data[indices_accessor[inputs_start] * ddim];
         move_ker(out_data_ptr, select_data_ptr, ddim);
       } else {
@@ -75,6 +84,11 @@ static inline Tensor _embedding_bag_index_add_select_fast(
         acc_t temp_out[ddim];
         zero_ker(temp_out, ddim);
         for (int64_t s = inputs_start; s < inputs_end; s++) {
+          if (s + kRowPrefetchDistance < last_index) {
+            prefetch_row_ker(
+                &src_data[indices_accessor[s + kRowPrefetchDistance] * ddim],
+                ddim);
+          }
           T* select_data_ptr = &src_data[indices_accessor[s] * ddim];
           add_ker(temp_out, select_data_ptr, ddim);
         }
@@ -337,6 +351,12 @@ Tensor embedding_bag_int8_kernel_impl(
       } else {
         zero_ker(&fp32_buffer[0], ddim);
         for (int64_t s = inputs_start; s < inputs_end; s++) {
+          if (s + kRowPrefetchDistance < last_index) {
+            prefetch_row_ker(
+                &qweight_data
+                    [indices_accessor[s + kRowPrefetchDistance] * ddim],
+                ddim);
+          }
           int8_t* select_data_ptr = &qweight_data[indices_accessor[s] * ddim];
           scale_fp32_and_fma(
               &fp32_buffer[0], select_data_ptr, weight_scale, ddim);
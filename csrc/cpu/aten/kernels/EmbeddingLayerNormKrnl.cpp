@@ -0,0 +1,342 @@
+#include <aten/EmbeddingLayerNorm.h>
+
+#include <ATen/Parallel.h>
+#include <torch/csrc/autograd/function.h>
+#include "utils/workspace.h"
+#include "vec/vec.h"
+
+namespace torch_ipex {
+namespace cpu {
+
+namespace {
+
+#if defined(CPU_CAPABILITY_AVX512) || defined(CPU_CAPABILITY_AVX2)
+template <typename T, typename T1, typename index_t>
+void EmbeddingLayerNormKernelImpl(
+    const index_t* indices_data,
+    const index_t* position_ids_data, // null -> sequence offset
+    const index_t* token_type_ids_data, // null -> segment zero
+    const T* word_data,
+    const T* position_data,
+    const T* token_type_data, // null -> no segment embedding
+    const T1* gamma_data,
+    const T1* beta_data,
+    int64_t M,
+    int64_t S,
+    int64_t N,
+    int64_t word_rows,
+    int64_t position_rows,
+    int64_t token_type_rows,
+    float eps,
+    T* out_data) {
+  const float c = float(1) / static_cast<float>(N);
+  at::parallel_for(0, M, 1, [&](int64_t start, int64_t end) {
+    float* tmp_out_ptr =
+        static_cast<float*>(get_thread_local_workspace(N * sizeof(float)));
+    for (const auto i : c10::irange(start, end)) {
+      int64_t word_row = indices_data[i];
+      int64_t position_row = position_ids_data ? position_ids_data[i] : i % S;
+      TORCH_CHECK(
+          word_row >= 0 && word_row < word_rows,
+          "embedding_layernorm_dropout: token index ",
+          word_row,
+          " out of range [0, ",
+          word_rows,
+          ")");
+      TORCH_CHECK(
+          position_row >= 0 && position_row < position_rows,
+          "embedding_layernorm_dropout: position index ",
+          position_row,
+          " out of range [0, ",
+          position_rows,
+          ")");
+      const T* word_ptr = word_data + word_row * N;
+      const T* position_ptr = position_data + position_row * N;
+      float mean_val;
+      float rstd_val;
+      if (token_type_data) {
+        int64_t token_type_row =
+            token_type_ids_data ? token_type_ids_data[i] : 0;
+        TORCH_CHECK(
+            token_type_row >= 0 && token_type_row < token_type_rows,
+            "embedding_layernorm_dropout: token type index ",
+            token_type_row,
+            " out of range [0, ",
+            token_type_rows,
+            ")");
+        std::tie(mean_val, rstd_val) = kernel::_add3_and_compute_mean_var<T>(
+            word_ptr,
+            position_ptr,
+            token_type_data + token_type_row * N,
+            N,
+            tmp_out_ptr);
+      } else {
+        std::tie(mean_val, rstd_val) = kernel::_add_and_compute_mean_var<T>(
+            word_ptr, position_ptr, N, tmp_out_ptr);
+      }
+      rstd_val = std::max(rstd_val * c - mean_val * mean_val, float(0));
+      rstd_val = float(1.0) / std::sqrt(rstd_val + eps);
+      float scale = rstd_val;
+      float bias = -rstd_val * mean_val;
+      kernel::_normalize_kernel<T, T1>(
+          out_data + i * N,
+          tmp_out_ptr,
+          N,
+          scale,
+          bias,
+          gamma_data,
+          beta_data);
+    }
+  });
+}
+
+template <typename T, typename T1>
+void embedding_layernorm_dispatch_index(
+    const at::Tensor& indices,
+    const at::Tensor& position_ids,
+    const at::Tensor& token_type_ids,
+    const at::Tensor& word_weight,
+    const at::Tensor& position_weight,
+    const at::Tensor& token_type_weight,
+    const at::Tensor& gamma,
+    const at::Tensor& beta,
+    int64_t M,
+    int64_t S,
+    int64_t N,
+    float eps,
+    at::Tensor& output) {
+  const T* token_type_data = token_type_weight.defined()
+      ? token_type_weight.data_ptr<T>()
+      : nullptr;
+  const T1* gamma_data = gamma.defined() ? gamma.data_ptr<T1>() : nullptr;
+  const T1* beta_data = beta.defined() ? beta.data_ptr<T1>() : nullptr;
+  if (indices.scalar_type() == at::kLong) {
+    EmbeddingLayerNormKernelImpl<T, T1, int64_t>(
+        indices.data_ptr<int64_t>(),
+        position_ids.defined() ? position_ids.data_ptr<int64_t>() : nullptr,
+        token_type_ids.defined() ? token_type_ids.data_ptr<int64_t>()
+                                 : nullptr,
+        word_weight.data_ptr<T>(),
+        position_weight.data_ptr<T>(),
+        token_type_data,
+        gamma_data,
+        beta_data,
+        M,
+        S,
+        N,
+        word_weight.size(0),
+        position_weight.size(0),
+        token_type_weight.defined() ? token_type_weight.size(0) : 0,
+        eps,
+        output.data_ptr<T>());
+  } else {
+    EmbeddingLayerNormKernelImpl<T, T1, int32_t>(
+        indices.data_ptr<int32_t>(),
+        position_ids.defined() ? position_ids.data_ptr<int32_t>() : nullptr,
+        token_type_ids.defined() ? token_type_ids.data_ptr<int32_t>()
+                                 : nullptr,
+        word_weight.data_ptr<T>(),
+        position_weight.data_ptr<T>(),
+        token_type_data,
+        gamma_data,
+        beta_data,
+        M,
+        S,
+        N,
+        word_weight.size(0),
+        position_weight.size(0),
+        token_type_weight.defined() ? token_type_weight.size(0) : 0,
+        eps,
+        output.data_ptr<T>());
+  }
+}
+#endif
+
+at::Tensor embedding_layernorm_fallback(
+    const at::Tensor& indices,
+    const at::Tensor& word_weight,
+    const at::Tensor& position_weight,
+    const c10::optional<at::Tensor>& token_type_weight,
+    const c10::optional<at::Tensor>& position_ids,
+    const c10::optional<at::Tensor>& token_type_ids,
+    const c10::optional<at::Tensor>& weight_opt,
+    const c10::optional<at::Tensor>& bias_opt,
+    float eps) {
+  int64_t S = indices.size(-1);
+  at::Tensor pos_ids;
+  if (position_ids.has_value() && position_ids.value().defined()) {
+    pos_ids = position_ids.value();
+  } else {
+    pos_ids = at::arange(S, indices.options());
+  }
+  auto gathered = at::embedding(word_weight, indices) +
+      at::embedding(position_weight, pos_ids);
+  if (token_type_weight.has_value() && token_type_weight.value().defined()) {
+    at::Tensor type_ids;
+    if (token_type_ids.has_value() && token_type_ids.value().defined()) {
+      type_ids = token_type_ids.value();
+    } else {
+      type_ids = at::zeros_like(indices);
+    }
+    gathered = gathered + at::embedding(token_type_weight.value(), type_ids);
+  }
+  return at::layer_norm(
+      gathered, {word_weight.size(1)}, weight_opt, bias_opt, eps);
+}
+
+at::Tensor embedding_layernorm_kernel_impl(
+    const at::Tensor& indices,
+    const at::Tensor& word_weight,
+    const at::Tensor& position_weight,
+    const c10::optional<at::Tensor>& token_type_weight,
+    const c10::optional<at::Tensor>& position_ids,
+    const c10::optional<at::Tensor>& token_type_ids,
+    const c10::optional<at::Tensor>& weight_opt,
+    const c10::optional<at::Tensor>& bias_opt,
+    float eps) {
+#if defined(CPU_CAPABILITY_AVX512) || defined(CPU_CAPABILITY_AVX2)
+  c10::MaybeOwned<at::Tensor> weight_maybe_owned =
+      at::borrow_from_optional_tensor(weight_opt);
+  const at::Tensor& weight = *weight_maybe_owned;
+  c10::MaybeOwned<at::Tensor> bias_maybe_owned =
+      at::borrow_from_optional_tensor(bias_opt);
+  const at::Tensor& bias = *bias_maybe_owned;
+
+  auto dtype = word_weight.scalar_type();
+  bool index_supported = indices.scalar_type() == at::kLong ||
+      indices.scalar_type() == at::kInt;
+  bool dtype_supported = position_weight.scalar_type() == dtype &&
+      (!token_type_weight.has_value() ||
+       !token_type_weight.value().defined() ||
+       token_type_weight.value().scalar_type() == dtype);
+  if (index_supported && dtype_supported &&
+      (dtype == at::kFloat || dtype == at::kBFloat16 || dtype == at::kHalf)) {
+    int64_t N = word_weight.size(1);
+    int64_t M = indices.numel();
+    int64_t S = indices.size(-1);
+
+    auto indices_ = indices.contiguous();
+    at::Tensor pos_ids = position_ids.has_value() &&
+            position_ids.value().defined()
+        ? position_ids.value().to(indices.scalar_type()).contiguous()
+        : at::Tensor();
+    at::Tensor type_ids = token_type_ids.has_value() &&
+            token_type_ids.value().defined()
+        ? token_type_ids.value().to(indices.scalar_type()).contiguous()
+        : at::Tensor();
+    auto word_weight_ = word_weight.contiguous();
+    auto position_weight_ = position_weight.contiguous();
+    at::Tensor token_type_weight_ = token_type_weight.has_value() &&
+            token_type_weight.value().defined()
+        ? token_type_weight.value().contiguous()
+        : at::Tensor();
+    auto gamma = weight.defined() ? weight.contiguous() : weight;
+    auto beta = bias.defined() ? bias.contiguous() : bias;
+
+    std::vector<int64_t> output_size = indices.sizes().vec();
+    output_size.push_back(N);
+    at::Tensor output = at::empty(output_size, word_weight.options());
+
+    if (dtype == at::kFloat) {
+      embedding_layernorm_dispatch_index<float, float>(
+          indices_,
+          pos_ids,
+          type_ids,
+          word_weight_,
+          position_weight_,
+          token_type_weight_,
+          gamma,
+          beta,
+          M,
+          S,
+          N,
+          eps,
+          output);
+    } else if (dtype == at::kBFloat16) {
+      if (gamma.defined() && gamma.scalar_type() == at::kBFloat16) {
+        embedding_layernorm_dispatch_index<at::BFloat16, at::BFloat16>(
+            indices_,
+            pos_ids,
+            type_ids,
+            word_weight_,
+            position_weight_,
+            token_type_weight_,
+            gamma,
+            beta,
+            M,
+            S,
+            N,
+            eps,
+            output);
+      } else {
+        embedding_layernorm_dispatch_index<at::BFloat16, float>(
+            indices_,
+            pos_ids,
+            type_ids,
+            word_weight_,
+            position_weight_,
+            token_type_weight_,
+            gamma,
+            beta,
+            M,
+            S,
+            N,
+            eps,
+            output);
+      }
+    } else {
+      if (gamma.defined() && gamma.scalar_type() == at::kHalf) {
+        embedding_layernorm_dispatch_index<at::Half, at::Half>(
+            indices_,
+            pos_ids,
+            type_ids,
+            word_weight_,
+            position_weight_,
+            token_type_weight_,
+            gamma,
+            beta,
+            M,
+            S,
+            N,
+            eps,
+            output);
+      } else {
+        embedding_layernorm_dispatch_index<at::Half, float>(
+            indices_,
+            pos_ids,
+            type_ids,
+            word_weight_,
+            position_weight_,
+            token_type_weight_,
+            gamma,
+            beta,
+            M,
+            S,
+            N,
+            eps,
+            output);
+      }
+    }
+    return output;
+  }
+#endif
+  return embedding_layernorm_fallback(
+      indices,
+      word_weight,
+      position_weight,
+      token_type_weight,
+      position_ids,
+      token_type_ids,
+      weight_opt,
+      bias_opt,
+      eps);
+}
+
+} // anonymous namespace
+
+IPEX_REGISTER_DISPATCH(
+    embedding_layernorm_kernel_stub,
+    &embedding_layernorm_kernel_impl);
+
+} // namespace cpu
+} // namespace torch_ipex
@@ -14,6 +14,8 @@
 #include "../cpu/utils/isa_utils.h"
 #include "csrc/cpu/tpp/woq/tla.h"
 #include "mkl.h"
+#include "utils/hot_trace.h"
+#include "utils/workspace.h"
 #include "vec/vec.h"
 
 inline void _mkl_gemm(
@@ -377,7 +379,8 @@ cpu_flash_attention(
     double dropout_p,
     bool is_causal,
     c10::optional<at::Tensor> attention_mask,
-    c10::optional<double> scale) {
+    c10::optional<double> scale,
+    int64_t window_size = -1) {
   // Query (Batch x Num_heads  x Q_seq_len  x Dim_per_head)
   //    -> (Batch x Q_seq_len  x Num_heads  x Dim_per_head)
   // Key   (Batch x Num_heads  x KV_seq_len x Dim_per_head)
@@ -440,20 +443,14 @@ cpu_flash_attention(
   int64_t qTail = (qSize - 1) % qSplitSize + 1;
   int64_t kvSlice = (kvSize - 1) / kvSplitSize + 1;
   int64_t kvTail = (kvSize - 1) % kvSplitSize + 1;
-  int64_t num_thread = at::get_num_threads();
-
-  const auto dtype = query.scalar_type();
-  const auto accumulate_dtype = at::toOpMathType(dtype);
 
-  // allocate per thread temp buf (accumulate type)
+  // per thread temp buf (accumulate type)
   int64_t size_per_thread =
       /* qk     */ qSplitSize * kvSplitSize +
       /* qk_max */ qSplitSize +
       /* qk_sum */ qSplitSize +
       /* dst    */ qSplitSize * headSize;
 
-  at::Tensor buf = at::empty(
-      {num_thread, size_per_thread}, query.options().dtype(accumulate_dtype));
   // Data ptrs
   scalar_t* q_data = query.data_ptr<scalar_t>();
   scalar_t* k_data = key.data_ptr<scalar_t>();
@@ -463,15 +460,15 @@ cpu_flash_attention(
       : nullptr;
   scalar_t* out_data = output.data_ptr<scalar_t>();
   accum_t* lse_data = logsumexp.data_ptr<accum_t>();
-  accum_t* buf_data = buf.data_ptr<accum_t>();
 
   at::parallel_for(
       0, batchSize * num_head * qSlice, 1, [&](int64_t begin, int64_t end) {
         int64_t i = 0, j = 0, k = 0;
         at::native::data_index_init(
             begin, i, batchSize, j, num_head, k, qSlice);
-        int ompIdx = at::get_thread_num();
-        accum_t* buf_ptr = buf_data + ompIdx * size_per_thread;
+        // Per thread temp buf (accumulate type), reused across calls
+        accum_t* buf_ptr = static_cast<accum_t*>(
+            get_thread_local_workspace(size_per_thread * sizeof(accum_t)));
         accum_t* qk_data = buf_ptr;
         accum_t* qk_max_data = qk_data + qSplitSize * kvSplitSize;
         accum_t* qk_sum_data = qk_max_data + qSplitSize;
@@ -490,7 +487,14 @@ cpu_flash_attention(
               qk_sum_data, static_cast<accum_t>(0), qBlockSize);
           int64_t num_keys =
               is_causal ? std::min(m + qBlockSize, kvSize) : kvSize;
-          for (int64_t n = 0; n < num_keys; n += kvSplitSize) {
+          // Sliding window: keys before m - window_size + 1 are masked for
+          // every row of this query block, so skip those kv blocks entirely.
+          int64_t start_keys = (is_causal && window_size > 0)
+              ? std::max(
+                    static_cast<int64_t>(0),
+                    (m - window_size + 1) / kvSplitSize * kvSplitSize)
+              : 0;
+          for (int64_t n = start_keys; n < num_keys; n += kvSplitSize) {
             int64_t kvBlockSize = std::min(kvSplitSize, kvSize - n);
             // Calculate scale * q @ k.T
             _mkl_gemm(
@@ -519,6 +523,22 @@ cpu_flash_attention(
                     kvBlockSize - last_col - 1);
               }
             }
+            // Mask out keys on the left of the sliding window. A large finite
+            // negative is used instead of -inf so a row whose window has not
+            // reached this kv block yet still produces a finite running max
+            // (its contribution is scaled away by the online softmax).
+            if (is_causal && window_size > 0 &&
+                n < m + qBlockSize - window_size) {
+              for (const auto row : c10::irange(qBlockSize)) {
+                int64_t first_col = m + row - window_size + 1 - n;
+                if (first_col > 0) {
+                  torch_ipex::cpu::kernel::fill_stub(
+                      qk_data + row * kvBlockSize,
+                      -std::numeric_limits<accum_t>::max() / 2,
+                      std::min(first_col, kvBlockSize));
+                }
+              }
+            }
             // Update attention weights with attention mask
             // And apply scaling factor
             if (attention_mask.has_value()) {
@@ -584,7 +604,7 @@ cpu_flash_attention(
               // max[row] <- max
               qk_max_data[row] = tmp_max;
               // dst <- dst * exp_tmp
-              if (n > 0) {
+              if (n > start_keys) {
                 at::vec::map<accum_t>(
                     [exp_tmp](Vec x) { return x * Vec(exp_tmp); },
                     dst_data + row * headSize,
@@ -605,7 +625,8 @@ cpu_flash_attention(
                 vStrideN,
                 qk_data,
                 kvBlockSize,
-                n == 0 ? static_cast<accum_t>(0) : static_cast<accum_t>(1),
+                n == start_keys ? static_cast<accum_t>(0)
+                                : static_cast<accum_t>(1),
                 dst_data,
                 headSize);
           }
@@ -645,7 +666,8 @@ cpu_flash_attention(
     double dropout_p,
     bool is_causal,
     c10::optional<at::Tensor> attention_mask,
-    c10::optional<double> scale) {
+    c10::optional<double> scale,
+    int64_t window_size = -1) {
   // Query (Batch x Num_heads  x Q_seq_len  x Dim_per_head)
   //    -> (Batch x Q_seq_len  x Num_heads  x Dim_per_head)
   // Key   (Batch x Num_heads  x KV_seq_len x Dim_per_head)
@@ -724,13 +746,6 @@ cpu_flash_attention(
       /* qk_sum */ qSplitSize +
       /* dst    */ qSplitSize * headSize;
 
-  at::Tensor buf = at::empty(
-      {num_thread, size_per_thread}, query.options().dtype(accumulate_dtype));
-  at::Tensor buf_reduced = at::empty(
-      {num_thread,
-       qSplitSize,
-       kvSplitSize % 2 == 0 ? kvSplitSize : kvSplitSize + 1},
-      query.options());
   // Data ptrs
   scalar_t* q_data = query.data_ptr<scalar_t>();
   scalar_t* k_data = key.data_ptr<scalar_t>();
@@ -740,8 +755,6 @@ cpu_flash_attention(
       : nullptr;
   scalar_t* out_data = output.data_ptr<scalar_t>();
   accum_t* lse_data = logsumexp.data_ptr<accum_t>();
-  accum_t* buf_data = buf.data_ptr<accum_t>();
-  scalar_t* buf_reduced_data = buf_reduced.data_ptr<scalar_t>();
 
   // Create tpp kernels for Query @ Key
   bool headSize_even = headSize % 2 == 0;
@@ -1056,13 +1069,17 @@ cpu_flash_attention(
         at::native::data_index_init(
             begin, i, batchSize, j, num_head, k, qSlice);
         int ompIdx = at::get_thread_num();
-        accum_t* buf_ptr = buf_data + ompIdx * size_per_thread;
+        // Per thread temp buf (accumulate type) with the reduced-precision
+        // qk block appended, reused across calls
+        accum_t* buf_ptr = static_cast<accum_t*>(get_thread_local_workspace(
+            size_per_thread * sizeof(accum_t) +
+            qSplitSize * av_gemm_K * sizeof(scalar_t)));
         accum_t* qk_data = buf_ptr;
         accum_t* qk_max_data = qk_data + qSplitSize * kvSplitSize;
         accum_t* qk_sum_data = qk_max_data + qSplitSize;
         accum_t* dst_data = qk_sum_data + qSplitSize;
         scalar_t* qk_reduced_data =
-            buf_reduced_data + ompIdx * qSplitSize * av_gemm_K;
+            reinterpret_cast<scalar_t*>(buf_ptr + size_per_thread);
         scalar_t* query_t_padding_ptr = (is_fp16 && !headSize_even)
             ? query_padding_ptr + ompIdx * qSplitSize * qk_gemm_K
             : nullptr;
@@ -1080,6 +1097,13 @@ cpu_flash_attention(
               qk_sum_data, static_cast<accum_t>(0), qBlockSize);
           int64_t num_keys =
               is_causal ? std::min(m + qBlockSize, kvSize) : kvSize;
+          // Sliding window: keys before m - window_size + 1 are masked for
+          // every row of this query block, so skip those kv blocks entirely.
+          int64_t start_keys = (is_causal && window_size > 0)
+              ? std::max(
+                    static_cast<int64_t>(0),
+                    (m - window_size + 1) / kvSplitSize * kvSplitSize)
+              : 0;
           if (is_fp16 && !headSize_even) {
             // pad query if headSize is not even for fp16
             // [qBlockSize, headSize] -> [qBlockSize, headSize + 1]
@@ -1090,7 +1114,7 @@ cpu_flash_attention(
                 headSize + 1,
                 qStrideM);
           }
-          for (int64_t n = 0; n < num_keys; n += kvSplitSize) {
+          for (int64_t n = start_keys; n < num_keys; n += kvSplitSize) {
             int64_t kvBlockSize = std::min(kvSplitSize, kvSize - n);
             // Calculate scale * q @ k.T
             if ((!is_fp16 && headSize_even) || is_fp16) {
@@ -1168,6 +1192,22 @@ cpu_flash_attention(
                     kvBlockSize - last_col - 1);
               }
             }
+            // Mask out keys on the left of the sliding window. A large finite
+            // negative is used instead of -inf so a row whose window has not
+            // reached this kv block yet still produces a finite running max
+            // (its contribution is scaled away by the online softmax).
+            if (is_causal && window_size > 0 &&
+                n < m + qBlockSize - window_size) {
+              for (const auto row : c10::irange(qBlockSize)) {
+                int64_t first_col = m + row - window_size + 1 - n;
+                if (first_col > 0) {
+                  torch_ipex::cpu::kernel::fill_stub(
+                      qk_data + row * kvBlockSize,
+                      -std::numeric_limits<accum_t>::max() / 2,
+                      std::min(first_col, kvBlockSize));
+                }
+              }
+            }
             // Update attention weights with attention mask
             // And apply scaling factor
             if (attention_mask.has_value()) {
@@ -1236,7 +1276,7 @@ cpu_flash_attention(
               // max[row] <- max
               qk_max_data[row] = tmp_max;
               // dst <- dst * exp_tmp
-              if (n > 0) {
+              if (n > start_keys) {
                 at::vec::map<accum_t>(
                     [exp_tmp](Vec x) { return x * Vec(exp_tmp); },
                     dst_data + row * headSize,
@@ -1257,7 +1297,7 @@ cpu_flash_attention(
               int64_t psize = n / kvSplitSize * av_gemm_K;
               if (n + kvSplitSize < kvSize) {
                 // main
-                if (n == 0) {
+                if (n == start_keys) {
                   av_gemm(
                       qk_reduced_data,
                       value_reorder_ptr +
@@ -1277,7 +1317,7 @@ cpu_flash_attention(
                 }
               } else if (n + kvSplitSize >= kvSize) {
                 // tail
-                if (n == 0) {
+                if (n == start_keys) {
                   av_gemm_tail(
                       qk_reduced_data,
                       value_reorder_ptr +
@@ -1309,7 +1349,8 @@ cpu_flash_attention(
                   vStrideN,
                   qk_reduced_data,
                   kvBlockSize % 2 == 0 ? kvBlockSize : kvBlockSize + 1,
-                  n == 0 ? static_cast<accum_t>(0) : static_cast<accum_t>(1),
+                  n == start_keys ? static_cast<accum_t>(0)
+                                : static_cast<accum_t>(1),
                   dst_data,
                   headSize);
             }
@@ -1347,7 +1388,9 @@ void flash_attention_kernel_impl(
     double dropout_p,
     bool is_causal,
     c10::optional<at::Tensor> attention_mask,
-    c10::optional<double> scale) {
+    c10::optional<double> scale,
+    int64_t window_size = -1) {
+  IPEX_HOT_TRACE_SCOPE("aten::flash_attention_kernel");
   auto q_seq_len = query.size(2);
 
   AT_DISPATCH_FLOATING_TYPES_AND2(
@@ -1362,7 +1405,8 @@ void flash_attention_kernel_impl(
               dropout_p,
               is_causal,
               attention_mask,
-              scale);
+              scale,
+              window_size);
         } else if (q_seq_len >= 192) {
           cpu_flash_attention<scalar_t, 64, 512>(
               output,
@@ -1373,7 +1417,8 @@ void flash_attention_kernel_impl(
               dropout_p,
               is_causal,
               attention_mask,
-              scale);
+              scale,
+              window_size);
         } else {
           cpu_flash_attention<scalar_t, 32, 512>(
               output,
@@ -1384,7 +1429,8 @@ void flash_attention_kernel_impl(
               dropout_p,
               is_causal,
               attention_mask,
-              scale);
+              scale,
+              window_size);
         }
       });
 }
@@ -1457,9 +1503,209 @@ std::tuple<at::Tensor, at::Tensor> flash_attention_kernel(
 
   return std::make_tuple(std::move(output), std::move(logsumexp));
 }
+
+/*
+ *Flash attention over variable-length sequences packed without padding.
+ *Q/K/V are [total_tokens, num_head, head_size] with cu_seqlens_q/k giving
+ *the [batch + 1] cumulative token offsets (flash-attn varlen layout).
+ *Each sequence is handed to the tiled kernel as a batch-1 strided view of
+ *the packed buffers, so no padding is materialized anywhere and the
+ *per-sequence cost is O(seqlen_q * seqlen_k) of real tokens only; the
+ *kernel parallelizes internally over heads and query tiles.
+ */
+at::Tensor flash_attention_varlen_kernel(
+    const at::Tensor& query,
+    const at::Tensor& key,
+    const at::Tensor& value,
+    const at::Tensor& cu_seqlens_q,
+    const at::Tensor& cu_seqlens_k,
+    int64_t max_seqlen_q,
+    int64_t max_seqlen_k,
+    bool is_causal,
+    c10::optional<double> scale) {
+  RECORD_FUNCTION(
+      "torch_ipex::flash_attention_varlen_kernel",
+      c10::ArrayRef<c10::IValue>({}));
+
+  const auto dtype = query.scalar_type();
+  TORCH_CHECK(
+      c10::isFloatingType(dtype),
+      "IPEX varlen_attention: Expected data type in FP32, FP64, BF16, FP16, but got ",
+      dtype,
+      " instead.");
+  TORCH_CHECK(
+      dtype == key.scalar_type() && dtype == value.scalar_type(),
+      "IPEX varlen_attention: Q/K/V should have the same data type");
+  TORCH_CHECK(
+      query.dim() == 3 && key.dim() == 3 && value.dim() == 3,
+      "IPEX varlen_attention: Accept only 3 dims packed inputs of {T, H, K}");
+  TORCH_CHECK(
+      (query.size(2) == value.size(2)) && (key.size(2) == value.size(2)),
+      "IPEX varlen_attention: Q/K/V should have the same head size");
+  TORCH_CHECK(
+      (query.stride(-1) == 1) && (key.stride(-1) == 1) &&
+          (value.stride(-1) == 1),
+      "IPEX varlen_attention: Q/K/V should be continuous on the last dim");
+  TORCH_CHECK(
+      cu_seqlens_q.dim() == 1 &&
+          cu_seqlens_q.sizes() == cu_seqlens_k.sizes() &&
+          cu_seqlens_q.numel() >= 2,
+      "IPEX varlen_attention: cu_seqlens should be [batch + 1] offsets");
+
+  auto cu_q = cu_seqlens_q.to(at::kLong).contiguous();
+  auto cu_k = cu_seqlens_k.to(at::kLong).contiguous();
+  const int64_t* cu_q_ptr = cu_q.data_ptr<int64_t>();
+  const int64_t* cu_k_ptr = cu_k.data_ptr<int64_t>();
+  int64_t batch = cu_q.numel() - 1;
+  int64_t total_q = query.size(0);
+  int64_t num_head = query.size(1);
+  TORCH_CHECK(
+      cu_q_ptr[0] == 0 && cu_q_ptr[batch] == total_q,
+      "IPEX varlen_attention: cu_seqlens_q should start at 0 and end at the total token count");
+  TORCH_CHECK(
+      cu_k_ptr[0] == 0 && cu_k_ptr[batch] == key.size(0),
+      "IPEX varlen_attention: cu_seqlens_k should start at 0 and end at the total token count");
+
+  // Output shares the packed [total_q, H, K] layout, which is exactly the
+  // {B, T, H, K} layout the tiled kernel writes for a batch-1 slice.
+  at::Tensor output = at::empty_like(query);
+  const auto accumulate_dtype = at::toOpMathType(dtype);
+  at::Tensor logsumexp = at::empty(
+      {total_q, num_head}, query.options().dtype(accumulate_dtype));
+
+  for (int64_t b = 0; b < batch; b++) {
+    int64_t q_len = cu_q_ptr[b + 1] - cu_q_ptr[b];
+    int64_t k_len = cu_k_ptr[b + 1] - cu_k_ptr[b];
+    TORCH_CHECK(
+        q_len >= 0 && k_len >= 0 && q_len <= max_seqlen_q &&
+            k_len <= max_seqlen_k,
+        "IPEX varlen_attention: cu_seqlens should be non-decreasing and bounded by max_seqlen");
+    if (q_len == 0) {
+      continue;
+    }
+    auto out_b = output.slice(0, cu_q_ptr[b], cu_q_ptr[b + 1]).unsqueeze(0);
+    if (k_len == 0) {
+      out_b.zero_();
+      continue;
+    }
+    auto q_b = query.slice(0, cu_q_ptr[b], cu_q_ptr[b + 1])
+                   .transpose(0, 1)
+                   .unsqueeze(0);
+    auto k_b = key.slice(0, cu_k_ptr[b], cu_k_ptr[b + 1])
+                   .transpose(0, 1)
+                   .unsqueeze(0);
+    auto v_b = value.slice(0, cu_k_ptr[b], cu_k_ptr[b + 1])
+                   .transpose(0, 1)
+                   .unsqueeze(0);
+    auto lse_b =
+        logsumexp.slice(0, cu_q_ptr[b], cu_q_ptr[b + 1]).unsqueeze(0);
+    flash_attention_kernel_impl(
+        out_b,
+        lse_b,
+        q_b,
+        k_b,
+        v_b,
+        /* dropout */ 0.0,
+        is_causal,
+        c10::nullopt,
+        scale);
+  }
+  return output;
+}
+
+/*
+ *Flash attention restricted to a causal sliding window of window_size keys
+ *(Mistral-style). Key blocks entirely outside the window are skipped by the
+ *tiling loop, so prefill work is O(q_len * window_size) instead of
+ *O(q_len^2).
+ */
+std::tuple<at::Tensor, at::Tensor> flash_attention_sliding_window_kernel(
+    const at::Tensor& query,
+    const at::Tensor& key,
+    const at::Tensor& value,
+    double dropout_p,
+    bool is_causal,
+    c10::optional<at::Tensor> attention_mask,
+    c10::optional<double> scale,
+    int64_t window_size) {
+  RECORD_FUNCTION(
+      "torch_ipex::flash_attention_sliding_window_kernel",
+      c10::ArrayRef<c10::IValue>({}));
+
+  TORCH_CHECK(
+      window_size > 0,
+      "IPEX flash_attention_sliding_window: window_size should be positive");
+  TORCH_CHECK(
+      is_causal,
+      "IPEX flash_attention_sliding_window: only causal attention supports a sliding window");
+
+  const auto dtype = query.scalar_type();
+  int64_t batchSize = query.size(0);
+  int64_t qSize = query.size(2);
+  int64_t num_head = query.size(1);
+  int64_t headSize = query.size(3);
+
+  TORCH_CHECK(
+      c10::isFloatingType(dtype),
+      "IPEX flash_attention_sliding_window: Expected data type in FP32, FP64, BF16, FP16, but got ",
+      dtype,
+      " instead.");
+  TORCH_CHECK(
+      dtype == key.scalar_type() && dtype == value.scalar_type(),
+      "IPEX flash_attention_sliding_window: Q/K/V should have the same data type");
+  TORCH_CHECK(
+      !attention_mask.has_value() ||
+          dtype == attention_mask.value().scalar_type() ||
+          attention_mask.value().scalar_type() == ScalarType::Bool,
+      "IPEX flash_attention_sliding_window: Mask should have the same data type as Q/K/V or Bool");
+  TORCH_CHECK(
+      query.dim() == 4 && key.dim() == 4 && value.dim() == 4,
+      "IPEX flash_attention_sliding_window: Accept only 4 dims inputs shape of {B, H, T, K}");
+  TORCH_CHECK(
+      dropout_p == 0.0,
+      "IPEX flash_attention_sliding_window: Currently do not support dropout > 0");
+  TORCH_CHECK(
+      (query.size(3) == value.size(3)) && (key.size(3) == value.size(3)),
+      "IPEX flash_attention_sliding_window: Q/K/V should have the same head size");
+  TORCH_CHECK(
+      (query.stride(-1) == 1) && (key.stride(-1) == 1) &&
+          (value.stride(-1) == 1) &&
+          (!attention_mask.has_value() ||
+           attention_mask.value().stride(-1) == 1),
+      "IPEX flash_attention_sliding_window: Q/K/V/Mask should be continuous on the last dim");
+
+  at::Tensor output =
+      at::empty({batchSize, qSize, num_head, headSize}, query.options());
+  const auto accumulate_dtype = at::toOpMathType(dtype);
+  at::Tensor logsumexp = at::empty(
+      {batchSize, qSize, num_head}, query.options().dtype(accumulate_dtype));
+
+  flash_attention_kernel_impl(
+      output,
+      logsumexp,
+      query,
+      key,
+      value,
+      dropout_p,
+      is_causal,
+      attention_mask,
+      scale,
+      window_size);
+
+  output = output.transpose(1, 2);
+  logsumexp = logsumexp.transpose(1, 2);
+
+  return std::make_tuple(std::move(output), std::move(logsumexp));
+}
 } // anonymous namespace
 
 IPEX_REGISTER_DISPATCH(flash_attention_kernel_stub, &flash_attention_kernel);
+IPEX_REGISTER_DISPATCH(
+    flash_attention_varlen_kernel_stub,
+    &flash_attention_varlen_kernel);
+IPEX_REGISTER_DISPATCH(
+    flash_attention_sliding_window_kernel_stub,
+    &flash_attention_sliding_window_kernel);
 
 } // namespace cpu
 } // namespace torch_ipex
@@ -3,6 +3,7 @@
 
 #include <ATen/Dispatch.h>
 #include <ATen/OpMathType.h>
+#include <ATen/Parallel.h>
 #include <ATen/core/Tensor.h>
 #include <ATen/cpu/vec/functional.h>
 #include <ATen/native/TensorIterator.h>
@@ -18,6 +19,103 @@ void check_foreach_api_restrictions(std::vector<at::Tensor> tensors) {
   TORCH_CHECK(!tensors.empty(), "Tensor list must have at least one tensor.");
 }
 
+// Work item of the chunked multi-tensor unscale path: a contiguous slice of
+// one gradient tensor. Flattening all grads into equally sized chunks lets a
+// single parallel_for balance many small tensors and a few large ones alike,
+// instead of forking per tensor.
+struct UnscaleChunk {
+  int32_t tensor_id;
+  int32_t size;
+  int64_t offset;
+};
+
+constexpr int64_t kUnscaleChunkSize = 16384;
+
+// Unscales [ptr, ptr + size) in place and reports whether any element is
+// inf/NaN. The caller merges the per-chunk results into found_inf.
+template <typename scalar_t>
+inline bool unscale_and_check_range(
+    scalar_t* ptr,
+    int64_t size,
+    float inv_scale_val) {
+  using Vec = at::vec::Vectorized<scalar_t>;
+  bool found = false;
+  int64_t d = 0;
+  for (; d < size - (size % Vec::size()); d += Vec::size()) {
+    Vec val_vec = Vec::loadu(ptr + d);
+    if (val_vec.has_inf_nan()) {
+      found = true;
+    }
+    if (inv_scale_val != 1.f) {
+      val_vec = val_vec * Vec(scalar_t(inv_scale_val));
+      val_vec.store(ptr + d);
+    }
+  }
+  for (; d < size; d++) {
+    if (!std::isfinite(ptr[d])) {
+      found = true;
+    }
+    if (inv_scale_val != 1.f) {
+      ptr[d] = ptr[d] * scalar_t(inv_scale_val);
+    }
+  }
+  return found;
+}
+
+// Reduced floating types are checked and scaled in float, matching the
+// opmath handling of the TensorIterator path.
+template <typename scalar_t>
+inline bool unscale_and_check_range_reduced(
+    scalar_t* ptr,
+    int64_t size,
+    float inv_scale_val) {
+  using bVec = at::vec::Vectorized<scalar_t>;
+  using fVec = at::vec::Vectorized<float>;
+  bool found = false;
+  int64_t d = 0;
+  for (; d < size - (size % bVec::size()); d += bVec::size()) {
+    bVec val_bvec = bVec::loadu(ptr + d);
+    fVec val_fvec0, val_fvec1;
+    std::tie(val_fvec0, val_fvec1) =
+        at::vec::convert_to_float<scalar_t>(val_bvec);
+    if (val_fvec0.has_inf_nan() || val_fvec1.has_inf_nan()) {
+      found = true;
+    }
+    if (inv_scale_val != 1.f) {
+      val_fvec0 = val_fvec0 * fVec(inv_scale_val);
+      val_fvec1 = val_fvec1 * fVec(inv_scale_val);
+      val_bvec = at::vec::convert_from_float<scalar_t>(val_fvec0, val_fvec1);
+      val_bvec.store(ptr + d);
+    }
+  }
+  for (; d < size; d++) {
+    float val = static_cast<float>(ptr[d]);
+    if (!std::isfinite(val)) {
+      found = true;
+    }
+    if (inv_scale_val != 1.f) {
+      ptr[d] = static_cast<scalar_t>(val * inv_scale_val);
+    }
+  }
+  return found;
+}
+
+template <>
+inline bool unscale_and_check_range<at::BFloat16>(
+    at::BFloat16* ptr,
+    int64_t size,
+    float inv_scale_val) {
+  return unscale_and_check_range_reduced(ptr, size, inv_scale_val);
+}
+
+template <>
+inline bool unscale_and_check_range<at::Half>(
+    at::Half* ptr,
+    int64_t size,
+    float inv_scale_val) {
+  return unscale_and_check_range_reduced(ptr, size, inv_scale_val);
+}
+
 // Follow the implementations of PyTorch.
 // Multiplies each tensor in scaled_grads by inv_scale in-place.
 // If any element of any tensor in scaled_grads is inf or NaN, sets found_inf
@@ -61,6 +159,72 @@ void _amp_foreach_non_finite_check_and_unscale_cpu_kernel(
     TORCH_CHECK(
         t.layout() == at::kStrided,
         "one of scaled_grads was not a strided tensor.");
+  }
+
+  // Contiguous grads take the chunked multi-tensor path: one parallel_for
+  // over fixed-size chunks of the flattened list, with vectorized inf/NaN
+  // compares folded into the unscale sweep. Strided or unsupported-dtype
+  // tensors fall back to the per-tensor TensorIterator path below.
+  std::vector<at::Tensor> fallback_grads;
+  std::vector<void*> grad_data;
+  std::vector<at::ScalarType> grad_dtypes;
+  std::vector<UnscaleChunk> chunks;
+  for (const at::Tensor& t : scaled_grads) {
+    auto dtype = t.scalar_type();
+    bool chunkable = t.is_contiguous() &&
+        (dtype == at::ScalarType::Float || dtype == at::ScalarType::Double ||
+         dtype == at::ScalarType::BFloat16 || dtype == at::ScalarType::Half);
+    if (!chunkable) {
+      fallback_grads.push_back(t);
+      continue;
+    }
+    int32_t tensor_id = grad_data.size();
+    grad_data.push_back(t.data_ptr());
+    grad_dtypes.push_back(dtype);
+    int64_t numel = t.numel();
+    for (int64_t offset = 0; offset < numel; offset += kUnscaleChunkSize) {
+      chunks.push_back(
+          {tensor_id,
+           (int32_t)std::min(kUnscaleChunkSize, numel - offset),
+           offset});
+    }
+  }
+
+  if (!chunks.empty()) {
+    auto* found_inf_ptr = found_inf.data_ptr<float>();
+    const float inv_scale_val = *inv_scale.data_ptr<float>();
+    at::parallel_for(0, chunks.size(), 1, [&](int64_t begin, int64_t end) {
+      bool found = false;
+      for (int64_t i = begin; i < end; i++) {
+        const UnscaleChunk& c = chunks[i];
+        void* data = grad_data[c.tensor_id];
+        switch (grad_dtypes[c.tensor_id]) {
+          case at::ScalarType::Float:
+            found |= unscale_and_check_range(
+                (float*)data + c.offset, c.size, inv_scale_val);
+            break;
+          case at::ScalarType::Double:
+            found |= unscale_and_check_range(
+                (double*)data + c.offset, c.size, inv_scale_val);
+            break;
+          case at::ScalarType::BFloat16:
+            found |= unscale_and_check_range(
+                (at::BFloat16*)data + c.offset, c.size, inv_scale_val);
+            break;
+          default:
+            found |= unscale_and_check_range(
+                (at::Half*)data + c.offset, c.size, inv_scale_val);
+            break;
+        }
+      }
+      if (found) {
+        // Benign race: every writer stores the same value.
+        *found_inf_ptr = 1.f;
+      }
+    });
+  }
+
+  for (const at::Tensor& t : fallback_grads) {
     auto iter = at::TensorIterator::unary_op(
         const_cast<at::Tensor&>(t), const_cast<at::Tensor&>(t));
     if (at::isReducedFloatingType(iter.dtype())) {
@@ -167,6 +167,103 @@ ColumnwiseMoments(const T* X_data, int64_t HxW, int64_t C, int64_t D) {
   return std::tuple<opmath_t, opmath_t>(mean_val, rstd_val);
 }
 
+// Single-pass moments for one {n, g} slice on channels last with the group
+// width D fixed at compile time, so the per-row loops have no tail handling
+// and fully unroll. Rows are reduced as exact fp32 sum/sumsq over chunks and
+// the chunks are merged into running per-lane {mean, m2} with Chan's parallel
+// Welford update, which stays stable over the long HxW reductions of
+// diffusion UNet activations. Returns {mean, var}.
+template <typename T, int64_t kD>
+std::tuple<at::opmath_type<T>, at::opmath_type<T>> ColumnwiseMomentsWelford(
+    const T* X_data,
+    int64_t HxW,
+    int64_t C) {
+  using opmath_t = at::opmath_type<T>;
+  constexpr int64_t kChunk = 256;
+  alignas(64) opmath_t lane_mean[kD] = {0};
+  alignas(64) opmath_t lane_m2[kD] = {0};
+  alignas(64) opmath_t chunk_sum[kD];
+  alignas(64) opmath_t chunk_sumsq[kD];
+  int64_t count = 0;
+  for (int64_t m0 = 0; m0 < HxW; m0 += kChunk) {
+    const int64_t rows = std::min(kChunk, HxW - m0);
+    std::fill(chunk_sum, chunk_sum + kD, opmath_t(0));
+    std::fill(chunk_sumsq, chunk_sumsq + kD, opmath_t(0));
+    // center each chunk on its first row so the sumsq reduction does not
+    // cancel catastrophically when |mean| >> stddev
+    alignas(64) opmath_t shift[kD];
+    for (int64_t d = 0; d < kD; d++) {
+      shift[d] = opmath_t(X_data[m0 * C + d]);
+    }
+    for (const auto m : c10::irange(m0, m0 + rows)) {
+      const T* X_ptr = X_data + m * C;
+      for (int64_t d = 0; d < kD; d++) {
+        opmath_t x = opmath_t(X_ptr[d]) - shift[d];
+        chunk_sum[d] += x;
+        chunk_sumsq[d] += x * x;
+      }
+    }
+    const opmath_t c = opmath_t(rows);
+    const opmath_t tot = opmath_t(count) + c;
+    const opmath_t chunk_weight = c / tot;
+    const opmath_t cross_weight = opmath_t(count) * c / tot;
+    for (int64_t d = 0; d < kD; d++) {
+      opmath_t chunk_mean = shift[d] + chunk_sum[d] / c;
+      opmath_t chunk_m2 = chunk_sumsq[d] - (chunk_sum[d] / c) * chunk_sum[d];
+      opmath_t delta = chunk_mean - lane_mean[d];
+      lane_mean[d] += delta * chunk_weight;
+      lane_m2[d] += chunk_m2 + delta * delta * cross_weight;
+    }
+    count += rows;
+  }
+  // fold the kD equal-count lane statistics into one {mean, var}
+  opmath_t mean_val{0}, m2_val{0}, n_acc{0};
+  for (int64_t d = 0; d < kD; d++) {
+    opmath_t c = opmath_t(count);
+    opmath_t tot = n_acc + c;
+    opmath_t delta = lane_mean[d] - mean_val;
+    mean_val += delta * (c / tot);
+    m2_val += lane_m2[d] + delta * delta * (n_acc * c / tot);
+    n_acc = tot;
+  }
+  return std::tuple<at::opmath_type<T>, at::opmath_type<T>>(
+      mean_val, m2_val / n_acc);
+}
+
+// Dispatches the {n, g} slice moments to a compile-time specialization of
+// the common group widths (C/G for the UNet channel counts with the
+// conventional 32 groups), falling back to the generic vectorized two-sum
+// reduction otherwise. Returns {mean, var}.
+template <typename T>
+std::tuple<at::opmath_type<T>, at::opmath_type<T>> GroupMomentsChannelsLast(
+    const T* X_ptr,
+    int64_t HxW,
+    int64_t C,
+    int64_t D,
+    at::opmath_type<T> s) {
+  using opmath_t = at::opmath_type<T>;
+  switch (D) {
+#define IPEX_GROUP_MOMENTS_CASE(kD) \
+  case kD:                          \
+    return ColumnwiseMomentsWelford<T, kD>(X_ptr, HxW, C);
+    IPEX_GROUP_MOMENTS_CASE(10)
+    IPEX_GROUP_MOMENTS_CASE(20)
+    IPEX_GROUP_MOMENTS_CASE(30)
+    IPEX_GROUP_MOMENTS_CASE(40)
+    IPEX_GROUP_MOMENTS_CASE(60)
+    IPEX_GROUP_MOMENTS_CASE(80)
+#undef IPEX_GROUP_MOMENTS_CASE
+    default: {
+      opmath_t mean_val, rstd_val;
+      std::tie(mean_val, rstd_val) = ColumnwiseMoments(X_ptr, HxW, C, D);
+      mean_val *= s;
+      opmath_t var_val =
+          std::max(rstd_val * s - mean_val * mean_val, opmath_t(0));
+      return std::tuple<opmath_t, opmath_t>(mean_val, var_val);
+    }
+  }
+}
+
 template <typename T, typename opmath_t>
 inline typename std::enable_if<std::is_same<T, opmath_t>::value, void>::type
 CalcMeanVar(const T* X_ptr, opmath_t* mean_ptr, opmath_t* rstd_ptr, int64_t C) {
@@ -343,7 +440,17 @@ void GroupNormKernelImplChannelsLastInternal(
   //
 
   constexpr int64_t feature_map_threshold = 1024;
-  if (HxW < feature_map_threshold) {
+  // Large feature maps normally take impl-2, but when one {n, g} slice is
+  // small enough to stay cache resident (e.g. the 64x64x960 / 32-group
+  // activations of diffusion UNets), impl-1 is preferable as long as N * G
+  // offers enough parallelism: the normalize pass then re-reads the slice
+  // from cache instead of streaming the whole activation from memory a
+  // second time.
+  constexpr int64_t cache_resident_bytes = 512 * 1024;
+  const bool cache_resident_slice =
+      D * HxW * static_cast<int64_t>(sizeof(T)) <= cache_resident_bytes &&
+      N * G >= at::get_num_threads();
+  if (HxW < feature_map_threshold || cache_resident_slice) {
     // impl-1: parallel on N * G.
     //
     // for each plain of HxW, scale and bias is calculated only once
@@ -364,10 +471,8 @@ void GroupNormKernelImplChannelsLastInternal(
         // and do a horizontal add just once for each {n, g}.
         //
         opmath_t mean_val, rstd_val;
-        std::tie(mean_val, rstd_val) =
-            ColumnwiseMoments(X_data + n * HxW * C + g * D, HxW, C, D);
-        mean_val *= s;
-        rstd_val = std::max(rstd_val * s - mean_val * mean_val, opmath_t(0));
+        std::tie(mean_val, rstd_val) = GroupMomentsChannelsLast<T>(
+            X_data + n * HxW * C + g * D, HxW, C, D, s);
         rstd_val = opmath_t(1) / std::sqrt(rstd_val + eps);
         mean_data[i] = mean_val;
         rstd_data[i] = rstd_val;
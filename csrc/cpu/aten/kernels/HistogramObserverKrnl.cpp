@@ -0,0 +1,200 @@
+#include <aten/HistogramObserver.h>
+
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec/functional.h>
+#include <ATen/cpu/vec/vec.h>
+
+#include <limits>
+#include <vector>
+
+namespace torch_ipex {
+namespace cpu {
+
+namespace {
+
+using fVec = at::vec::Vectorized<float>;
+
+inline int64_t divup(int64_t x, int64_t y) {
+  return (x + y - 1) / y;
+}
+
+// One slab of the observation pass: vectorized min/max accumulation
+// fused with histogram binning over the same loaded lanes, so the
+// activation data is streamed through exactly once. The bin scatter is
+// inherently a gather/increment and stays scalar, but it works on the
+// already-resident vector lanes instead of a second pass.
+inline void observe_slab_float(
+    const float* data,
+    int64_t len,
+    int64_t bins,
+    float hist_min,
+    float scale,
+    int64_t* hist,
+    float& slab_min,
+    float& slab_max) {
+  fVec vmin(std::numeric_limits<float>::infinity());
+  fVec vmax(-std::numeric_limits<float>::infinity());
+  const float max_bin = static_cast<float>(bins - 1);
+  int64_t d = 0;
+  for (; d + fVec::size() <= len; d += fVec::size()) {
+    fVec v = fVec::loadu(data + d);
+    vmin = at::vec::minimum(vmin, v);
+    vmax = at::vec::maximum(vmax, v);
+    // clamp into the valid bin range before truncation; out-of-range
+    // values land in the edge bins so the counts stay complete
+    fVec bin = at::vec::minimum(
+        at::vec::maximum((v - fVec(hist_min)) * fVec(scale), fVec(0.f)),
+        fVec(max_bin));
+    float bin_lane[fVec::size()];
+    bin.store(bin_lane);
+    for (int i = 0; i < fVec::size(); ++i) {
+      hist[static_cast<int64_t>(bin_lane[i])]++;
+    }
+  }
+  slab_min = std::min(
+      slab_min,
+      at::vec::vec_reduce_all<float>(
+          [](fVec& x, fVec& y) { return at::vec::minimum(x, y); }, vmin));
+  slab_max = std::max(
+      slab_max,
+      at::vec::vec_reduce_all<float>(
+          [](fVec& x, fVec& y) { return at::vec::maximum(x, y); }, vmax));
+  for (; d < len; ++d) {
+    float v = data[d];
+    slab_min = std::min(slab_min, v);
+    slab_max = std::max(slab_max, v);
+    float bin = std::min(std::max((v - hist_min) * scale, 0.f), max_bin);
+    hist[static_cast<int64_t>(bin)]++;
+  }
+}
+
+inline void observe_slab_bf16(
+    const at::BFloat16* data,
+    int64_t len,
+    int64_t bins,
+    float hist_min,
+    float scale,
+    int64_t* hist,
+    float& slab_min,
+    float& slab_max) {
+  using bVec = at::vec::Vectorized<at::BFloat16>;
+  fVec vmin(std::numeric_limits<float>::infinity());
+  fVec vmax(-std::numeric_limits<float>::infinity());
+  const float max_bin = static_cast<float>(bins - 1);
+  int64_t d = 0;
+  for (; d + bVec::size() <= len; d += bVec::size()) {
+    fVec v0, v1;
+    std::tie(v0, v1) = at::vec::convert_bfloat16_float(bVec::loadu(data + d));
+    for (fVec v : {v0, v1}) {
+      vmin = at::vec::minimum(vmin, v);
+      vmax = at::vec::maximum(vmax, v);
+      fVec bin = at::vec::minimum(
+          at::vec::maximum((v - fVec(hist_min)) * fVec(scale), fVec(0.f)),
+          fVec(max_bin));
+      float bin_lane[fVec::size()];
+      bin.store(bin_lane);
+      for (int i = 0; i < fVec::size(); ++i) {
+        hist[static_cast<int64_t>(bin_lane[i])]++;
+      }
+    }
+  }
+  slab_min = std::min(
+      slab_min,
+      at::vec::vec_reduce_all<float>(
+          [](fVec& x, fVec& y) { return at::vec::minimum(x, y); }, vmin));
+  slab_max = std::max(
+      slab_max,
+      at::vec::vec_reduce_all<float>(
+          [](fVec& x, fVec& y) { return at::vec::maximum(x, y); }, vmax));
+  for (; d < len; ++d) {
+    float v = static_cast<float>(data[d]);
+    slab_min = std::min(slab_min, v);
+    slab_max = std::max(slab_max, v);
+    float bin = std::min(std::max((v - hist_min) * scale, 0.f), max_bin);
+    hist[static_cast<int64_t>(bin)]++;
+  }
+}
+
+std::tuple<double, double> histogram_observe_kernel_impl(
+    const at::Tensor& input,
+    at::Tensor& histogram,
+    double hist_min,
+    double hist_max) {
+  auto input_ = input.contiguous();
+  int64_t numel = input_.numel();
+  int64_t bins = histogram.numel();
+  int64_t* hist_data = histogram.data_ptr<int64_t>();
+  if (numel == 0) {
+    return std::make_tuple(
+        std::numeric_limits<double>::infinity(),
+        -std::numeric_limits<double>::infinity());
+  }
+
+  const float scale =
+      static_cast<float>(bins / (hist_max - hist_min));
+  const float h_min = static_cast<float>(hist_min);
+
+  // one contiguous slab per worker with private histogram and min/max
+  // accumulators (2048 bins = 16KB, comfortably cache resident); the
+  // per-slab results are merged serially afterwards so the hot pass
+  // needs no atomics
+  int64_t num_slabs = std::min<int64_t>(at::get_num_threads(), numel);
+  int64_t slab_size = divup(numel, num_slabs);
+  num_slabs = divup(numel, slab_size);
+  std::vector<int64_t> slab_hist(num_slabs * bins, 0);
+  std::vector<float> slab_min(
+      num_slabs, std::numeric_limits<float>::infinity());
+  std::vector<float> slab_max(
+      num_slabs, -std::numeric_limits<float>::infinity());
+
+  at::parallel_for(0, num_slabs, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t s = begin; s < end; ++s) {
+      int64_t slab_begin = s * slab_size;
+      int64_t len = std::min(slab_size, numel - slab_begin);
+      int64_t* hist = slab_hist.data() + s * bins;
+      if (input_.scalar_type() == at::kFloat) {
+        observe_slab_float(
+            input_.data_ptr<float>() + slab_begin,
+            len,
+            bins,
+            h_min,
+            scale,
+            hist,
+            slab_min[s],
+            slab_max[s]);
+      } else {
+        observe_slab_bf16(
+            input_.data_ptr<at::BFloat16>() + slab_begin,
+            len,
+            bins,
+            h_min,
+            scale,
+            hist,
+            slab_min[s],
+            slab_max[s]);
+      }
+    }
+  });
+
+  float global_min = std::numeric_limits<float>::infinity();
+  float global_max = -std::numeric_limits<float>::infinity();
+  for (int64_t s = 0; s < num_slabs; ++s) {
+    global_min = std::min(global_min, slab_min[s]);
+    global_max = std::max(global_max, slab_max[s]);
+    const int64_t* hist = slab_hist.data() + s * bins;
+    for (int64_t b = 0; b < bins; ++b) {
+      hist_data[b] += hist[b];
+    }
+  }
+  return std::make_tuple(
+      static_cast<double>(global_min), static_cast<double>(global_max));
+}
+
+} // anonymous namespace
+
+IPEX_REGISTER_DISPATCH(
+    histogram_observe_kernel_stub,
+    &histogram_observe_kernel_impl);
+
+} // namespace cpu
+} // namespace torch_ipex
@@ -12,6 +12,9 @@
 #include <c10/util/TypeCast.h>
 #include <c10/util/irange.h>
 
+#include <algorithm>
+#include <vector>
+
 #include <utils/library.h>
 
 #include <aten/TensorAdvancedIndexing.h>
@@ -65,43 +68,86 @@ static void index_select_firstdim_impl(
   constexpr int64_t grain_size = at::internal::GRAIN_SIZE / 2;
   if (inner_size > grain_size) {
     constexpr int64_t block_size = 2048;
-    int64_t num_blocks = at::divup(inner_size, block_size);
+
+    // A run of consecutive index values selects rows that are contiguous in
+    // both the source and the result, so each run is one flat region that
+    // can be blocked as a whole. Threads are handed fixed-size element
+    // blocks (i.e. output bytes), not whole rows, so the split stays even
+    // regardless of how the runs are distributed. Random indices degenerate
+    // to length-1 runs and reproduce the former per-row blocking.
+    std::vector<int64_t> run_row; // first row of each run
+    std::vector<int64_t> block_prefix; // exclusive prefix of blocks per run
+    run_row.reserve(index_size + 1);
+    block_prefix.reserve(index_size + 1);
+    block_prefix.push_back(0);
+    for (int64_t j = 0; j < index_size;) {
+      index_t offset = index_data[j];
+      int64_t run = 1;
+      while (j + run < index_size && index_data[j + run] == offset + run) {
+        run++;
+      }
+      run_row.push_back(j);
+      block_prefix.push_back(
+          block_prefix.back() + at::divup(run * inner_size, block_size));
+      j += run;
+    }
+    run_row.push_back(index_size);
+    int64_t num_runs = run_row.size() - 1;
+
     at::parallel_for(
         0,
-        index_size * num_blocks,
+        block_prefix[num_runs],
         grain_size / block_size,
         [&](int64_t begin, int64_t end) {
+          // locate the run holding the first block of this thread
+          int64_t r =
+              std::upper_bound(
+                  block_prefix.begin(), block_prefix.end(), begin) -
+              block_prefix.begin() - 1;
           for (const auto ii : c10::irange(begin, end)) {
-            int64_t j = ii / num_blocks;
-            int64_t k = ii % num_blocks;
-            int64_t inner_idx_begin = k * block_size;
-            int64_t size = std::min(block_size, inner_size - inner_idx_begin);
+            while (ii >= block_prefix[r + 1]) {
+              r++;
+            }
+            int64_t run_elems = (run_row[r + 1] - run_row[r]) * inner_size;
+            int64_t elem_begin = (ii - block_prefix[r]) * block_size;
+            int64_t size = std::min(block_size, run_elems - elem_begin);
 
-            index_t offset = index_data[j];
+            index_t offset = index_data[run_row[r]];
             scalar_t* self_ptr =
-                self_data + offset * inner_size + inner_idx_begin;
+                self_data + offset * inner_size + elem_begin;
             scalar_t* result_ptr =
-                result_data + j * inner_size + inner_idx_begin;
+                result_data + run_row[r] * inner_size + elem_begin;
             copy_stub(result_ptr, self_ptr, size);
           }
         });
   } else {
+    // Rows are uniform, so splitting the index space by row count already
+    // hands each thread an equal share of output bytes. Within a thread,
+    // consecutive index values select adjacent source rows; detect such runs
+    // on the fly and fuse them into one bulk copy, so mostly-sorted index
+    // streams turn into long streaming copies instead of per-row gathers.
     at::parallel_for(
         0,
         index_size,
         grain_size / inner_size,
         [&](int64_t begin, int64_t end) {
-          for (const auto j : c10::irange(begin, end)) {
+          int64_t j = begin;
+          while (j < end) {
             index_t offset = index_data[j];
+            int64_t run = 1;
+            while (j + run < end && index_data[j + run] == offset + run) {
+              run++;
+            }
 #ifdef __GNUC__
-            if (j + 1 < index_size) {
+            if (j + run < index_size) {
               __builtin_prefetch(
-                  self_data + index_data[j + 1] * inner_size, 0, 1);
+                  self_data + index_data[j + run] * inner_size, 0, 1);
             }
 #endif // __GNUC__
             scalar_t* self_ptr = self_data + offset * inner_size;
             scalar_t* result_ptr = result_data + j * inner_size;
-            copy_stub(result_ptr, self_ptr, inner_size);
+            copy_stub(result_ptr, self_ptr, run * inner_size);
+            j += run;
           }
         });
   }
@@ -223,7 +269,9 @@ void cpu_index_select_dispatch(
   // 2. `index_select_firstdim_impl`: used when dim is the first dimension.
   //   The kernel may directly parallel on {index_size} or do blocking on
   //   {inner_size} so as to further extend parallelism. Therefore we may
-  //   efficiently handle both thin tall shapes and flat shapes.
+  //   efficiently handle both thin tall shapes and flat shapes. Runs of
+  //   consecutive index values are fused into bulk contiguous copies in
+  //   both modes, which matters for mostly-sorted index streams.
   //
   // 3. `index_select_non_firstdim_impl`: the most generic case.
   //   The kernel parallels on {outer_size, index_size} and do vectorized copy
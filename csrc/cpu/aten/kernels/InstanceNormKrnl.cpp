@@ -75,6 +75,24 @@ inline static void _mm512_mask_storeu_data_ps(
 #endif
 
 #if defined(CPU_CAPABILITY_AVX512)
+// Merge the Welford triple (nb, mb, m2b) into (n, mean, m2) with Chan's
+// update.
+inline static void _welford_combine(
+    float& n,
+    float& mean,
+    float& m2,
+    float nb,
+    float mb,
+    float m2b) {
+  if (nb == 0)
+    return;
+  auto ntot = n + nb;
+  auto delta = mb - mean;
+  mean += delta * nb / ntot;
+  m2 += m2b + delta * delta * n * nb / ntot;
+  n = ntot;
+}
+
 template <typename T>
 void channels_first_forward(
     T* in,
@@ -84,43 +102,61 @@ void channels_first_forward(
     float& m,
     float& v,
     int64_t channel,
-    int64_t rl) {
+    int64_t rl,
+    bool apply_relu) {
   int64_t d;
-  auto vsum = _mm512_setzero_ps();
-  auto vsum2 = _mm512_setzero_ps();
+  // Single-pass Welford statistics: one running (mean, M2) triple per
+  // lane over the vector body, a scalar triple for the tail, merged with
+  // Chan's update. Unlike the sum/sum-of-squares moments, this stays
+  // accurate when the mean dominates the spread.
+  auto vmean_acc = _mm512_setzero_ps();
+  auto vm2_acc = _mm512_setzero_ps();
   auto* pin = in;
+  int64_t nvec = rl / 16;
 
-  for (d = 0; d < rl / 16 * 16; d += 16) {
+  for (d = 0; d < nvec * 16; d += 16) {
     auto f = _mm512_loadu_data_ps<T>(&pin[d]);
-    vsum += f;
-    vsum2 += f * f;
+    auto rn = _mm512_set1_ps(1.0f / (d / 16 + 1));
+    auto delta = f - vmean_acc;
+    vmean_acc += delta * rn;
+    vm2_acc += delta * (f - vmean_acc);
   }
 
-  if (d < rl) {
-    auto rem = rl - d;
-    __mmask16 k = (1 << rem) - 1;
-    auto f = _mm512_mask_loadu_data_ps<T>(k, &pin[d]);
-    vsum += f;
-    vsum2 += f * f;
-  }
+  float lane_mean[16];
+  float lane_m2[16];
+  _mm512_storeu_ps(lane_mean, vmean_acc);
+  _mm512_storeu_ps(lane_m2, vm2_acc);
 
-  auto veps = _mm512_set1_ps(1e-5);
-  auto vmean = _mm512_mean_reduce_ps(vsum, rl);
-  auto vmean2 = _mm512_mean_reduce_ps(vsum2, rl);
-  auto vvar2 = vmean2 - vmean * vmean;
+  float n = 0;
+  float mean = 0;
+  float m2 = 0;
+  for (int l = 0; l < 16; ++l) {
+    _welford_combine(n, mean, m2, nvec, lane_mean[l], lane_m2[l]);
+  }
+  for (; d < rl; ++d) {
+    float x = static_cast<float>(pin[d]);
+    n += 1;
+    auto delta = x - mean;
+    mean += delta / n;
+    m2 += delta * (x - mean);
+  }
 
-  m = vmean[0];
-  v = vvar2[0];
-  vvar2 += veps;
+  m = mean;
+  v = m2 / rl;
 
+  auto vmean = _mm512_set1_ps(mean);
+  auto vvar2 = _mm512_set1_ps(v + 1e-5f);
   auto r_vvar = 1. / _mm512_sqrt_ps(vvar2);
   auto* pout = out;
   auto w = _mm512_set1_ps(weight);
   auto b = _mm512_set1_ps(bias);
+  auto zero = _mm512_setzero_ps();
 
   for (d = 0; d < rl / 16 * 16; d += 16) {
     auto f = _mm512_loadu_data_ps<T>(&pin[d]);
     auto o = (f - vmean) * w * r_vvar + b;
+    if (apply_relu)
+      o = _mm512_max_ps(zero, o);
     _mm512_storeu_data_ps<T>(&pout[d], o);
   }
   if (d < rl) {
@@ -128,6 +164,8 @@ void channels_first_forward(
     __mmask16 k = (1 << rem) - 1;
     auto f = _mm512_mask_loadu_data_ps<T>(k, &pin[d]);
     auto o = (f - vmean) * w * r_vvar + b;
+    if (apply_relu)
+      o = _mm512_max_ps(zero, o);
     _mm512_mask_storeu_data_ps<T>(&pout[d], k, o);
   }
 }
@@ -138,7 +176,8 @@ template <typename T>
 std::vector<at::Tensor> instancenorm_forward_channels_first(
     const at::Tensor& input,
     const at::Tensor& weight,
-    const at::Tensor& bias) {
+    const at::Tensor& bias,
+    bool apply_relu) {
   auto in_sz = input.sizes();
   auto channel = in_sz[1];
   int64_t reduce_l;
@@ -183,7 +222,8 @@ std::vector<at::Tensor> instancenorm_forward_channels_first(
         m[i],
         v[i],
         channel,
-        reduce_l);
+        reduce_l,
+        apply_relu);
   }
   return {output, mean_t, var_t};
 }
@@ -329,8 +369,13 @@ std::vector<at::Tensor> instancenorm_backward_channels_first(
 #endif
 
 #if defined(CPU_CAPABILITY_AVX512)
+// Per-channel single-pass Welford statistics over the bl rows of one
+// block: the lanes map onto channels, so every row contributes exactly
+// one sample per lane and the running mean divides by the same scalar
+// count. Writes the block (mean, M2) pair, merged across blocks with
+// Chan's update by the caller.
 template <typename T>
-void channels_last_mean_var(T* in, float* m, float* v, int64_t c, int64_t bl) {
+void channels_last_welford(T* in, float* m, float* m2, int64_t c, int64_t bl) {
   auto vnum = c / 16;
   auto vrem = c % 16;
   auto vnum_total = vnum;
@@ -338,38 +383,40 @@ void channels_last_mean_var(T* in, float* m, float* v, int64_t c, int64_t bl) {
     vnum_total += 1;
 
   __m512 sm[vnum_total];
-  __m512 smm[vnum_total];
+  __m512 sm2[vnum_total];
   for (int i = 0; i < vnum_total; ++i) {
     sm[i] = _mm512_setzero_ps();
-    smm[i] = _mm512_setzero_ps();
+    sm2[i] = _mm512_setzero_ps();
   }
 
   auto* pin = in;
-  auto rbl = _mm512_set1_ps(1.0 / bl);
   for (auto i = 0; i < bl; ++i) {
+    auto rn = _mm512_set1_ps(1.0f / (i + 1));
     int64_t j;
     for (j = 0; j < vnum; ++j) {
       auto f = _mm512_loadu_data_ps<T>(&pin[(i * c + j * 16)]);
-      sm[j] += f;
-      smm[j] += f * f;
+      auto delta = f - sm[j];
+      sm[j] += delta * rn;
+      sm2[j] += delta * (f - sm[j]);
     }
     if (vrem > 0) {
       __mmask16 k = (1 << vrem) - 1;
       auto f = _mm512_mask_loadu_data_ps<T>(k, &pin[(i * c + j * 16)]);
-      sm[j] += f;
-      smm[j] += f * f;
+      auto delta = f - sm[j];
+      sm[j] += delta * rn;
+      sm2[j] += delta * (f - sm[j]);
     }
   }
 
   int64_t i;
   for (i = 0; i < vnum; ++i) {
-    _mm512_storeu_data_ps<float>(&m[i * 16], sm[i] * rbl);
-    _mm512_storeu_data_ps<float>(&v[i * 16], smm[i] * rbl);
+    _mm512_storeu_data_ps<float>(&m[i * 16], sm[i]);
+    _mm512_storeu_data_ps<float>(&m2[i * 16], sm2[i]);
   }
   if (vrem > 0) {
     __mmask16 k = (1 << vrem) - 1;
-    _mm512_mask_storeu_data_ps<float>(&m[i * 16], k, sm[i] * rbl);
-    _mm512_mask_storeu_data_ps<float>(&v[i * 16], k, smm[i] * rbl);
+    _mm512_mask_storeu_data_ps<float>(&m[i * 16], k, sm[i]);
+    _mm512_mask_storeu_data_ps<float>(&m2[i * 16], k, sm2[i]);
   }
 }
 #endif
@@ -384,7 +431,8 @@ void channels_last_norm(
     float* m,
     float* v,
     int64_t c,
-    int64_t bl) {
+    int64_t bl,
+    bool apply_relu) {
   auto vnum = c / 16;
   auto vrem = c % 16;
   auto vnum_total = vnum;
@@ -429,17 +477,22 @@ void channels_last_norm(
 
   auto* pin = in;
   auto* pout = out;
+  auto zero = _mm512_setzero_ps();
   for (auto i = 0; i < bl; ++i) {
     int64_t j;
     for (j = 0; j < vnum; ++j) {
       auto f = _mm512_loadu_data_ps<T>(&pin[(i * c + j * 16)]);
       auto o = _mm512_fmsub_ps(f, vscale[j], vshift[j]);
+      if (apply_relu)
+        o = _mm512_max_ps(zero, o);
       _mm512_storeu_data_ps<T>(&pout[(i * c + j * 16)], o);
     }
     if (vrem > 0) {
       __mmask16 k = (1 << vrem) - 1;
       auto f = _mm512_mask_loadu_data_ps<T>(k, &pin[(i * c + j * 16)]);
       auto o = _mm512_fmsub_ps(f, vscale[j], vshift[j]);
+      if (apply_relu)
+        o = _mm512_max_ps(zero, o);
       _mm512_mask_storeu_data_ps<T>(&pout[(i * c + j * 16)], k, o);
     }
   }
@@ -449,7 +502,8 @@ template <typename T>
 std::vector<at::Tensor> instancenorm_forward_channels_last(
     const at::Tensor& input,
     const at::Tensor& weight,
-    const at::Tensor& bias) {
+    const at::Tensor& bias,
+    bool apply_relu) {
   auto in_sz = input.sizes();
   auto batch = in_sz[0];
   auto channel = in_sz[1];
@@ -484,15 +538,42 @@ std::vector<at::Tensor> instancenorm_forward_channels_last(
     auto* bin = reinterpret_cast<T(*)[block_len * channel]>(in_ptr);
     auto* m = reinterpret_cast<float(*)[channel]>(m_ptr);
     auto* v = reinterpret_cast<float(*)[channel]>(v_ptr);
-    channels_last_mean_var<T>(bin[i], m[i], v[i], channel, block_len);
+    channels_last_welford<T>(bin[i], m[i], v[i], channel, block_len);
   }
 
-  auto mt = at::mean(mean_t, 1).reshape(batch * channel);
-  auto mt2 = at::mean(var_t, 1).reshape(batch * channel);
-  auto vt = mt2 - mt * mt;
+  // Merge the per-block Welford triples with Chan's update; every block
+  // covers block_len rows so the counts are uniform. The merge touches
+  // batch * block_num * channel statistics, negligible next to the
+  // activation sweeps.
+  auto mt = at::empty(
+      batch * channel,
+      at::TensorOptions().dtype<float>().memory_format(
+          c10::MemoryFormat::Contiguous));
+  auto vt = at::empty(
+      batch * channel,
+      at::TensorOptions().dtype<float>().memory_format(
+          c10::MemoryFormat::Contiguous));
   auto* mt_ptr = mt.data_ptr();
   auto* vt_ptr = vt.data_ptr();
 
+#pragma omp parallel for
+  for (auto i = 0; i < batch; ++i) {
+    auto* bm = reinterpret_cast<float(*)[channel]>(m_ptr) + i * block_num;
+    auto* bm2 = reinterpret_cast<float(*)[channel]>(v_ptr) + i * block_num;
+    auto* om = reinterpret_cast<float(*)>(mt_ptr) + i * channel;
+    auto* ov = reinterpret_cast<float(*)>(vt_ptr) + i * channel;
+    for (int64_t ch = 0; ch < channel; ++ch) {
+      float n = 0;
+      float mean = 0;
+      float m2 = 0;
+      for (int64_t blk = 0; blk < block_num; ++blk) {
+        _welford_combine(n, mean, m2, block_len, bm[blk][ch], bm2[blk][ch]);
+      }
+      om[ch] = mean;
+      ov[ch] = m2 / reduce_l;
+    }
+  }
+
 #pragma omp parallel for
   for (auto i = 0; i < batch * block_num; ++i) {
     auto* bin = reinterpret_cast<T(*)[block_len * channel]>(in_ptr);
@@ -509,7 +590,8 @@ std::vector<at::Tensor> instancenorm_forward_channels_last(
         m[i / block_num],
         v[i / block_num],
         channel,
-        block_len);
+        block_len,
+        apply_relu);
   }
   return {output, mt, vt};
 }
@@ -774,7 +856,8 @@ std::vector<at::Tensor> InstanceNormKernelImpl(
     const at::Tensor& running_mean,
     const at::Tensor& running_var,
     double eps,
-    bool is_channels_last) {
+    bool is_channels_last,
+    bool apply_relu) {
   int channel = input.sizes()[1];
   auto weight = weight_t.defined() ? weight_t : at::ones(channel);
   auto bias = bias_t.defined() ? bias_t : at::zeros(channel);
@@ -784,16 +867,18 @@ std::vector<at::Tensor> InstanceNormKernelImpl(
   if (is_channels_last) {
     if (data_type == c10::ScalarType::BFloat16) {
       return instancenorm_forward_channels_last<at::BFloat16>(
-          input, weight, bias);
+          input, weight, bias, apply_relu);
     } else {
-      return instancenorm_forward_channels_last<float>(input, weight, bias);
+      return instancenorm_forward_channels_last<float>(
+          input, weight, bias, apply_relu);
     }
   } else {
     if (data_type == c10::ScalarType::BFloat16) {
       return instancenorm_forward_channels_first<at::BFloat16>(
-          input, weight, bias);
+          input, weight, bias, apply_relu);
     } else {
-      return instancenorm_forward_channels_first<float>(input, weight, bias);
+      return instancenorm_forward_channels_first<float>(
+          input, weight, bias, apply_relu);
     }
   }
 #else
@@ -3,6 +3,7 @@
 #include "autocast/autocast_mode.h"
 #include "cpu/kernels/Interaction.h"
 #include "ideep/IDeepConversions.h"
+#include "utils/amx_tile.h"
 #include "vec/unroll_helper.hpp"
 #include "vec/vec.h"
 
@@ -251,6 +252,68 @@ inline void dot_product<BFloat16>(
   out[0] = BFloat16(acc);
 }
 
+// Cache-blocked pairwise dot products for the fp32 path: compute the
+// (feature x feature) Gram matrix in kTileF x kTileF register tiles so a
+// feature row fetched into L1 is reused kTileF times, and emit the flat
+// triangular packing straight from the accumulators instead of scattering
+// one scalar per dot-product call. The dense feature is already
+// concatenated in place by the caller, so the whole interaction row is
+// produced without a separate cat pass.
+static inline void flat_triangle_blocked(
+    const std::vector<float*>& input_ptr,
+    float* out,
+    uint32_t feature_nums,
+    uint32_t feature_size) {
+  using Vec = at::vec::Vectorized<float>;
+  constexpr int kTileF = 4;
+  const uint32_t vec_len = feature_size - (feature_size % Vec::size());
+  for (uint32_t i0 = 1; i0 < feature_nums; i0 += kTileF) {
+    const uint32_t i_max =
+        std::min<uint32_t>(i0 + kTileF, feature_nums);
+    for (uint32_t j0 = 0; j0 < i_max - 1; j0 += kTileF) {
+      // cols only pair with rows above them: j < i
+      const uint32_t j_max = std::min<uint32_t>(j0 + kTileF, i_max - 1);
+      const uint32_t i_lo = std::max<uint32_t>(i0, j0 + 1);
+      Vec acc[kTileF][kTileF];
+      for (int ii = 0; ii < kTileF; ii++) {
+        for (int jj = 0; jj < kTileF; jj++) {
+          acc[ii][jj] = Vec(0.f);
+        }
+      }
+      for (uint32_t k = 0; k < vec_len; k += Vec::size()) {
+        Vec b[kTileF];
+        for (uint32_t j = j0; j < j_max; j++) {
+          b[j - j0] = Vec::loadu(input_ptr[j] + k);
+        }
+        for (uint32_t i = i_lo; i < i_max; i++) {
+          Vec a = Vec::loadu(input_ptr[i] + k);
+          const uint32_t j_hi = std::min<uint32_t>(j_max, i);
+          for (uint32_t j = j0; j < j_hi; j++) {
+            acc[i - i0][j - j0] += a * b[j - j0];
+          }
+        }
+      }
+      float buf[Vec::size()] __attribute__((aligned(64)));
+      for (uint32_t i = i_lo; i < i_max; i++) {
+        const uint32_t j_hi = std::min<uint32_t>(j_max, i);
+        // row i of the triangle starts at i * (i - 1) / 2
+        float* out_row = out + i * (i - 1) / 2;
+        for (uint32_t j = j0; j < j_hi; j++) {
+          acc[i - i0][j - j0].store(buf);
+          float sum = 0.f;
+          for (int v = 0; v < Vec::size(); v++) {
+            sum += buf[v];
+          }
+          for (uint32_t k = vec_len; k < feature_size; k++) {
+            sum += input_ptr[i][k] * input_ptr[j][k];
+          }
+          out_row[j] = sum;
+        }
+      }
+    }
+  }
+}
+
 template <typename Tout, typename Tin>
 static inline void cat_backward(
     const Tin* in,
@@ -343,14 +406,18 @@ inline at::Tensor _interaction_forward(const std::vector<at::Tensor>& input) {
     for (int64_t i = start; i < end; i++) {
       move_ker(&out_data[i * out_data_line_len], input_ptr[0], feature_size);
       T* flat_buf = (T*)(&out_data[i * out_data_line_len] + feature_size);
-      auto o_offset = interact_feature_size;
-      for (int f1 = feature_nums - 1; f1 > 0; f1--) {
-        o_offset = o_offset - f1;
-        T* v1 = input_ptr[f1];
-        for (int f2 = 0; f2 < f1; f2++) {
-          T* v2 = input_ptr[f2];
-          T* out = flat_buf + o_offset + f2;
-          dot_product<T>(out, v1, v2, feature_size);
+      if constexpr (std::is_same<T, float>::value) {
+        flat_triangle_blocked(input_ptr, flat_buf, feature_nums, feature_size);
+      } else {
+        auto o_offset = interact_feature_size;
+        for (int f1 = feature_nums - 1; f1 > 0; f1--) {
+          o_offset = o_offset - f1;
+          T* v1 = input_ptr[f1];
+          for (int f2 = 0; f2 < f1; f2++) {
+            T* v2 = input_ptr[f2];
+            T* out = flat_buf + o_offset + f2;
+            dot_product<T>(out, v1, v2, feature_size);
+          }
         }
       }
       for (uint32_t n = 0; n < feature_nums; n++) {
@@ -443,20 +510,12 @@ inline std::vector<at::Tensor> _interaction_backward(
 }
 
 #if defined(CPU_CAPABILITY_AMX)
-typedef struct tileconfig_t {
-  uint8_t palette_id;
-  uint8_t startRow;
-  uint8_t reserved[14];
-  uint16_t colb[16];
-  uint8_t rows[16];
-} tileconfig_t;
-
 const uint8_t TILE_M = 16;
 const uint8_t TILE_N = 16;
 const uint8_t TILE_IK = 64;
 const uint8_t TILE_BK = 32;
 
-static tileconfig_t tc = {0};
+static TileConfig tc = {0};
 template <typename res_type, typename src_type>
 inline void set_tile_config(
     const uint8_t TILE_M,
@@ -520,7 +579,8 @@ inline at::Tensor _interaction_forward<at::BFloat16>(
     zero_ker(&Amem[0][0], _AM * _AK);
     at::BFloat16 Bmem[_AK >> 1][_AM][2] __attribute__((aligned(64)));
 
-    _tile_loadconfig((const void*)&tc);
+    TileConfigRegion tile_region;
+    load_tile_config_cached(tc);
 
     std::vector<at::BFloat16*> input_ptr(feature_nums);
     for (uint32_t n = 0; n < feature_nums; n++) {
@@ -647,7 +707,8 @@ inline std::vector<at::Tensor> _interaction_backward<at::BFloat16>(
     at::BFloat16 Bmem[_AK / 2][_AN][2] __attribute__((aligned(64)));
     float Cmem[_AM][_AN] __attribute__((aligned(64)));
 
-    _tile_loadconfig((const void*)&tc);
+    TileConfigRegion tile_region;
+    load_tile_config_cached(tc);
 
     std::vector<at::BFloat16*> input_ptr(feature_nums);
     std::vector<at::BFloat16*> output_ptr(feature_nums);
@@ -825,7 +886,7 @@ void interaction_int8_128_27_amx(
   const size_t ROW = _K + flat_nums; // 128 + 27 * 26/2
   TORCH_INTERNAL_ASSERT(input_data.size() == _S1);
   TORCH_INTERNAL_ASSERT(output.size(1) == ROW);
-  tileconfig_t tc = {0};
+  TileConfig tc = {0};
   tc.palette_id = 1;
   // tc.startRow = 0;
   //  Configure C tiles
@@ -852,7 +913,8 @@ void interaction_int8_128_27_amx(
     int32_t flat_buf[351] __attribute__((aligned(64)));
     int8_t Amem[_M][_K] __attribute__((aligned(64)));
     int8_t Bmem[_K / 4][_M][4] __attribute__((aligned(64)));
-    _tile_loadconfig((const void*)&tc);
+    TileConfigRegion tile_region;
+    load_tile_config_cached(tc);
     int8_t* local_input_data[_S1];
     int64_t bs_offset = start << LOG2_K;
     for (int i = 0; i < _S1; i++) {
@@ -960,6 +1022,42 @@ void interaction_int8_128_27_amx(
 
 #endif
 
+#if defined(CPU_CAPABILITY_AVX512_VNNI)
+// Byte-VNNI variant of _interaction_s8s8_scale_s32s8_128: rows are kept
+// as packed s8 (2 zmm each) instead of widened s16 (4 zmm each) and each
+// pair costs 2 vpdpbusd instead of 4 madd/dpwssd, with the per-tensor
+// scales folded in the same reduce epilogue.
+static inline void _interaction_s8s8_scale_s32s8_128_vnni(
+    int8_t* out,
+    size_t M,
+    const float* __attribute__((aligned(64))) scales,
+    const __m512i* raw_buf, // M x 2
+    const __m512i* biased_buf, // M x 2
+    const __m512i* comp_buf, // M
+    __m512i* cat_buf) {
+  int64_t offset = 0;
+  for (int i = 1; i < M; i++) {
+    const __m512i* a = &biased_buf[i * 2];
+    for (int j = 0; j < i; j++) {
+      mul_and_sum_s8x128_to_s32x16_vnni(
+          cat_buf[offset], a, &raw_buf[j * 2], comp_buf[j]);
+      offset++;
+    }
+  }
+
+  // Do reduce add with scale
+  int64_t off = 0;
+  for (; off < offset - 15; off += 16) {
+    __m512 scale_m512 = _mm512_load_ps((const void*)(scales + off));
+    reduce_add_s32x16x16_with_scales(out + off, cat_buf + off, scale_m512);
+  }
+  __m512 scale_m512 = _mm512_load_ps((const void*)(scales + off));
+  auto mask = ((1 << (offset - off)) - 1);
+  reduce_add_s32x16x16_with_scales_and_mask_store(
+      out + off, mask, cat_buf + off, scale_m512);
+}
+#endif
+
 #if defined(CPU_CAPABILITY_AVX512)
 static inline void _interaction_s8s8_scale_s32s8_128(
     int8_t* out,
@@ -1096,11 +1194,44 @@ at::Tensor dil_qinteraction_kernel_impl(
             ipex_free_aligned);
     __m512i* convert_to_s16_buf = convert_to_s16_buf_buff.get();
 
+#if defined(CPU_CAPABILITY_AVX512_VNNI)
+    // packed s8 rows (2 zmm), their 128-biased copies and per-row bias
+    // compensation for the byte-VNNI pair kernel
+    std::unique_ptr<__m512i, decltype(ipex_free_aligned)*> vnni_buf_buff(
+        (__m512i*)ipex_alloc_aligned(sizeof(__m512i) * (feature_nums * 5), 64),
+        ipex_free_aligned);
+    __m512i* raw_buf = vnni_buf_buff.get();
+    __m512i* biased_buf = raw_buf + feature_nums * 2;
+    __m512i* comp_buf = biased_buf + feature_nums * 2;
+#endif
+
     std::vector<int8_t*> input_addr(feature_nums);
     for (int64_t i = start; i < end; i++) {
       int8_t* out_ptr = &out_data[i * out_data_line_len];
       int8_t* flat_buf = (int8_t*)(out_ptr + feature_size);
       auto row_len = i * feature_size;
+#if defined(CPU_CAPABILITY_AVX512_VNNI)
+      if (feature_size == 128) {
+        for (int k = 0; k < feature_nums; k++) {
+          load_s8x128_biased_with_comp(
+              &input_data[k][row_len],
+              &raw_buf[k * 2],
+              &biased_buf[k * 2],
+              comp_buf[k]);
+        }
+        scale_and_move_ker_128(
+            out_ptr, &input_data[0][row_len], dense_scale);
+        _interaction_s8s8_scale_s32s8_128_vnni(
+            flat_buf,
+            feature_nums,
+            out_in_scales,
+            raw_buf,
+            biased_buf,
+            comp_buf,
+            cat_buf);
+        continue;
+      }
+#endif
 #if defined(CPU_CAPABILITY_AVX512)
       if (feature_size == 128) {
         int k = 0;
@@ -4,6 +4,8 @@
 #include <torch/all.h>
 #include <torch/csrc/autograd/function.h>
 #include <limits>
+#include <type_traits>
+#include "utils/hot_trace.h"
 #include "vec/vec.h"
 
 namespace torch_ipex {
@@ -11,12 +13,34 @@ namespace cpu {
 
 namespace {
 
-template <typename T>
-void reduce_head(
+// 64/96/128 cover every model we run. Routing them through a
+// std::integral_constant hands the per-head helpers a compile-time trip
+// count, so the vector loops fully unroll and the per-head state stays
+// in registers; other sizes keep the dynamic path.
+template <typename F>
+inline void dispatch_head_size(int64_t head_size, const F& f) {
+  switch (head_size) {
+    case 64:
+      f(std::integral_constant<int64_t, 64>{});
+      break;
+    case 96:
+      f(std::integral_constant<int64_t, 96>{});
+      break;
+    case 128:
+      f(std::integral_constant<int64_t, 128>{});
+      break;
+    default:
+      f(head_size);
+      break;
+  }
+}
+
+template <typename T, typename HS>
+void reduce_head_impl(
     const T* q_ptr_start,
     const T* k_ptr_start,
     float* attn_w_pos,
-    int64_t head_size,
+    HS head_size,
     bool store_key,
     T* k_cache_start) {
   for (auto hsi = 0; hsi < head_size; hsi++) {
@@ -27,12 +51,12 @@ void reduce_head(
   }
 }
 #if defined(CPU_CAPABILITY_AVX512)
-template <>
-void reduce_head(
+template <typename HS>
+void reduce_head_impl(
     const float* q_ptr_start,
     const float* k_ptr_start,
     float* attn_w_pos,
-    int64_t head_size,
+    HS head_size,
     bool store_key,
     float* k_cache_start) {
   auto hsi = 0;
@@ -54,12 +78,12 @@ void reduce_head(
   return;
 }
 
-template <>
-void reduce_head(
+template <typename HS>
+void reduce_head_impl(
     const at::BFloat16* q_ptr_start,
     const at::BFloat16* k_ptr_start,
     float* attn_w_pos,
-    int64_t head_size,
+    HS head_size,
     bool store_key,
     at::BFloat16* k_cache_start) {
   auto hsi = 0;
@@ -85,11 +109,12 @@ void reduce_head(
   return;
 }
 
-void reduce_head(
+template <typename HS>
+void reduce_head_impl(
     const at::Half* q_ptr_start,
     const at::Half* k_ptr_start,
     float* attn_w_pos,
-    int64_t head_size,
+    HS head_size,
     bool store_key,
     at::Half* k_cache_start) {
   auto hsi = 0;
@@ -116,12 +141,27 @@ void reduce_head(
 }
 #endif
 
+template <typename T>
+void reduce_head(
+    const T* q_ptr_start,
+    const T* k_ptr_start,
+    float* attn_w_pos,
+    int64_t head_size,
+    bool store_key,
+    T* k_cache_start) {
+  dispatch_head_size(head_size, [&](auto hs) {
+    reduce_head_impl(
+        q_ptr_start, k_ptr_start, attn_w_pos, hs, store_key, k_cache_start);
+  });
+}
+
 #if defined(CPU_CAPABILITY_AVX512_FP16)
-void reduce_head_half(
+template <typename HS>
+void reduce_head_half_impl(
     const at::Half* q_ptr_start,
     const at::Half* k_ptr_start,
     at::Half* attn_w_pos,
-    int64_t head_size,
+    HS head_size,
     bool store_key,
     at::Half* k_cache_start) {
   auto hsi = 0;
@@ -141,18 +181,31 @@ void reduce_head_half(
     attn_w_pos[0] += q_ptr_start[hsi] * k_ptr_start[hsi];
   }
 }
+
+void reduce_head_half(
+    const at::Half* q_ptr_start,
+    const at::Half* k_ptr_start,
+    at::Half* attn_w_pos,
+    int64_t head_size,
+    bool store_key,
+    at::Half* k_cache_start) {
+  dispatch_head_size(head_size, [&](auto hs) {
+    reduce_head_half_impl(
+        q_ptr_start, k_ptr_start, attn_w_pos, hs, store_key, k_cache_start);
+  });
+}
 #endif
 
 /*
  *reduce the attention_weights with the value embedding by the dimension of
  *head_size for every head
  */
-template <typename T, typename T1>
-void mul_attenion_weights_and_value_of_head(
+template <typename T, typename T1, typename HS>
+void mul_attenion_weights_and_value_of_head_impl(
     float& attn_w,
     const T* v_ptr_start,
     T1* attn_out_start,
-    int64_t head_size,
+    HS head_size,
     bool store_value,
     T* v_cache_start,
     bool accumulate) {
@@ -169,12 +222,12 @@ void mul_attenion_weights_and_value_of_head(
 }
 
 #if defined(CPU_CAPABILITY_AVX512)
-template <>
-void mul_attenion_weights_and_value_of_head(
+template <typename HS>
+void mul_attenion_weights_and_value_of_head_impl(
     float& attn_w,
     const float* v_ptr_start,
     float* attn_out_start,
-    int64_t head_size,
+    HS head_size,
     bool store_value,
     float* v_cache_start,
     bool accumulate) {
@@ -208,12 +261,12 @@ void mul_attenion_weights_and_value_of_head(
   return;
 }
 
-template <>
-void mul_attenion_weights_and_value_of_head(
+template <typename HS>
+void mul_attenion_weights_and_value_of_head_impl(
     float& attn_w,
     const at::BFloat16* v_ptr_start,
     at::BFloat16* attn_out_start,
-    int64_t head_size,
+    HS head_size,
     bool store_value,
     at::BFloat16* v_cache_start,
     bool accumulate) {
@@ -263,12 +316,12 @@ void mul_attenion_weights_and_value_of_head(
   }
   return;
 }
-template <>
-void mul_attenion_weights_and_value_of_head(
+template <typename HS>
+void mul_attenion_weights_and_value_of_head_impl(
     float& attn_w,
     const at::BFloat16* v_ptr_start,
     float* attn_out_start,
-    int64_t head_size,
+    HS head_size,
     bool store_value,
     at::BFloat16* v_cache_start,
     bool accumulate) {
@@ -310,12 +363,12 @@ void mul_attenion_weights_and_value_of_head(
   return;
 }
 
-template <>
-void mul_attenion_weights_and_value_of_head(
+template <typename HS>
+void mul_attenion_weights_and_value_of_head_impl(
     float& attn_w,
     const at::Half* v_ptr_start,
     at::Half* attn_out_start,
-    int64_t head_size,
+    HS head_size,
     bool store_value,
     at::Half* v_cache_start,
     bool accumulate) {
@@ -365,12 +418,12 @@ void mul_attenion_weights_and_value_of_head(
   }
   return;
 }
-template <>
-void mul_attenion_weights_and_value_of_head(
+template <typename HS>
+void mul_attenion_weights_and_value_of_head_impl(
     float& attn_w,
     const at::Half* v_ptr_start,
     float* attn_out_start,
-    int64_t head_size,
+    HS head_size,
     bool store_value,
     at::Half* v_cache_start,
     bool accumulate) {
@@ -413,12 +466,34 @@ void mul_attenion_weights_and_value_of_head(
 }
 #endif
 
+template <typename T, typename T1>
+void mul_attenion_weights_and_value_of_head(
+    float& attn_w,
+    const T* v_ptr_start,
+    T1* attn_out_start,
+    int64_t head_size,
+    bool store_value,
+    T* v_cache_start,
+    bool accumulate) {
+  dispatch_head_size(head_size, [&](auto hs) {
+    mul_attenion_weights_and_value_of_head_impl(
+        attn_w,
+        v_ptr_start,
+        attn_out_start,
+        hs,
+        store_value,
+        v_cache_start,
+        accumulate);
+  });
+}
+
 #if defined(CPU_CAPABILITY_AVX512_FP16)
-void mul_attenion_weights_and_value_of_head_half(
+template <typename HS>
+void mul_attenion_weights_and_value_of_head_half_impl(
     at::Half& attn_w,
     const at::Half* v_ptr_start,
     at::Half* attn_out_start,
-    int64_t head_size,
+    HS head_size,
     bool store_value,
     at::Half* v_cache_start,
     bool accumulate) {
@@ -451,6 +526,26 @@ void mul_attenion_weights_and_value_of_head_half(
     }
   }
 }
+
+void mul_attenion_weights_and_value_of_head_half(
+    at::Half& attn_w,
+    const at::Half* v_ptr_start,
+    at::Half* attn_out_start,
+    int64_t head_size,
+    bool store_value,
+    at::Half* v_cache_start,
+    bool accumulate) {
+  dispatch_head_size(head_size, [&](auto hs) {
+    mul_attenion_weights_and_value_of_head_half_impl(
+        attn_w,
+        v_ptr_start,
+        attn_out_start,
+        hs,
+        store_value,
+        v_cache_start,
+        accumulate);
+  });
+}
 #endif
 
 template <typename T>
@@ -489,6 +584,38 @@ void copy_key_value(
   }
 }
 
+/*
+ *Reconstruct the per-sequence beam indirection for every past token by
+ *chasing the per-step beam choices in beam_idx backward from the latest
+ *decoded token. The attention kernels gather K/V cache rows through this
+ *table (like block_tables in PagedAttention), so a beam-search reorder is a
+ *single-row update of beam_idx on the frontend side instead of a copy of the
+ *whole KV cache. The table is laid out as [bs][offset + cur_len + 1]; heap
+ *storage keeps long contexts off the stack.
+ */
+static inline std::vector<long> reconstruct_beam_indices(
+    const at::Tensor& beam_idx,
+    int64_t bs,
+    int64_t offset,
+    int64_t cur_len) {
+  std::vector<long> new_beam_idx(bs * (offset + cur_len + 1), 0);
+  auto b_ptr = beam_idx.data_ptr<long>();
+  auto stride = offset + cur_len + 1;
+  if (offset > 0) {
+    // according to the last decoded token to get the target beam for the past
+    // token
+    for (auto i = 0; i < bs; i++) {
+      new_beam_idx[i * stride + offset - 1] = b_ptr[(offset - 1) * bs + i];
+      for (auto j = offset - 2; j >= 0;
+           j--) { // for the token of input, the target beam is alwarys 0
+        new_beam_idx[i * stride + j] =
+            b_ptr[j * bs + new_beam_idx[i * stride + j + 1]];
+      }
+    }
+  }
+  return new_beam_idx;
+}
+
 /*
  *The scale-dot product for indirect access kv chache and fuse
  *matmul+div+add+softmax to improve data reuse
@@ -553,19 +680,8 @@ scale_dot_product_for_indirect_access_kv_cache(
   auto attn_out_ptr = attn_outs.data_ptr<VT>();
   // torch_ipex::cpu::kernel::zero_ker(attn_out_ptr, attn_outs.numel());
   auto attn_w_ptr = attn_weights.data_ptr<float>();
-  long new_beam_idx[beam_batch][offset + query.size(1) + 1];
-  auto b_ptr = beam_idx.data_ptr<long>();
-  if (offset > 0) {
-    // according to the last decoded token to get the target beam for the past
-    // token
-    for (int i = 0; i < bs; i++) {
-      new_beam_idx[i][offset - 1] = b_ptr[(offset - 1) * bs + i];
-      for (int j = offset - 2; j >= 0;
-           j--) { // for the token of input, the target beam is alwarys 0
-        new_beam_idx[i][j] = b_ptr[j * bs + new_beam_idx[i][j + 1]];
-      }
-    }
-  }
+  auto new_beam_idx = reconstruct_beam_indices(beam_idx, bs, offset, cur_len);
+  auto beam_stride = offset + cur_len + 1;
   {
     RECORD_FUNCTION(
         "ipex::iakv_sdp::matmul(query, key)", c10::ArrayRef<c10::IValue>({}));
@@ -625,7 +741,7 @@ scale_dot_product_for_indirect_access_kv_cache(
                     nullptr);
               } else {
                 kc_t_beam_start = kc_t_beam_start +
-                    new_beam_idx[bi][ti] * kv_head * head_size;
+                    new_beam_idx[bi * beam_stride + ti] * kv_head * head_size;
                 if (cur_len > 1) {
                   auto beam_size = beam_batch / bs;
                   kc_t_beam_start =
@@ -779,7 +895,8 @@ scale_dot_product_for_indirect_access_kv_cache(
                     flag_access[thread_id][bi][hi]);
               } else {
                 auto vc_t_beam_start =
-                    vc_token_start + new_beam_idx[bi][vi] * kv_head * head_size;
+                    vc_token_start +
+                    new_beam_idx[bi * beam_stride + vi] * kv_head * head_size;
                 if (cur_len > 1) {
                   auto beam_size = beam_batch / bs;
                   vc_t_beam_start =
@@ -885,19 +1002,8 @@ scale_dot_product_for_indirect_access_kv_cache_half(
   auto attn_out_ptr = attn_outs.data_ptr<at::Half>();
   // torch_ipex::cpu::kernel::zero_ker(attn_out_ptr, attn_outs.numel());
   auto attn_w_ptr = attn_weights.data_ptr<at::Half>();
-  long new_beam_idx[beam_batch][offset + query.size(1) + 1];
-  auto b_ptr = beam_idx.data_ptr<long>();
-  if (offset > 0) {
-    // according to the last decoded token to get the target beam for the past
-    // token
-    for (int i = 0; i < bs; i++) {
-      new_beam_idx[i][offset - 1] = b_ptr[(offset - 1) * bs + i];
-      for (int j = offset - 2; j >= 0;
-           j--) { // for the token of input, the target beam is alwarys 0
-        new_beam_idx[i][j] = b_ptr[j * bs + new_beam_idx[i][j + 1]];
-      }
-    }
-  }
+  auto new_beam_idx = reconstruct_beam_indices(beam_idx, bs, offset, cur_len);
+  auto beam_stride = offset + cur_len + 1;
   {
     RECORD_FUNCTION(
         "ipex::iakv_sdp::matmul(query, key)", c10::ArrayRef<c10::IValue>({}));
@@ -957,7 +1063,7 @@ scale_dot_product_for_indirect_access_kv_cache_half(
                     nullptr);
               } else {
                 kc_t_beam_start = kc_t_beam_start +
-                    new_beam_idx[bi][ti] * kv_head * head_size;
+                    new_beam_idx[bi * beam_stride + ti] * kv_head * head_size;
                 if (cur_len > 1) {
                   auto beam_size = beam_batch / bs;
                   kc_t_beam_start =
@@ -1085,7 +1191,8 @@ scale_dot_product_for_indirect_access_kv_cache_half(
                     flag_access[thread_id][bi][hi]);
               } else {
                 auto vc_t_beam_start =
-                    vc_token_start + new_beam_idx[bi][vi] * kv_head * head_size;
+                    vc_token_start +
+                    new_beam_idx[bi * beam_stride + vi] * kv_head * head_size;
                 if (cur_len > 1) {
                   auto beam_size = beam_batch / bs;
                   vc_t_beam_start =
@@ -1356,6 +1463,7 @@ masked_multihead_self_attention_kernel_impl(
     const c10::optional<at::Tensor>& head_mask /* optional */,
     const c10::optional<at::Tensor>& attention_mask /* optional */,
     c10::optional<bool> add_casual_mask /* optional */) {
+  IPEX_HOT_TRACE_SCOPE("aten::masked_multihead_self_attention_kernel");
   TORCH_CHECK(
       attention_mask.has_value(),
       "Attention mask is necessary for ipex::masked_multihead_self_attention_kernel_impl");
@@ -1448,11 +1556,154 @@ masked_multihead_self_attention_kernel_impl(
         add_casual_mask.value_or(true));
   }
 }
+// Rotate one head row in place (GPT-NeoX pairing: element i with element
+// i + rotary_ndims / 2), with the row held in registers between the load
+// and the store.
+template <typename T>
+inline void apply_rotary_embedding_inplace(
+    T* head_start,
+    const float* cos_start,
+    const float* sin_start,
+    int64_t rotary_ndims) {
+  auto half_dim = rotary_ndims / 2;
+  auto di = 0;
+#if defined(CPU_CAPABILITY_AVX512)
+  if (std::is_same<T, float>::value) {
+    auto x_ptr = (float*)head_start;
+    auto vec_size = 16; // 512/32
+    for (; di <= half_dim - vec_size; di += vec_size) {
+      auto x1 = _mm512_loadu_ps(x_ptr + di);
+      auto x2 = _mm512_loadu_ps(x_ptr + di + half_dim);
+      auto cos_vec = _mm512_loadu_ps(cos_start + di);
+      auto sin_vec = _mm512_loadu_ps(sin_start + di);
+      auto out1 = _mm512_sub_ps(
+          _mm512_mul_ps(x1, cos_vec), _mm512_mul_ps(x2, sin_vec));
+      auto out2 = _mm512_add_ps(
+          _mm512_mul_ps(x2, cos_vec), _mm512_mul_ps(x1, sin_vec));
+      _mm512_storeu_ps(x_ptr + di, out1);
+      _mm512_storeu_ps(x_ptr + di + half_dim, out2);
+    }
+  }
+#endif
+  for (; di < half_dim; di++) {
+    auto x1 = (float)head_start[di];
+    auto x2 = (float)head_start[di + half_dim];
+    head_start[di] = x1 * cos_start[di] - x2 * sin_start[di];
+    head_start[di + half_dim] = x2 * cos_start[di] + x1 * sin_start[di];
+  }
+}
+
+template <typename T>
+void rotate_query_key_inplace(
+    at::Tensor& query, // [bs, cur_len, head_num, head_size]
+    at::Tensor& key, // [bs, cur_len, kv_head_num, head_size]
+    at::Tensor& rotary_cos, // [max_positions, rotary_ndims / 2]
+    at::Tensor& rotary_sin, // [max_positions, rotary_ndims / 2]
+    int64_t offset,
+    int64_t rotary_ndims) {
+  auto bs = query.size(0);
+  auto cur_len = query.size(1);
+  auto head_num = query.size(2);
+  auto kv_head_num = key.size(2);
+  auto head_size = query.size(3);
+  auto query_ptr = query.data_ptr<T>();
+  auto key_ptr = key.data_ptr<T>();
+  auto cos_ptr = rotary_cos.data_ptr<float>();
+  auto sin_ptr = rotary_sin.data_ptr<float>();
+  auto half_dim = rotary_ndims / 2;
+  auto q_stride = query.stride(0);
+  auto k_stride = key.stride(0);
+#pragma omp parallel for collapse(2)
+  for (auto bi = 0; bi < bs; bi++) {
+    for (auto si = 0; si < cur_len; si++) {
+      auto cos_start = cos_ptr + (offset + si) * half_dim;
+      auto sin_start = sin_ptr + (offset + si) * half_dim;
+      for (auto hi = 0; hi < head_num; hi++) {
+        auto q_start = query_ptr + bi * q_stride +
+            (si * head_num + hi) * head_size;
+        apply_rotary_embedding_inplace<T>(
+            q_start, cos_start, sin_start, rotary_ndims);
+      }
+      for (auto hi = 0; hi < kv_head_num; hi++) {
+        auto k_start =
+            key_ptr + bi * k_stride + (si * kv_head_num + hi) * head_size;
+        apply_rotary_embedding_inplace<T>(
+            k_start, cos_start, sin_start, rotary_ndims);
+      }
+    }
+  }
+}
+
+/**
+ * Fused rotary + masked MHA: the rotary embedding is applied to the fresh
+ * Q/K rows inside this kernel (in place, rows held in registers between
+ * load and store) right before they are consumed and cached, instead of a
+ * separate RotaryPositionEmbedding pass that re-reads and re-writes the
+ * whole hidden state from DRAM.
+ */
+std::tuple<at::Tensor, at::Tensor, at::Tensor, at::Tensor, at::Tensor>
+masked_multihead_self_attention_fused_rope_kernel_impl(
+    at::Tensor& query,
+    at::Tensor& key,
+    at::Tensor& value,
+    at::Tensor& key_cache,
+    at::Tensor& value_cache,
+    at::Tensor& beam_idx,
+    at::Tensor seq_info,
+    const double scale_attn,
+    int64_t max_positions,
+    const c10::optional<at::Tensor>& head_mask /* optional */,
+    const c10::optional<at::Tensor>& attention_mask /* optional */,
+    c10::optional<bool> add_casual_mask /* optional */,
+    at::Tensor& rotary_cos, // [max_positions, rotary_ndims / 2]
+    at::Tensor& rotary_sin, // [max_positions, rotary_ndims / 2]
+    int64_t rotary_ndims) {
+  RECORD_FUNCTION(
+      "ipex::masked_multihead_self_attention_fused_rope_kernel_impl",
+      c10::ArrayRef<c10::IValue>({}));
+  TORCH_CHECK(
+      rotary_ndims % 2 == 0 && rotary_ndims <= query.size(3),
+      "rotary_ndims must be even and not exceed head_size");
+  query = query.contiguous();
+  key = key.contiguous();
+  auto offset = seq_info.data_ptr<long>()[0];
+  if (query.scalar_type() == at::kFloat) {
+    rotate_query_key_inplace<float>(
+        query, key, rotary_cos, rotary_sin, offset, rotary_ndims);
+  } else if (query.scalar_type() == at::kBFloat16) {
+    rotate_query_key_inplace<at::BFloat16>(
+        query, key, rotary_cos, rotary_sin, offset, rotary_ndims);
+  } else if (query.scalar_type() == at::kHalf) {
+    rotate_query_key_inplace<at::Half>(
+        query, key, rotary_cos, rotary_sin, offset, rotary_ndims);
+  } else {
+    TORCH_CHECK(
+        false,
+        "Unsupported data type for ipex::masked_multihead_self_attention_fused_rope");
+  }
+  return masked_multihead_self_attention_kernel_impl(
+      query,
+      key,
+      value,
+      key_cache,
+      value_cache,
+      beam_idx,
+      seq_info,
+      scale_attn,
+      max_positions,
+      head_mask,
+      attention_mask,
+      add_casual_mask);
+}
+
 } // anonymous namespace
 
 IPEX_REGISTER_DISPATCH(
     masked_multihead_self_attention_kernel_stub,
     &masked_multihead_self_attention_kernel_impl);
+IPEX_REGISTER_DISPATCH(
+    masked_multihead_self_attention_fused_rope_kernel_stub,
+    &masked_multihead_self_attention_fused_rope_kernel_impl);
 
 } // namespace cpu
 } // namespace torch_ipex
@@ -2,6 +2,7 @@
 #include <aten/MergedEmbeddingBag.h>
 #include <c10/core/CPUAllocator.h>
 #include <omp.h>
+#include <algorithm>
 #include "vec/merged_emb_utils.hpp"
 #include "vec/unroll_helper.hpp"
 #include "vec/vec.h"
@@ -14,6 +15,140 @@ namespace {
 using namespace at;
 using namespace torch_ipex::cpu::kernel;
 
+// With IPEX_EMB_BWD_BINNED=1 the gradient scatter first radix-partitions
+// the lookup positions of each table by row-range owner, so each thread
+// accumulates a disjoint row range from its own contiguous segment. The
+// default mod-hash mode instead has every thread scan the full index
+// stream and keep only wid % numthd == thdidx, i.e. O(threads * lookups)
+// index traffic.
+inline bool emb_bwd_binned_enabled() {
+  static int enabled = []() {
+    auto* env = getenv("IPEX_EMB_BWD_BINNED");
+    return env != nullptr ? atoi(env) : 0;
+  }();
+  return enabled != 0;
+}
+
+// Counting-sort the positions [0, num_indices) of one table's index
+// stream into num_bins buckets keyed by indices[j] / rows_per_bin.
+// Per-chunk histograms are taken in parallel, turned into write cursors
+// with prefix_sum, then positions are scattered in parallel; the sort is
+// stable so positions inside a bin stay in bag order.
+template <typename index_t>
+void bin_indices_by_owner(
+    const index_t* indices,
+    const int64_t num_indices,
+    const int64_t num_bins,
+    const int64_t rows_per_bin,
+    int64_t* sorted_pos,
+    int64_t* bin_offsets /* num_bins + 1 */) {
+  const int64_t num_thd = omp_get_max_threads();
+  const int64_t chunk = (num_indices + num_thd - 1) / num_thd;
+  std::vector<int64_t> counts(num_thd * num_bins, 0);
+#pragma omp parallel
+  {
+    const int64_t tid = omp_get_thread_num();
+    const int64_t cs = std::min(tid * chunk, num_indices);
+    const int64_t ce = std::min(cs + chunk, num_indices);
+    int64_t* cnt = &counts[tid * num_bins];
+    for (int64_t j = cs; j < ce; ++j) {
+      cnt[indices[j] / rows_per_bin] += 1;
+    }
+  }
+  std::vector<int64_t> bin_totals(num_bins, 0);
+  for (int64_t c = 0; c < num_thd; ++c) {
+    for (int64_t b = 0; b < num_bins; ++b) {
+      bin_totals[b] += counts[c * num_bins + b];
+    }
+  }
+  bin_offsets[0] = 0;
+  prefix_sum(bin_totals.data(), &bin_offsets[1], (int64_t)0, num_bins);
+  // write cursor for (chunk c, bin b): bin start plus what earlier chunks
+  // scatter into the same bin
+  std::vector<int64_t> cursors(num_thd * num_bins);
+  for (int64_t b = 0; b < num_bins; ++b) {
+    int64_t run = bin_offsets[b];
+    for (int64_t c = 0; c < num_thd; ++c) {
+      cursors[c * num_bins + b] = run;
+      run += counts[c * num_bins + b];
+    }
+  }
+#pragma omp parallel
+  {
+    const int64_t tid = omp_get_thread_num();
+    const int64_t cs = std::min(tid * chunk, num_indices);
+    const int64_t ce = std::min(cs + chunk, num_indices);
+    int64_t* cur = &cursors[tid * num_bins];
+    for (int64_t j = cs; j < ce; ++j) {
+      sorted_pos[cur[indices[j] / rows_per_bin]++] = j;
+    }
+  }
+}
+
+// Map each lookup position to its bag so the binned kernel can recover
+// the grad row and the MEAN scale after the positions are permuted.
+template <typename index_t>
+void fill_pos2bag(
+    const index_t* offsets,
+    const int64_t num_batch,
+    const int64_t last_offset,
+    int64_t* pos2bag) {
+#pragma omp parallel for
+  for (int64_t b = 0; b < num_batch; ++b) {
+    const int64_t start_idx = offsets[b];
+    const int64_t end_idx = (b + 1) == num_batch ? last_offset : offsets[b + 1];
+    for (int64_t j = start_idx; j < end_idx; ++j) {
+      pos2bag[j] = b;
+    }
+  }
+}
+
+// Accumulate one thread's segment of the binned positions. The segment
+// only touches rows this thread owns, so no mod-hash filter and no
+// atomics are needed.
+template <typename data_t, typename index_t, typename acc_t, bool use_cache>
+void embeddingbag_bwd_binned_acc_kern(
+    const int64_t seg_begin,
+    const int64_t seg_end,
+    const int64_t num_batch,
+    const int64_t emb_dim,
+    const int64_t last_offset,
+    const index_t* indices,
+    const index_t* offsets,
+    const int64_t* sorted_pos,
+    const int64_t* pos2bag,
+    const data_t* grad,
+    data_t* result,
+    const int64_t pooling_mode,
+    EmbeddingRowCache<acc_t>& ewc) {
+  for (int64_t k = seg_begin; k < seg_end; ++k) {
+    const int64_t j = sorted_pos[k];
+    const int64_t wid = indices[j];
+    const int64_t b = pos2bag[j];
+    const int64_t start_idx = offsets[b];
+    const int64_t end_idx = (b + 1) == num_batch ? last_offset : offsets[b + 1];
+    acc_t* acc = nullptr;
+    if (use_cache) {
+      acc = ewc.find(wid);
+      if (acc == nullptr) {
+        acc = ewc.emplace(wid, emb_dim);
+      }
+    } else {
+      acc = reinterpret_cast<acc_t*>(&result[wid * emb_dim]);
+    }
+    const data_t* g = &grad[b * emb_dim];
+    if (pooling_mode == MEAN && (end_idx - start_idx) > 1) {
+      const acc_t scale = acc_t(1.0) / (end_idx - start_idx);
+#pragma omp simd
+      for (int64_t i = 0; i < emb_dim; ++i) {
+        acc[i] += acc_t(g[i]) * scale;
+      }
+    } else {
+      add_ker<acc_t, data_t>(acc, g, emb_dim);
+    }
+  }
+}
+
 template <typename data_t, typename acc_t>
 typename std::enable_if<
     std::is_same<data_t, Half>::value || std::is_same<data_t, BFloat16>::value,
@@ -246,9 +381,56 @@ merged_embeddingbag_dense_backward(
     int64_t num_emb,
     int64_t emb_dim,
     std::vector<int64_t> last_offsets,
+    std::vector<int64_t> num_rows,
     int64_t pooling_mode) {
   using acc_t = acc_type<data_t, true>; // if use_cuda = False, float's acc type
                                         // will be double
+  if (emb_bwd_binned_enabled()) {
+    const int64_t num_bins = omp_get_max_threads();
+    for (int32_t n = 0; n < num_emb; ++n) {
+      const int64_t num_indices = last_offsets[n];
+      const int64_t rows_per_bin = (num_rows[n] + num_bins - 1) / num_bins;
+      std::vector<int64_t> pos2bag(num_indices);
+      std::vector<int64_t> sorted_pos(num_indices);
+      std::vector<int64_t> bin_offsets(num_bins + 1);
+      fill_pos2bag(
+          offsets_ptr[n], num_batch, last_offsets[n], pos2bag.data());
+      bin_indices_by_owner(
+          indices_ptr[n],
+          num_indices,
+          num_bins,
+          rows_per_bin,
+          sorted_pos.data(),
+          bin_offsets.data());
+#pragma omp parallel
+      {
+        const int64_t tid = omp_get_thread_num();
+        if (tid < num_bins) {
+          EmbeddingRowCache<acc_t> ewc;
+          embeddingbag_bwd_binned_acc_kern<
+              data_t,
+              index_t,
+              acc_t,
+              /*use_cache=*/true>(
+              bin_offsets[tid],
+              bin_offsets[tid + 1],
+              num_batch,
+              emb_dim,
+              last_offsets[n],
+              indices_ptr[n],
+              offsets_ptr[n],
+              sorted_pos.data(),
+              pos2bag.data(),
+              grads_ptr[n],
+              o_ptr[n],
+              pooling_mode,
+              ewc);
+          copy_from_grad_cache(o_ptr[n], ewc, emb_dim);
+        }
+      }
+    }
+    return;
+  }
 #pragma omp parallel
   {
     for (int32_t n = 0; n < num_emb; ++n) {
@@ -283,9 +465,54 @@ merged_embeddingbag_dense_backward(
     int64_t num_emb,
     int64_t emb_dim,
     std::vector<int64_t> last_offsets,
+    std::vector<int64_t> num_rows,
     int64_t pooling_mode) {
   // For float/double, do not need ewc to accumulate grad
   EmbeddingRowCache<data_t> dummy_ewc;
+  if (emb_bwd_binned_enabled()) {
+    const int64_t num_bins = omp_get_max_threads();
+    for (int32_t n = 0; n < num_emb; ++n) {
+      const int64_t num_indices = last_offsets[n];
+      const int64_t rows_per_bin = (num_rows[n] + num_bins - 1) / num_bins;
+      std::vector<int64_t> pos2bag(num_indices);
+      std::vector<int64_t> sorted_pos(num_indices);
+      std::vector<int64_t> bin_offsets(num_bins + 1);
+      fill_pos2bag(
+          offsets_ptr[n], num_batch, last_offsets[n], pos2bag.data());
+      bin_indices_by_owner(
+          indices_ptr[n],
+          num_indices,
+          num_bins,
+          rows_per_bin,
+          sorted_pos.data(),
+          bin_offsets.data());
+#pragma omp parallel
+      {
+        const int64_t tid = omp_get_thread_num();
+        if (tid < num_bins) {
+          embeddingbag_bwd_binned_acc_kern<
+              data_t,
+              index_t,
+              data_t,
+              /*use_cache=*/false>(
+              bin_offsets[tid],
+              bin_offsets[tid + 1],
+              num_batch,
+              emb_dim,
+              last_offsets[n],
+              indices_ptr[n],
+              offsets_ptr[n],
+              sorted_pos.data(),
+              pos2bag.data(),
+              grads_ptr[n],
+              o_ptr[n],
+              pooling_mode,
+              dummy_ewc);
+        }
+      }
+    }
+    return;
+  }
 #pragma omp parallel
   {
     for (int32_t n = 0; n < num_emb; ++n) {
@@ -326,6 +553,7 @@ std::vector<Tensor> merged_embeddingbag_backward_cpu_kernel_impl(
   auto data_type = weights[0].scalar_type();
 
   std::vector<int64_t> last_offsets(num_emb, -1);
+  std::vector<int64_t> num_rows(num_emb, 0);
   std::vector<Tensor> contiguous_grad;
   std::vector<Tensor> outputs;
 
@@ -340,6 +568,7 @@ std::vector<Tensor> merged_embeddingbag_backward_cpu_kernel_impl(
         contiguous_grad[i].scalar_type() == data_type);
     // handle last offsets
     last_offsets[i] = indices[i].numel();
+    num_rows[i] = weights[i].size(0);
     outputs.emplace_back(zeros_like(weights[i], weights[i].options()));
   }
 
@@ -372,6 +601,7 @@ std::vector<Tensor> merged_embeddingbag_backward_cpu_kernel_impl(
                   num_emb,
                   emb_dim,
                   last_offsets,
+                  num_rows,
                   pooling_mode);
             });
       });
@@ -620,11 +850,60 @@ void merged_embeddingbag_backward_update(
     int64_t num_emb,
     int64_t emb_dim,
     std::vector<int64_t> last_offsets,
+    std::vector<int64_t> num_rows,
     int64_t pooling_mode,
     optimizer_arg_t& args) {
   using acc_t =
       acc_type<data_t, /*use_cuda=*/true>; // if use_cuda = False, float's acc
                                            // type will be double
+  if (emb_bwd_binned_enabled()) {
+    const int64_t num_bins = omp_get_max_threads();
+    for (int32_t n = 0; n < num_emb; ++n) {
+      const int64_t num_indices = last_offsets[n];
+      const int64_t rows_per_bin = (num_rows[n] + num_bins - 1) / num_bins;
+      std::vector<int64_t> pos2bag(num_indices);
+      std::vector<int64_t> sorted_pos(num_indices);
+      std::vector<int64_t> bin_offsets(num_bins + 1);
+      fill_pos2bag(
+          offsets_ptr[n], num_batch, last_offsets[n], pos2bag.data());
+      bin_indices_by_owner(
+          indices_ptr[n],
+          num_indices,
+          num_bins,
+          rows_per_bin,
+          sorted_pos.data(),
+          bin_offsets.data());
+#pragma omp parallel
+      {
+        const int64_t tid = omp_get_thread_num();
+        if (tid < num_bins) {
+          EmbeddingRowCache<acc_t> ewc;
+          embeddingbag_bwd_binned_acc_kern<
+              data_t,
+              index_t,
+              acc_t,
+              /*use_cache=*/true>(
+              bin_offsets[tid],
+              bin_offsets[tid + 1],
+              num_batch,
+              emb_dim,
+              last_offsets[n],
+              indices_ptr[n],
+              offsets_ptr[n],
+              sorted_pos.data(),
+              pos2bag.data(),
+              grads_ptr[n],
+              /*result=*/nullptr,
+              pooling_mode,
+              ewc);
+          // each thread owns disjoint rows, so updates stay conflict free
+          EmbeddingGradUpdate<data_t, acc_t, optimizer_arg_t>::update(
+              w_ptr[n], ewc, args, n, emb_dim);
+        }
+      }
+    }
+    return;
+  }
 #pragma omp parallel
   {
     for (int32_t n = 0; n < num_emb; ++n) {
@@ -671,6 +950,7 @@ void merged_embeddingbag_backward_sgd_cpu_kernel_impl(
   auto data_type = weights[0].scalar_type();
 
   std::vector<int64_t> last_offsets(num_emb, -1);
+  std::vector<int64_t> num_rows(num_emb, 0);
   std::vector<Tensor> contiguous_grad;
   std::vector<Tensor> outputs;
 
@@ -685,6 +965,7 @@ void merged_embeddingbag_backward_sgd_cpu_kernel_impl(
         contiguous_grad[i].scalar_type() == data_type);
     // handle last offsets
     last_offsets[i] = indices[i].numel();
+    num_rows[i] = weights[i].size(0);
   }
 
   AT_DISPATCH_FLOATING_TYPES_AND(
@@ -716,6 +997,7 @@ void merged_embeddingbag_backward_sgd_cpu_kernel_impl(
                   num_emb,
                   emb_dim,
                   last_offsets,
+                  num_rows,
                   pooling_mode,
                   args);
             });
@@ -747,6 +1029,7 @@ void merged_embeddingbag_backward_adagrad_cpu_kernel_impl(
   auto data_type = weights[0].scalar_type();
 
   std::vector<int64_t> last_offsets(num_emb, -1);
+  std::vector<int64_t> num_rows(num_emb, 0);
   std::vector<Tensor> contiguous_grad;
   std::vector<Tensor> outputs;
 
@@ -761,6 +1044,7 @@ void merged_embeddingbag_backward_adagrad_cpu_kernel_impl(
         contiguous_grad[i].scalar_type() == data_type);
     // handle last offsets
     last_offsets[i] = indices[i].numel();
+    num_rows[i] = weights[i].size(0);
   }
 
   AT_DISPATCH_FLOATING_TYPES_AND(
@@ -795,6 +1079,7 @@ void merged_embeddingbag_backward_adagrad_cpu_kernel_impl(
                   num_emb,
                   emb_dim,
                   last_offsets,
+                  num_rows,
                   pooling_mode,
                   args);
             });
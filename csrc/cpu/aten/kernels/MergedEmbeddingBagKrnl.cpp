@@ -5,6 +5,9 @@
 #include <aten/MergedEmbCat.h>
 #include <aten/MergedEmbeddingBag.h>
 #include <torch/all.h>
+#include <algorithm>
+#include <functional>
+#include <mutex>
 #include "autocast/autocast_mode.h"
 #include "vec/merged_emb_utils.hpp"
 #include "vec/unroll_helper.hpp"
@@ -18,6 +21,114 @@ namespace {
 using namespace at;
 using namespace torch_ipex::cpu::kernel;
 
+// Software-managed cache for hot embedding rows. Recsys lookups follow a
+// steep zipf distribution: a small fraction of rows serves most lookups,
+// yet every row is streamed from its home location in the (huge) table.
+// Pinning the hottest rows in a compact contiguous region lets repeated
+// lookups hit L2/L3 instead of burning DRAM bandwidth on scattered reads.
+// Opt-in via IPEX_EMB_HOT_ROW_CACHE (total budget in MB across all tables,
+// typically sized to the L3 slice available to the embedding pass).
+// Row frequencies are sampled on each forward call and the hottest rows
+// are (re-)promoted every kEmbHotPromoteInterval calls with decayed
+// counts, so the cache follows shifts in the distribution. Cached copies
+// are only refreshed at promotion time, so the cache is intended for
+// frozen (inference) weights.
+struct EmbHotRowCache {
+  robin_hood::unordered_flat_map<int64_t, int64_t> slots; // row -> slot
+  robin_hood::unordered_map<int64_t, uint64_t> freq; // sampled lookup counts
+  std::vector<char> rows; // capacity * row_bytes, contiguous
+  int64_t row_bytes = 0;
+  int64_t capacity = 0;
+  int64_t calls = 0;
+};
+
+constexpr int64_t kEmbHotSampleStride = 7;
+constexpr int64_t kEmbHotPromoteInterval = 64;
+
+inline int64_t emb_hot_row_cache_mb() {
+  static int64_t mb = []() {
+    auto* env = getenv("IPEX_EMB_HOT_ROW_CACHE");
+    return env != nullptr ? atol(env) : 0;
+  }();
+  return mb;
+}
+
+template <typename data_t>
+inline const data_t* hot_row(
+    const EmbHotRowCache* hot,
+    const data_t* weight,
+    int64_t row,
+    int64_t emb_dim) {
+  if (hot != nullptr) {
+    auto it = hot->slots.find(row);
+    if (it != hot->slots.end()) {
+      return reinterpret_cast<const data_t*>(hot->rows.data()) +
+          it->second * emb_dim;
+    }
+  }
+  return &weight[row * emb_dim];
+}
+
+// Sample this call's indices into the per-table frequency map and, every
+// kEmbHotPromoteInterval calls, rebuild the compact region from the rows
+// with the highest decayed counts. Runs single threaded before the
+// parallel kernel launch; the returned cache is read-only inside it.
+template <typename data_t, typename index_t>
+const EmbHotRowCache* emb_hot_row_cache_update(
+    const data_t* weight,
+    const index_t* indices,
+    int64_t num_indices,
+    int64_t emb_dim,
+    int64_t budget_bytes) {
+  static std::mutex mtx;
+  static robin_hood::unordered_map<const void*, EmbHotRowCache*> registry;
+  std::lock_guard<std::mutex> lock(mtx);
+  EmbHotRowCache*& entry = registry[weight];
+  if (entry == nullptr) {
+    entry = new EmbHotRowCache();
+    entry->row_bytes = emb_dim * sizeof(data_t);
+    entry->capacity = budget_bytes / entry->row_bytes;
+  }
+  EmbHotRowCache* hot = entry;
+  if (hot->capacity == 0) {
+    return nullptr;
+  }
+  for (int64_t i = 0; i < num_indices; i += kEmbHotSampleStride) {
+    hot->freq[indices[i]] += 1;
+  }
+  if (++hot->calls % kEmbHotPromoteInterval != 0) {
+    return hot->slots.empty() ? nullptr : hot;
+  }
+  std::vector<std::pair<uint64_t, int64_t>> order;
+  order.reserve(hot->freq.size());
+  for (auto& [row, cnt] : hot->freq) {
+    // require a row to be sampled at least twice before it may be pinned
+    if (cnt > 1) {
+      order.emplace_back(cnt, row);
+    }
+    cnt >>= 1;
+  }
+  for (auto it = hot->freq.begin(); it != hot->freq.end();) {
+    it = (it->second == 0) ? hot->freq.erase(it) : std::next(it);
+  }
+  const int64_t n_hot =
+      std::min<int64_t>(hot->capacity, static_cast<int64_t>(order.size()));
+  std::partial_sort(
+      order.begin(),
+      order.begin() + n_hot,
+      order.end(),
+      std::greater<std::pair<uint64_t, int64_t>>());
+  hot->rows.resize(n_hot * hot->row_bytes);
+  hot->slots.clear();
+  auto* rows = reinterpret_cast<data_t*>(hot->rows.data());
+  for (int64_t s = 0; s < n_hot; ++s) {
+    const int64_t row = order[s].second;
+    memcpy(&rows[s * emb_dim], &weight[row * emb_dim], hot->row_bytes);
+    hot->slots.emplace(row, s);
+  }
+  return hot->slots.empty() ? nullptr : hot;
+}
+
 template <typename data_t>
 inline void copy_dense(
     const int64_t bs_bgein,
@@ -48,22 +159,33 @@ typename std::enable_if<
         const data_t* weight,
         data_t* result,
         int64_t result_stride,
-        int64_t pooling_mode) {
+        int64_t pooling_mode,
+        const EmbHotRowCache* hot) {
   using Vec = at::vec::Vectorized<data_t>;
   auto vec_size = Vec::size();
   for (int64_t b = bs_begin; b < bs_end; ++b) {
     int64_t start_idx = offsets[b];
     int64_t end_idx =
         ((b + 1) == bs_end && last_offset != -1) ? last_offset : offsets[b + 1];
+    // prefetch the next bag's rows while this bag accumulates
+    if (b + 1 < bs_end) {
+      int64_t nstart = offsets[b + 1];
+      int64_t nend = ((b + 2) == bs_end && last_offset != -1)
+          ? last_offset
+          : offsets[b + 2];
+      for (int64_t j = nstart; j < nend; ++j) {
+        prefetch_row_ker(&weight[indices[j] * emb_dim], emb_dim);
+      }
+    }
     // vec
     Vec w_vec;
     int64_t i = 0;
     for (; i + vec_size <= emb_dim; i += vec_size) {
-      int64_t idx = indices[start_idx] * emb_dim;
-      w_vec = Vec::loadu(&weight[idx + i]);
+      const data_t* w_row = hot_row(hot, weight, indices[start_idx], emb_dim);
+      w_vec = Vec::loadu(&w_row[i]);
       for (int64_t j = start_idx + 1; j < end_idx; ++j) {
-        idx = indices[j] * emb_dim;
-        Vec w_next_vec = Vec::loadu(&weight[idx + i]);
+        w_row = hot_row(hot, weight, indices[j], emb_dim);
+        Vec w_next_vec = Vec::loadu(&w_row[i]);
         w_vec += w_next_vec;
       }
       if (pooling_mode == MEAN) {
@@ -74,11 +196,11 @@ typename std::enable_if<
     // scalar tail
     data_t w;
     for (; i < emb_dim; i++) {
-      int64_t idx = indices[start_idx] * emb_dim;
-      w = weight[idx + i];
+      const data_t* w_row = hot_row(hot, weight, indices[start_idx], emb_dim);
+      w = w_row[i];
       for (int64_t j = start_idx + 1; j < end_idx; ++j) {
-        idx = indices[j] * emb_dim;
-        data_t w_next = weight[idx + i];
+        w_row = hot_row(hot, weight, indices[j], emb_dim);
+        data_t w_next = w_row[i];
         w += w_next;
       }
       if (pooling_mode == MEAN) {
@@ -105,7 +227,8 @@ typename std::enable_if<
         const data_t* weight,
         data_t* result,
         int64_t result_stride,
-        int64_t pooling_mode) {
+        int64_t pooling_mode,
+        const EmbHotRowCache* hot) {
   using lpVec = at::vec::Vectorized<data_t>;
   using fVec = at::vec::Vectorized<float>;
   auto vec_size = lpVec::size();
@@ -113,17 +236,27 @@ typename std::enable_if<
     int64_t start_idx = offsets[b];
     int64_t end_idx =
         ((b + 1) == bs_end && last_offset != -1) ? last_offset : offsets[b + 1];
+    // prefetch the next bag's rows while this bag accumulates
+    if (b + 1 < bs_end) {
+      int64_t nstart = offsets[b + 1];
+      int64_t nend = ((b + 2) == bs_end && last_offset != -1)
+          ? last_offset
+          : offsets[b + 2];
+      for (int64_t j = nstart; j < nend; ++j) {
+        prefetch_row_ker(&weight[indices[j] * emb_dim], emb_dim);
+      }
+    }
     // vec
     fVec f_w_vec1, f_w_vec2;
     int64_t i = 0;
     for (; i + vec_size <= emb_dim; i += vec_size) {
-      int64_t idx = indices[start_idx] * emb_dim;
-      lpVec lp_w_vec = lpVec::loadu(&weight[idx + i]);
+      const data_t* w_row = hot_row(hot, weight, indices[start_idx], emb_dim);
+      lpVec lp_w_vec = lpVec::loadu(&w_row[i]);
       std::tie(f_w_vec1, f_w_vec2) =
           at::vec::convert_to_float<data_t>(lp_w_vec);
       for (int64_t j = start_idx + 1; j < end_idx; ++j) {
-        idx = indices[j] * emb_dim;
-        lpVec lp_w_next_vec = lpVec::loadu(&weight[idx + i]);
+        w_row = hot_row(hot, weight, indices[j], emb_dim);
+        lpVec lp_w_next_vec = lpVec::loadu(&w_row[i]);
         fVec f_w_next_vec1, f_w_next_vec2;
         std::tie(f_w_next_vec1, f_w_next_vec2) =
             at::vec::convert_to_float<data_t>(lp_w_next_vec);
@@ -140,11 +273,11 @@ typename std::enable_if<
     // scalar tail
     float w;
     for (; i < emb_dim; i++) {
-      int64_t idx = indices[start_idx] * emb_dim;
-      w = float(weight[idx + i]);
+      const data_t* w_row = hot_row(hot, weight, indices[start_idx], emb_dim);
+      w = float(w_row[i]);
       for (int64_t j = start_idx + 1; j < end_idx; ++j) {
-        idx = indices[j] * emb_dim;
-        float w_next = float(weight[idx + i]);
+        w_row = hot_row(hot, weight, indices[j], emb_dim);
+        float w_next = float(w_row[i]);
         w += w_next;
       }
       if (pooling_mode == MEAN) {
@@ -169,7 +302,8 @@ typename std::enable_if<std::is_same<data_t, float>::value, void>::
         const data_t* weight,
         data_t* result,
         const int64_t result_stride,
-        const int64_t pooling_mode) {
+        const int64_t pooling_mode,
+        const EmbHotRowCache* hot = nullptr) {
 #if defined(CPU_CAPABILITY_AVX512)
   // FP32 avx512 fast path for emb_dim=128
   // ~7% improvement while benchmarking on SPR 56C/S with 1 S.
@@ -177,6 +311,7 @@ typename std::enable_if<std::is_same<data_t, float>::value, void>::
   // num_bags = [3,2,1,2,6,1,1,1,1,7,3,8,1,6,9,5,1,1,1,12,100,27,10,3,1,1] for
   // each table
   if (emb_dim == 128) {
+    const int64_t pf_end = (last_offset != -1) ? last_offset : offsets[bs_end];
     for (int64_t b = bs_begin; b < bs_end; ++b) {
       __m512 w0[8];
       __m512 wj[8];
@@ -185,13 +320,22 @@ typename std::enable_if<std::is_same<data_t, float>::value, void>::
           ? last_offset
           : offsets[b + 1];
       // load first indices
-      int64_t idx = indices[start_idx] * emb_dim;
-      compile_time_for<8>::op(load_fp32, w0, &weight[idx]);
+      const data_t* w_row = hot_row(hot, weight, indices[start_idx], emb_dim);
+      compile_time_for<8>::op(load_fp32, w0, w_row);
+      if (start_idx + kRowPrefetchDistance < pf_end) {
+        prefetch_row_ker(
+            &weight[indices[start_idx + kRowPrefetchDistance] * emb_dim],
+            emb_dim);
+      }
       for (int64_t j = start_idx + 1; j < end_idx; ++j) {
         // add following idx
-        idx = indices[j] * emb_dim;
-        compile_time_for<8>::op(load_fp32, wj, &weight[idx]);
+        w_row = hot_row(hot, weight, indices[j], emb_dim);
+        compile_time_for<8>::op(load_fp32, wj, w_row);
         compile_time_for<8>::op(add_fp32, w0, wj);
+        if (j + kRowPrefetchDistance < pf_end) {
+          prefetch_row_ker(
+              &weight[indices[j + kRowPrefetchDistance] * emb_dim], emb_dim);
+        }
       }
       if (pooling_mode == MEAN) {
         __m512 vec_l = _mm512_set1_ps(1.0 / (end_idx - start_idx));
@@ -215,7 +359,8 @@ typename std::enable_if<std::is_same<data_t, float>::value, void>::
       weight,
       result,
       result_stride,
-      pooling_mode);
+      pooling_mode,
+      hot);
 }
 
 template <typename data_t, typename index_t>
@@ -231,7 +376,8 @@ typename std::enable_if<std::is_same<data_t, Half>::value, void>::
         const data_t* weight,
         data_t* result,
         const int64_t result_stride,
-        const int64_t pooling_mode) {
+        const int64_t pooling_mode,
+        const EmbHotRowCache* hot = nullptr) {
 #if defined(CPU_CAPABILITY_AVX512)
   // FP16 avx512_fp16 fast path for emb_dim=128
   // only ~1.5% improvement while benchmarking on SPR 56C/S with 1 S.
@@ -239,6 +385,7 @@ typename std::enable_if<std::is_same<data_t, Half>::value, void>::
   // num_bags = [3,2,1,2,6,1,1,1,1,7,3,8,1,6,9,5,1,1,1,12,100,27,10,3,1,1] for
   // each table
   if (emb_dim == 128) {
+    const int64_t pf_end = (last_offset != -1) ? last_offset : offsets[bs_end];
     for (int64_t b = bs_begin; b < bs_end; ++b) {
       __m512i fp16_w0[4], fp16_wj[4];
       __m512 fp32_w0[8], fp32_wj[8];
@@ -247,15 +394,22 @@ typename std::enable_if<std::is_same<data_t, Half>::value, void>::
           ? last_offset
           : offsets[b + 1];
       // load first indices
-      int64_t idx = indices[start_idx] * emb_dim;
-      compile_time_for<4>::op(
-          load_fp16_cast_fp32, fp16_w0, fp32_w0, &weight[idx]);
+      const data_t* w_row = hot_row(hot, weight, indices[start_idx], emb_dim);
+      compile_time_for<4>::op(load_fp16_cast_fp32, fp16_w0, fp32_w0, w_row);
+      if (start_idx + kRowPrefetchDistance < pf_end) {
+        prefetch_row_ker(
+            &weight[indices[start_idx + kRowPrefetchDistance] * emb_dim],
+            emb_dim);
+      }
       for (int64_t j = start_idx + 1; j < end_idx; ++j) {
         // add following idx
-        idx = indices[j] * emb_dim;
-        compile_time_for<4>::op(
-            load_fp16_cast_fp32, fp16_wj, fp32_wj, &weight[idx]);
+        w_row = hot_row(hot, weight, indices[j], emb_dim);
+        compile_time_for<4>::op(load_fp16_cast_fp32, fp16_wj, fp32_wj, w_row);
         compile_time_for<8>::op(add_fp32, fp32_w0, fp32_wj);
+        if (j + kRowPrefetchDistance < pf_end) {
+          prefetch_row_ker(
+              &weight[indices[j + kRowPrefetchDistance] * emb_dim], emb_dim);
+        }
       }
       if (pooling_mode == MEAN) {
         __m512 vec_l = _mm512_set1_ps(1.0 / (end_idx - start_idx));
@@ -279,7 +433,8 @@ typename std::enable_if<std::is_same<data_t, Half>::value, void>::
       weight,
       result,
       result_stride,
-      pooling_mode);
+      pooling_mode,
+      hot);
 }
 
 template <typename data_t, typename index_t>
@@ -295,7 +450,8 @@ typename std::enable_if<std::is_same<data_t, BFloat16>::value, void>::
         const data_t* weight,
         data_t* result,
         const int64_t result_stride,
-        const int64_t pooling_mode) {
+        const int64_t pooling_mode,
+        const EmbHotRowCache* hot = nullptr) {
 #if defined(CPU_CAPABILITY_AVX512_BF16)
   // BF16 avx512_bf16 fast path for emb_dim=128
   // ~30% improvement while benchmarking on SPR 56C/S with 1 S.
@@ -303,6 +459,7 @@ typename std::enable_if<std::is_same<data_t, BFloat16>::value, void>::
   // num_bags = [3,2,1,2,6,1,1,1,1,7,3,8,1,6,9,5,1,1,1,12,100,27,10,3,1,1] for
   // each table
   if (emb_dim == 128) {
+    const int64_t pf_end = (last_offset != -1) ? last_offset : offsets[bs_end];
     for (int64_t b = bs_begin; b < bs_end; ++b) {
       __m512i bf16_w0[4], bf16_wj[4];
       __m512 fp32_w0[8], fp32_wj[8];
@@ -311,15 +468,22 @@ typename std::enable_if<std::is_same<data_t, BFloat16>::value, void>::
           ? last_offset
           : offsets[b + 1];
       // load first indices
-      int64_t idx = indices[start_idx] * emb_dim;
-      compile_time_for<4>::op(
-          load_bf16_cast_fp32, bf16_w0, fp32_w0, &weight[idx]);
+      const data_t* w_row = hot_row(hot, weight, indices[start_idx], emb_dim);
+      compile_time_for<4>::op(load_bf16_cast_fp32, bf16_w0, fp32_w0, w_row);
+      if (start_idx + kRowPrefetchDistance < pf_end) {
+        prefetch_row_ker(
+            &weight[indices[start_idx + kRowPrefetchDistance] * emb_dim],
+            emb_dim);
+      }
       for (int64_t j = start_idx + 1; j < end_idx; ++j) {
         // add following idx
-        idx = indices[j] * emb_dim;
-        compile_time_for<4>::op(
-            load_bf16_cast_fp32, bf16_wj, fp32_wj, &weight[idx]);
+        w_row = hot_row(hot, weight, indices[j], emb_dim);
+        compile_time_for<4>::op(load_bf16_cast_fp32, bf16_wj, fp32_wj, w_row);
         compile_time_for<8>::op(add_fp32, fp32_w0, fp32_wj);
+        if (j + kRowPrefetchDistance < pf_end) {
+          prefetch_row_ker(
+              &weight[indices[j + kRowPrefetchDistance] * emb_dim], emb_dim);
+        }
       }
       if (pooling_mode == MEAN) {
         __m512 vec_l = _mm512_set1_ps(1.0 / (end_idx - start_idx));
@@ -343,7 +507,8 @@ typename std::enable_if<std::is_same<data_t, BFloat16>::value, void>::
       weight,
       result,
       result_stride,
-      pooling_mode);
+      pooling_mode,
+      hot);
 }
 
 template <typename data_t, typename index_t>
@@ -359,7 +524,8 @@ typename std::enable_if<std::is_same<data_t, double>::value, void>::
         const data_t* weight,
         data_t* result,
         const int64_t result_stride,
-        const int64_t pooling_mode) {
+        const int64_t pooling_mode,
+        const EmbHotRowCache* hot = nullptr) {
   embeddingbag_kern_general(
       bs_begin,
       bs_end,
@@ -371,7 +537,8 @@ typename std::enable_if<std::is_same<data_t, double>::value, void>::
       weight,
       result,
       result_stride,
-      pooling_mode);
+      pooling_mode,
+      hot);
 }
 
 template <typename data_t, typename index_t>
@@ -384,7 +551,8 @@ void merged_embeddingbag_cat(
     int64_t num_batch,
     int64_t num_emb,
     int64_t emb_dim,
-    std::vector<int64_t> last_offsets) {
+    std::vector<int64_t> last_offsets,
+    const EmbHotRowCache* const* hot_ptr) {
   constexpr int64_t b_block = 128;
   const int64_t n_b_blocks = (num_batch - 1) / b_block + 1;
 #pragma omp parallel for collapse(2)
@@ -416,7 +584,8 @@ void merged_embeddingbag_cat(
             w_ptr[m],
             r,
             /*result_stride=*/(num_emb + 1) * emb_dim,
-            SUM);
+            SUM,
+            hot_ptr[m]);
       }
     }
   }
@@ -469,10 +638,21 @@ Tensor merged_embedding_cat_fw_impl(
               scalar_t* weights_ptr[num_emb];
               index_t* indices_ptr[num_emb];
               index_t* offsets_ptr[num_emb];
+              const EmbHotRowCache* hot_ptr[num_emb];
+              const int64_t hot_budget =
+                  emb_hot_row_cache_mb() * 1024 * 1024 / num_emb;
               for (int i = 0; i < num_emb; i++) {
                 weights_ptr[i] = weights[i].data_ptr<scalar_t>();
                 indices_ptr[i] = indices[i].data_ptr<index_t>();
                 offsets_ptr[i] = offsets[i].data_ptr<index_t>();
+                hot_ptr[i] = hot_budget == 0
+                    ? nullptr
+                    : emb_hot_row_cache_update<scalar_t, index_t>(
+                          weights_ptr[i],
+                          indices_ptr[i],
+                          indices[i].numel(),
+                          emb_dim,
+                          hot_budget);
               }
               scalar_t* output_ptr = output.data_ptr<scalar_t>();
               merged_embeddingbag_cat<scalar_t, index_t>(
@@ -484,7 +664,177 @@ Tensor merged_embedding_cat_fw_impl(
                   batch_size,
                   num_emb,
                   emb_dim,
-                  last_offsets);
+                  last_offsets,
+                  hot_ptr);
+            });
+      });
+  return output;
+}
+
+template <typename data_t>
+inline data_t pairwise_dot(const data_t* v1, const data_t* v2, int64_t len) {
+  using acc_t = std::
+      conditional_t<std::is_same<data_t, double>::value, double, float>;
+  acc_t acc = 0;
+#pragma omp simd
+  for (int64_t k = 0; k < len; k++) {
+    acc += acc_t(v1[k]) * acc_t(v2[k]);
+  }
+  return data_t(acc);
+}
+
+// Fused producer-consumer of merged_embeddingbag_cat + interaction: the
+// concatenated [dense | bags] features are staged per batch block in a
+// cache-resident scratch and the pairwise dot products are computed
+// straight out of it, so the batch-sized [num_batch, (num_emb + 1) *
+// emb_dim] intermediate of the separate cat pass is never allocated.
+template <typename data_t, typename index_t>
+void merged_embeddingbag_interaction(
+    data_t* o_ptr,
+    data_t** w_ptr,
+    index_t** indices_ptr,
+    index_t** offsets_ptr,
+    data_t* d_ptr,
+    int64_t num_batch,
+    int64_t num_emb,
+    int64_t emb_dim,
+    std::vector<int64_t> last_offsets,
+    const EmbHotRowCache* const* hot_ptr) {
+  const int64_t feature_nums = num_emb + 1;
+  const int64_t cat_line = feature_nums * emb_dim;
+  const int64_t interact_feature_size = feature_nums * (feature_nums - 1) / 2;
+  const int64_t out_line = emb_dim + interact_feature_size;
+  constexpr int64_t b_block = 32;
+  const int64_t n_b_blocks = (num_batch - 1) / b_block + 1;
+#pragma omp parallel
+  {
+    std::vector<data_t> scratch(b_block * cat_line);
+    data_t* cat_buf = scratch.data();
+#pragma omp for
+    for (int64_t b = 0; b < n_b_blocks; ++b) {
+      const int64_t bs_begin = b * b_block;
+      const int64_t bs_end = std::min(num_batch, (b + 1) * b_block);
+      // produce: same fill as merged_embeddingbag_cat, into the scratch
+      copy_dense(
+          bs_begin,
+          bs_end,
+          num_emb,
+          emb_dim,
+          &d_ptr[bs_begin * emb_dim],
+          cat_buf);
+      for (int64_t m = 0; m < num_emb; ++m) {
+        // avoid offsets not include last batch
+        const index_t last_offset = bs_end == num_batch ? last_offsets[m] : -1;
+        embeddingbag_kern(
+            bs_begin,
+            bs_end,
+            num_emb,
+            emb_dim,
+            last_offset,
+            indices_ptr[m],
+            offsets_ptr[m],
+            w_ptr[m],
+            cat_buf + (m + 1) * emb_dim,
+            /*result_stride=*/cat_line,
+            SUM,
+            hot_ptr[m]);
+      }
+      // consume: flat triangle of pairwise dots, rows still in cache
+      for (int64_t i = bs_begin; i < bs_end; ++i) {
+        const data_t* row = cat_buf + (i - bs_begin) * cat_line;
+        data_t* out_row = &o_ptr[i * out_line];
+        move_ker(out_row, row, emb_dim);
+        data_t* flat = out_row + emb_dim;
+        int64_t offset = 0;
+        for (int64_t f1 = 1; f1 < feature_nums; ++f1) {
+          const data_t* v1 = row + f1 * emb_dim;
+          for (int64_t f2 = 0; f2 < f1; ++f2) {
+            flat[offset++] = pairwise_dot(v1, row + f2 * emb_dim, emb_dim);
+          }
+        }
+      }
+    }
+  }
+}
+
+Tensor merged_embedding_interaction_fw_impl(
+    const TensorList& weights,
+    const TensorList& indices,
+    const TensorList& offsets,
+    const Tensor& dense) {
+  RECORD_FUNCTION(__FUNCTION__, c10::ArrayRef<c10::IValue>({}));
+  int64_t batch_size = dense.size(0);
+  int64_t emb_dim = dense.size(1);
+  int64_t num_emb = weights.size();
+
+  TORCH_INTERNAL_ASSERT_DEBUG_ONLY(num_emb > 0);
+  TORCH_INTERNAL_ASSERT_DEBUG_ONLY(num_emb == indices.size());
+  TORCH_INTERNAL_ASSERT_DEBUG_ONLY(num_emb == offsets.size());
+  TORCH_INTERNAL_ASSERT_DEBUG_ONLY(dense.dim() == 2 && dense.is_contiguous());
+
+  auto index_type = indices[0].scalar_type();
+  auto data_type = dense.scalar_type();
+
+  std::vector<int64_t> last_offsets(num_emb, -1);
+
+  for (int i = 0; i < num_emb; i++) {
+    TORCH_INTERNAL_ASSERT_DEBUG_ONLY(
+        indices[i].is_contiguous() && indices[i].scalar_type() == index_type);
+    TORCH_INTERNAL_ASSERT_DEBUG_ONLY(
+        offsets[i].is_contiguous() && offsets[i].scalar_type() == index_type);
+    TORCH_INTERNAL_ASSERT_DEBUG_ONLY(
+        weights[i].is_contiguous() && weights[i].scalar_type() == data_type);
+    TORCH_INTERNAL_ASSERT_DEBUG_ONLY(
+        weights[i].dim() == 2 && weights[i].size(1) == emb_dim);
+    // handle last offsets
+    last_offsets[i] = indices[i].numel();
+  }
+
+  int64_t feature_nums = num_emb + 1;
+  int64_t interact_feature_size = feature_nums * (feature_nums - 1) / 2;
+  Tensor output = empty(
+      {batch_size, emb_dim + interact_feature_size}, dense.options());
+
+  AT_DISPATCH_FLOATING_TYPES_AND2(
+      at::kBFloat16,
+      at::kHalf,
+      dense.scalar_type(),
+      "merged_embeddingbag_interaction",
+      [&] {
+        AT_DISPATCH_INDEX_TYPES(
+            indices[0].scalar_type(), "merged_embeddingbag_interaction", [&] {
+              scalar_t* dense_ptr = dense.data_ptr<scalar_t>();
+              scalar_t* weights_ptr[num_emb];
+              index_t* indices_ptr[num_emb];
+              index_t* offsets_ptr[num_emb];
+              const EmbHotRowCache* hot_ptr[num_emb];
+              const int64_t hot_budget =
+                  emb_hot_row_cache_mb() * 1024 * 1024 / num_emb;
+              for (int i = 0; i < num_emb; i++) {
+                weights_ptr[i] = weights[i].data_ptr<scalar_t>();
+                indices_ptr[i] = indices[i].data_ptr<index_t>();
+                offsets_ptr[i] = offsets[i].data_ptr<index_t>();
+                hot_ptr[i] = hot_budget == 0
+                    ? nullptr
+                    : emb_hot_row_cache_update<scalar_t, index_t>(
+                          weights_ptr[i],
+                          indices_ptr[i],
+                          indices[i].numel(),
+                          emb_dim,
+                          hot_budget);
+              }
+              scalar_t* output_ptr = output.data_ptr<scalar_t>();
+              merged_embeddingbag_interaction<scalar_t, index_t>(
+                  output_ptr,
+                  weights_ptr,
+                  indices_ptr,
+                  offsets_ptr,
+                  dense_ptr,
+                  batch_size,
+                  num_emb,
+                  emb_dim,
+                  last_offsets,
+                  hot_ptr);
             });
       });
   return output;
@@ -500,7 +850,8 @@ void merged_embeddingbag(
     int64_t num_emb,
     int64_t emb_dim,
     std::vector<int64_t> last_offsets,
-    int64_t pooling_mode) {
+    int64_t pooling_mode,
+    const EmbHotRowCache* const* hot_ptr) {
   constexpr int64_t b_block = 128;
   const int64_t n_b_blocks = (num_batch - 1) / b_block + 1;
 #pragma omp parallel for collapse(2)
@@ -522,7 +873,8 @@ void merged_embeddingbag(
           w_ptr[m],
           r,
           /*result_stride=*/emb_dim,
-          pooling_mode);
+          pooling_mode,
+          hot_ptr[m]);
     }
   }
 }
@@ -578,11 +930,22 @@ std::vector<Tensor> merged_embeddingbag_forward_cpu_kernel_impl(
               scalar_t* outputs_ptr[num_emb];
               index_t* indices_ptr[num_emb];
               index_t* offsets_ptr[num_emb];
+              const EmbHotRowCache* hot_ptr[num_emb];
+              const int64_t hot_budget =
+                  emb_hot_row_cache_mb() * 1024 * 1024 / num_emb;
               for (int i = 0; i < num_emb; i++) {
                 weights_ptr[i] = weights[i].data_ptr<scalar_t>();
                 outputs_ptr[i] = outputs[i].data_ptr<scalar_t>();
                 indices_ptr[i] = indices[i].data_ptr<index_t>();
                 offsets_ptr[i] = offsets[i].data_ptr<index_t>();
+                hot_ptr[i] = hot_budget == 0
+                    ? nullptr
+                    : emb_hot_row_cache_update<scalar_t, index_t>(
+                          weights_ptr[i],
+                          indices_ptr[i],
+                          indices[i].numel(),
+                          emb_dim,
+                          hot_budget);
               }
               merged_embeddingbag<scalar_t, index_t>(
                   outputs_ptr,
@@ -593,6 +956,205 @@ std::vector<Tensor> merged_embeddingbag_forward_cpu_kernel_impl(
                   num_emb,
                   emb_dim,
                   last_offsets,
+                  pooling_mode,
+                  hot_ptr);
+            });
+      });
+
+  return outputs;
+}
+
+// Row-wise quantized lookup: weights are stored as INT8 ([rows, emb_dim],
+// kChar) or packed INT4 ([rows, emb_dim / 2], kByte, low nibble first,
+// signed nibbles) with one fp32 scale per row. Dequantization is fused
+// into the fp32 accumulation loop so the quantized bytes are the only
+// table traffic.
+template <typename out_t, typename index_t>
+inline void qembeddingbag_kern(
+    const int64_t bs_begin,
+    const int64_t bs_end,
+    const int64_t emb_dim,
+    const index_t last_offset,
+    const index_t* indices,
+    const index_t* offsets,
+    const uint8_t* weight,
+    const float* scales,
+    const bool is_int4,
+    out_t* result,
+    const int64_t result_stride,
+    const int64_t pooling_mode) {
+  const int64_t row_bytes = is_int4 ? emb_dim / 2 : emb_dim;
+  const int64_t pf_end = (last_offset != -1) ? last_offset : offsets[bs_end];
+  for (int64_t b = bs_begin; b < bs_end; ++b) {
+    int64_t start_idx = offsets[b];
+    int64_t end_idx =
+        ((b + 1) == bs_end && last_offset != -1) ? last_offset : offsets[b + 1];
+    float temp[emb_dim];
+    zero_ker(temp, emb_dim);
+    for (int64_t j = start_idx; j < end_idx; ++j) {
+      if (j + kRowPrefetchDistance < pf_end) {
+        prefetch_row_ker(
+            &weight[indices[j + kRowPrefetchDistance] * row_bytes], row_bytes);
+      }
+      const int64_t idx = indices[j];
+      const float scale = scales[idx];
+      const uint8_t* row = &weight[idx * row_bytes];
+      if (is_int4) {
+        for (int64_t i = 0; i < row_bytes; ++i) {
+          const uint8_t packed = row[i];
+          temp[2 * i] += scale * float(int8_t(packed << 4) >> 4);
+          temp[2 * i + 1] += scale * float(int8_t(packed) >> 4);
+        }
+      } else {
+        const int8_t* r = reinterpret_cast<const int8_t*>(row);
+#pragma omp simd
+        for (int64_t i = 0; i < emb_dim; ++i) {
+          temp[i] += scale * float(r[i]);
+        }
+      }
+    }
+    if (pooling_mode == MEAN) {
+      const float inv_n = 1.0f / (end_idx - start_idx);
+#pragma omp simd
+      for (int64_t i = 0; i < emb_dim; ++i) {
+        temp[i] *= inv_n;
+      }
+    }
+    move_ker(result, temp, emb_dim);
+    result += result_stride;
+  }
+}
+
+template <typename out_t, typename index_t>
+void merged_embeddingbag_quantized(
+    out_t** o_ptr,
+    const uint8_t** w_ptr,
+    const float** s_ptr,
+    index_t** indices_ptr,
+    index_t** offsets_ptr,
+    const bool* is_int4,
+    int64_t num_batch,
+    int64_t num_emb,
+    int64_t emb_dim,
+    std::vector<int64_t> last_offsets,
+    int64_t pooling_mode) {
+  constexpr int64_t b_block = 128;
+  const int64_t n_b_blocks = (num_batch - 1) / b_block + 1;
+#pragma omp parallel for collapse(2)
+  for (int64_t b = 0; b < n_b_blocks; ++b) {
+    for (int64_t m = 0; m < num_emb; ++m) {
+      const int64_t bs_begin = b * b_block;
+      const int64_t bs_end = std::min(num_batch, (b + 1) * b_block);
+      out_t* r = &o_ptr[m][b * b_block * emb_dim];
+      // avoid offsets not include last batch
+      const index_t last_offset = bs_end == num_batch ? last_offsets[m] : -1;
+      qembeddingbag_kern(
+          bs_begin,
+          bs_end,
+          emb_dim,
+          last_offset,
+          indices_ptr[m],
+          offsets_ptr[m],
+          w_ptr[m],
+          s_ptr[m],
+          is_int4[m],
+          r,
+          /*result_stride=*/emb_dim,
+          pooling_mode);
+    }
+  }
+}
+
+std::vector<Tensor> merged_embeddingbag_forward_quantized_cpu_kernel_impl(
+    const std::vector<Tensor>& qweights,
+    const TensorList& scales,
+    const TensorList& indices,
+    const TensorList& offsets,
+    const int64_t emb_dim,
+    const int64_t pooling_mode,
+    const bool include_last_offsets,
+    const c10::optional<at::ScalarType> output_dtype) {
+  RECORD_FUNCTION(__FUNCTION__, c10::ArrayRef<c10::IValue>({}));
+
+  int64_t num_emb = qweights.size();
+  TORCH_CHECK(num_emb > 0);
+  TORCH_CHECK(num_emb == scales.size());
+  TORCH_CHECK(num_emb == indices.size());
+  TORCH_CHECK(num_emb == offsets.size());
+
+  int64_t batch_size = offsets[0].size(0);
+  if (include_last_offsets) {
+    batch_size -= 1;
+  }
+  auto index_type = indices[0].scalar_type();
+  auto out_type = output_dtype.value_or(at::kFloat);
+  TORCH_CHECK(
+      out_type == at::kFloat || out_type == at::kBFloat16 ||
+          out_type == at::kHalf,
+      "merged_embeddingbag_forward_quantized: unsupported output dtype ",
+      out_type);
+
+  std::vector<int64_t> last_offsets(num_emb, -1);
+  std::vector<bool> table_is_int4(num_emb, false);
+  std::vector<Tensor> outputs;
+
+  for (int i = 0; i < num_emb; i++) {
+    TORCH_CHECK(
+        indices[i].is_contiguous() && indices[i].scalar_type() == index_type);
+    TORCH_CHECK(
+        offsets[i].is_contiguous() && offsets[i].scalar_type() == index_type);
+    TORCH_CHECK(qweights[i].is_contiguous() && qweights[i].dim() == 2);
+    if (qweights[i].scalar_type() == at::kByte) {
+      // packed int4, two values per byte
+      TORCH_CHECK(qweights[i].size(1) * 2 == emb_dim);
+      table_is_int4[i] = true;
+    } else {
+      TORCH_CHECK(qweights[i].scalar_type() == at::kChar);
+      TORCH_CHECK(qweights[i].size(1) == emb_dim);
+    }
+    TORCH_CHECK(
+        scales[i].is_contiguous() && scales[i].scalar_type() == at::kFloat &&
+        scales[i].numel() == qweights[i].size(0));
+    // handle last offsets
+    last_offsets[i] = indices[i].numel();
+    outputs.emplace_back(
+        empty({batch_size, emb_dim}, qweights[i].options().dtype(out_type)));
+  }
+
+  AT_DISPATCH_FLOATING_TYPES_AND2(
+      at::kBFloat16,
+      at::kHalf,
+      out_type,
+      "merged_embeddingbag_quantized",
+      [&] {
+        AT_DISPATCH_INDEX_TYPES(
+            indices[0].scalar_type(), "merged_embeddingbag_quantized", [&] {
+              const uint8_t* weights_ptr[num_emb];
+              const float* scales_ptr[num_emb];
+              scalar_t* outputs_ptr[num_emb];
+              index_t* indices_ptr[num_emb];
+              index_t* offsets_ptr[num_emb];
+              bool is_int4[num_emb];
+              for (int i = 0; i < num_emb; i++) {
+                weights_ptr[i] =
+                    reinterpret_cast<const uint8_t*>(qweights[i].data_ptr());
+                scales_ptr[i] = scales[i].data_ptr<float>();
+                outputs_ptr[i] = outputs[i].data_ptr<scalar_t>();
+                indices_ptr[i] = indices[i].data_ptr<index_t>();
+                offsets_ptr[i] = offsets[i].data_ptr<index_t>();
+                is_int4[i] = table_is_int4[i];
+              }
+              merged_embeddingbag_quantized<scalar_t, index_t>(
+                  outputs_ptr,
+                  weights_ptr,
+                  scales_ptr,
+                  indices_ptr,
+                  offsets_ptr,
+                  is_int4,
+                  batch_size,
+                  num_emb,
+                  emb_dim,
+                  last_offsets,
                   pooling_mode);
             });
       });
@@ -904,9 +1466,15 @@ void mergedemb_distribute_forward_merge_kernel_impl(
 IPEX_REGISTER_DISPATCH(
     merged_embeddingbag_forward_cpu_kernel_stub,
     &merged_embeddingbag_forward_cpu_kernel_impl);
+IPEX_REGISTER_DISPATCH(
+    merged_embeddingbag_forward_quantized_cpu_kernel_stub,
+    &merged_embeddingbag_forward_quantized_cpu_kernel_impl);
 IPEX_REGISTER_DISPATCH(
     merged_embeddingbag_cat_fw_stub,
     &merged_embedding_cat_fw_impl);
+IPEX_REGISTER_DISPATCH(
+    merged_embeddingbag_interaction_fw_stub,
+    &merged_embedding_interaction_fw_impl);
 IPEX_REGISTER_DISPATCH(
     mergedemb_distribute_forward_local_kernel_stub,
     &mergedemb_distribute_forward_local_kernel_impl);
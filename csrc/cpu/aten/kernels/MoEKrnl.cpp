@@ -8,6 +8,11 @@
 #include <immintrin.h>
 #include <torch/csrc/autograd/function.h>
 #include <algorithm>
+#include <cstdlib>
+#include <future>
+#include <map>
+#include "runtime/CPUPool.h"
+#include "runtime/TaskExecutor.h"
 #include "tpp/kernels/TPPGEMMKrnl.h"
 
 namespace torch_ipex {
@@ -124,6 +129,325 @@ at::Tensor mixtral_moe_woq_kernl_impl(
 
   return output;
 }
+
+// Token-sorted batched WOQ path: instead of one call per (expert, token
+// fragment), sort the flattened top-k assignments by expert id with a
+// counting sort, run each expert's GEMMs once over its contiguous token
+// slab, and scatter-add the weighted results back. This pays the INT4
+// weight dequant once per expert per layer rather than per fragment.
+at::Tensor mixtral_moe_woq_batched_kernl_impl(
+    const at::Tensor& hidden_states, // [num_tokens, hidden_size]
+    const at::Tensor& top_k_ids, // [num_tokens, k]
+    const at::Tensor& routing_weights, // [num_tokens, k]
+    at::TensorList gate_wei,
+    at::TensorList up_wei,
+    at::TensorList down_wei,
+    at::Tensor& output) {
+  int64_t num_tokens = hidden_states.size(0);
+  int64_t top_k = top_k_ids.size(1);
+  int64_t num_experts = static_cast<int64_t>(gate_wei.size());
+  int64_t num_assignments = num_tokens * top_k;
+
+  auto ids = top_k_ids.contiguous();
+  auto ids_ptr = ids.data_ptr<int64_t>();
+
+  // Counting sort of the flattened (token, k) assignments by expert id.
+  std::vector<int64_t> expert_offsets(num_experts + 1, 0);
+  for (int64_t n = 0; n < num_assignments; ++n) {
+    expert_offsets[ids_ptr[n] + 1]++;
+  }
+  for (int64_t e = 0; e < num_experts; ++e) {
+    expert_offsets[e + 1] += expert_offsets[e];
+  }
+  // perm maps slab row -> flattened assignment index; token_idx holds the
+  // source token of each slab row for the gather/scatter.
+  at::Tensor perm = at::empty({num_assignments}, ids.options());
+  at::Tensor token_idx = at::empty({num_assignments}, ids.options());
+  auto perm_ptr = perm.data_ptr<int64_t>();
+  auto token_idx_ptr = token_idx.data_ptr<int64_t>();
+  {
+    std::vector<int64_t> fill_pos(
+        expert_offsets.begin(), expert_offsets.end() - 1);
+    for (int64_t n = 0; n < num_assignments; ++n) {
+      auto pos = fill_pos[ids_ptr[n]]++;
+      perm_ptr[pos] = n;
+      token_idx_ptr[pos] = n / top_k;
+    }
+  }
+
+  auto gathered = hidden_states.index_select(0, token_idx);
+  auto routing_w =
+      routing_weights.reshape({-1}).index_select(0, perm).unsqueeze(-1);
+
+  at::Tensor out_rows = at::empty_like(gathered);
+  for (int64_t e = 0; e < num_experts; ++e) {
+    int64_t slab_size = expert_offsets[e + 1] - expert_offsets[e];
+    if (slab_size == 0)
+      continue;
+    auto slab = gathered.narrow(0, expert_offsets[e], slab_size).unsqueeze(0);
+    auto curr_state = woq_linear_forward(
+        at::silu(woq_linear_forward(slab, gate_wei[e])) *
+            woq_linear_forward(slab, up_wei[e]),
+        down_wei[e]);
+    out_rows.narrow(0, expert_offsets[e], slab_size)
+        .copy_(curr_state.squeeze(0));
+  }
+  out_rows = out_rows * routing_w;
+  output.index_add_(0, token_idx, out_rows.to(output.scalar_type()));
+
+  return output;
+}
+
+// ---------------- Expert-parallel execution ----------------
+// Instead of running the experts one after another on all cores, partition
+// the available cores into one group per NUMA node (two contiguous halves
+// when the topology is not exposed) and pin a single-worker TaskExecutor to
+// each group. Experts are assigned round-robin to the groups, so the expert
+// GEMMs of different groups overlap while each group still runs its own
+// experts sequentially on node-local cores.
+//
+// The mode is opt-in via IPEX_MOE_EXPERT_PARALLEL=1 and additionally
+// requires the runtime extension (preloaded IOMP); otherwise the batched
+// entry points below fall back to the sequential per-expert path.
+
+struct MoEExpertGroup {
+  std::unique_ptr<runtime::CPUPool> pool;
+  std::shared_ptr<runtime::TaskExecutor> executor;
+};
+
+std::vector<MoEExpertGroup>& moe_expert_groups() {
+  static std::vector<MoEExpertGroup> groups = []() {
+    std::vector<MoEExpertGroup> result;
+    auto* env = std::getenv("IPEX_MOE_EXPERT_PARALLEL");
+    if (env == nullptr || std::strtol(env, nullptr, 10) == 0) {
+      return result;
+    }
+    if (!runtime::is_runtime_ext_enabled()) {
+      return result;
+    }
+    auto cores = runtime::get_process_available_cores();
+    if (cores.size() < 2) {
+      return result;
+    }
+    std::vector<std::vector<int32_t>> core_groups;
+    auto nodes = runtime::get_numa_nodes_for_cores(cores);
+    if (nodes.size() == cores.size()) {
+      std::map<int32_t, std::vector<int32_t>> cores_per_node;
+      for (size_t i = 0; i < cores.size(); ++i) {
+        cores_per_node[nodes[i]].push_back(cores[i]);
+      }
+      for (auto& node : cores_per_node) {
+        core_groups.push_back(std::move(node.second));
+      }
+    }
+    if (core_groups.size() < 2) {
+      // Single node or unknown topology: split the core list in half so
+      // two experts can still overlap.
+      core_groups.clear();
+      auto half = cores.begin() + cores.size() / 2;
+      core_groups.emplace_back(cores.begin(), half);
+      core_groups.emplace_back(half, cores.end());
+    }
+    for (auto& core_group : core_groups) {
+      MoEExpertGroup group;
+      group.pool = std::make_unique<runtime::CPUPool>(core_group);
+      group.executor = std::make_shared<runtime::TaskExecutor>(
+          *group.pool, /*num_workers*/ 1);
+      result.push_back(std::move(group));
+    }
+    return result;
+  }();
+  return groups;
+}
+
+// Submits expert_fn(expert_id, group_id) round-robin onto the expert groups
+// and waits for all of them; exceptions are rethrown on the calling thread.
+template <typename expert_fn_t>
+void run_experts_in_parallel(int64_t num_experts, const expert_fn_t& expert_fn) {
+  auto& groups = moe_expert_groups();
+  auto grad_mode = at::GradMode::is_enabled();
+  std::vector<std::future<void>> futures;
+  for (int64_t e = 0; e < num_experts; ++e) {
+    int64_t g = e % groups.size();
+    auto task = std::make_shared<std::packaged_task<void()>>(
+        [&expert_fn, e, g, grad_mode]() {
+          at::GradMode::set_enabled(grad_mode);
+          expert_fn(e, g);
+        });
+    futures.emplace_back(task->get_future());
+    groups[g].executor->submit([task]() { (*task)(); });
+  }
+  for (auto& future : futures) {
+    future.get();
+  }
+}
+
+at::Tensor mixtral_moe_tpp_ep_kernl_impl(
+    const at::Tensor& hidden_states,
+    at::TensorList top_x_list,
+    at::TensorList idx_list,
+    at::TensorList gate_wei,
+    at::TensorList up_wei,
+    at::TensorList down_wei,
+    bool tpp_fallback,
+    const at::Tensor& routing_weights,
+    at::Tensor& output) {
+  int64_t num_experts = static_cast<int64_t>(gate_wei.size());
+  auto& groups = moe_expert_groups();
+  if (groups.size() < 2) {
+    for (int64_t e = 0; e < num_experts; ++e) {
+      if (top_x_list[e].sizes()[0] == 0)
+        continue;
+      mixtral_moe_tpp_kernl_impl(
+          hidden_states,
+          top_x_list[e],
+          idx_list[e],
+          gate_wei[e],
+          up_wei[e],
+          down_wei[e],
+          tpp_fallback,
+          routing_weights,
+          output);
+    }
+    return output;
+  }
+  // Each group accumulates into a private buffer; two experts routed to
+  // the same token would otherwise race in index_add_.
+  std::vector<at::Tensor> partials(groups.size());
+  for (auto& partial : partials) {
+    partial = at::zeros_like(output);
+  }
+  run_experts_in_parallel(num_experts, [&](int64_t e, int64_t g) {
+    if (top_x_list[e].sizes()[0] == 0)
+      return;
+    mixtral_moe_tpp_kernl_impl(
+        hidden_states,
+        top_x_list[e],
+        idx_list[e],
+        gate_wei[e],
+        up_wei[e],
+        down_wei[e],
+        tpp_fallback,
+        routing_weights,
+        partials[g]);
+  });
+  for (auto& partial : partials) {
+    output.add_(partial);
+  }
+  return output;
+}
+
+at::Tensor mixtral_moe_ep_kernl_impl(
+    const at::Tensor& hidden_states,
+    at::TensorList top_x_list,
+    at::TensorList idx_list,
+    at::TensorList gate_wei,
+    at::TensorList gate_op_ctx,
+    at::TensorList up_wei,
+    at::TensorList up_op_ctx,
+    at::TensorList down_wei,
+    at::TensorList down_op_ctx,
+    bool use_dnnl,
+    const at::Tensor& routing_weights,
+    at::Tensor& output) {
+  int64_t num_experts = static_cast<int64_t>(gate_wei.size());
+  auto& groups = moe_expert_groups();
+  if (groups.size() < 2) {
+    for (int64_t e = 0; e < num_experts; ++e) {
+      if (top_x_list[e].sizes()[0] == 0)
+        continue;
+      mixtral_moe_kernl_impl(
+          hidden_states,
+          top_x_list[e],
+          idx_list[e],
+          gate_wei[e],
+          gate_op_ctx[e],
+          up_wei[e],
+          up_op_ctx[e],
+          down_wei[e],
+          down_op_ctx[e],
+          use_dnnl,
+          routing_weights,
+          output);
+    }
+    return output;
+  }
+  std::vector<at::Tensor> partials(groups.size());
+  for (auto& partial : partials) {
+    partial = at::zeros_like(output);
+  }
+  run_experts_in_parallel(num_experts, [&](int64_t e, int64_t g) {
+    if (top_x_list[e].sizes()[0] == 0)
+      return;
+    mixtral_moe_kernl_impl(
+        hidden_states,
+        top_x_list[e],
+        idx_list[e],
+        gate_wei[e],
+        gate_op_ctx[e],
+        up_wei[e],
+        up_op_ctx[e],
+        down_wei[e],
+        down_op_ctx[e],
+        use_dnnl,
+        routing_weights,
+        partials[g]);
+  });
+  for (auto& partial : partials) {
+    output.add_(partial);
+  }
+  return output;
+}
+
+at::Tensor mixtral_moe_woq_ep_kernl_impl(
+    const at::Tensor& hidden_states,
+    at::TensorList top_x_list,
+    at::TensorList idx_list,
+    at::TensorList gate_wei,
+    at::TensorList up_wei,
+    at::TensorList down_wei,
+    const at::Tensor& routing_weights,
+    at::Tensor& output) {
+  int64_t num_experts = static_cast<int64_t>(gate_wei.size());
+  auto& groups = moe_expert_groups();
+  if (groups.size() < 2) {
+    for (int64_t e = 0; e < num_experts; ++e) {
+      if (top_x_list[e].sizes()[0] == 0)
+        continue;
+      mixtral_moe_woq_kernl_impl(
+          hidden_states,
+          top_x_list[e],
+          idx_list[e],
+          gate_wei[e],
+          up_wei[e],
+          down_wei[e],
+          routing_weights,
+          output);
+    }
+    return output;
+  }
+  std::vector<at::Tensor> partials(groups.size());
+  for (auto& partial : partials) {
+    partial = at::zeros_like(output);
+  }
+  run_experts_in_parallel(num_experts, [&](int64_t e, int64_t g) {
+    if (top_x_list[e].sizes()[0] == 0)
+      return;
+    mixtral_moe_woq_kernl_impl(
+        hidden_states,
+        top_x_list[e],
+        idx_list[e],
+        gate_wei[e],
+        up_wei[e],
+        down_wei[e],
+        routing_weights,
+        partials[g]);
+  });
+  for (auto& partial : partials) {
+    output.add_(partial);
+  }
+  return output;
+}
 } // anonymous namespace
 
 IPEX_REGISTER_DISPATCH(
@@ -133,6 +457,16 @@ IPEX_REGISTER_DISPATCH(
     mixtral_moe_woq_kernel_stub,
     &mixtral_moe_woq_kernl_impl);
 IPEX_REGISTER_DISPATCH(mixtral_moe_kernel_stub, &mixtral_moe_kernl_impl);
+IPEX_REGISTER_DISPATCH(
+    mixtral_moe_tpp_ep_kernel_stub,
+    &mixtral_moe_tpp_ep_kernl_impl);
+IPEX_REGISTER_DISPATCH(
+    mixtral_moe_woq_ep_kernel_stub,
+    &mixtral_moe_woq_ep_kernl_impl);
+IPEX_REGISTER_DISPATCH(mixtral_moe_ep_kernel_stub, &mixtral_moe_ep_kernl_impl);
+IPEX_REGISTER_DISPATCH(
+    mixtral_moe_woq_batched_kernel_stub,
+    &mixtral_moe_woq_batched_kernl_impl);
 
 } // namespace cpu
 } // namespace torch_ipex
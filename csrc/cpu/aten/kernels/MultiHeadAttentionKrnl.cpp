@@ -1,4 +1,5 @@
 #include <aten/MultiHeadAttention.h>
+#include <aten/utils/mha_context.h>
 #include "csrc/cpu/tpp/woq/tla.h"
 #include "mkl.h"
 #include "vec/vec.h"
@@ -133,28 +134,25 @@ at::Tensor sd_mha_base_kernel(
   int64_t qSplitSize = qSize >= qsplit_size ? qsplit_size : qSize;
   int64_t kvSplitSize = kvSize >= kvsplit_size ? kvsplit_size : kvSize;
 
-  int64_t qSlice = (qSize - 1) / qSplitSize + 1;
-  int64_t qTail = (qSize - 1) % qSplitSize + 1;
-  int64_t kvSlice = (kvSize - 1) / kvSplitSize + 1;
-  int64_t kvTail = (kvSize - 1) % kvSplitSize + 1;
+  // The tiling plan and scratch buffers are cached per shape bucket; see
+  // aten/utils/mha_context.h.
+  auto ctx = detail::get_mha_context(
+      qSize, kvSize, headSize, qSplitSize, kvSplitSize, scale);
+  int64_t qSlice = ctx->q_slice_;
+  int64_t qTail = ctx->q_tail_;
+  int64_t kvSlice = ctx->kv_slice_;
+  int64_t kvTail = ctx->kv_tail_;
 
   int64_t num_thread = omp_get_max_threads();
 
-  at::Tensor qk_fp32 =
-      at::empty({num_thread, qSplitSize, kvSplitSize}, at::kFloat);
-  at::Tensor qk_bf16 =
-      at::empty({num_thread, qSplitSize, kvSplitSize}, at::kBFloat16);
-  at::Tensor qk_max = at::empty({num_thread, qSplitSize}, at::kFloat);
-  at::Tensor qk_sum = at::empty({num_thread, qSplitSize}, at::kFloat);
-  at::Tensor dst_fp32 =
-      at::empty({num_thread, qSplitSize, headSize}, at::kFloat);
+  detail::MhaScratchLease scratch(ctx, num_thread, headSize);
 
   auto output_ptr = output.data_ptr<at::BFloat16>();
-  auto qk_fp32_ptr = qk_fp32.data_ptr<float>();
-  auto qk_bf16_ptr = qk_bf16.data_ptr<at::BFloat16>();
-  auto qk_max_ptr = qk_max.data_ptr<float>();
-  auto qk_sum_ptr = qk_sum.data_ptr<float>();
-  auto dst_fp32_ptr = dst_fp32.data_ptr<float>();
+  auto qk_fp32_ptr = scratch.qk_fp32_.data_ptr<float>();
+  auto qk_bf16_ptr = scratch.qk_bf16_.data_ptr<at::BFloat16>();
+  auto qk_max_ptr = scratch.qk_max_.data_ptr<float>();
+  auto qk_sum_ptr = scratch.qk_sum_.data_ptr<float>();
+  auto dst_fp32_ptr = scratch.dst_fp32_.data_ptr<float>();
 
   // Create tpp kernels for Query @ Key
   int qk_gemm_K = headSize % 2 == 0
@@ -405,7 +403,7 @@ at::Tensor sd_mha_base_kernel(
               dst_fp32_ptr + ompIdx * qSplitSize * headSize,
               qk_max_ptr + ompIdx * qSplitSize,
               qk_sum_ptr + ompIdx * qSplitSize,
-              scale,
+              ctx->scale_,
               qBlockSize,
               kvBlockSize,
               headSize,
@@ -506,21 +504,28 @@ at::Tensor bert_mha_kernel_impl(
   int64_t kvSplitSize =
       sequenceSize >= kvsplit_size ? kvsplit_size : sequenceSize;
 
-  int64_t qSlice = (sequenceSize - 1) / qSplitSize + 1;
-  int64_t qTail = (sequenceSize - 1) % qSplitSize + 1;
-  int64_t kvSlice = (sequenceSize - 1) / kvSplitSize + 1;
-  int64_t kvTail = (sequenceSize - 1) % kvSplitSize + 1;
+  // The tiling plan and scratch buffers are cached per shape bucket; see
+  // aten/utils/mha_context.h.
+  auto ctx = detail::get_mha_context(
+      sequenceSize,
+      sequenceSize,
+      headSize,
+      qSplitSize,
+      kvSplitSize,
+      dim_per_head);
+  int64_t qSlice = ctx->q_slice_;
+  int64_t qTail = ctx->q_tail_;
+  int64_t kvSlice = ctx->kv_slice_;
+  int64_t kvTail = ctx->kv_tail_;
 
   int64_t num_thread = omp_get_max_threads();
 
-  at::Tensor qk_fp32 =
-      at::empty({num_thread, qSplitSize, kvSplitSize}, at::kFloat);
-  at::Tensor qk_bf16 =
-      at::empty({num_thread, qSplitSize, kvSplitSize}, at::kBFloat16);
-  at::Tensor qk_max = at::empty({num_thread, qSplitSize}, at::kFloat);
-  at::Tensor qk_sum = at::empty({num_thread, qSplitSize}, at::kFloat);
-  at::Tensor dst_fp32 =
-      at::empty({num_thread, qSplitSize, headSize}, at::kFloat);
+  detail::MhaScratchLease scratch(ctx, num_thread, headSize);
+  at::Tensor qk_fp32 = scratch.qk_fp32_;
+  at::Tensor qk_bf16 = scratch.qk_bf16_;
+  at::Tensor qk_max = scratch.qk_max_;
+  at::Tensor qk_sum = scratch.qk_sum_;
+  at::Tensor dst_fp32 = scratch.dst_fp32_;
 
 #pragma omp parallel for collapse(3)
   for (int i = 0; i < batchSize; ++i) {
@@ -560,7 +565,7 @@ at::Tensor bert_mha_kernel_impl(
                   l * qSplitSize,
               qk_max.data_ptr<float>() + ompIdx * qSplitSize,
               qk_sum.data_ptr<float>() + ompIdx * qSplitSize,
-              dim_per_head,
+              ctx->scale_,
               qBlockSize,
               kvBlockSize,
               headSize,
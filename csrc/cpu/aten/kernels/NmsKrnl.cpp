@@ -6,6 +6,7 @@
 #include <algorithm>
 #include "autocast/autocast_mode.h"
 #include "cpu/kernels/Softmax.h"
+#include "utils/radix_sort.h"
 
 #include <aten/Nms.h>
 
@@ -52,9 +53,15 @@ at::Tensor nms_cpu_kernel(
   auto ndets = dets.size(0);
   // If scores and dets are already sorted in descending order, we don't need to
   // sort it again.
-  auto order_t = sorted
-      ? at::arange(0, ndets, scores.options().dtype(at::kLong))
-      : std::get<1>(scores.sort(0, /* descending=*/true));
+  at::Tensor order_t;
+  if (sorted) {
+    order_t = at::arange(0, ndets, scores.options().dtype(at::kLong));
+  } else {
+    auto scores_t = scores.contiguous();
+    order_t = at::empty({ndets}, scores.options().dtype(at::kLong));
+    radix_sort_descending_indices<scalar_t>(
+        scores_t.data_ptr<scalar_t>(), order_t.data_ptr<int64_t>(), ndets);
+  }
 
   at::Tensor suppressed_t =
       at::zeros({ndets}, dets.options().dtype(at::kByte).device(at::kCPU));
@@ -2,7 +2,10 @@
 #include <aten/PagedAttention.h>
 #include <torch/all.h>
 #include <torch/csrc/autograd/function.h>
+#include <cmath>
 #include <limits>
+#include <type_traits>
+#include "utils/hot_trace.h"
 #include "vec/vec.h"
 
 namespace torch_ipex {
@@ -10,12 +13,34 @@ namespace cpu {
 
 namespace {
 
-template <typename QT, typename KT>
-void reduce_head(
+// 64/96/128 cover every model we run. Routing them through a
+// std::integral_constant hands the per-head helpers a compile-time trip
+// count, so the (inlined) vector loops fully unroll and the per-head
+// state stays in registers; other sizes keep the dynamic path.
+template <typename F>
+inline void dispatch_head_size(int64_t head_size, const F& f) {
+  switch (head_size) {
+    case 64:
+      f(std::integral_constant<int64_t, 64>{});
+      break;
+    case 96:
+      f(std::integral_constant<int64_t, 96>{});
+      break;
+    case 128:
+      f(std::integral_constant<int64_t, 128>{});
+      break;
+    default:
+      f(head_size);
+      break;
+  }
+}
+
+template <typename QT, typename KT, typename HS>
+void reduce_head_impl(
     const QT* q_ptr_start,
     const KT* k_cache_start,
     float* attn_w_pos,
-    int64_t head_size) {
+    HS head_size) {
   attn_w_pos[0] = 0;
 #if defined(CPU_CAPABILITY_AVX512)
   torch_ipex::cpu::kernel::_reduce_head<QT, KT, KT>(
@@ -27,15 +52,56 @@ void reduce_head(
 #endif
 }
 
-template <typename OT, typename CT>
-inline void mul_attenion_weights_and_value_of_head(
+template <typename QT, typename KT>
+void reduce_head(
+    const QT* q_ptr_start,
+    const KT* k_cache_start,
+    float* attn_w_pos,
+    int64_t head_size) {
+  dispatch_head_size(head_size, [&](auto hs) {
+    reduce_head_impl<QT, KT>(q_ptr_start, k_cache_start, attn_w_pos, hs);
+  });
+}
+
+template <typename QT, typename HS>
+void reduce_head_quant_impl(
+    const QT* q_ptr_start,
+    const int8_t* k_cache_start,
+    const float k_scale,
+    float* attn_w_pos,
+    HS head_size) {
+  attn_w_pos[0] = 0;
+#if defined(CPU_CAPABILITY_AVX512)
+  torch_ipex::cpu::kernel::_reduce_head_quant<QT>(
+      q_ptr_start, k_cache_start, k_scale, attn_w_pos, head_size);
+#else
+  for (auto hsi = 0; hsi < head_size; hsi++) {
+    attn_w_pos[0] +=
+        (float)q_ptr_start[hsi] * (float)k_cache_start[hsi] * k_scale;
+  }
+#endif
+}
+
+template <typename QT>
+void reduce_head_quant(
+    const QT* q_ptr_start,
+    const int8_t* k_cache_start,
+    const float k_scale,
+    float* attn_w_pos,
+    int64_t head_size) {
+  dispatch_head_size(head_size, [&](auto hs) {
+    reduce_head_quant_impl<QT>(
+        q_ptr_start, k_cache_start, k_scale, attn_w_pos, hs);
+  });
+}
+
+template <typename OT, typename CT, typename HS>
+inline void mul_attenion_weights_and_value_of_head_impl(
     const float& attn_w,
     const CT* v_cache_start,
     OT* attn_out_start,
-    int64_t head_size,
+    HS head_size,
     bool accumulated) {
-  auto vec_size = 16; // 512/32
-  auto hsi = 0;
 #if defined(CPU_CAPABILITY_AVX512)
   torch_ipex::cpu::kernel::_mul_and_accumulate<CT, OT, CT>(
       attn_w,
@@ -46,7 +112,7 @@ inline void mul_attenion_weights_and_value_of_head(
       nullptr,
       accumulated);
 #else
-  for (hsi = 0; hsi < head_size; hsi++) {
+  for (auto hsi = 0; hsi < head_size; hsi++) {
     if (accumulated) {
       attn_out_start[hsi] += attn_w * (float)v_cache_start[hsi];
     } else {
@@ -56,6 +122,55 @@ inline void mul_attenion_weights_and_value_of_head(
 #endif
 }
 
+template <typename OT, typename CT>
+inline void mul_attenion_weights_and_value_of_head(
+    const float& attn_w,
+    const CT* v_cache_start,
+    OT* attn_out_start,
+    int64_t head_size,
+    bool accumulated) {
+  dispatch_head_size(head_size, [&](auto hs) {
+    mul_attenion_weights_and_value_of_head_impl<OT, CT>(
+        attn_w, v_cache_start, attn_out_start, hs, accumulated);
+  });
+}
+
+template <typename OT, typename HS>
+inline void mul_attenion_weights_and_value_of_head_quant_impl(
+    const float& attn_w,
+    const int8_t* v_cache_start,
+    const float v_scale,
+    OT* attn_out_start,
+    HS head_size,
+    bool accumulated) {
+#if defined(CPU_CAPABILITY_AVX512)
+  torch_ipex::cpu::kernel::_mul_and_accumulate_quant<OT>(
+      attn_w, v_cache_start, v_scale, attn_out_start, head_size, accumulated);
+#else
+  for (auto hsi = 0; hsi < head_size; hsi++) {
+    if (accumulated) {
+      attn_out_start[hsi] += attn_w * v_scale * (float)v_cache_start[hsi];
+    } else {
+      attn_out_start[hsi] = attn_w * v_scale * (float)v_cache_start[hsi];
+    }
+  }
+#endif
+}
+
+template <typename OT>
+inline void mul_attenion_weights_and_value_of_head_quant(
+    const float& attn_w,
+    const int8_t* v_cache_start,
+    const float v_scale,
+    OT* attn_out_start,
+    int64_t head_size,
+    bool accumulated) {
+  dispatch_head_size(head_size, [&](auto hs) {
+    mul_attenion_weights_and_value_of_head_quant_impl<OT>(
+        attn_w, v_cache_start, v_scale, attn_out_start, hs, accumulated);
+  });
+}
+
 /**
  * Performs scale-dot-product for the next token based on cached key-value
  * attention.
@@ -84,8 +199,23 @@ inline void mul_attenion_weights_and_value_of_head(
  * @param max_context_len Maximum context length.
  * @param alibi_slopes  Optional tensor of alibi slopes with the shape of
  * (num_heads).
+ * @param k_scale_ptr   Per token/head dequantization scales of the key cache
+ * with the layout [num_blocks, block_size, num_kv_heads]; nullptr for an
+ * unquantized cache (cache_t == scalar_t).
+ * @param v_scale_ptr   Same as k_scale_ptr, for the value cache.
+ * @param attn_bias_ptr Optional learned relative-position bias tile
+ * (T5-style), pre-tiled at cache setup as [num_heads, max_context_len]
+ * fp32 and indexed by the key token's distance from the current query
+ * token, so one tile serves every sequence regardless of its context
+ * length. nullptr keeps the alibi/no-bias behavior.
+ * @param attn_bias_stride Stride between heads in attn_bias_ptr.
+ *
+ * HEAD_BLOCKED selects the [num_blocks, num_heads, block_size, head_size]
+ * cache layout, where one head's keys within a block form a contiguous
+ * stream, instead of the default [num_blocks, block_size, num_heads,
+ * head_size] token-major layout.
  */
-template <typename scalar_t>
+template <typename scalar_t, typename cache_t = scalar_t, bool HEAD_BLOCKED = false>
 void single_query_cached_kv_attention_kernel(
     at::Tensor& out,
     at::Tensor& query,
@@ -97,11 +227,15 @@ void single_query_cached_kv_attention_kernel(
     at::Tensor& context_lens,
     int64_t block_size,
     int64_t max_context_len,
-    const c10::optional<at::Tensor>& alibi_slopes) {
+    const c10::optional<at::Tensor>& alibi_slopes,
+    const float* k_scale_ptr = nullptr,
+    const float* v_scale_ptr = nullptr,
+    const float* attn_bias_ptr = nullptr,
+    int64_t attn_bias_stride = 0) {
   auto out_ptr = out.data_ptr<scalar_t>();
   auto query_ptr = query.data_ptr<scalar_t>();
-  auto key_cache_ptr = key_cache.data_ptr<scalar_t>();
-  auto value_cache_ptr = value_cache.data_ptr<scalar_t>();
+  auto key_cache_ptr = key_cache.data_ptr<cache_t>();
+  auto value_cache_ptr = value_cache.data_ptr<cache_t>();
   auto head_mapping_ptr = head_mapping.data_ptr<int>();
   auto block_tables_ptr = block_tables.data_ptr<int>();
   auto context_lens_ptr = context_lens.data_ptr<int>();
@@ -111,7 +245,7 @@ void single_query_cached_kv_attention_kernel(
   auto num_seqs = query.size(0);
   auto num_heads = query.size(1);
   auto head_size = query.size(2);
-  auto num_kv_heads = key_cache.size(2);
+  auto num_kv_heads = HEAD_BLOCKED ? key_cache.size(1) : key_cache.size(2);
   auto max_num_blocks_per_seq = block_tables.size(1);
   auto attn_weights = at::empty(
       {num_seqs, num_heads, max_context_len},
@@ -128,6 +262,65 @@ void single_query_cached_kv_attention_kernel(
         "alibi_slopes size is not equal to num_heads");
   }
 
+  // GQA fast path: when query heads of a group are consecutive and mapped in
+  // order (head_mapping[h] == h / group_size), iterate KV-head-major so each
+  // shared K/V row is loaded once and reused for the whole group while it is
+  // hot in registers/L1, instead of being re-read once per query head.
+  auto group_size = num_heads / num_kv_heads;
+  bool uniform_gqa = num_heads % num_kv_heads == 0 && group_size > 1;
+  if (uniform_gqa) {
+    for (auto head_id = 0; head_id < num_heads; head_id++) {
+      if (head_mapping_ptr[head_id] != head_id / group_size) {
+        uniform_gqa = false;
+        break;
+      }
+    }
+  }
+
+  if (uniform_gqa) {
+#pragma omp parallel for collapse(3)
+    for (auto seq_id = 0; seq_id < num_seqs; seq_id++) {
+      for (auto kv_head_id = 0; kv_head_id < num_kv_heads; kv_head_id++) {
+        for (auto token_id = 0; token_id < max_context_len; token_id++) {
+          auto context_len = context_lens_ptr[seq_id];
+          if (token_id >= context_len)
+            continue;
+          auto block_id = block_tables_ptr
+              [seq_id * max_num_blocks_per_seq + token_id / block_size];
+          auto block_offset = token_id % block_size;
+          auto kv_offset = HEAD_BLOCKED
+              ? kv_head_id * block_size * head_size + block_offset * head_size
+              : block_offset * num_kv_heads * head_size +
+                  kv_head_id * head_size;
+          auto k_cache_start =
+              key_cache_ptr + block_id * kv_block_stride + kv_offset;
+          float k_scale = 1.0f;
+          if constexpr (std::is_same<cache_t, int8_t>::value) {
+            auto scale_offset = HEAD_BLOCKED
+                ? block_id * num_kv_heads * block_size +
+                    kv_head_id * block_size + block_offset
+                : block_id * block_size * num_kv_heads +
+                    block_offset * num_kv_heads + kv_head_id;
+            k_scale = k_scale_ptr[scale_offset];
+          }
+          for (auto gi = 0; gi < group_size; gi++) {
+            auto head_id = kv_head_id * group_size + gi;
+            auto attn_w_pos = attn_weights_ptr + seq_id * attn_weights_stride +
+                head_id * max_context_len + token_id;
+            auto q_ptr_start =
+                query_ptr + seq_id * q_stride + head_id * head_size;
+            if constexpr (std::is_same<cache_t, int8_t>::value) {
+              reduce_head_quant<scalar_t>(
+                  q_ptr_start, k_cache_start, k_scale, attn_w_pos, head_size);
+            } else {
+              reduce_head<scalar_t, cache_t>(
+                  q_ptr_start, k_cache_start, attn_w_pos, head_size);
+            }
+          }
+        }
+      }
+    }
+  } else {
 #pragma omp parallel for collapse(3)
   for (auto seq_id = 0; seq_id < num_seqs; seq_id++) {
     for (auto head_id = 0; head_id < num_heads; head_id++) {
@@ -141,15 +334,129 @@ void single_query_cached_kv_attention_kernel(
         auto block_id = block_tables_ptr
             [seq_id * max_num_blocks_per_seq + token_id / block_size];
         auto block_offset = token_id % block_size;
-        auto k_cache_start = key_cache_ptr + block_id * kv_block_stride +
-            block_offset * num_kv_heads * head_size +
-            head_mapping_ptr[head_id] * head_size;
-        reduce_head<scalar_t, scalar_t>(
-            q_ptr_start, k_cache_start, attn_w_pos, head_size);
+        auto kv_offset = HEAD_BLOCKED
+            ? head_mapping_ptr[head_id] * block_size * head_size +
+                block_offset * head_size
+            : block_offset * num_kv_heads * head_size +
+                head_mapping_ptr[head_id] * head_size;
+        auto k_cache_start =
+            key_cache_ptr + block_id * kv_block_stride + kv_offset;
+        if constexpr (std::is_same<cache_t, int8_t>::value) {
+          auto scale_offset = HEAD_BLOCKED
+              ? block_id * num_kv_heads * block_size +
+                  head_mapping_ptr[head_id] * block_size + block_offset
+              : block_id * block_size * num_kv_heads +
+                  block_offset * num_kv_heads + head_mapping_ptr[head_id];
+          auto k_scale = k_scale_ptr[scale_offset];
+          reduce_head_quant<scalar_t>(
+              q_ptr_start, k_cache_start, k_scale, attn_w_pos, head_size);
+        } else {
+          reduce_head<scalar_t, cache_t>(
+              q_ptr_start, k_cache_start, attn_w_pos, head_size);
+        }
       }
     }
   }
+  } // uniform_gqa
 
+  auto thread_numbers = omp_get_max_threads();
+  // Flash-decoding style split-KV softmax: when a small batch times head
+  // count leaves most cores idle (e.g. one 32k-context sequence on a
+  // 56-core socket), partition the context, compute partial max/sum
+  // statistics per partition in parallel and reduce them, instead of one
+  // serial softmax per (seq, head).
+  constexpr int64_t kSplitKVPartitionSize = 512;
+  auto num_partitions =
+      (max_context_len + kSplitKVPartitionSize - 1) / kSplitKVPartitionSize;
+  bool use_split_kv =
+      num_seqs * num_heads < thread_numbers && num_partitions > 1;
+  if (use_split_kv) {
+    auto partial_max =
+        at::empty({num_seqs, num_heads, num_partitions}, at::kFloat);
+    auto partial_sum =
+        at::empty({num_seqs, num_heads, num_partitions}, at::kFloat);
+    auto partial_max_acc = partial_max.accessor<float, 3>();
+    auto partial_sum_acc = partial_sum.accessor<float, 3>();
+// scale+alibi, partial max and exp-sum per partition
+#pragma omp parallel for collapse(3)
+    for (auto seq_id = 0; seq_id < num_seqs; seq_id++) {
+      for (auto head_id = 0; head_id < num_heads; head_id++) {
+        for (auto part_id = 0; part_id < num_partitions; part_id++) {
+          auto context_len = context_lens_ptr[seq_id];
+          auto token_start = part_id * kSplitKVPartitionSize;
+          auto token_end = std::min(
+              (int64_t)context_len, token_start + kSplitKVPartitionSize);
+          auto part_max = -10000.0f;
+          float part_sum = 0.0f;
+          auto attn_w_start = attn_weights_ptr +
+              seq_id * attn_weights_stride + head_id * max_context_len;
+          if (token_start < token_end) {
+            for (auto token_id = token_start; token_id < token_end;
+                 token_id++) {
+              attn_w_start[token_id] = attn_w_start[token_id] * scale;
+              if (alibi_slopes_ptr != nullptr) {
+                attn_w_start[token_id] += alibi_slopes_ptr[head_id] *
+                    (token_id + 1 - context_len);
+              }
+              if (attn_bias_ptr != nullptr) {
+                attn_w_start[token_id] += attn_bias_ptr
+                    [head_id * attn_bias_stride + (context_len - 1 - token_id)];
+              }
+              if (attn_w_start[token_id] > part_max) {
+                part_max = attn_w_start[token_id];
+              }
+            }
+            for (auto token_id = token_start; token_id < token_end;
+                 token_id++) {
+              attn_w_start[token_id] = exp(attn_w_start[token_id] - part_max);
+              part_sum += attn_w_start[token_id];
+            }
+          }
+          partial_max_acc[seq_id][head_id][part_id] = part_max;
+          partial_sum_acc[seq_id][head_id][part_id] = part_sum;
+        }
+      }
+    }
+// reduce the partial statistics into one rescale factor per partition
+#pragma omp parallel for collapse(2)
+    for (auto seq_id = 0; seq_id < num_seqs; seq_id++) {
+      for (auto head_id = 0; head_id < num_heads; head_id++) {
+        auto global_max = -10000.0f;
+        for (auto part_id = 0; part_id < num_partitions; part_id++) {
+          global_max =
+              std::max(global_max, partial_max_acc[seq_id][head_id][part_id]);
+        }
+        float global_sum = 0.0f;
+        for (auto part_id = 0; part_id < num_partitions; part_id++) {
+          global_sum += partial_sum_acc[seq_id][head_id][part_id] *
+              exp(partial_max_acc[seq_id][head_id][part_id] - global_max);
+        }
+        for (auto part_id = 0; part_id < num_partitions; part_id++) {
+          partial_sum_acc[seq_id][head_id][part_id] =
+              exp(partial_max_acc[seq_id][head_id][part_id] - global_max) /
+              global_sum;
+        }
+      }
+    }
+// rescale each partition's weights with its correction factor
+#pragma omp parallel for collapse(3)
+    for (auto seq_id = 0; seq_id < num_seqs; seq_id++) {
+      for (auto head_id = 0; head_id < num_heads; head_id++) {
+        for (auto part_id = 0; part_id < num_partitions; part_id++) {
+          auto context_len = context_lens_ptr[seq_id];
+          auto token_start = part_id * kSplitKVPartitionSize;
+          auto token_end = std::min(
+              (int64_t)context_len, token_start + kSplitKVPartitionSize);
+          auto factor = partial_sum_acc[seq_id][head_id][part_id];
+          auto attn_w_start = attn_weights_ptr +
+              seq_id * attn_weights_stride + head_id * max_context_len;
+          for (auto token_id = token_start; token_id < token_end; token_id++) {
+            attn_w_start[token_id] *= factor;
+          }
+        }
+      }
+    }
+  } else {
 // div+add+softmax
 #pragma omp parallel for collapse(2)
   for (auto seq_id = 0; seq_id < num_seqs; seq_id++) {
@@ -160,34 +467,38 @@ void single_query_cached_kv_attention_kernel(
       auto attn_w_start = attn_weights_ptr + seq_id * attn_weights_stride +
           head_id * max_context_len;
 #if defined(CPU_CAPABILITY_AVX512)
-      if (alibi_slopes_ptr != nullptr) {
-        auto alibi_slope = alibi_slopes_ptr[head_id];
-        torch_ipex::cpu::kernel::
-            _dil_div_add_alibi_and_reduce_max_fusion_kernel<float>(
-                attn_w_start,
-                scale,
-                context_len,
-                attn_w_start,
-                max_val,
-                alibi_slope,
-                true);
-      } else {
-        torch_ipex::cpu::kernel::
-            _dil_div_add_alibi_and_reduce_max_fusion_kernel<float>(
-                attn_w_start,
-                scale,
-                context_len,
-                attn_w_start,
-                max_val,
-                1,
-                false);
-      }
-      torch_ipex::cpu::kernel::_dil_exp_reduce_sum_fusion_kernel(
-          attn_w_start, context_len, attn_w_start, max_val);
-      torch_ipex::cpu::kernel::_dil_normalization_kernel<float>(
-          attn_w_start, max_val, context_len, attn_w_start);
-
-#else
+      // the fused helpers only fold scale+alibi; the learned bias path
+      // takes the scalar loop below
+      if (attn_bias_ptr == nullptr) {
+        if (alibi_slopes_ptr != nullptr) {
+          auto alibi_slope = alibi_slopes_ptr[head_id];
+          torch_ipex::cpu::kernel::
+              _dil_div_add_alibi_and_reduce_max_fusion_kernel<float>(
+                  attn_w_start,
+                  scale,
+                  context_len,
+                  attn_w_start,
+                  max_val,
+                  alibi_slope,
+                  true);
+        } else {
+          torch_ipex::cpu::kernel::
+              _dil_div_add_alibi_and_reduce_max_fusion_kernel<float>(
+                  attn_w_start,
+                  scale,
+                  context_len,
+                  attn_w_start,
+                  max_val,
+                  1,
+                  false);
+        }
+        torch_ipex::cpu::kernel::_dil_exp_reduce_sum_fusion_kernel(
+            attn_w_start, context_len, attn_w_start, max_val);
+        torch_ipex::cpu::kernel::_dil_normalization_kernel<float>(
+            attn_w_start, max_val, context_len, attn_w_start);
+      } else
+#endif
+      {
       // div+add+softmax
       for (auto token_id = 0; token_id < context_lens_ptr[seq_id]; token_id++) {
         attn_w_start[token_id] = attn_w_start[token_id] * scale;
@@ -197,6 +508,11 @@ void single_query_cached_kv_attention_kernel(
               alibi_slope * (token_id + 1 - context_lens_ptr[seq_id]);
           attn_w_start[token_id] = attn_w_start[token_id] + alibi_slopes_val;
         }
+        if (attn_bias_ptr != nullptr) {
+          attn_w_start[token_id] += attn_bias_ptr
+              [head_id * attn_bias_stride +
+               (context_lens_ptr[seq_id] - 1 - token_id)];
+        }
         if (attn_w_start[token_id] > max_val) {
           max_val = attn_w_start[token_id];
         }
@@ -210,11 +526,11 @@ void single_query_cached_kv_attention_kernel(
       for (auto token_id = 0; token_id < context_lens_ptr[seq_id]; token_id++) {
         attn_w_start[token_id] = attn_w_start[token_id] / sum;
       }
-#endif
+      }
     }
   }
+  } // use_split_kv
 
-  auto thread_numbers = omp_get_max_threads();
   auto private_attn_outs =
       at::empty({thread_numbers, num_seqs, num_heads, head_size}, at::kFloat);
   auto private_attn_out_flag =
@@ -223,6 +539,65 @@ void single_query_cached_kv_attention_kernel(
   auto private_attn_out_ptr = private_attn_outs.data_ptr<float>();
   auto private_attn_out_stride = private_attn_outs.stride(0);
 // mul and accumulate
+  if (uniform_gqa) {
+    // KV-head-major mirror of the QK pass: one V row feeds every query head
+    // of its group.
+#pragma omp parallel for collapse(3)
+    for (auto seq_id = 0; seq_id < num_seqs; seq_id++) {
+      for (auto kv_head_id = 0; kv_head_id < num_kv_heads; kv_head_id++) {
+        for (auto token_id = 0; token_id < max_context_len; token_id++) {
+          auto context_len = context_lens_ptr[seq_id];
+          auto thread_id = omp_get_thread_num();
+          if (token_id >= context_len)
+            continue;
+          auto block_id = block_tables_ptr
+              [seq_id * max_num_blocks_per_seq + token_id / block_size];
+          auto block_offset = token_id % block_size;
+          auto kv_offset = HEAD_BLOCKED
+              ? kv_head_id * block_size * head_size + block_offset * head_size
+              : block_offset * num_kv_heads * head_size +
+                  kv_head_id * head_size;
+          auto v_cache_start =
+              value_cache_ptr + block_id * kv_block_stride + kv_offset;
+          float v_scale = 1.0f;
+          if constexpr (std::is_same<cache_t, int8_t>::value) {
+            auto scale_offset = HEAD_BLOCKED
+                ? block_id * num_kv_heads * block_size +
+                    kv_head_id * block_size + block_offset
+                : block_id * block_size * num_kv_heads +
+                    block_offset * num_kv_heads + kv_head_id;
+            v_scale = v_scale_ptr[scale_offset];
+          }
+          for (auto gi = 0; gi < group_size; gi++) {
+            auto head_id = kv_head_id * group_size + gi;
+            auto attn_w = attn_weights_ptr
+                [seq_id * attn_weights_stride + head_id * max_context_len +
+                 token_id];
+            auto attn_out_start = private_attn_out_ptr +
+                thread_id * private_attn_out_stride + seq_id * q_stride +
+                head_id * head_size;
+            if constexpr (std::is_same<cache_t, int8_t>::value) {
+              mul_attenion_weights_and_value_of_head_quant<float>(
+                  attn_w,
+                  v_cache_start,
+                  v_scale,
+                  attn_out_start,
+                  head_size,
+                  flag_access[thread_id][seq_id][head_id]);
+            } else {
+              mul_attenion_weights_and_value_of_head<float, cache_t>(
+                  attn_w,
+                  v_cache_start,
+                  attn_out_start,
+                  head_size,
+                  flag_access[thread_id][seq_id][head_id]);
+            }
+            flag_access[thread_id][seq_id][head_id] = 1;
+          }
+        } // for token_id
+      } // for kv_head_id
+    } // for seq_id
+  } else {
 #pragma omp parallel for collapse(3)
   for (auto seq_id = 0; seq_id < num_seqs; seq_id++) {
     for (auto head_id = 0; head_id < num_heads; head_id++) {
@@ -237,22 +612,43 @@ void single_query_cached_kv_attention_kernel(
         auto block_id = block_tables_ptr
             [seq_id * max_num_blocks_per_seq + token_id / block_size];
         auto block_offset = token_id % block_size;
-        auto v_cache_start = value_cache_ptr + block_id * kv_block_stride +
-            block_offset * num_kv_heads * head_size +
-            head_mapping_ptr[head_id] * head_size;
+        auto kv_offset = HEAD_BLOCKED
+            ? head_mapping_ptr[head_id] * block_size * head_size +
+                block_offset * head_size
+            : block_offset * num_kv_heads * head_size +
+                head_mapping_ptr[head_id] * head_size;
+        auto v_cache_start =
+            value_cache_ptr + block_id * kv_block_stride + kv_offset;
         auto attn_out_start = private_attn_out_ptr +
             thread_id * private_attn_out_stride + seq_id * q_stride +
             head_id * head_size;
-        mul_attenion_weights_and_value_of_head<float, scalar_t>(
-            attn_w,
-            v_cache_start,
-            attn_out_start,
-            head_size,
-            flag_access[thread_id][seq_id][head_id]);
+        if constexpr (std::is_same<cache_t, int8_t>::value) {
+          auto scale_offset = HEAD_BLOCKED
+              ? block_id * num_kv_heads * block_size +
+                  head_mapping_ptr[head_id] * block_size + block_offset
+              : block_id * block_size * num_kv_heads +
+                  block_offset * num_kv_heads + head_mapping_ptr[head_id];
+          auto v_scale = v_scale_ptr[scale_offset];
+          mul_attenion_weights_and_value_of_head_quant<float>(
+              attn_w,
+              v_cache_start,
+              v_scale,
+              attn_out_start,
+              head_size,
+              flag_access[thread_id][seq_id][head_id]);
+        } else {
+          mul_attenion_weights_and_value_of_head<float, cache_t>(
+              attn_w,
+              v_cache_start,
+              attn_out_start,
+              head_size,
+              flag_access[thread_id][seq_id][head_id]);
+        }
         flag_access[thread_id][seq_id][head_id] = 1;
       } // for token_id
     } // for head_id
   } // for seq_id
+  } // uniform_gqa
   {
     RECORD_FUNCTION(
         "ipex::single_query_cached_kv_attention::reduction_private_result",
@@ -286,112 +682,1237 @@ void single_query_cached_kv_attention_kernel(
 } // single_query_cached_kv_attention_kernel
 
 /**
- * Reshapes and caches the key and value tensors based on the provided slot
- * mapping.
- *
- * @param key The input key tensor. The shape should be [num_seqs, num_heads,
- * head_size].
- * @param value The input value tensor.  The shape should be [num_seqs,
- * num_heads, head_size].
- * @param key_cache The output key cache tensor. The pre-allocated buffer to
- * store the key cache. The shape should be [num_blocks, block_size, num_heads,
- * head_size].
- * @param value_cache The output value cache tensor. The pre-allocated buffer to
- * store the value cache. The shape should be [num_blocks, block_size,
- * num_heads, head_size].
- * @param slot_mapping The slot mapping tensor. It stores the position to store
- * the key/value in the pre-allocated buffers. The shape should be the number of
- * sequences. For sequence i, the slot_mapping[i]//block_number can get the
- * block index, and the slot_mapping%block_size can get the offset of this
- * block.
+ * Multi-query variant of the decode kernel for speculative decoding
+ * verification: q_len draft tokens per sequence are verified in one call.
+ * The draft keys/values are assumed to be already written to the cache (via
+ * reshape_and_cache), and context_lens counts them, so draft token qi may
+ * attend positions [0, context_len - q_len + qi]. The block-table walk and
+ * each K/V row load are amortized across all q_len draft queries instead of
+ * looping the single-query kernel q_len times.
  *
- * @tparam DST_T The data type of the output tensors.
- * @tparam SRC_T The data type of the input tensors.
+ * @param out   Output tensor [num_seqs, q_len, num_heads, head_size].
+ * @param query Query tensor [num_seqs, q_len, num_heads, head_size].
+ * Remaining parameters match single_query_cached_kv_attention_kernel.
  */
-template <typename DST_T, typename SRC_T>
-void reshape_and_cache_kernel(
-    at::Tensor& key,
-    at::Tensor& value,
+template <typename scalar_t>
+void multi_query_cached_kv_attention_kernel(
+    at::Tensor& out,
+    at::Tensor& query,
     at::Tensor& key_cache,
     at::Tensor& value_cache,
-    at::Tensor& slot_mapping) {
-  auto num_tokens = key.size(0);
-  auto head_num = key.size(1);
-  auto head_size = key.size(2);
-  auto block_size = key_cache.size(1);
-  auto hidden_size = head_num * head_size;
-  auto key_cache_ptr = key_cache.data_ptr<DST_T>();
-  auto key_ptr = key.data_ptr<SRC_T>();
-  auto value_cache_ptr = value_cache.data_ptr<DST_T>();
-  auto value_ptr = value.data_ptr<SRC_T>();
-  auto slot_mapping_ptr = slot_mapping.data_ptr<int>();
-  auto cache_stride = key_cache.stride(0);
-  auto state_stride = key.stride(0);
-#pragma omp parallel for collapse(2)
-  for (auto ti = 0; ti < num_tokens; ti++) {
-    for (auto hi = 0; hi < head_num; hi++) {
-      auto block_id = slot_mapping_ptr[ti] / block_size;
-      auto block_offset = slot_mapping_ptr[ti] % block_size;
-      auto cache_offset = block_id * cache_stride +
-          block_offset * key_cache.stride(1) + hi * head_size;
-      auto state_offset = ti * state_stride + hi * head_size;
-      auto key_cache_start = key_cache_ptr + cache_offset;
-      auto key_ptr_start = key_ptr + state_offset;
-      auto value_cache_start = value_cache_ptr + cache_offset;
-      auto value_ptr_start = value_ptr + state_offset;
-      torch_ipex::cpu::kernel::move_ker<DST_T, SRC_T>(
-          key_cache_start, key_ptr_start, head_size);
-      torch_ipex::cpu::kernel::move_ker<DST_T, SRC_T>(
-          value_cache_start, value_ptr_start, head_size);
-    }
-  }
-}
-
-void single_query_cached_kv_attention_kernel_impl(
-    at::Tensor& out, // [num_seqs, num_heads, head_size]
-    at::Tensor& query, // [num_seqs, num_heads, head_size]
-    at::Tensor& key_cache, // [num_blocks,  block_size, num_heads, head_size]
-    at::Tensor& value_cache, // [num_blocks,  block_size, num_heads, head_size]
-    at::Tensor& head_mapping, // [num_heads]
+    at::Tensor& head_mapping,
     const double scale,
-    at::Tensor& block_tables, // [num_seqs, max_num_blocks_per_seq]
-    at::Tensor& context_lens, // [num_seqs]
+    at::Tensor& block_tables,
+    at::Tensor& context_lens,
     int64_t block_size,
     int64_t max_context_len,
     const c10::optional<at::Tensor>& alibi_slopes) {
-  RECORD_FUNCTION(
-      "ipex::single_query_cached_kv_attention_kernel_impl",
-      c10::ArrayRef<c10::IValue>({}));
-  // dispatch kernel according to the data type of input tensor
-  if (out.scalar_type() == at::ScalarType::Float) {
-    single_query_cached_kv_attention_kernel<float>(
-        out,
-        query,
-        key_cache,
-        value_cache,
-        head_mapping,
-        scale,
-        block_tables,
-        context_lens,
-        block_size,
-        max_context_len,
-        alibi_slopes);
-  } else if (out.scalar_type() == at::ScalarType::BFloat16) {
-    single_query_cached_kv_attention_kernel<at::BFloat16>(
-        out,
-        query,
-        key_cache,
-        value_cache,
-        head_mapping,
-        scale,
-        block_tables,
+  auto out_ptr = out.data_ptr<scalar_t>();
+  auto query_ptr = query.data_ptr<scalar_t>();
+  auto key_cache_ptr = key_cache.data_ptr<scalar_t>();
+  auto value_cache_ptr = value_cache.data_ptr<scalar_t>();
+  auto head_mapping_ptr = head_mapping.data_ptr<int>();
+  auto block_tables_ptr = block_tables.data_ptr<int>();
+  auto context_lens_ptr = context_lens.data_ptr<int>();
+  auto alibi_slopes_ptr = alibi_slopes.has_value()
+      ? alibi_slopes.value().data_ptr<float>()
+      : nullptr;
+  auto num_seqs = query.size(0);
+  auto q_len = query.size(1);
+  auto num_heads = query.size(2);
+  auto head_size = query.size(3);
+  auto num_kv_heads = key_cache.size(2);
+  auto max_num_blocks_per_seq = block_tables.size(1);
+  auto attn_weights = at::empty(
+      {num_seqs, q_len, num_heads, max_context_len},
+      query.options().dtype(at::ScalarType::Float));
+  auto attn_weights_ptr = attn_weights.data_ptr<float>();
+  auto attn_weights_stride = attn_weights.stride(0);
+  auto kv_block_stride = key_cache.stride(0);
+  auto q_stride = query.stride(0);
+  auto q_token_stride = num_heads * head_size;
+
+  if (alibi_slopes.has_value()) {
+    auto alibi_slopes_size = alibi_slopes.value().size(0);
+    TORCH_CHECK(
+        alibi_slopes_size == num_heads,
+        "alibi_slopes size is not equal to num_heads");
+  }
+
+// QK: one block-table lookup and one key row load per (seq, head, token),
+// shared by every draft query that may attend the token
+#pragma omp parallel for collapse(3)
+  for (auto seq_id = 0; seq_id < num_seqs; seq_id++) {
+    for (auto head_id = 0; head_id < num_heads; head_id++) {
+      for (auto token_id = 0; token_id < max_context_len; token_id++) {
+        auto context_len = context_lens_ptr[seq_id];
+        if (token_id >= context_len)
+          continue;
+        auto block_id = block_tables_ptr
+            [seq_id * max_num_blocks_per_seq + token_id / block_size];
+        auto block_offset = token_id % block_size;
+        auto k_cache_start = key_cache_ptr + block_id * kv_block_stride +
+            block_offset * num_kv_heads * head_size +
+            head_mapping_ptr[head_id] * head_size;
+        // token_id is visible to draft query qi iff
+        // token_id <= context_len - q_len + qi
+        auto qi_start =
+            std::max((int64_t)0, token_id - (context_len - q_len));
+        for (auto qi = qi_start; qi < q_len; qi++) {
+          auto q_ptr_start = query_ptr + seq_id * q_stride +
+              qi * q_token_stride + head_id * head_size;
+          auto attn_w_pos = attn_weights_ptr + seq_id * attn_weights_stride +
+              (qi * num_heads + head_id) * max_context_len + token_id;
+          reduce_head<scalar_t, scalar_t>(
+              q_ptr_start, k_cache_start, attn_w_pos, head_size);
+        }
+      }
+    }
+  }
+
+// div+add+softmax per (seq, draft query, head) over its causal context
+#pragma omp parallel for collapse(3)
+  for (auto seq_id = 0; seq_id < num_seqs; seq_id++) {
+    for (auto qi = 0; qi < q_len; qi++) {
+      for (auto head_id = 0; head_id < num_heads; head_id++) {
+        auto context_len = context_lens_ptr[seq_id];
+        auto valid_len = context_len - q_len + qi + 1;
+        auto max_val = -10000.0f;
+        float sum = 0.0f;
+        auto attn_w_start = attn_weights_ptr + seq_id * attn_weights_stride +
+            (qi * num_heads + head_id) * max_context_len;
+#if defined(CPU_CAPABILITY_AVX512)
+        if (alibi_slopes_ptr != nullptr) {
+          auto alibi_slope = alibi_slopes_ptr[head_id];
+          torch_ipex::cpu::kernel::
+              _dil_div_add_alibi_and_reduce_max_fusion_kernel<float>(
+                  attn_w_start,
+                  scale,
+                  valid_len,
+                  attn_w_start,
+                  max_val,
+                  alibi_slope,
+                  true);
+        } else {
+          torch_ipex::cpu::kernel::
+              _dil_div_add_alibi_and_reduce_max_fusion_kernel<float>(
+                  attn_w_start, scale, valid_len, attn_w_start, max_val, 1,
+                  false);
+        }
+        torch_ipex::cpu::kernel::_dil_exp_reduce_sum_fusion_kernel(
+            attn_w_start, valid_len, attn_w_start, max_val);
+        torch_ipex::cpu::kernel::_dil_normalization_kernel<float>(
+            attn_w_start, max_val, valid_len, attn_w_start);
+#else
+        for (auto token_id = 0; token_id < valid_len; token_id++) {
+          attn_w_start[token_id] = attn_w_start[token_id] * scale;
+          if (alibi_slopes_ptr != nullptr) {
+            attn_w_start[token_id] +=
+                alibi_slopes_ptr[head_id] * (token_id + 1 - valid_len);
+          }
+          if (attn_w_start[token_id] > max_val) {
+            max_val = attn_w_start[token_id];
+          }
+        }
+        for (auto token_id = 0; token_id < valid_len; token_id++) {
+          attn_w_start[token_id] = exp(attn_w_start[token_id] - max_val);
+          sum += attn_w_start[token_id];
+        }
+        for (auto token_id = 0; token_id < valid_len; token_id++) {
+          attn_w_start[token_id] = attn_w_start[token_id] / sum;
+        }
+#endif
+      }
+    }
+  }
+
+  auto thread_numbers = omp_get_max_threads();
+  auto private_attn_outs = at::empty(
+      {thread_numbers, num_seqs, q_len, num_heads, head_size}, at::kFloat);
+  auto private_attn_out_flag =
+      at::zeros({thread_numbers, num_seqs, q_len * num_heads}, at::kByte);
+  auto flag_access = private_attn_out_flag.accessor<uint8_t, 3>();
+  auto private_attn_out_ptr = private_attn_outs.data_ptr<float>();
+  auto private_attn_out_stride = private_attn_outs.stride(0);
+// PV: one value row load per (seq, head, token), accumulated into every
+// draft query that attends the token
+#pragma omp parallel for collapse(3)
+  for (auto seq_id = 0; seq_id < num_seqs; seq_id++) {
+    for (auto head_id = 0; head_id < num_heads; head_id++) {
+      for (auto token_id = 0; token_id < max_context_len; token_id++) {
+        auto context_len = context_lens_ptr[seq_id];
+        auto thread_id = omp_get_thread_num();
+        if (token_id >= context_len)
+          continue;
+        auto block_id = block_tables_ptr
+            [seq_id * max_num_blocks_per_seq + token_id / block_size];
+        auto block_offset = token_id % block_size;
+        auto v_cache_start = value_cache_ptr + block_id * kv_block_stride +
+            block_offset * num_kv_heads * head_size +
+            head_mapping_ptr[head_id] * head_size;
+        auto qi_start =
+            std::max((int64_t)0, token_id - (context_len - q_len));
+        for (auto qi = qi_start; qi < q_len; qi++) {
+          auto attn_w = attn_weights_ptr
+              [seq_id * attn_weights_stride +
+               (qi * num_heads + head_id) * max_context_len + token_id];
+          auto attn_out_start = private_attn_out_ptr +
+              thread_id * private_attn_out_stride +
+              ((seq_id * q_len + qi) * num_heads + head_id) * head_size;
+          mul_attenion_weights_and_value_of_head<float, scalar_t>(
+              attn_w,
+              v_cache_start,
+              attn_out_start,
+              head_size,
+              flag_access[thread_id][seq_id][qi * num_heads + head_id]);
+          flag_access[thread_id][seq_id][qi * num_heads + head_id] = 1;
+        }
+      } // for token_id
+    } // for head_id
+  } // for seq_id
+  {
+    RECORD_FUNCTION(
+        "ipex::multi_query_cached_kv_attention::reduction_private_result",
+        c10::ArrayRef<c10::IValue>({}));
+#pragma omp parallel for collapse(2)
+    for (auto seq_id = 0; seq_id < num_seqs; seq_id++) {
+      for (auto qh = 0; qh < q_len * num_heads; qh++) {
+        auto thr0_head_start = private_attn_out_ptr +
+            (seq_id * q_len * num_heads + qh) * head_size;
+        if (flag_access[0][seq_id][qh] == 0) {
+          torch_ipex::cpu::kernel::zero_ker(thr0_head_start, head_size);
+        }
+        for (auto thread_id = 1; thread_id < thread_numbers; thread_id++) {
+          if (flag_access[thread_id][seq_id][qh] == 0) {
+            continue;
+          }
+          auto private_attn_out_start = private_attn_out_ptr +
+              thread_id * private_attn_out_stride +
+              (seq_id * q_len * num_heads + qh) * head_size;
+          torch_ipex::cpu::kernel::add_ker<float, float>(
+              thr0_head_start, private_attn_out_start, head_size);
+        }
+        auto out_start =
+            out_ptr + (seq_id * q_len * num_heads + qh) * head_size;
+        torch_ipex::cpu::kernel::move_ker<scalar_t, float>(
+            out_start, thr0_head_start, head_size);
+      }
+    }
+  }
+} // multi_query_cached_kv_attention_kernel
+
+/**
+ * Shared-prefix variant of the decode kernel. All sequences share the first
+ * prefix_len cached tokens (the same physical blocks, taken from sequence
+ * 0's block table). The prefix loops are block-major: each shared key/value
+ * row is read once per batch and used for every sequence's query while it is
+ * hot in cache, so decode bandwidth over the prefix drops by roughly the
+ * sharing factor. The per-sequence tail past the prefix runs like the plain
+ * decode kernel.
+ *
+ * Parameters match single_query_cached_kv_attention_kernel, plus prefix_len
+ * which must not exceed any sequence's context length.
+ */
+template <typename scalar_t>
+void shared_prefix_cached_kv_attention_kernel(
+    at::Tensor& out,
+    at::Tensor& query,
+    at::Tensor& key_cache,
+    at::Tensor& value_cache,
+    at::Tensor& head_mapping,
+    const double scale,
+    at::Tensor& block_tables,
+    at::Tensor& context_lens,
+    int64_t block_size,
+    int64_t max_context_len,
+    const c10::optional<at::Tensor>& alibi_slopes,
+    int64_t prefix_len) {
+  auto out_ptr = out.data_ptr<scalar_t>();
+  auto query_ptr = query.data_ptr<scalar_t>();
+  auto key_cache_ptr = key_cache.data_ptr<scalar_t>();
+  auto value_cache_ptr = value_cache.data_ptr<scalar_t>();
+  auto head_mapping_ptr = head_mapping.data_ptr<int>();
+  auto block_tables_ptr = block_tables.data_ptr<int>();
+  auto context_lens_ptr = context_lens.data_ptr<int>();
+  auto alibi_slopes_ptr = alibi_slopes.has_value()
+      ? alibi_slopes.value().data_ptr<float>()
+      : nullptr;
+  auto num_seqs = query.size(0);
+  auto num_heads = query.size(1);
+  auto head_size = query.size(2);
+  auto num_kv_heads = key_cache.size(2);
+  auto max_num_blocks_per_seq = block_tables.size(1);
+  auto attn_weights = at::empty(
+      {num_seqs, num_heads, max_context_len},
+      query.options().dtype(at::ScalarType::Float));
+  auto attn_weights_ptr = attn_weights.data_ptr<float>();
+  auto kv_block_stride = key_cache.stride(0);
+  auto q_stride = query.stride(0);
+  auto attn_weights_stride = attn_weights.stride(0);
+
+// Prefix dot-products, block-major: one key row feeds every sequence.
+#pragma omp parallel for collapse(2)
+  for (auto head_id = 0; head_id < num_heads; head_id++) {
+    for (auto token_id = 0; token_id < prefix_len; token_id++) {
+      auto block_id =
+          block_tables_ptr[token_id / block_size]; // sequence 0's table
+      auto block_offset = token_id % block_size;
+      auto k_cache_start = key_cache_ptr + block_id * kv_block_stride +
+          block_offset * num_kv_heads * head_size +
+          head_mapping_ptr[head_id] * head_size;
+      for (auto seq_id = 0; seq_id < num_seqs; seq_id++) {
+        auto attn_w_pos = attn_weights_ptr + seq_id * attn_weights_stride +
+            head_id * max_context_len + token_id;
+        auto q_ptr_start = query_ptr + seq_id * q_stride + head_id * head_size;
+        reduce_head<scalar_t, scalar_t>(
+            q_ptr_start, k_cache_start, attn_w_pos, head_size);
+      }
+    }
+  }
+
+// Per-sequence tail past the prefix.
+#pragma omp parallel for collapse(3)
+  for (auto seq_id = 0; seq_id < num_seqs; seq_id++) {
+    for (auto head_id = 0; head_id < num_heads; head_id++) {
+      for (auto token_id = prefix_len; token_id < max_context_len;
+           token_id++) {
+        auto context_len = context_lens_ptr[seq_id];
+        if (token_id >= context_len)
+          continue;
+        auto attn_w_pos = attn_weights_ptr + seq_id * attn_weights_stride +
+            head_id * max_context_len + token_id;
+        auto q_ptr_start = query_ptr + seq_id * q_stride + head_id * head_size;
+        auto block_id = block_tables_ptr
+            [seq_id * max_num_blocks_per_seq + token_id / block_size];
+        auto block_offset = token_id % block_size;
+        auto k_cache_start = key_cache_ptr + block_id * kv_block_stride +
+            block_offset * num_kv_heads * head_size +
+            head_mapping_ptr[head_id] * head_size;
+        reduce_head<scalar_t, scalar_t>(
+            q_ptr_start, k_cache_start, attn_w_pos, head_size);
+      }
+    }
+  }
+
+// div+add+softmax, identical to the plain decode kernel
+#pragma omp parallel for collapse(2)
+  for (auto seq_id = 0; seq_id < num_seqs; seq_id++) {
+    for (auto head_id = 0; head_id < num_heads; head_id++) {
+      auto max_val = -10000.0f;
+      float sum = 0.0f;
+      auto context_len = context_lens_ptr[seq_id];
+      auto attn_w_start = attn_weights_ptr + seq_id * attn_weights_stride +
+          head_id * max_context_len;
+#if defined(CPU_CAPABILITY_AVX512)
+      if (alibi_slopes_ptr != nullptr) {
+        auto alibi_slope = alibi_slopes_ptr[head_id];
+        torch_ipex::cpu::kernel::
+            _dil_div_add_alibi_and_reduce_max_fusion_kernel<float>(
+                attn_w_start,
+                scale,
+                context_len,
+                attn_w_start,
+                max_val,
+                alibi_slope,
+                true);
+      } else {
+        torch_ipex::cpu::kernel::
+            _dil_div_add_alibi_and_reduce_max_fusion_kernel<float>(
+                attn_w_start,
+                scale,
+                context_len,
+                attn_w_start,
+                max_val,
+                1,
+                false);
+      }
+      torch_ipex::cpu::kernel::_dil_exp_reduce_sum_fusion_kernel(
+          attn_w_start, context_len, attn_w_start, max_val);
+      torch_ipex::cpu::kernel::_dil_normalization_kernel<float>(
+          attn_w_start, max_val, context_len, attn_w_start);
+#else
+      for (auto token_id = 0; token_id < context_len; token_id++) {
+        attn_w_start[token_id] = attn_w_start[token_id] * scale;
+        if (alibi_slopes_ptr != nullptr) {
+          auto alibi_slope = alibi_slopes_ptr[head_id];
+          auto alibi_slopes_val = alibi_slope * (token_id + 1 - context_len);
+          attn_w_start[token_id] = attn_w_start[token_id] + alibi_slopes_val;
+        }
+        if (attn_w_start[token_id] > max_val) {
+          max_val = attn_w_start[token_id];
+        }
+      }
+      for (auto token_id = 0; token_id < context_len; token_id++) {
+        attn_w_start[token_id] = exp(attn_w_start[token_id] - max_val);
+        sum += attn_w_start[token_id];
+      }
+      for (auto token_id = 0; token_id < context_len; token_id++) {
+        attn_w_start[token_id] = attn_w_start[token_id] / sum;
+      }
+#endif
+    }
+  }
+
+  auto thread_numbers = omp_get_max_threads();
+  auto private_attn_outs =
+      at::empty({thread_numbers, num_seqs, num_heads, head_size}, at::kFloat);
+  auto private_attn_out_flag =
+      at::zeros({thread_numbers, num_seqs, num_heads}, at::kByte);
+  auto flag_access = private_attn_out_flag.accessor<uint8_t, 3>();
+  auto private_attn_out_ptr = private_attn_outs.data_ptr<float>();
+  auto private_attn_out_stride = private_attn_outs.stride(0);
+// Prefix weighted-value accumulation, block-major: one value row feeds
+// every sequence.
+#pragma omp parallel for collapse(2)
+  for (auto head_id = 0; head_id < num_heads; head_id++) {
+    for (auto token_id = 0; token_id < prefix_len; token_id++) {
+      auto thread_id = omp_get_thread_num();
+      auto block_id = block_tables_ptr[token_id / block_size];
+      auto block_offset = token_id % block_size;
+      auto v_cache_start = value_cache_ptr + block_id * kv_block_stride +
+          block_offset * num_kv_heads * head_size +
+          head_mapping_ptr[head_id] * head_size;
+      for (auto seq_id = 0; seq_id < num_seqs; seq_id++) {
+        auto attn_w = attn_weights_ptr
+            [seq_id * attn_weights_stride + head_id * max_context_len +
+             token_id];
+        auto attn_out_start = private_attn_out_ptr +
+            thread_id * private_attn_out_stride + seq_id * q_stride +
+            head_id * head_size;
+        mul_attenion_weights_and_value_of_head<float, scalar_t>(
+            attn_w,
+            v_cache_start,
+            attn_out_start,
+            head_size,
+            flag_access[thread_id][seq_id][head_id]);
+        flag_access[thread_id][seq_id][head_id] = 1;
+      }
+    }
+  }
+// Per-sequence tail accumulation.
+#pragma omp parallel for collapse(3)
+  for (auto seq_id = 0; seq_id < num_seqs; seq_id++) {
+    for (auto head_id = 0; head_id < num_heads; head_id++) {
+      for (auto token_id = prefix_len; token_id < max_context_len;
+           token_id++) {
+        auto context_len = context_lens_ptr[seq_id];
+        auto thread_id = omp_get_thread_num();
+        if (token_id >= context_len)
+          continue;
+        auto attn_w = attn_weights_ptr
+            [seq_id * attn_weights_stride + head_id * max_context_len +
+             token_id];
+        auto block_id = block_tables_ptr
+            [seq_id * max_num_blocks_per_seq + token_id / block_size];
+        auto block_offset = token_id % block_size;
+        auto v_cache_start = value_cache_ptr + block_id * kv_block_stride +
+            block_offset * num_kv_heads * head_size +
+            head_mapping_ptr[head_id] * head_size;
+        auto attn_out_start = private_attn_out_ptr +
+            thread_id * private_attn_out_stride + seq_id * q_stride +
+            head_id * head_size;
+        mul_attenion_weights_and_value_of_head<float, scalar_t>(
+            attn_w,
+            v_cache_start,
+            attn_out_start,
+            head_size,
+            flag_access[thread_id][seq_id][head_id]);
+        flag_access[thread_id][seq_id][head_id] = 1;
+      }
+    }
+  }
+  {
+    RECORD_FUNCTION(
+        "ipex::shared_prefix_cached_kv_attention::reduction_private_result",
+        c10::ArrayRef<c10::IValue>({}));
+#pragma omp parallel for collapse(2)
+    for (auto seq_id = 0; seq_id < num_seqs; seq_id++) {
+      for (auto hi = 0; hi < num_heads; hi++) {
+        auto thr0_head_start =
+            private_attn_out_ptr + (seq_id * num_heads + hi) * head_size;
+        if (flag_access[0][seq_id][hi] == 0) {
+          torch_ipex::cpu::kernel::zero_ker(thr0_head_start, head_size);
+        }
+        for (auto thread_id = 1; thread_id < thread_numbers; thread_id++) {
+          if (flag_access[thread_id][seq_id][hi] == 0) {
+            continue;
+          }
+          auto attn_out_head_stride = thread_id * private_attn_out_stride +
+              (seq_id * num_heads + hi) * head_size;
+          auto private_attn_out_start =
+              private_attn_out_ptr + attn_out_head_stride;
+          torch_ipex::cpu::kernel::add_ker<float, float>(
+              thr0_head_start, private_attn_out_start, head_size);
+        }
+        auto out_start = out_ptr + (seq_id * num_heads + hi) * head_size;
+        torch_ipex::cpu::kernel::move_ker<scalar_t, float>(
+            out_start, thr0_head_start, head_size);
+      }
+    }
+  }
+} // shared_prefix_cached_kv_attention_kernel
+
+/**
+ * Computes attention for one chunk of prompt tokens against the paged
+ * key-value cache. The caller streams a long prompt in fixed-size chunks
+ * (after writing the chunk's keys/values with reshape_and_cache) and is free
+ * to interleave decode steps of other sequences between chunk calls, which
+ * keeps decode p99 flat while the prompt prefills.
+ *
+ * Query rows of sequence i occupy [query_start_loc[i], query_start_loc[i+1])
+ * and attend causally: the j-th row of the chunk sees the cache positions
+ * [0, context_len - chunk_len + j].
+ *
+ * @param out             Output tensor [num_tokens, num_heads, head_size].
+ * @param query           Query tensor [num_tokens, num_heads, head_size].
+ * @param key_cache       Key cache [num_blocks, block_size, num_heads,
+ * head_size].
+ * @param value_cache     Value cache [num_blocks, block_size, num_heads,
+ * head_size].
+ * @param head_mapping    Query-head to kv-head mapping [num_heads].
+ * @param scale           Scaling factor for attention weights.
+ * @param block_tables    Block tables tensor [num_seqs, max_num_blocks_per_seq].
+ * @param context_lens    Tokens already cached per sequence, including this
+ * chunk [num_seqs].
+ * @param query_start_loc Cumulative query row offsets [num_seqs + 1].
+ * @param block_size      The number of tokens in every block.
+ * @param max_context_len Maximum context length.
+ * @param alibi_slopes    Optional tensor of alibi slopes (num_heads).
+ */
+template <typename scalar_t>
+void chunked_prefill_cached_kv_attention_kernel(
+    at::Tensor& out,
+    at::Tensor& query,
+    at::Tensor& key_cache,
+    at::Tensor& value_cache,
+    at::Tensor& head_mapping,
+    const double scale,
+    at::Tensor& block_tables,
+    at::Tensor& context_lens,
+    at::Tensor& query_start_loc,
+    int64_t block_size,
+    int64_t max_context_len,
+    const c10::optional<at::Tensor>& alibi_slopes) {
+  auto out_ptr = out.data_ptr<scalar_t>();
+  auto query_ptr = query.data_ptr<scalar_t>();
+  auto key_cache_ptr = key_cache.data_ptr<scalar_t>();
+  auto value_cache_ptr = value_cache.data_ptr<scalar_t>();
+  auto head_mapping_ptr = head_mapping.data_ptr<int>();
+  auto block_tables_ptr = block_tables.data_ptr<int>();
+  auto context_lens_ptr = context_lens.data_ptr<int>();
+  auto query_start_loc_ptr = query_start_loc.data_ptr<int>();
+  auto alibi_slopes_ptr = alibi_slopes.has_value()
+      ? alibi_slopes.value().data_ptr<float>()
+      : nullptr;
+  auto num_tokens = query.size(0);
+  auto num_seqs = context_lens.size(0);
+  auto num_heads = query.size(1);
+  auto head_size = query.size(2);
+  auto num_kv_heads = key_cache.size(2);
+  auto max_num_blocks_per_seq = block_tables.size(1);
+  auto kv_block_stride = key_cache.stride(0);
+  auto q_stride = query.stride(0);
+
+  // Map every query row back to its sequence and causal length once.
+  auto token_to_seq = at::empty({num_tokens}, at::kInt);
+  auto causal_lens = at::empty({num_tokens}, at::kInt);
+  auto token_to_seq_ptr = token_to_seq.data_ptr<int>();
+  auto causal_lens_ptr = causal_lens.data_ptr<int>();
+  for (auto seq_id = 0; seq_id < num_seqs; seq_id++) {
+    auto chunk_start = query_start_loc_ptr[seq_id];
+    auto chunk_len = query_start_loc_ptr[seq_id + 1] - chunk_start;
+    for (auto i = 0; i < chunk_len; i++) {
+      token_to_seq_ptr[chunk_start + i] = seq_id;
+      causal_lens_ptr[chunk_start + i] =
+          context_lens_ptr[seq_id] - chunk_len + i + 1;
+    }
+  }
+
+  auto attn_weights = at::empty(
+      {num_tokens, num_heads, max_context_len},
+      query.options().dtype(at::ScalarType::Float));
+  auto attn_weights_ptr = attn_weights.data_ptr<float>();
+  auto attn_weights_stride = attn_weights.stride(0);
+
+#pragma omp parallel for collapse(3)
+  for (auto token_idx = 0; token_idx < num_tokens; token_idx++) {
+    for (auto head_id = 0; head_id < num_heads; head_id++) {
+      for (auto token_id = 0; token_id < max_context_len; token_id++) {
+        auto causal_len = causal_lens_ptr[token_idx];
+        if (token_id >= causal_len)
+          continue;
+        auto seq_id = token_to_seq_ptr[token_idx];
+        auto attn_w_pos = attn_weights_ptr + token_idx * attn_weights_stride +
+            head_id * max_context_len + token_id;
+        auto q_ptr_start =
+            query_ptr + token_idx * q_stride + head_id * head_size;
+        auto block_id = block_tables_ptr
+            [seq_id * max_num_blocks_per_seq + token_id / block_size];
+        auto block_offset = token_id % block_size;
+        auto k_cache_start = key_cache_ptr + block_id * kv_block_stride +
+            block_offset * num_kv_heads * head_size +
+            head_mapping_ptr[head_id] * head_size;
+        reduce_head<scalar_t, scalar_t>(
+            q_ptr_start, k_cache_start, attn_w_pos, head_size);
+      }
+    }
+  }
+
+// div+add+softmax over each query row's causal window
+#pragma omp parallel for collapse(2)
+  for (auto token_idx = 0; token_idx < num_tokens; token_idx++) {
+    for (auto head_id = 0; head_id < num_heads; head_id++) {
+      auto max_val = -10000.0f;
+      float sum = 0.0f;
+      auto causal_len = causal_lens_ptr[token_idx];
+      auto attn_w_start = attn_weights_ptr + token_idx * attn_weights_stride +
+          head_id * max_context_len;
+#if defined(CPU_CAPABILITY_AVX512)
+      if (alibi_slopes_ptr != nullptr) {
+        auto alibi_slope = alibi_slopes_ptr[head_id];
+        torch_ipex::cpu::kernel::
+            _dil_div_add_alibi_and_reduce_max_fusion_kernel<float>(
+                attn_w_start,
+                scale,
+                causal_len,
+                attn_w_start,
+                max_val,
+                alibi_slope,
+                true);
+      } else {
+        torch_ipex::cpu::kernel::
+            _dil_div_add_alibi_and_reduce_max_fusion_kernel<float>(
+                attn_w_start,
+                scale,
+                causal_len,
+                attn_w_start,
+                max_val,
+                1,
+                false);
+      }
+      torch_ipex::cpu::kernel::_dil_exp_reduce_sum_fusion_kernel(
+          attn_w_start, causal_len, attn_w_start, max_val);
+      torch_ipex::cpu::kernel::_dil_normalization_kernel<float>(
+          attn_w_start, max_val, causal_len, attn_w_start);
+#else
+      for (auto token_id = 0; token_id < causal_len; token_id++) {
+        attn_w_start[token_id] = attn_w_start[token_id] * scale;
+        if (alibi_slopes_ptr != nullptr) {
+          auto alibi_slope = alibi_slopes_ptr[head_id];
+          auto alibi_slopes_val = alibi_slope * (token_id + 1 - causal_len);
+          attn_w_start[token_id] = attn_w_start[token_id] + alibi_slopes_val;
+        }
+        if (attn_w_start[token_id] > max_val) {
+          max_val = attn_w_start[token_id];
+        }
+      }
+      for (auto token_id = 0; token_id < causal_len; token_id++) {
+        attn_w_start[token_id] = exp(attn_w_start[token_id] - max_val);
+        sum += attn_w_start[token_id];
+      }
+      for (auto token_id = 0; token_id < causal_len; token_id++) {
+        attn_w_start[token_id] = attn_w_start[token_id] / sum;
+      }
+#endif
+    }
+  }
+
+  auto thread_numbers = omp_get_max_threads();
+  auto private_attn_outs =
+      at::empty({thread_numbers, num_tokens, num_heads, head_size}, at::kFloat);
+  auto private_attn_out_flag =
+      at::zeros({thread_numbers, num_tokens, num_heads}, at::kByte);
+  auto flag_access = private_attn_out_flag.accessor<uint8_t, 3>();
+  auto private_attn_out_ptr = private_attn_outs.data_ptr<float>();
+  auto private_attn_out_stride = private_attn_outs.stride(0);
+// mul and accumulate
+#pragma omp parallel for collapse(3)
+  for (auto token_idx = 0; token_idx < num_tokens; token_idx++) {
+    for (auto head_id = 0; head_id < num_heads; head_id++) {
+      for (auto token_id = 0; token_id < max_context_len; token_id++) {
+        auto causal_len = causal_lens_ptr[token_idx];
+        auto thread_id = omp_get_thread_num();
+        if (token_id >= causal_len)
+          continue;
+        auto seq_id = token_to_seq_ptr[token_idx];
+        auto attn_w = attn_weights_ptr
+            [token_idx * attn_weights_stride + head_id * max_context_len +
+             token_id];
+        auto block_id = block_tables_ptr
+            [seq_id * max_num_blocks_per_seq + token_id / block_size];
+        auto block_offset = token_id % block_size;
+        auto v_cache_start = value_cache_ptr + block_id * kv_block_stride +
+            block_offset * num_kv_heads * head_size +
+            head_mapping_ptr[head_id] * head_size;
+        auto attn_out_start = private_attn_out_ptr +
+            thread_id * private_attn_out_stride +
+            (token_idx * num_heads + head_id) * head_size;
+        mul_attenion_weights_and_value_of_head<float, scalar_t>(
+            attn_w,
+            v_cache_start,
+            attn_out_start,
+            head_size,
+            flag_access[thread_id][token_idx][head_id]);
+        flag_access[thread_id][token_idx][head_id] = 1;
+      } // for token_id
+    } // for head_id
+  } // for token_idx
+  {
+    RECORD_FUNCTION(
+        "ipex::chunked_prefill_cached_kv_attention::reduction_private_result",
+        c10::ArrayRef<c10::IValue>({}));
+#pragma omp parallel for collapse(2)
+    for (auto token_idx = 0; token_idx < num_tokens; token_idx++) {
+      for (auto hi = 0; hi < num_heads; hi++) {
+        auto thr0_head_start =
+            private_attn_out_ptr + (token_idx * num_heads + hi) * head_size;
+        if (flag_access[0][token_idx][hi] == 0) {
+          torch_ipex::cpu::kernel::zero_ker(thr0_head_start, head_size);
+        }
+        for (auto thread_id = 1; thread_id < thread_numbers; thread_id++) {
+          if (flag_access[thread_id][token_idx][hi] == 0) {
+            continue;
+          }
+          auto attn_out_head_stride = thread_id * private_attn_out_stride +
+              (token_idx * num_heads + hi) * head_size;
+          auto private_attn_out_start =
+              private_attn_out_ptr + attn_out_head_stride;
+          torch_ipex::cpu::kernel::add_ker<float, float>(
+              thr0_head_start, private_attn_out_start, head_size);
+        }
+        auto out_start = out_ptr + (token_idx * num_heads + hi) * head_size;
+        torch_ipex::cpu::kernel::move_ker<scalar_t, float>(
+            out_start, thr0_head_start, head_size);
+      }
+    }
+  }
+} // chunked_prefill_cached_kv_attention_kernel
+
+/**
+ * Reshapes and caches the key and value tensors based on the provided slot
+ * mapping.
+ *
+ * @param key The input key tensor. The shape should be [num_seqs, num_heads,
+ * head_size].
+ * @param value The input value tensor.  The shape should be [num_seqs,
+ * num_heads, head_size].
+ * @param key_cache The output key cache tensor. The pre-allocated buffer to
+ * store the key cache. The shape should be [num_blocks, block_size, num_heads,
+ * head_size].
+ * @param value_cache The output value cache tensor. The pre-allocated buffer to
+ * store the value cache. The shape should be [num_blocks, block_size,
+ * num_heads, head_size].
+ * @param slot_mapping The slot mapping tensor. It stores the position to store
+ * the key/value in the pre-allocated buffers. The shape should be the number of
+ * sequences. For sequence i, the slot_mapping[i]//block_number can get the
+ * block index, and the slot_mapping%block_size can get the offset of this
+ * block.
+ *
+ * @tparam DST_T The data type of the output tensors.
+ * @tparam SRC_T The data type of the input tensors.
+ * @tparam HEAD_BLOCKED Selects the [num_blocks, num_heads, block_size,
+ * head_size] head-major cache layout instead of the default token-major one.
+ */
+template <typename DST_T, typename SRC_T, bool HEAD_BLOCKED = false>
+void reshape_and_cache_kernel(
+    at::Tensor& key,
+    at::Tensor& value,
+    at::Tensor& key_cache,
+    at::Tensor& value_cache,
+    at::Tensor& slot_mapping) {
+  auto num_tokens = key.size(0);
+  auto head_num = key.size(1);
+  auto head_size = key.size(2);
+  auto block_size = HEAD_BLOCKED ? key_cache.size(2) : key_cache.size(1);
+  auto hidden_size = head_num * head_size;
+  auto key_cache_ptr = key_cache.data_ptr<DST_T>();
+  auto key_ptr = key.data_ptr<SRC_T>();
+  auto value_cache_ptr = value_cache.data_ptr<DST_T>();
+  auto value_ptr = value.data_ptr<SRC_T>();
+  auto slot_mapping_ptr = slot_mapping.data_ptr<int>();
+  auto cache_stride = key_cache.stride(0);
+  auto state_stride = key.stride(0);
+#pragma omp parallel for collapse(2)
+  for (auto ti = 0; ti < num_tokens; ti++) {
+    for (auto hi = 0; hi < head_num; hi++) {
+      auto block_id = slot_mapping_ptr[ti] / block_size;
+      auto block_offset = slot_mapping_ptr[ti] % block_size;
+      auto cache_offset = HEAD_BLOCKED
+          ? block_id * cache_stride + hi * block_size * head_size +
+              block_offset * head_size
+          : block_id * cache_stride + block_offset * key_cache.stride(1) +
+              hi * head_size;
+      auto state_offset = ti * state_stride + hi * head_size;
+      auto key_cache_start = key_cache_ptr + cache_offset;
+      auto key_ptr_start = key_ptr + state_offset;
+      auto value_cache_start = value_cache_ptr + cache_offset;
+      auto value_ptr_start = value_ptr + state_offset;
+      torch_ipex::cpu::kernel::move_ker<DST_T, SRC_T>(
+          key_cache_start, key_ptr_start, head_size);
+      torch_ipex::cpu::kernel::move_ker<DST_T, SRC_T>(
+          value_cache_start, value_ptr_start, head_size);
+    }
+  }
+}
+
+/**
+ * Int8 variant of reshape_and_cache: quantizes every key/value head row on
+ * write with one symmetric scale per token/head entry, stored alongside the
+ * block in k_scale/v_scale with the layout [num_blocks, block_size,
+ * num_heads]. Halves the cache footprint and memory bandwidth per decode
+ * step compared with a BF16 cache.
+ */
+template <typename SRC_T>
+void reshape_and_cache_int8_kernel(
+    at::Tensor& key,
+    at::Tensor& value,
+    at::Tensor& key_cache,
+    at::Tensor& value_cache,
+    at::Tensor& k_scale,
+    at::Tensor& v_scale,
+    at::Tensor& slot_mapping) {
+  auto num_tokens = key.size(0);
+  auto head_num = key.size(1);
+  auto head_size = key.size(2);
+  auto block_size = key_cache.size(1);
+  auto key_cache_ptr = key_cache.data_ptr<int8_t>();
+  auto key_ptr = key.data_ptr<SRC_T>();
+  auto value_cache_ptr = value_cache.data_ptr<int8_t>();
+  auto value_ptr = value.data_ptr<SRC_T>();
+  auto k_scale_ptr = k_scale.data_ptr<float>();
+  auto v_scale_ptr = v_scale.data_ptr<float>();
+  auto slot_mapping_ptr = slot_mapping.data_ptr<int>();
+  auto cache_stride = key_cache.stride(0);
+  auto state_stride = key.stride(0);
+#pragma omp parallel for collapse(2)
+  for (auto ti = 0; ti < num_tokens; ti++) {
+    for (auto hi = 0; hi < head_num; hi++) {
+      auto block_id = slot_mapping_ptr[ti] / block_size;
+      auto block_offset = slot_mapping_ptr[ti] % block_size;
+      auto cache_offset = block_id * cache_stride +
+          block_offset * key_cache.stride(1) + hi * head_size;
+      auto scale_offset =
+          block_id * block_size * head_num + block_offset * head_num + hi;
+      auto state_offset = ti * state_stride + hi * head_size;
+      auto key_ptr_start = key_ptr + state_offset;
+      auto value_ptr_start = value_ptr + state_offset;
+      float k_absmax = 0.0f;
+      float v_absmax = 0.0f;
+      for (auto hsi = 0; hsi < head_size; hsi++) {
+        k_absmax = std::max(k_absmax, std::abs((float)key_ptr_start[hsi]));
+        v_absmax = std::max(v_absmax, std::abs((float)value_ptr_start[hsi]));
+      }
+      auto k_quant_scale = k_absmax == 0.0f ? 1.0f : k_absmax / 127.0f;
+      auto v_quant_scale = v_absmax == 0.0f ? 1.0f : v_absmax / 127.0f;
+      k_scale_ptr[scale_offset] = k_quant_scale;
+      v_scale_ptr[scale_offset] = v_quant_scale;
+      auto key_cache_start = key_cache_ptr + cache_offset;
+      auto value_cache_start = value_cache_ptr + cache_offset;
+      for (auto hsi = 0; hsi < head_size; hsi++) {
+        key_cache_start[hsi] = static_cast<int8_t>(
+            std::nearbyint((float)key_ptr_start[hsi] / k_quant_scale));
+        value_cache_start[hsi] = static_cast<int8_t>(
+            std::nearbyint((float)value_ptr_start[hsi] / v_quant_scale));
+      }
+    }
+  }
+}
+
+void single_query_cached_kv_attention_kernel_impl(
+    at::Tensor& out, // [num_seqs, num_heads, head_size]
+    at::Tensor& query, // [num_seqs, num_heads, head_size]
+    at::Tensor& key_cache, // [num_blocks,  block_size, num_heads, head_size]
+    at::Tensor& value_cache, // [num_blocks,  block_size, num_heads, head_size]
+    at::Tensor& head_mapping, // [num_heads]
+    const double scale,
+    at::Tensor& block_tables, // [num_seqs, max_num_blocks_per_seq]
+    at::Tensor& context_lens, // [num_seqs]
+    int64_t block_size,
+    int64_t max_context_len,
+    const c10::optional<at::Tensor>& alibi_slopes) {
+  RECORD_FUNCTION(
+      "ipex::single_query_cached_kv_attention_kernel_impl",
+      c10::ArrayRef<c10::IValue>({}));
+  IPEX_HOT_TRACE_SCOPE("aten::single_query_cached_kv_attention_kernel");
+  // dispatch kernel according to the data type of input tensor
+  if (out.scalar_type() == at::ScalarType::Float) {
+    single_query_cached_kv_attention_kernel<float>(
+        out,
+        query,
+        key_cache,
+        value_cache,
+        head_mapping,
+        scale,
+        block_tables,
+        context_lens,
+        block_size,
+        max_context_len,
+        alibi_slopes);
+  } else if (out.scalar_type() == at::ScalarType::BFloat16) {
+    single_query_cached_kv_attention_kernel<at::BFloat16>(
+        out,
+        query,
+        key_cache,
+        value_cache,
+        head_mapping,
+        scale,
+        block_tables,
+        context_lens,
+        block_size,
+        max_context_len,
+        alibi_slopes);
+  } else {
+    TORCH_CHECK(
+        false, "Unsupported data type for single_query_cached_kv_attention");
+  }
+}
+
+// T5-style decode: a learned relative-position bias tile, pre-tiled at
+// cache setup as [num_heads, max_context_len] fp32 and indexed by the
+// key token's distance from the current query token, is streamed into
+// the attention weights alongside the K pass.
+void single_query_cached_kv_attention_bias_kernel_impl(
+    at::Tensor& out, // [num_seqs, num_heads, head_size]
+    at::Tensor& query, // [num_seqs, num_heads, head_size]
+    at::Tensor& key_cache, // [num_blocks,  block_size, num_heads, head_size]
+    at::Tensor& value_cache, // [num_blocks,  block_size, num_heads, head_size]
+    at::Tensor& head_mapping, // [num_heads]
+    const double scale,
+    at::Tensor& block_tables, // [num_seqs, max_num_blocks_per_seq]
+    at::Tensor& context_lens, // [num_seqs]
+    int64_t block_size,
+    int64_t max_context_len,
+    const at::Tensor& attn_bias) { // [num_heads, max_context_len]
+  RECORD_FUNCTION(
+      "ipex::single_query_cached_kv_attention_bias_kernel_impl",
+      c10::ArrayRef<c10::IValue>({}));
+  TORCH_CHECK(
+      attn_bias.scalar_type() == at::kFloat && attn_bias.dim() == 2 &&
+          attn_bias.is_contiguous(),
+      "single_query_cached_kv_attention_bias: expect a contiguous 2-d fp32 bias tile");
+  TORCH_CHECK(
+      attn_bias.size(0) == query.size(1) &&
+          attn_bias.size(1) >= max_context_len,
+      "single_query_cached_kv_attention_bias: expect bias of shape [num_heads, >= max_context_len]");
+  auto attn_bias_ptr = attn_bias.data_ptr<float>();
+  auto attn_bias_stride = attn_bias.stride(0);
+  if (out.scalar_type() == at::ScalarType::Float) {
+    single_query_cached_kv_attention_kernel<float>(
+        out,
+        query,
+        key_cache,
+        value_cache,
+        head_mapping,
+        scale,
+        block_tables,
+        context_lens,
+        block_size,
+        max_context_len,
+        c10::nullopt,
+        nullptr,
+        nullptr,
+        attn_bias_ptr,
+        attn_bias_stride);
+  } else if (out.scalar_type() == at::ScalarType::BFloat16) {
+    single_query_cached_kv_attention_kernel<at::BFloat16>(
+        out,
+        query,
+        key_cache,
+        value_cache,
+        head_mapping,
+        scale,
+        block_tables,
+        context_lens,
+        block_size,
+        max_context_len,
+        c10::nullopt,
+        nullptr,
+        nullptr,
+        attn_bias_ptr,
+        attn_bias_stride);
+  } else {
+    TORCH_CHECK(
+        false,
+        "Unsupported data type for single_query_cached_kv_attention_bias");
+  }
+}
+
+// Speculative decoding verification: q_len draft tokens per sequence are
+// verified in one call instead of q_len single-query calls.
+void multi_query_cached_kv_attention_kernel_impl(
+    at::Tensor& out, // [num_seqs, q_len, num_heads, head_size]
+    at::Tensor& query, // [num_seqs, q_len, num_heads, head_size]
+    at::Tensor& key_cache, // [num_blocks,  block_size, num_heads, head_size]
+    at::Tensor& value_cache, // [num_blocks,  block_size, num_heads, head_size]
+    at::Tensor& head_mapping, // [num_heads]
+    const double scale,
+    at::Tensor& block_tables, // [num_seqs, max_num_blocks_per_seq]
+    at::Tensor& context_lens, // [num_seqs]
+    int64_t block_size,
+    int64_t max_context_len,
+    const c10::optional<at::Tensor>& alibi_slopes) {
+  TORCH_CHECK(
+      query.dim() == 4 && out.dim() == 4,
+      "multi_query_cached_kv_attention expects query/out of shape [num_seqs, q_len, num_heads, head_size]");
+  TORCH_CHECK(
+      query.size(1) <= max_context_len,
+      "multi_query_cached_kv_attention expects the draft tokens to be part of the cached context");
+  RECORD_FUNCTION(
+      "ipex::multi_query_cached_kv_attention_kernel_impl",
+      c10::ArrayRef<c10::IValue>({}));
+  if (out.scalar_type() == at::ScalarType::Float) {
+    multi_query_cached_kv_attention_kernel<float>(
+        out,
+        query,
+        key_cache,
+        value_cache,
+        head_mapping,
+        scale,
+        block_tables,
+        context_lens,
+        block_size,
+        max_context_len,
+        alibi_slopes);
+  } else if (out.scalar_type() == at::ScalarType::BFloat16) {
+    multi_query_cached_kv_attention_kernel<at::BFloat16>(
+        out,
+        query,
+        key_cache,
+        value_cache,
+        head_mapping,
+        scale,
+        block_tables,
         context_lens,
         block_size,
         max_context_len,
         alibi_slopes);
   } else {
     TORCH_CHECK(
-        false, "Unsupported data type for single_query_cached_kv_attention");
+        false, "Unsupported data type for multi_query_cached_kv_attention");
+  }
+}
+
+// Head-blocked cache layout: one head's keys/values within a block are
+// contiguous, so per-head decode reads become full cache-line streams.
+void single_query_cached_kv_attention_head_blocked_kernel_impl(
+    at::Tensor& out, // [num_seqs, num_heads, head_size]
+    at::Tensor& query, // [num_seqs, num_heads, head_size]
+    at::Tensor& key_cache, // [num_blocks, num_heads, block_size, head_size]
+    at::Tensor& value_cache, // [num_blocks, num_heads, block_size, head_size]
+    at::Tensor& head_mapping, // [num_heads]
+    const double scale,
+    at::Tensor& block_tables, // [num_seqs, max_num_blocks_per_seq]
+    at::Tensor& context_lens, // [num_seqs]
+    int64_t block_size,
+    int64_t max_context_len,
+    const c10::optional<at::Tensor>& alibi_slopes) {
+  RECORD_FUNCTION(
+      "ipex::single_query_cached_kv_attention_head_blocked_kernel_impl",
+      c10::ArrayRef<c10::IValue>({}));
+  TORCH_CHECK(
+      key_cache.size(2) == block_size,
+      "head-blocked cache expects the [num_blocks, num_heads, block_size, head_size] layout");
+  if (out.scalar_type() == at::ScalarType::Float) {
+    single_query_cached_kv_attention_kernel<float, float, true>(
+        out,
+        query,
+        key_cache,
+        value_cache,
+        head_mapping,
+        scale,
+        block_tables,
+        context_lens,
+        block_size,
+        max_context_len,
+        alibi_slopes);
+  } else if (out.scalar_type() == at::ScalarType::BFloat16) {
+    single_query_cached_kv_attention_kernel<at::BFloat16, at::BFloat16, true>(
+        out,
+        query,
+        key_cache,
+        value_cache,
+        head_mapping,
+        scale,
+        block_tables,
+        context_lens,
+        block_size,
+        max_context_len,
+        alibi_slopes);
+  } else {
+    TORCH_CHECK(
+        false,
+        "Unsupported data type for single_query_cached_kv_attention_head_blocked");
+  }
+}
+
+void shared_prefix_cached_kv_attention_kernel_impl(
+    at::Tensor& out, // [num_seqs, num_heads, head_size]
+    at::Tensor& query, // [num_seqs, num_heads, head_size]
+    at::Tensor& key_cache, // [num_blocks,  block_size, num_heads, head_size]
+    at::Tensor& value_cache, // [num_blocks,  block_size, num_heads, head_size]
+    at::Tensor& head_mapping, // [num_heads]
+    const double scale,
+    at::Tensor& block_tables, // [num_seqs, max_num_blocks_per_seq]
+    at::Tensor& context_lens, // [num_seqs]
+    int64_t block_size,
+    int64_t max_context_len,
+    const c10::optional<at::Tensor>& alibi_slopes,
+    int64_t prefix_len) {
+  RECORD_FUNCTION(
+      "ipex::shared_prefix_cached_kv_attention_kernel_impl",
+      c10::ArrayRef<c10::IValue>({}));
+  auto context_lens_ptr = context_lens.data_ptr<int>();
+  for (auto seq_id = 0; seq_id < context_lens.size(0); seq_id++) {
+    TORCH_CHECK(
+        prefix_len <= context_lens_ptr[seq_id],
+        "prefix_len must not exceed any sequence's context length");
+  }
+  // dispatch kernel according to the data type of input tensor
+  if (out.scalar_type() == at::ScalarType::Float) {
+    shared_prefix_cached_kv_attention_kernel<float>(
+        out,
+        query,
+        key_cache,
+        value_cache,
+        head_mapping,
+        scale,
+        block_tables,
+        context_lens,
+        block_size,
+        max_context_len,
+        alibi_slopes,
+        prefix_len);
+  } else if (out.scalar_type() == at::ScalarType::BFloat16) {
+    shared_prefix_cached_kv_attention_kernel<at::BFloat16>(
+        out,
+        query,
+        key_cache,
+        value_cache,
+        head_mapping,
+        scale,
+        block_tables,
+        context_lens,
+        block_size,
+        max_context_len,
+        alibi_slopes,
+        prefix_len);
+  } else {
+    TORCH_CHECK(
+        false, "Unsupported data type for shared_prefix_cached_kv_attention");
+  }
+}
+
+void single_query_cached_kv_attention_int8_kernel_impl(
+    at::Tensor& out, // [num_seqs, num_heads, head_size]
+    at::Tensor& query, // [num_seqs, num_heads, head_size]
+    at::Tensor& key_cache, // [num_blocks,  block_size, num_heads, head_size]
+    at::Tensor& value_cache, // [num_blocks,  block_size, num_heads, head_size]
+    at::Tensor& head_mapping, // [num_heads]
+    const double scale,
+    at::Tensor& block_tables, // [num_seqs, max_num_blocks_per_seq]
+    at::Tensor& context_lens, // [num_seqs]
+    int64_t block_size,
+    int64_t max_context_len,
+    const c10::optional<at::Tensor>& alibi_slopes,
+    at::Tensor& k_scale, // [num_blocks, block_size, num_heads]
+    at::Tensor& v_scale) { // [num_blocks, block_size, num_heads]
+  RECORD_FUNCTION(
+      "ipex::single_query_cached_kv_attention_int8_kernel_impl",
+      c10::ArrayRef<c10::IValue>({}));
+  TORCH_CHECK(
+      key_cache.scalar_type() == at::ScalarType::Char &&
+          value_cache.scalar_type() == at::ScalarType::Char,
+      "int8 single_query_cached_kv_attention expects an int8 KV cache");
+  auto k_scale_ptr = k_scale.data_ptr<float>();
+  auto v_scale_ptr = v_scale.data_ptr<float>();
+  if (out.scalar_type() == at::ScalarType::Float) {
+    single_query_cached_kv_attention_kernel<float, int8_t>(
+        out,
+        query,
+        key_cache,
+        value_cache,
+        head_mapping,
+        scale,
+        block_tables,
+        context_lens,
+        block_size,
+        max_context_len,
+        alibi_slopes,
+        k_scale_ptr,
+        v_scale_ptr);
+  } else if (out.scalar_type() == at::ScalarType::BFloat16) {
+    single_query_cached_kv_attention_kernel<at::BFloat16, int8_t>(
+        out,
+        query,
+        key_cache,
+        value_cache,
+        head_mapping,
+        scale,
+        block_tables,
+        context_lens,
+        block_size,
+        max_context_len,
+        alibi_slopes,
+        k_scale_ptr,
+        v_scale_ptr);
+  } else {
+    TORCH_CHECK(
+        false,
+        "Unsupported data type for single_query_cached_kv_attention_int8");
+  }
+}
+
+void chunked_prefill_cached_kv_attention_kernel_impl(
+    at::Tensor& out, // [num_tokens, num_heads, head_size]
+    at::Tensor& query, // [num_tokens, num_heads, head_size]
+    at::Tensor& key_cache, // [num_blocks,  block_size, num_heads, head_size]
+    at::Tensor& value_cache, // [num_blocks,  block_size, num_heads, head_size]
+    at::Tensor& head_mapping, // [num_heads]
+    const double scale,
+    at::Tensor& block_tables, // [num_seqs, max_num_blocks_per_seq]
+    at::Tensor& context_lens, // [num_seqs]
+    at::Tensor& query_start_loc, // [num_seqs + 1]
+    int64_t block_size,
+    int64_t max_context_len,
+    const c10::optional<at::Tensor>& alibi_slopes) {
+  RECORD_FUNCTION(
+      "ipex::chunked_prefill_cached_kv_attention_kernel_impl",
+      c10::ArrayRef<c10::IValue>({}));
+  TORCH_CHECK(
+      query_start_loc.size(0) == context_lens.size(0) + 1,
+      "query_start_loc should have num_seqs + 1 elements");
+  // dispatch kernel according to the data type of input tensor
+  if (out.scalar_type() == at::ScalarType::Float) {
+    chunked_prefill_cached_kv_attention_kernel<float>(
+        out,
+        query,
+        key_cache,
+        value_cache,
+        head_mapping,
+        scale,
+        block_tables,
+        context_lens,
+        query_start_loc,
+        block_size,
+        max_context_len,
+        alibi_slopes);
+  } else if (out.scalar_type() == at::ScalarType::BFloat16) {
+    chunked_prefill_cached_kv_attention_kernel<at::BFloat16>(
+        out,
+        query,
+        key_cache,
+        value_cache,
+        head_mapping,
+        scale,
+        block_tables,
+        context_lens,
+        query_start_loc,
+        block_size,
+        max_context_len,
+        alibi_slopes);
+  } else {
+    TORCH_CHECK(
+        false, "Unsupported data type for chunked_prefill_cached_kv_attention");
   }
 }
 
@@ -426,14 +1947,169 @@ void reshape_and_cache_cpu_kernel_impl(
   }
 }
 
+void reshape_and_cache_head_blocked_cpu_kernel_impl(
+    at::Tensor& key,
+    at::Tensor& value,
+    at::Tensor& key_cache, // [num_blocks, num_heads, block_size, head_size]
+    at::Tensor& value_cache, // [num_blocks, num_heads, block_size, head_size]
+    at::Tensor& slot_mapping) {
+  TORCH_CHECK(
+      key.scalar_type() == value.scalar_type(),
+      "key and value should have the same data type");
+  TORCH_CHECK(
+      key_cache.scalar_type() == value_cache.scalar_type(),
+      "key_cache and value_cache should have the same data type");
+  TORCH_CHECK(key_cache.is_contiguous(), "key_cache should be contiguous");
+  TORCH_CHECK(value_cache.is_contiguous(), "value_cache should be contiguous");
+  TORCH_CHECK(
+      slot_mapping.is_contiguous(), "slot_mapping should be contiguous");
+  TORCH_CHECK(
+      key_cache.size(1) == key.size(1),
+      "head-blocked cache expects the [num_blocks, num_heads, block_size, head_size] layout");
+  RECORD_FUNCTION(
+      "ipex::reshape_and_cache_head_blocked_cpu_kernel_impl",
+      c10::ArrayRef<c10::IValue>({}));
+  if (key.scalar_type() == at::ScalarType::Float) {
+    reshape_and_cache_kernel<float, float, true>(
+        key, value, key_cache, value_cache, slot_mapping);
+  } else if (key.scalar_type() == at::ScalarType::BFloat16) {
+    reshape_and_cache_kernel<at::BFloat16, at::BFloat16, true>(
+        key, value, key_cache, value_cache, slot_mapping);
+  } else {
+    TORCH_CHECK(
+        false,
+        "Unsupported data type for ipex::reshape_and_cache_head_blocked");
+  }
+}
+
+void reshape_and_cache_int8_cpu_kernel_impl(
+    at::Tensor& key,
+    at::Tensor& value,
+    at::Tensor& key_cache,
+    at::Tensor& value_cache,
+    at::Tensor& k_scale,
+    at::Tensor& v_scale,
+    at::Tensor& slot_mapping) {
+  TORCH_CHECK(
+      key.scalar_type() == value.scalar_type(),
+      "key and value should have the same data type");
+  TORCH_CHECK(
+      key_cache.scalar_type() == at::ScalarType::Char &&
+          value_cache.scalar_type() == at::ScalarType::Char,
+      "reshape_and_cache_int8 expects an int8 KV cache");
+  TORCH_CHECK(key_cache.is_contiguous(), "key_cache should be contiguous");
+  TORCH_CHECK(value_cache.is_contiguous(), "value_cache should be contiguous");
+  TORCH_CHECK(
+      slot_mapping.is_contiguous(), "slot_mapping should be contiguous");
+  RECORD_FUNCTION(
+      "ipex::reshape_and_cache_int8_cpu_kernel_impl",
+      c10::ArrayRef<c10::IValue>({}));
+  if (key.scalar_type() == at::ScalarType::Float) {
+    reshape_and_cache_int8_kernel<float>(
+        key, value, key_cache, value_cache, k_scale, v_scale, slot_mapping);
+  } else if (key.scalar_type() == at::ScalarType::BFloat16) {
+    reshape_and_cache_int8_kernel<at::BFloat16>(
+        key, value, key_cache, value_cache, k_scale, v_scale, slot_mapping);
+  } else {
+    TORCH_CHECK(
+        false, "Unsupported data type for ipex::reshape_and_cache_int8");
+  }
+}
+
+/**
+ * StreamingLLM eviction over the paged KV cache. Per sequence, keep the
+ * first sink_blocks blocks plus the newest window_blocks blocks; the oldest
+ * block after the sinks is dropped (whole blocks only, so the partially
+ * filled tail block always stays inside the window). Only block_tables and
+ * context_lens are rewritten - no cache data moves - and the attention
+ * kernels keep reading the retained tokens through the compacted table.
+ *
+ * @param block_tables  [num_seqs, max_num_blocks_per_seq]
+ * @param context_lens  [num_seqs]
+ * @return freed physical block ids [num_seqs, max_evicted], padded with -1,
+ *         for the block manager to recycle.
+ */
+at::Tensor streaming_llm_cache_evict_kernel_impl(
+    at::Tensor& block_tables,
+    at::Tensor& context_lens,
+    int64_t block_size,
+    int64_t sink_blocks,
+    int64_t window_blocks) {
+  TORCH_CHECK(
+      sink_blocks >= 0 && window_blocks > 0,
+      "streaming_llm_cache_evict expects sink_blocks >= 0 and window_blocks > 0");
+  TORCH_CHECK(
+      block_tables.is_contiguous() && context_lens.is_contiguous(),
+      "block_tables and context_lens should be contiguous");
+  RECORD_FUNCTION(
+      "ipex::streaming_llm_cache_evict_kernel_impl",
+      c10::ArrayRef<c10::IValue>({}));
+  auto num_seqs = block_tables.size(0);
+  auto max_num_blocks_per_seq = block_tables.size(1);
+  auto budget = sink_blocks + window_blocks;
+  auto max_evicted = max_num_blocks_per_seq > budget
+      ? max_num_blocks_per_seq - budget
+      : static_cast<int64_t>(1);
+  auto freed_blocks =
+      at::full({num_seqs, max_evicted}, -1, block_tables.options());
+  auto block_tables_ptr = block_tables.data_ptr<int>();
+  auto context_lens_ptr = context_lens.data_ptr<int>();
+  auto freed_blocks_ptr = freed_blocks.data_ptr<int>();
+#pragma omp parallel for
+  for (auto seq_id = 0; seq_id < num_seqs; seq_id++) {
+    auto table = block_tables_ptr + seq_id * max_num_blocks_per_seq;
+    auto num_blocks =
+        (context_lens_ptr[seq_id] + block_size - 1) / block_size;
+    auto freed = freed_blocks_ptr + seq_id * max_evicted;
+    auto freed_count = 0;
+    while (num_blocks > budget) {
+      freed[freed_count++] = table[sink_blocks];
+      for (auto bi = sink_blocks; bi < num_blocks - 1; bi++) {
+        table[bi] = table[bi + 1];
+      }
+      table[num_blocks - 1] = -1;
+      num_blocks--;
+      context_lens_ptr[seq_id] -= block_size;
+    }
+  }
+  return freed_blocks;
+}
+
 } // namespace
 
 IPEX_REGISTER_DISPATCH(
     single_query_cached_kv_attention_kernel_stub,
     &single_query_cached_kv_attention_kernel_impl);
+IPEX_REGISTER_DISPATCH(
+    single_query_cached_kv_attention_bias_kernel_stub,
+    &single_query_cached_kv_attention_bias_kernel_impl);
+IPEX_REGISTER_DISPATCH(
+    shared_prefix_cached_kv_attention_kernel_stub,
+    &shared_prefix_cached_kv_attention_kernel_impl);
+IPEX_REGISTER_DISPATCH(
+    single_query_cached_kv_attention_int8_kernel_stub,
+    &single_query_cached_kv_attention_int8_kernel_impl);
+IPEX_REGISTER_DISPATCH(
+    reshape_and_cache_int8_kernel_stub,
+    &reshape_and_cache_int8_cpu_kernel_impl);
+IPEX_REGISTER_DISPATCH(
+    chunked_prefill_cached_kv_attention_kernel_stub,
+    &chunked_prefill_cached_kv_attention_kernel_impl);
 IPEX_REGISTER_DISPATCH(
     reshape_and_cache_kernel_stub,
     &reshape_and_cache_cpu_kernel_impl);
+IPEX_REGISTER_DISPATCH(
+    single_query_cached_kv_attention_head_blocked_kernel_stub,
+    &single_query_cached_kv_attention_head_blocked_kernel_impl);
+IPEX_REGISTER_DISPATCH(
+    reshape_and_cache_head_blocked_kernel_stub,
+    &reshape_and_cache_head_blocked_cpu_kernel_impl);
+IPEX_REGISTER_DISPATCH(
+    streaming_llm_cache_evict_kernel_stub,
+    &streaming_llm_cache_evict_kernel_impl);
+IPEX_REGISTER_DISPATCH(
+    multi_query_cached_kv_attention_kernel_stub,
+    &multi_query_cached_kv_attention_kernel_impl);
 
 } // namespace cpu
 } // namespace torch_ipex
@@ -32,6 +32,157 @@ void RMSNormKernelImpl(
 }
 #endif
 
+#if defined(CPU_CAPABILITY_AVX512)
+template <typename T, typename T1, typename Tq>
+void RMSNormQuantKernelImpl(
+    const at::Tensor& a,
+    const at::Tensor& gamma,
+    const float* smooth_data,
+    int64_t M,
+    int64_t N,
+    float eps,
+    float inv_scale,
+    int32_t zero_point,
+    float qmin,
+    float qmax,
+    Tq* Y_data) {
+  DCHECK(a.numel() == M * N);
+  const T* a_data = a.data_ptr<T>();
+  const T1* gamma_data = gamma.defined() ? gamma.data_ptr<T1>() : nullptr;
+  at::parallel_for(0, M, 1, [&](int64_t start, int64_t end) {
+    for (const auto i : c10::irange(start, end)) {
+      const T* a_ptr = a_data + i * N;
+      Tq* Y_ptr = Y_data + i * N;
+      kernel::_compute_rmsnorm_quant<T, T1, Tq>(
+          a_ptr,
+          N,
+          eps,
+          gamma_data,
+          smooth_data,
+          inv_scale,
+          zero_point,
+          qmin,
+          qmax,
+          Y_ptr);
+    }
+  });
+}
+
+template <typename T, typename T1>
+void RMSNormQuantDispatch(
+    const at::Tensor& a,
+    const at::Tensor& gamma,
+    const float* smooth_data,
+    int64_t M,
+    int64_t N,
+    float eps,
+    float inv_scale,
+    int32_t zero_point,
+    at::ScalarType o_dtype,
+    at::Tensor& Y) {
+  if (o_dtype == at::ScalarType::QInt8) {
+    RMSNormQuantKernelImpl<T, T1, int8_t>(
+        a,
+        gamma,
+        smooth_data,
+        M,
+        N,
+        eps,
+        inv_scale,
+        zero_point,
+        -128.f,
+        127.f,
+        reinterpret_cast<int8_t*>(Y.data_ptr<c10::qint8>()));
+  } else {
+    RMSNormQuantKernelImpl<T, T1, uint8_t>(
+        a,
+        gamma,
+        smooth_data,
+        M,
+        N,
+        eps,
+        inv_scale,
+        zero_point,
+        0.f,
+        255.f,
+        reinterpret_cast<uint8_t*>(Y.data_ptr<c10::quint8>()));
+  }
+}
+#endif
+
+at::Tensor rmsnorm_quant_kernel_impl(
+    const at::Tensor& input,
+    const at::Tensor& b,
+    float eps,
+    const c10::optional<at::Tensor>& smooth,
+    double o_scale,
+    int64_t o_zp,
+    at::ScalarType o_dtype) {
+  TORCH_CHECK(
+      o_dtype == at::ScalarType::QInt8 || o_dtype == at::ScalarType::QUInt8,
+      "rmsnorm_quant: only qint8 and quint8 outputs are supported");
+  const auto input_shape = input.sizes();
+  const auto input_ndim = input.dim();
+  const int axis = input_ndim - 1;
+  const int64_t M =
+      c10::multiply_integers(input_shape.cbegin(), input_shape.cbegin() + axis);
+  const int64_t N =
+      c10::multiply_integers(input_shape.cbegin() + axis, input_shape.cend());
+  auto X = input.contiguous();
+  at::Tensor smooth_f;
+  const float* smooth_data = nullptr;
+  if (smooth.has_value() && smooth.value().defined()) {
+    smooth_f = smooth.value().to(at::kFloat).contiguous();
+    TORCH_CHECK(
+        smooth_f.numel() == N,
+        "rmsnorm_quant: smoothing factors must have one entry per channel");
+    smooth_data = smooth_f.data_ptr<float>();
+  }
+#if defined(CPU_CAPABILITY_AVX512)
+  at::Tensor Y = at::_empty_affine_quantized(
+      input_shape,
+      input.options().dtype(o_dtype),
+      o_scale,
+      o_zp,
+      at::MemoryFormat::Contiguous);
+  float inv_scale = 1.0f / static_cast<float>(o_scale);
+  int32_t zero_point = static_cast<int32_t>(o_zp);
+  if (input.scalar_type() == at::ScalarType::Float) {
+    RMSNormQuantDispatch<float, float>(
+        X, b, smooth_data, M, N, eps, inv_scale, zero_point, o_dtype, Y);
+  } else if (
+      input.scalar_type() == at::ScalarType::BFloat16 &&
+      b.scalar_type() == at::ScalarType::Float) {
+    RMSNormQuantDispatch<at::BFloat16, float>(
+        X, b, smooth_data, M, N, eps, inv_scale, zero_point, o_dtype, Y);
+  } else if (
+      input.scalar_type() == at::ScalarType::BFloat16 &&
+      b.scalar_type() == at::ScalarType::BFloat16) {
+    RMSNormQuantDispatch<at::BFloat16, at::BFloat16>(
+        X, b, smooth_data, M, N, eps, inv_scale, zero_point, o_dtype, Y);
+  } else if (
+      input.scalar_type() == at::ScalarType::Half &&
+      b.scalar_type() == at::ScalarType::Float) {
+    RMSNormQuantDispatch<at::Half, float>(
+        X, b, smooth_data, M, N, eps, inv_scale, zero_point, o_dtype, Y);
+  } else if (
+      input.scalar_type() == at::ScalarType::Half &&
+      b.scalar_type() == at::ScalarType::Half) {
+    RMSNormQuantDispatch<at::Half, at::Half>(
+        X, b, smooth_data, M, N, eps, inv_scale, zero_point, o_dtype, Y);
+  } else {
+    TORCH_CHECK(false, "Unsupported input type");
+  }
+  return Y;
+#else
+  auto normed = rmsnorm_kernel_impl(X, b, eps).to(at::kFloat);
+  if (smooth_data) {
+    normed = at::mul(normed, smooth_f);
+  }
+  return at::quantize_per_tensor(normed, o_scale, o_zp, o_dtype);
+#endif
+}
+
 at::Tensor rmsnorm_kernel_impl(
     const at::Tensor& input,
     const at::Tensor& b,
@@ -62,6 +213,14 @@ at::Tensor rmsnorm_kernel_impl(
       input.scalar_type() == at::ScalarType::BFloat16 &&
       b.scalar_type() == at::ScalarType::BFloat16) {
     RMSNormKernelImpl<at::BFloat16, at::BFloat16>(X, b, M, N, eps, Y);
+  } else if (
+      input.scalar_type() == at::ScalarType::Half &&
+      b.scalar_type() == at::ScalarType::Float) {
+    RMSNormKernelImpl<at::Half, float>(X, b, M, N, eps, Y);
+  } else if (
+      input.scalar_type() == at::ScalarType::Half &&
+      b.scalar_type() == at::ScalarType::Half) {
+    RMSNormKernelImpl<at::Half, at::Half>(X, b, M, N, eps, Y);
   } else {
     TORCH_CHECK(false, "Unsupported input type");
   }
@@ -77,5 +236,6 @@ at::Tensor rmsnorm_kernel_impl(
 } // namespace
 
 IPEX_REGISTER_DISPATCH(rmsnorm_kernel_stub, &rmsnorm_kernel_impl);
+IPEX_REGISTER_DISPATCH(rmsnorm_quant_kernel_stub, &rmsnorm_quant_kernel_impl);
 } // namespace cpu
 } // namespace torch_ipex
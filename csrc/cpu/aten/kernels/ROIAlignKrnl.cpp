@@ -182,30 +182,37 @@ inline void roi_align_single_framework_channels_last_forward(
     int64_t roi_bin_grid_w,
     const std::vector<PreCalc<ACC_T>>& pre_calc,
     T* output) {
-  // for 'normal' size of channels, should be L1 fit;
-  // otherwise consider blocking on channels.
   using Vec = at::vec::Vectorized<T>;
 
-  int64_t pre_calc_index = 0;
+  // Block the channel dimension so the output lane and the four input rows
+  // of a sampling point stay L1-resident even for large channel counts; each
+  // block runs all three passes before moving on.
+  constexpr int64_t BLOCK_C = 1024;
+  const int64_t grid_size = roi_bin_grid_h * roi_bin_grid_w;
+
   for (int64_t ph = 0; ph < pooled_height; ph++) {
     for (int64_t pw = 0; pw < pooled_width; pw++) {
       T* out = output + (ph * pooled_width + pw) * channels;
+      const int64_t pre_calc_base = (ph * pooled_width + pw) * grid_size;
 
-      // pass I: zero the out lane
-      int64_t d1 = 0;
-      for (; d1 < channels - (channels % Vec::size()); d1 += Vec::size()) {
-        Vec out_vec = Vec(T(0));
-        out_vec.store(out + d1);
-      }
-      // TODO: optimize with masked intrinsics.
-      for (; d1 < channels; d1++) {
-        out[d1] = T(0);
-      }
+      for (int64_t cb = 0; cb < channels; cb += BLOCK_C) {
+        int64_t cend = std::min(cb + BLOCK_C, channels);
+        int64_t clen = cend - cb;
 
-      // pass II: do accumulation
-      for (int64_t iy = 0; iy < roi_bin_grid_h; iy++) {
-        for (int64_t ix = 0; ix < roi_bin_grid_w; ix++) {
-          PreCalc<ACC_T> pc = pre_calc[pre_calc_index];
+        // pass I: zero the out lane
+        int64_t d1 = cb;
+        for (; d1 < cend - (clen % Vec::size()); d1 += Vec::size()) {
+          Vec out_vec = Vec(T(0));
+          out_vec.store(out + d1);
+        }
+        // TODO: optimize with masked intrinsics.
+        for (; d1 < cend; d1++) {
+          out[d1] = T(0);
+        }
+
+        // pass II: do accumulation
+        for (int64_t g = 0; g < grid_size; g++) {
+          PreCalc<ACC_T> pc = pre_calc[pre_calc_base + g];
           const T* in1 = input + pc.pos1 * channels;
           const T* in2 = input + pc.pos2 * channels;
           const T* in3 = input + pc.pos3 * channels;
@@ -215,34 +222,42 @@ inline void roi_align_single_framework_channels_last_forward(
           Vec w2_vec = Vec(pc.w2);
           Vec w3_vec = Vec(pc.w3);
           Vec w4_vec = Vec(pc.w4);
-          int64_t d2 = 0;
-          // TODO: optimize with FMA.
-          for (; d2 < channels - (channels % Vec::size()); d2 += Vec::size()) {
-            Vec out_vec = Vec::loadu(out + d2) + w1_vec * Vec::loadu(in1 + d2) +
-                w2_vec * Vec::loadu(in2 + d2) + w3_vec * Vec::loadu(in3 + d2) +
-                w4_vec * Vec::loadu(in4 + d2);
+          int64_t d2 = cb;
+          for (; d2 < cend - (clen % Vec::size()); d2 += Vec::size()) {
+            Vec out_vec = at::vec::fmadd(
+                w1_vec,
+                Vec::loadu(in1 + d2),
+                at::vec::fmadd(
+                    w2_vec,
+                    Vec::loadu(in2 + d2),
+                    at::vec::fmadd(
+                        w3_vec,
+                        Vec::loadu(in3 + d2),
+                        at::vec::fmadd(
+                            w4_vec,
+                            Vec::loadu(in4 + d2),
+                            Vec::loadu(out + d2)))));
             out_vec.store(out + d2);
           }
           // TODO: optimize with masked intrinsics.
-          for (; d2 < channels; d2++) {
+          for (; d2 < cend; d2++) {
             out[d2] += pc.w1 * in1[d2] + pc.w2 * in2[d2] + pc.w3 * in3[d2] +
                 pc.w4 * in4[d2];
           }
-          pre_calc_index += 1;
         }
-      }
 
-      // pass III: do average
-      int64_t d3 = 0;
-      Vec count_vec = Vec(count);
-      for (; d3 < channels - (channels % Vec::size()); d3 += Vec::size()) {
-        Vec out_vec = Vec::loadu(out + d3) / count_vec;
-        out_vec.store(out + d3);
-      }
-      // TODO: optimize with masked intrinsics.
-      for (; d3 < channels; d3++) {
-        out[d3] /= static_cast<T>(count);
-      }
+        // pass III: do average
+        int64_t d3 = cb;
+        Vec count_vec = Vec(count);
+        for (; d3 < cend - (clen % Vec::size()); d3 += Vec::size()) {
+          Vec out_vec = Vec::loadu(out + d3) / count_vec;
+          out_vec.store(out + d3);
+        }
+        // TODO: optimize with masked intrinsics.
+        for (; d3 < cend; d3++) {
+          out[d3] /= static_cast<T>(count);
+        }
+      } // for cb
     } // for pw
   } // for ph
 }
@@ -262,48 +277,53 @@ inline void roi_align_single_framework_channels_last_forward<
     int64_t roi_bin_grid_w,
     const std::vector<PreCalc<float>>& pre_calc,
     at::BFloat16* output) {
-  // for 'normal' size of channels, should be L1 fit;
-  // otherwise consider blocking on channels.
   using bVec = at::vec::Vectorized<at::BFloat16>;
   using fVec = at::vec::Vectorized<float>;
 
+  // Same channel blocking as the generic version; one float block is also
+  // all the accumulation buffer we need.
+  constexpr int64_t BLOCK_C = 1024;
+  const int64_t grid_size = roi_bin_grid_h * roi_bin_grid_w;
+
   // temp buffer for sum, use float as accumulation type
   // can't reuse output buffer to store sum since it is BFloat16
-  std::unique_ptr<float[]> sum_arr(new float[channels]);
+  std::unique_ptr<float[]> sum_arr(new float[std::min(BLOCK_C, channels)]);
   float* sum = sum_arr.get();
 
-  int64_t pre_calc_index = 0;
   for (int64_t ph = 0; ph < pooled_height; ph++) {
     for (int64_t pw = 0; pw < pooled_width; pw++) {
       at::BFloat16* out = output + (ph * pooled_width + pw) * channels;
+      const int64_t pre_calc_base = (ph * pooled_width + pw) * grid_size;
 
-      // pass I: zero the sum lane
-      int64_t d1 = 0;
-      for (; d1 < channels - (channels % fVec::size()); d1 += fVec::size()) {
-        fVec sum_fvec = fVec(float(0));
-        sum_fvec.store(sum + d1);
-      }
-      // TODO: optimize with masked intrinsics.
-      for (; d1 < channels; d1++) {
-        sum[d1] = float(0);
-      }
+      for (int64_t cb = 0; cb < channels; cb += BLOCK_C) {
+        int64_t cend = std::min(cb + BLOCK_C, channels);
+        int64_t clen = cend - cb;
 
-      // pass II: do accumulation
-      for (int64_t iy = 0; iy < roi_bin_grid_h; iy++) {
-        for (int64_t ix = 0; ix < roi_bin_grid_w; ix++) {
-          PreCalc<float> pc = pre_calc[pre_calc_index];
-          const at::BFloat16* in1 = input + pc.pos1 * channels;
-          const at::BFloat16* in2 = input + pc.pos2 * channels;
-          const at::BFloat16* in3 = input + pc.pos3 * channels;
-          const at::BFloat16* in4 = input + pc.pos4 * channels;
+        // pass I: zero the sum lane
+        int64_t d1 = 0;
+        for (; d1 < clen - (clen % fVec::size()); d1 += fVec::size()) {
+          fVec sum_fvec = fVec(float(0));
+          sum_fvec.store(sum + d1);
+        }
+        // TODO: optimize with masked intrinsics.
+        for (; d1 < clen; d1++) {
+          sum[d1] = float(0);
+        }
+
+        // pass II: do accumulation
+        for (int64_t g = 0; g < grid_size; g++) {
+          PreCalc<float> pc = pre_calc[pre_calc_base + g];
+          const at::BFloat16* in1 = input + pc.pos1 * channels + cb;
+          const at::BFloat16* in2 = input + pc.pos2 * channels + cb;
+          const at::BFloat16* in3 = input + pc.pos3 * channels + cb;
+          const at::BFloat16* in4 = input + pc.pos4 * channels + cb;
 
           fVec w1_fvec = fVec(pc.w1);
           fVec w2_fvec = fVec(pc.w2);
           fVec w3_fvec = fVec(pc.w3);
           fVec w4_fvec = fVec(pc.w4);
           int64_t d2 = 0;
-          for (; d2 < channels - (channels % bVec::size());
-               d2 += bVec::size()) {
+          for (; d2 < clen - (clen % bVec::size()); d2 += bVec::size()) {
             bVec in1_bvec = bVec::loadu(in1 + d2);
             bVec in2_bvec = bVec::loadu(in2 + d2);
             bVec in3_bvec = bVec::loadu(in3 + d2);
@@ -314,40 +334,57 @@ inline void roi_align_single_framework_channels_last_forward<
             std::tie(in2_fvec0, in2_fvec1) = convert_bfloat16_float(in2_bvec);
             std::tie(in3_fvec0, in3_fvec1) = convert_bfloat16_float(in3_bvec);
             std::tie(in4_fvec0, in4_fvec1) = convert_bfloat16_float(in4_bvec);
-            // TODO: optimize with FMA.
-            fVec sum_fvec0 = fVec::loadu(sum + d2) + w1_fvec * in1_fvec0 +
-                w2_fvec * in2_fvec0 + w3_fvec * in3_fvec0 + w4_fvec * in4_fvec0;
-            fVec sum_fvec1 = fVec::loadu(sum + d2 + fVec::size()) +
-                w1_fvec * in1_fvec1 + w2_fvec * in2_fvec1 +
-                w3_fvec * in3_fvec1 + w4_fvec * in4_fvec1;
+            fVec sum_fvec0 = at::vec::fmadd(
+                w1_fvec,
+                in1_fvec0,
+                at::vec::fmadd(
+                    w2_fvec,
+                    in2_fvec0,
+                    at::vec::fmadd(
+                        w3_fvec,
+                        in3_fvec0,
+                        at::vec::fmadd(
+                            w4_fvec, in4_fvec0, fVec::loadu(sum + d2)))));
+            fVec sum_fvec1 = at::vec::fmadd(
+                w1_fvec,
+                in1_fvec1,
+                at::vec::fmadd(
+                    w2_fvec,
+                    in2_fvec1,
+                    at::vec::fmadd(
+                        w3_fvec,
+                        in3_fvec1,
+                        at::vec::fmadd(
+                            w4_fvec,
+                            in4_fvec1,
+                            fVec::loadu(sum + d2 + fVec::size())))));
             sum_fvec0.store(sum + d2);
             sum_fvec1.store(sum + d2 + fVec::size());
           }
           // TODO: optimize with masked intrinsics.
-          for (; d2 < channels; d2++) {
+          for (; d2 < clen; d2++) {
             sum[d2] += pc.w1 * static_cast<float>(in1[d2]) +
                 pc.w2 * static_cast<float>(in2[d2]) +
                 pc.w3 * static_cast<float>(in3[d2]) +
                 pc.w4 * static_cast<float>(in4[d2]);
           }
-          pre_calc_index += 1;
         }
-      }
 
-      // pass III: do average
-      int64_t d3 = 0;
-      fVec count_fvec = fVec(count);
-      for (; d3 < channels - (channels % bVec::size()); d3 += bVec::size()) {
-        fVec out_fvec0 = fVec::loadu(sum + d3) / count_fvec;
-        fVec out_fvec1 = fVec::loadu(sum + d3 + fVec::size()) / count_fvec;
+        // pass III: do average
+        int64_t d3 = 0;
+        fVec count_fvec = fVec(count);
+        for (; d3 < clen - (clen % bVec::size()); d3 += bVec::size()) {
+          fVec out_fvec0 = fVec::loadu(sum + d3) / count_fvec;
+          fVec out_fvec1 = fVec::loadu(sum + d3 + fVec::size()) / count_fvec;
 
-        bVec out_bvec = convert_float_bfloat16(out_fvec0, out_fvec1);
-        out_bvec.store(out + d3);
-      }
-      // TODO: optimize with masked intrinsics.
-      for (; d3 < channels; d3++) {
-        out[d3] = static_cast<at::BFloat16>(sum[d3] / count);
-      }
+          bVec out_bvec = convert_float_bfloat16(out_fvec0, out_fvec1);
+          out_bvec.store(out + cb + d3);
+        }
+        // TODO: optimize with masked intrinsics.
+        for (; d3 < clen; d3++) {
+          out[cb + d3] = static_cast<at::BFloat16>(sum[d3] / count);
+        }
+      } // for cb
     } // for pw
   } // for ph
 }
@@ -369,8 +406,8 @@ void roi_align_forward_kernel_body(
     bool is_channels_last) {
   // (n, c, ph, pw) is an element in the pooled output
   // can be parallelized using omp
-  at::parallel_for(0, n_rois, 1, [&](int64_t begin, int64_t end) {
-    for (int64_t n = begin; n < end; n++) {
+  auto roi_align_single_roi = [&](int64_t n) {
+    {
       const ACC_T* offset_rois = rois + n * 5;
       int64_t roi_batch_ind = offset_rois[0];
 
@@ -451,8 +488,25 @@ void roi_align_forward_kernel_body(
             pre_calc,
             output + n * channels * pooled_width * pooled_height);
       }
-    } // for n
+    }
+  };
+
+  // ROI cost scales with the sampling grid, which tracks the ROI size when
+  // sampling_ratio is not fixed; with a static partition a few large ROIs
+  // can serialize the whole batch, so hand out ROIs one at a time.
+#ifdef _OPENMP
+#pragma omp parallel for schedule( \
+    dynamic) if (omp_get_max_threads() > 1 && !omp_in_parallel())
+  for (int64_t n = 0; n < n_rois; n++) {
+    roi_align_single_roi(n);
+  }
+#else
+  at::parallel_for(0, n_rois, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t n = begin; n < end; n++) {
+      roi_align_single_roi(n);
+    }
   });
+#endif
 }
 
 template <class T>
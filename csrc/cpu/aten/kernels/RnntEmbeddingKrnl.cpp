@@ -47,6 +47,90 @@ inline void rnnt_embedding_kernel_body(
   });
 }
 
+#if defined(CPU_CAPABILITY_AVX512)
+// Copy one embedding row under a uniform row mask: an all-ones mask is a
+// plain copy, an all-zero mask (SOS) writes zeros without touching the
+// table. Both cases run the same straight-line loop, so a beam mixing SOS
+// and regular tokens gathers without per-hypothesis branches.
+inline void mask_move_ker(
+    float* out,
+    const float* in,
+    __mmask16 row_mask,
+    int64_t len) {
+  int64_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    _mm512_storeu_ps(out + i, _mm512_maskz_loadu_ps(row_mask, in + i));
+  }
+  if (i < len) {
+    __mmask16 tail = (1 << (len - i)) - 1;
+    _mm512_mask_storeu_ps(
+        out + i, tail, _mm512_maskz_loadu_ps(row_mask & tail, in + i));
+  }
+}
+
+inline void mask_move_ker(
+    at::BFloat16* out,
+    const at::BFloat16* in,
+    __mmask16 row_mask,
+    int64_t len) {
+  auto* dst = reinterpret_cast<uint16_t*>(out);
+  auto* src = reinterpret_cast<const uint16_t*>(in);
+  int64_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(dst + i),
+        _mm256_maskz_loadu_epi16(row_mask, src + i));
+  }
+  if (i < len) {
+    __mmask16 tail = (1 << (len - i)) - 1;
+    _mm256_mask_storeu_epi16(
+        dst + i, tail, _mm256_maskz_loadu_epi16(row_mask & tail, src + i));
+  }
+}
+#endif
+
+template <typename T>
+inline void rnnt_embedding_batched_kernel_body(
+    const at::Tensor& embedding_table,
+    const at::Tensor& idx,
+    at::Tensor embedding_out,
+    int64_t _SOS,
+    int64_t num_tokens,
+    int64_t embedding_dim) {
+  auto* embedding_table_ptr = embedding_table.data_ptr<T>();
+  auto* embedding_out_ptr = embedding_out.data_ptr<T>();
+
+  int64_t* idx_ptr = static_cast<int64_t*>(idx.data_ptr());
+
+  at::parallel_for(0, num_tokens, 16, [&](int64_t start, int64_t end) {
+    for (int i = start; i < end; i++) {
+      int64_t embed_idx = idx_ptr[i];
+      int64_t out_pos = i * embedding_dim;
+      bool is_sos = (embed_idx == _SOS);
+      // SOS rows read table row 0 under an all-zero mask instead of
+      // taking a separate zero-fill path.
+      int64_t in_pos = (is_sos ? 0 : embed_idx) * embedding_dim;
+#if defined(CPU_CAPABILITY_AVX512)
+      __mmask16 row_mask = is_sos ? 0 : 0xffff;
+      mask_move_ker(
+          &embedding_out_ptr[out_pos],
+          &embedding_table_ptr[in_pos],
+          row_mask,
+          embedding_dim);
+#else
+      if (is_sos) {
+        zero_ker(&embedding_out_ptr[out_pos], embedding_dim);
+      } else {
+        move_ker(
+            &embedding_out_ptr[out_pos],
+            &embedding_table_ptr[in_pos],
+            embedding_dim);
+      }
+#endif
+    }
+  });
+}
+
 void rnnt_embedding_kernel_impl(
     const at::Tensor& embedding_table,
     const at::Tensor& idx,
@@ -67,9 +151,32 @@ void rnnt_embedding_kernel_impl(
   }
 }
 
+void rnnt_embedding_batched_kernel_impl(
+    const at::Tensor& embedding_table,
+    const at::Tensor& idx,
+    at::Tensor embedding_out,
+    int64_t _SOS) {
+  AT_ASSERTM(
+      (embedding_table.scalar_type() == at::kBFloat16 ||
+       embedding_table.scalar_type() == at::kFloat),
+      "only support embedding_table to be float or bf16 tensor");
+  int64_t num_tokens = idx.numel();
+  int64_t embedding_dim = embedding_table.size(1);
+  if (embedding_table.scalar_type() == at::kBFloat16) {
+    rnnt_embedding_batched_kernel_body<at::BFloat16>(
+        embedding_table, idx, embedding_out, _SOS, num_tokens, embedding_dim);
+  } else {
+    rnnt_embedding_batched_kernel_body<float>(
+        embedding_table, idx, embedding_out, _SOS, num_tokens, embedding_dim);
+  }
+}
+
 } // anonymous namespace
 
 IPEX_REGISTER_DISPATCH(rnnt_embedding_kernel_stub, &rnnt_embedding_kernel_impl);
+IPEX_REGISTER_DISPATCH(
+    rnnt_embedding_batched_kernel_stub,
+    &rnnt_embedding_batched_kernel_impl);
 
 } // namespace cpu
 } // namespace torch_ipex
@@ -117,25 +117,23 @@ std::tuple<at::Tensor, at::Tensor, at::Tensor> ApplyROPEKernel(
                   rotary_dim,
                   offset);
             }
-          } else { // used by GPT-J 6B & CodeGen & ChatGLM
-                   // logic is like to the rotate_every_two in python code
-            for (int h = 0, h2 = 0; h < HR; h += 2, h2++) {
-              float sin = sin_start[h2];
-              float cos = cos_start[h2];
-              float in0 = in_ptr[in_offset_q + h];
-              float in1 = in_ptr[in_offset_q + h + offset];
-              float out0 = in0 * cos - in1 * sin;
-              float out1 = in1 * cos + in0 * sin;
-              query_ptr[out_offset_q + h] = out0;
-              query_ptr[out_offset_q + h + offset] = out1;
-              if (concat_qkv && n < N_KV) {
-                in0 = in_ptr[in_offset_k + h];
-                in1 = in_ptr[in_offset_k + h + offset];
-                out0 = in0 * cos - in1 * sin;
-                out1 = in1 * cos + in0 * sin;
-                key_ptr[out_offset_k + h] = out0;
-                key_ptr[out_offset_k + h + offset] = out1;
-              }
+          } else { // used by GPT-J 6B & CodeGen & ChatGLM & Qwen
+                   // logic is like to the rotate_every_two in python code;
+                   // the pairs are deinterleaved/interleaved in registers so
+                   // no permute of the head is needed
+            torch_ipex::cpu::kernel::apply_rope_interleaved_kernel<T>(
+                in_ptr + in_offset_q,
+                query_ptr + out_offset_q,
+                cos_start,
+                sin_start,
+                rotary_dim);
+            if (concat_qkv && n < N_KV) {
+              torch_ipex::cpu::kernel::apply_rope_interleaved_kernel<T>(
+                  in_ptr + in_offset_k,
+                  key_ptr + out_offset_k,
+                  cos_start,
+                  sin_start,
+                  rotary_dim);
             }
           }
           // step 2) copy the rest of the input tensor to query/key (query_pass
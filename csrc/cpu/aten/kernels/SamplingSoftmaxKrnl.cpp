@@ -0,0 +1,278 @@
+#include <ATen/CPUGeneratorImpl.h>
+#include <ATen/Parallel.h>
+#include <aten/SamplingSoftmax.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "vec/vec.h"
+
+namespace torch_ipex {
+namespace cpu {
+
+namespace {
+
+#if defined(CPU_CAPABILITY_AVX512)
+using namespace torch_ipex::cpu::kernel;
+
+// exp(a - max) for entries >= threshold, 0 elsewhere, accumulating the
+// sum of the surviving exponentials. Kept local: this kernel TU is built
+// per ISA, so the helper does not need to live in the shared vec headers.
+inline void _masked_exp_reduce_sum_kernel(
+    const float* a,
+    const float& threshold,
+    const int& size,
+    float* out,
+    float& val) {
+  auto vec_max = _mm512_set1_ps(val);
+  auto vec_thr = _mm512_set1_ps(threshold);
+  auto vec_zero = _mm512_set1_ps(0.f);
+  auto vec_sum = _mm512_set1_ps(0.f);
+
+  int i = 0;
+  for (; i <= size - 16; i += 16) {
+    auto vec_a = _mm512_loadu_ps(a + i);
+    __mmask16 keep = _mm512_cmp_ps_mask(vec_a, vec_thr, _CMP_GE_OQ);
+    auto vec_out = _dil_exp_kernel(_mm512_sub_ps(vec_a, vec_max));
+    vec_out = _mm512_mask_blend_ps(keep, vec_zero, vec_out);
+    vec_sum = _mm512_add_ps(vec_sum, vec_out);
+    _mm512_storeu_ps(out + i, vec_out);
+  }
+
+  if (i < size) {
+    __mmask16 mask = (1 << (size - i)) - 1;
+    auto vec_a = _mm512_mask_loadu_ps(vec_max, mask, a + i);
+    __mmask16 keep =
+        _mm512_mask_cmp_ps_mask(mask, vec_a, vec_thr, _CMP_GE_OQ);
+    auto vec_out = _dil_exp_kernel(_mm512_sub_ps(vec_a, vec_max));
+    vec_out = _mm512_mask_blend_ps(keep, vec_zero, vec_out);
+    vec_sum = _mm512_mask_add_ps(vec_sum, mask, vec_sum, vec_out);
+    _mm512_mask_storeu_ps(out + i, mask, vec_out);
+  }
+
+  // NOTE: _mm512_reduce_add_ps is sequence instruction
+  val = _mm512_reduce_add_ps(vec_sum);
+}
+#endif
+
+at::Tensor sampling_softmax_kernel_impl(
+    const at::Tensor& logits,
+    double temperature,
+    int64_t top_k) {
+  TORCH_CHECK(
+      logits.scalar_type() == at::kFloat,
+      "sampling_softmax: expect fp32 logits");
+  TORCH_CHECK(
+      temperature > 0, "sampling_softmax: temperature must be positive");
+  auto logits_ = logits.contiguous();
+  auto vocab_size = logits_.size(logits_.dim() - 1);
+  int64_t rows = logits_.numel() / vocab_size;
+  auto output = at::empty_like(logits_);
+  float inv_temp = static_cast<float>(1.0 / temperature);
+  bool do_topk = top_k > 0 && top_k < vocab_size;
+
+  const float* in_ptr = logits_.data_ptr<float>();
+  float* out_ptr = output.data_ptr<float>();
+
+  at::parallel_for(0, rows, 1, [&](int64_t begin, int64_t end) {
+    std::vector<float> scaled(vocab_size);
+    std::vector<float> selection(do_topk ? vocab_size : 0);
+    for (int64_t r = begin; r < end; r++) {
+      const float* row = in_ptr + r * vocab_size;
+      float* out_row = out_ptr + r * vocab_size;
+      float max = std::numeric_limits<float>::lowest();
+      // pass 1: temperature scaling fused with the max reduction
+#if defined(CPU_CAPABILITY_AVX512)
+      _dil_mul_reduce_max_fusion_kernel(
+          row, inv_temp, vocab_size, scaled.data(), max);
+#else
+      for (int64_t i = 0; i < vocab_size; i++) {
+        scaled[i] = row[i] * inv_temp;
+        max = std::max(max, scaled[i]);
+      }
+#endif
+      // top_k threshold via a partial selection over a scratch copy;
+      // ties on the threshold value keep all tied entries.
+      float threshold = std::numeric_limits<float>::lowest();
+      if (do_topk) {
+        std::copy(scaled.begin(), scaled.end(), selection.begin());
+        std::nth_element(
+            selection.begin(),
+            selection.begin() + top_k - 1,
+            selection.end(),
+            std::greater<float>());
+        threshold = selection[top_k - 1];
+      }
+      // pass 2: exp + sum over the survivors, zeros elsewhere
+      float sum = max;
+#if defined(CPU_CAPABILITY_AVX512)
+      _masked_exp_reduce_sum_kernel(
+          scaled.data(), threshold, vocab_size, out_row, sum);
+#else
+      sum = 0.f;
+      for (int64_t i = 0; i < vocab_size; i++) {
+        float e = scaled[i] >= threshold ? std::exp(scaled[i] - max) : 0.f;
+        out_row[i] = e;
+        sum += e;
+      }
+#endif
+      // pass 3: normalize; filtered entries are zero and stay zero
+#if defined(CPU_CAPABILITY_AVX512)
+      _dil_normalization_kernel<float>(out_row, sum, vocab_size, out_row);
+#else
+      float inv_sum = 1.f / sum;
+      for (int64_t i = 0; i < vocab_size; i++) {
+        out_row[i] *= inv_sum;
+      }
+#endif
+    }
+  });
+  return output;
+}
+
+// Draws the base seed for one sampling call from the default CPU
+// generator, so the op stays deterministic under torch.manual_seed.
+// Each row then derives its own stream from (seed + row), making the
+// result independent of the thread partitioning.
+uint64_t sampling_base_seed() {
+  auto gen = at::get_generator_or_default<at::CPUGeneratorImpl>(
+      c10::nullopt, at::detail::getDefaultCPUGenerator());
+  std::lock_guard<std::mutex> lock(gen->mutex_);
+  return gen->random64();
+}
+
+// First index of the row maximum, matching torch.argmax tie breaking.
+inline int64_t _argmax_kernel(const float* a, int64_t size) {
+  float best = std::numeric_limits<float>::lowest();
+  int64_t best_idx = 0;
+  int64_t i = 0;
+#if defined(CPU_CAPABILITY_AVX512)
+  if (size >= 16) {
+    auto vec_max = _mm512_set1_ps(std::numeric_limits<float>::lowest());
+    auto vec_max_idx = _mm512_setzero_si512();
+    auto vec_idx = _mm512_setr_epi32(
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    auto vec_step = _mm512_set1_epi32(16);
+    for (; i <= size - 16; i += 16) {
+      auto vec_a = _mm512_loadu_ps(a + i);
+      // strict > keeps the first occurrence within each lane
+      __mmask16 gt = _mm512_cmp_ps_mask(vec_a, vec_max, _CMP_GT_OQ);
+      vec_max = _mm512_mask_blend_ps(gt, vec_max, vec_a);
+      vec_max_idx = _mm512_mask_blend_epi32(gt, vec_max_idx, vec_idx);
+      vec_idx = _mm512_add_epi32(vec_idx, vec_step);
+    }
+    float lane_max[16];
+    int32_t lane_idx[16];
+    _mm512_storeu_ps(lane_max, vec_max);
+    _mm512_storeu_si512(reinterpret_cast<__m512i*>(lane_idx), vec_max_idx);
+    for (int l = 0; l < 16; l++) {
+      if (lane_max[l] > best ||
+          (lane_max[l] == best && lane_idx[l] < best_idx)) {
+        best = lane_max[l];
+        best_idx = lane_idx[l];
+      }
+    }
+  }
+#endif
+  for (; i < size; i++) {
+    if (a[i] > best) {
+      best = a[i];
+      best_idx = i;
+    }
+  }
+  return best_idx;
+}
+
+// Inverse-CDF draw: walk the row in vector blocks, skipping a block in
+// one reduce_add when the cumulative sum does not reach the target yet,
+// and only scanning scalar once the crossing block is found. If float
+// rounding exhausts the row before the target is reached, the last
+// index with nonzero probability is returned.
+inline int64_t _cdf_sample_kernel(const float* a, int64_t size, float target) {
+  float running = 0.f;
+  int64_t last_nz = -1;
+  int64_t i = 0;
+#if defined(CPU_CAPABILITY_AVX512)
+  auto vec_zero = _mm512_set1_ps(0.f);
+  for (; i <= size - 16; i += 16) {
+    auto vec_a = _mm512_loadu_ps(a + i);
+    float block_sum = _mm512_reduce_add_ps(vec_a);
+    if (running + block_sum >= target) {
+      break;
+    }
+    __mmask16 nz = _mm512_cmp_ps_mask(vec_a, vec_zero, _CMP_GT_OQ);
+    if (nz != 0) {
+      last_nz = i + 31 - __builtin_clz(static_cast<uint32_t>(nz));
+    }
+    running += block_sum;
+  }
+#endif
+  for (; i < size; i++) {
+    if (a[i] > 0.f) {
+      running += a[i];
+      last_nz = i;
+      if (running >= target) {
+        return i;
+      }
+    }
+  }
+  return last_nz >= 0 ? last_nz : size - 1;
+}
+
+at::Tensor sample_token_kernel_impl(const at::Tensor& probs, bool do_sample) {
+  TORCH_CHECK(
+      probs.scalar_type() == at::kFloat,
+      "sample_token: expect fp32 probabilities");
+  auto probs_ = probs.contiguous();
+  auto vocab_size = probs_.size(probs_.dim() - 1);
+  int64_t rows = probs_.numel() / vocab_size;
+  auto out_sizes = probs_.sizes().vec();
+  out_sizes.back() = 1;
+  auto output = at::empty(out_sizes, probs_.options().dtype(at::kLong));
+
+  const float* in_ptr = probs_.data_ptr<float>();
+  int64_t* out_ptr = output.data_ptr<int64_t>();
+  const uint64_t seed = do_sample ? sampling_base_seed() : 0;
+
+  at::parallel_for(0, rows, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t r = begin; r < end; r++) {
+      const float* row = in_ptr + r * vocab_size;
+      if (!do_sample) {
+        out_ptr[r] = _argmax_kernel(row, vocab_size);
+        continue;
+      }
+      std::mt19937_64 rng(seed + (uint64_t)r);
+      // 24-bit draw in [0, 1); scale by the actual row sum so slightly
+      // unnormalized probabilities still sample in proportion
+      float u = (rng() >> 40) * 0x1p-24f;
+      float total = 0.f;
+      int64_t i = 0;
+#if defined(CPU_CAPABILITY_AVX512)
+      auto vec_sum = _mm512_set1_ps(0.f);
+      for (; i <= vocab_size - 16; i += 16) {
+        vec_sum = _mm512_add_ps(vec_sum, _mm512_loadu_ps(row + i));
+      }
+      total = _mm512_reduce_add_ps(vec_sum);
+#endif
+      for (; i < vocab_size; i++) {
+        total += row[i];
+      }
+      out_ptr[r] = _cdf_sample_kernel(row, vocab_size, u * total);
+    }
+  });
+  return output;
+}
+
+} // anonymous namespace
+
+IPEX_REGISTER_DISPATCH(
+    sampling_softmax_kernel_stub,
+    &sampling_softmax_kernel_impl);
+IPEX_REGISTER_DISPATCH(sample_token_kernel_stub, &sample_token_kernel_impl);
+
+} // namespace cpu
+} // namespace torch_ipex
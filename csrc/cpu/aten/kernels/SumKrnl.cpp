@@ -10,7 +10,16 @@
 #include <ATen/record_function.h>
 #include <c10/util/irange.h>
 #include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
 
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "utils/determinism.h"
 #include "utils/library.h"
 
 #include <aten/Sum.h>
@@ -716,6 +725,312 @@ void cascade_sum(at::TensorIterator& iter) {
   });
 }
 
+void sum_kernel_cascade_impl(at::TensorIterator& iter) {
+  AT_DISPATCH_FLOATING_AND_COMPLEX_TYPES_AND2(
+      at::ScalarType::BFloat16,
+      at::ScalarType::Half,
+      iter.dtype(),
+      "sum_cpu",
+      [&] { cascade_sum</*ignore_nan=*/false, scalar_t>(iter); });
+}
+
+// Plain running-sum reduction for short reductions, where the cascade's
+// chunking tree costs more than the rounding it saves. Reduced-precision
+// and complex types stay on the cascade at every size: they accumulate in
+// a wider type there, which the plain loop would give up.
+void sum_kernel_simple_impl(at::TensorIterator& iter) {
+  if (iter.dtype() != at::ScalarType::Float &&
+      iter.dtype() != at::ScalarType::Double) {
+    sum_kernel_cascade_impl(iter);
+    return;
+  }
+  AT_DISPATCH_FLOATING_TYPES(iter.dtype(), "sum_cpu", [&] {
+    at::native::binary_kernel_reduce_vec(
+        iter,
+        [=](scalar_t a, scalar_t b) -> scalar_t { return a + b; },
+        [=](at::vec::Vectorized<scalar_t> a, at::vec::Vectorized<scalar_t> b) {
+          return a + b;
+        });
+  });
+}
+
+/* Streaming two-pass reduction for huge tensors. A full reduction over a
+ * multi-GB buffer is bandwidth bound; with the default static thread
+ * partitioning every socket ends up pulling most of its data across the
+ * interconnect, since the pages of a big allocation are interleaved or
+ * first-touch placed without regard to which thread later reads them. The
+ * path below samples the page-to-node mapping once (one move_pages probe per
+ * chunk), queues the chunks per node, and lets each worker drain the queue
+ * of the node it is running on before stealing, so almost all traffic stays
+ * node-local. Chunks stream with non-temporal loads: the data is read once
+ * and should not evict the caches.
+ */
+constexpr int64_t kStreamChunkBytes = 1 << 21; // one 2 MB huge page
+
+#if defined(CPU_CAPABILITY_AVX512)
+float stream_chunk_sum(const float* data, int64_t size) {
+  int64_t i = 0;
+  float sum = 0;
+  // Scalar head up to the 64-byte boundary the stream loads require.
+  while (i < size && (reinterpret_cast<uintptr_t>(data + i) & 63) != 0) {
+    sum += data[i++];
+  }
+  auto acc0 = _mm512_setzero_ps();
+  auto acc1 = _mm512_setzero_ps();
+  auto acc2 = _mm512_setzero_ps();
+  auto acc3 = _mm512_setzero_ps();
+  for (; i + 64 <= size; i += 64) {
+    acc0 = _mm512_add_ps(
+        acc0,
+        _mm512_castsi512_ps(_mm512_stream_load_si512((void*)(data + i))));
+    acc1 = _mm512_add_ps(
+        acc1,
+        _mm512_castsi512_ps(_mm512_stream_load_si512((void*)(data + i + 16))));
+    acc2 = _mm512_add_ps(
+        acc2,
+        _mm512_castsi512_ps(_mm512_stream_load_si512((void*)(data + i + 32))));
+    acc3 = _mm512_add_ps(
+        acc3,
+        _mm512_castsi512_ps(_mm512_stream_load_si512((void*)(data + i + 48))));
+  }
+  for (; i + 16 <= size; i += 16) {
+    acc0 = _mm512_add_ps(acc0, _mm512_load_ps(data + i));
+  }
+  sum += _mm512_reduce_add_ps(
+      _mm512_add_ps(_mm512_add_ps(acc0, acc1), _mm512_add_ps(acc2, acc3)));
+  for (; i < size; ++i) {
+    sum += data[i];
+  }
+  return sum;
+}
+#else
+float stream_chunk_sum(const float* data, int64_t size) {
+  // Two accumulators keep the error profile close to the vectorized path.
+  float even = 0;
+  float odd = 0;
+  int64_t i = 0;
+  for (; i + 2 <= size; i += 2) {
+    even += data[i];
+    odd += data[i + 1];
+  }
+  if (i < size) {
+    even += data[i];
+  }
+  return even + odd;
+}
+#endif
+
+// Samples the NUMA node of each chunk's first page in one move_pages call.
+// Returns false (and leaves every chunk on node 0) when the probe is not
+// available, e.g. on non-Linux or single-node machines.
+bool probe_chunk_nodes(
+    const void* base,
+    int64_t num_chunks,
+    std::vector<int>& chunk_nodes) {
+  chunk_nodes.assign(num_chunks, 0);
+#ifdef __linux__
+  const auto page_size = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+  std::vector<void*> pages(num_chunks);
+  std::vector<int> status(num_chunks, 0);
+  for (const auto i : c10::irange(num_chunks)) {
+    auto addr = reinterpret_cast<uintptr_t>(base) + i * kStreamChunkBytes;
+    pages[i] = reinterpret_cast<void*>(addr & ~(page_size - 1));
+  }
+  if (syscall(
+          SYS_move_pages,
+          0,
+          static_cast<unsigned long>(num_chunks),
+          pages.data(),
+          nullptr,
+          status.data(),
+          0) != 0) {
+    return false;
+  }
+  bool multi_node = false;
+  for (const auto i : c10::irange(num_chunks)) {
+    // Negative status means the page is not faulted in yet; leave it on 0.
+    chunk_nodes[i] = status[i] > 0 ? status[i] : 0;
+    multi_node = multi_node || chunk_nodes[i] != chunk_nodes[0];
+  }
+  return multi_node;
+#else
+  return false;
+#endif
+}
+
+int current_numa_node() {
+#ifdef __linux__
+  unsigned cpu = 0;
+  unsigned node = 0;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+    return static_cast<int>(node);
+  }
+#endif
+  return 0;
+}
+
+void sum_kernel_streaming_impl(at::TensorIterator& iter) {
+  // The streaming path handles the common shape of the huge case: one
+  // contiguous fp32 input fully reduced to a scalar. Everything else keeps
+  // the cascade.
+  if (iter.dtype() != at::ScalarType::Float || iter.noutputs() != 1 ||
+      iter.output_base().numel() != 1 || iter.ntensors() != 2 ||
+      !iter.tensor_base(1).is_contiguous()) {
+    sum_kernel_cascade_impl(iter);
+    return;
+  }
+
+  const auto* data = static_cast<const float*>(iter.data_ptr(1));
+  const int64_t numel = iter.numel();
+  constexpr int64_t chunk_elems = kStreamChunkBytes / sizeof(float);
+  const int64_t num_chunks = (numel + chunk_elems - 1) / chunk_elems;
+
+  std::vector<int> chunk_nodes;
+  int num_nodes = 1;
+  if (probe_chunk_nodes(data, num_chunks, chunk_nodes)) {
+    for (const auto i : c10::irange(num_chunks)) {
+      num_nodes = std::max(num_nodes, chunk_nodes[i] + 1);
+    }
+  }
+
+  // Per-node chunk queues with work stealing: a worker drains the queue of
+  // the node it runs on and only then helps the remote ones, so the bulk of
+  // the traffic stays on the local memory controllers.
+  std::vector<std::vector<int64_t>> node_chunks(num_nodes);
+  for (const auto i : c10::irange(num_chunks)) {
+    node_chunks[chunk_nodes[i]].push_back(i);
+  }
+  auto cursors = std::make_unique<std::atomic<int64_t>[]>(num_nodes);
+  for (const auto n : c10::irange(num_nodes)) {
+    cursors[n].store(0, std::memory_order_relaxed);
+  }
+
+  std::vector<float> chunk_sums(num_chunks, 0.0f);
+  const int num_threads = at::get_num_threads();
+  at::parallel_for(0, num_threads, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t t = begin; t < end; ++t) {
+      int home = current_numa_node();
+      if (home >= num_nodes) {
+        home = 0;
+      }
+      for (const auto offset : c10::irange(num_nodes)) {
+        const int n = (home + offset) % num_nodes;
+        while (true) {
+          const auto slot =
+              cursors[n].fetch_add(1, std::memory_order_relaxed);
+          if (slot >= static_cast<int64_t>(node_chunks[n].size())) {
+            break;
+          }
+          const auto chunk = node_chunks[n][slot];
+          const auto start = chunk * chunk_elems;
+          chunk_sums[chunk] = stream_chunk_sum(
+              data + start, std::min(chunk_elems, numel - start));
+        }
+      }
+    }
+  });
+
+  // Second pass: the per-chunk partials combine in double, which costs
+  // nothing at this size and keeps the huge-input error below the cascade's.
+  double total = 0;
+  for (const auto i : c10::irange(num_chunks)) {
+    total += chunk_sums[i];
+  }
+  iter.output_base().fill_(static_cast<float>(total));
+}
+
+/* Deterministic fixed-tree reduction (IPEX_DETERMINISTIC_REDUCTIONS).
+ * The chunk size is a compile-time constant, so the partial layout and the
+ * pairwise combination tree depend only on the input length — not on
+ * thread count, dynamic scheduling, or buffer alignment — which makes the
+ * result bitwise run-to-run reproducible at full parallelism. Chunks are
+ * computed independently (assignment to threads is free to vary); the
+ * partials then fold sequentially in a fixed-shape pairwise tree.
+ */
+constexpr int64_t kDetChunkElems = 1 << 15;
+
+template <typename scalar_t>
+scalar_t det_chunk_sum(const scalar_t* data, int64_t size) {
+  using Vec = at::vec::Vectorized<scalar_t>;
+  // Unaligned loads keep the traversal identical regardless of where the
+  // allocator placed the buffer.
+  Vec acc(scalar_t(0));
+  int64_t i = 0;
+  for (; i + Vec::size() <= size; i += Vec::size()) {
+    acc = acc + Vec::loadu(data + i);
+  }
+  alignas(64) scalar_t lanes[Vec::size()];
+  acc.store(lanes);
+  // Fixed pairwise fold of the vector lanes.
+  for (int64_t width = Vec::size() / 2; width >= 1; width /= 2) {
+    for (int64_t k = 0; k < width; ++k) {
+      lanes[k] += lanes[k + width];
+    }
+  }
+  scalar_t sum = lanes[0];
+  for (; i < size; ++i) {
+    sum += data[i];
+  }
+  return sum;
+}
+
+template <typename scalar_t>
+void deterministic_sum_reduce_all(at::TensorIterator& iter) {
+  const auto* data = static_cast<const scalar_t*>(iter.data_ptr(1));
+  const int64_t numel = iter.numel();
+  const int64_t num_chunks =
+      std::max<int64_t>(1, (numel + kDetChunkElems - 1) / kDetChunkElems);
+
+  std::vector<scalar_t> partials(num_chunks, scalar_t(0));
+  at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+    for (const auto i : c10::irange(begin, end)) {
+      const int64_t start = i * kDetChunkElems;
+      partials[i] =
+          det_chunk_sum(data + start, std::min(kDetChunkElems, numel - start));
+    }
+  });
+
+  // Fixed-shape pairwise tree over the chunk partials.
+  for (int64_t width = num_chunks; width > 1;) {
+    const int64_t half = (width + 1) / 2;
+    for (int64_t k = 0; k + half < width; ++k) {
+      partials[k] += partials[k + half];
+    }
+    width = half;
+  }
+  iter.output_base().fill_(partials[0]);
+}
+
+void sum_kernel_deterministic_impl(at::TensorIterator& iter) {
+  // The fixed-tree path covers contiguous full reductions of fp32/fp64.
+  // Everything else takes the cascade, whose parallel_reduce partitioning
+  // is static for a given shape and thread count (notably it never work
+  // steals), so it stays run-to-run reproducible as well.
+  if ((iter.dtype() == at::ScalarType::Float ||
+       iter.dtype() == at::ScalarType::Double) &&
+      iter.noutputs() == 1 && iter.output_base().numel() == 1 &&
+      iter.ntensors() == 2 && iter.tensor_base(1).is_contiguous()) {
+    if (iter.dtype() == at::ScalarType::Float) {
+      deterministic_sum_reduce_all<float>(iter);
+    } else {
+      deterministic_sum_reduce_all<double>(iter);
+    }
+    return;
+  }
+  sum_kernel_cascade_impl(iter);
+}
+
+// Size-classed sub-dispatch (see dyndisp/DispatchStub.h): the algorithm
+// choice happens once per call instead of branching inside the kernel, and
+// the thresholds stay tunable at runtime under the stub's name.
+SizeClassedKernel<void (*)(at::TensorIterator&)> sum_size_classes(
+    "sum_kernel_stub",
+    &sum_kernel_simple_impl,
+    &sum_kernel_cascade_impl,
+    &sum_kernel_streaming_impl,
+    /*small_limit=*/4096,
+    /*medium_limit=*/1 << 26);
+
 void sum_kernel_impl(at::TensorIterator& iter) {
   if (isIntegralType(iter.dtype(), /*includeBool=*/true)) {
     AT_DISPATCH_INTEGRAL_TYPES_AND(
@@ -729,12 +1044,15 @@ void sum_kernel_impl(at::TensorIterator& iter) {
     return;
   }
 
-  AT_DISPATCH_FLOATING_AND_COMPLEX_TYPES_AND2(
-      at::ScalarType::BFloat16,
-      at::ScalarType::Half,
-      iter.dtype(),
-      "sum_cpu",
-      [&] { cascade_sum</*ignore_nan=*/false, scalar_t>(iter); });
+  if (torch_ipex::isDeterministicReductionsEnabled()) {
+    // Deterministic mode bypasses the size classes: the simple and
+    // streaming paths trade reproducibility (alignment-dependent heads,
+    // work stealing) for speed.
+    sum_kernel_deterministic_impl(iter);
+    return;
+  }
+
+  sum_size_classes.select(iter.numel())(iter);
 }
 
 } // anonymous namespace
@@ -62,6 +62,29 @@ at::Tensor tpp_linear_nobias_kernel_impl(
   return t_out;
 }
 
+at::Tensor tpp_linear_argmax_kernel_impl(
+    const at::Tensor& t_in,
+    const at::Tensor& t_wt,
+    const at::Tensor& t_bias) {
+  auto in_sizes = t_in.sizes();
+  auto t_out = at::empty(
+      {in_sizes[0], in_sizes[1]}, t_in.options().dtype(at::kLong));
+
+  auto dt = t_wt.dtype();
+  if (dt == at::kFloat) {
+    torch_ipex::tpp::tpp_linear_argmax<float>(t_in, t_wt, t_bias, t_out);
+  } else if (dt == at::kBFloat16) {
+    torch_ipex::tpp::tpp_linear_argmax<at::BFloat16>(t_in, t_wt, t_bias, t_out);
+  } else {
+    AT_ASSERT(
+        0,
+        "TPP does not support current weight dtype %s:%d\n",
+        __FILE__,
+        __LINE__);
+  }
+  return t_out;
+}
+
 at::Tensor tpp_linear_gelu_kernel_impl(
     const at::Tensor& t_in,
     const at::Tensor& t_wt,
@@ -240,6 +263,162 @@ at::Tensor tpp_linear_mul_kernel_impl(
   return t_out;
 }
 
+at::Tensor tpp_fused_gated_mlp_kernel_impl(
+    const at::Tensor& t_in,
+    const at::Tensor& t_wt_gate,
+    const at::Tensor& t_bias_gate,
+    const at::Tensor& t_wt_up,
+    const at::Tensor& t_bias_up,
+    const at::Tensor& t_wt_down,
+    const at::Tensor& t_bias_down) {
+  auto sizes = t_in.sizes().vec();
+  AT_ASSERT(
+      t_wt_gate.sizes() == t_wt_up.sizes(),
+      "Expect t_wt_gate.sizes() == t_wt_up.sizes()");
+  auto wd_sizes = t_wt_down.sizes();
+  sizes[2] = wd_sizes[0] * wd_sizes[3];
+
+  auto t_out = t_in.new_empty(sizes);
+
+  auto dt = t_wt_gate.dtype();
+  if (dt == at::kFloat) {
+    torch_ipex::tpp::tpp_fused_gated_mlp<float>(
+        t_in,
+        t_wt_gate,
+        t_bias_gate,
+        t_wt_up,
+        t_bias_up,
+        t_wt_down,
+        t_bias_down,
+        t_out);
+  } else if (dt == at::kBFloat16) {
+    torch_ipex::tpp::tpp_fused_gated_mlp<at::BFloat16>(
+        t_in,
+        t_wt_gate,
+        t_bias_gate,
+        t_wt_up,
+        t_bias_up,
+        t_wt_down,
+        t_bias_down,
+        t_out);
+  } else {
+    AT_ASSERT(
+        0,
+        "TPP does not support current weight dtype %s:%d\n",
+        __FILE__,
+        __LINE__);
+  }
+  return t_out;
+}
+
+at::Tensor tpp_fused_gated_mlp_add_kernel_impl(
+    const at::Tensor& t_in,
+    const at::Tensor& t_res,
+    const at::Tensor& t_wt_gate,
+    const at::Tensor& t_bias_gate,
+    const at::Tensor& t_wt_up,
+    const at::Tensor& t_bias_up,
+    const at::Tensor& t_wt_down,
+    const at::Tensor& t_bias_down) {
+  auto sizes = t_in.sizes().vec();
+  AT_ASSERT(
+      t_wt_gate.sizes() == t_wt_up.sizes(),
+      "Expect t_wt_gate.sizes() == t_wt_up.sizes()");
+  auto wd_sizes = t_wt_down.sizes();
+  sizes[2] = wd_sizes[0] * wd_sizes[3];
+  AT_ASSERT(
+      t_res.sizes().vec() == sizes,
+      "Expect the residual to match the down-projection output shape");
+
+  auto t_out = t_in.new_empty(sizes);
+
+  auto dt = t_wt_gate.dtype();
+  if (dt == at::kFloat) {
+    torch_ipex::tpp::tpp_fused_gated_mlp_add<float>(
+        t_in,
+        t_res,
+        t_wt_gate,
+        t_bias_gate,
+        t_wt_up,
+        t_bias_up,
+        t_wt_down,
+        t_bias_down,
+        t_out);
+  } else if (dt == at::kBFloat16) {
+    torch_ipex::tpp::tpp_fused_gated_mlp_add<at::BFloat16>(
+        t_in,
+        t_res,
+        t_wt_gate,
+        t_bias_gate,
+        t_wt_up,
+        t_bias_up,
+        t_wt_down,
+        t_bias_down,
+        t_out);
+  } else {
+    AT_ASSERT(
+        0,
+        "TPP does not support current weight dtype %s:%d\n",
+        __FILE__,
+        __LINE__);
+  }
+  return t_out;
+}
+
+std::tuple<at::Tensor, at::Tensor, at::Tensor> tpp_fused_qkv_gemm_kernel_impl(
+    const at::Tensor& t_in,
+    const at::Tensor& t_wt_q,
+    const at::Tensor& t_bias_q,
+    const at::Tensor& t_wt_k,
+    const at::Tensor& t_bias_k,
+    const at::Tensor& t_wt_v,
+    const at::Tensor& t_bias_v) {
+  auto sizes = t_in.sizes().vec();
+  AT_ASSERT(
+      t_wt_q.sizes() == t_wt_k.sizes() && t_wt_q.sizes() == t_wt_v.sizes(),
+      "Expect Q/K/V weights to have the same sizes");
+  auto wt_sizes = t_wt_q.sizes();
+  sizes[2] = wt_sizes[0] * wt_sizes[3];
+
+  auto t_out_q = t_in.new_empty(sizes);
+  auto t_out_k = t_in.new_empty(sizes);
+  auto t_out_v = t_in.new_empty(sizes);
+
+  auto dt = t_wt_q.dtype();
+  if (dt == at::kFloat) {
+    torch_ipex::tpp::tpp_fused_qkv_gemm<float>(
+        t_in,
+        t_wt_q,
+        t_bias_q,
+        t_wt_k,
+        t_bias_k,
+        t_wt_v,
+        t_bias_v,
+        t_out_q,
+        t_out_k,
+        t_out_v);
+  } else if (dt == at::kBFloat16) {
+    torch_ipex::tpp::tpp_fused_qkv_gemm<at::BFloat16>(
+        t_in,
+        t_wt_q,
+        t_bias_q,
+        t_wt_k,
+        t_bias_k,
+        t_wt_v,
+        t_bias_v,
+        t_out_q,
+        t_out_k,
+        t_out_v);
+  } else {
+    AT_ASSERT(
+        0,
+        "TPP does not support current weight dtype %s:%d\n",
+        __FILE__,
+        __LINE__);
+  }
+  return std::make_tuple(t_out_q, t_out_k, t_out_v);
+}
+
 } // namespace
 
 IPEX_REGISTER_DISPATCH(
@@ -251,9 +430,21 @@ IPEX_REGISTER_DISPATCH(
 IPEX_REGISTER_DISPATCH(
     tpp_linear_gelu_kernel_stub,
     &tpp_linear_gelu_kernel_impl);
+IPEX_REGISTER_DISPATCH(
+    tpp_linear_argmax_kernel_stub,
+    &tpp_linear_argmax_kernel_impl);
 IPEX_REGISTER_DISPATCH(
     tpp_fused_gate_up_proj_kernel_stub,
     &tpp_fused_gate_up_proj_kernel_impl);
+IPEX_REGISTER_DISPATCH(
+    tpp_fused_qkv_gemm_kernel_stub,
+    &tpp_fused_qkv_gemm_kernel_impl);
+IPEX_REGISTER_DISPATCH(
+    tpp_fused_gated_mlp_kernel_stub,
+    &tpp_fused_gated_mlp_kernel_impl);
+IPEX_REGISTER_DISPATCH(
+    tpp_fused_gated_mlp_add_kernel_stub,
+    &tpp_fused_gated_mlp_add_kernel_impl);
 IPEX_REGISTER_DISPATCH(
     tpp_linear_relu_kernel_stub,
     &tpp_linear_relu_kernel_impl);
@@ -20,57 +20,82 @@ using namespace torch_ipex::cpu::kernel;
 
 #if defined(CPU_CAPABILITY_AVX512)
 
-template <typename T>
-inline void update_hidden_kernel(
-    std::vector<int64_t> idx,
-    at::Tensor hidden,
-    at::Tensor hidden_prime) {
-  auto* hidden_ptr = hidden.data_ptr<T>();
-  auto* hidden_prime_ptr = hidden_prime.data_ptr<T>();
-
-  int64_t idx_len = idx.size();
-  int64_t ld = hidden.size(0);
-  int64_t bs = hidden.size(1);
-  int64_t feature_size = hidden.size(2);
-  // TODO: at::parallel_for
-  for (int64_t i = 0; i < ld; i++) {
-    for (int64_t j = 0; j < idx_len; j++) {
-      auto pos = i * bs * feature_size + idx[j] * feature_size;
-      move_ker(&hidden_ptr[pos], &hidden_prime_ptr[pos], feature_size);
-    }
-  }
-}
-
-template <typename T>
-inline void update_feature_kernel(
+// The per-frame state rebuild used to run as two serial phases: compact the
+// LSTM state of the streams that emitted a symbol, then gather the next
+// encoder frame for the streams that emitted blank. The two phases touch
+// disjoint tensors and (mostly) disjoint streams, so they are fused into a
+// single parallel region: the hx and cx row copies double-buffer through the
+// same compacted index list while the remaining workers fetch the feature
+// rows of blank streams, instead of leaving the gather serialized behind the
+// compaction on the frame's critical path.
+template <typename TH, typename TF>
+inline void update_state_fused_kernel(
+    const int32_t* idx,
+    int64_t idx_len,
+    at::Tensor hidden_0,
+    at::Tensor hidden_1,
+    const at::Tensor& hidden_prime_0,
+    const at::Tensor& hidden_prime_1,
+    bool fetch_feature,
     at::Tensor x,
     at::Tensor f,
     const at::Tensor& time_idxs,
-    int batch_size,
-    int max_len) {
-  auto* x_ptr = x.data_ptr<T>();
-  auto* f_ptr = f.data_ptr<T>();
-  int32_t* time_idxs_ptr = static_cast<int32_t*>(time_idxs.data_ptr());
-
-  int64_t time_step = x.size(1);
-  int64_t feature_size = x.size(2);
+    int64_t batch_size,
+    int64_t max_len) {
+  auto* h0_ptr = hidden_0.data_ptr<TH>();
+  auto* h1_ptr = hidden_1.data_ptr<TH>();
+  auto* hp0_ptr = hidden_prime_0.data_ptr<TH>();
+  auto* hp1_ptr = hidden_prime_1.data_ptr<TH>();
+
+  int64_t ld = hidden_0.size(0);
+  int64_t bs = hidden_0.size(1);
+  int64_t feature_size = hidden_0.size(2);
+
+  TF* x_ptr = nullptr;
+  TF* f_ptr = nullptr;
+  const int32_t* time_idxs_ptr = static_cast<int32_t*>(time_idxs.data_ptr());
+  int64_t x_feature_size = 0;
+  if (fetch_feature) {
+    x_ptr = x.data_ptr<TF>();
+    f_ptr = f.data_ptr<TF>();
+    x_feature_size = x.size(2);
+  }
 
-  at::parallel_for(0, batch_size, 16, [&](int64_t start, int64_t end) {
-    for (int i = start; i < end; i++) {
-      int fetch_time_idx = std::min(time_idxs_ptr[i], max_len - 1);
-
-      // f is a view of x: f = x[:, 0, :], f.data_ptr() ==
-      // x.data_ptr() x has been transposed: x.transpose(0, 1) shape of x: [64,
-      // 545, 1024] (bs * t * feature) stride of x: [1024, 65536, 1]
-
-      // shape of f: [64, 1024]
-      // stride of f: [1024, 1]
-      auto x_pos =
-          fetch_time_idx * batch_size * feature_size + i * feature_size;
-      auto f_pos = i * feature_size;
-      move_ker(&f_ptr[f_pos], &x_ptr[x_pos], feature_size);
-    }
-  });
+  int64_t hidden_tasks = 2 * ld * idx_len;
+  int64_t feature_tasks = fetch_feature ? batch_size : 0;
+
+  at::parallel_for(
+      0, hidden_tasks + feature_tasks, 16, [&](int64_t start, int64_t end) {
+        for (int64_t t = start; t < end; t++) {
+          if (t < hidden_tasks) {
+            int64_t r = t >> 1;
+            int64_t i = r / idx_len;
+            int64_t j = r % idx_len;
+            auto pos = i * bs * feature_size + idx[j] * feature_size;
+            if ((t & 1) == 0) {
+              move_ker(&h0_ptr[pos], &hp0_ptr[pos], feature_size);
+            } else {
+              move_ker(&h1_ptr[pos], &hp1_ptr[pos], feature_size);
+            }
+          } else {
+            int64_t i = t - hidden_tasks;
+            int64_t fetch_time_idx =
+                std::min((int64_t)time_idxs_ptr[i], max_len - 1);
+
+            // f is a view of x: f = x[:, 0, :], f.data_ptr() ==
+            // x.data_ptr() x has been transposed: x.transpose(0, 1) shape of
+            // x: [64, 545, 1024] (bs * t * feature) stride of x: [1024,
+            // 65536, 1]
+
+            // shape of f: [64, 1024]
+            // stride of f: [1024, 1]
+            auto x_pos = fetch_time_idx * batch_size * x_feature_size +
+                i * x_feature_size;
+            auto f_pos = i * x_feature_size;
+            move_ker(&f_ptr[f_pos], &x_ptr[x_pos], x_feature_size);
+          }
+        }
+      });
 }
 
 inline void label_index_put_kernel(
@@ -109,20 +134,27 @@ inline void label_index_put_kernel(
   });
 }
 
-inline void update_hidden_idx_kernel(
+inline void update_state_idx_kernel(
     at::Tensor not_blank_out,
+    const at::Tensor& blankness_out,
     at::Tensor hidden_0,
     at::Tensor hidden_1,
     const at::Tensor& hidden_prime_0,
     const at::Tensor& hidden_prime_1,
-    int64_t batch_size) {
-  std::vector<int64_t> idx;
-  int32_t* not_blank_out_ptr = static_cast<int32_t*>(not_blank_out.data_ptr());
-  // TODO: merge idx into update_hidden_kernel
-  // Have data dependency here, shouldn't be parallelled
-  for (int64_t i = 0; i < batch_size; i++) {
-    if (not_blank_out_ptr[i] != 0)
-      idx.push_back(i);
+    at::Tensor x,
+    at::Tensor f,
+    const at::Tensor& time_idxs,
+    int64_t batch_size,
+    int64_t max_len) {
+  // idx = (not_blank).nonzero(as_tuple=True)[0], via AVX512 compress store
+  std::vector<int32_t> idx(batch_size);
+  int64_t idx_len = compact_nonzero_idx(
+      static_cast<int32_t*>(not_blank_out.data_ptr()), idx.data(), batch_size);
+
+  bool fetch_feature =
+      should_update_feature(blankness_out, (int32_t)batch_size);
+  if (idx_len == 0 && !fetch_feature) {
+    return;
   }
 
   AT_ASSERTM(
@@ -132,34 +164,70 @@ inline void update_hidden_idx_kernel(
       (hidden_0.scalar_type() == at::kBFloat16 ||
        hidden_0.scalar_type() == at::kFloat),
       "only support hidden_0 to be float or bf16 tensor");
-
-  if (hidden_0.scalar_type() == at::kBFloat16) {
-    update_hidden_kernel<at::BFloat16>(idx, hidden_0, hidden_prime_0);
-    update_hidden_kernel<at::BFloat16>(idx, hidden_1, hidden_prime_1);
-  } else {
-    update_hidden_kernel<float>(idx, hidden_0, hidden_prime_0);
-    update_hidden_kernel<float>(idx, hidden_1, hidden_prime_1);
-  }
-}
-
-inline void update_feature_idx_kernel(
-    const at::Tensor& blankness_out,
-    at::Tensor x,
-    at::Tensor f,
-    const at::Tensor& time_idxs,
-    int64_t batch_size,
-    int64_t max_len) {
-  if (should_update_feature(blankness_out, (int32_t)batch_size)) {
+  if (fetch_feature) {
     AT_ASSERTM(
         (x.scalar_type() == at::kBFloat16 || x.scalar_type() == at::kFloat),
         "only support x to be float or bf16 tensor");
-    if (x.scalar_type() == at::kBFloat16) {
-      update_feature_kernel<at::BFloat16>(
-          x, f, time_idxs, (int32_t)batch_size, (int32_t)max_len);
-    } else {
-      update_feature_kernel<float>(
-          x, f, time_idxs, (int32_t)batch_size, (int32_t)max_len);
-    }
+  }
+
+  bool hidden_bf16 = hidden_0.scalar_type() == at::kBFloat16;
+  bool x_bf16 = fetch_feature && x.scalar_type() == at::kBFloat16;
+  if (hidden_bf16 && x_bf16) {
+    update_state_fused_kernel<at::BFloat16, at::BFloat16>(
+        idx.data(),
+        idx_len,
+        hidden_0,
+        hidden_1,
+        hidden_prime_0,
+        hidden_prime_1,
+        fetch_feature,
+        x,
+        f,
+        time_idxs,
+        batch_size,
+        max_len);
+  } else if (hidden_bf16) {
+    update_state_fused_kernel<at::BFloat16, float>(
+        idx.data(),
+        idx_len,
+        hidden_0,
+        hidden_1,
+        hidden_prime_0,
+        hidden_prime_1,
+        fetch_feature,
+        x,
+        f,
+        time_idxs,
+        batch_size,
+        max_len);
+  } else if (x_bf16) {
+    update_state_fused_kernel<float, at::BFloat16>(
+        idx.data(),
+        idx_len,
+        hidden_0,
+        hidden_1,
+        hidden_prime_0,
+        hidden_prime_1,
+        fetch_feature,
+        x,
+        f,
+        time_idxs,
+        batch_size,
+        max_len);
+  } else {
+    update_state_fused_kernel<float, float>(
+        idx.data(),
+        idx_len,
+        hidden_0,
+        hidden_1,
+        hidden_prime_0,
+        hidden_prime_1,
+        fetch_feature,
+        x,
+        f,
+        time_idxs,
+        batch_size,
+        max_len);
   }
 }
 #endif
@@ -260,19 +328,23 @@ bool rnnt_update_batch_kernel_impl(
   // idx = (not_blank).nonzero(as_tuple=True)[0]
   // hidden[0][:, idx, :] = hidden_prime[0][:, idx, :]
   // hidden[1][:, idx, :] = hidden_prime[1][:, idx, :]
-  update_hidden_idx_kernel(
+  // if blankness.nonzero().size(0) > 0:
+  //     fetch_time_idxs = time_idxs.min(max_lens)
+  //     f = x[label_row_list, fetch_time_idxs, :]
+  // (the hidden compaction and the feature fetch run in one fused parallel
+  // region, see update_state_fused_kernel)
+  update_state_idx_kernel(
       not_blank_out,
+      blankness_out,
       hidden_0,
       hidden_1,
       hidden_prime_0,
       hidden_prime_1,
-      batch_size);
-
-  // if blankness.nonzero().size(0) > 0:
-  //     fetch_time_idxs = time_idxs.min(max_lens)
-  //     f = x[label_row_list, fetch_time_idxs, :]
-  update_feature_idx_kernel(
-      blankness_out, x, f, time_idxs, batch_size, max_len);
+      x,
+      f,
+      time_idxs,
+      batch_size,
+      max_len);
   return BatchStatus::UnFinished;
 #else
   // label_row = torch.tensor([i for i in range(batch_size)])
@@ -2464,6 +2464,120 @@ struct Function_matching<T1, T2, has_bias, 0> {
   }
 };
 
+#if defined(CPU_CAPABILITY_AVX512)
+// GEMV-style fast path for the per-tensor path at batch-1..4 decode.
+// The large-M brgemm tiling wastes bandwidth when only a few activation
+// rows exist; here each weight row is streamed exactly once, the int8 ->
+// fp32 conversion feeds the FMA directly, and the zero point folds into a
+// compensation term (scale * (dot - zp * sum(A_row))) so no per-element
+// subtraction is needed. BLOCK_M is the actual M so the row loops unroll.
+template <bool has_bias, int BLOCK_M>
+void woq_gemv_per_tensor(
+    float* A,
+    int8_t* B,
+    float* C,
+    int M,
+    int N,
+    int K,
+    int lda,
+    int ldb,
+    int ldc,
+    float scale,
+    float zero_point,
+    float* bias = NULL) {
+  // Row sums of A for the zero-point compensation term
+  float a_sum[BLOCK_M];
+  for (int m = 0; m < BLOCK_M; m++) {
+    __m512 vsum = _mm512_setzero_ps();
+    int k = 0;
+    for (; k <= K - 16; k += 16) {
+      vsum = _mm512_add_ps(vsum, _mm512_loadu_ps(A + m * lda + k));
+    }
+    float sum = _mm512_reduce_add_ps(vsum);
+    for (; k < K; k++) {
+      sum += A[m * lda + k];
+    }
+    a_sum[m] = sum;
+  }
+#pragma omp parallel for
+  for (int n = 0; n < N; n++) {
+    __m512 acc[BLOCK_M];
+    float tail[BLOCK_M];
+    for (int m = 0; m < BLOCK_M; m++) {
+      acc[m] = _mm512_setzero_ps();
+      tail[m] = 0.f;
+    }
+    int k = 0;
+    for (; k <= K - 16; k += 16) {
+      auto vb = _mm512_cvtepi32_ps(
+          _mm512_cvtepi8_epi32(_mm_loadu_si128((__m128i*)(B + n * ldb + k))));
+      for (int m = 0; m < BLOCK_M; m++) {
+        acc[m] = _mm512_fmadd_ps(_mm512_loadu_ps(A + m * lda + k), vb, acc[m]);
+      }
+    }
+    for (; k < K; k++) {
+      float b_val = (float)B[n * ldb + k];
+      for (int m = 0; m < BLOCK_M; m++) {
+        tail[m] += A[m * lda + k] * b_val;
+      }
+    }
+    for (int m = 0; m < BLOCK_M; m++) {
+      float dot = _mm512_reduce_add_ps(acc[m]) + tail[m];
+      float res = scale * (dot - zero_point * a_sum[m]);
+      if constexpr (has_bias) {
+        res += bias[n];
+      }
+      C[m * ldc + n] = res;
+    }
+  }
+}
+
+// function matching for M = 1..4, same idiom as Function_matching above
+template <bool has_bias, int BLOCK_M>
+struct GemvPerTensorMatching {
+  static void func_match(
+      float* A,
+      int8_t* B,
+      float* C,
+      int M,
+      int N,
+      int K,
+      int lda,
+      int ldb,
+      int ldc,
+      float scale,
+      float zero_point,
+      float* bias = NULL) {
+    if (M == BLOCK_M) {
+      woq_gemv_per_tensor<has_bias, BLOCK_M>(
+          A, B, C, M, N, K, lda, ldb, ldc, scale, zero_point, bias);
+    } else {
+      GemvPerTensorMatching<has_bias, BLOCK_M - 1>::func_match(
+          A, B, C, M, N, K, lda, ldb, ldc, scale, zero_point, bias);
+    }
+  }
+};
+
+template <bool has_bias>
+struct GemvPerTensorMatching<has_bias, 0> {
+  static void func_match(
+      float* A,
+      int8_t* B,
+      float* C,
+      int M,
+      int N,
+      int K,
+      int lda,
+      int ldb,
+      int ldc,
+      float scale,
+      float zero_point,
+      float* bias = NULL) {
+    TORCH_CHECK(false, "WOQ GEMV: unreachable M");
+  }
+};
+#endif
+
 void woq_gemm_kernel_impl(
     const at::Tensor& self,
     const at::Tensor& weight,
@@ -2494,6 +2608,21 @@ void woq_gemm_kernel_impl(
     if (bias.defined()) {
       auto bias_ = bias.is_contiguous() ? bias : bias.contiguous();
       auto bias_ptr = bias_.data_ptr<float>();
+      if (M <= 4) { // small M: GEMV fast path for decode
+        return GemvPerTensorMatching<true, 4>::func_match(
+            in_ptr,
+            weight_ptr,
+            out_ptr,
+            M,
+            N,
+            K,
+            K,
+            K,
+            N,
+            scales_float_ptr[0],
+            zero_points_float_ptr[0],
+            bias_ptr);
+      }
       return woq_gemm_brgemm_per_tensor<true, 24>(
           in_ptr,
           weight_ptr,
@@ -2508,6 +2637,20 @@ void woq_gemm_kernel_impl(
           zero_points_float_ptr[0],
           bias_ptr);
     } else {
+      if (M <= 4) { // small M: GEMV fast path for decode
+        return GemvPerTensorMatching<false, 4>::func_match(
+            in_ptr,
+            weight_ptr,
+            out_ptr,
+            M,
+            N,
+            K,
+            K,
+            K,
+            N,
+            scales_float_ptr[0],
+            zero_points_float_ptr[0]);
+      }
       return woq_gemm_brgemm_per_tensor<false, 24>(
           in_ptr,
           weight_ptr,
@@ -5,6 +5,7 @@
 #include <ATen/cpu/vec/functional.h>
 #include <ATen/cpu/vec/vec.h>
 #include <aten/Linear.h>
+#include <limits>
 #include "csrc/cpu/tpp/woq/tla.h"
 
 #ifdef __GNUC__
@@ -34,13 +35,14 @@ using TensorList = std::vector<at::Tensor>;
 #define QINT8 1
 #define QINT4 2
 #define NF4 3
+#define FP4 4
 
 constexpr bool is_4bit(const int qw_type) {
-  return qw_type == QINT4 || qw_type == NF4;
+  return qw_type == QINT4 || qw_type == NF4 || qw_type == FP4;
 }
 
 constexpr bool is_sym_quant(const int qw_type) {
-  return qw_type == NF4;
+  return qw_type == NF4 || qw_type == FP4;
 }
 
 static constexpr std::array<float, 16> NF4_QUANT_TABLE = {
@@ -107,6 +109,58 @@ at::Tensor map_nf4_tensor_to_float(const at::Tensor& t) {
   return out_dq;
 }
 
+// FP4 (e2m1) code points normalized to [-1, 1] so the NF4 scale convention
+// (scale = group absmax) carries over unchanged. The bit pattern is
+// sign-magnitude: index = s|e1|e0|m, i.e. codes 8..15 mirror 0..7 negated.
+static constexpr std::array<float, 16> FP4_DEQUANT_TABLE = {
+    0.0, // 0b0000
+    0.08333333333333333, // 0b0001
+    0.16666666666666666, // 0b0010
+    0.25, // 0b0011
+    0.3333333333333333, // 0b0100
+    0.5, // 0b0101
+    0.6666666666666666, // 0b0110
+    1.0, // 0b0111
+    -0.0, // 0b1000
+    -0.08333333333333333, // 0b1001
+    -0.16666666666666666, // 0b1010
+    -0.25, // 0b1011
+    -0.3333333333333333, // 0b1100
+    -0.5, // 0b1101
+    -0.6666666666666666, // 0b1110
+    -1.0, // 0b1111
+};
+
+at::Tensor map_float_tensor_to_fp4(const at::Tensor& t) {
+  // Map [-1, 1] to fp4. The fp4 codes are not monotonic in the bit pattern,
+  // so map each value to the nearest table entry instead of thresholding.
+  using namespace at::indexing;
+  auto out_uint8 = at::zeros(t.sizes(), t.options().dtype(at::kByte));
+  auto min_dist = at::full(
+      t.sizes(),
+      std::numeric_limits<float>::infinity(),
+      t.options().dtype(at::kFloat));
+  for (size_t i = 0; i < FP4_DEQUANT_TABLE.size(); ++i) {
+    auto dist = t.sub(FP4_DEQUANT_TABLE[i]).abs_();
+    out_uint8.index_put_({dist.less(min_dist)}, i);
+    min_dist = at::minimum(min_dist, dist);
+  }
+  return out_uint8;
+}
+
+at::Tensor map_fp4_tensor_to_float(const at::Tensor& t) {
+  // Map fp4 to [-1, 1], t is already unpacked as uint8
+  // Logic:
+  // for i in range(len(FP4_DEQUANT_TABLE)):
+  //     out_dq[t == i] = FP4_DEQUANT_TABLE[i]
+  using namespace at::indexing;
+  auto out_dq = at::empty(t.sizes(), t.options().dtype(at::kFloat));
+  for (size_t i = 0; i < FP4_DEQUANT_TABLE.size(); ++i) {
+    out_dq.index_put_({t.eq(i)}, FP4_DEQUANT_TABLE[i]);
+  }
+  return out_dq;
+}
+
 // We only build optimized kernels if AVX512_FP16 is supported and gcc>=12.3
 // Otherwise we just return empty results
 // TODO(Weiwen) Merge WoqTppKrnl.cpp and WoqLinearKrnl.cpp and put the latter in
@@ -633,7 +687,9 @@ struct GemmMicroKernel<
     constexpr bool is_4bit_flag = is_4bit(qw_type);
     constexpr bool sym_quant = is_sym_quant(qw_type);
     if constexpr (is_4bit_flag) {
-      lut = qw_type == NF4 ? V::set_nf4_lut() : V::set_0_to_15();
+      lut = qw_type == NF4 ? V::set_nf4_lut()
+          : qw_type == FP4 ? V::set_fp4_lut()
+                           : V::set_0_to_15();
     }
 
     // Load scales and zps
@@ -788,17 +844,23 @@ struct GemmMicroKernel<
     __m512i vb[COLS];
     __m512i vc[M * COLS];
     __m512 vscales[COLS];
-    __m512i vzps[COLS];
+    __m512i vzps32[COLS];
     __m512i vcompensate[COLS];
+    __m512i va_sum[M];
 
-    // Load scales and zps
+    // Load scales and zps. The weight zero points are not subtracted in the
+    // inner loop; they fold into the compensation term in the epilogue:
+    //   sum(qa * (qb - zp_b)) = sum(qa * qb) - zp_b * sum(qa)
+    //   sum(qb - zp_b) = sum(qb) - K * zp_b
+    // so the k loop runs dpbusd on the raw quantized weights only.
     compile_time_for<COLS>::op([&](auto i) {
       vscales[i] = _mm512_loadu_ps(scales + i * 16);
-      // TODO(jgong5): should we use 512 or two 256 here?
-      vzps[i] = combine_m256i(load_zps_4vnni(zps + i * 16));
+      vzps32[i] = _mm512_cvtepi8_epi32(
+          _mm_loadu_si128(reinterpret_cast<__m128i*>(zps + i * 16)));
       vcompensate[i] = _mm512_setzero_epi32();
     });
 
+    compile_time_for<M>::op([&](auto i) { va_sum[i] = _mm512_setzero_epi32(); });
     compile_time_for<M * COLS>::op(
         [&](auto i) { vc[i] = _mm512_setzero_epi32(); });
 
@@ -812,11 +874,12 @@ struct GemmMicroKernel<
         } else {
           va = _mm512_set1_epi32(*(int32_t*)ADDRESS(A, row, k, lda));
         }
+        // all lanes hold the same partial sum of the activation row
+        va_sum[row] = _mm512_dpbusd_epi32(va_sum[row], va, ones);
       }
 
       if constexpr (row == 0) {
         vb[col] = combine_m256i(load_int4_as_int8(pqB[k / 4][col * 16]));
-        vb[col] = _mm512_sub_epi8(vb[col], vzps[col]);
         vcompensate[col] = _mm512_dpbusd_epi32(vcompensate[col], ones, vb[col]);
         if constexpr (PREFETCH_K_DIST > 0) {
           _mm_prefetch(pqB[(k + PREFETCH_K_DIST) / 4][col * 16], _MM_HINT_T0);
@@ -839,13 +902,24 @@ struct GemmMicroKernel<
       compile_time_for<M * COLS>::op(compute, k);
     }
 
+    // Fold the weight zero points into the raw sums:
+    //   compensate = sum(qb) - K * zp_b
+    //   qC = sum(qa * qb) - zp_b * sum(qa)
+    compile_time_for<COLS>::op([&](auto i) {
+      vcompensate[i] = _mm512_sub_epi32(
+          vcompensate[i],
+          _mm512_mullo_epi32(vzps32[i], _mm512_set1_epi32((int32_t)K)));
+    });
+
     // Store to C
     auto store = [&](auto i) {
       constexpr const int row = i / COLS;
       constexpr const int col = i % COLS;
-      // compute (qC - compensate * zp_a) * scale_a * scale_b
-      // where compensate = sum(qB)
+      // compute (qC - zp_b * sum(qa) - compensate * zp_a) * scale_a * scale_b
+      // where compensate = sum(qb) - K * zp_b
       __m512 vc_float;
+      vc[i] = _mm512_sub_epi32(
+          vc[i], _mm512_mullo_epi32(vzps32[col], va_sum[row]));
       if constexpr (
           quant_a_mode == QUANT_A_PER_TENSOR ||
           quant_a_mode == QUANT_A_PER_K_BLOCK) {
@@ -1049,7 +1123,9 @@ struct Dequantize<float, ldb, N_GROUP_SIZE, qw_type> {
     constexpr bool is_4bit_flag = is_4bit(qw_type);
     constexpr bool sym_quant = is_sym_quant(qw_type);
     if constexpr (is_4bit_flag) {
-      lut = qw_type == NF4 ? V::set_nf4_lut() : V::set_0_to_15();
+      lut = qw_type == NF4 ? V::set_nf4_lut()
+          : qw_type == FP4 ? V::set_fp4_lut()
+                           : V::set_0_to_15();
     }
 
     dequant_n_grouped<float, ldb, N_GROUP_SIZE, qw_type>::call(
@@ -1103,7 +1179,9 @@ struct Dequantize<bfloat16, ldb, N_GROUP_SIZE, qw_type> {
     constexpr bool is_4bit_flag = is_4bit(qw_type);
     constexpr bool sym_quant = is_sym_quant(qw_type);
     if constexpr (is_4bit_flag) {
-      lut = qw_type == NF4 ? V::set_nf4_lut() : V::set_0_to_15();
+      lut = qw_type == NF4 ? V::set_nf4_lut()
+          : qw_type == FP4 ? V::set_fp4_lut()
+                           : V::set_0_to_15();
     }
 
     dequant_n_grouped<bfloat16, ldb, N_GROUP_SIZE, qw_type>::call(
@@ -1160,7 +1238,9 @@ struct Dequantize<half, ldb, N_GROUP_SIZE, qw_type> {
     constexpr bool is_4bit_flag = is_4bit(qw_type);
     constexpr bool sym_quant = is_sym_quant(qw_type);
     if constexpr (is_4bit_flag) {
-      lut = qw_type == NF4 ? V::set_nf4_lut() : V::set_0_to_15();
+      lut = qw_type == NF4 ? V::set_nf4_lut()
+          : qw_type == FP4 ? V::set_fp4_lut()
+                           : V::set_0_to_15();
     }
 
     dequant_n_grouped<half, ldb, N_GROUP_SIZE, qw_type>::call(
@@ -1675,8 +1755,23 @@ void qlinear_woq_affine_impl(
 
   auto BLOCK_M_rem = M % BLOCK_M;
 
-  // TODO(jgong5): use heuristics to decide k_splits
-  if (k_splits <= 0 || M >= 32 || BLOCK_M_rem) {
+  // Decide k_splits: with batch <= 4 the Nc blocks alone cannot feed all
+  // threads on many-core parts, so split the K blocks into partial sums
+  // held in thread-private buffers and reduced at the end. A non-positive
+  // value requests the heuristic: the smallest power-of-two split that
+  // covers the thread pool while keeping a few K blocks per slice.
+  if (M >= 32 || BLOCK_M_rem) {
+    k_splits = 1;
+  } else if (k_splits <= 0) {
+    k_splits = 1;
+    if (M <= 4) {
+      auto num_threads = omp_get_max_threads();
+      while (Nc * k_splits < num_threads && Kc % (k_splits * 2) == 0 &&
+             Kc / (k_splits * 2) >= 4) {
+        k_splits *= 2;
+      }
+    }
+  } else if (Kc % k_splits != 0) {
     k_splits = 1;
   }
   TLA_ASSERT(Kc % k_splits == 0, "Kc must be a multiple of k_splits");
@@ -1761,7 +1856,7 @@ void qlinear_woq_affine_impl(
       std::tuple</*BLOCK_N*/ long, /*qw_type*/ int>,
       std::tuple<
           enumerate_dispatcher<long, 16, 32, 64, 128>,
-          enumerate_dispatcher<int, QINT8, QINT4, NF4>>>::
+          enumerate_dispatcher<int, QINT8, QINT4, NF4, FP4>>>::
       call(
           std::make_tuple(Nb, qw_type),
           [&](auto tuple) {
@@ -3253,7 +3348,8 @@ at::Tensor qlinear_woq_affine(
     int64_t quant_a_mode = -1,
     int64_t quant_w_mode = 0,
     int64_t quant_block_k = 0) {
-  const int64_t k_splits = 0;
+  // 0 = auto heuristic, 1 = disable, > 1 = forced number of K slices
+  static const int64_t k_splits = env2int("IPEX_WOQ_K_SPLITS", 0);
   // int8_idx is only valid with zp_list when lowp_mode == LOWP_MODE_INT8
   constexpr size_t fp32_idx = 0, fp16_idx = 1, bf16_idx = 2, int8_idx = 3;
   auto biases = bias_list.empty()
@@ -3613,15 +3709,16 @@ at::Tensor qlinear_woq_affine(
     }
     at::Tensor scale, zp;
     scale = scales_list[fp32_idx].unsqueeze(-1);
-    if (qw_type != NF4) {
+    if (!sym_quant) {
       zp = zp_list[fp32_idx].unsqueeze(-1);
     }
     auto w =
         [&]() {
           at::Tensor dqw;
-          if (qw_type == NF4) {
+          if (qw_type == NF4 || qw_type == FP4) {
             TLA_ASSERT(
-                sym_quant, "Weight must be symmetrically quantized for NF4");
+                sym_quant,
+                "Weight must be symmetrically quantized for NF4/FP4");
             using namespace at::indexing;
             auto w_int8 =
                 at::empty({N, qw.size(1) * 2}, qw.options().dtype(at::kByte));
@@ -3629,7 +3726,8 @@ at::Tensor qlinear_woq_affine(
                 .copy_(qw.bitwise_and(0xf));
             w_int8.index({Slice(), Slice(1, None, 2)})
                 .copy_(qw.bitwise_right_shift(4));
-            auto w_ret = map_nf4_tensor_to_float(w_int8);
+            auto w_ret = qw_type == NF4 ? map_nf4_tensor_to_float(w_int8)
+                                        : map_fp4_tensor_to_float(w_int8);
             if (quant_w_mode == 0) {
               dqw = w_ret * scale;
             } else {
@@ -3742,15 +3840,15 @@ at::Tensor qlinear_woq_affine(
   }
   at::Tensor scale, zp;
   scale = scales_list[fp32_idx].unsqueeze(-1);
-  if (qw_type != NF4) {
+  if (!sym_quant) {
     zp = zp_list[fp32_idx].unsqueeze(-1);
   }
   auto w =
       [&]() {
         at::Tensor dqw;
-        if (qw_type == NF4) {
+        if (qw_type == NF4 || qw_type == FP4) {
           TLA_ASSERT(
-              sym_quant, "Weight must be symmetrically quantized for NF4");
+              sym_quant, "Weight must be symmetrically quantized for NF4/FP4");
           using namespace at::indexing;
           auto w_int8 =
               at::empty({N, qw.size(1) * 2}, qw.options().dtype(at::kByte));
@@ -3758,7 +3856,8 @@ at::Tensor qlinear_woq_affine(
               .copy_(qw.bitwise_and(0xf));
           w_int8.index({Slice(), Slice(1, None, 2)})
               .copy_(qw.bitwise_right_shift(4));
-          auto w_ret = map_nf4_tensor_to_float(w_int8);
+          auto w_ret = qw_type == NF4 ? map_nf4_tensor_to_float(w_int8)
+                                      : map_fp4_tensor_to_float(w_int8);
           if (quant_w_mode == 0) {
             dqw = w_ret * scale;
           } else {
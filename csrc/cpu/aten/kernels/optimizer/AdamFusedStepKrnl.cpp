@@ -3,6 +3,9 @@
 
 #include <torch/all.h>
 #include <torch/csrc/autograd/function.h>
+
+#include <vector>
+
 namespace torch_ipex {
 namespace cpu {
 
@@ -10,6 +13,254 @@ namespace {
 
 using namespace at::vec;
 
+// Adam update for one flat range of elements. The per-tensor kernels below
+// call this from their own parallel regions; the multi-tensor kernel calls it
+// per chunk so hundreds of small parameters share a single parallel region.
+template <typename scalar_t>
+inline void adam_step_range(
+    scalar_t* param_ptr,
+    scalar_t* exp_avg_ptr,
+    scalar_t* exp_avg_sq_ptr,
+    scalar_t* max_exp_avg_sq_ptr,
+    scalar_t* grad_ptr,
+    int64_t size,
+    bool amsgrad,
+    scalar_t beta1,
+    scalar_t beta2,
+    scalar_t exp_avg_grad_coefficient,
+    scalar_t exp_avg_sq_grad_coefficient,
+    scalar_t step_size,
+    scalar_t bias_correction2,
+    scalar_t weight_decay,
+    scalar_t eps) {
+  using Vec = at::vec::Vectorized<scalar_t>;
+
+  int64_t d = 0;
+  for (; d < size - (size % Vec::size()); d += Vec::size()) {
+    Vec param_vec = Vec::loadu(param_ptr + d);
+    Vec grad_vec = Vec::loadu(grad_ptr + d) + param_vec * Vec(weight_decay);
+    Vec exp_avg_vec = Vec::loadu(exp_avg_ptr + d) * Vec(beta1) +
+        grad_vec * Vec(exp_avg_grad_coefficient);
+    Vec exp_avg_sq_vec = Vec::loadu(exp_avg_sq_ptr + d) * Vec(beta2) +
+        grad_vec * grad_vec * Vec(exp_avg_sq_grad_coefficient);
+    exp_avg_vec.store(exp_avg_ptr + d);
+    exp_avg_sq_vec.store(exp_avg_sq_ptr + d);
+
+    Vec denom_vec;
+    if (amsgrad) {
+      Vec max_exp_avg_sq_vec =
+          maximum(Vec::loadu(max_exp_avg_sq_ptr + d), exp_avg_sq_vec);
+      max_exp_avg_sq_vec.store(max_exp_avg_sq_ptr + d);
+      denom_vec = (max_exp_avg_sq_vec / Vec(bias_correction2)).sqrt() + Vec(eps);
+    } else {
+      denom_vec = (exp_avg_sq_vec / Vec(bias_correction2)).sqrt() + Vec(eps);
+    }
+
+    param_vec = param_vec - Vec(step_size) * exp_avg_vec / denom_vec;
+    param_vec.store(param_ptr + d);
+  }
+  for (; d < size; d++) {
+    scalar_t grad_val = grad_ptr[d] + param_ptr[d] * weight_decay;
+    exp_avg_ptr[d] = exp_avg_ptr[d] * beta1 + grad_val * exp_avg_grad_coefficient;
+    exp_avg_sq_ptr[d] = exp_avg_sq_ptr[d] * beta2 +
+        grad_val * grad_val * (exp_avg_sq_grad_coefficient);
+    scalar_t demon_val;
+    if (amsgrad) {
+      max_exp_avg_sq_ptr[d] = std::max(max_exp_avg_sq_ptr[d], exp_avg_sq_ptr[d]);
+      demon_val = std::sqrt(max_exp_avg_sq_ptr[d] / bias_correction2) + eps;
+    } else {
+      demon_val = std::sqrt(exp_avg_sq_ptr[d] / bias_correction2) + eps;
+    }
+    param_ptr[d] = param_ptr[d] - step_size * exp_avg_ptr[d] / demon_val;
+  }
+}
+
+// Split bf16 path: bf16 param + bf16 trail packed into fp32 for computation.
+inline void adam_step_range(
+    at::BFloat16* param_ptr,
+    at::BFloat16* param2_ptr,
+    float* exp_avg_ptr,
+    float* exp_avg_sq_ptr,
+    float* max_exp_avg_sq_ptr,
+    at::BFloat16* grad_ptr,
+    int64_t size,
+    bool amsgrad,
+    float beta1,
+    float beta2,
+    float exp_avg_grad_coefficient,
+    float exp_avg_sq_grad_coefficient,
+    float step_size,
+    float bias_correction2,
+    float weight_decay,
+    float eps) {
+  using bVec = at::vec::Vectorized<at::BFloat16>;
+  using fVec = at::vec::Vectorized<float>;
+
+  int64_t d = 0;
+  for (; d < size - (size % bVec::size()); d += bVec::size()) {
+    // load grad vec
+    bVec grad_bvec = bVec::loadu(grad_ptr + d);
+    fVec grad_fvec, grad_fvec2;
+    std::tie(grad_fvec, grad_fvec2) = convert_bfloat16_float(grad_bvec);
+    // load param vec
+    bVec param_bvec = bVec::loadu(param_ptr + d);
+    bVec param2_bvec = bVec::loadu(param2_ptr + d);
+    fVec param_fvec, param_fvec2;
+    std::tie(param_fvec, param_fvec2) =
+        at::vec::pack_bfloat16_float(param_bvec, param2_bvec);
+    // weight decay
+    grad_fvec = grad_fvec + param_fvec * fVec(weight_decay);
+    grad_fvec2 = grad_fvec2 + param_fvec2 * fVec(weight_decay);
+    // update exp_avg, exp_avg_sq
+    fVec exp_avg_fvec = fVec::loadu(exp_avg_ptr + d) * fVec(beta1) +
+        grad_fvec * fVec(exp_avg_grad_coefficient);
+    fVec exp_avg_fvec2 = fVec::loadu(exp_avg_ptr + d + fVec::size()) * fVec(beta1) +
+        grad_fvec2 * fVec(exp_avg_grad_coefficient);
+    exp_avg_fvec.store(exp_avg_ptr + d);
+    exp_avg_fvec2.store(exp_avg_ptr + d + fVec::size());
+    fVec exp_avg_sq_fvec = fVec::loadu(exp_avg_sq_ptr + d) * fVec(beta2) +
+        grad_fvec * grad_fvec * fVec(exp_avg_sq_grad_coefficient);
+    fVec exp_avg_sq_fvec2 =
+        fVec::loadu(exp_avg_sq_ptr + d + fVec::size()) * fVec(beta2) +
+        grad_fvec2 * grad_fvec2 * fVec(exp_avg_sq_grad_coefficient);
+    exp_avg_sq_fvec.store(exp_avg_sq_ptr + d);
+    exp_avg_sq_fvec2.store(exp_avg_sq_ptr + d + fVec::size());
+    // amsgrad
+    fVec denom_fvec, denom_fvec2;
+    if (amsgrad) {
+      fVec max_exp_avg_sq_fvec =
+          maximum(fVec::loadu(max_exp_avg_sq_ptr + d), exp_avg_sq_fvec);
+      fVec max_exp_avg_sq_fvec2 = maximum(
+          fVec::loadu(max_exp_avg_sq_ptr + d + fVec::size()), exp_avg_sq_fvec2);
+      max_exp_avg_sq_fvec.store(max_exp_avg_sq_ptr + d);
+      max_exp_avg_sq_fvec2.store(max_exp_avg_sq_ptr + d + fVec::size());
+      denom_fvec =
+          (max_exp_avg_sq_fvec / fVec(bias_correction2)).sqrt() + fVec(eps);
+      denom_fvec2 =
+          (max_exp_avg_sq_fvec2 / fVec(bias_correction2)).sqrt() + fVec(eps);
+    } else {
+      denom_fvec = (exp_avg_sq_fvec / fVec(bias_correction2)).sqrt() + fVec(eps);
+      denom_fvec2 =
+          (exp_avg_sq_fvec2 / fVec(bias_correction2)).sqrt() + fVec(eps);
+    }
+    // update param
+    param_fvec = param_fvec - fVec(step_size) * exp_avg_fvec / denom_fvec;
+    param_fvec2 = param_fvec2 - fVec(step_size) * exp_avg_fvec2 / denom_fvec2;
+    std::tie(param_bvec, param2_bvec) =
+        at::vec::unpack_float_bfloat16(param_fvec, param_fvec2);
+    param_bvec.store(param_ptr + d);
+    param2_bvec.store(param2_ptr + d);
+  }
+  for (; d < size; d++) {
+    float param_val = at::vec::pack_bfloat16_float(param_ptr[d], param2_ptr[d]);
+    float grad_val = float(grad_ptr[d]) + param_val * weight_decay;
+    exp_avg_ptr[d] = exp_avg_ptr[d] * beta1 + grad_val * exp_avg_grad_coefficient;
+    exp_avg_sq_ptr[d] = exp_avg_sq_ptr[d] * beta2 +
+        grad_val * grad_val * exp_avg_sq_grad_coefficient;
+    float demon_val;
+    if (amsgrad) {
+      max_exp_avg_sq_ptr[d] = std::max(max_exp_avg_sq_ptr[d], exp_avg_sq_ptr[d]);
+      demon_val = std::sqrt(max_exp_avg_sq_ptr[d] / bias_correction2) + eps;
+    } else {
+      demon_val = std::sqrt(exp_avg_sq_ptr[d] / bias_correction2) + eps;
+    }
+    param_val = param_val - step_size * exp_avg_ptr[d] / demon_val;
+    std::tie(param_ptr[d], param2_ptr[d]) =
+        at::vec::unpack_float_bfloat16(param_val);
+  }
+}
+
+// Master weight path: fp32 param + bf16 grad, bf16 copy kept in sync.
+inline void adam_step_range(
+    float* param_ptr,
+    at::BFloat16* param2_ptr,
+    float* exp_avg_ptr,
+    float* exp_avg_sq_ptr,
+    float* max_exp_avg_sq_ptr,
+    at::BFloat16* grad_ptr,
+    int64_t size,
+    bool amsgrad,
+    float beta1,
+    float beta2,
+    float exp_avg_grad_coefficient,
+    float exp_avg_sq_grad_coefficient,
+    float step_size,
+    float bias_correction2,
+    float weight_decay,
+    float eps) {
+  using bVec = at::vec::Vectorized<at::BFloat16>;
+  using fVec = at::vec::Vectorized<float>;
+
+  int64_t d = 0;
+  for (; d < size - (size % bVec::size()); d += bVec::size()) {
+    // load grad vec
+    bVec grad_bvec = bVec::loadu(grad_ptr + d);
+    fVec grad_fvec, grad_fvec2;
+    std::tie(grad_fvec, grad_fvec2) = convert_bfloat16_float(grad_bvec);
+    // load param vec
+    fVec param_fvec = fVec::loadu(param_ptr + d);
+    fVec param_fvec2 = fVec::loadu(param_ptr + d + fVec::size());
+    // weight decay
+    grad_fvec = grad_fvec + param_fvec * fVec(weight_decay);
+    grad_fvec2 = grad_fvec2 + param_fvec2 * fVec(weight_decay);
+    // update exp_avg, exp_avg_sq
+    fVec exp_avg_fvec = fVec::loadu(exp_avg_ptr + d) * fVec(beta1) +
+        grad_fvec * fVec(exp_avg_grad_coefficient);
+    fVec exp_avg_fvec2 = fVec::loadu(exp_avg_ptr + d + fVec::size()) * fVec(beta1) +
+        grad_fvec2 * fVec(exp_avg_grad_coefficient);
+    exp_avg_fvec.store(exp_avg_ptr + d);
+    exp_avg_fvec2.store(exp_avg_ptr + d + fVec::size());
+    fVec exp_avg_sq_fvec = fVec::loadu(exp_avg_sq_ptr + d) * fVec(beta2) +
+        grad_fvec * grad_fvec * fVec(exp_avg_sq_grad_coefficient);
+    fVec exp_avg_sq_fvec2 =
+        fVec::loadu(exp_avg_sq_ptr + d + fVec::size()) * fVec(beta2) +
+        grad_fvec2 * grad_fvec2 * fVec(exp_avg_sq_grad_coefficient);
+    exp_avg_sq_fvec.store(exp_avg_sq_ptr + d);
+    exp_avg_sq_fvec2.store(exp_avg_sq_ptr + d + fVec::size());
+    // amsgrad
+    fVec denom_fvec, denom_fvec2;
+    if (amsgrad) {
+      fVec max_exp_avg_sq_fvec =
+          maximum(fVec::loadu(max_exp_avg_sq_ptr + d), exp_avg_sq_fvec);
+      fVec max_exp_avg_sq_fvec2 = maximum(
+          fVec::loadu(max_exp_avg_sq_ptr + d + fVec::size()), exp_avg_sq_fvec2);
+      max_exp_avg_sq_fvec.store(max_exp_avg_sq_ptr + d);
+      max_exp_avg_sq_fvec2.store(max_exp_avg_sq_ptr + d + fVec::size());
+      denom_fvec =
+          (max_exp_avg_sq_fvec / fVec(bias_correction2)).sqrt() + fVec(eps);
+      denom_fvec2 =
+          (max_exp_avg_sq_fvec2 / fVec(bias_correction2)).sqrt() + fVec(eps);
+    } else {
+      denom_fvec = (exp_avg_sq_fvec / fVec(bias_correction2)).sqrt() + fVec(eps);
+      denom_fvec2 =
+          (exp_avg_sq_fvec2 / fVec(bias_correction2)).sqrt() + fVec(eps);
+    }
+    // update param
+    param_fvec = param_fvec - fVec(step_size) * exp_avg_fvec / denom_fvec;
+    param_fvec2 = param_fvec2 - fVec(step_size) * exp_avg_fvec2 / denom_fvec2;
+    param_fvec.store(param_ptr + d);
+    param_fvec2.store(param_ptr + d + fVec::size());
+    // sync float param to bfloat16
+    bVec param2_bvec = convert_float_bfloat16(param_fvec, param_fvec2);
+    param2_bvec.store(param2_ptr + d);
+  }
+  for (; d < size; d++) {
+    float grad_val = float(grad_ptr[d]) + param_ptr[d] * weight_decay;
+    exp_avg_ptr[d] = exp_avg_ptr[d] * beta1 + grad_val * exp_avg_grad_coefficient;
+    exp_avg_sq_ptr[d] = exp_avg_sq_ptr[d] * beta2 +
+        grad_val * grad_val * exp_avg_sq_grad_coefficient;
+    float demon_val;
+    if (amsgrad) {
+      max_exp_avg_sq_ptr[d] = std::max(max_exp_avg_sq_ptr[d], exp_avg_sq_ptr[d]);
+      demon_val = std::sqrt(max_exp_avg_sq_ptr[d] / bias_correction2) + eps;
+    } else {
+      demon_val = std::sqrt(exp_avg_sq_ptr[d] / bias_correction2) + eps;
+    }
+    param_ptr[d] = param_ptr[d] - step_size * exp_avg_ptr[d] / demon_val;
+    param2_ptr[d] = at::BFloat16(param_ptr[d]);
+  }
+}
+
 template <typename scalar_t, typename grad_t>
 void adam_fused_step_kernel(
     const at::Tensor& param,
@@ -40,70 +291,31 @@ void adam_fused_step_kernel(
   scalar_t beta2 = scalar_t(beta2_double);
   scalar_t exp_avg_grad_coefficient = scalar_t(1 - beta1_double);
   scalar_t exp_avg_sq_grad_coefficient = scalar_t(1 - beta2_double);
-  scalar_t learning_rate = scalar_t(learning_rate_double);
   scalar_t weight_decay = scalar_t(weight_decay_double);
   scalar_t eps = scalar_t(eps_double);
 
-  using Vec = at::vec::Vectorized<scalar_t>;
   int64_t grain_size = 512;
 
   // update momentum vt and mt
   // also accumulate sum of param_norm and rtw_norm
   at::parallel_for(
       0, param.numel(), grain_size, [&](int64_t begin, int64_t end) {
-        // local pointers
-        scalar_t* param_ptr = param_data + begin;
-        scalar_t* exp_avg_ptr = exp_avg_data + begin;
-        scalar_t* exp_avg_sq_ptr = exp_avg_sq_data + begin;
-        scalar_t* grad_ptr = grad_data + begin;
-        scalar_t* max_exp_avg_sq_ptr = max_exp_avg_sq_data + begin;
-
-        const int64_t size = end - begin;
-
-        int64_t d = 0;
-        for (; d < size - (size % Vec::size()); d += Vec::size()) {
-          Vec param_vec = Vec::loadu(param_ptr + d);
-          Vec grad_vec =
-              Vec::loadu(grad_ptr + d) + param_vec * Vec(weight_decay);
-          Vec exp_avg_vec = Vec::loadu(exp_avg_ptr + d) * Vec(beta1) +
-              grad_vec * Vec(exp_avg_grad_coefficient);
-          Vec exp_avg_sq_vec = Vec::loadu(exp_avg_sq_ptr + d) * Vec(beta2) +
-              grad_vec * grad_vec * Vec(exp_avg_sq_grad_coefficient);
-          exp_avg_vec.store(exp_avg_ptr + d);
-          exp_avg_sq_vec.store(exp_avg_sq_ptr + d);
-
-          Vec denom_vec;
-          if (amsgrad) {
-            Vec max_exp_avg_sq_vec =
-                maximum(Vec::loadu(max_exp_avg_sq_ptr + d), exp_avg_sq_vec);
-            max_exp_avg_sq_vec.store(max_exp_avg_sq_ptr + d);
-            denom_vec =
-                (max_exp_avg_sq_vec / Vec(bias_correction2)).sqrt() + Vec(eps);
-          } else {
-            denom_vec =
-                (exp_avg_sq_vec / Vec(bias_correction2)).sqrt() + Vec(eps);
-          }
-
-          param_vec = param_vec - Vec(step_size) * exp_avg_vec / denom_vec;
-          param_vec.store(param_ptr + d);
-        }
-        for (; d < size; d++) {
-          scalar_t grad_val = grad_ptr[d] + param_ptr[d] * weight_decay;
-          exp_avg_ptr[d] =
-              exp_avg_ptr[d] * beta1 + grad_val * exp_avg_grad_coefficient;
-          exp_avg_sq_ptr[d] = exp_avg_sq_ptr[d] * beta2 +
-              grad_val * grad_val * (exp_avg_sq_grad_coefficient);
-          scalar_t demon_val;
-          if (amsgrad) {
-            max_exp_avg_sq_ptr[d] =
-                std::max(max_exp_avg_sq_ptr[d], exp_avg_sq_ptr[d]);
-            demon_val =
-                std::sqrt(max_exp_avg_sq_ptr[d] / bias_correction2) + eps;
-          } else {
-            demon_val = std::sqrt(exp_avg_sq_ptr[d] / bias_correction2) + eps;
-          }
-          param_ptr[d] = param_ptr[d] - step_size * exp_avg_ptr[d] / demon_val;
-        }
+        adam_step_range<scalar_t>(
+            param_data + begin,
+            exp_avg_data + begin,
+            exp_avg_sq_data + begin,
+            max_exp_avg_sq_data + begin,
+            grad_data + begin,
+            end - begin,
+            amsgrad,
+            beta1,
+            beta2,
+            exp_avg_grad_coefficient,
+            exp_avg_sq_grad_coefficient,
+            step_size,
+            bias_correction2,
+            weight_decay,
+            eps);
       });
 }
 
@@ -157,108 +369,30 @@ void adam_fused_step_kernel<at::BFloat16, at::BFloat16>(
   float beta2 = float(beta2_double);
   float exp_avg_grad_coefficient = float(1 - beta1_double);
   float exp_avg_sq_grad_coefficient = float(1 - beta2_double);
-  float learning_rate = float(learning_rate_double);
   float weight_decay = float(weight_decay_double);
   float eps = float(eps_double);
 
-  using bVec = at::vec::Vectorized<at::BFloat16>;
-  using fVec = at::vec::Vectorized<float>;
-
   int64_t grain_size = 512;
 
   at::parallel_for(
       0, param.numel(), grain_size, [&](int64_t begin, int64_t end) {
-        // local pointers
-        at::BFloat16* param_ptr = param_data + begin;
-        float* exp_avg_ptr = exp_avg_data + begin;
-        float* exp_avg_sq_ptr = exp_avg_sq_data + begin;
-        float* max_exp_avg_sq_ptr = max_exp_avg_sq_data + begin;
-        at::BFloat16* grad_ptr = grad_data + begin;
-        at::BFloat16* param2_ptr = param2_data + begin;
-
-        const int64_t size = end - begin;
-
-        int64_t d = 0;
-        for (; d < size - (size % bVec::size()); d += bVec::size()) {
-          // load grad vec
-          bVec grad_bvec = bVec::loadu(grad_ptr + d);
-          fVec grad_fvec, grad_fvec2;
-          std::tie(grad_fvec, grad_fvec2) = convert_bfloat16_float(grad_bvec);
-          // load param vec
-          bVec param_bvec = bVec::loadu(param_ptr + d);
-          bVec param2_bvec = bVec::loadu(param2_ptr + d);
-          fVec param_fvec, param_fvec2;
-          std::tie(param_fvec, param_fvec2) =
-              at::vec::pack_bfloat16_float(param_bvec, param2_bvec);
-          // weight decay
-          grad_fvec = grad_fvec + param_fvec * fVec(weight_decay);
-          grad_fvec2 = grad_fvec2 + param_fvec2 * fVec(weight_decay);
-          // update exp_avg, exp_avg_sq
-          fVec exp_avg_fvec = fVec::loadu(exp_avg_ptr + d) * fVec(beta1) +
-              grad_fvec * fVec(exp_avg_grad_coefficient);
-          fVec exp_avg_fvec2 =
-              fVec::loadu(exp_avg_ptr + d + fVec::size()) * fVec(beta1) +
-              grad_fvec2 * fVec(exp_avg_grad_coefficient);
-          exp_avg_fvec.store(exp_avg_ptr + d);
-          exp_avg_fvec2.store(exp_avg_ptr + d + fVec::size());
-          fVec exp_avg_sq_fvec = fVec::loadu(exp_avg_sq_ptr + d) * fVec(beta2) +
-              grad_fvec * grad_fvec * fVec(exp_avg_sq_grad_coefficient);
-          fVec exp_avg_sq_fvec2 =
-              fVec::loadu(exp_avg_sq_ptr + d + fVec::size()) * fVec(beta2) +
-              grad_fvec2 * grad_fvec2 * fVec(exp_avg_sq_grad_coefficient);
-          exp_avg_sq_fvec.store(exp_avg_sq_ptr + d);
-          exp_avg_sq_fvec2.store(exp_avg_sq_ptr + d + fVec::size());
-          // amsgrad
-          fVec denom_fvec, denom_fvec2;
-          if (amsgrad) {
-            fVec max_exp_avg_sq_fvec =
-                maximum(fVec::loadu(max_exp_avg_sq_ptr + d), exp_avg_sq_fvec);
-            fVec max_exp_avg_sq_fvec2 = maximum(
-                fVec::loadu(max_exp_avg_sq_ptr + d + fVec::size()),
-                exp_avg_sq_fvec2);
-            max_exp_avg_sq_fvec.store(max_exp_avg_sq_ptr + d);
-            max_exp_avg_sq_fvec2.store(max_exp_avg_sq_ptr + d + fVec::size());
-            denom_fvec = (max_exp_avg_sq_fvec / fVec(bias_correction2)).sqrt() +
-                fVec(eps);
-            denom_fvec2 =
-                (max_exp_avg_sq_fvec2 / fVec(bias_correction2)).sqrt() +
-                fVec(eps);
-          } else {
-            denom_fvec =
-                (exp_avg_sq_fvec / fVec(bias_correction2)).sqrt() + fVec(eps);
-            denom_fvec2 =
-                (exp_avg_sq_fvec2 / fVec(bias_correction2)).sqrt() + fVec(eps);
-          }
-          // update param
-          param_fvec = param_fvec - fVec(step_size) * exp_avg_fvec / denom_fvec;
-          param_fvec2 =
-              param_fvec2 - fVec(step_size) * exp_avg_fvec2 / denom_fvec2;
-          std::tie(param_bvec, param2_bvec) =
-              at::vec::unpack_float_bfloat16(param_fvec, param_fvec2);
-          param_bvec.store(param_ptr + d);
-          param2_bvec.store(param2_ptr + d);
-        }
-        for (; d < size; d++) {
-          float param_val =
-              at::vec::pack_bfloat16_float(param_ptr[d], param2_ptr[d]);
-          float grad_val = float(grad_ptr[d]) + param_val * weight_decay;
-          exp_avg_ptr[d] =
-              exp_avg_ptr[d] * beta1 + grad_val * exp_avg_grad_coefficient;
-          exp_avg_sq_ptr[d] = exp_avg_sq_ptr[d] * beta2 +
-              grad_val * grad_val * exp_avg_sq_grad_coefficient;
-          float demon_val;
-          if (amsgrad) {
-            max_exp_avg_sq_ptr[d] =
-                std::max(max_exp_avg_sq_ptr[d], exp_avg_sq_ptr[d]);
-            demon_val =
-                std::sqrt(max_exp_avg_sq_ptr[d] / bias_correction2) + eps;
-          } else {
-            demon_val = std::sqrt(exp_avg_sq_ptr[d] / bias_correction2) + eps;
-          }
-          param_val = param_val - step_size * exp_avg_ptr[d] / demon_val;
-          std::tie(param_ptr[d], param2_ptr[d]) =
-              at::vec::unpack_float_bfloat16(param_val);
-        }
+        adam_step_range(
+            param_data + begin,
+            param2_data + begin,
+            exp_avg_data + begin,
+            exp_avg_sq_data + begin,
+            max_exp_avg_sq_data + begin,
+            grad_data + begin,
+            end - begin,
+            amsgrad,
+            beta1,
+            beta2,
+            exp_avg_grad_coefficient,
+            exp_avg_sq_grad_coefficient,
+            step_size,
+            bias_correction2,
+            weight_decay,
+            eps);
       });
 }
 
@@ -312,103 +446,30 @@ void adam_fused_step_kernel<float, at::BFloat16>(
   float beta2 = float(beta2_double);
   float exp_avg_grad_coefficient = float(1 - beta1_double);
   float exp_avg_sq_grad_coefficient = float(1 - beta2_double);
-  float learning_rate = float(learning_rate_double);
   float weight_decay = float(weight_decay_double);
   float eps = float(eps_double);
 
-  using bVec = at::vec::Vectorized<at::BFloat16>;
-  using fVec = at::vec::Vectorized<float>;
-
   int64_t grain_size = 512;
 
   at::parallel_for(
       0, param.numel(), grain_size, [&](int64_t begin, int64_t end) {
-        // local pointers
-        float* param_ptr = param_data + begin;
-        float* exp_avg_ptr = exp_avg_data + begin;
-        float* exp_avg_sq_ptr = exp_avg_sq_data + begin;
-        float* max_exp_avg_sq_ptr = max_exp_avg_sq_data + begin;
-        at::BFloat16* grad_ptr = grad_data + begin;
-        at::BFloat16* param2_ptr = param2_data + begin;
-
-        const int64_t size = end - begin;
-
-        int64_t d = 0;
-        for (; d < size - (size % bVec::size()); d += bVec::size()) {
-          // load grad vec
-          bVec grad_bvec = bVec::loadu(grad_ptr + d);
-          fVec grad_fvec, grad_fvec2;
-          std::tie(grad_fvec, grad_fvec2) = convert_bfloat16_float(grad_bvec);
-          // load param vec
-          fVec param_fvec = fVec::loadu(param_ptr + d);
-          fVec param_fvec2 = fVec::loadu(param_ptr + d + fVec::size());
-          // weight decay
-          grad_fvec = grad_fvec + param_fvec * fVec(weight_decay);
-          grad_fvec2 = grad_fvec2 + param_fvec2 * fVec(weight_decay);
-          // update exp_avg, exp_avg_sq
-          fVec exp_avg_fvec = fVec::loadu(exp_avg_ptr + d) * fVec(beta1) +
-              grad_fvec * fVec(exp_avg_grad_coefficient);
-          fVec exp_avg_fvec2 =
-              fVec::loadu(exp_avg_ptr + d + fVec::size()) * fVec(beta1) +
-              grad_fvec2 * fVec(exp_avg_grad_coefficient);
-          exp_avg_fvec.store(exp_avg_ptr + d);
-          exp_avg_fvec2.store(exp_avg_ptr + d + fVec::size());
-          fVec exp_avg_sq_fvec = fVec::loadu(exp_avg_sq_ptr + d) * fVec(beta2) +
-              grad_fvec * grad_fvec * fVec(exp_avg_sq_grad_coefficient);
-          fVec exp_avg_sq_fvec2 =
-              fVec::loadu(exp_avg_sq_ptr + d + fVec::size()) * fVec(beta2) +
-              grad_fvec2 * grad_fvec2 * fVec(exp_avg_sq_grad_coefficient);
-          exp_avg_sq_fvec.store(exp_avg_sq_ptr + d);
-          exp_avg_sq_fvec2.store(exp_avg_sq_ptr + d + fVec::size());
-          // amsgrad
-          fVec denom_fvec, denom_fvec2;
-          if (amsgrad) {
-            fVec max_exp_avg_sq_fvec =
-                maximum(fVec::loadu(max_exp_avg_sq_ptr + d), exp_avg_sq_fvec);
-            fVec max_exp_avg_sq_fvec2 = maximum(
-                fVec::loadu(max_exp_avg_sq_ptr + d + fVec::size()),
-                exp_avg_sq_fvec2);
-            max_exp_avg_sq_fvec.store(max_exp_avg_sq_ptr + d);
-            max_exp_avg_sq_fvec2.store(max_exp_avg_sq_ptr + d + fVec::size());
-            denom_fvec = (max_exp_avg_sq_fvec / fVec(bias_correction2)).sqrt() +
-                fVec(eps);
-            denom_fvec2 =
-                (max_exp_avg_sq_fvec2 / fVec(bias_correction2)).sqrt() +
-                fVec(eps);
-          } else {
-            denom_fvec =
-                (exp_avg_sq_fvec / fVec(bias_correction2)).sqrt() + fVec(eps);
-            denom_fvec2 =
-                (exp_avg_sq_fvec2 / fVec(bias_correction2)).sqrt() + fVec(eps);
-          }
-          // update param
-          param_fvec = param_fvec - fVec(step_size) * exp_avg_fvec / denom_fvec;
-          param_fvec2 =
-              param_fvec2 - fVec(step_size) * exp_avg_fvec2 / denom_fvec2;
-          param_fvec.store(param_ptr + d);
-          param_fvec2.store(param_ptr + d + fVec::size());
-          // sync float param to bfloat16
-          bVec param2_bvec = convert_float_bfloat16(param_fvec, param_fvec2);
-          param2_bvec.store(param2_ptr + d);
-        }
-        for (; d < size; d++) {
-          float grad_val = float(grad_ptr[d]) + param_ptr[d] * weight_decay;
-          exp_avg_ptr[d] =
-              exp_avg_ptr[d] * beta1 + grad_val * exp_avg_grad_coefficient;
-          exp_avg_sq_ptr[d] = exp_avg_sq_ptr[d] * beta2 +
-              grad_val * grad_val * exp_avg_sq_grad_coefficient;
-          float demon_val;
-          if (amsgrad) {
-            max_exp_avg_sq_ptr[d] =
-                std::max(max_exp_avg_sq_ptr[d], exp_avg_sq_ptr[d]);
-            demon_val =
-                std::sqrt(max_exp_avg_sq_ptr[d] / bias_correction2) + eps;
-          } else {
-            demon_val = std::sqrt(exp_avg_sq_ptr[d] / bias_correction2) + eps;
-          }
-          param_ptr[d] = param_ptr[d] - step_size * exp_avg_ptr[d] / demon_val;
-          param2_ptr[d] = at::BFloat16(param_ptr[d]);
-        }
+        adam_step_range(
+            param_data + begin,
+            param2_data + begin,
+            exp_avg_data + begin,
+            exp_avg_sq_data + begin,
+            max_exp_avg_sq_data + begin,
+            grad_data + begin,
+            end - begin,
+            amsgrad,
+            beta1,
+            beta2,
+            exp_avg_grad_coefficient,
+            exp_avg_sq_grad_coefficient,
+            step_size,
+            bias_correction2,
+            weight_decay,
+            eps);
       });
 }
 
@@ -520,11 +581,227 @@ void adam_fused_step_kernel_impl(
   }
 }
 
+// dtype combinations handled by the fused Adam kernels, resolved once per
+// tensor so the chunk loop below only switches on a tag.
+enum AdamDtypeCombo : int8_t {
+  kAdamFp32 = 0, // fp32 param + fp32 grad
+  kAdamFp64, // fp64 param + fp64 grad
+  kAdamBF16, // bf16 param + bf16 trail + bf16 grad
+  kAdamFp32MasterBF16, // fp32 master param + bf16 copy + bf16 grad
+};
+
+// A flat slice of one parameter tensor. Chunks of all parameters form a
+// single index space so one parallel region covers the whole optimizer step
+// instead of one fork/join per tensor.
+struct AdamChunk {
+  int32_t tensor_id;
+  int32_t size;
+  int64_t offset;
+};
+
+constexpr int64_t kAdamChunkSize = 16384;
+
+void adam_fused_step_list_kernel_impl(
+    at::TensorList params_,
+    at::TensorList exp_avgs_,
+    at::TensorList exp_avg_sqs_,
+    at::TensorList max_exp_avg_sqs_,
+    at::TensorList grads_,
+    at::TensorList params2_,
+    bool amsgrad,
+    at::ArrayRef<double> steps,
+    double beta1,
+    double beta2,
+    double learning_rate,
+    double weight_decay,
+    double eps) {
+  int64_t num_tensors = params_.size();
+
+  std::vector<at::Tensor> params(num_tensors);
+  std::vector<at::Tensor> exp_avgs(num_tensors);
+  std::vector<at::Tensor> exp_avg_sqs(num_tensors);
+  std::vector<at::Tensor> max_exp_avg_sqs(num_tensors);
+  std::vector<at::Tensor> grads(num_tensors);
+  std::vector<at::Tensor> params2(num_tensors);
+
+  std::vector<int8_t> combo(num_tensors);
+  std::vector<void*> param_data(num_tensors);
+  std::vector<void*> exp_avg_data(num_tensors);
+  std::vector<void*> exp_avg_sq_data(num_tensors);
+  std::vector<void*> max_exp_avg_sq_data(num_tensors, nullptr);
+  std::vector<void*> grad_data(num_tensors);
+  std::vector<void*> param2_data(num_tensors, nullptr);
+  // bias corrections depend on the per-tensor step count
+  std::vector<double> step_size(num_tensors);
+  std::vector<double> bias_correction2(num_tensors);
+
+  std::vector<AdamChunk> chunks;
+  for (int64_t i = 0; i < num_tensors; i++) {
+    params[i] = params_[i].contiguous();
+    exp_avgs[i] = exp_avgs_[i].contiguous();
+    exp_avg_sqs[i] = exp_avg_sqs_[i].contiguous();
+    max_exp_avg_sqs[i] = max_exp_avg_sqs_[i].contiguous();
+    grads[i] = grads_[i].contiguous();
+    params2[i] = params2_[i].contiguous();
+
+    auto grad_dtype = grads[i].scalar_type();
+    auto param_dtype = params[i].scalar_type();
+    if (at::ScalarType::Float == grad_dtype) {
+      combo[i] = kAdamFp32;
+    } else if (at::ScalarType::Double == grad_dtype) {
+      combo[i] = kAdamFp64;
+    } else if (
+        at::ScalarType::BFloat16 == grad_dtype &&
+        at::ScalarType::BFloat16 == param_dtype) {
+      combo[i] = kAdamBF16;
+      param2_data[i] = params2[i].data_ptr();
+    } else if (
+        at::ScalarType::BFloat16 == grad_dtype &&
+        at::ScalarType::Float == param_dtype) {
+      combo[i] = kAdamFp32MasterBF16;
+      param2_data[i] = params2[i].data_ptr();
+    } else {
+      TORCH_CHECK(false, "expect bfloat16 or float or double param");
+    }
+
+    param_data[i] = params[i].data_ptr();
+    exp_avg_data[i] = exp_avgs[i].data_ptr();
+    exp_avg_sq_data[i] = exp_avg_sqs[i].data_ptr();
+    grad_data[i] = grads[i].data_ptr();
+    if (amsgrad) {
+      max_exp_avg_sq_data[i] = max_exp_avg_sqs[i].data_ptr();
+    }
+
+    double bias_correction1 = 1 - std::pow(beta1, steps[i]);
+    step_size[i] = learning_rate / bias_correction1;
+    bias_correction2[i] = 1 - std::pow(beta2, steps[i]);
+
+    int64_t numel = params[i].numel();
+    for (int64_t offset = 0; offset < numel; offset += kAdamChunkSize) {
+      chunks.push_back(
+          {static_cast<int32_t>(i),
+           static_cast<int32_t>(std::min(kAdamChunkSize, numel - offset)),
+           offset});
+    }
+  }
+
+  at::parallel_for(
+      0, chunks.size(), 1, [&](int64_t chunk_begin, int64_t chunk_end) {
+        for (const auto c : c10::irange(chunk_begin, chunk_end)) {
+          const AdamChunk& chunk = chunks[c];
+          int64_t i = chunk.tensor_id;
+          int64_t off = chunk.offset;
+          switch (combo[i]) {
+            case kAdamFp32:
+              adam_step_range<float>(
+                  static_cast<float*>(param_data[i]) + off,
+                  static_cast<float*>(exp_avg_data[i]) + off,
+                  static_cast<float*>(exp_avg_sq_data[i]) + off,
+                  amsgrad ? static_cast<float*>(max_exp_avg_sq_data[i]) + off
+                          : nullptr,
+                  static_cast<float*>(grad_data[i]) + off,
+                  chunk.size,
+                  amsgrad,
+                  float(beta1),
+                  float(beta2),
+                  float(1 - beta1),
+                  float(1 - beta2),
+                  float(step_size[i]),
+                  float(bias_correction2[i]),
+                  float(weight_decay),
+                  float(eps));
+              break;
+            case kAdamFp64:
+              adam_step_range<double>(
+                  static_cast<double*>(param_data[i]) + off,
+                  static_cast<double*>(exp_avg_data[i]) + off,
+                  static_cast<double*>(exp_avg_sq_data[i]) + off,
+                  amsgrad ? static_cast<double*>(max_exp_avg_sq_data[i]) + off
+                          : nullptr,
+                  static_cast<double*>(grad_data[i]) + off,
+                  chunk.size,
+                  amsgrad,
+                  beta1,
+                  beta2,
+                  1 - beta1,
+                  1 - beta2,
+                  step_size[i],
+                  bias_correction2[i],
+                  weight_decay,
+                  eps);
+              break;
+            case kAdamBF16:
+              adam_step_range(
+                  static_cast<at::BFloat16*>(param_data[i]) + off,
+                  static_cast<at::BFloat16*>(param2_data[i]) + off,
+                  static_cast<float*>(exp_avg_data[i]) + off,
+                  static_cast<float*>(exp_avg_sq_data[i]) + off,
+                  amsgrad ? static_cast<float*>(max_exp_avg_sq_data[i]) + off
+                          : nullptr,
+                  static_cast<at::BFloat16*>(grad_data[i]) + off,
+                  chunk.size,
+                  amsgrad,
+                  float(beta1),
+                  float(beta2),
+                  float(1 - beta1),
+                  float(1 - beta2),
+                  float(step_size[i]),
+                  float(bias_correction2[i]),
+                  float(weight_decay),
+                  float(eps));
+              break;
+            case kAdamFp32MasterBF16:
+              adam_step_range(
+                  static_cast<float*>(param_data[i]) + off,
+                  static_cast<at::BFloat16*>(param2_data[i]) + off,
+                  static_cast<float*>(exp_avg_data[i]) + off,
+                  static_cast<float*>(exp_avg_sq_data[i]) + off,
+                  amsgrad ? static_cast<float*>(max_exp_avg_sq_data[i]) + off
+                          : nullptr,
+                  static_cast<at::BFloat16*>(grad_data[i]) + off,
+                  chunk.size,
+                  amsgrad,
+                  float(beta1),
+                  float(beta2),
+                  float(1 - beta1),
+                  float(1 - beta2),
+                  float(step_size[i]),
+                  float(bias_correction2[i]),
+                  float(weight_decay),
+                  float(eps));
+              break;
+          }
+        }
+      });
+
+  for (int64_t i = 0; i < num_tensors; i++) {
+    if (!params_[i].is_contiguous()) {
+      params_[i].copy_(params[i]);
+    }
+    if (!exp_avgs_[i].is_contiguous()) {
+      exp_avgs_[i].copy_(exp_avgs[i]);
+    }
+    if (!exp_avg_sqs_[i].is_contiguous()) {
+      exp_avg_sqs_[i].copy_(exp_avg_sqs[i]);
+    }
+    if (amsgrad && !max_exp_avg_sqs_[i].is_contiguous()) {
+      max_exp_avg_sqs_[i].copy_(max_exp_avg_sqs[i]);
+    }
+    if (!params2_[i].is_contiguous()) {
+      params2_[i].copy_(params2[i]);
+    }
+  }
+}
+
 } // anonymous namespace
 
 IPEX_REGISTER_DISPATCH(
     adam_fused_step_kernel_stub,
     &adam_fused_step_kernel_impl);
 
+IPEX_REGISTER_DISPATCH(
+    adam_fused_step_list_kernel_stub,
+    &adam_fused_step_list_kernel_impl);
+
 } // namespace cpu
 } // namespace torch_ipex
@@ -18,6 +18,53 @@ static inline scalar_t acc_vec(const at::vec::Vectorized<scalar_t>& v) {
   return std::accumulate(arr.cbegin(), arr.cend(), scalar_t(0));
 }
 
+// The trust ratio depends on the full rtw_norm, so the scaled write cannot
+// start before every thread finished accumulating. With OpenMP available we
+// run everything in ONE parallel region: per-thread norm partials, a barrier,
+// a cross-thread reduction, and the scaled update on the same chunk — instead
+// of paying a second fork/join.
+//
+// [Note]: this cannot be expressed with at::parallel_for + #pragma omp
+// barrier, because its partition rule will not guarantee ALL threads in the
+// same team will be used, so an unused thread would keep on waiting since it
+// never reaches the barrier. The at::parallel_for fallback below therefore
+// keeps the two-region form.
+template <typename update_fn_t, typename ratio_fn_t, typename apply_fn_t>
+inline void lamb_two_phase_loop(
+    int64_t numel,
+    int64_t grain_size,
+    const update_fn_t& update_and_accumulate,
+    const ratio_fn_t& compute_true_ratio,
+    const apply_fn_t& apply_update) {
+#ifdef _OPENMP
+  if (omp_get_max_threads() > 1 && !omp_in_parallel()) {
+#pragma omp parallel
+    {
+      int tid = omp_get_thread_num();
+      int64_t nthr = omp_get_num_threads();
+      int64_t chunk = at::divup(numel, nthr);
+      int64_t begin = std::min((int64_t)tid * chunk, numel);
+      int64_t end = std::min(begin + chunk, numel);
+      update_and_accumulate(begin, end, tid);
+#pragma omp barrier
+#pragma omp single
+      compute_true_ratio();
+      // implicit barrier at the end of single: every thread sees the ratio
+      apply_update(begin, end);
+    }
+    return;
+  }
+#endif
+  at::parallel_for(0, numel, grain_size, [&](int64_t begin, int64_t end) {
+    update_and_accumulate(begin, end, at::get_thread_num());
+  });
+  // synchronize before update true_ratio
+  compute_true_ratio();
+  at::parallel_for(0, numel, grain_size, [&](int64_t begin, int64_t end) {
+    apply_update(begin, end);
+  });
+}
+
 template <typename scalar_t, typename grad_t>
 void lamb_fused_step_kernel(
     const at::Tensor& param,
@@ -40,121 +87,118 @@ void lamb_fused_step_kernel(
   double bias_correction2 = 1 - std::pow(beta2, step);
 
   int num_threads = at::get_num_threads();
-  scalar_t param_norm_acc[num_threads];
-  scalar_t rtw_norm_acc[num_threads];
-  std::fill_n(&param_norm_acc[0], num_threads, scalar_t(0));
-  std::fill_n(&rtw_norm_acc[0], num_threads, scalar_t(0));
+#ifdef _OPENMP
+  num_threads = std::max(num_threads, omp_get_max_threads());
+#endif
+  std::vector<scalar_t> param_norm_acc(num_threads, scalar_t(0));
+  std::vector<scalar_t> rtw_norm_acc(num_threads, scalar_t(0));
+  scalar_t true_ratio = scalar_t(1);
 
   using Vec = at::vec::Vectorized<scalar_t>;
 
   int64_t grain_size = 512;
 
-  // update momentum vt and mt
-  // also accumulate sum of param_norm and rtw_norm
-  at::parallel_for(
-      0, param.numel(), grain_size, [&](int64_t begin, int64_t end) {
-        int tid = at::get_thread_num();
-
-        // local pointers
-        scalar_t* param_ptr = param_data + begin;
-        scalar_t* exp_avg_ptr = exp_avg_data + begin;
-        scalar_t* exp_avg_sq_ptr = exp_avg_sq_data + begin;
-        scalar_t* grad_ptr = grad_data + begin;
-
-        const int64_t size = end - begin;
-
-        // local sum for param_norm and rtw_norm
-        Vec sum1_vec = Vec(scalar_t(0));
-        Vec sum2_vec = Vec(scalar_t(0));
-        scalar_t sum1_val = scalar_t(0);
-        scalar_t sum2_val = scalar_t(0);
-
-        int64_t d = 0;
-        for (; d < size - (size % Vec::size()); d += Vec::size()) {
-          Vec grad_vec = Vec::loadu(grad_ptr + d);
-          Vec exp_avg_vec = Vec::loadu(exp_avg_ptr + d) * Vec(scalar_t(beta1)) +
-              grad_vec * Vec(scalar_t(1 - beta1));
-          Vec exp_avg_sq_vec =
-              Vec::loadu(exp_avg_sq_ptr + d) * Vec(scalar_t(beta2)) +
-              grad_vec * grad_vec * Vec(scalar_t(1 - beta2));
-          Vec adam_step_vec = exp_avg_vec / Vec(scalar_t(bias_correction1)) /
-              ((exp_avg_sq_vec / Vec(scalar_t(bias_correction2))).sqrt() +
-               Vec(scalar_t(eps)));
-
-          exp_avg_vec.store(exp_avg_ptr + d);
-          exp_avg_sq_vec.store(exp_avg_sq_ptr + d);
-
-          Vec param_vec = Vec::loadu(param_ptr + d);
-          adam_step_vec =
-              adam_step_vec + param_vec * Vec(scalar_t(weight_decay));
-          // reuse grad to store adam_step
-          adam_step_vec.store(grad_ptr + d);
-
-          sum1_vec = sum1_vec + param_vec * param_vec;
-          sum2_vec = sum2_vec + adam_step_vec * adam_step_vec;
-        }
-        for (; d < size; d++) {
-          exp_avg_ptr[d] = exp_avg_ptr[d] * beta1 + grad_ptr[d] * (1 - beta1);
-          exp_avg_sq_ptr[d] = exp_avg_sq_ptr[d] * beta2 +
-              grad_ptr[d] * grad_ptr[d] * (1 - beta2);
-          scalar_t adam_step_val = (exp_avg_ptr[d] / bias_correction1) /
-              (std::sqrt(exp_avg_sq_ptr[d] / bias_correction2) + eps);
-
-          adam_step_val += param_ptr[d] * weight_decay;
-          // reuse grad to store adam_step
-          grad_ptr[d] = adam_step_val;
-
-          sum1_val += param_ptr[d] * param_ptr[d];
-          sum2_val += adam_step_val * adam_step_val;
-        }
-        sum1_val += acc_vec(sum1_vec);
-        sum2_val += acc_vec(sum2_vec);
-
-        param_norm_acc[tid] = sum1_val;
-        rtw_norm_acc[tid] = sum2_val;
-      });
+  // update momentum vt and mt, produce adam_step (stored back into grad)
+  // and accumulate both param_norm and rtw_norm in the same sweep
+  auto update_and_accumulate = [&](int64_t begin, int64_t end, int tid) {
+    // local pointers
+    scalar_t* param_ptr = param_data + begin;
+    scalar_t* exp_avg_ptr = exp_avg_data + begin;
+    scalar_t* exp_avg_sq_ptr = exp_avg_sq_data + begin;
+    scalar_t* grad_ptr = grad_data + begin;
 
-  // synchronize before update true_ratio
-  //
-  // [Note]: we could use #pragma omp barrier so that finish within a single omp
-  // session
-  //   but at::parallel_for partition rule will not guarantee ALL threads in the
-  //   same team will be used, so the unused thread will keep on waiting since
-  //   it never reaches the barrier.
-  //
-  scalar_t param_norm_sum = scalar_t(0);
-  scalar_t rtw_norm_sum = scalar_t(0);
-  for (int64_t tid = 0; tid < num_threads; tid++) {
-    param_norm_sum += param_norm_acc[tid];
-    rtw_norm_sum += rtw_norm_acc[tid];
-  }
-  scalar_t true_ratio = scalar_t(1);
-  scalar_t param_norm = std::sqrt(param_norm_sum);
-  scalar_t rtw_norm = std::sqrt(rtw_norm_sum);
-  if (param_norm != scalar_t(0) && rtw_norm != scalar_t(0)) {
-    true_ratio = param_norm / rtw_norm;
-  }
+    const int64_t size = end - begin;
 
-  // update param
-  at::parallel_for(
-      0, param.numel(), grain_size, [&](int64_t begin, int64_t end) {
-        // local pointers
-        scalar_t* param_ptr = param_data + begin;
-        scalar_t* grad_ptr = grad_data + begin;
-
-        const int64_t size = end - begin;
-
-        int64_t d = 0;
-        for (; d < size - (size % Vec::size()); d += Vec::size()) {
-          Vec param_vec = Vec::loadu(param_ptr + d) -
-              Vec::loadu(grad_ptr + d) *
-                  Vec(scalar_t(learning_rate * true_ratio));
-          param_vec.store(param_ptr + d);
-        }
-        for (; d < size; d++) {
-          param_ptr[d] -= grad_ptr[d] * learning_rate * true_ratio;
-        }
-      });
+    // local sum for param_norm and rtw_norm
+    Vec sum1_vec = Vec(scalar_t(0));
+    Vec sum2_vec = Vec(scalar_t(0));
+    scalar_t sum1_val = scalar_t(0);
+    scalar_t sum2_val = scalar_t(0);
+
+    int64_t d = 0;
+    for (; d < size - (size % Vec::size()); d += Vec::size()) {
+      Vec grad_vec = Vec::loadu(grad_ptr + d);
+      Vec exp_avg_vec = Vec::loadu(exp_avg_ptr + d) * Vec(scalar_t(beta1)) +
+          grad_vec * Vec(scalar_t(1 - beta1));
+      Vec exp_avg_sq_vec =
+          Vec::loadu(exp_avg_sq_ptr + d) * Vec(scalar_t(beta2)) +
+          grad_vec * grad_vec * Vec(scalar_t(1 - beta2));
+      Vec adam_step_vec = exp_avg_vec / Vec(scalar_t(bias_correction1)) /
+          ((exp_avg_sq_vec / Vec(scalar_t(bias_correction2))).sqrt() +
+           Vec(scalar_t(eps)));
+
+      exp_avg_vec.store(exp_avg_ptr + d);
+      exp_avg_sq_vec.store(exp_avg_sq_ptr + d);
+
+      Vec param_vec = Vec::loadu(param_ptr + d);
+      adam_step_vec = adam_step_vec + param_vec * Vec(scalar_t(weight_decay));
+      // reuse grad to store adam_step
+      adam_step_vec.store(grad_ptr + d);
+
+      sum1_vec = sum1_vec + param_vec * param_vec;
+      sum2_vec = sum2_vec + adam_step_vec * adam_step_vec;
+    }
+    for (; d < size; d++) {
+      exp_avg_ptr[d] = exp_avg_ptr[d] * beta1 + grad_ptr[d] * (1 - beta1);
+      exp_avg_sq_ptr[d] = exp_avg_sq_ptr[d] * beta2 +
+          grad_ptr[d] * grad_ptr[d] * (1 - beta2);
+      scalar_t adam_step_val = (exp_avg_ptr[d] / bias_correction1) /
+          (std::sqrt(exp_avg_sq_ptr[d] / bias_correction2) + eps);
+
+      adam_step_val += param_ptr[d] * weight_decay;
+      // reuse grad to store adam_step
+      grad_ptr[d] = adam_step_val;
+
+      sum1_val += param_ptr[d] * param_ptr[d];
+      sum2_val += adam_step_val * adam_step_val;
+    }
+    sum1_val += acc_vec(sum1_vec);
+    sum2_val += acc_vec(sum2_vec);
+
+    param_norm_acc[tid] = sum1_val;
+    rtw_norm_acc[tid] = sum2_val;
+  };
+
+  // cross-thread reduction of the norm partials
+  auto compute_true_ratio = [&]() {
+    scalar_t param_norm_sum = scalar_t(0);
+    scalar_t rtw_norm_sum = scalar_t(0);
+    for (int64_t tid = 0; tid < num_threads; tid++) {
+      param_norm_sum += param_norm_acc[tid];
+      rtw_norm_sum += rtw_norm_acc[tid];
+    }
+    scalar_t param_norm = std::sqrt(param_norm_sum);
+    scalar_t rtw_norm = std::sqrt(rtw_norm_sum);
+    if (param_norm != scalar_t(0) && rtw_norm != scalar_t(0)) {
+      true_ratio = param_norm / rtw_norm;
+    }
+  };
+
+  // update param with the trust-ratio scaled step
+  auto apply_update = [&](int64_t begin, int64_t end) {
+    // local pointers
+    scalar_t* param_ptr = param_data + begin;
+    scalar_t* grad_ptr = grad_data + begin;
+
+    const int64_t size = end - begin;
+
+    int64_t d = 0;
+    for (; d < size - (size % Vec::size()); d += Vec::size()) {
+      Vec param_vec = Vec::loadu(param_ptr + d) -
+          Vec::loadu(grad_ptr + d) * Vec(scalar_t(learning_rate * true_ratio));
+      param_vec.store(param_ptr + d);
+    }
+    for (; d < size; d++) {
+      param_ptr[d] -= grad_ptr[d] * learning_rate * true_ratio;
+    }
+  };
+
+  lamb_two_phase_loop(
+      param.numel(),
+      grain_size,
+      update_and_accumulate,
+      compute_true_ratio,
+      apply_update);
 }
 
 template <>
@@ -196,10 +240,12 @@ void lamb_fused_step_kernel<at::BFloat16, at::BFloat16>(
   double bias_correction2 = 1 - std::pow(beta2, step);
 
   int num_threads = at::get_num_threads();
-  std::vector<float> param_norm_acc(num_threads);
-  std::vector<float> rtw_norm_acc(num_threads);
-  std::fill_n(&param_norm_acc[0], num_threads, float(0));
-  std::fill_n(&rtw_norm_acc[0], num_threads, float(0));
+#ifdef _OPENMP
+  num_threads = std::max(num_threads, omp_get_max_threads());
+#endif
+  std::vector<float> param_norm_acc(num_threads, float(0));
+  std::vector<float> rtw_norm_acc(num_threads, float(0));
+  float true_ratio = float(1);
 
   // for float32 path, we can reuse grad to store adam_step
   // but for bfloat16 path, this can't be done since grad is in bfloat16
@@ -213,9 +259,7 @@ void lamb_fused_step_kernel<at::BFloat16, at::BFloat16>(
 
   int64_t grain_size = 512;
 
-  at::parallel_for(0, numel, grain_size, [&](int64_t begin, int64_t end) {
-    int tid = at::get_thread_num();
-
+  auto update_and_accumulate = [&](int64_t begin, int64_t end, int tid) {
     // local pointers
     at::BFloat16* param_ptr = param_data + begin;
     float* exp_avg_ptr = exp_avg_data + begin;
@@ -300,23 +344,24 @@ void lamb_fused_step_kernel<at::BFloat16, at::BFloat16>(
 
     param_norm_acc[tid] = sum1_val;
     rtw_norm_acc[tid] = sum2_val;
-  });
-
-  float param_norm_sum = float(0);
-  float rtw_norm_sum = float(0);
-  for (int64_t tid = 0; tid < num_threads; tid++) {
-    param_norm_sum += param_norm_acc[tid];
-    rtw_norm_sum += rtw_norm_acc[tid];
-  }
-  float true_ratio = float(1);
-  float param_norm = std::sqrt(param_norm_sum);
-  float rtw_norm = std::sqrt(rtw_norm_sum);
-  if (param_norm != float(0) && rtw_norm != float(0)) {
-    true_ratio = param_norm / rtw_norm;
-  }
+  };
+
+  auto compute_true_ratio = [&]() {
+    float param_norm_sum = float(0);
+    float rtw_norm_sum = float(0);
+    for (int64_t tid = 0; tid < num_threads; tid++) {
+      param_norm_sum += param_norm_acc[tid];
+      rtw_norm_sum += rtw_norm_acc[tid];
+    }
+    float param_norm = std::sqrt(param_norm_sum);
+    float rtw_norm = std::sqrt(rtw_norm_sum);
+    if (param_norm != float(0) && rtw_norm != float(0)) {
+      true_ratio = param_norm / rtw_norm;
+    }
+  };
 
   // update param
-  at::parallel_for(0, numel, grain_size, [&](int64_t begin, int64_t end) {
+  auto apply_update = [&](int64_t begin, int64_t end) {
     // local pointers
     at::BFloat16* param_ptr = param_data + begin;
     at::BFloat16* param2_ptr = param2_data + begin;
@@ -349,7 +394,10 @@ void lamb_fused_step_kernel<at::BFloat16, at::BFloat16>(
       std::tie(param_ptr[d], param2_ptr[d]) =
           at::vec::unpack_float_bfloat16(param_val);
     }
-  });
+  };
+
+  lamb_two_phase_loop(
+      numel, grain_size, update_and_accumulate, compute_true_ratio, apply_update);
 }
 
 template <>
@@ -391,10 +439,12 @@ void lamb_fused_step_kernel<float, at::BFloat16>(
   double bias_correction2 = 1 - std::pow(beta2, step);
 
   int num_threads = at::get_num_threads();
-  std::vector<float> param_norm_acc(num_threads);
-  std::vector<float> rtw_norm_acc(num_threads);
-  std::fill_n(&param_norm_acc[0], num_threads, float(0));
-  std::fill_n(&rtw_norm_acc[0], num_threads, float(0));
+#ifdef _OPENMP
+  num_threads = std::max(num_threads, omp_get_max_threads());
+#endif
+  std::vector<float> param_norm_acc(num_threads, float(0));
+  std::vector<float> rtw_norm_acc(num_threads, float(0));
+  float true_ratio = float(1);
 
   // for float32 path, we can reuse grad to store adam_step
   // but for bfloat16 path, this can't be done since grad is in bfloat16
@@ -408,9 +458,7 @@ void lamb_fused_step_kernel<float, at::BFloat16>(
 
   int64_t grain_size = 512;
 
-  at::parallel_for(0, numel, grain_size, [&](int64_t begin, int64_t end) {
-    int tid = at::get_thread_num();
-
+  auto update_and_accumulate = [&](int64_t begin, int64_t end, int tid) {
     // local pointers
     float* param_ptr = param_data + begin;
     float* exp_avg_ptr = exp_avg_data + begin;
@@ -490,23 +538,24 @@ void lamb_fused_step_kernel<float, at::BFloat16>(
 
     param_norm_acc[tid] = sum1_val;
     rtw_norm_acc[tid] = sum2_val;
-  });
-
-  float param_norm_sum = float(0);
-  float rtw_norm_sum = float(0);
-  for (int64_t tid = 0; tid < num_threads; tid++) {
-    param_norm_sum += param_norm_acc[tid];
-    rtw_norm_sum += rtw_norm_acc[tid];
-  }
-  float true_ratio = float(1);
-  float param_norm = std::sqrt(param_norm_sum);
-  float rtw_norm = std::sqrt(rtw_norm_sum);
-  if (param_norm != float(0) && rtw_norm != float(0)) {
-    true_ratio = param_norm / rtw_norm;
-  }
+  };
+
+  auto compute_true_ratio = [&]() {
+    float param_norm_sum = float(0);
+    float rtw_norm_sum = float(0);
+    for (int64_t tid = 0; tid < num_threads; tid++) {
+      param_norm_sum += param_norm_acc[tid];
+      rtw_norm_sum += rtw_norm_acc[tid];
+    }
+    float param_norm = std::sqrt(param_norm_sum);
+    float rtw_norm = std::sqrt(rtw_norm_sum);
+    if (param_norm != float(0) && rtw_norm != float(0)) {
+      true_ratio = param_norm / rtw_norm;
+    }
+  };
 
   // update param
-  at::parallel_for(0, numel, grain_size, [&](int64_t begin, int64_t end) {
+  auto apply_update = [&](int64_t begin, int64_t end) {
     // local pointers
     float* param_ptr = param_data + begin;
     at::BFloat16* param2_ptr = param2_data + begin;
@@ -536,7 +585,10 @@ void lamb_fused_step_kernel<float, at::BFloat16>(
       param_ptr[d] = param_val;
       param2_ptr[d] = at::BFloat16(param_val);
     }
-  });
+  };
+
+  lamb_two_phase_loop(
+      numel, grain_size, update_and_accumulate, compute_true_ratio, apply_update);
 }
 
 std::tuple<at::Tensor, at::Tensor, at::Tensor> lamb_fused_step_kernel_impl(
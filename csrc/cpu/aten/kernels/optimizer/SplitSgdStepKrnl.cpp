@@ -17,7 +17,8 @@ at::Tensor packed_add_kernel_impl(
     const at::Tensor& grad_,
     double alpha) {
   TORCH_INTERNAL_ASSERT_DEBUG_ONLY(
-      grad_.scalar_type() == at::ScalarType::BFloat16);
+      grad_.scalar_type() == at::ScalarType::BFloat16 ||
+      grad_.scalar_type() == at::ScalarType::Float);
   TORCH_INTERNAL_ASSERT_DEBUG_ONLY(
       top_half_.scalar_type() == at::ScalarType::BFloat16);
   TORCH_INTERNAL_ASSERT_DEBUG_ONLY(
@@ -42,11 +43,15 @@ at::Tensor packed_add_kernel_impl(
     auto indices_accessor = indices.accessor<int64_t, 2>();
 
     TORCH_INTERNAL_ASSERT_DEBUG_ONLY(values.is_contiguous());
-    auto value_ptr = values.data_ptr<at::BFloat16>();
+    bool is_fp32_grad = values.scalar_type() == at::ScalarType::Float;
+    at::BFloat16* value_ptr =
+        is_fp32_grad ? nullptr : values.data_ptr<at::BFloat16>();
+    float* fp32_value_ptr = is_fp32_grad ? values.data_ptr<float>() : nullptr;
     auto top_half_ptr = top_half.data_ptr<at::BFloat16>();
     auto bot_half_ptr = bot_half.data_ptr<at::BFloat16>();
 
-    TORCH_INTERNAL_ASSERT_DEBUG_ONLY(value_ptr != nullptr);
+    TORCH_INTERNAL_ASSERT_DEBUG_ONLY(
+        value_ptr != nullptr || fp32_value_ptr != nullptr);
     TORCH_INTERNAL_ASSERT_DEBUG_ONLY(top_half_ptr != nullptr);
     TORCH_INTERNAL_ASSERT_DEBUG_ONLY(bot_half_ptr != nullptr);
 
@@ -81,19 +86,44 @@ at::Tensor packed_add_kernel_impl(
             for (int64_t d = 0; d < sparse_dim; d++) {
               table_offset += sparse_stride[d] * indices_accessor[d][n];
             }
-            auto value_index = value_ptr + n * feature_size;
             auto top_half_index = top_half_ptr + table_offset;
             auto bot_half_index = bot_half_ptr + table_offset;
-            packed_bf16_add_ker(
-                top_half_index,
-                bot_half_index,
-                value_index,
-                feature_size,
-                alpha_);
+            if (is_fp32_grad) {
+              packed_bf16_add_ker(
+                  top_half_index,
+                  bot_half_index,
+                  fp32_value_ptr + n * feature_size,
+                  feature_size,
+                  alpha_);
+            } else {
+              packed_bf16_add_ker(
+                  top_half_index,
+                  bot_half_index,
+                  value_ptr + n * feature_size,
+                  feature_size,
+                  alpha_);
+            }
           }
         }
       }
     });
+  } else if (grad.scalar_type() == at::ScalarType::Float) {
+    // Fused add-cast epilogue for gradient accumulation: an FP32 grad coming
+    // straight out of backward is accumulated into the (top, bot) pair in one
+    // pass, so no standalone FP32 gradient accumulator has to be kept.
+    auto len = top_half.numel();
+    auto value_ptr = grad.data_ptr<float>();
+    auto top_half_ptr = top_half.data_ptr<at::BFloat16>();
+    auto bot_half_ptr = bot_half.data_ptr<at::BFloat16>();
+
+    at::parallel_for(0, len, 64, [&](int64_t start, int64_t end) {
+      packed_bf16_add_ker(
+          top_half_ptr + start,
+          bot_half_ptr + start,
+          value_ptr + start,
+          end - start,
+          alpha_);
+    });
   } else {
     // TODO: vector implementation basing on vector size
     union packed_bf16 {
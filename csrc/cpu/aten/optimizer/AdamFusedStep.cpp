@@ -8,6 +8,7 @@ namespace torch_ipex {
 namespace cpu {
 
 IPEX_DEFINE_DISPATCH(adam_fused_step_kernel_stub);
+IPEX_DEFINE_DISPATCH(adam_fused_step_list_kernel_stub);
 
 void adam_fused_step(
     const at::Tensor& param_,
@@ -100,6 +101,98 @@ void adam_fused_step(
       eps);
 }
 
+// Multi-tensor (foreach-style) variant: applies one Adam step to every
+// parameter in the group through a single kernel launch, so small tensors do
+// not pay one parallel fork/join each. `steps` carries the already advanced
+// per-tensor step counts.
+void adam_fused_step_list(
+    at::TensorList params,
+    at::TensorList exp_avgs,
+    at::TensorList exp_avg_sqs,
+    at::TensorList max_exp_avg_sqs,
+    at::TensorList grads,
+    at::TensorList params2,
+    bool amsgrad,
+    c10::ArrayRef<double> steps,
+    double beta1,
+    double beta2,
+    double learning_rate,
+    double weight_decay,
+    double eps) {
+  RECORD_FUNCTION(
+      "torch_ipex::adam_fused_step_list", c10::ArrayRef<c10::IValue>({}));
+
+  TORCH_CHECK(
+      learning_rate >= 0, "Expect learning rate >= 0.0, got ", learning_rate);
+  TORCH_CHECK(eps >= 0, "Expect eps >= 0.0, got ", eps);
+  TORCH_CHECK(beta1 >= 0 && beta1 < 1, "Expect 0.0 <= beta1 < 1.0, got", beta1);
+  TORCH_CHECK(beta2 >= 0 && beta2 < 1, "Expect 0.0 <= beta2 < 1.0, got", beta2);
+  TORCH_CHECK(
+      weight_decay >= 0, "Expect weight_decay >= 0.0, got ", weight_decay);
+
+  auto num_tensors = params.size();
+  TORCH_CHECK(
+      exp_avgs.size() == num_tensors && exp_avg_sqs.size() == num_tensors &&
+          max_exp_avg_sqs.size() == num_tensors &&
+          grads.size() == num_tensors && params2.size() == num_tensors &&
+          steps.size() == num_tensors,
+      "Expect params, exp_avgs, exp_avg_sqs, max_exp_avg_sqs, grads, params2 ",
+      "and steps to have the same length, got ",
+      num_tensors,
+      " params");
+
+  for (const auto i : c10::irange(num_tensors)) {
+    TORCH_CHECK(
+        params[i].sizes() == grads[i].sizes(),
+        "Expect param and grad have the same sizes, param sizes: ",
+        params[i].sizes(),
+        "; grad sizes: ",
+        grads[i].sizes());
+    TORCH_CHECK(
+        params[i].sizes() == exp_avgs[i].sizes(),
+        "Expect param and exp_avg have the same sizes, param sizes: ",
+        params[i].sizes(),
+        "; exp_avg sizes: ",
+        exp_avgs[i].sizes());
+    TORCH_CHECK(
+        params[i].sizes() == exp_avg_sqs[i].sizes(),
+        "Expect param and exp_avg_sq_ have the same sizes, param sizes: ",
+        params[i].sizes(),
+        "; exp_avg_sq sizes: ",
+        exp_avg_sqs[i].sizes());
+    if (amsgrad) {
+      TORCH_CHECK(
+          params[i].sizes() == max_exp_avg_sqs[i].sizes(),
+          "Expect param and max_exp_avg_sq_ have the same sizes, param sizes: ",
+          params[i].sizes(),
+          "; max_exp_avg_sq sizes: ",
+          max_exp_avg_sqs[i].sizes());
+    }
+    TORCH_CHECK(
+        params2[i].numel() == 0 || params[i].sizes() == params2[i].sizes(),
+        "Expect param and param2_ have the same sizes, param sizes: ",
+        params[i].sizes(),
+        "; param2_ sizes: ",
+        params2[i].sizes());
+  }
+
+  adam_fused_step_list_kernel_stub(
+      kCPU,
+      params,
+      exp_avgs,
+      exp_avg_sqs,
+      max_exp_avg_sqs,
+      grads,
+      params2,
+      amsgrad,
+      steps,
+      beta1,
+      beta2,
+      learning_rate,
+      weight_decay,
+      eps);
+}
+
 } // namespace cpu
 } // namespace torch_ipex
 
@@ -110,6 +203,10 @@ IPEX_LIBRARY_FRAGMENT() {
       "adam_fused_step",
       torch_ipex::cpu::adam_fused_step,
       at::DispatchKey::CPU);
+  IPEX_OP_IPEX_REGISTER_DISPATCH(
+      "adam_fused_step_list",
+      torch_ipex::cpu::adam_fused_step_list,
+      at::DispatchKey::CPU);
 }
 
 } // namespace
@@ -63,6 +63,21 @@ void adam_fused_step_kernel_impl(
     double weight_decay,
     double eps);
 
+void adam_fused_step_list_kernel_impl(
+    at::TensorList params_,
+    at::TensorList exp_avgs_,
+    at::TensorList exp_avg_sqs_,
+    at::TensorList max_exp_avg_sqs_,
+    at::TensorList grads_,
+    at::TensorList params2_,
+    bool amsgrad,
+    at::ArrayRef<double> steps,
+    double beta1,
+    double beta2,
+    double learning_rate,
+    double weight_decay,
+    double eps);
+
 } // namespace
 
 using adagrad_fused_step_kernel_fn = std::tuple<at::Tensor, at::Tensor> (*)(
@@ -126,6 +141,24 @@ using adam_fused_step_kernel_fn = void (*)(
     double);
 IPEX_DECLARE_DISPATCH(adam_fused_step_kernel_fn, adam_fused_step_kernel_stub);
 
+using adam_fused_step_list_kernel_fn = void (*)(
+    at::TensorList,
+    at::TensorList,
+    at::TensorList,
+    at::TensorList,
+    at::TensorList,
+    at::TensorList,
+    bool,
+    at::ArrayRef<double>,
+    double,
+    double,
+    double,
+    double,
+    double);
+IPEX_DECLARE_DISPATCH(
+    adam_fused_step_list_kernel_fn,
+    adam_fused_step_list_kernel_stub);
+
 using lars_norm_kernel_fn = float (*)(const at::Tensor&);
 
 IPEX_DECLARE_DISPATCH(lars_norm_kernel_fn, lars_norm_kernel_stub);
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <ATen/ATen.h>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+
+namespace torch_ipex {
+namespace cpu {
+namespace detail {
+
+// Cached per-shape context for the fused flash-attention MHA kernels in
+// csrc/cpu/aten/kernels/MultiHeadAttentionKrnl.cpp. The fused MHA graph
+// rewrite cannot build such a context at rewrite time because the sequence
+// length is only known when the op runs, so the kernels look the context up
+// on the first call for each shape bucket and reuse it afterwards. The
+// steady-state per-call setup is then one map lookup instead of re-deriving
+// the tiling plan and re-allocating the per-thread scratch buffers.
+struct ContextMha final {
+  // Query/key-value tiling derived from the sequence lengths.
+  int64_t q_split_size_;
+  int64_t kv_split_size_;
+  int64_t q_slice_;
+  int64_t q_tail_;
+  int64_t kv_slice_;
+  int64_t kv_tail_;
+  // Softmax scale narrowed to fp32 once instead of on every call.
+  float scale_;
+
+  // Per-thread scratch buffers reused across calls of the same shape bucket.
+  // Their contents are fully re-initialized by the kernel, so only the
+  // allocations are shared; `scratch_in_use_` makes a concurrent caller fall
+  // back to fresh allocations instead of racing on the cached ones.
+  int64_t scratch_threads_ = 0;
+  int64_t scratch_head_size_ = 0;
+  at::Tensor qk_fp32_;
+  at::Tensor qk_bf16_;
+  at::Tensor qk_max_;
+  at::Tensor qk_sum_;
+  at::Tensor dst_fp32_;
+  std::atomic<bool> scratch_in_use_{false};
+
+  ContextMha() = delete;
+
+  ContextMha(
+      int64_t q_size,
+      int64_t kv_size,
+      int64_t q_split_size,
+      int64_t kv_split_size,
+      double scale)
+      : q_split_size_(q_split_size),
+        kv_split_size_(kv_split_size),
+        q_slice_((q_size - 1) / q_split_size + 1),
+        q_tail_((q_size - 1) % q_split_size + 1),
+        kv_slice_((kv_size - 1) / kv_split_size + 1),
+        kv_tail_((kv_size - 1) % kv_split_size + 1),
+        scale_(static_cast<float>(scale)) {}
+
+  ContextMha(const ContextMha&) = delete;
+  ContextMha& operator=(const ContextMha&) = delete;
+};
+
+// Returns the cached context for a shape bucket, creating it on first use.
+// The split sizes are passed in (instead of re-derived here) so that the
+// q/kv block size heuristics stay next to the kernels that own them. The
+// cache is bounded; sentence-length bucketing in serving workloads keeps the
+// number of live buckets small in practice.
+inline std::shared_ptr<ContextMha> get_mha_context(
+    int64_t q_size,
+    int64_t kv_size,
+    int64_t head_size,
+    int64_t q_split_size,
+    int64_t kv_split_size,
+    double scale) {
+  constexpr size_t max_cached_contexts = 64;
+  using Key = std::tuple<int64_t, int64_t, int64_t, int64_t, int64_t, double>;
+  static std::mutex mutex;
+  static std::map<Key, std::shared_ptr<ContextMha>> cache;
+
+  Key key{q_size, kv_size, head_size, q_split_size, kv_split_size, scale};
+  std::lock_guard<std::mutex> guard(mutex);
+  auto it = cache.find(key);
+  if (it != cache.end()) {
+    return it->second;
+  }
+  if (cache.size() >= max_cached_contexts) {
+    cache.erase(cache.begin());
+  }
+  auto context = std::make_shared<ContextMha>(
+      q_size, kv_size, q_split_size, kv_split_size, scale);
+  cache.emplace(std::move(key), context);
+  return context;
+}
+
+// Leases the per-thread scratch buffers of a context for the duration of one
+// kernel call. If the cached buffers are held by a concurrent call, or were
+// sized for a different thread count or head size, fresh tensors are
+// allocated (and adopted by the context when we own the lease).
+class MhaScratchLease final {
+ public:
+  MhaScratchLease(
+      std::shared_ptr<ContextMha> context,
+      int64_t num_thread,
+      int64_t head_size)
+      : context_(std::move(context)) {
+    bool expected = false;
+    owns_cached_ =
+        context_->scratch_in_use_.compare_exchange_strong(expected, true);
+    if (owns_cached_ && context_->scratch_threads_ == num_thread &&
+        context_->scratch_head_size_ == head_size) {
+      qk_fp32_ = context_->qk_fp32_;
+      qk_bf16_ = context_->qk_bf16_;
+      qk_max_ = context_->qk_max_;
+      qk_sum_ = context_->qk_sum_;
+      dst_fp32_ = context_->dst_fp32_;
+      return;
+    }
+    qk_fp32_ = at::empty(
+        {num_thread, context_->q_split_size_, context_->kv_split_size_},
+        at::kFloat);
+    qk_bf16_ = at::empty(
+        {num_thread, context_->q_split_size_, context_->kv_split_size_},
+        at::kBFloat16);
+    qk_max_ = at::empty({num_thread, context_->q_split_size_}, at::kFloat);
+    qk_sum_ = at::empty({num_thread, context_->q_split_size_}, at::kFloat);
+    dst_fp32_ = at::empty(
+        {num_thread, context_->q_split_size_, head_size}, at::kFloat);
+    if (owns_cached_) {
+      context_->scratch_threads_ = num_thread;
+      context_->scratch_head_size_ = head_size;
+      context_->qk_fp32_ = qk_fp32_;
+      context_->qk_bf16_ = qk_bf16_;
+      context_->qk_max_ = qk_max_;
+      context_->qk_sum_ = qk_sum_;
+      context_->dst_fp32_ = dst_fp32_;
+    }
+  }
+
+  ~MhaScratchLease() {
+    if (owns_cached_) {
+      context_->scratch_in_use_.store(false);
+    }
+  }
+
+  MhaScratchLease(const MhaScratchLease&) = delete;
+  MhaScratchLease& operator=(const MhaScratchLease&) = delete;
+
+  at::Tensor qk_fp32_;
+  at::Tensor qk_bf16_;
+  at::Tensor qk_max_;
+  at::Tensor qk_sum_;
+  at::Tensor dst_fp32_;
+
+ private:
+  std::shared_ptr<ContextMha> context_;
+  bool owns_cached_ = false;
+};
+
+} // namespace detail
+} // namespace cpu
+} // namespace torch_ipex
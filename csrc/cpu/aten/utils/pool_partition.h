@@ -0,0 +1,86 @@
+#pragma once
+
+#include <ATen/Parallel.h>
+
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+namespace torch_ipex {
+namespace cpu {
+
+// Adaptive grain size for the hand-written pooling kernels. The fixed
+// grain (0, i.e. one even chunk per thread) starves threads on small
+// spatial dims with many channels and over-partitions big images, so the
+// grain is derived from the bytes of output each work item produces:
+// chunks are sized towards a per-task tile budget, then clamped so every
+// thread gets at least a few chunks (load balance) but no thread drowns
+// in scheduling overhead. The decision is cached per shape since the
+// same pooling shapes repeat every iteration.
+//
+// `IPEX_POOL_TILE_BYTES` overrides the per-chunk output budget for
+// tuning on parts with unusual cache hierarchies.
+constexpr int64_t kDefaultPoolTileBytes = 32 * 1024;
+constexpr int64_t kPoolMinChunksPerThread = 4;
+constexpr int64_t kPoolMaxChunksPerThread = 64;
+
+inline int64_t pool_tile_bytes() {
+  static int64_t bytes = []() {
+    int64_t value = kDefaultPoolTileBytes;
+    auto* env = std::getenv("IPEX_POOL_TILE_BYTES");
+    if (env != nullptr) {
+      try {
+        value = std::stoll(env);
+      } catch (...) {
+        value = kDefaultPoolTileBytes;
+      }
+      if (value <= 0) {
+        value = kDefaultPoolTileBytes;
+      }
+    }
+    return value;
+  }();
+  return bytes;
+}
+
+inline int64_t pooling_grain_size(int64_t work_items, int64_t bytes_per_item) {
+  if (work_items <= 1 || bytes_per_item <= 0) {
+    return 1;
+  }
+  int64_t num_threads = at::get_num_threads();
+
+  using Key = std::tuple<int64_t, int64_t, int64_t>;
+  static std::mutex mutex;
+  static std::map<Key, int64_t> cache;
+  Key key{work_items, bytes_per_item, num_threads};
+  {
+    std::lock_guard<std::mutex> guard(mutex);
+    auto it = cache.find(key);
+    if (it != cache.end()) {
+      return it->second;
+    }
+  }
+
+  int64_t grain = std::max<int64_t>(1, pool_tile_bytes() / bytes_per_item);
+  // Keep every thread fed with a few chunks; cap the chunk count so tiny
+  // items do not degenerate into per-element tasks.
+  int64_t max_grain = std::max<int64_t>(
+      1, work_items / (num_threads * kPoolMinChunksPerThread));
+  int64_t min_grain = std::max<int64_t>(
+      1, work_items / (num_threads * kPoolMaxChunksPerThread));
+  grain = std::min(grain, max_grain);
+  grain = std::max(grain, min_grain);
+
+  {
+    std::lock_guard<std::mutex> guard(mutex);
+    if (cache.size() >= 256) {
+      cache.erase(cache.begin());
+    }
+    cache.emplace(key, grain);
+  }
+  return grain;
+}
+
+} // namespace cpu
+} // namespace torch_ipex
@@ -1,5 +1,7 @@
 #include "autocast_mode.h"
 #include <exception>
+#include <mutex>
+#include <unordered_map>
 #include "library.h"
 
 namespace torch_ipex {
@@ -9,7 +11,79 @@ at::ScalarType get_autocast_dtype() {
   return at::autocast::get_autocast_cpu_dtype();
 }
 
+namespace {
+
+// Weight-cast cache for inference. The upstream autocast cache only covers
+// fp32 leaves that require grad, so under no_grad every forward re-casts the
+// (frozen) fp32 weights to the lower precision dtype. We key the cast result
+// on the source TensorImpl, hold only a weak reference so the cache never
+// extends a weight's lifetime, and treat an entry as stale when the source's
+// version counter bumped (in-place update) or the weak reference expired
+// (which also guards against a new tensor reusing a dead impl's address).
+using weakref_type =
+    c10::weak_intrusive_ptr<c10::TensorImpl, c10::UndefinedTensorImpl>;
+
+struct CastCacheEntry {
+  weakref_type weak;
+  uint32_t version;
+  Tensor casted;
+};
+
+std::mutex cast_cache_mutex;
+std::unordered_map<c10::TensorImpl*, CastCacheEntry> cast_cache;
+// Purge expired entries before growing past this many weights.
+constexpr size_t kCastCachePurgeThreshold = 512;
+
+bool is_weight_cast_cacheable(at::ScalarType to_type, const Tensor& arg) {
+  // Inference tensors do not track a version counter, so in-place updates to
+  // them could not invalidate an entry; leave them on the uncached path.
+  return (to_type == at::kBFloat16 || to_type == at::kHalf) &&
+      arg.scalar_type() == at::kFloat && !arg.requires_grad() &&
+      !arg.is_view() && !arg.is_inference() &&
+      at::autocast::is_autocast_cache_enabled() &&
+      at::autocast::is_autocast_eligible(arg, c10::DeviceType::CPU);
+}
+
+} // namespace
+
+void clear_cpu_cast_cache() {
+  std::lock_guard<std::mutex> lock(cast_cache_mutex);
+  cast_cache.clear();
+}
+
 Tensor cpu_cached_cast(at::ScalarType to_type, const Tensor& arg) {
+  if (arg.defined() && is_weight_cast_cacheable(to_type, arg)) {
+    auto* impl = arg.unsafeGetTensorImpl();
+    uint32_t version = impl->version_counter().current_version();
+    {
+      std::lock_guard<std::mutex> lock(cast_cache_mutex);
+      auto it = cast_cache.find(impl);
+      if (it != cast_cache.end()) {
+        if (it->second.weak.use_count() > 0 &&
+            it->second.version == version &&
+            it->second.casted.scalar_type() == to_type) {
+          return it->second.casted;
+        }
+        cast_cache.erase(it);
+      }
+    }
+    auto casted = at::autocast::cached_cast(to_type, arg, c10::DeviceType::CPU);
+    {
+      std::lock_guard<std::mutex> lock(cast_cache_mutex);
+      if (cast_cache.size() >= kCastCachePurgeThreshold) {
+        for (auto it = cast_cache.begin(); it != cast_cache.end();) {
+          if (it->second.weak.use_count() == 0) {
+            it = cast_cache.erase(it);
+          } else {
+            ++it;
+          }
+        }
+      }
+      cast_cache.emplace(
+          impl, CastCacheEntry{weakref_type(arg.getIntrusivePtr()), version, casted});
+    }
+    return casted;
+  }
   return at::autocast::cached_cast(to_type, arg, c10::DeviceType::CPU);
 }
 
@@ -65,19 +139,44 @@ struct CPU_WrapFunction_<
     guts::typelist::typelist<Args...>> {
   static Ret call(Args... args) {
     c10::impl::ExcludeDispatchKeyGuard no_autocastCPU(DispatchKey::AutocastCPU);
-    auto set_type = get_autocast_dtype();
-    auto policy =
-        (set_type == at::kBFloat16) ? bf16_cast_policy : fp16_cast_policy;
-    switch (policy) {
-      case DtypeCastPolicy::user_defined_dtype:
-        return (*F)(cpu_cached_cast(set_type, args)...);
-      case DtypeCastPolicy::fp32:
-        return (*F)(cpu_cached_cast(at::kFloat, args)...);
-      case DtypeCastPolicy::promote:
-        return (*F)(cpu_cached_cast(
-            promote_type(get_autocast_dtype(), args...), args)...);
-      default:
+    // Both policies are compile-time constants, so whenever they agree the
+    // cast decision does not depend on the configured autocast dtype and the
+    // per-call policy selection folds away entirely. In particular,
+    // cast-neutral ops redispatch without querying the autocast dtype or
+    // touching their tensor arguments.
+    if constexpr (bf16_cast_policy == fp16_cast_policy) {
+      if constexpr (bf16_cast_policy == DtypeCastPolicy::fallthrough) {
         return (*F)(args...);
+      } else if constexpr (bf16_cast_policy == DtypeCastPolicy::fp32) {
+        return (*F)(cpu_cached_cast(at::kFloat, args)...);
+      } else if constexpr (bf16_cast_policy == DtypeCastPolicy::promote) {
+        // Hoisted out of the pack expansion so the promote type is computed
+        // once per call rather than once per argument.
+        auto to_type = promote_type(get_autocast_dtype(), args...);
+        return (*F)(cpu_cached_cast(to_type, args)...);
+      } else {
+        static_assert(
+            bf16_cast_policy == DtypeCastPolicy::user_defined_dtype,
+            "unexpected cast policy");
+        auto set_type = get_autocast_dtype();
+        return (*F)(cpu_cached_cast(set_type, args)...);
+      }
+    } else {
+      auto set_type = get_autocast_dtype();
+      auto policy =
+          (set_type == at::kBFloat16) ? bf16_cast_policy : fp16_cast_policy;
+      switch (policy) {
+        case DtypeCastPolicy::user_defined_dtype:
+          return (*F)(cpu_cached_cast(set_type, args)...);
+        case DtypeCastPolicy::fp32:
+          return (*F)(cpu_cached_cast(at::kFloat, args)...);
+        case DtypeCastPolicy::promote: {
+          auto to_type = promote_type(set_type, args...);
+          return (*F)(cpu_cached_cast(to_type, args)...);
+        }
+        default:
+          return (*F)(args...);
+      }
     }
   }
 };
@@ -43,6 +43,10 @@ IPEX_API at::ScalarType get_autocast_dtype();
 
 Tensor cpu_cached_cast(at::ScalarType to_type, const Tensor& arg);
 
+// Drops every entry of the inference weight-cast cache (see
+// cpu_cached_cast); stale entries are otherwise evicted lazily.
+IPEX_API void clear_cpu_cast_cache();
+
 inline c10::optional<Tensor> cpu_cached_cast(
     at::ScalarType to_type,
     const c10::optional<Tensor>& arg) {
@@ -7,8 +7,14 @@
 #include <dnnl.hpp>
 
 #include <algorithm>
+#include <cctype>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+#include <utility>
 
 namespace torch_ipex {
 namespace cpu {
@@ -41,6 +47,33 @@ const char* CPUCapabilityToString(CPUCapability isa) {
   }
 }
 
+bool CPUCapabilityFromString(const std::string& isa_str, CPUCapability& isa) {
+  std::string lower = isa_str;
+  std::transform(lower.begin(), lower.end(), lower.begin(), [](char c) {
+    return std::tolower(c);
+  });
+  if (lower == "default") {
+    isa = CPUCapability::DEFAULT;
+  } else if (lower == "avx2") {
+    isa = CPUCapability::AVX2;
+  } else if (lower == "avx2_vnni") {
+    isa = CPUCapability::AVX2_VNNI;
+  } else if (lower == "avx512") {
+    isa = CPUCapability::AVX512;
+  } else if (lower == "avx512_vnni") {
+    isa = CPUCapability::AVX512_VNNI;
+  } else if (lower == "avx512_bf16") {
+    isa = CPUCapability::AVX512_BF16;
+  } else if (lower == "amx") {
+    isa = CPUCapability::AMX;
+  } else if (lower == "avx512_fp16") {
+    isa = CPUCapability::AVX512_FP16;
+  } else {
+    return false;
+  }
+  return true;
+}
+
 CPUCapability _get_highest_cpu_support_isa_level() {
   /*
   reference to FindAVX.cmake
@@ -209,6 +242,384 @@ CPUCapability get_cpu_capability() {
   return g_cpu_capability;
 }
 
+const char* CPUUarchToString(CPUUarch uarch) {
+  switch (uarch) {
+    case CPUUarch::SPR:
+      return "spr";
+    case CPUUarch::GNR:
+      return "gnr";
+    case CPUUarch::GENERIC:
+    default:
+      return "generic";
+  }
+}
+
+static CPUUarch compute_cpu_uarch() {
+  // _IPEX_CPU_UARCH is debug only env: forces the microarchitecture the
+  // tuned kernel variants are checked against ("spr", "gnr", "generic").
+  auto envar = std::getenv("_IPEX_CPU_UARCH");
+  if (envar) {
+    if (strcmp(envar, "spr") == 0) {
+      return CPUUarch::SPR;
+    } else if (strcmp(envar, "gnr") == 0) {
+      return CPUUarch::GNR;
+    } else if (strcmp(envar, "generic") == 0) {
+      return CPUUarch::GENERIC;
+    }
+    TORCH_WARN("ignoring invalid value for _IPEX_CPU_UARCH: ", envar);
+  }
+  auto& feature = CPUFeature::get_instance();
+  if (feature.cpu_family() != 0x6) {
+    return CPUUarch::GENERIC;
+  }
+  switch (feature.cpu_model()) {
+    case 0x8F: // Sapphire Rapids
+    case 0xCF: // Emerald Rapids, same performance core as SPR
+      return CPUUarch::SPR;
+    case 0xAD: // Granite Rapids
+    case 0xAE: // Granite Rapids D
+      return CPUUarch::GNR;
+    default:
+      return CPUUarch::GENERIC;
+  }
+}
+
+CPUUarch get_cpu_uarch() {
+  static CPUUarch g_cpu_uarch = compute_cpu_uarch();
+  return g_cpu_uarch;
+}
+
+void register_uarch_dispatch(
+    DispatchStubImpl* impl,
+    const char* uarch_name,
+    CPUCapability compiled_level,
+    void* fn) {
+  if (strcmp(uarch_name, CPUUarchToString(get_cpu_uarch())) != 0) {
+    return;
+  }
+  // The variant was compiled at the highest ISA level the build found; if the
+  // running machine cannot execute that level the generic ladder applies.
+  CPUCapability max_support_isa_level = std::min(
+      _get_highest_cpu_support_isa_level(),
+      _get_highest_binary_support_isa_level());
+  if (compiled_level > max_support_isa_level) {
+    return;
+  }
+  impl->uarch_capability.store(
+      static_cast<int>(compiled_level), std::memory_order_relaxed);
+  impl->uarch_dispatch_ptr.store(fn, std::memory_order_relaxed);
+}
+
+namespace {
+
+struct DispatchStubRegistry {
+  std::mutex mutex;
+  // registration order is kept so the introspection output is stable
+  std::vector<std::pair<std::string, DispatchStubImpl*>> stubs;
+  std::unordered_map<std::string, DispatchStubImpl*> by_name;
+};
+
+DispatchStubRegistry& dispatch_stub_registry() {
+  static DispatchStubRegistry registry;
+  return registry;
+}
+
+// Parses a flat {"stub": "isa", ...} JSON object. Only string keys/values are
+// expected, so a full JSON parser is not needed here.
+void parse_flat_json_overrides(
+    const std::string& text,
+    std::unordered_map<std::string, std::string>& out) {
+  size_t pos = 0;
+  auto next_string = [&](std::string& str) -> bool {
+    auto start = text.find('"', pos);
+    if (start == std::string::npos)
+      return false;
+    auto end = text.find('"', start + 1);
+    if (end == std::string::npos)
+      return false;
+    str = text.substr(start + 1, end - start - 1);
+    pos = end + 1;
+    return true;
+  };
+  std::string key;
+  std::string value;
+  while (next_string(key)) {
+    auto colon = text.find(':', pos);
+    if (colon == std::string::npos)
+      break;
+    pos = colon + 1;
+    if (!next_string(value))
+      break;
+    out[key] = value;
+  }
+}
+
+// Overrides requested via IPEX_DISPATCH_OVERRIDES: either an inline
+// "stub=isa,stub=isa" list, or the path of a JSON file with a flat
+// {"stub": "isa"} object. Parsed once; stubs pick their entry up when they
+// register at load time.
+const std::unordered_map<std::string, std::string>& env_dispatch_overrides() {
+  static auto overrides = []() {
+    std::unordered_map<std::string, std::string> map;
+    auto envar = std::getenv("IPEX_DISPATCH_OVERRIDES");
+    if (!envar) {
+      return map;
+    }
+    std::string value(envar);
+    if (value.find('=') == std::string::npos &&
+        value.find('{') == std::string::npos) {
+      std::ifstream file(value);
+      if (!file) {
+        TORCH_WARN(
+            "DispatchStub: cannot open override file from "
+            "IPEX_DISPATCH_OVERRIDES: ",
+            value);
+        return map;
+      }
+      std::stringstream buffer;
+      buffer << file.rdbuf();
+      value = buffer.str();
+    }
+    if (value.find('{') != std::string::npos) {
+      parse_flat_json_overrides(value, map);
+    } else {
+      std::stringstream stream(value);
+      std::string entry;
+      while (std::getline(stream, entry, ',')) {
+        auto sep = entry.find('=');
+        if (sep == std::string::npos) {
+          TORCH_WARN(
+              "DispatchStub: ignoring malformed IPEX_DISPATCH_OVERRIDES "
+              "entry: ",
+              entry);
+          continue;
+        }
+        map[entry.substr(0, sep)] = entry.substr(sep + 1);
+      }
+    }
+    return map;
+  }();
+  return overrides;
+}
+
+// Applies an override string to a stub. Returns false and fills error_msg
+// instead of throwing, since this also runs during static initialization.
+bool try_set_stub_override(
+    DispatchStubImpl* impl,
+    const std::string& isa_str,
+    std::string& error_msg) {
+  if (isa_str.empty() || isa_str == "auto") {
+    impl->override_capability.store(-1, std::memory_order_relaxed);
+    impl->cpu_dispatch_ptr.store(nullptr, std::memory_order_relaxed);
+    return true;
+  }
+  CPUCapability isa;
+  if (!CPUCapabilityFromString(isa_str, isa)) {
+    error_msg = c10::str("unknown ISA level: ", isa_str);
+    return false;
+  }
+  CPUCapability max_support_isa_level = std::min(
+      _get_highest_cpu_support_isa_level(),
+      _get_highest_binary_support_isa_level());
+  if (isa > max_support_isa_level) {
+    error_msg = c10::str(
+        isa_str,
+        " exceeds the highest supported ISA level ",
+        CPUCapabilityToString(max_support_isa_level));
+    return false;
+  }
+  impl->override_capability.store(
+      static_cast<int>(isa), std::memory_order_relaxed);
+  impl->cpu_dispatch_ptr.store(nullptr, std::memory_order_relaxed);
+  return true;
+}
+
+} // anonymous namespace
+
+void register_dispatch_stub(const char* name, DispatchStubImpl* impl) {
+  auto& registry = dispatch_stub_registry();
+  std::lock_guard<std::mutex> guard(registry.mutex);
+  if (!registry.by_name.emplace(name, impl).second) {
+    return;
+  }
+  registry.stubs.emplace_back(name, impl);
+  auto& overrides = env_dispatch_overrides();
+  auto it = overrides.find(name);
+  if (it != overrides.end()) {
+    std::string error_msg;
+    if (!try_set_stub_override(impl, it->second, error_msg)) {
+      TORCH_WARN(
+          "DispatchStub: ignoring IPEX_DISPATCH_OVERRIDES entry for ",
+          name,
+          ": ",
+          error_msg);
+    }
+  }
+}
+
+std::vector<DispatchStubInfo> list_dispatch_stubs() {
+  auto& registry = dispatch_stub_registry();
+  std::lock_guard<std::mutex> guard(registry.mutex);
+  std::vector<DispatchStubInfo> infos;
+  infos.reserve(registry.stubs.size());
+  for (auto& entry : registry.stubs) {
+    DispatchStubInfo info;
+    info.name = entry.first;
+    auto chosen = entry.second->chosen_capability.load(std::memory_order_relaxed);
+    if (chosen >= 0) {
+      info.chosen_isa = CPUCapabilityToString(static_cast<CPUCapability>(chosen));
+    }
+    auto override_isa =
+        entry.second->override_capability.load(std::memory_order_relaxed);
+    if (override_isa >= 0) {
+      info.override_isa =
+          CPUCapabilityToString(static_cast<CPUCapability>(override_isa));
+    }
+    infos.push_back(std::move(info));
+  }
+  return infos;
+}
+
+void set_dispatch_stub_override(
+    const std::string& name,
+    const std::string& isa_str) {
+  auto& registry = dispatch_stub_registry();
+  std::lock_guard<std::mutex> guard(registry.mutex);
+  auto it = registry.by_name.find(name);
+  TORCH_CHECK(
+      it != registry.by_name.end(),
+      "DispatchStub: no stub registered under name ",
+      name);
+  std::string error_msg;
+  TORCH_CHECK(
+      try_set_stub_override(it->second, isa_str, error_msg),
+      "DispatchStub: cannot override ",
+      name,
+      ": ",
+      error_msg);
+}
+
+namespace {
+
+struct SizeClassRegistry {
+  std::mutex mutex;
+  // registration order is kept so the introspection output is stable; the
+  // per-ISA copies of a kernel file each register their own threshold block
+  // under the same name
+  std::vector<std::string> names;
+  std::unordered_map<std::string, std::vector<SizeClassThresholds*>> by_name;
+};
+
+SizeClassRegistry& size_class_registry() {
+  static SizeClassRegistry registry;
+  return registry;
+}
+
+// Threshold overrides requested via IPEX_SIZE_CLASS_THRESHOLDS, a
+// "stub=small:medium,stub=small:medium" list. Parsed once; kernels pick
+// their entry up when they register at load time.
+const std::unordered_map<std::string, std::pair<int64_t, int64_t>>&
+env_size_class_overrides() {
+  static auto overrides = []() {
+    std::unordered_map<std::string, std::pair<int64_t, int64_t>> map;
+    auto envar = std::getenv("IPEX_SIZE_CLASS_THRESHOLDS");
+    if (!envar) {
+      return map;
+    }
+    std::stringstream stream(envar);
+    std::string entry;
+    while (std::getline(stream, entry, ',')) {
+      auto sep = entry.find('=');
+      auto colon = entry.find(':', sep == std::string::npos ? 0 : sep);
+      if (sep == std::string::npos || colon == std::string::npos) {
+        TORCH_WARN(
+            "DispatchStub: ignoring malformed IPEX_SIZE_CLASS_THRESHOLDS "
+            "entry: ",
+            entry);
+        continue;
+      }
+      try {
+        auto small_limit = std::stoll(entry.substr(sep + 1, colon - sep - 1));
+        auto medium_limit = std::stoll(entry.substr(colon + 1));
+        map[entry.substr(0, sep)] = {small_limit, medium_limit};
+      } catch (const std::exception&) {
+        TORCH_WARN(
+            "DispatchStub: ignoring malformed IPEX_SIZE_CLASS_THRESHOLDS "
+            "entry: ",
+            entry);
+      }
+    }
+    return map;
+  }();
+  return overrides;
+}
+
+} // anonymous namespace
+
+void register_size_class_thresholds(
+    const char* name,
+    SizeClassThresholds* thresholds,
+    int64_t small_limit,
+    int64_t medium_limit) {
+  auto& overrides = env_size_class_overrides();
+  auto it = overrides.find(name);
+  if (it != overrides.end()) {
+    small_limit = it->second.first;
+    medium_limit = it->second.second;
+  }
+  thresholds->small_limit.store(small_limit, std::memory_order_relaxed);
+  thresholds->medium_limit.store(medium_limit, std::memory_order_relaxed);
+  auto& registry = size_class_registry();
+  std::lock_guard<std::mutex> guard(registry.mutex);
+  auto& instances = registry.by_name[name];
+  if (instances.empty()) {
+    registry.names.emplace_back(name);
+  }
+  instances.push_back(thresholds);
+}
+
+std::vector<SizeClassInfo> list_size_class_thresholds() {
+  auto& registry = size_class_registry();
+  std::lock_guard<std::mutex> guard(registry.mutex);
+  std::vector<SizeClassInfo> infos;
+  infos.reserve(registry.names.size());
+  for (auto& name : registry.names) {
+    auto* thresholds = registry.by_name[name].front();
+    SizeClassInfo info;
+    info.name = name;
+    info.small_limit =
+        thresholds->small_limit.load(std::memory_order_relaxed);
+    info.medium_limit =
+        thresholds->medium_limit.load(std::memory_order_relaxed);
+    infos.push_back(std::move(info));
+  }
+  return infos;
+}
+
+void set_size_class_thresholds(
+    const std::string& name,
+    int64_t small_limit,
+    int64_t medium_limit) {
+  TORCH_CHECK(
+      small_limit >= 0 && medium_limit >= small_limit,
+      "DispatchStub: size class thresholds must satisfy 0 <= small <= medium, "
+      "got ",
+      small_limit,
+      " and ",
+      medium_limit);
+  auto& registry = size_class_registry();
+  std::lock_guard<std::mutex> guard(registry.mutex);
+  auto it = registry.by_name.find(name);
+  TORCH_CHECK(
+      it != registry.by_name.end(),
+      "DispatchStub: no size-classed kernel registered under name ",
+      name);
+  for (auto* thresholds : it->second) {
+    thresholds->small_limit.store(small_limit, std::memory_order_relaxed);
+    thresholds->medium_limit.store(medium_limit, std::memory_order_relaxed);
+  }
+}
+
 void* DispatchStubImpl::get_call_ptr(
     DeviceType device_type,
     void* DEFAULT
@@ -247,6 +658,18 @@ void* DispatchStubImpl::get_call_ptr(
       // they will still compute the same value for cpu_dispatch_ptr.
       auto fptr = cpu_dispatch_ptr.load(std::memory_order_relaxed);
       if (!fptr) {
+        // A microarchitecture-tuned variant matching this CPU model wins
+        // over the generic copy of its ISA level, unless the stub has been
+        // pinned to an explicit level.
+        auto uarch_fptr = uarch_dispatch_ptr.load(std::memory_order_relaxed);
+        if (uarch_fptr &&
+            override_capability.load(std::memory_order_relaxed) < 0) {
+          chosen_capability.store(
+              uarch_capability.load(std::memory_order_relaxed),
+              std::memory_order_relaxed);
+          cpu_dispatch_ptr.store(uarch_fptr, std::memory_order_relaxed);
+          return uarch_fptr;
+        }
         fptr = choose_cpu_impl(
             DEFAULT
 #ifdef HAVE_AVX512_FP16_CPU_DEFINITION
@@ -327,7 +750,21 @@ void* DispatchStubImpl::choose_cpu_impl(
 #endif
 ) {
   auto capability = static_cast<int>(get_cpu_capability());
+  // A per-stub override pins this stub to a specific ISA level, keeping the
+  // global capability for every other stub.
+  auto forced_capability = override_capability.load(std::memory_order_relaxed);
+  if (forced_capability >= 0) {
+    capability = forced_capability;
+  }
   (void)capability;
+  // record the decision for the introspection API before handing the
+  // function pointer back
+  auto select = [this](CPUCapability isa, void* fn) {
+    chosen_capability.store(
+        static_cast<int>(isa), std::memory_order_relaxed);
+    return fn;
+  };
+  (void)select;
 #ifdef HAVE_AVX512_FP16_CPU_DEFINITION
   if (capability >= static_cast<int>(CPUCapability::AVX512_FP16)) {
     // Quantization kernels have also been disabled on Windows
@@ -336,9 +773,9 @@ void* DispatchStubImpl::choose_cpu_impl(
     if (C10_UNLIKELY(!AVX512_FP16)) {
       // dispatch to AVX2, since the AVX512 kernel is missing
       TORCH_INTERNAL_ASSERT(AVX2, "DispatchStub: missing AVX2 kernel");
-      return AVX2;
+      return select(CPUCapability::AVX2, AVX2);
     } else {
-      return AVX512_FP16;
+      return select(CPUCapability::AVX512_FP16, AVX512_FP16);
     }
   }
 #endif
@@ -350,9 +787,9 @@ void* DispatchStubImpl::choose_cpu_impl(
     if (C10_UNLIKELY(!AMX)) {
       // dispatch to AVX2, since the AVX512 kernel is missing
       TORCH_INTERNAL_ASSERT(AVX2, "DispatchStub: missing AVX2 kernel");
-      return AVX2;
+      return select(CPUCapability::AVX2, AVX2);
     } else {
-      return AMX;
+      return select(CPUCapability::AMX, AMX);
     }
   }
 #endif
@@ -364,9 +801,9 @@ void* DispatchStubImpl::choose_cpu_impl(
     if (C10_UNLIKELY(!AVX512_BF16)) {
       // dispatch to AVX2, since the AVX512 kernel is missing
       TORCH_INTERNAL_ASSERT(AVX2, "DispatchStub: missing AVX2 kernel");
-      return AVX2;
+      return select(CPUCapability::AVX2, AVX2);
     } else {
-      return AVX512_BF16;
+      return select(CPUCapability::AVX512_BF16, AVX512_BF16);
     }
   }
 #endif
@@ -378,9 +815,9 @@ void* DispatchStubImpl::choose_cpu_impl(
     if (C10_UNLIKELY(!AVX512_VNNI)) {
       // dispatch to AVX2, since the AVX512 kernel is missing
       TORCH_INTERNAL_ASSERT(AVX2, "DispatchStub: missing AVX2 kernel");
-      return AVX2;
+      return select(CPUCapability::AVX2, AVX2);
     } else {
-      return AVX512_VNNI;
+      return select(CPUCapability::AVX512_VNNI, AVX512_VNNI);
     }
   }
 #endif
@@ -392,27 +829,27 @@ void* DispatchStubImpl::choose_cpu_impl(
     if (C10_UNLIKELY(!AVX512)) {
       // dispatch to AVX2, since the AVX512 kernel is missing
       TORCH_INTERNAL_ASSERT(AVX2, "DispatchStub: missing AVX2 kernel");
-      return AVX2;
+      return select(CPUCapability::AVX2, AVX2);
     } else {
-      return AVX512;
+      return select(CPUCapability::AVX512, AVX512);
     }
   }
 #endif
 #ifdef HAVE_AVX2_VNNI_CPU_DEFINITION
   if (capability >= static_cast<int>(CPUCapability::AVX2_VNNI)) {
     TORCH_INTERNAL_ASSERT(AVX2_VNNI, "DispatchStub: missing AVX2_VNNI kernel");
-    return AVX2_VNNI;
+    return select(CPUCapability::AVX2_VNNI, AVX2_VNNI);
   }
 #endif
 #ifdef HAVE_AVX2_CPU_DEFINITION
   if (capability >= static_cast<int>(CPUCapability::AVX2)) {
     TORCH_INTERNAL_ASSERT(AVX2, "DispatchStub: missing AVX2 kernel");
-    return AVX2;
+    return select(CPUCapability::AVX2, AVX2);
   }
 #endif
 
   TORCH_INTERNAL_ASSERT(DEFAULT, "DispatchStub: missing default kernel");
-  return DEFAULT;
+  return select(CPUCapability::DEFAULT, DEFAULT);
 }
 
 } // namespace cpu
@@ -6,7 +6,10 @@
 
 #include <Macros.h>
 #include <atomic>
+#include <cstdint>
+#include <string>
 #include <type_traits>
+#include <vector>
 
 using namespace c10;
 
@@ -63,6 +66,9 @@ enum class CPUCapability {
 };
 
 const char* CPUCapabilityToString(CPUCapability isa);
+// Parses the lowercase ISA names used by ATEN_CPU_CAPABILITY (e.g. "avx2",
+// "avx512_bf16"). Returns false if the string names no known ISA level.
+bool CPUCapabilityFromString(const std::string& isa_str, CPUCapability& isa);
 CPUCapability _get_highest_cpu_support_isa_level();
 CPUCapability _get_highest_binary_support_isa_level();
 
@@ -70,6 +76,21 @@ bool check_not_sync_onednn_isa_level();
 
 CPUCapability get_cpu_capability();
 
+// Microarchitecture of the running CPU, orthogonal to the ISA ladder above.
+// The per-ISA kernel copies are scheduled for a generic pipeline; for a few
+// GEMM-adjacent kernels the tuning model (L2 size, port layout) matters
+// enough that the build can optionally emit extra -mtune copies of the
+// highest ISA level (IPEX_ENABLE_UARCH_TUNING, cmake/cpu/IsaCodegen.cmake)
+// which take precedence over the generic copy when the model matches.
+enum class CPUUarch {
+  GENERIC = 0,
+  SPR, // Sapphire Rapids; Emerald Rapids shares the core and the tuning
+  GNR, // Granite Rapids
+};
+
+const char* CPUUarchToString(CPUUarch uarch);
+CPUUarch get_cpu_uarch();
+
 template <typename FnPtr, typename T>
 struct DispatchStub;
 
@@ -159,6 +180,140 @@ struct IPEX_API DispatchStubImpl {
   std::atomic<void*> cpu_dispatch_ptr{nullptr};
   void* xpu_dispatch_ptr = nullptr;
 #endif
+
+  // The ISA level choose_cpu_impl() settled on, recorded at dispatch time for
+  // introspection. -1 until the stub has been called at least once.
+  std::atomic<int> chosen_capability{-1};
+  // Per-stub override of the global capability. -1 means no override, i.e.
+  // follow get_cpu_capability(). Setting it resets cpu_dispatch_ptr so the
+  // next call re-runs the kernel selection.
+  std::atomic<int> override_capability{-1};
+
+  // Microarchitecture-tuned kernel variant, filled in at load time when a
+  // -mtune copy matches the running CPU model. Preferred over the ISA-level
+  // selection unless an override pins the stub to an explicit level.
+  std::atomic<void*> uarch_dispatch_ptr{nullptr};
+  // ISA level the tuned variant was compiled at, for introspection.
+  std::atomic<int> uarch_capability{-1};
+};
+
+/**
+ * A snapshot of one registered stub: which kernel variant was chosen at
+ * dispatch time (empty until the stub was first called) and which variant is
+ * pinned by an override (empty when the stub follows the global capability).
+ */
+struct DispatchStubInfo {
+  std::string name;
+  std::string chosen_isa;
+  std::string override_isa;
+};
+
+// Every stub defined via IPEX_DEFINE_DISPATCH registers itself here, so the
+// selection can be inspected and overridden at runtime without rebuilding.
+IPEX_API void register_dispatch_stub(const char* name, DispatchStubImpl* impl);
+IPEX_API std::vector<DispatchStubInfo> list_dispatch_stubs();
+// Pins the given stub to the given ISA level ("avx2", "default", ...). An
+// empty string or "auto" removes the override. Throws if the stub is unknown,
+// the ISA name is invalid, or the level exceeds what this machine and binary
+// support. Overrides can also be preloaded from the IPEX_DISPATCH_OVERRIDES
+// environment variable: either an inline "stub=isa,stub=isa" list, or the
+// path of a JSON file holding a flat {"stub": "isa"} object.
+IPEX_API void set_dispatch_stub_override(
+    const std::string& name,
+    const std::string& isa_str);
+
+// Called by the registrars of -mtune kernel variants (IPEX_REGISTER_DISPATCH
+// in a CPU_UARCH translation unit). The variant only sticks when it matches
+// the detected microarchitecture and its ISA level is supported by this
+// machine.
+IPEX_API void register_uarch_dispatch(
+    DispatchStubImpl* impl,
+    const char* uarch_name,
+    CPUCapability compiled_level,
+    void* fn);
+
+// DispatchStub picks a kernel per ISA level; many kernels additionally pick
+// an algorithm per problem size (e.g. the sum cascade vs a plain running
+// loop). SizeClassedKernel hoists that choice out of the kernel: a kernel
+// translation unit declares one triple of {small, medium, large} function
+// pointers plus two thresholds, and resolves the class with two compares
+// before entering the hot loop. The thresholds are runtime-tunable through
+// the same override surface as the ISA choice.
+enum class SizeClass {
+  SMALL = 0,
+  MEDIUM = 1,
+  LARGE = 2,
+};
+
+struct SizeClassThresholds {
+  std::atomic<int64_t> small_limit{0};
+  std::atomic<int64_t> medium_limit{0};
+
+  SizeClass classify(int64_t n) const {
+    if (n <= small_limit.load(std::memory_order_relaxed)) {
+      return SizeClass::SMALL;
+    }
+    if (n <= medium_limit.load(std::memory_order_relaxed)) {
+      return SizeClass::MEDIUM;
+    }
+    return SizeClass::LARGE;
+  }
+};
+
+struct SizeClassInfo {
+  std::string name;
+  int64_t small_limit;
+  int64_t medium_limit;
+};
+
+// Every SizeClassedKernel registers its thresholds here under the stub name.
+// The per-ISA copies of a kernel file each carry their own instance, so one
+// name may map to several threshold blocks; the setter updates all of them.
+// Defaults can be overridden from the IPEX_SIZE_CLASS_THRESHOLDS environment
+// variable: a "stub=small:medium,stub=small:medium" list.
+IPEX_API void register_size_class_thresholds(
+    const char* name,
+    SizeClassThresholds* thresholds,
+    int64_t small_limit,
+    int64_t medium_limit);
+IPEX_API std::vector<SizeClassInfo> list_size_class_thresholds();
+IPEX_API void set_size_class_thresholds(
+    const std::string& name,
+    int64_t small_limit,
+    int64_t medium_limit);
+
+template <typename FnPtr>
+struct SizeClassedKernel {
+  SizeClassedKernel(
+      const char* name,
+      FnPtr small,
+      FnPtr medium,
+      FnPtr large,
+      int64_t small_limit,
+      int64_t medium_limit)
+      : small(small), medium(medium), large(large) {
+    register_size_class_thresholds(
+        name, &thresholds, small_limit, medium_limit);
+  }
+  SizeClassedKernel(const SizeClassedKernel&) = delete;
+  SizeClassedKernel& operator=(const SizeClassedKernel&) = delete;
+
+  FnPtr select(int64_t n) const {
+    switch (thresholds.classify(n)) {
+      case SizeClass::SMALL:
+        return small;
+      case SizeClass::MEDIUM:
+        return medium;
+      case SizeClass::LARGE:
+      default:
+        return large;
+    }
+  }
+
+  FnPtr small;
+  FnPtr medium;
+  FnPtr large;
+  SizeClassThresholds thresholds;
 };
 
 template <typename rT, typename T, typename... Args>
@@ -216,6 +371,10 @@ struct DispatchStub<rT (*)(Args...), T> {
     impl.xpu_dispatch_ptr = reinterpret_cast<void*>(fn_ptr);
   }
 
+  DispatchStubImpl* impl_ptr() {
+    return &impl;
+  }
+
   static FnPtr DEFAULT;
 #ifdef HAVE_AVX512_FP16_CPU_DEFINITION
   static FnPtr AVX512_FP16;
@@ -258,6 +417,21 @@ struct RegisterHIPDispatch {
     stub.set_cuda_dispatch_ptr(value);
   }
 };
+
+template <typename FnPtr, typename T>
+struct RegisterUarchDispatch {
+  RegisterUarchDispatch(
+      DispatchStub<FnPtr, T>& stub,
+      const char* uarch_name,
+      CPUCapability compiled_level,
+      FnPtr value) {
+    register_uarch_dispatch(
+        stub.impl_ptr(),
+        uarch_name,
+        compiled_level,
+        reinterpret_cast<void*>(value));
+  }
+};
 } // anonymous namespace
 
 // Compiler will complain if you put things like std::tuple<Tensor, Tensor> in
@@ -273,7 +447,10 @@ struct RegisterHIPDispatch {
   };                                       \
   extern IPEX_API struct name name
 
-#define IPEX_DEFINE_DISPATCH(name) struct name name
+#define IPEX_DEFINE_DISPATCH(name)                 \
+  struct name name;                                \
+  static const bool C10_UNUSED name##__registered = \
+      (torch_ipex::cpu::register_dispatch_stub(#name, name.impl_ptr()), true)
 
 #undef IPEX_REGISTER_ARCH_DISPATCH
 #define IPEX_REGISTER_ARCH_DISPATCH(name, arch, fn) \
@@ -322,6 +499,20 @@ ToDo: Fix warning: "REGISTER_HIP_DISPATCH" redefined to stock pytorch.
 // is HIP in the PyTorch HIPify build.
 #define IPEX_REGISTER_DISPATCH(name, fn) REGISTER_CUDA_DISPATCH(name, fn)
 // #define IPEX_REGISTER_DISPATCH(name, fn) REGISTER_HIP_DISPATCH(name, fn)
+#elif defined(CPU_UARCH)
+// Translation unit of a -mtune'd kernel variant. The generic copy of the
+// same ISA level already defines the DispatchStub<> specialization for
+// CPU_CAPABILITY, so the variant goes through the runtime side table
+// instead of a second (ODR-conflicting) specialization.
+#define IPEX_REGISTER_DISPATCH(name, fn)                   \
+  static RegisterUarchDispatch<decltype(fn), struct name>  \
+      name##__uarch_register(                              \
+          name,                                            \
+          C10_STRINGIZE(CPU_UARCH),                        \
+          CPUCapability::CPU_CAPABILITY,                   \
+          fn);
+#undef IPEX_REGISTER_NO_AVX512_DISPATCH
+#define IPEX_REGISTER_NO_AVX512_DISPATCH(name, fn_type)
 #elif defined(CPU_CAPABILITY)
 #define IPEX_REGISTER_DISPATCH(name, fn) \
   IPEX_REGISTER_ARCH_DISPATCH(name, CPU_CAPABILITY, fn)
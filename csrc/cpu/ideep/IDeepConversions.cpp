@@ -225,6 +225,38 @@ at::Tensor mkldnn_to_dense(
   return cpu_tensor;
 }
 
+at::Tensor dense_view_from_itensor(
+    ideep::tensor&& it,
+    c10::optional<at::ScalarType> dtype,
+    c10::optional<c10::Device> device) {
+  auto data_type = dtype_or_default(dtype);
+  auto desc = it.get_desc();
+  if (!it.is_empty() && desc.is_plain() &&
+      get_mkldnn_dtype(data_type) == it.get_data_type()) {
+    auto dims = it.get_dims();
+    std::vector<int64_t> sizes(dims.begin(), dims.end());
+    int64_t nelems = 1;
+    for (auto s : sizes) {
+      nelems *= s;
+    }
+    caffe2::TypeMeta dtype_ = scalarTypeToTypeMeta(data_type);
+    // A plain desc can still carry padded dims; only alias the buffer when
+    // it holds exactly the logical elements.
+    if ((int64_t)desc.get_size() == nelems * (int64_t)dtype_.itemsize()) {
+      auto it_strides = it.get_strides();
+      std::vector<int64_t> strides(it_strides.begin(), it_strides.end());
+      auto handle = std::make_shared<ideep::tensor>(std::move(it));
+      return at::from_blob(
+          handle->get_data_handle(),
+          sizes,
+          strides,
+          [handle](void*) mutable { handle.reset(); },
+          at::TensorOptions().dtype(dtype_).device(device_or_default(device)));
+    }
+  }
+  return mkldnn_to_dense(new_with_itensor_mkldnn(std::move(it), dtype, device));
+}
+
 // Init a aten tensor according to ideep tensor's desc.
 at::Tensor empty_aten_tensor_from_desc(
     const ideep::tensor::desc& desc,
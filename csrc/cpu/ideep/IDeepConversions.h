@@ -8,8 +8,15 @@
 
 #include <oneapi/dnnl/dnnl_types.h>
 
+#include "utils/fpmath_mode.h"
+
 namespace torch_ipex {
 extern dnnl_fpmath_mode_t fpmath_mode;
+
+// Effective fpmath mode for one op category: the innermost scoped
+// policy active on this thread when there is one, otherwise the global
+// fpmath_mode above.
+dnnl_fpmath_mode_t get_fpmath_mode(FpMathOpCategory category);
 namespace cpu {
 
 // Mapping ScalarType to ideep tensor data_type
@@ -35,6 +42,17 @@ at::Tensor mkldnn_to_dense(
     const at::Tensor& self,
     c10::optional<at::ScalarType> dtype = c10::nullopt);
 
+// Construct a dense aten tensor from an ideep tensor. When the ideep tensor
+// is already in a plain (non-blocked, non-padded) layout of the requested
+// dtype, the aten tensor wraps the ideep buffer without copying and keeps the
+// ideep tensor alive through its deleter; blocked or padded layouts fall back
+// to the reorder+copy of mkldnn_to_dense. The ideep tensor must own (or
+// outlive through) the buffer it points at, as with itensor_view_from_dense.
+at::Tensor dense_view_from_itensor(
+    ideep::tensor&& it,
+    c10::optional<at::ScalarType> dtype,
+    c10::optional<c10::Device> device);
+
 at::Tensor empty_aten_tensor_from_desc(
     const ideep::tensor::desc& desc,
     const at::TensorOptions& options);
@@ -1,16 +1,17 @@
 #include <ATen/ATen.h>
 #include <ATen/Config.h>
 
+#include "utils/onednn_utils.h"
+
 // needs to be included only once in library.
 #include <ideep_pin_singletons.hpp>
 
 using namespace ideep;
 
+// Engine allocations (dominated by primitive scratchpads) go through the
+// thread-aware arena so steady-state executions reuse the previous call's
+// block instead of round-tripping the CPU allocator.
 RegisterEngineAllocator cpu_alloc(
     engine::cpu_engine(),
-    [](size_t size) {
-      return c10::GetAllocator(c10::DeviceType::CPU)->raw_allocate(size);
-    },
-    [](void* p) {
-      c10::GetAllocator(c10::DeviceType::CPU)->raw_deallocate(p);
-    });
+    [](size_t size) { return torch_ipex::utils::onednn_arena_allocate(size); },
+    [](void* p) { torch_ipex::utils::onednn_arena_deallocate(p); });
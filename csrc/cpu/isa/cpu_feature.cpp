@@ -59,6 +59,19 @@ void CPUFeature::detect_intel_cpu_feature() {
 
     MICRO_CLASS_MEMBER(fma) = check_reg_bit(ecx, 12);
     MICRO_CLASS_MEMBER(f16c) = check_reg_bit(ecx, 29);
+
+    /*
+    DisplayFamily/DisplayModel composition rule, Intel® 64 and IA-32
+    Architectures Software Developer's Manual Vol. 2A, CPUID leaf 01H.
+    */
+    m_cpu_family = (eax >> 8) & 0xF;
+    m_cpu_model = (eax >> 4) & 0xF;
+    if (m_cpu_family == 0xF) {
+      m_cpu_family += (eax >> 20) & 0xFF;
+    }
+    if (m_cpu_family == 0x6 || m_cpu_family == 0xF) {
+      m_cpu_model += ((eax >> 16) & 0xF) << 4;
+    }
   }
 
   if (max_basic_id >= 0x00000007) {
@@ -94,6 +107,7 @@ void CPUFeature::detect_intel_cpu_feature() {
     MICRO_CLASS_MEMBER(avx512_4vnniw) =
         check_reg_bit(edx, 2); // (Intel® Xeon Phi™ only.)
     MICRO_CLASS_MEMBER(avx512_vp2intersect) = check_reg_bit(edx, 8);
+    MICRO_CLASS_MEMBER(hybrid) = check_reg_bit(edx, 15);
     MICRO_CLASS_MEMBER(avx512_fp16) = check_reg_bit(edx, 23);
 
     MICRO_CLASS_MEMBER(amx_bf16) = check_reg_bit(edx, 22);
@@ -435,6 +449,8 @@ void CPUFeature::show_features() {
 
   MICRO_CLASS_PRINT_BOOL_STATUS(prefetchw);
   MICRO_CLASS_PRINT_BOOL_STATUS(prefetchwt1);
+
+  MICRO_CLASS_PRINT_BOOL_STATUS(hybrid);
 #endif
 }
 } // namespace cpu
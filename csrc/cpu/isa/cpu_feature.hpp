@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 #define MICRO_CLASS_MEMBER_DECL(feature_name) bool m_##feature_name = false
 #define MICRO_CLASS_MEMBER(feature_name) m_##feature_name
 #define MICRO_CLASS_CHECK_FUNC(feature_name) \
@@ -134,6 +136,31 @@ class CPUFeature {
   MICRO_CLASS_CHECK_FUNC(prefetchw);
   MICRO_CLASS_CHECK_FUNC(prefetchwt1);
 
+  // Hybrid (heterogeneous P-core/E-core) part. The flag only says the
+  // package mixes core types; which logical CPUs belong to which class is a
+  // topology question answered by the runtime extension (sysfs), since cpuid
+  // leaf 0x1A would have to be executed on every core.
+ private:
+  MICRO_CLASS_MEMBER_DECL(hybrid);
+
+ public:
+  MICRO_CLASS_CHECK_FUNC(hybrid);
+
+  // DisplayFamily/DisplayModel from cpuid leaf 1, used to recognize the
+  // microarchitecture for the -mtune'd kernel variants (see
+  // dyndisp/DispatchStub.h).
+ private:
+  uint32_t m_cpu_family = 0;
+  uint32_t m_cpu_model = 0;
+
+ public:
+  uint32_t cpu_family() {
+    return m_cpu_family;
+  }
+  uint32_t cpu_model() {
+    return m_cpu_model;
+  }
+
  public:
   /*
   isa level referance to oneDNN.
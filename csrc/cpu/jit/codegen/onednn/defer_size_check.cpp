@@ -9,6 +9,170 @@ namespace onednn {
 
 using namespace torch::jit;
 
+namespace {
+
+c10::optional<std::vector<int64_t>> constantIntList(Value* v) {
+  auto ival = toIValue(v);
+  if (!ival || !ival->isIntList())
+    return c10::nullopt;
+  return ival->toIntVector();
+}
+
+c10::optional<int64_t> constantInt(Value* v) {
+  auto ival = toIValue(v);
+  if (!ival || !ival->isInt())
+    return c10::nullopt;
+  return ival->toInt();
+}
+
+} // namespace
+
+class SizeThroughViewMover {
+ private:
+  Block* block_;
+  std::shared_ptr<Graph> graph_;
+
+ public:
+  SizeThroughViewMover(Block* block, std::shared_ptr<Graph> graph)
+      : block_(block), graph_(std::move(graph)) {}
+
+  // Answers aten::size queries on the results of view-like ops so the query
+  // no longer forces the intermediate tensor out of a fusion group:
+  //
+  // %b = aten::view(%a, [2, 384, 16, 64])
+  // %sz = aten::size(%b, %c0)
+  //  =>
+  // %sz = prim::Constant[value=2]()
+  //        ^-- read straight off the constant target shape
+  //
+  // and through ops that only permute dimensions:
+  //
+  // %b = aten::permute(%a, [0, 2, 1, 3])
+  // %sz = aten::size(%b, %c1)
+  //  =>
+  // %sz = aten::size(%a, %c2)
+  //        ^-- redirected to the source of the chain
+  //
+  // Applied iteratively this walks size queries up whole reshape chains, so
+  // size-dependent arithmetic hangs off the chain's (already materialized)
+  // source or off constants instead of splitting the partition at every
+  // intermediate.
+  bool analyzeNode(Node* node, AliasDb& aliasDb) {
+    if (node->kind() != aten::size)
+      return false;
+
+    auto* producer = node->input(0)->node();
+    auto pkind = producer->kind();
+
+    // aten::size(Tensor) -> int[] has one input, aten::size(Tensor, int)
+    // -> int has two; a non-constant dim cannot be rewritten.
+    c10::optional<int64_t> dim = c10::nullopt;
+    if (node->inputs().size() == 2) {
+      dim = constantInt(node->input(1));
+      if (!dim)
+        return false;
+    } else if (node->inputs().size() != 1) {
+      return false;
+    }
+
+    if (pkind == aten::view || pkind == aten::reshape) {
+      auto shape = constantIntList(producer->input(1));
+      if (!shape)
+        return false;
+      auto rank = (int64_t)shape->size();
+      if (dim) {
+        auto d = *dim < 0 ? *dim + rank : *dim;
+        // a -1 entry is inferred at runtime and stays a real query
+        if (d < 0 || d >= rank || (*shape)[d] < 0)
+          return false;
+        WithInsertPoint insert_guard(node);
+        node->output()->replaceAllUsesWith(graph_->insertConstant((*shape)[d]));
+        node->destroy();
+        return true;
+      }
+      if (std::any_of(shape->begin(), shape->end(), [](int64_t s) {
+            return s < 0;
+          }))
+        return false;
+      WithInsertPoint insert_guard(node);
+      node->output()->replaceAllUsesWith(graph_->insertConstant(*shape));
+      node->destroy();
+      return true;
+    }
+
+    // The permuting ops below keep every dimension of the source; moving
+    // the query next to the producer first guarantees nothing can resize
+    // the source tensor between the producer and the redirected read.
+    if (!dim)
+      return false;
+
+    if (pkind == aten::permute) {
+      auto dims = constantIntList(producer->input(1));
+      if (!dims)
+        return false;
+      auto rank = (int64_t)dims->size();
+      auto d = *dim < 0 ? *dim + rank : *dim;
+      if (d < 0 || d >= rank)
+        return false;
+      auto src = (*dims)[d] < 0 ? (*dims)[d] + rank : (*dims)[d];
+      if (src < 0 || src >= rank)
+        return false;
+      if (!aliasDb.moveAfterTopologicallyValid(node, producer))
+        return false;
+      WithInsertPoint insert_guard(node);
+      node->replaceInput(0, producer->input(0));
+      node->replaceInput(1, graph_->insertConstant(src));
+      return true;
+    }
+
+    if (pkind == aten::transpose) {
+      auto dim0 = constantInt(producer->input(1));
+      auto dim1 = constantInt(producer->input(2));
+      auto type = producer->output()->type()->cast<TensorType>();
+      auto rank_opt = type ? type->sizes().size() : c10::nullopt;
+      if (!dim0 || !dim1 || !rank_opt)
+        return false;
+      auto rank = (int64_t)*rank_opt;
+      auto d = *dim < 0 ? *dim + rank : *dim;
+      auto d0 = *dim0 < 0 ? *dim0 + rank : *dim0;
+      auto d1 = *dim1 < 0 ? *dim1 + rank : *dim1;
+      if (d < 0 || d >= rank || d0 < 0 || d0 >= rank || d1 < 0 || d1 >= rank)
+        return false;
+      auto src = d == d0 ? d1 : (d == d1 ? d0 : d);
+      if (!aliasDb.moveAfterTopologicallyValid(node, producer))
+        return false;
+      WithInsertPoint insert_guard(node);
+      node->replaceInput(0, producer->input(0));
+      node->replaceInput(1, graph_->insertConstant(src));
+      return true;
+    }
+
+    return false;
+  }
+
+  void run() {
+    bool changed = true;
+    while (changed) {
+      changed = false;
+      AliasDb aliasDb(graph_);
+      // analyzeNode may destroy the node it inspects, so gather the
+      // candidates up front
+      std::vector<Node*> sizeNodes;
+      for (Node* node : block_->nodes()) {
+        if (node->kind() == aten::size)
+          sizeNodes.push_back(node);
+      }
+      for (Node* node : sizeNodes) {
+        changed |= analyzeNode(node, aliasDb);
+      }
+    }
+
+    for (Node* node : block_->nodes())
+      for (Block* subBlock : node->blocks())
+        SizeThroughViewMover(subBlock, graph_).run();
+  }
+};
+
 class SizeCheckMover {
  private:
   Block* block_;
@@ -87,6 +251,9 @@ class SizeCheckMover {
 };
 
 void DeferSizeCheck(std::shared_ptr<Graph>& graph) {
+  // Resolving queries through view/reshape/permute/transpose first leaves
+  // fewer (and better-placed) aten::size nodes for the deferral below.
+  SizeThroughViewMover(graph->block(), graph).run();
   SizeCheckMover(graph->block(), graph).run();
 }
 
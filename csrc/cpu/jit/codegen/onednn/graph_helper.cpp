@@ -1,4 +1,5 @@
 #include "graph_helper.h"
+#include "op_symbol_table.h"
 #include "fusion_group_name.h"
 #include "utils.h"
 
@@ -561,7 +562,7 @@ Operator LlgaGraphHelper::createOperator(Node* node) const {
     return Operator(node, opkind::Reorder).setInput(0).setOutput(0);
   } else if (nodeKind == Symbol::aten("where")) {
     return Operator(node, opkind::Select).setInput(0, 1, 2).setOutput(0);
-  } else if (nodeKind == Symbol::fromQualString("llga::Select")) {
+  } else if (nodeKind == torch_ipex::jit::ipex_op_symbols().llga_Select) {
     return Operator(node, opkind::Select).setInput(0, 1, 2).setOutput(0);
   }
 
@@ -15,6 +15,104 @@ using namespace torch::jit;
 using tensor_type_converter_t =
     c10::function_ref<TensorTypePtr(const TensorTypePtr& t)>;
 
+namespace {
+
+// Smallest power of two >= d; the upper bound of the shape bucket a
+// profiled dimension belongs to (e.g. a profiled sequence length of 384
+// admits any length up to 512).
+int64_t bucketCeiling(int64_t d) {
+  int64_t b = 1;
+  while (b < d) {
+    b <<= 1;
+  }
+  return b;
+}
+
+// Strides of a dense row-major (torch.contiguous_format) tensor; strides
+// of size-1 dimensions are arbitrary and ignored.
+bool stridesAreContiguous(
+    const std::vector<int64_t>& sizes,
+    const std::vector<int64_t>& strides) {
+  int64_t expected = 1;
+  for (int64_t i = (int64_t)sizes.size() - 1; i >= 0; i--) {
+    if (sizes[i] != 1 && strides[i] != expected) {
+      return false;
+    }
+    expected *= sizes[i];
+  }
+  return true;
+}
+
+// Strides of a dense NHWC (torch.channels_last) tensor.
+bool stridesAreChannelsLast(
+    const std::vector<int64_t>& sizes,
+    const std::vector<int64_t>& strides) {
+  if (sizes.size() != 4) {
+    return false;
+  }
+  int64_t C = sizes[1], H = sizes[2], W = sizes[3];
+  return (C == 1 || strides[1] == 1) && (W == 1 || strides[3] == C) &&
+      (H == 1 || strides[2] == C * W) && (sizes[0] == 1 || strides[0] == C * H * W);
+}
+
+} // namespace
+
+bool guardShapeClassMatch(
+    const c10::TensorTypePtr& type,
+    const at::Tensor& tensor) {
+  // The profiled type matches exactly, strides included.
+  if (type->matchTensor(tensor)) {
+    return true;
+  }
+  // Relaxation requires a fully specialized profile to derive the shape
+  // class from; anything less falls back conservatively.
+  auto dtype = type->scalarType();
+  auto device = type->device();
+  auto sizes_opt = type->sizes().concrete_sizes();
+  auto strides_opt = type->strides().concrete_sizes();
+  if (!dtype || !device || !sizes_opt || !strides_opt) {
+    return false;
+  }
+  if (tensor.scalar_type() != *dtype || tensor.device() != *device) {
+    return false;
+  }
+  if (type->requiresGrad() &&
+      *type->requiresGrad() != tensor.requires_grad()) {
+    return false;
+  }
+  const auto& sizes = *sizes_opt;
+  const auto& strides = *strides_opt;
+  if ((size_t)tensor.dim() != sizes.size()) {
+    return false;
+  }
+  // The kernel's compilation cache is keyed on sizes only, so two layouts
+  // must never share a cache entry: a relaxed match is restricted to the
+  // contiguity class the guard was profiled with. Exotic (strided or
+  // transposed) profiles only ever match exactly.
+  bool want_contiguous = stridesAreContiguous(sizes, strides);
+  bool want_channels_last = stridesAreChannelsLast(sizes, strides);
+  if (!want_contiguous && !want_channels_last) {
+    return false;
+  }
+  bool is_contiguous = tensor.is_contiguous();
+  bool is_channels_last = tensor.dim() == 4 &&
+      tensor.is_contiguous(at::MemoryFormat::ChannelsLast);
+  if (!((want_contiguous && is_contiguous) ||
+        (want_channels_last && is_channels_last))) {
+    return false;
+  }
+  for (int64_t i = 0; i < tensor.dim(); i++) {
+    int64_t actual = tensor.size(i);
+    if (actual == sizes[i]) {
+      continue;
+    }
+    if (sizes[i] <= 0 || actual <= 0 || actual > bucketCeiling(sizes[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void insertTypeGuardForFusionGroup(
     Node* guarded_node,
     tensor_type_converter_t type_converter,
@@ -53,7 +151,10 @@ void insertTypeGuardForFusionGroup(
   //
   // They have N inputs whose types we are going to check and N+1 outputs. The
   // first N outputs specify expected types and N+1-th output holds the result
-  // of the check (bool).
+  // of the check (bool). The stored types are the exact profiled ones; the
+  // runtime check (guardShapeClassMatch) accepts the whole shape class they
+  // define, so a new sequence length or batch size within the bucket runs
+  // the fused group instead of the fallback graph.
   Node* typecheck_node =
       guarded_node->owningGraph()
           ->create(kind, inputs_to_check, inputs_to_check.size() + 1)
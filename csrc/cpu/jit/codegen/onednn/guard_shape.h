@@ -9,6 +9,18 @@ namespace onednn {
 
 void prepareFusionGroupAndGuardOutputs(torch::jit::Block* block);
 
+// Runtime predicate of the ipex::LlgaFusionGuard node: true when `tensor`
+// belongs to the shape class of the profiled `type`. An exact match (the
+// old guard semantics) always passes; beyond that, a tensor passes when
+// dtype, device and rank match, the layout falls in the same contiguity
+// class, and every dimension stays within the power-of-two bucket of its
+// profiled value. LlgaKernel compiles and caches one partition per
+// concrete input shape, so any tensor in the class executes fused instead
+// of falling back to the unoptimized graph.
+bool guardShapeClassMatch(
+    const c10::TensorTypePtr& type,
+    const at::Tensor& tensor);
+
 } // namespace onednn
 } // namespace fuser
 } // namespace jit
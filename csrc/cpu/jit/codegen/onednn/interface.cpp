@@ -13,6 +13,7 @@
 #include "process_cast.h"
 #include "quantization_patterns.h"
 #include "remove_mutation.h"
+#include "utils/hot_trace.h"
 
 #include <torch/csrc/jit/jit_log.h>
 #include <torch/csrc/jit/passes/common_subexpression_elimination.h>
@@ -115,6 +116,7 @@ Operation createLlgaKernel(const Node* node) {
   return [kernel](Stack* stack) {
     RECORD_FUNCTION(kernel->profileName(), c10::ArrayRef<c10::IValue>());
 
+    IPEX_HOT_TRACE_SCOPE("jit::LlgaFusionGroup");
     kernel->run(*stack);
     return 0;
   };
@@ -127,5 +129,41 @@ torch::jit::RegisterOperators LLGAFusionGroupOp({
         AliasAnalysisKind::PURE_FUNCTION),
 });
 
+Operation createLlgaGuardKernel(const Node* node) {
+  return [node](Stack* stack) {
+    GRAPH_DEBUG("Guarding node: ", *node);
+    std::vector<TypePtr> types = node->tys(attr::types);
+    const auto num_inputs = types.size();
+    // The N guarded inputs stay on the stack and double as the first N
+    // outputs; only the check result is pushed.
+    for (size_t i = 0; i < num_inputs; i++) {
+      const c10::IValue& input = peek(*stack, i, num_inputs);
+      const c10::TensorTypePtr& guard_type = types[i]->cast<TensorType>();
+      if (!input.isTensor()) {
+        push(*stack, IValue(false));
+        return 0;
+      }
+      const at::Tensor& tensor = input.toTensor();
+      // Bucketed check: the exact profiled shape and every shape in its
+      // class pass; LlgaKernel compiles and caches per concrete shape, so
+      // relaxing the guard trades a one-time compilation for avoiding the
+      // 5x slower fallback path on every run with a new shape.
+      if (!fuser::onednn::guardShapeClassMatch(guard_type, tensor)) {
+        push(*stack, IValue(false));
+        return 0;
+      }
+    }
+    push(*stack, IValue(true));
+    return 0;
+  };
+}
+
+torch::jit::RegisterOperators LLGAGuardOp({
+    torch::jit::Operator(
+        Symbol::fromQualString(fuser::onednn::LlgaGuardName()),
+        createLlgaGuardKernel,
+        AliasAnalysisKind::FROM_SCHEMA),
+});
+
 } // namespace jit
 } // namespace torch_ipex
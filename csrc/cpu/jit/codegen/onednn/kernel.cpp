@@ -1,5 +1,7 @@
 #include <omp.h>
 
+#include <cstdlib>
+
 #include "graph_helper.h"
 #include "kernel.h"
 #include "operator.h"
@@ -24,7 +26,26 @@ thread_local std::list<LlgaKernel::key_value_pair_t>
 thread_local std::
     unordered_map<std::vector<int64_t>, LlgaKernel::list_iterator_t>
         LlgaKernel::cache_items_map_;
-thread_local int LlgaKernel::capacity_ = 7500;
+thread_local int LlgaKernel::capacity_ = []() {
+  auto* env = getenv("IPEX_LLGA_CACHE_CAPACITY");
+  int capacity = env != nullptr ? atoi(env) : 0;
+  return capacity > 0 ? capacity : 7500;
+}();
+thread_local std::unordered_map<uint64_t, int>
+    LlgaKernel::partition_entry_count_;
+// How many concrete-shape compilations one partition may keep resident;
+// <= 0 disables the per-partition bound and leaves only the global one.
+thread_local int LlgaKernel::partition_capacity_ = []() {
+  auto* env = getenv("IPEX_LLGA_PARTITION_CACHE_CAPACITY");
+  return env != nullptr ? atoi(env) : 1024;
+}();
+
+uint64_t LlgaKernel::partitionKeyOf(const std::vector<int64_t>& key) {
+  // key[1] is the fusion node, key[2] the owning graph; together they
+  // identify the partition (see compileAndCache for why two pointers).
+  return static_cast<uint64_t>(key[1]) * 0x9e3779b97f4a7c15ULL ^
+      static_cast<uint64_t>(key[2]);
+}
 
 LlgaKernel::LlgaKernel(const Node* fusionNode)
     : fusionNode_(fusionNode),
@@ -495,9 +516,28 @@ LlgaKernel::cp_entry& LlgaKernel::compileAndCache(
     cache_items_list_.push_front(
         key_value_pair_t(key, std::move(compiledPartitionEntry)));
     cache_items_map_[key] = cache_items_list_.begin();
-    if (cache_items_map_.size() > capacity_) {
+    auto partitionKey = partitionKeyOf(key);
+    auto partitionCount = ++partition_entry_count_[partitionKey];
+    if (partition_capacity_ > 0 && partitionCount > partition_capacity_) {
+      // This partition overflowed its own bound: evict its LRU entry so
+      // one dynamic-shape partition cannot flush the compilations of the
+      // others. The walk is from the cold end and only runs on overflow.
+      for (auto it = cache_items_list_.rbegin(); it != cache_items_list_.rend();
+           ++it) {
+        if (partitionKeyOf(it->first) == partitionKey) {
+          --partition_entry_count_[partitionKey];
+          cache_items_map_.erase(it->first);
+          cache_items_list_.erase(std::next(it).base());
+          break;
+        }
+      }
+    } else if (cache_items_map_.size() > capacity_) {
       auto last = cache_items_list_.end();
       last--;
+      auto lastPartitionKey = partitionKeyOf(last->first);
+      if (--partition_entry_count_[lastPartitionKey] == 0) {
+        partition_entry_count_.erase(lastPartitionKey);
+      }
       cache_items_map_.erase(last->first);
       cache_items_list_.pop_back();
     }
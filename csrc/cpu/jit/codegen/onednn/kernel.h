@@ -176,6 +176,14 @@ class LlgaKernel {
   static thread_local std::unordered_map<std::vector<int64_t>, list_iterator_t>
       cache_items_map_;
   static thread_local int capacity_;
+  // The cache is shared by every partition of the thread, so a partition
+  // fed with many distinct concrete shapes (variable sequence length)
+  // could evict the compilations of all the others. Entries are counted
+  // per partition and each partition is bounded separately: overflowing a
+  // partition evicts the LRU entry of that partition only.
+  static uint64_t partitionKeyOf(const std::vector<int64_t>& key);
+  static thread_local std::unordered_map<uint64_t, int> partition_entry_count_;
+  static thread_local int partition_capacity_;
   std::vector<std::vector<int64_t>> tracedInputShapes_;
   std::vector<std::vector<int64_t>> tracedInputStrides_;
   std::string debugName_;
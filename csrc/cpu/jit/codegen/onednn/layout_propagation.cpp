@@ -9,9 +9,17 @@ namespace onednn {
 
 using namespace torch::jit;
 
+// Ops that only read tensor metadata which stays valid on a
+// LlgaTensorImpl-wrapped tensor (sizes, numel, dtype, device) and never touch
+// the data or the strides. A value consumed by these ops alone does not force
+// the producing partition out of the blocked layout.
 bool couldSupportOpaqueLayout(Node* node) {
   switch (node->kind()) {
     case aten::size:
+    case aten::dim:
+    case aten::numel:
+    case prim::dtype:
+    case prim::device:
       return true;
     default:
       return false;
@@ -70,32 +78,42 @@ void LayoutPropagation(Node* n) {
     std::vector<int64_t> future_input_uses(num_inputs, 1);
     n->is_(Symbol::attr("future_input_uses"), future_input_uses);
   }
-  for (int i = 0; i < num_inputs; i++) {
-    // propagate layout
-    auto input = n->inputs()[i];
-    auto prev = input->node();
-    auto offset = input->offset();
-    if (LlgaGraphHelper::isLlgaSubgraph(prev)) {
-      bool useOpaqueLayout = true;
-      for (auto& use : input->uses()) {
-        if (!couldSupportOpaqueLayout(use.user) &&
-            !LlgaGraphHelper::isLlgaSubgraph(use.user)) {
-          useOpaqueLayout = false;
-          break;
-        }
-      }
-      if (useOpaqueLayout) {
-        LlgaNodeWrapper(prev).setOpaqueLayout(offset);
+  // An output may keep the blocked (opaque) layout oneDNN graph picked as
+  // long as every use of it either stays inside LLGA (another partition) or
+  // only reads metadata that remains valid on the wrapped tensor. Deciding
+  // this per output on the producer lets back-to-back partitions exchange
+  // blocked tensors directly even when a size check or another
+  // layout-agnostic op observes the value at the partition boundary, and
+  // spares the reorder entirely for outputs that are only ever queried for
+  // their metadata.
+  const auto num_outputs = n->outputs().size();
+  for (int i = 0; i < num_outputs; i++) {
+    auto output = n->outputs()[i];
+    if (output->uses().empty())
+      continue;
+    bool useOpaqueLayout = true;
+    for (auto& use : output->uses()) {
+      if (!couldSupportOpaqueLayout(use.user) &&
+          !LlgaGraphHelper::isLlgaSubgraph(use.user)) {
+        useOpaqueLayout = false;
+        break;
       }
     }
-    markLastUseOfInputs(n, input, i);
-  } // end outer for loop for each input
+    if (useOpaqueLayout) {
+      LlgaNodeWrapper(n).setOpaqueLayout(i);
+    }
+  }
+  for (int i = 0; i < num_inputs; i++) {
+    markLastUseOfInputs(n, n->inputs()[i], i);
+  }
 }
 
 void LayoutPropagation(at::ArrayRef<Block*> blocks) {
   for (Block* block : blocks)
-    for (Node* node : block->nodes())
+    for (Node* node : block->nodes()) {
       LayoutPropagation(node);
+      LayoutPropagation(node->blocks());
+    }
 }
 
 void PropagateLayout(const std::shared_ptr<Graph>& graph) {
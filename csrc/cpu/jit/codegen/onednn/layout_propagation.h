@@ -9,8 +9,12 @@ namespace onednn {
 
 // The rule is that LlgaTensor can only be consumed by JIT-only ops:
 // e.g. llga fusion ops, prim ops
-// (torch/csrc/jit/runtime/register_prim_ops.cpp). If a LlgaPartition is only
-// fed to JIT-only ops, the output format of this partition will be set as ANY.
+// (torch/csrc/jit/runtime/register_prim_ops.cpp), or by ops that only read
+// metadata which stays valid on the wrapped tensor (aten::size, aten::dim,
+// aten::numel, prim::dtype, prim::device). If every use of a LlgaPartition
+// output falls in these categories, the output format of this partition will
+// be set as ANY, so back-to-back partitions exchange blocked tensors without
+// reordering to the plain layout at the boundary.
 void PropagateLayout(const std::shared_ptr<torch::jit::Graph>& graph);
 
 } // namespace onednn
@@ -13,6 +13,17 @@ bool usedBySingleOp(Value* v) {
   return v->uses().size() == 1;
 }
 
+namespace {
+
+// aten::slice behaves like the view ops for per-tensor quantization: it
+// only selects elements, so quantize(slice(x)) == slice(quantize(x)) and
+// the quant can be lifted above it toward the producing op.
+bool isQuantTransparentOp(Node* n) {
+  return utils::isViewOp(n) || n->kind() == aten::slice;
+}
+
+} // namespace
+
 class QuantLifter {
  private:
   std::shared_ptr<Graph> graph_;
@@ -45,7 +56,7 @@ class QuantLifter {
       bool could_lift_up = true;
       while (could_lift_up) {
         auto* target_value = target->input(0);
-        if (utils::isViewOp(target_value->node()) &&
+        if (isQuantTransparentOp(target_value->node()) &&
             (usedBySingleOp(target_value))) {
           target = target_value->node();
 
@@ -110,7 +121,137 @@ class QuantLifter {
   }
 };
 
+// Rewrites the dequant -> concat -> quant sandwich so the concat itself
+// runs on the int8 tensors:
+//
+// From:
+// %dq0 = aten::dequantize(%q0), %dq1 = aten::dequantize(%q1)
+// %cat = aten::cat(prim::ListConstruct(%dq0, %dq1), %dim)
+// %out = aten::quantize_per_tensor(%cat, %scale, %zp, %dtype)
+// To:
+// %cat = aten::cat(prim::ListConstruct(%q0, %q1), %dim)
+//
+// An input quantized with different parameters than the output is
+// requantized in place of being used directly (its existing dequantize
+// feeding a new quantize_per_tensor with the output parameters); that
+// pair is a pointwise rescale LLGA folds into the partition, while the
+// fp32 concat it replaces is bandwidth bound on the widest tensor in
+// the block.
+class QuantConcatRewriter {
+ private:
+  std::shared_ptr<Graph> graph_;
+
+  static c10::optional<IValue> constantParam(Value* v) {
+    if (v->node()->kind() != prim::Constant) {
+      return c10::nullopt;
+    }
+    return toIValue(v);
+  }
+
+  static bool sameQuantParams(Node* a, Node* b) {
+    // scale, zero point and dtype are inputs 1..3 of quantize_per_tensor;
+    // a non-constant parameter cannot be proven equal and is treated as
+    // a mismatch
+    for (size_t i = 1; i <= 3; i++) {
+      auto pa = constantParam(a->input(i));
+      auto pb = constantParam(b->input(i));
+      if (!pa || !pb || !(*pa == *pb)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ public:
+  explicit QuantConcatRewriter(std::shared_ptr<Graph> graph)
+      : graph_(std::move(graph)) {}
+
+  bool analyze(Block* block) {
+    bool changed = false;
+    for (auto it = block->nodes().begin(); it != block->nodes().end(); ++it) {
+      auto node = *it;
+      for (auto sub : node->blocks()) {
+        changed |= analyze(sub);
+      }
+
+      if (node->kind() != Symbol::aten("quantize_per_tensor")) {
+        continue;
+      }
+      auto cat = node->input(0)->node();
+      if (cat->kind() != aten::cat || !usedBySingleOp(cat->output(0))) {
+        continue;
+      }
+      auto list = cat->input(0)->node();
+      if (list->kind() != prim::ListConstruct ||
+          !usedBySingleOp(list->output(0)) || list->inputs().size() == 0) {
+        continue;
+      }
+      std::vector<Node*> dequants;
+      bool supported = true;
+      for (auto* in : list->inputs()) {
+        auto dq = in->node();
+        // restricted to per-tensor quantized inputs: slicing and
+        // concatenation do not preserve per-channel axis metadata
+        if (dq->kind() != aten::dequantize || !usedBySingleOp(dq->output(0)) ||
+            dq->input(0)->node()->kind() !=
+                Symbol::aten("quantize_per_tensor")) {
+          supported = false;
+          break;
+        }
+        dequants.push_back(dq);
+      }
+      if (!supported) {
+        continue;
+      }
+
+      WithInsertPoint guard(cat);
+      auto g = cat->owningGraph();
+      auto out_scalar_type =
+          node->output(0)->type()->expect<TensorType>()->scalarType();
+      std::vector<Value*> int8_inputs;
+      for (auto* dq : dequants) {
+        auto quant_in = dq->input(0)->node();
+        if (sameQuantParams(quant_in, node)) {
+          int8_inputs.push_back(dq->input(0));
+          continue;
+        }
+        std::vector<Value*> requant_inputs{dq->output(0)};
+        for (size_t i = 1; i < node->inputs().size(); i++) {
+          requant_inputs.push_back(node->input(i));
+        }
+        auto requant =
+            g->create(node->kind(), requant_inputs)->insertBefore(cat);
+        requant->output(0)->setType(dq->output(0)
+                                        ->type()
+                                        ->expect<TensorType>()
+                                        ->withScalarType(out_scalar_type));
+        int8_inputs.push_back(requant->output(0));
+      }
+      auto new_list =
+          g->create(prim::ListConstruct, int8_inputs)->insertBefore(cat);
+      new_list->output(0)->setType(ListType::ofTensors());
+      auto new_cat = g->create(aten::cat, {new_list->output(0), cat->input(1)})
+                         ->insertBefore(cat);
+      new_cat->output(0)->setType(node->output(0)->type());
+      node->output(0)->replaceAllUsesWith(new_cat->output(0));
+
+      // the old quant/cat/list/dequantize chain is dead; dropping the
+      // quant here keeps this pattern from matching again, DCE removes
+      // the rest
+      it.destroyCurrent();
+      changed = true;
+    }
+    return changed;
+  }
+
+  void run() {
+    while (analyze(graph_->block())) {
+    }
+  }
+};
+
 void LiftUpQuant(std::shared_ptr<Graph>& graph) {
+  QuantConcatRewriter(graph).run();
   QuantLifter(graph).run();
   EliminateDeadCode(graph);
 }
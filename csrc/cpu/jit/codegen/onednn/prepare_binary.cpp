@@ -1,4 +1,5 @@
 #include "prepare_binary.h"
+#include "op_symbol_table.h"
 #include <torch/csrc/jit/passes/dead_code_elimination.h>
 #include <torch/csrc/jit/passes/shape_analysis.h>
 #include "utils.h"
@@ -175,7 +176,7 @@ void replaceWithSelectOpNode(Node* node, Value* unexpanded_mask) {
   auto unsqueezed = g->insert(aten::unsqueeze, {to_replace_tensor, 0});
   unsqueezed->setType(target_type);
   auto selectNode = g->insert(
-      Symbol::fromQualString("llga::Select"),
+      torch_ipex::jit::ipex_op_symbols().llga_Select,
       {unexpanded_mask, unsqueezed, node->input(0)});
   selectNode->setType(node->outputs()[0]->type());
   node->outputs()[0]->replaceAllUsesWith(selectNode);
@@ -4,6 +4,10 @@
 
 #include <ideep.hpp>
 
+#include <list>
+#include <memory>
+#include <mutex>
+
 namespace torch_ipex {
 namespace cpu {
 namespace detail {
@@ -28,6 +32,35 @@ struct ContextConvolution final {
   ideep::convolution_forward_params conv_params_;
   ideep::convolution_forward::super conv_desc_;
 
+  // conv_params_/conv_desc_ above cover exactly the input shape given at
+  // prepack time; every other shape used to re-create the primitive
+  // (30-80us) inside the call. The small LRU below keeps primitives (and,
+  // through conv_params_.pd, their scratchpad descriptors) prepared for
+  // the last few input shapes seen at runtime. Entries carry the packed
+  // weight's version tag: swapping the weight data into an existing
+  // context (LoRA-style, load_from_ctx) bumps the version and drops every
+  // primitive built against the old weight.
+  struct CachedPrimitive {
+    std::vector<int64_t> src_dims;
+    uint64_t weight_version;
+    ideep::convolution_forward_params params;
+    ideep::convolution_forward::super prim;
+  };
+  struct PrimitiveCache {
+    static constexpr size_t kCapacity = 8;
+    std::mutex mutex;
+    std::list<CachedPrimitive> entries;
+    uint64_t weight_version = 0;
+  };
+  // held through a unique_ptr so the context stays movable
+  std::unique_ptr<PrimitiveCache> primitive_cache_{new PrimitiveCache()};
+
+  void invalidate_cached_primitives() {
+    std::lock_guard<std::mutex> lock(primitive_cache_->mutex);
+    primitive_cache_->weight_version++;
+    primitive_cache_->entries.clear();
+  }
+
   ContextConvolution() = delete;
 
   ContextConvolution(
@@ -14,6 +14,10 @@ struct ContextLinear final {
   // at_weight is used for autograd and optimizer update
   at::Tensor at_weight_;
   c10::optional<at::Tensor> at_bias_;
+  // set once apply_lora_delta has replaced at_weight_ with a private copy;
+  // the prepacked image may alias a base weight shared across replicas or
+  // processes (packed weight registry / shm) that must not be merged into
+  bool lora_weight_private_ = false;
 
   ContextLinear() = delete;
 
@@ -2,16 +2,59 @@
 
 #include <ATen/Tensor.h>
 
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
 #include <ideep.hpp>
 
 namespace torch_ipex {
 namespace cpu {
 namespace detail {
+
+// Shared mutable runtime state for a ContextLinearMKL.
+//
+// MKL packed sgemm images are specialized for both the GEMM M dimension
+// and the thread count MKL observed at pack time. The same op context can
+// be run under different per-stream thread budgets (MultiStreamModule),
+// so alternate images are cached here keyed by (batch, nthreads).
+//
+// The state also backs the dynamic kernel dispatcher
+// (IPEX_LINEAR_DYNAMIC_KERNEL): a lazily created oneDNN inner_product
+// weight as an alternative route, and per-M-bucket cycle measurements
+// the dispatcher learns the kernel choice from.
+//
+// Guarded by a single mutex since streams share the context; lives
+// behind a shared_ptr to keep ContextLinearMKL movable.
+struct MKLLinearRuntimeState {
+  std::mutex mutex_;
+  std::map<std::pair<int64_t, int64_t>, at::Tensor> images_;
+
+  // oneDNN route: blocked inner_product weight created on first use.
+  at::Tensor onednn_at_weight_;
+  ideep::tensor onednn_weight_;
+
+  // Per-M-bucket measurements for the kernel arms (MKL packed, MKL
+  // plain, oneDNN). Filled while calibrating; once every available arm
+  // has enough samples the cheapest one is frozen in frozen_arm_.
+  struct ArmStats {
+    uint64_t calls_[3] = {0, 0, 0};
+    uint64_t cycles_[3] = {0, 0, 0};
+    int frozen_arm_ = -1;
+  };
+  std::map<int64_t, ArmStats> kernel_stats_;
+};
+
 struct ContextLinearMKL final {
   std::vector<int64_t> sgemm_sizes_ = {0, 0, 0};
   at::Tensor at_weight_; // packed at weight
   at::Tensor ori_weight_; // non-packed at weight
   c10::optional<at::Tensor> at_bias_;
+  // thread count at_weight_ was packed with
+  int64_t pack_nthreads_ = 0;
+  std::shared_ptr<MKLLinearRuntimeState> runtime_state_ =
+      std::make_shared<MKLLinearRuntimeState>();
 
   ContextLinearMKL() = delete;
 
@@ -5,6 +5,7 @@
 #define WOQ_DTYPE_INT8 1
 #define WOQ_DTYPE_INT4 2
 #define WOQ_DTYPE_NF4 3
+#define WOQ_DTYPE_FP4 4
 
 namespace torch_ipex {
 namespace cpu {
@@ -25,6 +26,15 @@ struct ContextLinearWoq final {
   int64_t group_size_;
   int64_t lowp_mode_;
   int64_t act_quant_mode_;
+  // Optional second packed image for dual-path execution: when the primary
+  // image is packed for INT8 compute (prefill), this holds a BF16-compute
+  // pack of the same weight that decode-sized batches are routed to.
+  c10::optional<at::Tensor> at_weight_decode_;
+  // Cached compute-dtype (fp16/bf16) image of a plain 2D weight,
+  // materialized once at prepack time so the GEMM fallback does not
+  // re-dequantize the whole weight on every forward. Kept on the context
+  // so it is freed together with the packed weight on model unload.
+  c10::optional<at::Tensor> at_dequant_weight_;
 
   ContextLinearWoq() = delete;
 
@@ -48,7 +58,8 @@ struct ContextLinearWoq final {
         lowp_mode_(lowp_mode),
         act_quant_mode_(act_quant_mode) {
     is_4bit_ =
-        (weight_dtype == WOQ_DTYPE_INT4 || weight_dtype == WOQ_DTYPE_NF4);
+        (weight_dtype == WOQ_DTYPE_INT4 || weight_dtype == WOQ_DTYPE_NF4 ||
+         weight_dtype == WOQ_DTYPE_FP4);
     // Make three dtype versions of scale, zp and bias
     // There is one more dtype for zp
     if (group_size > 0) {
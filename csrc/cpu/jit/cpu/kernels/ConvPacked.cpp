@@ -2,6 +2,8 @@
 #include <dnnl.hpp>
 #include <ideep.hpp>
 #include <ideep/utils.hpp>
+#include "PackedWeightRegistry.h"
+#include "TrustedLayout.h"
 #include "aten/Conv.h"
 #include "aten/ParamUtils.h"
 #include "aten/WeightPack.h"
@@ -23,7 +25,7 @@ namespace convolution {
     return op_context->run(                                         \
         input,                                                      \
         ideep::attr_t::fuse_##FUSED_OP().set_fpmath_mode(           \
-            torch_ipex::fpmath_mode));                              \
+            torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::CONV)));                              \
   }
 
 // follow check rules from
@@ -168,7 +170,7 @@ c10::intrusive_ptr<ConvolutionOpContext> createConvolutionPrePackOpContext(
       groups,
       weight_is_channels_last,
       std::move(input_size),
-      ideep::attr_t(torch_ipex::fpmath_mode));
+      ideep::attr_t(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::CONV)));
 }
 
 at::Tensor convolution_run(
@@ -176,7 +178,7 @@ at::Tensor convolution_run(
     const c10::intrusive_ptr<ConvolutionOpContext>& op_context) {
   RECORD_FUNCTION(
       "ipex_prepack::convolution_run", c10::ArrayRef<c10::IValue>({}));
-  return op_context->run(input, ideep::attr_t(torch_ipex::fpmath_mode));
+  return op_context->run(input, ideep::attr_t(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::CONV)));
 }
 
 DEFINE_CONVOLUTION_UNARY_ELTWISE_RUN(relu);
@@ -204,7 +206,7 @@ at::Tensor convolution_leaky_relu_run(
   return op_context->run(
       input,
       ideep::attr_t::fuse_relu(1.0, alpha_value)
-          .set_fpmath_mode(torch_ipex::fpmath_mode));
+          .set_fpmath_mode(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::CONV)));
 }
 
 at::Tensor convolution_hardtanh_run(
@@ -219,7 +221,7 @@ at::Tensor convolution_hardtanh_run(
   return op_context->run(
       input,
       ideep::attr_t::fuse_clamp(lower_bound_value, upper_bound_value)
-          .set_fpmath_mode(torch_ipex::fpmath_mode));
+          .set_fpmath_mode(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::CONV)));
 }
 
 at::Tensor convolution_elu_run(
@@ -236,7 +238,7 @@ at::Tensor convolution_elu_run(
   return op_context->run(
       input,
       ideep::attr_t::fuse_elu(scale_value, alpha_value, input_scale_value)
-          .set_fpmath_mode(torch_ipex::fpmath_mode));
+          .set_fpmath_mode(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::CONV)));
 }
 
 at::Tensor convolution_pow_run(
@@ -249,7 +251,7 @@ at::Tensor convolution_pow_run(
   return op_context->run(
       input,
       ideep::attr_t::fuse_pow(1.0, 1.0, exponent_value)
-          .set_fpmath_mode(torch_ipex::fpmath_mode));
+          .set_fpmath_mode(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::CONV)));
 }
 
 at::Tensor convolution_gelu_run(
@@ -274,7 +276,7 @@ at::Tensor convolution_gelu_run(
   return op_context->run(
       input,
       ideep::attr_t::fuse_gelu(1.0, 0.f, 0.f, gelu_type)
-          .set_fpmath_mode(torch_ipex::fpmath_mode));
+          .set_fpmath_mode(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::CONV)));
 }
 
 at::Tensor convolution_add_run(
@@ -288,7 +290,7 @@ at::Tensor convolution_add_run(
   return op_context->run(
       input,
       accumu,
-      ideep::attr_t::fuse_sum(scale).set_fpmath_mode(torch_ipex::fpmath_mode));
+      ideep::attr_t::fuse_sum(scale).set_fpmath_mode(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::CONV)));
 }
 
 at::Tensor convolution_add_relu_run(
@@ -302,7 +304,7 @@ at::Tensor convolution_add_relu_run(
   return op_context->run(
       input,
       accumu,
-      ideep::attr_t::residual(scale).set_fpmath_mode(torch_ipex::fpmath_mode));
+      ideep::attr_t::residual(scale).set_fpmath_mode(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::CONV)));
 }
 
 at::Tensor convolution_swish_add_run(
@@ -318,7 +320,7 @@ at::Tensor convolution_swish_add_run(
       input,
       accumu,
       ideep::attr_t::fuse_swish_sum(scale).set_fpmath_mode(
-          torch_ipex::fpmath_mode));
+          torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::CONV)));
 }
 
 at::Tensor& convolution_bottleneck_run(
@@ -605,7 +607,69 @@ ContextConvolution create(
         "Only support bfloat16, float16 and float for weight prepack of convolution");
     packed_weight.init(expected_desc, at_weight.template data_ptr<c10::Half>());
   }
-  packed_weight.feed_from(w);
+  // The packed layout depends on the conv parameters as well as the
+  // weight, so they all go into the file cache key.
+  std::vector<int64_t> pack_key(input_size.begin(), input_size.end());
+  pack_key.insert(
+      pack_key.end(), stride_expanded.begin(), stride_expanded.end());
+  pack_key.insert(
+      pack_key.end(), padding_expanded.begin(), padding_expanded.end());
+  pack_key.insert(
+      pack_key.end(), dilation_expanded.begin(), dilation_expanded.end());
+  pack_key.push_back(groups);
+  pack_key.push_back(weight_is_channels_last_ ? 1 : 0);
+  bool restored_from_cache = false;
+  if (packed_weight_registry::shm_enabled()) {
+    // Attach the packed image another process on this host already
+    // published, so every process serves from one physical copy.
+    auto mapped = packed_weight_registry::load_packed_from_shm(
+        weight_, pack_key, at_weight);
+    if (mapped.has_value()) {
+      at_weight = std::move(mapped.value());
+      packed_weight.init(expected_desc, at_weight.data_ptr());
+      restored_from_cache = true;
+    }
+  }
+  if (!restored_from_cache && packed_weight_registry::file_cache_enabled()) {
+    // mmap a previously stored packed image instead of repacking, so the
+    // OS pages the weight in lazily on first use.
+    auto mapped = packed_weight_registry::load_packed_from_file_cache(
+        weight_, pack_key, at_weight);
+    if (mapped.has_value()) {
+      at_weight = std::move(mapped.value());
+      packed_weight.init(expected_desc, at_weight.data_ptr());
+      restored_from_cache = true;
+    }
+  }
+  if (!restored_from_cache) {
+    packed_weight.feed_from(w);
+    if (packed_weight_registry::file_cache_enabled()) {
+      packed_weight_registry::store_packed_to_file_cache(
+          weight_, pack_key, at_weight);
+    }
+    if (packed_weight_registry::shm_enabled()) {
+      // Publish, then re-attach the shared copy ourselves so the private
+      // packing buffer is released and the publisher counts against the
+      // single physical copy too.
+      packed_weight_registry::store_packed_to_shm(
+          weight_, pack_key, at_weight);
+      auto mapped = packed_weight_registry::load_packed_from_shm(
+          weight_, pack_key, at_weight);
+      if (mapped.has_value()) {
+        at_weight = std::move(mapped.value());
+        packed_weight.init(expected_desc, at_weight.data_ptr());
+        restored_from_cache = true;
+      }
+    }
+  }
+  if (packed_weight_registry::sharing_enabled()) {
+    // Alias a canonical copy if an identical weight was already packed in
+    // this process (e.g. another replica of the same model). The packed
+    // bytes fully determine the content, so rebinding the ideep handle to
+    // the canonical storage is safe.
+    at_weight = packed_weight_registry::get_or_register(at_weight);
+    packed_weight.init(expected_desc, at_weight.data_ptr());
+  }
 
   return ContextConvolution{
       std::move(ori_desc),
@@ -622,6 +686,111 @@ ContextConvolution create(
       ideep::convolution_forward::super(conv_params.pd)};
 }
 
+// Runs the convolution through the per-context primitive LRU (see
+// ContextConvolution::PrimitiveCache): a hit reuses the prepared
+// primitive, a miss prepares one for this input shape and caches it.
+// `input` and `output` must already be contiguous in the target memory
+// format. Returns false for 3-D inputs, which keep the channels-last-1d
+// workaround path in convolution_kernel_output.
+static bool run_cached_primitive(
+    const ContextConvolution& context,
+    const at::Tensor& input,
+    at::Tensor& output,
+    const ideep::attr_t& attr) {
+  if (input.dim() == 3) {
+    return false;
+  }
+  auto& cache = *context.primitive_cache_;
+  auto src_dims = input.sizes().vec();
+  ideep::convolution_forward_params params;
+  ideep::convolution_forward::super prim;
+  bool found = false;
+  {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    for (auto it = cache.entries.begin(); it != cache.entries.end(); ++it) {
+      if (it->weight_version != cache.weight_version) {
+        continue;
+      }
+      if (it->src_dims == src_dims &&
+          omp_get_max_threads() == it->params.pd_use_threads &&
+          attr.has_same_postop_as(it->params.op_attr) &&
+          attr.get_all_scales() == it->params.op_attr.get_all_scales()) {
+        cache.entries.splice(cache.entries.begin(), cache.entries, it);
+        params = cache.entries.front().params;
+        prim = cache.entries.front().prim;
+        found = true;
+        break;
+      }
+    }
+  }
+
+  const ideep::tensor mkldnn_input = itensor_view_from_dense(input);
+  ideep::tensor mkldnn_output = itensor_view_from_dense(output);
+  if (!found) {
+    auto output_dims = mkldnn_output.get_dims();
+    if (context.bias_.is_empty()) {
+      ideep::convolution_forward::prepare(
+          params,
+          mkldnn_input,
+          context.weight_packed_,
+          output_dims,
+          mkldnn_output,
+          {context.stride_.begin(), context.stride_.end()},
+          {context.dilation_.begin(), context.dilation_.end()},
+          {context.padding_.begin(), context.padding_.end()},
+          {context.padding_.begin(), context.padding_.end()},
+          context.groups_,
+          ideep::scale_t(),
+          ideep::scale_t(),
+          ideep::scale_t(),
+          attr,
+          ideep::algorithm::convolution_direct,
+          ideep::prop_kind::forward_inference);
+    } else {
+      ideep::convolution_forward::prepare(
+          params,
+          mkldnn_input,
+          context.weight_packed_,
+          context.bias_,
+          output_dims,
+          mkldnn_output,
+          {context.stride_.begin(), context.stride_.end()},
+          {context.dilation_.begin(), context.dilation_.end()},
+          {context.padding_.begin(), context.padding_.end()},
+          {context.padding_.begin(), context.padding_.end()},
+          context.groups_,
+          ideep::scale_t(),
+          ideep::scale_t(),
+          ideep::scale_t(),
+          attr,
+          ideep::algorithm::convolution_direct,
+          ideep::prop_kind::forward_inference);
+    }
+    prim = ideep::convolution_forward::super(params.pd);
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.entries.push_front(
+        {src_dims, cache.weight_version, params, prim});
+    while (cache.entries.size() >
+           ContextConvolution::PrimitiveCache::kCapacity) {
+      cache.entries.pop_back();
+    }
+  }
+
+  if (context.bias_.is_empty()) {
+    ideep::convolution_forward::compute(
+        params, prim, mkldnn_input, context.weight_packed_, mkldnn_output);
+  } else {
+    ideep::convolution_forward::compute(
+        params,
+        prim,
+        mkldnn_input,
+        context.weight_packed_,
+        context.bias_,
+        mkldnn_output);
+  }
+  return true;
+}
+
 at::Tensor run(
     const ContextConvolution& context,
     const at::Tensor& input,
@@ -643,14 +812,18 @@ at::Tensor run(
     input_ = input.contiguous(memory_format);
   }
 
-  check_shape_forward(
-      input_.sizes(),
-      context.weight_packed_.get_dims(),
-      context.at_bias_,
-      context.padding_,
-      context.stride_,
-      context.dilation_,
-      context.groups_);
+  // skipped for graph-executor calls whose layout/shape contract was
+  // proven at rewrite time; eager calls always validate
+  if (!layout_contracts_trusted()) {
+    check_shape_forward(
+        input_.sizes(),
+        context.weight_packed_.get_dims(),
+        context.at_bias_,
+        context.padding_,
+        context.stride_,
+        context.dilation_,
+        context.groups_);
+  }
 
   if (input_.sizes().vec() == context.conv_params_.pd.src_desc().get_dims() &&
       attr.has_same_postop_as(context.conv_params_.op_attr) &&
@@ -687,6 +860,21 @@ at::Tensor run(
     }
     return output;
   }
+  // Not the prepacked shape: serve the primitive from the per-context
+  // LRU instead of re-creating it inside convolution_kernel every call.
+  if (input_.dim() != 3) {
+    auto output_sizes = calc_conv_output_size(
+        input_.sizes(),
+        context.weight_packed_.get_dims(),
+        context.padding_,
+        context.stride_,
+        context.dilation_);
+    auto output = at::empty(
+        output_sizes, input_.options().memory_format(memory_format));
+    if (run_cached_primitive(context, input_, output, attr)) {
+      return output;
+    }
+  }
   return convolution_kernel(
       input_,
       context.weight_packed_,
@@ -733,14 +921,16 @@ at::Tensor& run(
     }
   }
 
-  check_shape_forward(
-      input_.sizes(),
-      context.weight_packed_.get_dims(),
-      context.at_bias_,
-      context.padding_,
-      context.stride_,
-      context.dilation_,
-      context.groups_);
+  if (!layout_contracts_trusted()) {
+    check_shape_forward(
+        input_.sizes(),
+        context.weight_packed_.get_dims(),
+        context.at_bias_,
+        context.padding_,
+        context.stride_,
+        context.dilation_,
+        context.groups_);
+  }
 
   if (input_.sizes().vec() == context.conv_params_.pd.src_desc().get_dims() &&
       attr == context.conv_params_.op_attr &&
@@ -764,7 +954,7 @@ at::Tensor& run(
           context.bias_,
           mkldnn_output);
     }
-  } else {
+  } else if (!run_cached_primitive(context, input_, accumu, attr)) {
     convolution_kernel_output(
         input_,
         context.weight_packed_,
@@ -1,5 +1,6 @@
 #include "ConvTransposePacked.h"
 #include <ideep.hpp>
+#include "TrustedLayout.h"
 #include "aten/ConvTranspose.h"
 #include "aten/ParamUtils.h"
 #include "aten/WeightPack.h"
@@ -349,14 +350,18 @@ at::Tensor run(
   }
   auto input_ = input.contiguous(memory_format);
 
-  check_shape_forward(
-      input_.sizes(),
-      context.origin_weight_dims_,
-      context.at_bias_,
-      context.padding_,
-      context.stride_,
-      context.dilation_,
-      context.groups_);
+  // skipped for graph-executor calls whose layout/shape contract was
+  // proven at rewrite time; eager calls always validate
+  if (!layout_contracts_trusted()) {
+    check_shape_forward(
+        input_.sizes(),
+        context.origin_weight_dims_,
+        context.at_bias_,
+        context.padding_,
+        context.stride_,
+        context.dilation_,
+        context.groups_);
+  }
 
   return conv_transpose_kernel_impl(
       input_,
@@ -394,14 +399,16 @@ at::Tensor& run(
   // always align accumu format with inputs' format.
   accumu = accumu.contiguous(memory_format);
 
-  check_shape_forward(
-      input_.sizes(),
-      context.origin_weight_dims_,
-      context.at_bias_,
-      context.padding_,
-      context.stride_,
-      context.dilation_,
-      context.groups_);
+  if (!layout_contracts_trusted()) {
+    check_shape_forward(
+        input_.sizes(),
+        context.origin_weight_dims_,
+        context.at_bias_,
+        context.padding_,
+        context.stride_,
+        context.dilation_,
+        context.groups_);
+  }
 
   conv_transpose_out_kernel_impl(
       input_,
@@ -116,7 +116,8 @@ bool is_add_broadcast_supported_by_onednn(
  * \param keep_dim: keep the target dim of output
  * \param udi_left unsqueezed info for every dim
  * \param udi_right unsqueezed info for every dim
- * \param add_arg: the other input of binary post-op
+ * \param add_arg: the other input of binary post-op; an undefined tensor
+ * means no binary post-op (the plain einsum contraction path).
  * \param alpha: the multiplier for other.
  * \return: the ouput of einsum+binary
  */
@@ -233,13 +234,15 @@ static Tensor sumproduct_pair(
   // [1024] we should unsqueeze add_arg to [1,1,1024] to use oneDNN binary ops.
   Tensor arg = add_arg;
   auto out_dims = dim - sum_dims_.size();
-  auto add_arg_dim = add_arg.dim();
+  if (arg.defined()) {
+    auto add_arg_dim = add_arg.dim();
 
-  for (int i = out_dims - 1; i >= 0; i--) {
-    if (add_arg_dim-- <= 0)
-      arg = arg.unsqueeze(0);
+    for (int i = out_dims - 1; i >= 0; i--) {
+      if (add_arg_dim-- <= 0)
+        arg = arg.unsqueeze(0);
+    }
+    arg = arg.permute(argpermutation);
   }
-  arg = arg.permute(argpermutation);
 
   // 1)expand the add_arg to the same shape in ro dims
   // 2)collapse the ro dims to use the oneDNN matmul, pls see the
@@ -250,7 +253,7 @@ static Tensor sumproduct_pair(
   //  they should have same dim order. B should also have the same dim order as
   //  the output for every dim, they should be same or to be 1 to make sure they
   //  can be broadcasted.
-  if (ro.size() > 1) {
+  if (arg.defined() && ro.size() > 1) {
     auto arg_size = arg.sizes();
     std::vector<int64_t> expanded_size(out_dims, 1);
     for (int i = 0; i < out_dims - ro.size(); i++) {
@@ -335,12 +338,17 @@ static Tensor sumproduct_pair(
   // now we do the computation
   Tensor result;
   bool is_fallback_post_add = false;
-  if (is_add_broadcast_supported_by_onednn(left, right, arg)) {
+  if (!arg.defined()) {
+    // no binary post-op to fuse: still go through bmm_impl so that the
+    // permuted (strided) operands are consumed directly by the MKL/oneDNN
+    // batched matmul instead of being materialized by at::bmm
+    result = bmm_impl(left, right, at::Tensor(), ideep::attr_t(), {}, 1.0f);
+  } else if (is_add_broadcast_supported_by_onednn(left, right, arg)) {
     auto _input = arg.is_contiguous() ? arg : arg.contiguous();
     ideep::tensor onednn_input = itensor_view_from_dense(_input);
     auto op_attr = ideep::attr_t::fuse_binary(
         dnnl::algorithm::binary_add, onednn_input.get_desc());
-    op_attr.set_fpmath_mode(torch_ipex::fpmath_mode);
+    op_attr.set_fpmath_mode(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::MATMUL));
     result = bmm_impl(left, right, at::Tensor(), op_attr, {onednn_input}, 1.0f);
   } else {
     result = at::matmul(left, right);
@@ -787,5 +795,71 @@ at::Tensor einsum_binary(
   return result;
 }
 
+//! function: dil_einsum
+/*!
+ * This function lowers a plain (un-fused) two-operand einsum contraction
+ * through the same prepare/sumproduct pipeline as einsum_binary, so that
+ * batched 4D contractions like "bhid,bhjd->bhij" hit the transpose-free
+ * MKL/oneDNN batched matmul with strided operands instead of the aten
+ * permute + contiguous + bmm decomposition.
+ *\param equation:  The subscripts for the Einstein summation.
+ *more detials about equation can found:
+ *https://pytorch.org/docs/stable/generated/torch.einsum.html
+ *\param operands: The tensors to compute the Einstein summation of.
+ */
+at::Tensor dil_einsum(
+    c10::string_view equation,
+    const c10::List<at::Tensor>& operands) {
+  RECORD_FUNCTION("dil_einsum", c10::ArrayRef<c10::IValue>({}));
+  // the MKL FP32 BMM kernel and the oneDNN matmul primitive only cover the
+  // floating point types; fall back to aten for anything else
+  for (const auto& operand : operands) {
+    if (operand.scalar_type() != at::kFloat &&
+        operand.scalar_type() != at::kBFloat16 &&
+        operand.scalar_type() != at::kHalf) {
+      return at::einsum(equation, operands.vec());
+    }
+  }
+  auto prepare_res = einsum_prepare(equation, operands);
+  bool has_zero_size_dim = std::get<0>(prepare_res);
+  auto out_size = std::get<1>(prepare_res);
+  auto dim_last_op = std::get<2>(prepare_res);
+  auto sum_dims = std::get<3>(prepare_res);
+  auto permuted_operands = std::get<4>(prepare_res);
+  auto unsqueezed_dim_info = std::get<5>(prepare_res);
+  Tensor result = permuted_operands[0];
+  Tensor operand = permuted_operands[1];
+  std::vector<bool> udi_result = unsqueezed_dim_info[0];
+  std::vector<bool> udi_operand = unsqueezed_dim_info[1];
+
+  // Fast path for when an operand has zero sized dim
+  if (has_zero_size_dim) {
+    std::vector<int64_t> out_shape(out_size);
+    for (const auto i : c10::irange(out_size)) {
+      out_shape[i] = permuted_operands[dim_last_op[i]].size(i);
+    }
+    return at::zeros(out_shape, result.options());
+  }
+
+  // Multiply tensors and sum out dimensions in sum_dims
+  if (sum_dims.empty()) {
+    result = result.mul(operand);
+  } else if (sum_dims.size() == result.sizes().size()) {
+    result = result.flatten().dot(operand.flatten());
+  } else {
+    result = sumproduct_pair(
+        result,
+        operand,
+        sum_dims,
+        false,
+        udi_result,
+        udi_operand,
+        at::Tensor(),
+        1);
+  }
+
+  return result;
+}
+
 } // namespace cpu
 } // namespace torch_ipex
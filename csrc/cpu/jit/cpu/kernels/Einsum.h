@@ -14,6 +14,7 @@ namespace jit {
 // And the alias analysis is not working for namespace other than aten ...
 // So we fake some op namespaces to workaround that.
 namespace ipex {
+static auto einsum = Symbol::fromQualString("ipex::einsum");
 static auto einsum_binary = Symbol::fromQualString("ipex::einsum_binary");
 
 } // namespace ipex
@@ -24,6 +25,10 @@ static auto einsum_binary = Symbol::fromQualString("ipex::einsum_binary");
 namespace torch_ipex {
 namespace cpu {
 
+at::Tensor dil_einsum(
+    c10::string_view equation,
+    const c10::List<at::Tensor>& operands);
+
 at::Tensor einsum_binary(
     c10::string_view,
     const c10::List<at::Tensor>& operands,
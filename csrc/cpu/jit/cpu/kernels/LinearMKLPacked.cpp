@@ -1,14 +1,250 @@
 #include "LinearMKLPacked.h"
+#include <ATen/Parallel.h>
+#include <atomic>
 #include <ideep.hpp>
+#include "aten/Linear.h"
 #include "aten/LinearMKL.h"
 #include "aten/WeightPack.h"
 #include "ideep/IDeepConversions.h"
 
+#if defined(__x86_64__) || defined(_M_X64)
+#include <x86intrin.h>
+#endif
+
 namespace torch_ipex {
 namespace cpu {
 namespace detail {
 namespace mkl_sgemm {
 
+namespace {
+
+// Bound the alternate packed images kept per context: one per batch tier
+// per stream thread budget is the expected population; a fully dynamic
+// M dimension should keep falling back to plain sgemm instead of
+// churning repacks.
+constexpr size_t kMaxPackedImagesPerContext = 8;
+
+std::atomic<uint64_t> g_pack_cache_hits{0};
+std::atomic<uint64_t> g_pack_cache_repacks{0};
+std::atomic<uint64_t> g_pack_cache_fallbacks{0};
+
+// Returns the packed image for (batch, nthreads), repacking from the
+// original weight and caching it on first sight. Returns an undefined
+// tensor when the cache is full, in which case the caller falls back to
+// the plain sgemm kernel. Packing happens under the cache lock so
+// concurrent streams asking for the same key pack only once.
+at::Tensor get_or_repack_image(
+    ContextLinearMKL& context,
+    int64_t batch,
+    int64_t nthreads) {
+  auto& cache = *context.runtime_state_;
+  std::lock_guard<std::mutex> lock(cache.mutex_);
+  auto key = std::make_pair(batch, nthreads);
+  auto it = cache.images_.find(key);
+  if (it != cache.images_.end()) {
+    g_pack_cache_hits.fetch_add(1, std::memory_order_relaxed);
+    return it->second;
+  }
+  if (cache.images_.size() >= kMaxPackedImagesPerContext) {
+    g_pack_cache_fallbacks.fetch_add(1, std::memory_order_relaxed);
+    return at::Tensor();
+  }
+  g_pack_cache_repacks.fetch_add(1, std::memory_order_relaxed);
+  auto packed = mkl_sgemm_pack_weight(
+      batch,
+      context.sgemm_sizes_[2],
+      context.sgemm_sizes_[1],
+      context.ori_weight_);
+  cache.images_.emplace(key, packed);
+  return packed;
+}
+
+// Dynamic kernel selection (IPEX_LINEAR_DYNAMIC_KERNEL=1): MKL packed
+// sgemm, plain MKL sgemm and the oneDNN inner_product each win in
+// different M regimes, but the backend is normally frozen at prepack.
+// When enabled, the first calls of each M bucket are round-robined over
+// the three arms with cycle measurements, after which the cheapest arm is
+// frozen for that bucket. Buckets are powers of two of M, so traffic
+// oscillating between batch-1 decode and batch-64 scoring learns an
+// independent choice for each regime.
+enum MklLinearArm : int {
+  kArmMklPacked = 0,
+  kArmMklPlain = 1,
+  kArmOnednn = 2,
+};
+
+constexpr uint64_t kCalibrationCallsPerArm = 64;
+
+bool dynamic_kernel_selection_enabled() {
+  static bool enabled = []() {
+    auto* env = std::getenv("IPEX_LINEAR_DYNAMIC_KERNEL");
+    return env != nullptr && atoi(env) != 0;
+  }();
+  return enabled;
+}
+
+inline uint64_t read_cycles() {
+#if defined(__x86_64__) || defined(_M_X64)
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+int64_t m_bucket(int64_t m) {
+  int64_t bucket = 1;
+  while (bucket < m) {
+    bucket <<= 1;
+  }
+  return bucket;
+}
+
+// Caller holds the state mutex. Lazily packs the oneDNN inner_product
+// weight from the original weight; the blocked desc is batch-agnostic so
+// a single image serves every M.
+const ideep::tensor& get_onednn_weight(
+    ContextLinearMKL& context,
+    MKLLinearRuntimeState& state) {
+  if (state.onednn_weight_.is_empty()) {
+    auto w = itensor_view_from_dense(context.ori_weight_);
+    auto packed_desc = ideep::inner_product_forward::expected_weights_desc(
+        {context.sgemm_sizes_[2], context.sgemm_sizes_[1]},
+        /* input_size */ ideep::dims(),
+        w.get_data_type(),
+        w.get_data_type());
+    state.onednn_at_weight_ =
+        empty_aten_tensor_from_desc(packed_desc, context.ori_weight_.options());
+    state.onednn_weight_.init(
+        packed_desc, state.onednn_at_weight_.template data_ptr<float>());
+    state.onednn_weight_.feed_from(w);
+  }
+  return state.onednn_weight_;
+}
+
+// Caller holds the state mutex. Round-robins the under-sampled arms while
+// calibrating, then freezes the arm with the lowest mean cycles. The MKL
+// packed arm is only eligible when an image for this (M, nthreads)
+// exists; a frozen packed choice degrades to plain sgemm when it does
+// not.
+int choose_arm(
+    MKLLinearRuntimeState::ArmStats& st,
+    bool packed_available) {
+  if (st.frozen_arm_ >= 0) {
+    if (st.frozen_arm_ == kArmMklPacked && !packed_available) {
+      return kArmMklPlain;
+    }
+    return st.frozen_arm_;
+  }
+  int arm = -1;
+  for (int a = 0; a < 3; ++a) {
+    if (a == kArmMklPacked && !packed_available) {
+      continue;
+    }
+    if (st.calls_[a] >= kCalibrationCallsPerArm) {
+      continue;
+    }
+    if (arm < 0 || st.calls_[a] < st.calls_[arm]) {
+      arm = a;
+    }
+  }
+  if (arm >= 0) {
+    return arm;
+  }
+  int best = -1;
+  double best_mean = 0;
+  for (int a = 0; a < 3; ++a) {
+    if (st.calls_[a] == 0) {
+      continue;
+    }
+    double mean = (double)st.cycles_[a] / (double)st.calls_[a];
+    if (best < 0 || mean < best_mean) {
+      best = a;
+      best_mean = mean;
+    }
+  }
+  st.frozen_arm_ = best;
+  if (best == kArmMklPacked && !packed_available) {
+    return kArmMklPlain;
+  }
+  return best;
+}
+
+struct ArmChoice {
+  int arm = kArmMklPlain;
+  int64_t bucket = 0;
+  at::Tensor packed; // defined iff arm == kArmMklPacked
+  ideep::tensor onednn_weight; // non-empty iff arm == kArmOnednn
+};
+
+ArmChoice select_arm(
+    ContextLinearMKL& context,
+    int64_t input_batch,
+    int64_t nthreads) {
+  auto& state = *context.runtime_state_;
+  ArmChoice choice;
+  choice.bucket = m_bucket(input_batch);
+  {
+    std::lock_guard<std::mutex> lock(state.mutex_);
+    auto& st = state.kernel_stats_[choice.bucket];
+    if (st.frozen_arm_ >= 0 && st.frozen_arm_ != kArmMklPacked) {
+      // Decision made and it does not need a packed image: skip the image
+      // cache entirely so frozen oneDNN/plain buckets never trigger
+      // repacks for new (M, nthreads) keys.
+      choice.arm = st.frozen_arm_;
+      if (choice.arm == kArmOnednn) {
+        choice.onednn_weight = get_onednn_weight(context, state);
+      }
+      return choice;
+    }
+  }
+  at::Tensor packed;
+  if (input_batch == context.sgemm_sizes_[0] &&
+      nthreads == context.pack_nthreads_) {
+    packed = context.at_weight_;
+  } else {
+    packed = get_or_repack_image(context, input_batch, nthreads);
+  }
+  std::lock_guard<std::mutex> lock(state.mutex_);
+  auto& st = state.kernel_stats_[choice.bucket];
+  choice.arm = choose_arm(st, packed.defined());
+  if (choice.arm == kArmMklPacked) {
+    choice.packed = packed;
+  } else if (choice.arm == kArmOnednn) {
+    choice.onednn_weight = get_onednn_weight(context, state);
+  }
+  return choice;
+}
+
+void record_arm(
+    ContextLinearMKL& context,
+    const ArmChoice& choice,
+    uint64_t cycles) {
+  auto& state = *context.runtime_state_;
+  std::lock_guard<std::mutex> lock(state.mutex_);
+  auto& st = state.kernel_stats_[choice.bucket];
+  if (st.frozen_arm_ >= 0) {
+    return;
+  }
+  st.calls_[choice.arm] += 1;
+  st.cycles_[choice.arm] += cycles;
+}
+
+} // namespace
+
+MklSgemmPackCacheStats get_pack_cache_stats() {
+  MklSgemmPackCacheStats stats;
+  stats.hits = g_pack_cache_hits.load(std::memory_order_relaxed);
+  stats.repacks = g_pack_cache_repacks.load(std::memory_order_relaxed);
+  stats.fallbacks = g_pack_cache_fallbacks.load(std::memory_order_relaxed);
+  return stats;
+}
+
+void reset_pack_cache_stats() {
+  g_pack_cache_hits.store(0, std::memory_order_relaxed);
+  g_pack_cache_repacks.store(0, std::memory_order_relaxed);
+  g_pack_cache_fallbacks.store(0, std::memory_order_relaxed);
+}
+
 c10::intrusive_ptr<MKLOpContext> createLinearMKLPrePackOpContext(
     at::Tensor&& weight,
     c10::optional<at::Tensor>&& bias,
@@ -46,12 +282,14 @@ ContextLinearMKL create(
   auto mkl_weight =
       mkl_sgemm_pack_weight(batch, out_features, in_features, weight);
 
-  return ContextLinearMKL{
+  ContextLinearMKL context{
       std::move(sgemm_sizes),
       std::move(mkl_weight),
       std::move(weight),
       bias.has_value() ? c10::make_optional(*bias) : c10::nullopt,
   };
+  context.pack_nthreads_ = at::get_num_threads();
+  return context;
 }
 
 at::Tensor run(ContextLinearMKL& context, const at::Tensor& input) {
@@ -65,14 +303,48 @@ at::Tensor run(ContextLinearMKL& context, const at::Tensor& input) {
   const at::Tensor& bias = *bias_maybe_owned;
   int64_t input_batch = (int64_t)(input_.numel() / K);
 
-  // Since MKL prepack API only accepts fixed M/N/K, a repack is required
-  // when M changes. To avoid frequently repacking the weights,
-  // it will fall back to the MKL cblas_sgemm kernel when M-dim is
-  // dynamically changed.
-  if (input_batch != context.sgemm_sizes_[0])
-    return mkl_sgemm_kernel(input_, context.ori_weight_, bias);
-  return mkl_prepack_sgemm_kernel(
-      input_, context.at_weight_, bias, context.sgemm_sizes_[2]);
+  // Since MKL prepack API only accepts fixed M/N/K and the packed image
+  // is also specialized for the thread count at pack time, the prepacked
+  // weight is only valid for the (M, nthreads) it was created with. Other
+  // recurring combinations (different batch sizes, or different
+  // per-stream thread budgets under MultiStreamModule) are served from
+  // the per-context image cache; a fully dynamic M-dim falls back to the
+  // plain MKL cblas_sgemm kernel once the cache is full.
+  const int64_t nthreads = at::get_num_threads();
+  if (dynamic_kernel_selection_enabled()) {
+    auto choice = select_arm(context, input_batch, nthreads);
+    auto start = read_cycles();
+    at::Tensor result;
+    switch (choice.arm) {
+      case kArmMklPacked:
+        result = mkl_prepack_sgemm_kernel(
+            input_, choice.packed, bias, context.sgemm_sizes_[2]);
+        break;
+      case kArmOnednn:
+        result = linear_kernel(
+            input_,
+            choice.onednn_weight,
+            bias,
+            ideep::attr_t(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::LINEAR)));
+        break;
+      default:
+        result = mkl_sgemm_kernel(input_, context.ori_weight_, bias);
+        break;
+    }
+    record_arm(context, choice, read_cycles() - start);
+    return result;
+  }
+  if (input_batch == context.sgemm_sizes_[0] &&
+      nthreads == context.pack_nthreads_) {
+    return mkl_prepack_sgemm_kernel(
+        input_, context.at_weight_, bias, context.sgemm_sizes_[2]);
+  }
+  auto packed = get_or_repack_image(context, input_batch, nthreads);
+  if (packed.defined()) {
+    return mkl_prepack_sgemm_kernel(
+        input_, packed, bias, context.sgemm_sizes_[2]);
+  }
+  return mkl_sgemm_kernel(input_, context.ori_weight_, bias);
 }
 
 at::Tensor& run(
@@ -88,11 +360,42 @@ at::Tensor& run(
       at::borrow_from_optional_tensor(context.at_bias_);
   const at::Tensor& bias = *bias_maybe_owned;
   int64_t input_batch = (int64_t)(input_.numel() / K);
-  if (input_batch != context.sgemm_sizes_[0]) {
-    mkl_sgemm_kernel_output(input_, context.ori_weight_, bias, accumu);
-  } else {
+  const int64_t nthreads = at::get_num_threads();
+  if (dynamic_kernel_selection_enabled()) {
+    auto choice = select_arm(context, input_batch, nthreads);
+    auto start = read_cycles();
+    switch (choice.arm) {
+      case kArmMklPacked:
+        mkl_prepack_sgemm_kernel_output(
+            input_, choice.packed, bias, context.sgemm_sizes_[2], accumu);
+        break;
+      case kArmOnednn:
+        linear_kernel_output(
+            input_,
+            choice.onednn_weight,
+            bias,
+            accumu,
+            ideep::attr_t(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::LINEAR)));
+        break;
+      default:
+        mkl_sgemm_kernel_output(input_, context.ori_weight_, bias, accumu);
+        break;
+    }
+    record_arm(context, choice, read_cycles() - start);
+    return accumu;
+  }
+  if (input_batch == context.sgemm_sizes_[0] &&
+      nthreads == context.pack_nthreads_) {
     mkl_prepack_sgemm_kernel_output(
         input_, context.at_weight_, bias, context.sgemm_sizes_[2], accumu);
+    return accumu;
+  }
+  auto packed = get_or_repack_image(context, input_batch, nthreads);
+  if (packed.defined()) {
+    mkl_prepack_sgemm_kernel_output(
+        input_, packed, bias, context.sgemm_sizes_[2], accumu);
+  } else {
+    mkl_sgemm_kernel_output(input_, context.ori_weight_, bias, accumu);
   }
   return accumu;
 }
@@ -32,6 +32,19 @@ at::Tensor& run(
 
 at::Tensor pack(ContextLinearMKL& context, const at::Tensor& tensor);
 
+// Counters for the per-context packed image cache: hits (reused a cached
+// image), repacks (packed a new image for an unseen (batch, nthreads)
+// combination) and fallbacks (cache full, served by plain sgemm).
+// Aggregated over all MKL sgemm op contexts.
+struct MklSgemmPackCacheStats {
+  uint64_t hits;
+  uint64_t repacks;
+  uint64_t fallbacks;
+};
+
+MklSgemmPackCacheStats get_pack_cache_stats();
+void reset_pack_cache_stats();
+
 } // namespace mkl_sgemm
 } // namespace detail
 } // namespace cpu
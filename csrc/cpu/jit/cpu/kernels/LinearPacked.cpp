@@ -1,8 +1,12 @@
 #include "LinearPacked.h"
 #include <ideep.hpp>
+#include <map>
+#include "PackedWeightRegistry.h"
+#include "TrustedLayout.h"
 #include "aten/Linear.h"
 #include "aten/WeightPack.h"
 #include "ideep/IDeepConversions.h"
+#include "utils/SysUtil.h"
 
 namespace torch_ipex {
 namespace cpu {
@@ -19,7 +23,7 @@ namespace linear {
     return op_context->run(                                    \
         input,                                                 \
         ideep::attr_t::fuse_##FUSED_OP().set_fpmath_mode(      \
-            torch_ipex::fpmath_mode));                         \
+            torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::LINEAR)));                         \
   }
 
 c10::intrusive_ptr<LinearOpContext> createLinearPrePackOpContext(
@@ -39,7 +43,7 @@ at::Tensor linear_run(
     const c10::intrusive_ptr<LinearOpContext>& op_context) {
   RECORD_FUNCTION("ipex_prepack::linear_run", c10::ArrayRef<c10::IValue>({}));
 
-  return op_context->run(input, ideep::attr_t(torch_ipex::fpmath_mode));
+  return op_context->run(input, ideep::attr_t(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::LINEAR)));
 }
 
 DEFINE_LINEAR_UNARY_ELTWISE_RUN(relu);
@@ -66,7 +70,7 @@ at::Tensor linear_leaky_relu_run(
   return op_context->run(
       input,
       ideep::attr_t::fuse_relu(1.0, alpha_value)
-          .set_fpmath_mode(torch_ipex::fpmath_mode));
+          .set_fpmath_mode(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::LINEAR)));
 }
 
 at::Tensor linear_hardtanh_run(
@@ -81,7 +85,7 @@ at::Tensor linear_hardtanh_run(
   return op_context->run(
       input,
       ideep::attr_t::fuse_clamp(lower_bound_value, upper_bound_value)
-          .set_fpmath_mode(torch_ipex::fpmath_mode));
+          .set_fpmath_mode(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::LINEAR)));
 }
 
 at::Tensor linear_elu_run(
@@ -98,7 +102,7 @@ at::Tensor linear_elu_run(
   return op_context->run(
       input,
       ideep::attr_t::fuse_elu(scale_value, alpha_value, input_scale_value)
-          .set_fpmath_mode(torch_ipex::fpmath_mode));
+          .set_fpmath_mode(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::LINEAR)));
 }
 
 at::Tensor linear_pow_run(
@@ -111,7 +115,7 @@ at::Tensor linear_pow_run(
   return op_context->run(
       input,
       ideep::attr_t::fuse_pow(1.0, 1.0, exponent_value)
-          .set_fpmath_mode(torch_ipex::fpmath_mode));
+          .set_fpmath_mode(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::LINEAR)));
 }
 
 at::Tensor linear_gelu_run(
@@ -136,7 +140,7 @@ at::Tensor linear_gelu_run(
   return op_context->run(
       input,
       ideep::attr_t::fuse_gelu(1.0, 0.f, 0.f, gelu_type)
-          .set_fpmath_mode(torch_ipex::fpmath_mode));
+          .set_fpmath_mode(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::LINEAR)));
 }
 
 at::Tensor linear_add_run(
@@ -151,7 +155,7 @@ at::Tensor linear_add_run(
   return op_context->run(
       input,
       accumu,
-      ideep::attr_t::fuse_sum(scale).set_fpmath_mode(torch_ipex::fpmath_mode));
+      ideep::attr_t::fuse_sum(scale).set_fpmath_mode(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::LINEAR)));
 }
 
 at::Tensor linear_add_relu_run(
@@ -166,7 +170,7 @@ at::Tensor linear_add_relu_run(
   return op_context->run(
       input,
       accumu,
-      ideep::attr_t::residual(scale).set_fpmath_mode(torch_ipex::fpmath_mode));
+      ideep::attr_t::residual(scale).set_fpmath_mode(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::LINEAR)));
 }
 
 at::Tensor linear_mul_run(
@@ -188,7 +192,7 @@ at::Tensor linear_mul_run(
       dnnl::algorithm::binary_mul, onednn_to_mul.get_desc());
   std::vector<ideep::tensor> post_op_tensors = {onednn_to_mul};
   return op_context->run_with_binary_post_op(
-      input, post_op_tensors, op_attr.set_fpmath_mode(torch_ipex::fpmath_mode));
+      input, post_op_tensors, op_attr.set_fpmath_mode(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::LINEAR)));
 }
 
 at::Tensor linear_mul_add_run(
@@ -221,7 +225,96 @@ at::Tensor linear_mul_add_run(
 
   std::vector<ideep::tensor> post_op_tensors = {onednn_to_mul, onednn_to_add};
   return op_context->run_with_binary_post_op(
-      input, post_op_tensors, op_attr.set_fpmath_mode(torch_ipex::fpmath_mode));
+      input, post_op_tensors, op_attr.set_fpmath_mode(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::LINEAR)));
+}
+
+namespace {
+
+struct EpilogueEltwiseSpec {
+  dnnl::algorithm algorithm;
+  float alpha;
+  float beta;
+};
+
+// Step names match the attr keys used by
+// graph_rewrite::utils::supported_unary_post_op_fusion_set(), so the
+// rewriter can translate any chain of already-fusable activations
+// directly into an epilogue list.
+const EpilogueEltwiseSpec* epilogue_eltwise_spec(const std::string& name) {
+  static const std::map<std::string, EpilogueEltwiseSpec> spec_map{
+      {"relu", {dnnl::algorithm::eltwise_relu, 0.f, 0.f}},
+      {"sigmoid", {dnnl::algorithm::eltwise_logistic, 0.f, 0.f}},
+      {"swish", {dnnl::algorithm::eltwise_swish, 1.f, 0.f}},
+      {"tanh", {dnnl::algorithm::eltwise_tanh, 0.f, 0.f}},
+      {"mish", {dnnl::algorithm::eltwise_mish, 0.f, 0.f}},
+      {"abs", {dnnl::algorithm::eltwise_abs, 0.f, 0.f}},
+      {"exp", {dnnl::algorithm::eltwise_exp, 0.f, 0.f}},
+      {"hardswish", {dnnl::algorithm::eltwise_hardswish, 1.f / 6.f, 0.5f}},
+      {"square", {dnnl::algorithm::eltwise_square, 0.f, 0.f}},
+      {"log", {dnnl::algorithm::eltwise_log, 0.f, 0.f}},
+      {"round", {dnnl::algorithm::eltwise_round, 0.f, 0.f}},
+      {"sqrt", {dnnl::algorithm::eltwise_sqrt, 0.f, 0.f}},
+      {"hardsigmoid", {dnnl::algorithm::eltwise_hardsigmoid, 1.f / 6.f, 0.5f}},
+      {"gelu_erf", {dnnl::algorithm::eltwise_gelu_erf, 0.f, 0.f}},
+      {"gelu_tanh", {dnnl::algorithm::eltwise_gelu_tanh, 0.f, 0.f}},
+  };
+  auto it = spec_map.find(name);
+  return it == spec_map.end() ? nullptr : &it->second;
+}
+
+} // namespace
+
+at::Tensor linear_epilogue_run(
+    const at::Tensor& input,
+    const std::vector<std::string>& epilogue,
+    const std::vector<at::Tensor>& extra_inputs,
+    const c10::intrusive_ptr<LinearOpContext>& op_context) {
+  RECORD_FUNCTION(
+      "ipex_prepack::linear_epilogue_run", c10::ArrayRef<c10::IValue>({}));
+  auto dtype = input.scalar_type();
+  ideep::post_ops po;
+  std::vector<ideep::tensor> post_op_tensors;
+  // keeps the aligned aten tensors alive for the duration of the run
+  std::vector<at::Tensor> aligned;
+  size_t extra_idx = 0;
+  for (auto& step : epilogue) {
+    if (step == "add" || step == "mul") {
+      TORCH_CHECK(
+          extra_idx < extra_inputs.size(),
+          "linear epilogue: step '",
+          step,
+          "' has no corresponding extra input");
+      // align dtype and format with the inner product output, see
+      // [Note: onednn inner product with Pytorch Linear]
+      auto t = extra_inputs[extra_idx++].contiguous().to(dtype);
+      aligned.push_back(
+          t.dim() == 2 ? t : t.reshape({-1, t.size(t.dim() - 1)}));
+      ideep::tensor onednn_t = itensor_view_from_dense(aligned.back());
+      po.append_binary(
+          step == "add" ? dnnl::algorithm::binary_add
+                        : dnnl::algorithm::binary_mul,
+          onednn_t.get_desc());
+      post_op_tensors.push_back(onednn_t);
+    } else {
+      auto* spec = epilogue_eltwise_spec(step);
+      TORCH_CHECK(
+          spec != nullptr, "linear epilogue: unsupported step '", step, "'");
+      po.append_eltwise(spec->algorithm, spec->alpha, spec->beta);
+    }
+  }
+  TORCH_CHECK(
+      extra_idx == extra_inputs.size(),
+      "linear epilogue: ",
+      extra_inputs.size() - extra_idx,
+      " extra input(s) not consumed by any add/mul step");
+  ideep::attr_t op_attr;
+  op_attr.set_post_ops(po);
+  op_attr.set_fpmath_mode(
+      torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::LINEAR));
+  if (post_op_tensors.empty()) {
+    return op_context->run(input, op_attr);
+  }
+  return op_context->run_with_binary_post_op(input, post_op_tensors, op_attr);
 }
 
 ContextLinear create(
@@ -255,7 +348,63 @@ ContextLinear create(
         "Only support bfloat16, float16 and float for weight prepack of linear");
     packed_weight.init(packed_desc, at_weight.template data_ptr<c10::Half>());
   }
-  packed_weight.feed_from(w);
+  bool restored_from_cache = false;
+  if (packed_weight_registry::shm_enabled()) {
+    // Attach the packed image another process on this host already
+    // published, so every process serves from one physical copy.
+    auto mapped = packed_weight_registry::load_packed_from_shm(
+        weight, {batch_size.value_or(-1)}, at_weight);
+    if (mapped.has_value()) {
+      at_weight = std::move(mapped.value());
+      packed_weight.init(packed_desc, at_weight.data_ptr());
+      restored_from_cache = true;
+    }
+  }
+  if (!restored_from_cache && packed_weight_registry::file_cache_enabled()) {
+    // mmap a previously stored packed image instead of repacking, so the
+    // OS pages the weight in lazily on first use.
+    auto mapped = packed_weight_registry::load_packed_from_file_cache(
+        weight, {batch_size.value_or(-1)}, at_weight);
+    if (mapped.has_value()) {
+      at_weight = std::move(mapped.value());
+      packed_weight.init(packed_desc, at_weight.data_ptr());
+      restored_from_cache = true;
+    }
+  }
+  if (!restored_from_cache) {
+    packed_weight.feed_from(w);
+    if (packed_weight_registry::file_cache_enabled()) {
+      packed_weight_registry::store_packed_to_file_cache(
+          weight, {batch_size.value_or(-1)}, at_weight);
+    }
+    if (packed_weight_registry::shm_enabled()) {
+      // Publish, then re-attach the shared copy ourselves so the private
+      // packing buffer is released and the publisher counts against the
+      // single physical copy too.
+      packed_weight_registry::store_packed_to_shm(
+          weight, {batch_size.value_or(-1)}, at_weight);
+      auto mapped = packed_weight_registry::load_packed_from_shm(
+          weight, {batch_size.value_or(-1)}, at_weight);
+      if (mapped.has_value()) {
+        at_weight = std::move(mapped.value());
+        packed_weight.init(packed_desc, at_weight.data_ptr());
+        restored_from_cache = true;
+      }
+    }
+  }
+  if (packed_weight_registry::sharing_enabled()) {
+    // Alias a canonical copy if an identical weight was already packed in
+    // this process (e.g. another replica of the same model). The packed
+    // bytes fully determine the content, so rebinding the ideep handle to
+    // the canonical storage is safe.
+    at_weight = packed_weight_registry::get_or_register(at_weight);
+    packed_weight.init(packed_desc, at_weight.data_ptr());
+  }
+  if (ipex_thp_alloc_enabled() && !restored_from_cache) {
+    // Long-lived and hot every decode step; back it with 2M pages to cut
+    // dTLB misses. Skip the file-cache path: those pages are file-backed.
+    ipex_madvise_hugepage(at_weight.data_ptr(), at_weight.nbytes());
+  }
   return ContextLinear{
       std::move(ori_desc),
       std::move(packed_weight),
@@ -268,9 +417,13 @@ at::Tensor run(
     const ContextLinear& context,
     const at::Tensor& input,
     const ideep::attr_t& attr) {
-  TORCH_CHECK(
-      input.size(input.dim() - 1) == context.weight_packed_.get_dims()[1],
-      "Check the shapes of mat1 and mat2, they cannot be multiplied!");
+  // graph-executor calls with a rewrite-time proven layout contract skip
+  // the per-call validation; eager calls always take the checked path
+  if (!layout_contracts_trusted()) {
+    TORCH_CHECK(
+        input.size(input.dim() - 1) == context.weight_packed_.get_dims()[1],
+        "Check the shapes of mat1 and mat2, they cannot be multiplied!");
+  }
   auto input_ = input.contiguous();
   c10::MaybeOwned<at::Tensor> bias_maybe_owned =
       at::borrow_from_optional_tensor(context.at_bias_);
@@ -283,9 +436,11 @@ at::Tensor& run(
     const at::Tensor& input,
     at::Tensor& accumu,
     const ideep::attr_t& attr) {
-  TORCH_CHECK(
-      input.size(input.dim() - 1) == context.weight_packed_.get_dims()[1],
-      "Check the shapes of mat1 and mat2, they cannot be multiplied!");
+  if (!layout_contracts_trusted()) {
+    TORCH_CHECK(
+        input.size(input.dim() - 1) == context.weight_packed_.get_dims()[1],
+        "Check the shapes of mat1 and mat2, they cannot be multiplied!");
+  }
   auto input_ = input.contiguous();
   c10::MaybeOwned<at::Tensor> bias_maybe_owned =
       at::borrow_from_optional_tensor(context.at_bias_);
@@ -299,9 +454,11 @@ at::Tensor run(
     const at::Tensor& input,
     const std::vector<ideep::tensor>& post_op_src,
     const ideep::attr_t& attr) {
-  TORCH_CHECK(
-      input.size(input.dim() - 1) == context.weight_packed_.get_dims()[1],
-      "Check the shapes of mat1 and mat2, they cannot be multiplied!");
+  if (!layout_contracts_trusted()) {
+    TORCH_CHECK(
+        input.size(input.dim() - 1) == context.weight_packed_.get_dims()[1],
+        "Check the shapes of mat1 and mat2, they cannot be multiplied!");
+  }
   auto input_ = input.contiguous();
   c10::MaybeOwned<at::Tensor> bias_maybe_owned =
       at::borrow_from_optional_tensor(context.at_bias_);
@@ -378,6 +535,69 @@ at::Tensor pack(ContextLinear& context, const at::Tensor& tensor) {
   return packed_at_tensor;
 }
 
+// Builds the packed image of the low-rank update alpha * lora_b @ lora_a.
+// The reorder into the blocked layout is a linear map, so adding the
+// packed delta to the packed weight equals prepacking the merged weight,
+// up to the rounding of one dtype conversion.
+static at::Tensor packed_lora_delta(
+    ContextLinear& context,
+    const at::Tensor& lora_a,
+    const at::Tensor& lora_b,
+    double alpha) {
+  auto weight_dims = context.original_desc_.get_dims();
+  TORCH_CHECK(
+      lora_b.dim() == 2 && lora_a.dim() == 2 &&
+          lora_b.size(1) == lora_a.size(0),
+      "lora delta: expected 2-D factors with matching rank, got shapes ",
+      lora_b.sizes(),
+      " and ",
+      lora_a.sizes());
+  TORCH_CHECK(
+      lora_b.size(0) == weight_dims[0] && lora_a.size(1) == weight_dims[1],
+      "lora delta: factors of shapes ",
+      lora_b.sizes(),
+      " and ",
+      lora_a.sizes(),
+      " do not produce a weight of shape [",
+      weight_dims[0],
+      ", ",
+      weight_dims[1],
+      "]");
+  // rank-r product in fp32, converted once to the weight dtype so the
+  // delta reorders through exactly the context's blocked descriptor
+  auto delta = at::matmul(lora_b.to(at::kFloat), lora_a.to(at::kFloat))
+                   .mul_(alpha)
+                   .to(context.at_weight_.scalar_type())
+                   .contiguous();
+  return pack(context, delta);
+}
+
+void apply_lora_delta(
+    ContextLinear& context,
+    const at::Tensor& lora_a,
+    const at::Tensor& lora_b,
+    double alpha) {
+  if (!context.lora_weight_private_) {
+    auto private_weight = context.at_weight_.clone();
+    context.weight_packed_.init(
+        context.weight_packed_.get_desc(), private_weight.data_ptr());
+    context.at_weight_ = std::move(private_weight);
+    context.lora_weight_private_ = true;
+  }
+  context.at_weight_.add_(packed_lora_delta(context, lora_a, lora_b, alpha));
+}
+
+void remove_lora_delta(
+    ContextLinear& context,
+    const at::Tensor& lora_a,
+    const at::Tensor& lora_b,
+    double alpha) {
+  TORCH_CHECK(
+      context.lora_weight_private_,
+      "lora delta: no adapter has been applied to this context");
+  context.at_weight_.sub_(packed_lora_delta(context, lora_a, lora_b, alpha));
+}
+
 at::Tensor unpack(ContextLinear& context, const at::Tensor& tensor) {
   auto dtype = get_mkldnn_dtype(tensor.scalar_type());
   auto expected_desc = context.weight_packed_.get_desc().to_type(dtype);
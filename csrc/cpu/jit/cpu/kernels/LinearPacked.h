@@ -88,6 +88,17 @@ at::Tensor linear_mul_add_run(
     const at::Tensor& to_add,
     const c10::intrusive_ptr<LinearOpContext>& op_context);
 
+// Run packed linear with an arbitrary epilogue: each entry of `epilogue`
+// names either a parameterless eltwise post op (same names as the unary
+// fusion set, e.g. "relu", "swish", "gelu_tanh") or a binary "add"/"mul"
+// step that consumes the next tensor from `extra_inputs`. The whole chain
+// executes as one oneDNN post-op sequence on the inner product.
+at::Tensor linear_epilogue_run(
+    const at::Tensor& input,
+    const std::vector<std::string>& epilogue,
+    const std::vector<at::Tensor>& extra_inputs,
+    const c10::intrusive_ptr<LinearOpContext>& op_context);
+
 ContextLinear create(
     const at::Tensor& weight,
     const c10::optional<at::Tensor>& bias,
@@ -130,6 +141,25 @@ at::Tensor pack(ContextLinear& context, const at::Tensor& tensor);
 // Unpack given tensor to same format with original weight format
 at::Tensor unpack(ContextLinear& context, const at::Tensor& tensor);
 
+// Merge (or undo the merge of) a LoRA adapter straight into the packed
+// weight image: the rank-r delta alpha * lora_b @ lora_a is computed,
+// reordered once into the blocked layout and added to (subtracted from)
+// the packed weight in place — an O(r*N) hot swap with no re-prepack.
+// The first apply replaces a possibly shared packed image with a private
+// copy. remove must be called with the same factors and alpha that were
+// applied; like any merge/unmerge in floating point it restores the
+// weight up to rounding.
+void apply_lora_delta(
+    ContextLinear& context,
+    const at::Tensor& lora_a,
+    const at::Tensor& lora_b,
+    double alpha);
+void remove_lora_delta(
+    ContextLinear& context,
+    const at::Tensor& lora_a,
+    const at::Tensor& lora_b,
+    double alpha);
+
 } // namespace linear
 } // namespace detail
 } // namespace cpu
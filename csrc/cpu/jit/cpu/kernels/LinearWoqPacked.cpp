@@ -1,6 +1,7 @@
 #ifdef USE_LIBXSMM
 #include "LinearWoqPacked.h"
 #include <ideep.hpp>
+#include <cstdlib>
 #include "aten/Linear.h"
 #include "aten/WeightPack.h"
 #include "csrc/cpu/tpp/woq/tla.h"
@@ -178,6 +179,90 @@ at::Tensor woq_linear_run(
   return op_context->run(input);
 }
 
+// ---- Persistent dequantized-weight cache ----
+// The 2D plain-weight fallback of the WOQ GEMM dequantizes the whole weight
+// to the compute dtype on every forward call. Cache that image keyed by
+// (weight data ptr, group size, ISA level) so it is materialized once --
+// at prepack time for the common case -- and reused by run() afterwards.
+// The 4D blocked TPP path keeps dequant fused inside the tiled GEMM and
+// bypasses the cache. Entries stay alive for the process lifetime, bounded
+// by the number of distinct prepacked weights.
+
+#define LOWP_MODE_FP16 1
+#define LOWP_MODE_BF16 2
+#define LOWP_MODE_INT8 3
+
+namespace {
+
+bool can_use_dequant_weight_cache(const ContextLinearWoq& context) {
+  // NF4/FP4 need the lookup-table mapping of the GEMM kernel and GPTQ
+  // act-order shuffles input channels; leave both to the fallback.
+  return context.at_weight_.dim() == 2 &&
+      context.weight_dtype_ != WOQ_DTYPE_NF4 &&
+      context.weight_dtype_ != WOQ_DTYPE_FP4 && !context.g_idx_.has_value() &&
+      (context.lowp_mode_ == LOWP_MODE_FP16 ||
+       context.lowp_mode_ == LOWP_MODE_BF16);
+}
+
+at::Tensor dequantize_plain_weight(const ContextLinearWoq& context) {
+  auto& qw = context.at_weight_;
+  int64_t N = qw.size(0);
+  auto compute_dtype =
+      context.lowp_mode_ == LOWP_MODE_FP16 ? at::kHalf : at::kBFloat16;
+  auto scale = context.scales_list_[0].unsqueeze(-1);
+  at::Tensor zp;
+  if (context.zero_points_list_[0].defined()) {
+    zp = context.zero_points_list_[0].unsqueeze(-1);
+  }
+  at::Tensor w_float;
+  if (context.is_4bit_) {
+    using namespace at::indexing;
+    auto w_int8 =
+        at::empty({N, qw.size(1) * 2}, qw.options().dtype(at::kByte));
+    w_int8.index({Slice(), Slice(None, None, 2)}).copy_(qw.bitwise_and(0xf));
+    w_int8.index({Slice(), Slice(1, None, 2)})
+        .copy_(qw.bitwise_right_shift(4));
+    w_float = w_int8.to(at::kFloat);
+  } else {
+    w_float = qw.to(at::kFloat);
+  }
+  at::Tensor dqw;
+  if (context.group_size_ > 0) {
+    int64_t num_blocks = scale.size(-2);
+    auto w_view = w_float.view({N, num_blocks, -1});
+    dqw = zp.defined() ? (w_view - zp) * scale : w_view * scale;
+    dqw = dqw.view({N, -1});
+  } else {
+    dqw = zp.defined() ? (w_float - zp) * scale : w_float * scale;
+  }
+  int64_t K = context.weight_shape_[1];
+  if (dqw.size(1) != K) {
+    TORCH_CHECK(
+        K < dqw.size(1), "WOQ Linear: unexpected weight shape for dequant");
+    dqw = dqw.narrow(1, 0, K);
+  }
+  return dqw.to(compute_dtype).contiguous();
+}
+
+// ---- Dual-path prepack for INT8 compute mode ----
+// Prefill is compute-bound and wants the INT8 VNNI/AMX image; decode is
+// bandwidth-bound and runs faster on the BF16-compute image, which also
+// skips activation quantization. When enabled, the op context keeps both
+// packed forms and run() picks per call based on M. Costs one extra copy
+// of the packed weight, so it is opt-in.
+#define WOQ_DECODE_M_THRESHOLD 32
+
+bool dual_lowp_prepack_enabled() {
+  auto* env = std::getenv("IPEX_WOQ_DUAL_LOWP_PREPACK");
+  return env != nullptr && std::strtol(env, nullptr, 10) != 0;
+}
+
+bool use_decode_weight(const ContextLinearWoq& context, int64_t M) {
+  return context.at_weight_decode_.has_value() && M < WOQ_DECODE_M_THRESHOLD;
+}
+
+} // namespace
+
 ContextLinearWoq create(
     at::Tensor& weight,
     int64_t weight_dtype,
@@ -194,18 +279,28 @@ ContextLinearWoq create(
   int64_t N = weight_shape[0];
   int64_t K = weight_shape[1];
   bool is_4bit =
-      (weight_dtype == WOQ_DTYPE_INT4 || weight_dtype == WOQ_DTYPE_NF4);
+      (weight_dtype == WOQ_DTYPE_INT4 || weight_dtype == WOQ_DTYPE_NF4 ||
+       weight_dtype == WOQ_DTYPE_FP4);
   // GPTQ with act-order
   // Shuffle weight along ic to make channels contiguous in group
+  at::Tensor pack_src = weight;
   if (is_4bit && group_size > 0 && g_idx.has_value()) {
     // Shuffle weight along ic to make channels contiguous in group
-    auto shuffled_weight = woq_shuffle_tensor_by_group_idx</* is_4bit */ true>(
+    pack_src = woq_shuffle_tensor_by_group_idx</* is_4bit */ true>(
         weight, weight_shape, g_idx.value(), group_size);
-    packed_weight = woq_linear_pack_weight(
-        shuffled_weight, weight_dtype, weight_shape, group_size, lowp_mode);
-  } else {
-    packed_weight = woq_linear_pack_weight(
-        weight, weight_dtype, weight_shape, group_size, lowp_mode);
+  }
+  packed_weight = woq_linear_pack_weight(
+      pack_src, weight_dtype, weight_shape, group_size, lowp_mode);
+  // Dual-path prepack: also keep a BF16-compute image for decode if the
+  // primary image is packed for INT8 compute.
+  c10::optional<at::Tensor> weight_decode = c10::nullopt;
+  if (packed_weight.dim() == 4 && lowp_mode == LOWP_MODE_INT8 &&
+      dual_lowp_prepack_enabled()) {
+    auto decode_packed = woq_linear_pack_weight(
+        pack_src, weight_dtype, weight_shape, group_size, LOWP_MODE_BF16);
+    if (decode_packed.dim() == 4) {
+      weight_decode = c10::make_optional(std::move(decode_packed));
+    }
   }
   auto packed_shape = packed_weight.sizes();
   // If OC is not a multiple of BLOCK_N, it may be padded.
@@ -236,7 +331,7 @@ ContextLinearWoq create(
           at::pad(bias.value(), {0, padded_N - N}, "constant", 0.f);
       bias_padded = c10::make_optional(bias_tensor_padded);
     }
-    return ContextLinearWoq(
+    auto context = ContextLinearWoq(
         std::move(packed_weight),
         weight_dtype,
         std::move(weight_shape),
@@ -247,12 +342,19 @@ ContextLinearWoq create(
         group_size,
         lowp_mode,
         act_quant_mode);
+    context.at_weight_decode_ = std::move(weight_decode);
+    if (can_use_dequant_weight_cache(context)) {
+      // Materialize the compute-dtype weight image once at prepack time.
+      context.at_dequant_weight_ =
+          c10::make_optional(dequantize_plain_weight(context));
+    }
+    return context;
   }
   c10::optional<at::Tensor> zero_points_float = c10::nullopt;
   if (zero_points.has_value() && zero_points.value().defined()) {
     zero_points_float = c10::make_optional(zero_points.value().to(c10::kFloat));
   }
-  return ContextLinearWoq(
+  auto context = ContextLinearWoq(
       std::move(packed_weight),
       weight_dtype,
       std::move(weight_shape),
@@ -263,6 +365,13 @@ ContextLinearWoq create(
       group_size,
       lowp_mode,
       act_quant_mode);
+  context.at_weight_decode_ = std::move(weight_decode);
+  if (can_use_dequant_weight_cache(context)) {
+    // Materialize the compute-dtype weight image once at prepack time.
+    context.at_dequant_weight_ =
+        c10::make_optional(dequantize_plain_weight(context));
+  }
+  return context;
 }
 
 static at::Tensor _shuffle_input_channels_if_needed(
@@ -294,15 +403,36 @@ at::Tensor run(ContextLinearWoq& context, const at::Tensor& input) {
   auto input_ = input.contiguous();
   // handle GPTQ with act-order
   input_ = _shuffle_input_channels_if_needed(context, input_);
+  if (context.at_dequant_weight_.has_value()) {
+    // Plain 2D weight: the GEMM fallback would dequantize the whole weight
+    // on every call. Use the compute-dtype image cached on the context.
+    auto& dqw = context.at_dequant_weight_.value();
+    constexpr size_t fp16_idx = 1, bf16_idx = 2;
+    auto& bias = context.bias_list_
+        [dqw.scalar_type() == at::kHalf ? fp16_idx : bf16_idx];
+    auto res = at::linear(
+        input_.to(dqw.scalar_type()),
+        dqw,
+        bias.defined() ? c10::optional<at::Tensor>(bias) : c10::nullopt);
+    res = res.to(input.scalar_type());
+    if (res.size(-1) != context.weight_shape_[0]) {
+      int64_t N = context.weight_shape_[0];
+      return at::narrow(res, /*dim*/ -1, /*start*/ 0, /*end*/ N);
+    }
+    return res;
+  }
+  // Dual-path prepack: decode-sized batches take the BF16-compute image.
+  int64_t M = input_.numel() / input_.size(input_.dim() - 1);
+  bool decode_path = use_decode_weight(context, M);
   auto res = woq_linear_kernel(
       input_,
-      context.at_weight_,
+      decode_path ? context.at_weight_decode_.value() : context.at_weight_,
       context.weight_dtype_,
       context.scales_list_,
       context.zero_points_list_,
       context.bias_list_,
       context.group_size_,
-      context.lowp_mode_,
+      decode_path ? LOWP_MODE_BF16 : context.lowp_mode_,
       context.act_quant_mode_);
   if (res.size(-1) != context.weight_shape_[0]) {
     int64_t N = context.weight_shape_[0];
@@ -330,9 +460,11 @@ at::Tensor run_eltwise(
   auto input_ = input.contiguous();
   // handle GPTQ with act-order
   input_ = _shuffle_input_channels_if_needed(context, input_);
+  int64_t M = input_.numel() / input_.size(input_.dim() - 1);
+  bool decode_path = use_decode_weight(context, M);
   return woq_linear_eltwise_kernel(
       input_,
-      context.at_weight_,
+      decode_path ? context.at_weight_decode_.value() : context.at_weight_,
       context.weight_dtype_,
       context.scales_list_,
       context.zero_points_list_,
@@ -341,7 +473,7 @@ at::Tensor run_eltwise(
       scalars,
       algorithm,
       context.group_size_,
-      context.lowp_mode_,
+      decode_path ? LOWP_MODE_BF16 : context.lowp_mode_,
       context.act_quant_mode_);
 }
 
@@ -362,15 +494,17 @@ at::Tensor run_add(
   auto input_ = input.contiguous();
   // handle GPTQ with act-order
   input_ = _shuffle_input_channels_if_needed(context, input_);
+  int64_t M = input_.numel() / input_.size(input_.dim() - 1);
+  bool decode_path = use_decode_weight(context, M);
   return woq_linear_add_kernel(
       input_,
-      context.at_weight_,
+      decode_path ? context.at_weight_decode_.value() : context.at_weight_,
       context.weight_dtype_,
       context.scales_list_,
       context.zero_points_list_,
       context.bias_list_,
       context.group_size_,
-      context.lowp_mode_,
+      decode_path ? LOWP_MODE_BF16 : context.lowp_mode_,
       others,
       context.act_quant_mode_);
 }
@@ -392,15 +526,17 @@ at::Tensor run_add_add(
   auto input_ = input.contiguous();
   // handle GPTQ with act-order
   input_ = _shuffle_input_channels_if_needed(context, input_);
+  int64_t M = input_.numel() / input_.size(input_.dim() - 1);
+  bool decode_path = use_decode_weight(context, M);
   return woq_linear_add_add_kernel(
       input_,
-      context.at_weight_,
+      decode_path ? context.at_weight_decode_.value() : context.at_weight_,
       context.weight_dtype_,
       context.scales_list_,
       context.zero_points_list_,
       context.bias_list_,
       context.group_size_,
-      context.lowp_mode_,
+      decode_path ? LOWP_MODE_BF16 : context.lowp_mode_,
       others,
       context.act_quant_mode_);
 }
@@ -10,6 +10,7 @@
 #include <limits>
 
 #include <ideep.hpp>
+#include "RooflineCounters.h"
 #include "ideep/IDeepConversions.h"
 #include "mkl.h"
 #include "utils/onednn_utils.h"
@@ -216,6 +217,12 @@ at::Tensor bmm_impl(
     mkl_fp32_bmm_impl(tensor1_, tensor2_, output, dst_coeff);
   }
 
+  IPEX_ROOFLINE_RECORD(
+      "matmul",
+      roofline::tensor_bytes(tensor1) + roofline::tensor_bytes(tensor2) +
+          roofline::tensor_bytes(output),
+      2 * static_cast<uint64_t>(output.numel()) *
+          tensor1.size(tensor1.dim() - 1));
   return output;
 }
 
@@ -281,7 +288,7 @@ at::Tensor dil_matmul_div(
         tensor1,
         tensor2,
         out,
-        ideep::attr_t(torch_ipex::fpmath_mode),
+        ideep::attr_t(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::MATMUL)),
         {},
         scale);
   } else {
@@ -304,7 +311,7 @@ at::Tensor dil_bmm_add(
 
     auto op_attr = ideep::attr_t::fuse_binary(
         dnnl::algorithm::binary_add, onednn_input.get_desc());
-    op_attr.set_fpmath_mode(torch_ipex::fpmath_mode);
+    op_attr.set_fpmath_mode(torch_ipex::get_fpmath_mode(torch_ipex::FpMathOpCategory::MATMUL));
     return bmm_impl(
         batch1, batch2, at::Tensor(), op_attr, {onednn_input}, 1.0f);
   } else {
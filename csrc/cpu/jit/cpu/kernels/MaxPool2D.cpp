@@ -142,10 +142,10 @@ at::Tensor pooling_impl(
   if (is_channels_last) {
     return output;
   } else {
-    return mkldnn_to_dense(new_with_itensor_mkldnn(
+    return dense_view_from_itensor(
         std::move(mkldnn_output),
         c10::optTypeMetaToScalarType(input.options().dtype_opt()),
-        input.options().device_opt()));
+        input.options().device_opt());
   }
 }
 
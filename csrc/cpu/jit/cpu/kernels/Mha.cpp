@@ -1,5 +1,6 @@
 #include "Mha.h"
 #include "Matmul.h"
+#include "RooflineCounters.h"
 #include "Softmax.h"
 #include "aten/AddSoftmax.h"
 #include "aten/DivSoftmax.h"
@@ -220,7 +221,14 @@ at::Tensor dil_bert_flash_mha(
     const int64_t& headSize) {
   RECORD_FUNCTION("dil_bert_flash_mha", c10::ArrayRef<c10::IValue>({}));
   auto _dim_per_head = dim_per_head.to<float>();
-  return bert_flash_mha(qkv, rel_kv, num_head, headSize, _dim_per_head);
+  auto output = bert_flash_mha(qkv, rel_kv, num_head, headSize, _dim_per_head);
+  // Two GEMMs per head (QK^T and PV), each 2 * S * S * headSize flops.
+  IPEX_ROOFLINE_RECORD(
+      "flash_mha",
+      roofline::tensor_bytes(qkv) + roofline::tensor_bytes(output),
+      4 * static_cast<uint64_t>(qkv.size(0)) * num_head * qkv.size(1) *
+          qkv.size(1) * headSize);
+  return output;
 }
 
 /**
@@ -237,12 +245,14 @@ at::Tensor dil_sd_flash_mha(
     const int64_t& num_head) {
   RECORD_FUNCTION("dil_sd_flash_mha_v1", c10::ArrayRef<c10::IValue>({}));
   int64_t headSize = qkv.size(-1) / split_list.size() / num_head;
-  if (!scale.isNone()) {
-    return sd_flash_mha(qkv, num_head, headSize, scale.toDouble());
-  } else {
-    auto scale_ = 1.f / sqrt(headSize);
-    return sd_flash_mha(qkv, num_head, headSize, scale_);
-  }
+  auto scale_ = scale.isNone() ? 1. / sqrt(headSize) : scale.toDouble();
+  auto output = sd_flash_mha(qkv, num_head, headSize, scale_);
+  IPEX_ROOFLINE_RECORD(
+      "flash_mha",
+      roofline::tensor_bytes(qkv) + roofline::tensor_bytes(output),
+      4 * static_cast<uint64_t>(qkv.size(0)) * num_head * qkv.size(1) *
+          qkv.size(1) * headSize);
+  return output;
 }
 
 /**
@@ -259,13 +269,137 @@ at::Tensor dil_sd_flash_mha(
     const int64_t& num_head) {
   RECORD_FUNCTION("dil_sd_flash_mha_v2", c10::ArrayRef<c10::IValue>({}));
   int64_t headSize = query.size(-1) / num_head;
-  if (!scale.isNone()) {
-    return sd_flash_mha(
-        query, key, value, num_head, headSize, scale.toDouble());
-  } else {
-    auto scale_ = 1.f / sqrt(headSize);
-    return sd_flash_mha(query, key, value, num_head, headSize, scale_);
+  auto scale_ = scale.isNone() ? 1. / sqrt(headSize) : scale.toDouble();
+  auto output = sd_flash_mha(query, key, value, num_head, headSize, scale_);
+  IPEX_ROOFLINE_RECORD(
+      "flash_mha",
+      roofline::tensor_bytes(query) + roofline::tensor_bytes(key) +
+          roofline::tensor_bytes(value) + roofline::tensor_bytes(output),
+      4 * static_cast<uint64_t>(query.size(0)) * num_head * query.size(1) *
+          key.size(1) * headSize);
+  return output;
+}
+
+template <typename T>
+void rotary_embedding_half_kernel(
+    const at::Tensor& x,
+    const at::Tensor& cos,
+    const at::Tensor& sin,
+    at::Tensor& out) {
+  int64_t batchSize = x.size(0);
+  int64_t numHead = x.size(1);
+  int64_t seqLen = x.size(2);
+  int64_t headDim = x.size(3);
+  int64_t half = headDim / 2;
+  const T* x_ptr = x.data_ptr<T>();
+  const T* cos_ptr = cos.data_ptr<T>();
+  const T* sin_ptr = sin.data_ptr<T>();
+  T* out_ptr = out.data_ptr<T>();
+  // cos and sin share their shape and are contiguous; size-1 dims
+  // broadcast over x with a zero stride
+  int64_t cs_stride0 = cos.size(0) == 1 ? 0 : cos.stride(0);
+  int64_t cs_stride1 = cos.size(1) == 1 ? 0 : cos.stride(1);
+  int64_t cs_stride2 = cos.size(2) == 1 ? 0 : cos.stride(2);
+  at::parallel_for(
+      0, batchSize * numHead * seqLen, 1, [&](int64_t begin, int64_t end) {
+        for (const auto i : c10::irange(begin, end)) {
+          int64_t seq_i = i % seqLen;
+          int64_t head_i = (i / seqLen) % numHead;
+          int64_t batch_i = i / (seqLen * numHead);
+          const T* x_row = x_ptr + i * headDim;
+          T* out_row = out_ptr + i * headDim;
+          int64_t cs_off = batch_i * cs_stride0 + head_i * cs_stride1 +
+              seq_i * cs_stride2;
+          const T* cos_row = cos_ptr + cs_off;
+          const T* sin_row = sin_ptr + cs_off;
+#pragma omp simd
+          for (int64_t j = 0; j < half; ++j) {
+            float x1 = static_cast<float>(x_row[j]);
+            float x2 = static_cast<float>(x_row[j + half]);
+            out_row[j] = static_cast<T>(
+                x1 * static_cast<float>(cos_row[j]) -
+                x2 * static_cast<float>(sin_row[j]));
+            out_row[j + half] = static_cast<T>(
+                x2 * static_cast<float>(cos_row[j + half]) +
+                x1 * static_cast<float>(sin_row[j + half]));
+          }
+        }
+      });
+}
+
+/**
+ * The rewrite-time filter guarantees the rotate_half structure (two
+ * half slices, neg, cat at the last dim) has already been folded into
+ * this op; the shape conditions below pick the single-pass kernel and
+ * anything unusual (non-contiguous input, dtype-mismatched tables,
+ * odd head size) falls back to the unfused math.
+ **/
+at::Tensor dil_rotary_embedding_half(
+    const at::Tensor& x,
+    const at::Tensor& cos,
+    const at::Tensor& sin) {
+  RECORD_FUNCTION("dil_rotary_embedding_half", c10::ArrayRef<c10::IValue>({}));
+  bool use_fast_path = x.dim() == 4 && x.is_contiguous() &&
+      x.size(-1) % 2 == 0 && cos.dim() == 4 && cos.is_contiguous() &&
+      sin.is_contiguous() && cos.sizes() == sin.sizes() &&
+      cos.size(3) == x.size(3) && cos.scalar_type() == x.scalar_type() &&
+      sin.scalar_type() == x.scalar_type();
+  if (use_fast_path) {
+    for (int64_t i = 0; i < 3; ++i) {
+      if (cos.size(i) != 1 && cos.size(i) != x.size(i)) {
+        use_fast_path = false;
+        break;
+      }
+    }
+  }
+  if (use_fast_path) {
+    auto out = at::empty_like(x);
+    if (x.scalar_type() == at::kFloat) {
+      rotary_embedding_half_kernel<float>(x, cos, sin, out);
+      return out;
+    } else if (x.scalar_type() == at::kBFloat16) {
+      rotary_embedding_half_kernel<at::BFloat16>(x, cos, sin, out);
+      return out;
+    }
+  }
+  int64_t half = x.size(-1) / 2;
+  auto x1 = x.slice(-1, 0, half);
+  auto x2 = x.slice(-1, half);
+  return at::add(
+      at::mul(x, cos), at::mul(at::cat({at::neg(x2), x1}, -1), sin));
+}
+
+at::Tensor dil_repeat_kv(
+    const at::Tensor& hidden_states,
+    const at::IntArrayRef& expand_list) {
+  RECORD_FUNCTION("dil_repeat_kv", c10::ArrayRef<c10::IValue>({}));
+  int64_t n_rep = expand_list[2];
+  if (n_rep == 1) {
+    return hidden_states;
+  }
+  int64_t batchSize = hidden_states.size(0);
+  int64_t kvHead = hidden_states.size(1);
+  int64_t seqLen = hidden_states.size(2);
+  int64_t headDim = hidden_states.size(3);
+  if (hidden_states.dim() != 4 || !hidden_states.is_contiguous()) {
+    // guarded at rewrite time; kept for safety
+    return hidden_states.unsqueeze(2)
+        .expand({batchSize, kvHead, n_rep, seqLen, headDim})
+        .reshape({batchSize, kvHead * n_rep, seqLen, headDim});
   }
+  auto out = at::empty(
+      {batchSize, kvHead * n_rep, seqLen, headDim}, hidden_states.options());
+  // dtype-agnostic: every repeated head is one contiguous block
+  int64_t blockBytes = seqLen * headDim * hidden_states.element_size();
+  const char* src = static_cast<const char*>(hidden_states.data_ptr());
+  char* dst = static_cast<char*>(out.data_ptr());
+  at::parallel_for(
+      0, batchSize * kvHead * n_rep, 1, [&](int64_t begin, int64_t end) {
+        for (const auto i : c10::irange(begin, end)) {
+          memcpy(dst + i * blockBytes, src + (i / n_rep) * blockBytes, blockBytes);
+        }
+      });
+  return out;
 }
 
 template <typename T>
@@ -88,6 +88,26 @@ at::Tensor dil_sd_flash_mha(
     const at::IValue& scale,
     const int64_t& num_head);
 
+/**
+ * Computes x * cos + rotate_half(x) * sin in one pass, where
+ * rotate_half(x) = cat(-x[..., d/2:], x[..., :d/2], -1). This is the
+ * rotary position embedding formulation used by the Llama family.
+ */
+at::Tensor dil_rotary_embedding_half(
+    const at::Tensor& x,
+    const at::Tensor& cos,
+    const at::Tensor& sin);
+
+/**
+ * Materializes the grouped-query repeat of the key/value heads
+ * (unsqueeze + expand + reshape) with one contiguous copy. The
+ * "expand_list" carries the five expanded dims; its third entry is the
+ * repeat factor n_rep.
+ */
+at::Tensor dil_repeat_kv(
+    const at::Tensor& hidden_states,
+    const at::IntArrayRef& expand_list);
+
 template <typename T>
 std::vector<at::Tensor> dil_mat_split(
     const at::Tensor& qkv,
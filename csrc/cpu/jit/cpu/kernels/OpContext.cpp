@@ -5,10 +5,44 @@
 #include "LinearMKLPacked.h"
 #include "LinearPacked.h"
 #include "LinearWoqPacked.h"
+#include "OpContextStats.h"
+#include "RooflineCounters.h"
 
 namespace torch_ipex {
 namespace cpu {
 
+// Probe placed in the forward run() methods to collect optional
+// per-context runtime statistics; a no-op unless collection is enabled.
+// M is the GEMM rows for linear-like ops and the batch size for
+// convolutions.
+#define IPEX_OP_CONTEXT_STATS_PROBE(kind, m) \
+  op_context_stats::ScopedProbe stats_probe_( \
+      this, kind, m, op_context_.at_weight_.sizes())
+
+namespace {
+
+// Modeled direct-convolution FLOPs: every output element takes one MAC
+// per input channel (within its group) per kernel tap, so
+// 2 * out.numel() * weight.numel() / out_channels covers any spatial
+// rank and grouped convolutions alike.
+uint64_t conv_flops(const at::Tensor& output, const at::Tensor& weight) {
+  if (weight.numel() == 0 || weight.size(0) == 0) {
+    return 0;
+  }
+  return 2 * static_cast<uint64_t>(output.numel()) *
+      static_cast<uint64_t>(weight.numel() / weight.size(0));
+}
+
+// Modeled GEMM FLOPs for linear-like ops: 2 * M * weight.numel() with
+// M the number of input rows.
+uint64_t linear_flops(const at::Tensor& input, const at::Tensor& weight) {
+  int64_t m = input.numel() / input.size(input.dim() - 1);
+  return 2 * static_cast<uint64_t>(m) *
+      static_cast<uint64_t>(weight.numel());
+}
+
+} // namespace
+
 template <typename T1, typename T2>
 void load_from_ctx_template(T1* self, c10::intrusive_ptr<T2> other) {
   auto& other_ctx_ = other->get_context();
@@ -83,15 +117,32 @@ int64_t ConvolutionOpContext::get_groups() {
 at::Tensor IpexConvolutionOpContext::run(
     const at::Tensor& input,
     const ideep::attr_t& attr) {
-  return torch_ipex::cpu::detail::convolution::run(op_context_, input, attr);
+  IPEX_OP_CONTEXT_STATS_PROBE("convolution", input.size(0));
+  auto output =
+      torch_ipex::cpu::detail::convolution::run(op_context_, input, attr);
+  IPEX_ROOFLINE_RECORD(
+      "convolution",
+      roofline::tensor_bytes(input) +
+          roofline::tensor_bytes(op_context_.at_weight_) +
+          roofline::tensor_bytes(output),
+      conv_flops(output, op_context_.at_weight_));
+  return output;
 }
 
 at::Tensor& IpexConvolutionOpContext::run(
     const at::Tensor& input,
     at::Tensor& accumu,
     const ideep::attr_t& attr) {
-  return torch_ipex::cpu::detail::convolution::run(
+  IPEX_OP_CONTEXT_STATS_PROBE("convolution", input.size(0));
+  auto& output = torch_ipex::cpu::detail::convolution::run(
       op_context_, input, accumu, attr);
+  IPEX_ROOFLINE_RECORD(
+      "convolution",
+      roofline::tensor_bytes(input) +
+          roofline::tensor_bytes(op_context_.at_weight_) +
+          2 * roofline::tensor_bytes(output),
+      conv_flops(output, op_context_.at_weight_));
+  return output;
 }
 
 std::tuple<at::Tensor, at::Tensor, at::Tensor> IpexConvolutionOpContext::
@@ -133,6 +184,9 @@ at::Tensor IpexConvolutionOpContext::get_data_handle() {
 void IpexConvolutionOpContext::load_from_ctx(
     c10::intrusive_ptr<ConvolutionOpContext> other) {
   load_from_ctx_template(this, other);
+  // the copied-in weight is a new version; primitives cached against the
+  // old one must not be served anymore
+  op_context_.invalidate_cached_primitives();
 }
 
 c10::intrusive_ptr<LinearOpContext> IpexLinearOpContext::create_context(
@@ -154,22 +208,50 @@ at::Tensor IpexLinearOpContext::get_data_handle() {
 at::Tensor IpexLinearOpContext::run(
     const at::Tensor& input,
     const ideep::attr_t& attr) {
-  return torch_ipex::cpu::detail::linear::run(op_context_, input, attr);
+  IPEX_OP_CONTEXT_STATS_PROBE(
+      "linear", input.numel() / input.size(input.dim() - 1));
+  auto output = torch_ipex::cpu::detail::linear::run(op_context_, input, attr);
+  IPEX_ROOFLINE_RECORD(
+      "linear",
+      roofline::tensor_bytes(input) +
+          roofline::tensor_bytes(op_context_.at_weight_) +
+          roofline::tensor_bytes(output),
+      linear_flops(input, op_context_.at_weight_));
+  return output;
 }
 
 at::Tensor& IpexLinearOpContext::run(
     const at::Tensor& input,
     at::Tensor& accumu,
     const ideep::attr_t& attr) {
-  return torch_ipex::cpu::detail::linear::run(op_context_, input, accumu, attr);
+  IPEX_OP_CONTEXT_STATS_PROBE(
+      "linear", input.numel() / input.size(input.dim() - 1));
+  auto& output =
+      torch_ipex::cpu::detail::linear::run(op_context_, input, accumu, attr);
+  IPEX_ROOFLINE_RECORD(
+      "linear",
+      roofline::tensor_bytes(input) +
+          roofline::tensor_bytes(op_context_.at_weight_) +
+          2 * roofline::tensor_bytes(output),
+      linear_flops(input, op_context_.at_weight_));
+  return output;
 }
 
 at::Tensor IpexLinearOpContext::run_with_binary_post_op(
     const at::Tensor& input,
     const std::vector<ideep::tensor>& post_op_src,
     const ideep::attr_t& attr) {
-  return torch_ipex::cpu::detail::linear::run(
+  IPEX_OP_CONTEXT_STATS_PROBE(
+      "linear", input.numel() / input.size(input.dim() - 1));
+  auto output = torch_ipex::cpu::detail::linear::run(
       op_context_, input, post_op_src, attr);
+  IPEX_ROOFLINE_RECORD(
+      "linear",
+      roofline::tensor_bytes(input) +
+          roofline::tensor_bytes(op_context_.at_weight_) +
+          roofline::tensor_bytes(output),
+      linear_flops(input, op_context_.at_weight_));
+  return output;
 }
 
 std::tuple<at::Tensor, at::Tensor, at::Tensor> IpexLinearOpContext::
@@ -206,6 +288,22 @@ void IpexLinearOpContext::load_from_ctx(
   load_from_ctx_template(this, other);
 }
 
+void IpexLinearOpContext::apply_lora_delta(
+    const at::Tensor& lora_a,
+    const at::Tensor& lora_b,
+    double alpha) {
+  torch_ipex::cpu::detail::linear::apply_lora_delta(
+      op_context_, lora_a, lora_b, alpha);
+}
+
+void IpexLinearOpContext::remove_lora_delta(
+    const at::Tensor& lora_a,
+    const at::Tensor& lora_b,
+    double alpha) {
+  torch_ipex::cpu::detail::linear::remove_lora_delta(
+      op_context_, lora_a, lora_b, alpha);
+}
+
 c10::intrusive_ptr<ConvTransposeOpContext> IpexConvTransposeOpContext::
     create_context(
         at::Tensor&& weight,
@@ -265,12 +363,16 @@ at::Tensor IpexLinearMKLOpContext::pack(const at::Tensor& tensor) {
 }
 
 at::Tensor IpexLinearMKLOpContext::run(const at::Tensor& input) {
+  IPEX_OP_CONTEXT_STATS_PROBE(
+      "mkl_sgemm", input.numel() / input.size(input.dim() - 1));
   return torch_ipex::cpu::detail::mkl_sgemm::run(op_context_, input);
 }
 
 at::Tensor& IpexLinearMKLOpContext::run(
     const at::Tensor& input,
     at::Tensor& accumu) {
+  IPEX_OP_CONTEXT_STATS_PROBE(
+      "mkl_sgemm", input.numel() / input.size(input.dim() - 1));
   return torch_ipex::cpu::detail::mkl_sgemm::run(op_context_, input, accumu);
 }
 
@@ -298,6 +400,7 @@ void IpexLinearMKLOpContext::load_from_ctx(
 at::Tensor IpexConvTransposeOpContext::run(
     const at::Tensor& input,
     const ideep::attr_t& attr) {
+  IPEX_OP_CONTEXT_STATS_PROBE("conv_transpose", input.size(0));
   return torch_ipex::cpu::detail::conv_transpose::run(op_context_, input, attr);
 }
 
@@ -305,6 +408,7 @@ at::Tensor& IpexConvTransposeOpContext::run(
     const at::Tensor& input,
     at::Tensor& accumu,
     const ideep::attr_t& attr) {
+  IPEX_OP_CONTEXT_STATS_PROBE("conv_transpose", input.size(0));
   return torch_ipex::cpu::detail::conv_transpose::run(
       op_context_, input, accumu, attr);
 }
@@ -396,6 +500,8 @@ at::Tensor IpexWoqLinearOpContext::get_data_handle() {
 }
 
 at::Tensor IpexWoqLinearOpContext::run(const at::Tensor& input) {
+  IPEX_OP_CONTEXT_STATS_PROBE(
+      "woq_linear", input.numel() / input.size(input.dim() - 1));
   return torch_ipex::cpu::detail::woq_linear::run(op_context_, input);
 }
 
@@ -404,6 +510,8 @@ at::Tensor IpexWoqLinearOpContext::run_eltwise(
     const c10::string_view& post_op,
     const torch::List<c10::optional<at::Scalar>>& scalars,
     const c10::optional<c10::string_view>& algorithm) {
+  IPEX_OP_CONTEXT_STATS_PROBE(
+      "woq_linear", input.numel() / input.size(input.dim() - 1));
   return torch_ipex::cpu::detail::woq_linear::run_eltwise(
       op_context_, input, post_op, scalars, algorithm);
 }
@@ -411,6 +519,8 @@ at::Tensor IpexWoqLinearOpContext::run_eltwise(
 at::Tensor IpexWoqLinearOpContext::run_add(
     const at::Tensor& input,
     const std::vector<at::Tensor>& others) {
+  IPEX_OP_CONTEXT_STATS_PROBE(
+      "woq_linear", input.numel() / input.size(input.dim() - 1));
   return torch_ipex::cpu::detail::woq_linear::run_add(
       op_context_, input, others);
 }
@@ -418,6 +528,8 @@ at::Tensor IpexWoqLinearOpContext::run_add(
 at::Tensor IpexWoqLinearOpContext::run_add_add(
     const at::Tensor& input,
     const std::vector<at::Tensor>& others) {
+  IPEX_OP_CONTEXT_STATS_PROBE(
+      "woq_linear", input.numel() / input.size(input.dim() - 1));
   return torch_ipex::cpu::detail::woq_linear::run_add_add(
       op_context_, input, others);
 }
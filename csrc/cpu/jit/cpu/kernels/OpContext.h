@@ -219,6 +219,17 @@ class LinearOpContext : public torch::jit::CustomClassHolder {
   //         new_ctx = create_ctx(state_dict[weight])
   //         self.ctx.load_from_ctx(new_ctx)
   virtual void load_from_ctx(c10::intrusive_ptr<LinearOpContext> other) = 0;
+
+  // Merge / unmerge a LoRA adapter (alpha * lora_b @ lora_a) directly on
+  // the packed weight image, without re-running weight prepack
+  virtual void apply_lora_delta(
+      const at::Tensor& lora_a,
+      const at::Tensor& lora_b,
+      double alpha) = 0;
+  virtual void remove_lora_delta(
+      const at::Tensor& lora_a,
+      const at::Tensor& lora_b,
+      double alpha) = 0;
 };
 
 class IpexLinearOpContext final : public LinearOpContext {
@@ -270,6 +281,15 @@ class IpexLinearOpContext final : public LinearOpContext {
 
   virtual void load_from_ctx(
       c10::intrusive_ptr<LinearOpContext> other) override;
+
+  virtual void apply_lora_delta(
+      const at::Tensor& lora_a,
+      const at::Tensor& lora_b,
+      double alpha) override;
+  virtual void remove_lora_delta(
+      const at::Tensor& lora_a,
+      const at::Tensor& lora_b,
+      double alpha) override;
 };
 
 using SerializationTypeMKLPrePack =
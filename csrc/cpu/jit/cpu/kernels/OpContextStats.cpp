@@ -0,0 +1,89 @@
+#include "OpContextStats.h"
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <x86intrin.h>
+#endif
+
+namespace torch_ipex {
+namespace cpu {
+namespace op_context_stats {
+
+namespace {
+
+std::atomic<bool> g_enabled{false};
+
+std::mutex stats_mutex;
+std::unordered_map<const void*, Record> stats;
+
+inline uint64_t read_cycles() {
+#if defined(__x86_64__) || defined(_M_X64)
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+} // namespace
+
+bool enabled() {
+  return g_enabled.load(std::memory_order_relaxed);
+}
+
+void set_enabled(bool enable) {
+  g_enabled.store(enable, std::memory_order_relaxed);
+}
+
+void reset() {
+  std::lock_guard<std::mutex> lock(stats_mutex);
+  stats.clear();
+}
+
+std::vector<std::pair<uint64_t, Record>> snapshot() {
+  std::vector<std::pair<uint64_t, Record>> result;
+  std::lock_guard<std::mutex> lock(stats_mutex);
+  result.reserve(stats.size());
+  for (auto& kv : stats) {
+    result.emplace_back(reinterpret_cast<uint64_t>(kv.first), kv.second);
+  }
+  return result;
+}
+
+ScopedProbe::ScopedProbe(
+    const void* context,
+    const char* kind,
+    int64_t m,
+    c10::IntArrayRef weight_shape) {
+  if (!enabled()) {
+    return;
+  }
+  context_ = context;
+  kind_ = kind;
+  m_ = m;
+  weight_shape_ = weight_shape;
+  start_cycles_ = read_cycles();
+  active_ = true;
+}
+
+ScopedProbe::~ScopedProbe() {
+  if (!active_) {
+    return;
+  }
+  auto cycles = read_cycles() - start_cycles_;
+  std::lock_guard<std::mutex> lock(stats_mutex);
+  auto& record = stats[context_];
+  if (record.invocations == 0) {
+    record.kind = kind_;
+    record.weight_shape.assign(weight_shape_.begin(), weight_shape_.end());
+  }
+  record.invocations++;
+  record.total_cycles += cycles;
+  record.m_histogram[m_]++;
+}
+
+} // namespace op_context_stats
+} // namespace cpu
+} // namespace torch_ipex
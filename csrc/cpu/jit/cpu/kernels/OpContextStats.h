@@ -0,0 +1,62 @@
+#pragma once
+
+#include <c10/util/ArrayRef.h>
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace torch_ipex {
+namespace cpu {
+namespace op_context_stats {
+
+// Lightweight per-op-context runtime counters: invocations, distribution
+// of the input rows (GEMM M, or batch size for convolutions) and
+// accumulated TSC cycles. Collection is off by default; when disabled,
+// the probes in the op context run() methods cost a single atomic load.
+// Enabled/queried from Python via _enable_op_context_stats /
+// _get_op_context_stats in the CPU module bindings.
+bool enabled();
+void set_enabled(bool enable);
+void reset();
+
+struct Record {
+  std::string kind;
+  std::vector<int64_t> weight_shape;
+  uint64_t invocations = 0;
+  uint64_t total_cycles = 0;
+  // Input rows -> number of calls with that many rows.
+  std::map<int64_t, uint64_t> m_histogram;
+};
+
+// Snapshot of all records, keyed by the op context address, which is
+// stable for the lifetime of the context and matches get_data_handle().
+std::vector<std::pair<uint64_t, Record>> snapshot();
+
+// RAII probe placed in the op context run() methods.
+class ScopedProbe {
+ public:
+  ScopedProbe(
+      const void* context,
+      const char* kind,
+      int64_t m,
+      c10::IntArrayRef weight_shape);
+  ~ScopedProbe();
+
+  ScopedProbe(const ScopedProbe&) = delete;
+  ScopedProbe& operator=(const ScopedProbe&) = delete;
+
+ private:
+  const void* context_ = nullptr;
+  const char* kind_ = nullptr;
+  int64_t m_ = 0;
+  c10::IntArrayRef weight_shape_;
+  uint64_t start_cycles_ = 0;
+  bool active_ = false;
+};
+
+} // namespace op_context_stats
+} // namespace cpu
+} // namespace torch_ipex
@@ -0,0 +1,285 @@
+#include "PackedWeightRegistry.h"
+
+#include <ATen/ATen.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace torch_ipex {
+namespace cpu {
+namespace detail {
+namespace packed_weight_registry {
+
+namespace {
+
+// FNV-1a over the packed bytes. Collisions are resolved with a full byte
+// comparison below, so the hash only needs to spread the keys.
+uint64_t hash_bytes(const void* data, size_t nbytes) {
+  const auto* p = static_cast<const uint8_t*>(data);
+  uint64_t h = 0xcbf29ce484222325ULL;
+  for (size_t i = 0; i < nbytes; ++i) {
+    h = (h ^ p[i]) * 0x100000001b3ULL;
+  }
+  return h;
+}
+
+bool content_equal(const at::Tensor& a, const at::Tensor& b) {
+  return a.scalar_type() == b.scalar_type() && a.sizes().equals(b.sizes()) &&
+      a.nbytes() == b.nbytes() &&
+      std::memcmp(a.data_ptr(), b.data_ptr(), a.nbytes()) == 0;
+}
+
+std::mutex registry_mutex;
+// Hash of the packed bytes -> canonical tensors with that hash. A bucket
+// normally holds a single entry; more only on a hash collision. Entries
+// live for the lifetime of the process, which is bounded by the number of
+// distinct weights, not the number of contexts.
+std::unordered_map<uint64_t, std::vector<at::Tensor>> registry;
+
+} // namespace
+
+bool sharing_enabled() {
+  static const bool enabled = []() {
+    auto* env = std::getenv("IPEX_PACKED_WEIGHT_SHARING");
+    return env != nullptr && std::strtol(env, nullptr, 10) != 0;
+  }();
+  return enabled;
+}
+
+at::Tensor get_or_register(const at::Tensor& packed_weight) {
+  auto candidate = packed_weight.contiguous();
+  auto h = hash_bytes(candidate.data_ptr(), candidate.nbytes());
+  std::lock_guard<std::mutex> lock(registry_mutex);
+  auto& bucket = registry[h];
+  for (auto& canonical : bucket) {
+    if (content_equal(canonical, candidate)) {
+      return canonical;
+    }
+  }
+  bucket.push_back(candidate);
+  return candidate;
+}
+
+namespace {
+
+const char* file_cache_dir() {
+  static const char* dir = std::getenv("IPEX_PACKED_WEIGHT_CACHE_DIR");
+  return dir;
+}
+
+// Content hash of a plain weight plus its pack parameters. Covers the
+// plain bytes, dtype, shape and the caller-provided pack parameters; the
+// packed byte size is appended to the name separately so a layout change
+// (e.g. after a oneDNN upgrade) shows up as a missing entry.
+uint64_t pack_key_hash(
+    const at::Tensor& plain_weight,
+    c10::ArrayRef<int64_t> extra_key) {
+  auto contig = plain_weight.contiguous();
+  uint64_t h = hash_bytes(contig.data_ptr(), contig.nbytes());
+  h = (h ^ static_cast<uint64_t>(contig.scalar_type())) * 0x100000001b3ULL;
+  for (auto s : contig.sizes()) {
+    h = (h ^ static_cast<uint64_t>(s)) * 0x100000001b3ULL;
+  }
+  for (auto v : extra_key) {
+    h = (h ^ static_cast<uint64_t>(v)) * 0x100000001b3ULL;
+  }
+  return h;
+}
+
+#ifndef _WIN32
+std::string file_cache_path(
+    const at::Tensor& plain_weight,
+    c10::ArrayRef<int64_t> extra_key,
+    size_t packed_nbytes) {
+  std::ostringstream path;
+  path << file_cache_dir() << "/ipex_packed_" << std::hex
+       << pack_key_hash(plain_weight, extra_key) << std::dec << "_"
+       << packed_nbytes << ".bin";
+  return path.str();
+}
+#endif
+
+} // namespace
+
+bool file_cache_enabled() {
+  return file_cache_dir() != nullptr;
+}
+
+c10::optional<at::Tensor> load_packed_from_file_cache(
+    const at::Tensor& plain_weight,
+    c10::ArrayRef<int64_t> extra_key,
+    const at::Tensor& packed_template) {
+#ifdef _WIN32
+  // No POSIX stat/mmap on Windows; treat every lookup as a miss.
+  return c10::nullopt;
+#else
+  auto path =
+      file_cache_path(plain_weight, extra_key, packed_template.nbytes());
+  struct stat st;
+  if (stat(path.c_str(), &st) != 0 ||
+      static_cast<size_t>(st.st_size) != packed_template.nbytes()) {
+    return c10::nullopt;
+  }
+  auto mapped = at::from_file(
+      path,
+      /* shared */ true,
+      packed_template.numel(),
+      packed_template.options());
+  return c10::make_optional(mapped.view(packed_template.sizes()));
+#endif
+}
+
+void store_packed_to_file_cache(
+    const at::Tensor& plain_weight,
+    c10::ArrayRef<int64_t> extra_key,
+    const at::Tensor& packed_weight) {
+#ifndef _WIN32
+  auto contig = packed_weight.contiguous();
+  auto path = file_cache_path(plain_weight, extra_key, contig.nbytes());
+  // Write to a process-private temporary file and rename it into place so
+  // concurrent loaders never see a partially written image.
+  auto tmp_path = path + ".tmp." + std::to_string(getpid());
+  {
+    std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      return;
+    }
+    out.write(
+        static_cast<const char*>(contig.data_ptr()),
+        static_cast<std::streamsize>(contig.nbytes()));
+    if (!out) {
+      std::remove(tmp_path.c_str());
+      return;
+    }
+  }
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    std::remove(tmp_path.c_str());
+  }
+#endif
+}
+
+namespace {
+
+#ifndef _WIN32
+// POSIX shm object name (leading slash, no other slashes) for a packed
+// weight. The key is shared with the file cache so the two mechanisms
+// agree on what identifies a packed image.
+std::string shm_object_name(
+    const at::Tensor& plain_weight,
+    c10::ArrayRef<int64_t> extra_key,
+    size_t packed_nbytes) {
+  std::ostringstream name;
+  name << "/ipex_packed_" << std::hex
+       << pack_key_hash(plain_weight, extra_key) << std::dec << "_"
+       << packed_nbytes;
+  return name.str();
+}
+#endif
+
+} // namespace
+
+bool shm_enabled() {
+#ifdef _WIN32
+  // POSIX shared memory is not available on Windows.
+  return false;
+#else
+  static const bool enabled = []() {
+    auto* env = std::getenv("IPEX_PACKED_WEIGHT_SHM");
+    return env != nullptr && std::strtol(env, nullptr, 10) != 0;
+  }();
+  return enabled;
+#endif
+}
+
+c10::optional<at::Tensor> load_packed_from_shm(
+    const at::Tensor& plain_weight,
+    c10::ArrayRef<int64_t> extra_key,
+    const at::Tensor& packed_template) {
+#ifdef _WIN32
+  return c10::nullopt;
+#else
+  auto name =
+      shm_object_name(plain_weight, extra_key, packed_template.nbytes());
+  int fd = shm_open(name.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    return c10::nullopt;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 ||
+      static_cast<size_t>(st.st_size) != packed_template.nbytes()) {
+    close(fd);
+    return c10::nullopt;
+  }
+  size_t nbytes = packed_template.nbytes();
+  void* addr = mmap(nullptr, nbytes, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED) {
+    return c10::nullopt;
+  }
+  // Read-only mapping: oneDNN only reads packed weights at execution, and
+  // a write through any aliasing tensor faults instead of silently
+  // corrupting every attached process.
+  auto mapped = at::from_blob(
+      addr,
+      packed_template.sizes(),
+      [addr, nbytes](void*) { munmap(addr, nbytes); },
+      packed_template.options());
+  return c10::make_optional(std::move(mapped));
+#endif
+}
+
+void store_packed_to_shm(
+    const at::Tensor& plain_weight,
+    c10::ArrayRef<int64_t> extra_key,
+    const at::Tensor& packed_weight) {
+#ifndef _WIN32
+  auto contig = packed_weight.contiguous();
+  auto name = shm_object_name(plain_weight, extra_key, contig.nbytes());
+  // Fill a process-private object and rename it into place (shm objects
+  // are plain files under /dev/shm on Linux) so attaching processes never
+  // see a partially written image.
+  auto tmp_name = name + ".tmp." + std::to_string(getpid());
+  int fd = shm_open(tmp_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (fd < 0) {
+    return;
+  }
+  if (ftruncate(fd, static_cast<off_t>(contig.nbytes())) != 0) {
+    close(fd);
+    shm_unlink(tmp_name.c_str());
+    return;
+  }
+  void* addr = mmap(
+      nullptr, contig.nbytes(), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED) {
+    shm_unlink(tmp_name.c_str());
+    return;
+  }
+  std::memcpy(addr, contig.data_ptr(), contig.nbytes());
+  munmap(addr, contig.nbytes());
+  auto tmp_path = std::string("/dev/shm") + tmp_name;
+  auto path = std::string("/dev/shm") + name;
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    shm_unlink(tmp_name.c_str());
+  }
+#endif
+}
+
+} // namespace packed_weight_registry
+} // namespace detail
+} // namespace cpu
+} // namespace torch_ipex
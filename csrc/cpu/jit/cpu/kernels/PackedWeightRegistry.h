@@ -0,0 +1,87 @@
+#pragma once
+
+#include <ATen/Tensor.h>
+
+namespace torch_ipex {
+namespace cpu {
+namespace detail {
+namespace packed_weight_registry {
+
+// Process-wide content-addressed registry of packed weight tensors.
+// When multiple op contexts prepack identical weights (e.g. several
+// replicas of the same model deserialized in one process), the registry
+// lets them all alias a single canonical copy instead of each holding a
+// private one. Enabled with IPEX_PACKED_WEIGHT_SHARING=1. Shared tensors
+// must be treated as immutable: in-place updates of a shared weight
+// (e.g. training or re-loading different values into an existing
+// context) would be visible to every context aliasing it, so sharing
+// should only be enabled for inference with frozen weights.
+bool sharing_enabled();
+
+// Return the canonical tensor whose content (dtype, shape and bytes)
+// matches `packed_weight`. If no such tensor is registered yet,
+// `packed_weight` itself is registered and returned. Thread-safe.
+at::Tensor get_or_register(const at::Tensor& packed_weight);
+
+// Optional on-disk cache of packed weight images, enabled by pointing
+// IPEX_PACKED_WEIGHT_CACHE_DIR at a writable directory. The first load of
+// a model packs the weights as usual and stores the packed bytes; later
+// loads mmap the stored image and skip the repack, so deserialization is
+// a pointer fixup and the OS pages the weights in lazily. Cache files are
+// keyed by the plain weight content plus the pack parameters, but the
+// packed layout also depends on the oneDNN version and the machine's ISA,
+// so the directory must not be reused across library upgrades or copied
+// between machines; a size mismatch is detected and treated as a miss.
+bool file_cache_enabled();
+
+// Try to mmap a previously stored packed image of `plain_weight`.
+// `extra_key` carries the pack parameters that shape the packed layout
+// (e.g. stride/padding/groups for convolution). On a hit, returns a
+// tensor aliasing the mapped file with the dtype and shape of
+// `packed_template`; on a miss, returns nullopt.
+c10::optional<at::Tensor> load_packed_from_file_cache(
+    const at::Tensor& plain_weight,
+    c10::ArrayRef<int64_t> extra_key,
+    const at::Tensor& packed_template);
+
+// Store the packed image of `plain_weight` for later mmap loads. Writes
+// to a temporary file and renames it so concurrent writers are safe.
+void store_packed_to_file_cache(
+    const at::Tensor& plain_weight,
+    c10::ArrayRef<int64_t> extra_key,
+    const at::Tensor& packed_weight);
+
+// Cross-process sharing of packed weight payloads through named POSIX
+// shared memory, enabled with IPEX_PACKED_WEIGHT_SHM=1. Deployments that
+// run one process per NUMA node (or per core subset) hold identical
+// packed weights in every process; with shm publishing the first process
+// to pack a weight places the packed bytes in a shm object named after
+// the weight content and pack parameters, and every process — including
+// the publisher — attaches the object read-only, so a single physical
+// copy serves all processes and page-cache warmup happens once per host.
+// The same caveats as the file cache apply: the packed layout depends on
+// the oneDNN version and the machine's ISA (a size mismatch is treated as
+// a miss), and the segments outlive the processes — the operator is
+// expected to clean up /dev/shm/ipex_packed_* when the model set changes.
+bool shm_enabled();
+
+// Try to attach the published packed image of `plain_weight` read-only.
+// On a hit, returns a tensor aliasing the shared mapping with the dtype
+// and shape of `packed_template`; on a miss, returns nullopt.
+c10::optional<at::Tensor> load_packed_from_shm(
+    const at::Tensor& plain_weight,
+    c10::ArrayRef<int64_t> extra_key,
+    const at::Tensor& packed_template);
+
+// Publish the packed image of `plain_weight` for other processes to
+// attach. Fills a private temporary shm object and renames it so
+// concurrent publishers are safe.
+void store_packed_to_shm(
+    const at::Tensor& plain_weight,
+    c10::ArrayRef<int64_t> extra_key,
+    const at::Tensor& packed_weight);
+
+} // namespace packed_weight_registry
+} // namespace detail
+} // namespace cpu
+} // namespace torch_ipex
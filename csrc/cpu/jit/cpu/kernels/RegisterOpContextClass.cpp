@@ -7,6 +7,7 @@
 #include "LinearPacked.h"
 #include "LinearWoqPacked.h"
 #include "OpContext.h"
+#include "utils/weight_compress.h"
 
 namespace torch_ipex {
 namespace cpu {
@@ -24,10 +25,15 @@ TORCH_LIBRARY(ipex_prepack, m) {
       .def_pickle(
           [](const c10::intrusive_ptr<ConvolutionOpContext>& op_context)
               -> SerializationTypeConvolutionPrePack { // __getstate__
-            return op_context->unpack();
+            auto state = op_context->unpack();
+            std::get<0>(state) =
+                utils::compress_packed_weight(std::get<0>(state));
+            return state;
           },
           [](SerializationTypeConvolutionPrePack state)
               -> c10::intrusive_ptr<ConvolutionOpContext> { // __setstate__
+            std::get<0>(state) =
+                utils::maybe_decompress_packed_weight(std::get<0>(state));
             return createConvolutionPrePackOpContext(
                 std::move(std::get<0>(state)),
                 std::move(std::get<1>(state)),
@@ -54,10 +60,15 @@ TORCH_LIBRARY(ipex_prepack, m) {
       .def_pickle(
           [](const c10::intrusive_ptr<LinearOpContext>& op_context)
               -> SerializationTypeLinearPrePack { // __getstate__
-            return op_context->unpack();
+            auto state = op_context->unpack();
+            std::get<0>(state) =
+                utils::compress_packed_weight(std::get<0>(state));
+            return state;
           },
           [](SerializationTypeLinearPrePack state)
               -> c10::intrusive_ptr<LinearOpContext> { // __setstate__
+            std::get<0>(state) =
+                utils::maybe_decompress_packed_weight(std::get<0>(state));
             return createLinearPrePackOpContext(
                 std::move(std::get<0>(state)),
                 std::move(std::get<1>(state)),
@@ -70,15 +81,26 @@ TORCH_LIBRARY(ipex_prepack, m) {
       .def("to_public", &torch_ipex::cpu::LinearOpContext::to_public)
       .def(
           "get_data_handle", &torch_ipex::cpu::LinearOpContext::get_data_handle)
-      .def("load_from_ctx", &torch_ipex::cpu::LinearOpContext::load_from_ctx);
+      .def("load_from_ctx", &torch_ipex::cpu::LinearOpContext::load_from_ctx)
+      .def(
+          "apply_lora_delta",
+          &torch_ipex::cpu::LinearOpContext::apply_lora_delta)
+      .def(
+          "remove_lora_delta",
+          &torch_ipex::cpu::LinearOpContext::remove_lora_delta);
   m.class_<MKLOpContext>("MKLOpContext")
       .def_pickle(
           [](const c10::intrusive_ptr<MKLOpContext>& op_context)
               -> SerializationTypeMKLPrePack { // __getstate__
-            return op_context->unpack();
+            auto state = op_context->unpack();
+            std::get<0>(state) =
+                utils::compress_packed_weight(std::get<0>(state));
+            return state;
           },
           [](SerializationTypeMKLPrePack state)
               -> c10::intrusive_ptr<MKLOpContext> { // __setstate__
+            std::get<0>(state) =
+                utils::maybe_decompress_packed_weight(std::get<0>(state));
             return createLinearMKLPrePackOpContext(
                 std::move(std::get<0>(state)),
                 std::move(std::get<1>(state)),
@@ -94,10 +116,15 @@ TORCH_LIBRARY(ipex_prepack, m) {
       .def_pickle(
           [](const c10::intrusive_ptr<ConvTransposeOpContext>& op_context)
               -> SerializationTypeConvTransposePrePack { // __getstate__
-            return op_context->unpack();
+            auto state = op_context->unpack();
+            std::get<0>(state) =
+                utils::compress_packed_weight(std::get<0>(state));
+            return state;
           },
           [](SerializationTypeConvTransposePrePack state)
               -> c10::intrusive_ptr<ConvTransposeOpContext> { // __setstate__
+            std::get<0>(state) =
+                utils::maybe_decompress_packed_weight(std::get<0>(state));
             return createConvTransposePrePackOpContext(
                 std::move(std::get<0>(state)),
                 std::move(std::get<1>(state)),
@@ -126,10 +153,15 @@ TORCH_LIBRARY(ipex_prepack, m) {
       .def_pickle(
           [](const c10::intrusive_ptr<WoqLinearOpContext>& op_context)
               -> SerializationTypeWoqLinearPrePack { // __getstate__
-            return op_context->unpack();
+            auto state = op_context->unpack();
+            std::get<0>(state) =
+                utils::compress_packed_weight(std::get<0>(state));
+            return state;
           },
           [](SerializationTypeWoqLinearPrePack state)
               -> c10::intrusive_ptr<WoqLinearOpContext> { // __setstate__
+            std::get<0>(state) =
+                utils::maybe_decompress_packed_weight(std::get<0>(state));
             return createWoqLinearPrePackOpContext(
                 std::move(std::get<0>(state)), // weight
                 std::move(std::get<1>(state)), // weight dtype
@@ -0,0 +1,54 @@
+#include "RooflineCounters.h"
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+namespace torch_ipex {
+namespace cpu {
+namespace roofline {
+
+namespace {
+
+std::atomic<bool> g_enabled{false};
+
+std::mutex counters_mutex;
+// Keyed by the literal's address; distinct sites use distinct literals.
+std::unordered_map<const char*, Counter> counters;
+
+} // namespace
+
+bool enabled() {
+  return g_enabled.load(std::memory_order_relaxed);
+}
+
+void set_enabled(bool enable) {
+  g_enabled.store(enable, std::memory_order_relaxed);
+}
+
+void reset() {
+  std::lock_guard<std::mutex> lock(counters_mutex);
+  counters.clear();
+}
+
+std::vector<std::pair<std::string, Counter>> snapshot() {
+  std::vector<std::pair<std::string, Counter>> result;
+  std::lock_guard<std::mutex> lock(counters_mutex);
+  result.reserve(counters.size());
+  for (auto& kv : counters) {
+    result.emplace_back(kv.first, kv.second);
+  }
+  return result;
+}
+
+void record(const char* op, uint64_t bytes, uint64_t flops) {
+  std::lock_guard<std::mutex> lock(counters_mutex);
+  auto& counter = counters[op];
+  counter.invocations++;
+  counter.bytes += bytes;
+  counter.flops += flops;
+}
+
+} // namespace roofline
+} // namespace cpu
+} // namespace torch_ipex
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <ATen/Tensor.h>
+#include <c10/macros/Macros.h>
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace torch_ipex {
+namespace cpu {
+namespace roofline {
+
+// Modeled bytes-moved and FLOPs per fused op, accumulated into a table
+// keyed by op name. Unlike op_context_stats (which tracks per-context
+// timing), these counters place each fused kernel on the roofline:
+// arithmetic intensity = flops / bytes tells bandwidth-bound from
+// compute-bound layers without an external profiler. Bytes are modeled
+// from the logical tensor shapes (each operand read or written once);
+// cache reuse and blocking are deliberately ignored. Collection is off
+// by default and a disabled probe costs one atomic load. Enabled and
+// queried from Python via _enable_roofline_counters /
+// _get_roofline_counters in the CPU module bindings.
+bool enabled();
+void set_enabled(bool enable);
+void reset();
+
+struct Counter {
+  uint64_t invocations = 0;
+  uint64_t bytes = 0;
+  uint64_t flops = 0;
+};
+
+// Snapshot of the table; op names are stable string literals from the
+// record sites.
+std::vector<std::pair<std::string, Counter>> snapshot();
+
+// Accumulates one call of the named op. `op` must be a string literal
+// (it is stored by pointer).
+void record(const char* op, uint64_t bytes, uint64_t flops);
+
+// Logical bytes of one full read or write of a tensor.
+inline uint64_t tensor_bytes(const at::Tensor& t) {
+  return t.defined()
+      ? static_cast<uint64_t>(t.numel()) * t.element_size()
+      : 0;
+}
+
+} // namespace roofline
+} // namespace cpu
+} // namespace torch_ipex
+
+// Record site for the fused kernel entry points. The byte/flop
+// expressions are only evaluated when collection is enabled.
+#define IPEX_ROOFLINE_RECORD(op, bytes, flops)                \
+  do {                                                        \
+    if (C10_UNLIKELY(torch_ipex::cpu::roofline::enabled())) { \
+      torch_ipex::cpu::roofline::record(op, bytes, flops);    \
+    }                                                         \
+  } while (0)
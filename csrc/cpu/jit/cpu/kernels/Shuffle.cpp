@@ -6,6 +6,9 @@
 #include <c10/util/Logging.h>
 #include <torch/csrc/autograd/function.h>
 
+#include <ATen/Parallel.h>
+
+#include <cstring>
 #include <limits>
 
 #include <ideep.hpp>
@@ -29,5 +32,46 @@ at::Tensor dil_shuffle(
   return output;
 }
 
+c10::List<at::Tensor> dil_shuffle_split(
+    const at::Tensor& self,
+    at::IntArrayRef view_shape,
+    int64_t dim0,
+    int64_t dim1) {
+  RECORD_FUNCTION("dil_shuffle_split", c10::ArrayRef<c10::IValue>({}));
+  auto group_dim = dim0 < dim1 ? dim0 : dim1;
+  auto groups = view_shape[group_dim];
+  auto self_ = self.contiguous();
+  TORCH_CHECK(self_.dim() == 4, "dil_shuffle_split: expect a 4-D NCHW input");
+  auto n = self_.size(0);
+  auto c = self_.size(1);
+  TORCH_CHECK(
+      groups > 0 && c % groups == 0 && c % 2 == 0,
+      "dil_shuffle_split: channel count must be even and divisible by groups");
+  auto channels_per_group = c / groups;
+  auto half = c / 2;
+  auto out0 =
+      at::empty({n, half, self_.size(2), self_.size(3)}, self_.options());
+  auto out1 = at::empty_like(out0);
+  auto plane_bytes = self_.size(2) * self_.size(3) * self_.element_size();
+  auto* src = static_cast<const char*>(self_.data_ptr());
+  char* dst[2] = {
+      static_cast<char*>(out0.data_ptr()), static_cast<char*>(out1.data_ptr())};
+  at::parallel_for(0, n * c, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      auto n_i = i / c;
+      auto oc = i % c;
+      // shuffled output channel oc reads input channel
+      // (oc % groups) * (c / groups) + oc / groups
+      auto ic = (oc % groups) * channels_per_group + oc / groups;
+      auto branch = oc < half ? 0 : 1;
+      std::memcpy(
+          dst[branch] + (n_i * half + (oc - branch * half)) * plane_bytes,
+          src + (n_i * c + ic) * plane_bytes,
+          plane_bytes);
+    }
+  });
+  return c10::List<at::Tensor>({out0, out1});
+}
+
 } // namespace cpu
 } // namespace torch_ipex
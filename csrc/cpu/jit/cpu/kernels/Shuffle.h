@@ -16,5 +16,14 @@ at::Tensor dil_shuffle(
     int64_t dim0,
     int64_t dim1);
 
+// Channel shuffle fused with a subsequent chunk(2, dim=1): every shuffled
+// channel plane is read once from the input and written directly into its
+// branch tensor, saving the intermediate shuffled activation.
+c10::List<at::Tensor> dil_shuffle_split(
+    const at::Tensor& self,
+    at::IntArrayRef view_shape,
+    int64_t dim0,
+    int64_t dim1);
+
 } // namespace cpu
 } // namespace torch_ipex
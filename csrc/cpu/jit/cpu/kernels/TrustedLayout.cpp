@@ -0,0 +1,29 @@
+#include "TrustedLayout.h"
+
+namespace torch_ipex {
+namespace cpu {
+
+namespace {
+
+// Per-thread flag rather than per-call plumbing: the kernel entry points
+// are shared between eager and graph-executor callers and their
+// signatures should not grow a validation knob.
+thread_local bool trusted_layout_active = false;
+
+} // namespace
+
+bool layout_contracts_trusted() {
+  return trusted_layout_active;
+}
+
+TrustedLayoutScope::TrustedLayoutScope(bool trusted)
+    : previous_(trusted_layout_active) {
+  trusted_layout_active = trusted;
+}
+
+TrustedLayoutScope::~TrustedLayoutScope() {
+  trusted_layout_active = previous_;
+}
+
+} // namespace cpu
+} // namespace torch_ipex
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <Macros.h>
+
+namespace torch_ipex {
+namespace cpu {
+
+// Attribute name the fusion pass stamps onto ipex_prepack nodes whose
+// input layout contract (CPU device, supported float dtype, contiguous
+// or channels-last strides) was proven from profiled types at rewrite
+// time. The jit operator wrappers translate the attribute into a
+// TrustedLayoutScope around the kernel call.
+constexpr const char* kTrustedLayoutAttr = "trusted_layout";
+
+// True while the calling thread executes a fused op whose layout
+// contract was proven at rewrite time. Kernel entry points consult this
+// to skip per-call shape/contiguity validation; the checked path stays
+// in place for eager callers and unproven graph nodes.
+IPEX_API bool layout_contracts_trusted();
+
+// RAII scope the graph executor wrappers use to vouch for the layout
+// contract of the op they are about to run. Nests trivially: the
+// previous value is restored on destruction.
+class IPEX_API TrustedLayoutScope {
+ public:
+  explicit TrustedLayoutScope(bool trusted);
+  ~TrustedLayoutScope();
+
+ private:
+  bool previous_;
+
+  TrustedLayoutScope() = delete;
+  TrustedLayoutScope(const TrustedLayoutScope&) = delete;
+  TrustedLayoutScope& operator=(const TrustedLayoutScope&) = delete;
+};
+
+} // namespace cpu
+} // namespace torch_ipex
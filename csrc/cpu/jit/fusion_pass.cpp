@@ -1,13 +1,16 @@
 #include "fusion_pass.h"
+#include "op_symbol_table.h"
 #include <string>
 #include "auto_opt_config.h"
 #include "codegen/onednn/interface.h"
 #include "cpu/kernels/Matmul.h"
+#include "cpu/kernels/TrustedLayout.h"
 #include "passes/concat_linear.h"
 #include "passes/frozen_conv_folding.h"
 #include "passes/frozen_linear_folding.h"
 #include "passes/graph_rewrite.h"
 #include "passes/graph_rewrite_helper.h"
+#include "passes/group_matmul.h"
 #include "passes/prepack_folding.h"
 #include "passes/qpadding.h"
 #include "passes/remove_redundant_aliases.h"
@@ -77,6 +80,87 @@ class ATenLinearRecorder {
   bool use_mkl_sgemm = false;
 };
 
+// True if the strides describe a dense tensor whose dimensions are laid
+// out in memory in the given order (innermost dimension first).
+// Size-one dimensions carry no layout information and are skipped.
+static bool stridesAreDenseInOrder(
+    const std::vector<int64_t>& sizes,
+    const std::vector<int64_t>& strides,
+    const std::vector<size_t>& order) {
+  int64_t expected = 1;
+  for (auto dim : order) {
+    if (sizes[dim] != 1) {
+      if (strides[dim] != expected) {
+        return false;
+      }
+      expected *= sizes[dim];
+    }
+  }
+  return true;
+}
+
+// A layout contract is proven when the profiled type pins down device,
+// dtype and a dense (contiguous or channels-last) stride layout. Only
+// then may the fused kernel skip its per-call validation: the guards the
+// profiling executor inserts re-check exactly these properties before
+// the optimized graph runs.
+static bool provenLayoutContract(Value* v) {
+  auto tensor_type = v->type()->cast<TensorType>();
+  if (!tensor_type) {
+    return false;
+  }
+  auto device = tensor_type->device();
+  if (!device.has_value() || !device->is_cpu()) {
+    return false;
+  }
+  auto dtype = tensor_type->scalarType();
+  if (!dtype.has_value() ||
+      (*dtype != at::kFloat && *dtype != at::kBFloat16 && *dtype != at::kHalf)) {
+    return false;
+  }
+  auto sizes = tensor_type->sizes().concrete_sizes();
+  auto strides = tensor_type->strides().concrete_sizes();
+  if (!sizes.has_value() || !strides.has_value() || sizes->empty() ||
+      sizes->size() != strides->size()) {
+    return false;
+  }
+  auto ndim = sizes->size();
+  std::vector<size_t> row_major(ndim);
+  for (size_t i = 0; i < ndim; ++i) {
+    row_major[i] = ndim - 1 - i;
+  }
+  if (stridesAreDenseInOrder(*sizes, *strides, row_major)) {
+    return true;
+  }
+  if (ndim == 4) {
+    return stridesAreDenseInOrder(*sizes, *strides, {1, 3, 2, 0});
+  }
+  if (ndim == 5) {
+    return stridesAreDenseInOrder(*sizes, *strides, {1, 4, 3, 2, 0});
+  }
+  return false;
+}
+
+// Stamp the trusted-layout attribute onto ipex_prepack nodes whose first
+// tensor input has a fully proven layout. The operator wrappers in
+// register_dnnl_jit_ops.cpp bake the attribute into the Operation so the
+// packed kernels can elide their per-call shape/contiguity checks; nodes
+// without the attribute (and all eager calls) keep the checked path.
+static void markTrustedLayoutContracts(Block* block) {
+  const auto prepack_ns = Symbol::fromQualString("namespaces::ipex_prepack");
+  for (auto node : block->nodes()) {
+    for (auto sub : node->blocks()) {
+      markTrustedLayoutContracts(sub);
+    }
+    if (node->kind().ns() != prepack_ns || node->inputs().empty()) {
+      continue;
+    }
+    if (provenLayoutContract(node->input(0))) {
+      node->i_(Symbol::attr(cpu::kTrustedLayoutAttr), 1);
+    }
+  }
+}
+
 void IPEXFusionPass(std::shared_ptr<Graph>& graph) {
   // remove dropout;
   torch::jit::removeDropout(graph);
@@ -94,9 +178,19 @@ void IPEXFusionPass(std::shared_ptr<Graph>& graph) {
   graph_rewrite::PostScalarDivOrMul(graph);
   graph_rewrite::FuseMHAScoreCalc(graph);
 
+  // Fuse the rotate_half rotary embedding and the grouped-query
+  // key/value repeat of Llama-style attention
+  graph_rewrite::FuseRopeAndRepeatKV(graph);
+
   // Fuse bmm + add for bmm_add
   graph_rewrite::fuseBmmAdd(graph);
 
+  // Group independent small same-shape matmuls into one batched GEMM.
+  // Runs after fuseBmmAdd so the bmm + add fusion keeps priority and
+  // only the leftover matmuls are grouped.
+  torch_ipex::jit::GroupMatmul(graph);
+  GRAPH_DUMP("After GroupMatmul.", graph);
+
   // Replace _convolution with conv2d or conv3d
   torch_ipex::jit::graph_rewrite_helper::replaceConvolutionWithAtenConv(graph);
   GRAPH_DUMP(
@@ -149,7 +243,11 @@ void IPEXFusionPass(std::shared_ptr<Graph>& graph) {
       aten_linear_recorder.get_records(),
       aten_linear_recorder.use_mkl());
   GRAPH_DUMP(
-      "After insertPrePackedLinearOp.Before fuseLinearWithEltwise", graph);
+      "After insertPrePackedLinearOp.Before fuseLinearEpilogueChain", graph);
+  // run before the single-op fusions so multi-op activation chains are
+  // collapsed into one generic epilogue instead of fusing only their head
+  graph_rewrite::fuseLinearEpilogueChain(graph);
+  GRAPH_DUMP("After fuseLinearEpilogueChain.Before fuseLinearWithEltwise", graph);
   graph_rewrite::fuseLinearWithEltwise(graph);
   GRAPH_DUMP("After fuseLinearWithEltwise.Before fuseLinearAddRelu", graph);
   graph_rewrite::fuseLinearAddRelu(graph);
@@ -158,8 +256,9 @@ void IPEXFusionPass(std::shared_ptr<Graph>& graph) {
   GRAPH_DUMP("After fuseLinearMulAdd.", graph);
   graph_rewrite::FuseLinearSwishCustomized(graph);
 
-  // fuse rmsnorm
+  // fuse rmsnorm, then fold a following quantize into it (smooth-quant)
   graph_rewrite::FuseRMSNorm(graph);
+  graph_rewrite::FuseRMSNormQuant(graph);
   // fuse add+layernorm
   graph_rewrite::FuseAddLayerNorm(graph);
 
@@ -181,11 +280,18 @@ void IPEXFusionPass(std::shared_ptr<Graph>& graph) {
   // hence the concat dim should be the channel
   graph_rewrite::FuseConcatBnRelu(graph);
 
+  // fold the remaining frozen bn(+add)+relu chains into a single
+  // scale-shift pass; must run before aten::batch_norm is replaced with
+  // ipex::batch_norm below so the chain is still visible
+  graph_rewrite::FuseFrozenBatchNormAddRelu(graph);
+
   // replace aten max_pool2d with ipex max_pool2d
   graph_rewrite::replaceAtenMaxPool2dWithIpexMaxPool2d(graph);
 
   // Fuse operators as shuffle
   graph_rewrite::FuseShuffle(graph);
+  // Fuse shuffle + channel chunk of ShuffleNet-style blocks
+  graph_rewrite::FuseShuffleSplit(graph);
   graph_rewrite::FuseMatmulDivOrMul(graph);
   // replace aten softmax with ipex softmax
   graph_rewrite::replaceAtenSoftmaxWithIpexSoftmax(graph);
@@ -204,11 +310,21 @@ void IPEXFusionPass(std::shared_ptr<Graph>& graph) {
   // fusion are completed to prevent mismatching "aten::matmul".
   graph_rewrite::FusedTransFreeMha(graph);
 
+  // harvest the remaining chains of unary / binary-with-constant eltwise
+  // ops into single-pass ipex::eltwise_chain nodes; runs last so it only
+  // collapses what the dedicated fusions left behind
+  graph_rewrite::FuseEltwiseChains(graph);
+
   ConstantPropagation(graph);
   GRAPH_DUMP("Before PrePackingOpsFolder", graph);
   // folding prepacking ops.
   PrePackingOpsFolder(graph);
   GRAPH_DUMP("After PrePackingOpsFolder", graph);
+
+  // runs last so the attribute lands on the final fused nodes after all
+  // rewrites above have settled
+  markTrustedLayoutContracts(graph->block());
+  GRAPH_DUMP("After markTrustedLayoutContracts", graph);
 }
 
 bool checkQuantization(Block* block) {
@@ -221,7 +337,7 @@ bool checkQuantization(Block* block) {
         node->kind() == Symbol::aten("dequantize") ||
         node->kind() == Symbol::aten("quantize_per_channel") ||
         node->kind() == Symbol::aten("quantized_lstm") ||
-        node->kind() == Symbol::fromQualString("quantized::linear_dynamic")) {
+        node->kind() == torch_ipex::jit::ipex_op_symbols().quantized_linear_dynamic) {
       return true;
     }
   }
@@ -0,0 +1,133 @@
+#include "graph_replay.h"
+
+#include <torch/csrc/jit/runtime/operator.h>
+
+#include <unordered_map>
+
+namespace torch_ipex {
+namespace jit {
+
+namespace {
+
+// Nodes the flat call list cannot represent: anything with sub-blocks
+// (control flow, fork) and the call/python escape hatches that need the
+// full interpreter behind them.
+bool node_is_flattenable(const torch::jit::Node* n) {
+  if (!n->blocks().empty()) {
+    return false;
+  }
+  switch (n->kind()) {
+    case torch::jit::prim::CallFunction:
+    case torch::jit::prim::CallMethod:
+    case torch::jit::prim::PythonOp:
+    case torch::jit::prim::BailOut:
+    case torch::jit::prim::BailoutTemplate:
+      return false;
+    default:
+      break;
+  }
+  return n->kind() == torch::jit::prim::Constant || n->maybeOperator();
+}
+
+} // namespace
+
+bool GraphReplay::IsReplayable(
+    const std::shared_ptr<torch::jit::Graph>& graph) {
+  for (const auto* n : graph->nodes()) {
+    if (!node_is_flattenable(n)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+GraphReplay::GraphReplay(std::shared_ptr<torch::jit::Graph> graph)
+    : graph_(std::move(graph)) {
+  std::unordered_map<const torch::jit::Value*, size_t> reg_of;
+  auto assign_reg = [&](const torch::jit::Value* v) {
+    auto it = reg_of.find(v);
+    if (it != reg_of.end()) {
+      return it->second;
+    }
+    size_t reg = initial_regs_.size();
+    initial_regs_.emplace_back();
+    reg_of.emplace(v, reg);
+    return reg;
+  };
+
+  for (const auto* input : graph_->inputs()) {
+    input_regs_.push_back(assign_reg(input));
+  }
+
+  for (auto* n : graph_->nodes()) {
+    TORCH_CHECK(
+        node_is_flattenable(n),
+        "GraphReplay: cannot flatten node ",
+        n->kind().toQualString(),
+        "; capture requires a control-flow-free optimized graph");
+    if (n->kind() == torch::jit::prim::Constant) {
+      // materialize once; replay never revisits the node
+      auto iv = torch::jit::toIValue(n->output());
+      TORCH_CHECK(
+          iv.has_value(), "GraphReplay: constant node without a value");
+      initial_regs_[assign_reg(n->output())] = std::move(iv.value());
+      continue;
+    }
+    Step step;
+    step.op = n->getOperation();
+    for (const auto* in : n->inputs()) {
+      step.input_regs.push_back(assign_reg(in));
+    }
+    for (const auto* out : n->outputs()) {
+      step.output_regs.push_back(assign_reg(out));
+    }
+    steps_.push_back(std::move(step));
+  }
+
+  for (const auto* output : graph_->outputs()) {
+    output_regs_.push_back(assign_reg(output));
+  }
+}
+
+std::vector<c10::IValue> GraphReplay::run(std::vector<c10::IValue> inputs) {
+  TORCH_CHECK(
+      inputs.size() == input_regs_.size(),
+      "GraphReplay: expected ",
+      input_regs_.size(),
+      " inputs, got ",
+      inputs.size());
+  // copying the template is a refcount bump per constant; intermediates
+  // from the previous token are dropped here
+  std::vector<c10::IValue> regs = initial_regs_;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    regs[input_regs_[i]] = std::move(inputs[i]);
+  }
+
+  torch::jit::Stack stack;
+  for (auto& step : steps_) {
+    stack.clear();
+    for (auto r : step.input_regs) {
+      stack.push_back(regs[r]);
+    }
+    step.op(stack);
+    TORCH_CHECK(
+        stack.size() == step.output_regs.size(),
+        "GraphReplay: op left ",
+        stack.size(),
+        " values on the stack, expected ",
+        step.output_regs.size());
+    for (size_t j = 0; j < step.output_regs.size(); ++j) {
+      regs[step.output_regs[j]] = std::move(stack[j]);
+    }
+  }
+
+  std::vector<c10::IValue> outputs;
+  outputs.reserve(output_regs_.size());
+  for (auto r : output_regs_) {
+    outputs.push_back(std::move(regs[r]));
+  }
+  return outputs;
+}
+
+} // namespace jit
+} // namespace torch_ipex
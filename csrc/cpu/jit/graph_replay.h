@@ -0,0 +1,64 @@
+#pragma once
+
+#include <Macros.h>
+#include <torch/csrc/jit/ir/ir.h>
+#include <torch/csrc/jit/runtime/operator.h>
+
+#include <memory>
+#include <vector>
+
+namespace torch_ipex {
+namespace jit {
+
+// GraphReplay flattens a control-flow-free graph into a resolved call
+// list once and replays that list for later invocations.
+//
+// Decode loops execute an identical op sequence with identical shapes
+// every token, yet each step pays full interpreter dispatch: instruction
+// decoding, operator lookup, bailout and profiling bookkeeping. Capture
+// resolves every node to its Operation up front and maps each Value to a
+// fixed register slot; replay is then a flat walk that pushes input
+// registers, invokes the stored Operation, and writes the results back —
+// only the per-token inputs change between runs. Constants (weights,
+// packed op contexts, scalars) are materialized once at capture.
+//
+// Only graphs the flat list can represent are accepted: no sub-blocks
+// (prim::If / prim::Loop), no function or method calls, and every
+// non-constant node must resolve to a registered operator. Run the
+// profiling/fusion warmup first and capture the optimized graph; a graph
+// that re-specializes after capture keeps replaying the captured form.
+// As with the interpreter on frozen graphs, ops that mutate their inputs
+// in place will mutate the captured constants.
+class IPEX_API GraphReplay {
+ public:
+  explicit GraphReplay(std::shared_ptr<torch::jit::Graph> graph);
+
+  // True when every node in `graph` can be flattened into the call list.
+  static bool IsReplayable(const std::shared_ptr<torch::jit::Graph>& graph);
+
+  // Executes the captured call list. Not thread-safe against itself; use
+  // one GraphReplay per replaying thread.
+  std::vector<c10::IValue> run(std::vector<c10::IValue> inputs);
+
+  int64_t num_steps() const {
+    return static_cast<int64_t>(steps_.size());
+  }
+
+ private:
+  struct Step {
+    torch::jit::Operation op;
+    std::vector<size_t> input_regs;
+    std::vector<size_t> output_regs;
+  };
+
+  // keeps the Values referenced by the captured Operations alive
+  std::shared_ptr<torch::jit::Graph> graph_;
+  // register file template: constants filled in, the rest empty
+  std::vector<c10::IValue> initial_regs_;
+  std::vector<size_t> input_regs_;
+  std::vector<size_t> output_regs_;
+  std::vector<Step> steps_;
+};
+
+} // namespace jit
+} // namespace torch_ipex
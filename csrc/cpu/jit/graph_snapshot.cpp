@@ -0,0 +1,169 @@
+#include "graph_snapshot.h"
+#include "op_symbol_table.h"
+
+#include <oneapi/dnnl/dnnl.h>
+#include <torch/csrc/jit/ir/irparser.h>
+#include <torch/csrc/jit/passes/dead_code_elimination.h>
+#include <torch/csrc/jit/passes/utils/subgraph_utils.h>
+#include <torch/csrc/jit/serialization/pickle.h>
+#include <sstream>
+
+#include "aten/utils/isa_help.h"
+#include "fusion_pass.h"
+
+namespace torch_ipex {
+namespace jit {
+
+using namespace torch::jit;
+
+namespace {
+
+constexpr const char* kSnapshotMagic = "ipex-graph-snapshot";
+constexpr const char* kSnapshotVersion = "v1";
+
+// Placeholder op standing in for constants the IR printer cannot
+// round-trip (tensors, packed-weight op contexts). The attribute indexes
+// into the pickled constant table stored next to the IR text.
+const c10::Symbol kPlaceholderSym =
+    torch_ipex::jit::ipex_op_symbols().ipex_snapshot_constant;
+const c10::Symbol kIndexAttr = c10::Symbol::attr("snapshot_index");
+
+bool needsSideChannel(const Node* node) {
+  if (node->kind() != prim::Constant) {
+    return false;
+  }
+  if (node->outputs().size() != 1) {
+    return false;
+  }
+  auto type = node->output()->type();
+  return type->isSubtypeOf(*c10::TensorType::get()) ||
+      type->kind() == c10::TypeKind::ClassType;
+}
+
+} // namespace
+
+std::string GraphSnapshotFingerprint() {
+  const dnnl_version_t* v = dnnl_version();
+  std::ostringstream oss;
+  oss << kSnapshotVersion << "|" << cpu::get_current_isa_level() << "|dnnl-"
+      << v->major << "." << v->minor << "." << v->patch;
+  return oss.str();
+}
+
+std::string SaveOptimizedGraph(const std::shared_ptr<Graph>& graph) {
+  TORCH_CHECK(graph, "SaveOptimizedGraph: graph should not be null");
+  // Work on a copy: the rewrites below mutate the graph and the caller's
+  // executor still owns the original.
+  auto snapshot = graph->copy();
+  // Fusion/partition groups carry their subgraph as a graph-valued
+  // attribute, which the IR parser cannot round-trip. Unmerge them back
+  // into plain ops; LoadOptimizedGraph re-runs the fusion pass to re-form
+  // the groups deterministically.
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (auto* node : snapshot->nodes()) {
+      if (node->hasAttribute(attr::Subgraph)) {
+        SubgraphUtils::unmergeSubgraph(node);
+        changed = true;
+        break;
+      }
+    }
+  }
+  EliminateDeadCode(snapshot);
+  // Tensor constants (frozen weights) and packed-weight op contexts do not
+  // survive the IR printer either; swap each for an indexed placeholder
+  // node and pickle the values alongside the IR.
+  c10::impl::GenericList constants{c10::AnyType::get()};
+  std::vector<Node*> to_replace;
+  for (auto* node : snapshot->nodes()) {
+    if (needsSideChannel(node)) {
+      to_replace.push_back(node);
+    }
+  }
+  for (auto* node : to_replace) {
+    auto ivalue = toIValue(node->output());
+    TORCH_CHECK(
+        ivalue.has_value(),
+        "SaveOptimizedGraph: constant without a value cannot be snapshot");
+    auto* placeholder = snapshot->create(kPlaceholderSym, 0);
+    placeholder->i_(kIndexAttr, static_cast<int64_t>(constants.size()));
+    placeholder->addOutput()->setType(node->output()->type());
+    placeholder->insertBefore(node);
+    node->output()->replaceAllUsesWith(placeholder->output());
+    node->destroy();
+    constants.push_back(*ivalue);
+  }
+  auto pickled = pickle_save(c10::IValue(constants));
+  std::ostringstream oss;
+  oss << kSnapshotMagic << "\n"
+      << GraphSnapshotFingerprint() << "\n"
+      << pickled.size() << "\n";
+  oss.write(pickled.data(), pickled.size());
+  oss << "\n";
+  snapshot->print(oss, false);
+  return oss.str();
+}
+
+std::shared_ptr<Graph> LoadOptimizedGraph(const std::string& payload) {
+  std::istringstream iss(payload);
+  std::string magic, fingerprint, pickled_size_str;
+  TORCH_CHECK(
+      std::getline(iss, magic) && magic == kSnapshotMagic,
+      "LoadOptimizedGraph: payload is not an IPEX graph snapshot");
+  TORCH_CHECK(
+      std::getline(iss, fingerprint),
+      "LoadOptimizedGraph: truncated graph snapshot");
+  TORCH_CHECK(
+      fingerprint == GraphSnapshotFingerprint(),
+      "LoadOptimizedGraph: snapshot was produced with '",
+      fingerprint,
+      "' but this process expects '",
+      GraphSnapshotFingerprint(),
+      "'; re-generate the snapshot on this build/machine");
+  TORCH_CHECK(
+      std::getline(iss, pickled_size_str),
+      "LoadOptimizedGraph: truncated graph snapshot");
+  auto pickled_size = std::stoll(pickled_size_str);
+  auto blob_begin = static_cast<int64_t>(iss.tellg());
+  TORCH_CHECK(
+      blob_begin >= 0 &&
+          blob_begin + pickled_size + 1 <=
+              static_cast<int64_t>(payload.size()),
+      "LoadOptimizedGraph: truncated graph snapshot");
+  auto constants =
+      pickle_load(std::vector<char>(
+                      payload.data() + blob_begin,
+                      payload.data() + blob_begin + pickled_size))
+          .toList();
+  std::string ir(payload.begin() + blob_begin + pickled_size + 1, payload.end());
+  auto graph = std::make_shared<Graph>();
+  parseIR(ir, graph.get());
+  // Restore the side-channel constants behind the placeholders.
+  std::vector<Node*> placeholders;
+  for (auto* node : graph->nodes()) {
+    if (node->kind() == kPlaceholderSym) {
+      placeholders.push_back(node);
+    }
+  }
+  for (auto* node : placeholders) {
+    auto index = node->i(kIndexAttr);
+    TORCH_CHECK(
+        index >= 0 && index < static_cast<int64_t>(constants.size()),
+        "LoadOptimizedGraph: constant table index out of range");
+    WithInsertPoint guard(node);
+    auto* value = graph->insertConstant(constants.get(index));
+    value->setType(node->output()->type());
+    node->output()->replaceAllUsesWith(value);
+    node->destroy();
+  }
+  // Re-form the fusion groups. The graph was saved with the profiling
+  // information already specialized into the value types, so this is the
+  // cheap deterministic tail of the optimization pipeline; the oneDNN
+  // partition kernels recompile lazily on first execution.
+  FusionPass(graph);
+  return graph;
+}
+
+} // namespace jit
+} // namespace torch_ipex
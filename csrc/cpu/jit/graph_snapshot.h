@@ -0,0 +1,34 @@
+#pragma once
+
+#include <Macros.h>
+#include <torch/csrc/jit/ir/ir.h>
+#include <memory>
+#include <string>
+
+namespace torch_ipex {
+namespace jit {
+
+// Fingerprint of everything a serialized graph depends on (snapshot format
+// version, ISA level, oneDNN version). A snapshot is only reloaded when the
+// fingerprint of the loading process matches the one recorded at save time.
+IPEX_API std::string GraphSnapshotFingerprint();
+
+// Serializes a post-fusion optimized graph to a self-describing text
+// payload. Fusion/partition subgraph nodes are unmerged into plain ops
+// before printing so the IR round-trips through the parser; the fusion
+// pass is re-applied on load. oneDNN partition kernels themselves are
+// JIT-compiled and cannot be serialized - they are rebuilt lazily on the
+// first run of the reloaded graph, which is cheap next to the profiling
+// warmup the snapshot skips.
+IPEX_API std::string SaveOptimizedGraph(
+    const std::shared_ptr<torch::jit::Graph>& graph);
+
+// Parses a payload produced by SaveOptimizedGraph, validating the magic
+// header and fingerprint, and re-runs the IPEX fusion pass to re-form the
+// fusion groups. Throws if the payload is malformed or was produced by an
+// incompatible build/machine.
+IPEX_API std::shared_ptr<torch::jit::Graph> LoadOptimizedGraph(
+    const std::string& payload);
+
+} // namespace jit
+} // namespace torch_ipex
@@ -0,0 +1,279 @@
+#include "memory_planner.h"
+
+#include <c10/core/CPUAllocator.h>
+#include <c10/util/Exception.h>
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace torch_ipex {
+namespace jit {
+
+namespace {
+
+constexpr size_t kArenaAlignment = 64; // cache line, matches onednn
+
+inline size_t align_up(size_t nbytes) {
+  return (nbytes + kArenaAlignment - 1) & ~(kArenaAlignment - 1);
+}
+
+// The planner whose region the current thread is inside, if any.
+// Threads outside a region (omp workers, other request threads) see
+// nullptr and go straight to the regular allocator.
+thread_local GraphMemoryPlanner* tls_active_planner = nullptr;
+
+// Process CPU allocator that forwards to the thread-active planner. It
+// is installed once, on the first region entry, and stays installed;
+// with no active planner on the calling thread it is a plain
+// pass-through to the allocator it replaced.
+class PlanningAllocator final : public c10::Allocator {
+ public:
+  static PlanningAllocator& singleton() {
+    static PlanningAllocator allocator;
+    return allocator;
+  }
+
+  at::DataPtr allocate(size_t nbytes) override {
+    auto* planner = tls_active_planner;
+    if (planner == nullptr) {
+      return delegate_->allocate(nbytes);
+    }
+    return planner->allocate_in_region(nbytes);
+  }
+
+  void copy_data(void* dest, const void* src, std::size_t count)
+      const override {
+    default_copy_data(dest, src, count);
+  }
+
+  c10::Allocator* get_delegate() const {
+    return delegate_;
+  }
+
+  void set_delegate(c10::Allocator* delegate) {
+    delegate_ = delegate;
+  }
+
+ private:
+  c10::Allocator* delegate_{nullptr};
+};
+
+c10::Allocator* installed_planning_allocator() {
+  static c10::Allocator* delegate = []() {
+    auto& allocator = PlanningAllocator::singleton();
+    allocator.set_delegate(c10::GetCPUAllocator());
+    c10::SetCPUAllocator(&allocator, /*priority=*/1);
+    return allocator.get_delegate();
+  }();
+  return delegate;
+}
+
+} // anonymous namespace
+
+// Deleter context of a block handed out while recording. Owns the
+// delegate DataPtr and remembers which event of which recording run it
+// belongs to, so a free arriving after the plan was rebuilt (or after
+// the planner moved on to a later recording run) is ignored instead of
+// touching stale bookkeeping.
+struct GraphMemoryPlanner::RecordedBlockCtx {
+  GraphMemoryPlanner* planner;
+  uint64_t run_id;
+  size_t event_index;
+  at::DataPtr inner;
+};
+
+void GraphMemoryPlanner::recorded_block_deleter(void* ctx_) {
+  auto* ctx = static_cast<RecordedBlockCtx*>(ctx_);
+  ctx->planner->on_recorded_free(ctx);
+  delete ctx;
+}
+
+void GraphMemoryPlanner::arena_block_deleter(void* ctx_) {
+  delete static_cast<std::shared_ptr<Arena>*>(ctx_);
+}
+
+GraphMemoryPlanner::GraphMemoryPlanner(c10::Allocator* delegate)
+    : delegate_(delegate) {}
+
+void GraphMemoryPlanner::begin_run() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (state_ == State::kRecording) {
+    events_.clear();
+    event_clock_ = 0;
+    ++record_run_id_;
+    recording_run_active_ = true;
+  } else {
+    replay_cursor_ = 0;
+    run_diverged_ = false;
+  }
+}
+
+void GraphMemoryPlanner::end_run() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (state_ == State::kRecording) {
+    recording_run_active_ = false;
+    build_plan();
+    return;
+  }
+  // A replay run that used fewer allocations than planned changed
+  // shape just like one that used more; re-record next run.
+  if (run_diverged_ || replay_cursor_ != plan_.size()) {
+    state_ = State::kRecording;
+    plan_.clear();
+    arena_.reset();
+    arena_nbytes_ = 0;
+  }
+}
+
+at::DataPtr GraphMemoryPlanner::allocate_in_region(size_t nbytes) {
+  // Zero-size allocations carry no payload and are not part of the
+  // plan; keep record and replay symmetric by bypassing both.
+  if (nbytes == 0) {
+    return delegate_->allocate(nbytes);
+  }
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (state_ == State::kRecording) {
+    size_t event_index = events_.size();
+    events_.push_back({nbytes, event_clock_++, -1});
+    auto inner = delegate_->allocate(nbytes);
+    void* data = inner.get();
+    auto* ctx =
+        new RecordedBlockCtx{this, record_run_id_, event_index, std::move(inner)};
+    delegated_alloc_count_.fetch_add(1, std::memory_order_relaxed);
+    return at::DataPtr(
+        data, ctx, &recorded_block_deleter, at::Device(at::DeviceType::CPU));
+  }
+  if (run_diverged_ || replay_cursor_ >= plan_.size() ||
+      plan_[replay_cursor_].nbytes != nbytes) {
+    run_diverged_ = true;
+    delegated_alloc_count_.fetch_add(1, std::memory_order_relaxed);
+    return delegate_->allocate(nbytes);
+  }
+  const PlanSlot& slot = plan_[replay_cursor_++];
+  if (slot.escaping) {
+    delegated_alloc_count_.fetch_add(1, std::memory_order_relaxed);
+    return delegate_->allocate(nbytes);
+  }
+  void* data = static_cast<char*>(arena_->buffer.get()) + slot.offset;
+  auto* ctx = new std::shared_ptr<Arena>(arena_);
+  planned_alloc_count_.fetch_add(1, std::memory_order_relaxed);
+  return at::DataPtr(
+      data, ctx, &arena_block_deleter, at::Device(at::DeviceType::CPU));
+}
+
+void GraphMemoryPlanner::on_recorded_free(RecordedBlockCtx* ctx) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  // Frees from earlier recording runs or after the plan was built no
+  // longer matter for liveness; the block stayed escaping.
+  if (ctx->run_id == record_run_id_ && recording_run_active_) {
+    events_[ctx->event_index].free_time = event_clock_++;
+  }
+}
+
+void GraphMemoryPlanner::build_plan() {
+  plan_.clear();
+  plan_.reserve(events_.size());
+  for (const auto& event : events_) {
+    plan_.push_back({event.nbytes, 0, event.free_time < 0});
+  }
+  // Greedy placement, largest block first: each block takes the lowest
+  // arena offset that does not collide with an already placed block
+  // whose lifetime overlaps its own.
+  std::vector<size_t> order;
+  for (size_t i = 0; i < events_.size(); ++i) {
+    if (!plan_[i].escaping) {
+      order.push_back(i);
+    }
+  }
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return events_[a].nbytes > events_[b].nbytes;
+  });
+  std::vector<size_t> placed;
+  int64_t arena_end = 0;
+  for (size_t i : order) {
+    size_t block_size = align_up(events_[i].nbytes);
+    // Placed blocks that are live at the same time as block i, by
+    // ascending offset, bound the gaps block i may use.
+    std::vector<size_t> conflicts;
+    for (size_t j : placed) {
+      if (events_[j].alloc_time < events_[i].free_time &&
+          events_[i].alloc_time < events_[j].free_time) {
+        conflicts.push_back(j);
+      }
+    }
+    std::sort(conflicts.begin(), conflicts.end(), [&](size_t a, size_t b) {
+      return plan_[a].offset < plan_[b].offset;
+    });
+    int64_t offset = 0;
+    for (size_t j : conflicts) {
+      if (offset + static_cast<int64_t>(block_size) <= plan_[j].offset) {
+        break;
+      }
+      offset = std::max(
+          offset,
+          plan_[j].offset + static_cast<int64_t>(align_up(plan_[j].nbytes)));
+    }
+    plan_[i].offset = offset;
+    arena_end = std::max(offset + static_cast<int64_t>(block_size), arena_end);
+    placed.push_back(i);
+  }
+  arena_nbytes_ = arena_end;
+  arena_.reset();
+  if (arena_nbytes_ > 0) {
+    arena_ = std::make_shared<Arena>();
+    arena_->buffer = delegate_->allocate(arena_nbytes_);
+  }
+  events_.clear();
+  state_ = State::kReplaying;
+}
+
+int64_t GraphMemoryPlanner::get_arena_nbytes() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return arena_nbytes_;
+}
+
+int64_t GraphMemoryPlanner::get_planned_alloc_count() const {
+  return planned_alloc_count_.load(std::memory_order_relaxed);
+}
+
+int64_t GraphMemoryPlanner::get_delegated_alloc_count() const {
+  return delegated_alloc_count_.load(std::memory_order_relaxed);
+}
+
+GraphMemoryPlanner* get_memory_planner(const std::string& tag) {
+  static std::mutex registry_mutex;
+  static std::unordered_map<std::string, std::unique_ptr<GraphMemoryPlanner>>
+      registry;
+  std::lock_guard<std::mutex> guard(registry_mutex);
+  auto it = registry.find(tag);
+  if (it == registry.end()) {
+    it = registry
+             .emplace(
+                 tag,
+                 std::make_unique<GraphMemoryPlanner>(
+                     installed_planning_allocator()))
+             .first;
+  }
+  return it->second.get();
+}
+
+void enter_memory_planning_region(const std::string& tag) {
+  TORCH_CHECK(
+      tls_active_planner == nullptr,
+      "memory planning regions do not nest");
+  auto* planner = get_memory_planner(tag);
+  planner->begin_run();
+  tls_active_planner = planner;
+}
+
+void exit_memory_planning_region() {
+  TORCH_CHECK(
+      tls_active_planner != nullptr,
+      "exit_memory_planning_region() without a matching enter");
+  auto* planner = tls_active_planner;
+  tls_active_planner = nullptr;
+  planner->end_run();
+}
+
+} // namespace jit
+} // namespace torch_ipex
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <Macros.h>
+#include <c10/core/Allocator.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace torch_ipex {
+namespace jit {
+
+// GraphMemoryPlanner captures the CPU allocation trace of one graph
+// execution and replays later executions out of a single arena.
+//
+// The fused ops on the dnnl JIT path allocate every intermediate output
+// through ATen per invocation. In serving graphs the shapes are stable
+// after warmup, so the trace of (size, lifetime) pairs is identical run
+// to run. The first run inside a planning region records that trace;
+// region exit places all intermediates whose lifetime ends inside the
+// region into one arena, reusing offsets between blocks whose lifetimes
+// do not overlap. Subsequent runs serve those allocations straight from
+// the arena with no allocator traffic. Allocations that are still alive
+// at region exit (graph outputs, cached state) always go to the regular
+// allocator, as do allocations from threads outside the region.
+//
+// Any divergence from the recorded trace - a different size, an extra
+// or a missing allocation - falls the rest of that run back to the
+// regular allocator and re-records on the next run, so a shape change
+// costs one un-planned execution and nothing else. Arena-backed tensors
+// hold shared ownership of their arena, so a plan can be invalidated
+// while tensors from the previous plan are still alive.
+class IPEX_API GraphMemoryPlanner {
+ public:
+  explicit GraphMemoryPlanner(c10::Allocator* delegate);
+
+  // One call pair per graph execution, from the thread that runs the
+  // graph. Between them, CPU allocations made by this thread are
+  // recorded or served from the arena depending on the planner state.
+  void begin_run();
+  void end_run();
+
+  // Serves one allocation inside an active region. Called from the
+  // process CPU allocator; not for direct use.
+  at::DataPtr allocate_in_region(size_t nbytes);
+
+  // Arena size of the current plan, 0 while recording.
+  int64_t get_arena_nbytes() const;
+  // Allocations served from the arena / handed to the regular
+  // allocator since the planner was created.
+  int64_t get_planned_alloc_count() const;
+  int64_t get_delegated_alloc_count() const;
+
+ private:
+  enum class State { kRecording, kReplaying };
+
+  // One allocation observed during the recording run. alloc_time and
+  // free_time index a per-run event clock; free_time stays -1 for
+  // blocks that escape the region.
+  struct AllocEvent {
+    size_t nbytes{0};
+    int64_t alloc_time{-1};
+    int64_t free_time{-1};
+  };
+
+  // One entry of the built plan, in allocation order.
+  struct PlanSlot {
+    size_t nbytes{0};
+    int64_t offset{0};
+    bool escaping{false};
+  };
+
+  // The arena plus the backing DataPtr that owns it. Arena-backed
+  // blocks keep a shared_ptr to this, so replacing the plan never
+  // frees memory that live tensors still point into.
+  struct Arena {
+    at::DataPtr buffer;
+  };
+
+  struct RecordedBlockCtx;
+  static void recorded_block_deleter(void* ctx);
+  static void arena_block_deleter(void* ctx);
+
+  void on_recorded_free(RecordedBlockCtx* ctx);
+  // Assigns arena offsets to the recorded events and switches to
+  // replay. Called under mutex_.
+  void build_plan();
+
+  c10::Allocator* delegate_;
+  mutable std::mutex mutex_;
+  State state_{State::kRecording};
+
+  // recording
+  std::vector<AllocEvent> events_;
+  int64_t event_clock_{0};
+  uint64_t record_run_id_{0};
+  bool recording_run_active_{false};
+
+  // replay
+  std::vector<PlanSlot> plan_;
+  std::shared_ptr<Arena> arena_;
+  int64_t arena_nbytes_{0};
+  size_t replay_cursor_{0};
+  bool run_diverged_{false};
+
+  std::atomic<int64_t> planned_alloc_count_{0};
+  std::atomic<int64_t> delegated_alloc_count_{0};
+
+  GraphMemoryPlanner(const GraphMemoryPlanner&) = delete;
+  GraphMemoryPlanner& operator=(const GraphMemoryPlanner&) = delete;
+};
+
+// Scoped planning region around one graph execution. Planners are kept
+// in a process-wide registry under the given tag, one per distinct
+// graph; enter/exit pairs must come from the same thread and do not
+// nest. Typical use wraps the traced module call:
+//
+//   _jit_memory_planner_enter("encoder")
+//   out = traced_module(input)
+//   _jit_memory_planner_exit()
+IPEX_API void enter_memory_planning_region(const std::string& tag);
+IPEX_API void exit_memory_planning_region();
+IPEX_API GraphMemoryPlanner* get_memory_planner(const std::string& tag);
+
+} // namespace jit
+} // namespace torch_ipex
@@ -0,0 +1,58 @@
+#include "op_symbol_table.h"
+
+namespace torch_ipex {
+namespace jit {
+
+using c10::Symbol;
+
+IpexOpSymbols::IpexOpSymbols()
+    : torch_ipex_convolution_forward(
+          Symbol::fromQualString("torch_ipex::convolution_forward")),
+      torch_ipex_conv_transpose(
+          Symbol::fromQualString("torch_ipex::conv_transpose")),
+      torch_ipex_ipex_linear(Symbol::fromQualString("torch_ipex::ipex_linear")),
+      torch_ipex_ipex_MKLSGEMM(
+          Symbol::fromQualString("torch_ipex::ipex_MKLSGEMM")),
+      torch_ipex_matmul_group(
+          Symbol::fromQualString("torch_ipex::matmul_group")),
+      torch_ipex_interaction_forward(
+          Symbol::fromQualString("torch_ipex::interaction_forward")),
+      torch_ipex_merged_embeddingbag_cat_forward(Symbol::fromQualString(
+          "torch_ipex::merged_embeddingbag_cat_forward")),
+      ipex_prepack_convolution_prepack(
+          Symbol::fromQualString("ipex_prepack::convolution_prepack")),
+      ipex_prepack_convolution_run(
+          Symbol::fromQualString("ipex_prepack::convolution_run")),
+      ipex_prepack_conv_transpose_prepack(
+          Symbol::fromQualString("ipex_prepack::conv_transpose_prepack")),
+      ipex_prepack_conv_transpose_run(
+          Symbol::fromQualString("ipex_prepack::conv_transpose_run")),
+      ipex_prepack_linear_prepack(
+          Symbol::fromQualString("ipex_prepack::linear_prepack")),
+      ipex_prepack_linear_run(
+          Symbol::fromQualString("ipex_prepack::linear_run")),
+      ipex_prepack_mkl_sgemm_prepack(
+          Symbol::fromQualString("ipex_prepack::mkl_sgemm_prepack")),
+      ipex_prepack_mkl_sgemm_run(
+          Symbol::fromQualString("ipex_prepack::mkl_sgemm_run")),
+      ipex_LlgaFusionGroup(Symbol::fromQualString("ipex::LlgaFusionGroup")),
+      ipex_split_tensor(Symbol::fromQualString("ipex::split_tensor")),
+      ipex_snapshot_constant(Symbol::fromQualString("ipex::snapshot_constant")),
+      ipex_einsum(Symbol::fromQualString("ipex::einsum")),
+      ipex_einsum_binary(Symbol::fromQualString("ipex::einsum_binary")),
+      quantized_linear_dynamic(
+          Symbol::fromQualString("quantized::linear_dynamic")),
+      prim_TensorExprGroup(Symbol::fromQualString("prim::TensorExprGroup")),
+      llga_Select(Symbol::fromQualString("llga::Select")) {}
+
+const IpexOpSymbols& ipex_op_symbols() {
+  static IpexOpSymbols table;
+  return table;
+}
+
+void init_op_symbol_table() {
+  (void)ipex_op_symbols();
+}
+
+} // namespace jit
+} // namespace torch_ipex
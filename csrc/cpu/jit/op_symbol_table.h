@@ -0,0 +1,55 @@
+#pragma once
+
+#include <torch/csrc/jit/ir/ir.h>
+
+namespace torch_ipex {
+namespace jit {
+
+// Flat table of pre-interned operator symbols for the custom ops the
+// fusion passes and the registration interface touch on every graph
+// compile. Symbol::fromQualString parses the qualified name and takes
+// the intern-registry lock on each call; under per-tenant model churn
+// (hundreds of graph loads per hour) the repeated interning shows up in
+// graph spin-up profiles. The table is built once, forced at library
+// init by init_op_symbol_table(), and the passes read plain struct
+// members afterwards.
+struct IpexOpSymbols {
+  // torch_ipex:: ops
+  c10::Symbol torch_ipex_convolution_forward;
+  c10::Symbol torch_ipex_conv_transpose;
+  c10::Symbol torch_ipex_ipex_linear;
+  c10::Symbol torch_ipex_ipex_MKLSGEMM;
+  c10::Symbol torch_ipex_matmul_group;
+  c10::Symbol torch_ipex_interaction_forward;
+  c10::Symbol torch_ipex_merged_embeddingbag_cat_forward;
+  // ipex_prepack:: ops
+  c10::Symbol ipex_prepack_convolution_prepack;
+  c10::Symbol ipex_prepack_convolution_run;
+  c10::Symbol ipex_prepack_conv_transpose_prepack;
+  c10::Symbol ipex_prepack_conv_transpose_run;
+  c10::Symbol ipex_prepack_linear_prepack;
+  c10::Symbol ipex_prepack_linear_run;
+  c10::Symbol ipex_prepack_mkl_sgemm_prepack;
+  c10::Symbol ipex_prepack_mkl_sgemm_run;
+  // ipex:: ops
+  c10::Symbol ipex_LlgaFusionGroup;
+  c10::Symbol ipex_split_tensor;
+  c10::Symbol ipex_snapshot_constant;
+  c10::Symbol ipex_einsum;
+  c10::Symbol ipex_einsum_binary;
+  // foreign namespaces the passes compare against
+  c10::Symbol quantized_linear_dynamic;
+  c10::Symbol prim_TensorExprGroup;
+  c10::Symbol llga_Select;
+
+  IpexOpSymbols();
+};
+
+const IpexOpSymbols& ipex_op_symbols();
+
+// Forces the table construction during library init so the first graph
+// load does not pay for the interning.
+void init_op_symbol_table();
+
+} // namespace jit
+} // namespace torch_ipex
@@ -1,6 +1,7 @@
 //[This file is from https://github.com/pytorch/pytorch/pull/63198/files and
 // change it to adapt to CPU and IPEX]
 #include "concat_linear.h"
+#include "op_symbol_table.h"
 #include <ATen/Functions.h>
 #include <torch/csrc/jit/ir/alias_analysis.h>
 #include <torch/csrc/jit/ir/ir.h>
@@ -27,6 +28,10 @@ class ConcatLinearLayers {
       : graph_(std::move(graph)) {}
 
   bool run(std::unordered_set<Node*>& aten_linear) {
+    hoistBlockAndSubblocks(graph_->block(), aten_linear);
+    // The hoist phase moves nodes across blocks; rebuild alias info
+    // before the merge phase starts reasoning about moves.
+    aliasDb_.reset();
     handleBlockAndSubblocks(graph_->block(), aten_linear);
     return graph_modified;
   }
@@ -161,7 +166,7 @@ class ConcatLinearLayers {
           aten::split_with_sizes, {linear_node->output(0), split_idx, neg1});
     } else {
       split = graph_->create(
-          Symbol::fromQualString("ipex::split_tensor"),
+          torch_ipex::jit::ipex_op_symbols().ipex_split_tensor,
           {linear_node->output(0), split_idx});
     }
 
@@ -275,6 +280,141 @@ class ConcatLinearLayers {
     }
   }
 
+  // True when v is visible right before `owner`, i.e. defined in the
+  // block owning `owner` or in one of its enclosing blocks.
+  bool definedOutsideNode(Value* v, Node* owner) {
+    Block* def_block = v->node()->owningBlock();
+    for (Block* b = owner->owningBlock(); b != nullptr;
+         b = b->owningNode() ? b->owningNode()->owningBlock() : nullptr) {
+      if (def_block == b) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // A linear inside a branch of `if_node` may run unconditionally in
+  // front of it when its parameters are constant, all of its inputs are
+  // already visible there, and nothing ever writes to its input tensor
+  // (a branch-local mutation of the input before the linear would
+  // otherwise change what the hoisted node sees). aten::linear itself is
+  // pure, so running it on the untaken path only costs compute - which
+  // is why hoisting is further gated on having a merge partner.
+  bool isHoistableLinear(Node* n, Node* if_node) {
+    if (n->kind() != aten::linear) {
+      return false;
+    }
+    if (n->namedInput("weight")->type() == NoneType::get()) {
+      return false;
+    }
+    if (nonConstantParameters(n)) {
+      return false;
+    }
+    for (Value* input : n->inputs()) {
+      if (!definedOutsideNode(input, if_node)) {
+        return false;
+      }
+    }
+    return !getAliasDb()->hasWriters(n->inputs().at(0));
+  }
+
+  // Mirrors the compatibility checks of collectAndMergeLinearLayers so
+  // we only speculate on linears the merge phase will actually combine.
+  bool canLikelyMerge(Node* a, Node* b) {
+    if (a->kind() != b->kind()) {
+      return false;
+    }
+    auto weight_a = constant_as<Tensor>(a->namedInput("weight")).value();
+    auto weight_b = constant_as<Tensor>(b->namedInput("weight")).value();
+    if (weight_a.dtype() != weight_b.dtype() ||
+        weight_a.device() != weight_b.device() ||
+        !isNonZeroDimEqual(weight_a, weight_b)) {
+      return false;
+    }
+    auto a_has_bias = (a->namedInput("bias")->type() != NoneType::get());
+    auto b_has_bias = (b->namedInput("bias")->type() != NoneType::get());
+    return a_has_bias == b_has_bias;
+  }
+
+  // Parallel heads on the same input often sit in different branches of
+  // prim::If nodes (detection heads behind score thresholds), where the
+  // per-block merge below cannot see them. Hoist such linears in front
+  // of their prim::If so they land in this block and merge with their
+  // siblings. Hoisting is done only for linears that have at least one
+  // compatible partner on the same input - either already in this block
+  // or hoistable from another branch - so a lone branch-local linear is
+  // never made unconditional for nothing.
+  void hoistLinearsAcrossBranches(
+      Block* block,
+      std::unordered_set<Node*>& aten_linear) {
+    std::unordered_map<Value*, std::vector<Node*>> grouped_by_input;
+    std::unordered_map<Node*, Node*> owning_if;
+
+    for (Node* n : block->nodes()) {
+      if (n->kind() == aten::linear) {
+        if (n->namedInput("weight")->type() == NoneType::get() ||
+            nonConstantParameters(n)) {
+          continue;
+        }
+        grouped_by_input[n->inputs().at(0)].push_back(n);
+      } else if (n->kind() == prim::If) {
+        for (Block* branch : n->blocks()) {
+          for (Node* candidate : branch->nodes()) {
+            if (isHoistableLinear(candidate, n)) {
+              grouped_by_input[candidate->inputs().at(0)].push_back(candidate);
+              owning_if[candidate] = n;
+            }
+          }
+        }
+      }
+    }
+
+    for (auto& group : grouped_by_input) {
+      if (group.second.size() < 2) {
+        continue;
+      }
+      for (Node* candidate : group.second) {
+        auto if_it = owning_if.find(candidate);
+        if (if_it == owning_if.end()) {
+          continue; // already in this block
+        }
+        bool has_partner = false;
+        for (Node* other : group.second) {
+          if (other != candidate && canLikelyMerge(candidate, other)) {
+            has_partner = true;
+            break;
+          }
+        }
+        if (!has_partner) {
+          continue;
+        }
+        graph_modified = true;
+        Node* hoisted =
+            graph_->createClone(candidate, [](Value* v) { return v; });
+        hoisted->insertBefore(if_it->second);
+        if (aten_linear.count(candidate) != 0) {
+          aten_linear.erase(candidate);
+          aten_linear.insert(hoisted);
+        }
+        candidate->output(0)->replaceAllUsesWith(hoisted->output(0));
+        candidate->destroy();
+      }
+    }
+  }
+
+  void hoistBlockAndSubblocks(
+      Block* block,
+      std::unordered_set<Node*>& aten_linear) {
+    // Innermost blocks first, so a linear hoisted out of a nested
+    // prim::If becomes a hoist candidate of the enclosing one.
+    for (auto node : block->nodes()) {
+      for (Block* subblock : node->blocks()) {
+        hoistBlockAndSubblocks(subblock, aten_linear);
+      }
+    }
+    hoistLinearsAcrossBranches(block, aten_linear);
+  }
+
   void handleBlockAndSubblocks(
       Block* block,
       std::unordered_set<Node*>& aten_linear) {
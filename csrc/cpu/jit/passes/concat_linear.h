@@ -8,7 +8,10 @@ namespace torch_ipex {
 namespace jit {
 
 // Concats multiple linear ops with the same Tensor input
-// into a single linear op.
+// into a single linear op. Linears sitting in branches of prim::If
+// nodes are first hoisted in front of the branch when they are pure of
+// side effects and have a compatible merge partner on the same input,
+// so parallel heads split across branches still merge.
 IPEX_API bool FrozenConcatLinear(
     std::shared_ptr<torch::jit::Graph>& graph,
     std::unordered_set<torch::jit::Node*>& aten_linear);
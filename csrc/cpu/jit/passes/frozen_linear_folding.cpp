@@ -1,4 +1,5 @@
 #include <ATen/Utils.h>
+#include "op_symbol_table.h"
 #include <c10/core/ScalarType.h>
 #include <c10/util/Exception.h>
 #include <c10/util/accumulate.h>
@@ -25,14 +26,54 @@ using Tensor = at::Tensor;
 
 bool supportedLinearNode(Node* n) {
   if (n->kind() == aten::linear ||
-      n->kind() == Symbol::fromQualString("torch_ipex::ipex_linear") ||
-      n->kind() == Symbol::fromQualString("torch_ipex::ipex_MKLSGEMM")) {
+      n->kind() == torch_ipex::jit::ipex_op_symbols().torch_ipex_ipex_linear ||
+      n->kind() == torch_ipex::jit::ipex_op_symbols().torch_ipex_ipex_MKLSGEMM) {
     return true;
   } else {
     return false;
   }
 }
 
+// Walks the producer chain of an elementwise op input through single-use,
+// constant-argument aten::to dtype casts onto floating types, so that the
+// scale/shift chains coming from per-channel rescaling (e.g. linear -> to ->
+// mul -> add -> mul) still fold into the linear one step per folding
+// iteration. Returns the linear node, or nullptr when the chain does not end
+// in a supported linear.
+Node* findLinearThroughDtypeCasts(Value* v) {
+  Node* producer = v->node();
+  while (producer->kind() == aten::to) {
+    if (nonConstantParameters(producer) ||
+        producer->output()->uses().size() > 1) {
+      return nullptr;
+    }
+    // only look through pure dtype casts onto another floating type; a to()
+    // with a tensor or device argument can change more than the dtype
+    auto cast_dtype = constant_as<int64_t>(producer->inputs().at(1));
+    if (!cast_dtype ||
+        !c10::isFloatingType(static_cast<c10::ScalarType>(*cast_dtype))) {
+      return nullptr;
+    }
+    producer = producer->inputs().at(0)->node();
+  }
+  return supportedLinearNode(producer) ? producer : nullptr;
+}
+
+// When folding through a dtype cast, the elementwise op result must already
+// be in the cast dtype, otherwise its consumers would observe a different
+// type after the op is removed (e.g. a bf16 cast followed by a mul with an
+// fp32 scale promotes back to fp32).
+bool castChainKeepsOpDtype(Value* chain_output, Node* op) {
+  auto chain_type = chain_output->type()->cast<TensorType>();
+  auto op_type = op->output()->type()->cast<TensorType>();
+  if (!chain_type || !op_type) {
+    return false;
+  }
+  auto chain_dtype = chain_type->scalarType();
+  auto op_dtype = op_type->scalarType();
+  return chain_dtype && op_dtype && chain_dtype.value() == op_dtype.value();
+}
+
 bool checkLinearAndBroadcastingOpPreConditions(Node* linear, Node* op) {
   if (nonConstantParameters(linear) || nonConstantParameters(op)) {
     return false;
@@ -172,11 +213,16 @@ bool FoldFrozenLinearAddOrSub(Block* b) {
       graph_modified |= FoldFrozenLinearAddOrSub(block);
     }
 
+    Node* linear = nullptr;
     if (supportedAddOrSub(n) &&
-        supportedLinearNode(n->inputs().at(0)->node())) {
-      auto linear = n->inputs().at(0)->node();
+        (linear = findLinearThroughDtypeCasts(n->inputs().at(0))) != nullptr) {
       auto add_or_sub = n;
+      Value* chain_output = n->inputs().at(0);
 
+      if (chain_output != linear->output() &&
+          !castChainKeepsOpDtype(chain_output, add_or_sub)) {
+        continue;
+      }
       if (!checkLinearAndBroadcastingOpPreConditions(linear, add_or_sub)) {
         continue;
       }
@@ -198,8 +244,7 @@ bool FoldFrozenLinearAddOrSub(Block* b) {
 
       WithInsertPoint guard(linear);
 
-      add_or_sub->replaceInputWith(
-          linear->output(), b->owningGraph()->insertConstant(bias));
+      add_or_sub->replaceInput(0, b->owningGraph()->insertConstant(bias));
       add_or_sub->replaceInput(
           1, b->owningGraph()->insertConstant(add_or_sub_tensor));
 
@@ -213,7 +258,8 @@ bool FoldFrozenLinearAddOrSub(Block* b) {
           linear_b_value->debugName() + "_fused_" +
           add_or_sub->kind().toUnqualString());
       linear->replaceInputWith(linear_b_value, fused_linear_b);
-      add_or_sub->output()->replaceAllUsesWith(linear->output());
+      // keep any dtype casts between the linear and the folded op applied
+      add_or_sub->output()->replaceAllUsesWith(chain_output);
       graph_modified = true;
       // DCE run after cleans up nodes
     }
@@ -228,11 +274,16 @@ bool FoldFrozenLinearMulOrDiv(Block* b) {
       graph_modified |= FoldFrozenLinearMulOrDiv(block);
     }
 
+    Node* linear = nullptr;
     if (supportedMulOrDiv(n) &&
-        supportedLinearNode(n->inputs().at(0)->node())) {
-      auto linear = n->inputs().at(0)->node();
+        (linear = findLinearThroughDtypeCasts(n->inputs().at(0))) != nullptr) {
       auto mul_or_div = n;
+      Value* chain_output = n->inputs().at(0);
 
+      if (chain_output != linear->output() &&
+          !castChainKeepsOpDtype(chain_output, mul_or_div)) {
+        continue;
+      }
       if (!checkLinearAndBroadcastingOpPreConditions(linear, mul_or_div)) {
         continue;
       }
@@ -261,8 +312,8 @@ bool FoldFrozenLinearMulOrDiv(Block* b) {
           weight_tensor.options());
 
       // First fold with weight tensor
-      mul_or_div->replaceInputWith(
-          linear->output(), b->owningGraph()->insertConstant(weight_tensor));
+      mul_or_div->replaceInput(
+          0, b->owningGraph()->insertConstant(weight_tensor));
       mul_or_div->replaceInput(1, b->owningGraph()->insertConstant(mul_tensor));
 
       auto stack_out = runNodeIfInputsAreConstant(mul_or_div);
@@ -277,7 +328,8 @@ bool FoldFrozenLinearMulOrDiv(Block* b) {
           mul_or_div->kind().toUnqualString());
       linear->replaceInputWith(linear_weight_value, fused_linear_weight);
 
-      mul_or_div->output()->replaceAllUsesWith(linear->output());
+      // keep any dtype casts between the linear and the folded op applied
+      mul_or_div->output()->replaceAllUsesWith(chain_output);
 
       // now fold with bias tensor
       if (linear->namedInput("bias")->type() != NoneType::get()) {
@@ -323,7 +375,9 @@ bool FoldFrozenLinearMulOrDiv(std::shared_ptr<Graph>& graph) {
 }
 
 void FrozenLinearFolding(std::shared_ptr<Graph>& graph) {
-  // run a couple times to capture Conv -> Mul -> Add etc
+  // run to a fixed point to capture arbitrary affine chains such as
+  // Linear -> Mul -> Add -> Mul (possibly with dtype casts in between),
+  // folding one op per iteration
   bool changed;
   do {
     changed = false;
@@ -1,9 +1,11 @@
 #include "graph_rewrite.h"
+#include "op_symbol_table.h"
 #include "graph_rewrite_helper.h"
 #include "utils.h"
 
 #include <ATen/code_template.h>
 #include <torch/csrc/jit/passes/remove_mutation.h>
+#include "aten/EltwiseChain.h"
 #include "utils/onednn_utils.h"
 
 namespace torch_ipex {
@@ -195,6 +197,59 @@ void FuseShuffle(std::shared_ptr<Graph>& graph) {
 
 } // namespace graph_rewrite
 
+// FuseShuffleSplit folds the ShuffleNet-style shuffle -> chunk(2, dim=1)
+// chain into one op so the two branch tensors are produced in a single
+// read of the activation instead of a shuffle copy plus two split copies.
+// It runs after FuseShuffle so it only has to match the already-fused
+// ipex::shuffle_2d node.
+void FuseShuffleSplit(std::shared_ptr<Graph>& graph) {
+  std::string shuffle_then_chunk = R"(
+      graph(%input, %view_shape:int[], %trans_dim0:int, %trans_dim1:int, %chunks:int, %dim:int):
+        %r = ipex::shuffle_2d(%input, %view_shape, %trans_dim0, %trans_dim1)
+        %out = aten::chunk(%r, %chunks, %dim)
+        return (%out) )";
+
+  std::string shuffle_split_fusion = R"(
+      graph(%input, %view_shape:int[], %trans_dim0:int, %trans_dim1:int, %chunks:int, %dim:int):
+        %out = ipex::shuffle_2d_split(%input, %view_shape, %trans_dim0, %trans_dim1)
+        return (%out) )";
+
+  auto filter_shuffle_split =
+      [](const Match& match,
+         const std::unordered_map<std::string, Value*>& vmap) {
+        // current node is the "chunk" node
+        Node* node = match.anchor;
+        auto chunks_ = toIValue(node->input(1));
+        auto dim_ = toIValue(node->input(2));
+        if (!chunks_.has_value() || !dim_.has_value()) {
+          return false;
+        }
+        // only the two-way channel split of ShuffleNet blocks is fused
+        if (chunks_.value().toInt() != 2 || dim_.value().toInt() != 1) {
+          return false;
+        }
+        // the input of the shuffle node must be a 4-D tensor with a known
+        // even channel count, otherwise the two chunks may be unequal
+        auto inputType =
+            node->input(0)->node()->input(0)->type()->cast<TensorType>();
+        if (!inputType || !inputType->dim().has_value() ||
+            inputType->dim().value() != 4) {
+          return false;
+        }
+        auto inputTensor = *inputType;
+        if (!inputTensor.sizes()[1].has_value() ||
+            (inputTensor.sizes()[1].value() % 2) != 0) {
+          return false;
+        }
+        return true;
+      };
+
+  SubgraphRewriter rewriter_shuffle_split;
+  rewriter_shuffle_split.RegisterRewritePattern(
+      shuffle_then_chunk, shuffle_split_fusion);
+  rewriter_shuffle_split.runOnGraph(graph, filter_shuffle_split);
+}
+
 void FuseRMSNorm(std::shared_ptr<Graph>& graph) {
   std::string aten_RMSNorm = R"(
       graph(%hidden_states, %weight, %exponent:int, %dim:int[], %keepdim:bool, %dtype:NoneType, %eps:float, %alpha:int):
@@ -214,6 +269,28 @@ void FuseRMSNorm(std::shared_ptr<Graph>& graph) {
   rewriter_aten.runOnGraph(graph);
 }
 
+// Smooth-quant INT8 graphs quantize the rmsnorm output right before the
+// INT8 linear (the per-channel smoothing factors are already folded into
+// the norm weight by the quantization flow). Fold the quantize into the
+// rmsnorm kernel so the hidden states are traversed once instead of
+// twice per layer. Runs after FuseRMSNorm, which creates the
+// ipex::RMSNorm node this pattern matches.
+void FuseRMSNormQuant(std::shared_ptr<Graph>& graph) {
+  std::string rmsnorm_quantize = R"(
+      graph(%a, %w, %eps:float, %o_scale:float, %o_zp:int, %o_dtype:int):
+        %r = ipex::RMSNorm(%a, %w, %eps)
+        %qout = aten::quantize_per_tensor(%r, %o_scale, %o_zp, %o_dtype)
+        return (%qout) )";
+  std::string fused_rmsnorm_quant = R"(
+      graph(%a, %w, %eps:float, %o_scale:float, %o_zp:int, %o_dtype:int):
+        %smooth : NoneType = prim::Constant()
+        %qout = ipex::rmsnorm_quant(%a, %w, %eps, %smooth, %o_scale, %o_zp, %o_dtype)
+        return (%qout) )";
+  SubgraphRewriter rewriter_quant;
+  rewriter_quant.RegisterRewritePattern(rmsnorm_quantize, fused_rmsnorm_quant);
+  rewriter_quant.runOnGraph(graph);
+}
+
 void FuseAddLayerNorm(std::shared_ptr<Graph>& graph) {
   std::string aten_add_layernorm = R"(
       graph(%add_a, %add_b, %alpha, %shape:int[], %w, %b, %eps:float, %cudnn_enable:bool):
@@ -695,7 +772,7 @@ void replaceInteractionWithQInteraction(std::shared_ptr<Graph>& graph) {
 
   for (auto* n : graph->block()->nodes()) {
     if (n->kind() ==
-        Symbol::fromQualString("torch_ipex::interaction_forward")) {
+        torch_ipex::jit::ipex_op_symbols().torch_ipex_interaction_forward) {
       size_t id = 0;
       auto ListConstructNode = n->input(0)->node();
 
@@ -767,7 +844,7 @@ void replaceMergedEmbCatWithQmergedEmbCat(std::shared_ptr<Graph>& graph) {
 
   for (auto* n : graph->block()->nodes()) {
     if (n->kind() ==
-        Symbol::fromQualString("torch_ipex::merged_embeddingbag_cat_forward")) {
+        torch_ipex::jit::ipex_op_symbols().torch_ipex_merged_embeddingbag_cat_forward) {
       size_t id = 0;
       auto weightslist = n->input(0)->node();
 
@@ -1086,12 +1163,12 @@ void FuseConcatBnRelu(std::shared_ptr<Graph>& graph) {
           (tensor.scalarType().value() == at::kFloat ||
            tensor.scalarType().value() == at::kBFloat16 ||
            tensor.scalarType().value() == at::kHalf) &&
-          tensor.sizes()[1].value() % 16 == 0 &&
           utils::is_channelslast(tensor));
     };
     // Check if the dimension of the first tensor is either 4 or 5.
-    // Check if the data type, the size of Channels, and the memory format are
-    // float, mutiples of 16, and ChannelsLast(3d), respectively.
+    // Check if the data type and the memory format are float and
+    // ChannelsLast(3d), respectively. The channel counts may be arbitrary:
+    // the kernel covers vector tails with masked loads/stores.
     if (!(tensor1->dim().value() == 4 || tensor1->dim().value() == 5) ||
         !check_type_channelsize(*tensor1)) {
       return false;
@@ -1130,6 +1207,271 @@ void FuseConcatBnRelu(std::shared_ptr<Graph>& graph) {
   rewriter_concatbnrelu.runOnGraph(graph, fusion_filter);
 }
 
+// Fold the frozen inference BN + (optional residual add) + ReLU chain into
+// ipex::batch_norm_add_relu, a single per-channel scale-shift pass. The
+// scale/beta arithmetic in the replacement runs on the frozen running
+// statistics, so constant propagation turns it into two constant tensors.
+void FuseFrozenBatchNormAddRelu(std::shared_ptr<Graph>& graph) {
+  std::string aten_bn_add_relu = R"(
+      graph(%input, %other, %alpha, %weight, %bias, %running_mean, %running_var, %training, %momentum, %eps, %cudnn_enabled):
+        %a = aten::batch_norm(%input, %weight, %bias, %running_mean, %running_var, %training, %momentum, %eps, %cudnn_enabled)
+        %b = aten::add(%a, %other, %alpha)
+        %c = aten::relu(%b)
+        return (%c) )";
+  // The residual may sit on either side of the add.
+  std::string aten_bn_add_relu_flipped = R"(
+      graph(%input, %other, %alpha, %weight, %bias, %running_mean, %running_var, %training, %momentum, %eps, %cudnn_enabled):
+        %a = aten::batch_norm(%input, %weight, %bias, %running_mean, %running_var, %training, %momentum, %eps, %cudnn_enabled)
+        %b = aten::add(%other, %a, %alpha)
+        %c = aten::relu(%b)
+        return (%c) )";
+  std::string fused_bn_add_relu = R"(
+      graph(%input, %other, %alpha, %weight, %bias, %running_mean, %running_var, %training, %momentum, %eps, %cudnn_enabled):
+        %alpha1: int = prim::Constant[value=1]()
+        %u1 = aten::add(%running_var, %eps, %alpha1)
+        %u2 = aten::sqrt(%u1)
+        %scale = aten::div(%weight, %u2)
+        %u3 = aten::mul(%running_mean, %scale)
+        %beta = aten::sub(%bias, %u3, %alpha1)
+        %b = ipex::batch_norm_add_relu(%input, %scale, %beta, %other, %weight, %bias, %running_mean, %running_var, %training, %momentum, %eps, %cudnn_enabled)
+        return (%b) )";
+  std::string aten_bn_relu = R"(
+      graph(%input, %weight, %bias, %running_mean, %running_var, %training, %momentum, %eps, %cudnn_enabled):
+        %a = aten::batch_norm(%input, %weight, %bias, %running_mean, %running_var, %training, %momentum, %eps, %cudnn_enabled)
+        %c = aten::relu(%a)
+        return (%c) )";
+  std::string fused_bn_relu = R"(
+      graph(%input, %weight, %bias, %running_mean, %running_var, %training, %momentum, %eps, %cudnn_enabled):
+        %alpha1: int = prim::Constant[value=1]()
+        %none : NoneType = prim::Constant()
+        %u1 = aten::add(%running_var, %eps, %alpha1)
+        %u2 = aten::sqrt(%u1)
+        %scale = aten::div(%weight, %u2)
+        %u3 = aten::mul(%running_mean, %scale)
+        %beta = aten::sub(%bias, %u3, %alpha1)
+        %b = ipex::batch_norm_add_relu(%input, %scale, %beta, %none, %weight, %bias, %running_mean, %running_var, %training, %momentum, %eps, %cudnn_enabled)
+        return (%b) )";
+
+  auto bn_fusion_filter = [](const Match& match,
+                             const std::unordered_map<std::string, Value*>&
+                                 vmap) {
+    const auto& match_vmap = match.values_map;
+    // Only frozen inference bn: the training flag must be the constant
+    // false so the running statistics fully define the affine transform.
+    auto training = torch_ipex::jit::graph_rewrite_helper::getIValue(
+        "training", match_vmap, vmap);
+    if (!training.has_value() || !training->isBool() || training->toBool()) {
+      return false;
+    }
+    // Check dimension, data type and memory format of the activations;
+    // the channel counts may be arbitrary since the kernel covers vector
+    // tails with masked loads/stores.
+    auto input_type = match_vmap.at(vmap.at("input"))->type()->cast<TensorType>();
+    if (!input_type || !input_type->dim().has_value() ||
+        !input_type->scalarType().has_value()) {
+      return false;
+    }
+    if (!(input_type->dim().value() == 4 || input_type->dim().value() == 5)) {
+      return false;
+    }
+    auto scalar_type = input_type->scalarType().value();
+    if (!(scalar_type == at::kFloat || scalar_type == at::kBFloat16 ||
+          scalar_type == at::kHalf)) {
+      return false;
+    }
+    if (!utils::is_channelslast(*input_type)) {
+      return false;
+    }
+    // Check if the BN weights is fp32 datatype; the scale/beta math in the
+    // replacement graph runs on it.
+    auto weight_type =
+        match_vmap.at(vmap.at("weight"))->type()->cast<TensorType>();
+    if (!weight_type || !weight_type->scalarType().has_value() ||
+        weight_type->scalarType().value() != at::kFloat) {
+      return false;
+    }
+    return true;
+  };
+  auto bn_add_fusion_filter =
+      [&bn_fusion_filter](
+          const Match& match,
+          const std::unordered_map<std::string, Value*>& vmap) {
+        // The fused kernel folds the residual with an implicit alpha of 1.
+        auto alpha = torch_ipex::jit::graph_rewrite_helper::getIValue(
+            "alpha", match.values_map, vmap);
+        if (!alpha.has_value() || !alpha->isInt() || alpha->toInt() != 1) {
+          return false;
+        }
+        return bn_fusion_filter(match, vmap);
+      };
+
+  SubgraphRewriter rewriter_bnaddrelu;
+  rewriter_bnaddrelu.RegisterRewritePattern(
+      aten_bn_add_relu, fused_bn_add_relu);
+  rewriter_bnaddrelu.RegisterRewritePattern(
+      aten_bn_add_relu_flipped, fused_bn_add_relu);
+  rewriter_bnaddrelu.runOnGraph(graph, bn_add_fusion_filter);
+
+  SubgraphRewriter rewriter_bnrelu;
+  rewriter_bnrelu.RegisterRewritePattern(aten_bn_relu, fused_bn_relu);
+  rewriter_bnrelu.runOnGraph(graph, bn_fusion_filter);
+}
+
+namespace {
+
+using EltwiseChainOp = torch_ipex::cpu::EltwiseChainOp;
+
+// Map an eligible unary / binary-with-constant node to its chain opcode
+// and constant. Binary ops qualify only when the tensor flows through
+// input 0 and the other operand is a constant scalar (add/sub also need
+// the implicit alpha to be 1).
+c10::optional<std::pair<int64_t, double>> eltwise_chain_step(Node* n) {
+  auto as_const_scalar = [](Value* v) -> c10::optional<double> {
+    auto iv = toIValue(v);
+    if (!iv.has_value() || !iv->isScalar()) {
+      return c10::nullopt;
+    }
+    return iv->toScalar().toDouble();
+  };
+  auto make = [](EltwiseChainOp op, double alpha = 0.0) {
+    return c10::optional<std::pair<int64_t, double>>(
+        {static_cast<int64_t>(op), alpha});
+  };
+
+  if (n->outputs().size() != 1 || !n->output()->type()->cast<TensorType>()) {
+    return c10::nullopt;
+  }
+  if (n->kind() == aten::relu) {
+    return make(EltwiseChainOp::kRelu);
+  } else if (n->kind() == aten::sigmoid) {
+    return make(EltwiseChainOp::kSigmoid);
+  } else if (n->kind() == aten::tanh) {
+    return make(EltwiseChainOp::kTanh);
+  } else if (n->kind() == aten::exp) {
+    return make(EltwiseChainOp::kExp);
+  } else if (n->kind() == aten::log) {
+    return make(EltwiseChainOp::kLog);
+  } else if (n->kind() == aten::sqrt) {
+    return make(EltwiseChainOp::kSqrt);
+  } else if (n->kind() == aten::abs) {
+    return make(EltwiseChainOp::kAbs);
+  } else if (n->kind() == aten::neg) {
+    return make(EltwiseChainOp::kNeg);
+  } else if (n->kind() == aten::square) {
+    return make(EltwiseChainOp::kSquare);
+  } else if (
+      (n->kind() == aten::add || n->kind() == aten::sub) &&
+      n->inputs().size() == 3) {
+    auto scalar = as_const_scalar(n->input(1));
+    auto alpha = as_const_scalar(n->input(2));
+    if (!scalar.has_value() || !alpha.has_value() || alpha.value() != 1.0) {
+      return c10::nullopt;
+    }
+    return make(
+        EltwiseChainOp::kAddScalar,
+        n->kind() == aten::sub ? -scalar.value() : scalar.value());
+  } else if (
+      (n->kind() == aten::mul || n->kind() == aten::div) &&
+      n->inputs().size() == 2) {
+    auto scalar = as_const_scalar(n->input(1));
+    if (!scalar.has_value()) {
+      return c10::nullopt;
+    }
+    if (n->kind() == aten::div) {
+      if (scalar.value() == 0.0) {
+        return c10::nullopt;
+      }
+      return make(EltwiseChainOp::kMulScalar, 1.0 / scalar.value());
+    }
+    return make(EltwiseChainOp::kMulScalar, scalar.value());
+  } else if (
+      (n->kind() == aten::clamp_min || n->kind() == aten::clamp_max) &&
+      n->inputs().size() == 2) {
+    auto scalar = as_const_scalar(n->input(1));
+    if (!scalar.has_value()) {
+      return c10::nullopt;
+    }
+    return make(
+        n->kind() == aten::clamp_min ? EltwiseChainOp::kClampMin
+                                     : EltwiseChainOp::kClampMax,
+        scalar.value());
+  }
+  return c10::nullopt;
+}
+
+void FuseEltwiseChainsInBlock(Block* block, std::shared_ptr<Graph>& graph) {
+  for (Node* node : block->nodes()) {
+    for (Block* sub : node->blocks()) {
+      FuseEltwiseChainsInBlock(sub, graph);
+    }
+  }
+
+  // Phase 1: collect maximal chains. A chain grows while the current
+  // output has exactly one use, in the same block, and that use is
+  // itself an eligible step.
+  std::vector<std::vector<Node*>> chains;
+  std::unordered_set<Node*> consumed;
+  for (Node* node : block->nodes()) {
+    if (consumed.count(node) || !eltwise_chain_step(node).has_value()) {
+      continue;
+    }
+    std::vector<Node*> chain{node};
+    Node* cur = node;
+    while (true) {
+      Value* out = cur->output();
+      if (out->uses().size() != 1) {
+        break;
+      }
+      Node* next = out->uses()[0].user;
+      if (next->owningBlock() != block || next->input(0) != out ||
+          !eltwise_chain_step(next).has_value()) {
+        break;
+      }
+      chain.push_back(next);
+      cur = next;
+    }
+    for (Node* n : chain) {
+      consumed.insert(n);
+    }
+    if (chain.size() >= 2) {
+      chains.push_back(std::move(chain));
+    }
+  }
+
+  // Phase 2: replace each chain with one ipex::eltwise_chain node.
+  for (auto& chain : chains) {
+    std::vector<int64_t> ops;
+    std::vector<double> alphas;
+    for (Node* n : chain) {
+      auto step = eltwise_chain_step(n).value();
+      ops.push_back(step.first);
+      alphas.push_back(step.second);
+    }
+    Node* last = chain.back();
+    WithInsertPoint guard(last);
+    Value* ops_v = graph->insertConstant(ops);
+    Value* alphas_v = graph->insertConstant(alphas);
+    Node* fused = graph->create(
+        Symbol::fromQualString("ipex::eltwise_chain"),
+        {chain.front()->input(0), ops_v, alphas_v});
+    fused->output()->setType(last->output()->type());
+    fused->insertBefore(last);
+    last->output()->replaceAllUsesWith(fused->output());
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+      (*it)->destroy();
+    }
+  }
+}
+
+} // namespace
+
+// Harvest runs of unary / binary-with-constant eltwise ops (length >= 2)
+// into single-pass ipex::eltwise_chain nodes. Runs after the dedicated
+// fusions, so it only collapses the chains they left behind.
+void FuseEltwiseChains(std::shared_ptr<Graph>& graph) {
+  FuseEltwiseChainsInBlock(graph->block(), graph);
+}
+
 void FuseLinearSwishCustomized(std::shared_ptr<Graph>& graph) {
   std::string linear_swish = R"(
       graph(%x, %weight, %bias):
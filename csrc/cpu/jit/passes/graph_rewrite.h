@@ -12,6 +12,7 @@ namespace jit {
 namespace graph_rewrite {
 
 void FuseShuffle(std::shared_ptr<torch::jit::Graph>& graph);
+void FuseShuffleSplit(std::shared_ptr<torch::jit::Graph>& graph);
 void PostScalarDivOrMul(std::shared_ptr<torch::jit::Graph>& graph);
 void FuseMHAScoreCalc(std::shared_ptr<torch::jit::Graph>& graph);
 void FuseLinearSwishCustomized(std::shared_ptr<torch::jit::Graph>& graph);
@@ -59,14 +60,18 @@ void insertPrePackedLinearOp(
     std::shared_ptr<torch::jit::Graph>& graph,
     std::unordered_set<torch::jit::Node*>& aten_linear,
     const bool& use_mkl_sgemm);
+void fuseLinearEpilogueChain(std::shared_ptr<torch::jit::Graph>& graph);
 void fuseLinearWithEltwise(std::shared_ptr<torch::jit::Graph>& graph);
 void fuseLinearAddRelu(std::shared_ptr<torch::jit::Graph>& graph);
 void fuseLinearMulAdd(std::shared_ptr<torch::jit::Graph>& graph);
 
 void FuseRMSNorm(std::shared_ptr<torch::jit::Graph>& graph);
+void FuseRMSNormQuant(std::shared_ptr<torch::jit::Graph>& graph);
 void FuseAddLayerNorm(std::shared_ptr<torch::jit::Graph>& graph);
 void FuseMatmulDivOrMul(std::shared_ptr<torch::jit::Graph>& graph);
 void FuseConcatBnRelu(std::shared_ptr<torch::jit::Graph>& graph);
+void FuseFrozenBatchNormAddRelu(std::shared_ptr<torch::jit::Graph>& graph);
+void FuseEltwiseChains(std::shared_ptr<torch::jit::Graph>& graph);
 
 void insertPrePackedConvTransposeOp(std::shared_ptr<torch::jit::Graph>& graph);
 void fuseConvTransposeWithEltwise(std::shared_ptr<torch::jit::Graph>& graph);
@@ -75,6 +80,7 @@ void fuseConvTransposeAdd(std::shared_ptr<torch::jit::Graph>& graph);
 void FusedEinsumPost(std::shared_ptr<torch::jit::Graph>& graph);
 
 void FusedTransFreeMha(std::shared_ptr<torch::jit::Graph>& graph);
+void FuseRopeAndRepeatKV(std::shared_ptr<torch::jit::Graph>& graph);
 void FusePythonGELUWithAten(std::shared_ptr<torch::jit::Graph>& graph);
 } // namespace graph_rewrite
 } // namespace jit
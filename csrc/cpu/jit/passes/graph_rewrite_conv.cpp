@@ -1,4 +1,5 @@
 #include <ideep.hpp>
+#include "op_symbol_table.h"
 #include "aten/WeightPack.h"
 #include "cpu/kernels/OpContext.h"
 #include "graph_rewrite.h"
@@ -24,7 +25,7 @@ void replaceFrozenIPEXConvWithAtenConv(
       replaceFrozenIPEXConvWithAtenConv(block, get_data_handle_nodes);
     }
     if (n->kind() ==
-        Symbol::fromQualString("torch_ipex::convolution_forward")) {
+        torch_ipex::jit::ipex_op_symbols().torch_ipex_convolution_forward) {
       if (!(constant_as<at::Tensor>(n->namedInput("weight")).has_value())) {
         continue;
       }
@@ -159,7 +160,7 @@ void insertPrePackedConvOp(Block* b) {
         // is also inserted into the graph. Details ref to "linear_prepack"
         // creation in "graph_rewrite_linear.cpp"
         prepack_node = graph->create(
-            Symbol::fromQualString("ipex_prepack::convolution_prepack"), 1);
+            torch_ipex::jit::ipex_op_symbols().ipex_prepack_convolution_prepack, 1);
         for (auto i = 1; i < n->inputs().size() - 1; ++i) {
           Value* v = n->inputs().at(i);
           prepack_node->addInput(v);
@@ -169,7 +170,7 @@ void insertPrePackedConvOp(Block* b) {
         prepack_node->addInput(weight_is_channels_last);
       } else {
         prepack_node = graph->create(
-            Symbol::fromQualString("ipex_prepack::convolution_prepack"), 1);
+            torch_ipex::jit::ipex_op_symbols().ipex_prepack_convolution_prepack, 1);
         for (auto i = 1; i < n->inputs().size(); ++i) {
           Value* v = n->inputs().at(i);
           prepack_node->addInput(v);
@@ -182,7 +183,7 @@ void insertPrePackedConvOp(Block* b) {
 
       graph->insertNode(prepack_node);
       auto prepack_conv = graph->insertNode(graph->create(
-          Symbol::fromQualString("ipex_prepack::convolution_run"), 1));
+          torch_ipex::jit::ipex_op_symbols().ipex_prepack_convolution_run, 1));
       prepack_conv->addInput(n->inputs().at(0));
       prepack_conv->addInput(prepack_node->output());
       prepack_conv->output()->setType(n->output()->type()->cast<TensorType>());
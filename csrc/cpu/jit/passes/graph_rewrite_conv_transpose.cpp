@@ -1,4 +1,5 @@
 #include <ideep.hpp>
+#include "op_symbol_table.h"
 #include "graph_rewrite.h"
 #include "graph_rewrite_utils.h"
 #include "utils.h"
@@ -103,7 +104,7 @@ void insertPrePackedConvTransposeOpForATen(Block* b) {
       // it is also inserted into the graph. Details ref to "linear_prepack"
       // creation in "graph_rewrite_linear.cpp"
       auto prepack_node = graph->create(
-          Symbol::fromQualString("ipex_prepack::conv_transpose_prepack"), 1);
+          torch_ipex::jit::ipex_op_symbols().ipex_prepack_conv_transpose_prepack, 1);
       for (auto i = 1; i < n->inputs().size(); ++i) {
         Value* v = n->inputs().at(i);
         prepack_node->addInput(v);
@@ -117,7 +118,7 @@ void insertPrePackedConvTransposeOpForATen(Block* b) {
 
       graph->insertNode(prepack_node);
       auto prepack_conv_transpose = graph->insertNode(graph->create(
-          Symbol::fromQualString("ipex_prepack::conv_transpose_run"), 1));
+          torch_ipex::jit::ipex_op_symbols().ipex_prepack_conv_transpose_run, 1));
       prepack_conv_transpose->addInput(n->inputs().at(0));
       prepack_conv_transpose->addInput(prepack_node->output());
       prepack_conv_transpose->output()->setType(
@@ -137,7 +138,7 @@ void mayRePackConvTransposeOpForIpex(Block* b) {
       mayRePackConvTransposeOpForIpex(block);
     }
     // TODO: add conv_transpose3d
-    if (n->kind() == Symbol::fromQualString("torch_ipex::conv_transpose")) {
+    if (n->kind() == torch_ipex::jit::ipex_op_symbols().torch_ipex_conv_transpose) {
       WithInsertPoint guard(n);
       auto graph = n->owningGraph();
       auto input_size_option = n->inputs()
@@ -162,7 +163,7 @@ void mayRePackConvTransposeOpForIpex(Block* b) {
                                       .toCustomClass<ConvTransposeOpContext>();
       convtranspose_op_ctx->may_repack(input_size_option.value());
       auto prepack_convtranspose = graph->insertNode(graph->create(
-          Symbol::fromQualString("ipex_prepack::conv_transpose_run"), 1));
+          torch_ipex::jit::ipex_op_symbols().ipex_prepack_conv_transpose_run, 1));
       prepack_convtranspose->addInput(n->inputs().at(0));
       prepack_convtranspose->addInput(prepack_node);
       prepack_convtranspose->output()->setType(
@@ -1,9 +1,14 @@
 #include "graph_rewrite.h"
+#include "op_symbol_table.h"
 #include "graph_rewrite_helper.h"
 #include "graph_rewrite_utils.h"
 
 #include <ATen/code_template.h>
 
+#include <algorithm>
+#include <cctype>
+#include <tuple>
+
 namespace torch_ipex {
 namespace jit {
 namespace graph_rewrite {
@@ -11,6 +16,153 @@ namespace graph_rewrite {
 using namespace at::jit;
 using namespace torch::jit;
 
+namespace {
+
+// Compute the physical dim order that sumproduct_pair wants for one operand
+// of a two-operand contraction: the batch dims shared with the other operand
+// first (in output order), then for the left operand its own output dims
+// followed by the contraction dims, and for the right operand the
+// contraction dims followed by its own output dims. The contraction dims are
+// ordered by label index to match einsum_prepare. Returns false when the
+// equation is not a plain explicit two-operand contraction (ellipsis,
+// repeated labels, implicit output) since then the runtime dim
+// classification cannot be derived from the labels alone.
+bool computeEinsumPackOrder(
+    const std::string& equation,
+    bool is_right,
+    std::vector<int64_t>& order) {
+  const auto arrow_pos = equation.find("->");
+  if (arrow_pos == std::string::npos) {
+    return false;
+  }
+  std::string lhs = equation.substr(0, arrow_pos);
+  std::string out = equation.substr(arrow_pos + 2);
+  lhs.erase(std::remove(lhs.begin(), lhs.end(), ' '), lhs.end());
+  out.erase(std::remove(out.begin(), out.end(), ' '), out.end());
+  const auto comma_pos = lhs.find(',');
+  if (comma_pos == std::string::npos ||
+      lhs.find(',', comma_pos + 1) != std::string::npos) {
+    return false;
+  }
+  std::string self = is_right ? lhs.substr(comma_pos + 1) : lhs.substr(0, comma_pos);
+  std::string other = is_right ? lhs.substr(0, comma_pos) : lhs.substr(comma_pos + 1);
+  auto has_dup = [](const std::string& s) {
+    for (size_t i = 0; i < s.size(); ++i) {
+      if (s.find(s[i], i + 1) != std::string::npos) {
+        return true;
+      }
+    }
+    return false;
+  };
+  if (has_dup(self) || has_dup(other) || has_dup(out) ||
+      self.find('.') != std::string::npos ||
+      other.find('.') != std::string::npos ||
+      out.find('.') != std::string::npos) {
+    return false;
+  }
+  // (group, rank, dim) sort keys per dim of this operand
+  std::vector<std::tuple<int, int, int64_t>> keys;
+  for (size_t j = 0; j < self.size(); ++j) {
+    const char label = self[j];
+    if (!std::isalpha(static_cast<unsigned char>(label))) {
+      return false;
+    }
+    const auto out_pos = out.find(label);
+    const bool in_other = other.find(label) != std::string::npos;
+    int group = 0;
+    int rank = 0;
+    if (out_pos != std::string::npos) {
+      // output dim: shared batch dims first, own output dims on the side
+      // sumproduct_pair puts them (before sum dims for left, after for right)
+      group = in_other ? 0 : (is_right ? 2 : 1);
+      rank = static_cast<int>(out_pos);
+    } else if (in_other) {
+      // contraction dim: einsum_prepare appends these in label index order
+      group = is_right ? 1 : 2;
+      rank = std::isupper(static_cast<unsigned char>(label))
+          ? label - 'A'
+          : 26 + (label - 'a');
+    } else {
+      // reduced before the matmul; layout is irrelevant, do not repack
+      return false;
+    }
+    keys.emplace_back(group, rank, static_cast<int64_t>(j));
+  }
+  std::sort(keys.begin(), keys.end());
+  order.clear();
+  for (const auto& key : keys) {
+    order.push_back(std::get<2>(key));
+  }
+  return true;
+}
+
+// For ipex::einsum/ipex::einsum_binary nodes whose operand list holds a
+// frozen constant tensor, replace the constant with a logically identical
+// tensor whose memory is laid out in the order the kernel will permute it
+// into, so the permute at runtime yields a contiguous (or brgemm-friendly)
+// view and no per-call packing copy is needed.
+void prepackEinsumConstantOperands(Block* block, std::shared_ptr<Graph>& graph) {
+  for (auto* node : block->nodes()) {
+    for (auto* sub : node->blocks()) {
+      prepackEinsumConstantOperands(sub, graph);
+    }
+    if (node->kind() != torch_ipex::jit::ipex_op_symbols().ipex_einsum &&
+        node->kind() != torch_ipex::jit::ipex_op_symbols().ipex_einsum_binary) {
+      continue;
+    }
+    auto equation_iv = toIValue(node->input(0));
+    if (!equation_iv || !equation_iv->isString()) {
+      continue;
+    }
+    auto* list_node = node->input(1)->node();
+    if (list_node->kind() != prim::ListConstruct ||
+        list_node->inputs().size() != 2 ||
+        list_node->output()->uses().size() != 1) {
+      continue;
+    }
+    const auto equation = equation_iv->toStringRef();
+    for (size_t idx = 0; idx < 2; ++idx) {
+      auto tensor_iv = toIValue(list_node->input(idx));
+      if (!tensor_iv || !tensor_iv->isTensor()) {
+        continue;
+      }
+      auto tensor = tensor_iv->toTensor();
+      if (!tensor.defined() || tensor.dim() < 2 || !tensor.is_floating_point()) {
+        continue;
+      }
+      // size-1 dims flip the runtime broadcast classification; skip them
+      bool has_trivial_dim = false;
+      for (const auto d : tensor.sizes()) {
+        has_trivial_dim |= d <= 1;
+      }
+      if (has_trivial_dim) {
+        continue;
+      }
+      std::vector<int64_t> order;
+      if (!computeEinsumPackOrder(equation, idx == 1, order) ||
+          static_cast<int64_t>(order.size()) != tensor.dim()) {
+        continue;
+      }
+      auto permuted = tensor.permute(order);
+      if (permuted.is_contiguous()) {
+        continue;
+      }
+      // pack in the permuted order, then permute back so the tensor stays
+      // logically unchanged and only the underlying layout differs
+      std::vector<int64_t> inverse(order.size());
+      for (size_t i = 0; i < order.size(); ++i) {
+        inverse[order[i]] = static_cast<int64_t>(i);
+      }
+      auto packed = permuted.contiguous().permute(inverse);
+      WithInsertPoint guard(list_node);
+      auto* packed_const = graph->insertConstant(packed);
+      list_node->replaceInput(idx, packed_const);
+    }
+  }
+}
+
+} // namespace
+
 auto ipex_einsum_filter =
     [](const Match& match,
        const std::unordered_map<std::string, Value*>& vmap) {
@@ -46,6 +198,22 @@ void FusedEinsumPost(std::shared_ptr<Graph>& graph) {
         aten_einsum_binary.format(env), fused_einsum_binary);
   }
   rewriter_einsum_binary.runOnGraph(graph, ipex_einsum_filter);
+
+  // lower the remaining (un-fused) two-operand einsum contractions so they
+  // also go through the transpose-free ipex batched matmul path
+  SubgraphRewriter rewriter_einsum;
+  std::string aten_einsum = R"(
+     graph(%equation, %inputs, %path):
+        %x = aten::einsum(%equation, %inputs, %path)
+        return (%x))";
+  std::string ipex_einsum = R"(
+    graph(%equation, %inputs, %path):
+        %res = ipex::einsum(%equation, %inputs)
+        return (%res))";
+  rewriter_einsum.RegisterRewritePattern(aten_einsum, ipex_einsum);
+  rewriter_einsum.runOnGraph(graph, ipex_einsum_filter);
+
+  prepackEinsumConstantOperands(graph->block(), graph);
 }
 
 } // namespace graph_rewrite
@@ -1,4 +1,5 @@
 #include "graph_rewrite_inplace_replace.h"
+#include "op_symbol_table.h"
 #include "codegen/onednn/remove_mutation.h"
 
 namespace torch_ipex {
@@ -51,11 +52,11 @@ bool hasSideEffectOrAliasInSubgraphs(Node* node, Value* v) {
   // A LLGAFusionGroup or TensorExprGroup must have its fallbackgraph, we only
   // need to check one of them
   if (node->kind().toQualString() ==
-      Symbol::fromQualString("ipex::LlgaFusionGroup").toQualString()) {
+      torch_ipex::jit::ipex_op_symbols().ipex_LlgaFusionGroup.toQualString()) {
     return false;
   }
   if (node->kind().toQualString() ==
-      Symbol::fromQualString("prim::TensorExprGroup").toQualString()) {
+      torch_ipex::jit::ipex_op_symbols().prim_TensorExprGroup.toQualString()) {
     return false;
   }
 
@@ -183,11 +184,18 @@ std::unordered_map<std::string, int> aten_ops_args_mapping = {
     {"aten::relu", 0},
     {"aten::selu", 0},
     {"aten::celu", 1},
+    {"aten::gelu", 1},
     {"aten::leaky_relu", 1},
     {"aten::hardtanh", 2},
     {"aten::elu", 3},
     {"aten::rrelu", 4}};
 
+// binary ops need extra dtype/shape checks before going inplace (the result
+// must fit the self buffer), so they are kept out of the generic activation
+// list and rewritten with a dedicated filter
+std::unordered_map<std::string, int> aten_binary_ops_args_mapping = {
+    {"aten::add", 2}};
+
 void replaceOpsWithAtenInplaceOps(std::shared_ptr<Graph>& graph) {
   std::string input_no_args = R"(
       graph(%input):)";
@@ -286,6 +294,71 @@ void replaceOpsWithAtenInplaceOps(std::shared_ptr<Graph>& graph) {
   }
 
   rewriter_aten_inplace.runOnGraph(graph, filter_inplace);
+
+  // Forward the result of residual additions into the self buffer: when the
+  // lhs lifetime provably ends at the add, aten::add is rewritten to
+  // aten::add_ so no new output buffer is allocated. This removes the copy
+  // chain around every residual connection once the surrounding ops failed
+  // to be fused.
+  std::string aten_add = R"(
+      graph(%a, %b, %alpha):
+        %r = aten::add(%a, %b, %alpha)
+        return (%r) )";
+  std::string aten_add_ = R"(
+      graph(%a, %b, %alpha):
+        %r = aten::add_(%a, %b, %alpha)
+        return (%r) )";
+
+  // Filter the unsupported cases for inplace add
+  auto filter_inplace_for_add =
+      [graph](
+          const Match& match,
+          const std::unordered_map<std::string, Value*>& vmap) {
+        Node* node = match.anchor;
+        std::unique_ptr<AliasDb> aliasDb_ = std::make_unique<AliasDb>(graph);
+        Value* input = node->inputs().at(0);
+        Value* output = node->outputs().at(0);
+
+        // never mutate a constant (e.g. a frozen parameter): the written
+        // values would leak into the following runs
+        if (input->node()->kind() == prim::Constant) {
+          return false;
+        }
+
+        // the result must fit the self buffer exactly: same dtype and no
+        // broadcast of self towards the other operand
+        auto inputType = input->type()->cast<TensorType>();
+        auto outputType = output->type()->cast<TensorType>();
+        if (!inputType || !outputType) {
+          return false;
+        }
+        auto inputDtype = inputType->scalarType();
+        auto outputDtype = outputType->scalarType();
+        if (!inputDtype || !outputDtype ||
+            inputDtype.value() != outputDtype.value()) {
+          return false;
+        }
+        auto inputSizes = inputType->sizes().concrete_sizes();
+        auto outputSizes = outputType->sizes().concrete_sizes();
+        if (!inputSizes || !outputSizes || *inputSizes != *outputSizes) {
+          return false;
+        }
+
+        // Skip if input has more than one use
+        if (input->uses().size() > 1) {
+          return false;
+        }
+
+        // Skip if input's def node has side effect or input has alias
+        if (hasSideEffectOrAlias(input, aliasDb_.get())) {
+          return false;
+        }
+        return true;
+      };
+
+  SubgraphRewriter rewriter_add_inplace;
+  rewriter_add_inplace.RegisterRewritePattern(aten_add, aten_add_);
+  rewriter_add_inplace.runOnGraph(graph, filter_inplace_for_add);
 }
 
 void replaceInplaceOpsWithOutplaceOps(std::shared_ptr<Graph>& graph, Block* b) {
@@ -304,6 +377,16 @@ void replaceInplaceOpsWithOutplaceOps(std::shared_ptr<Graph>& graph, Block* b) {
         break;
       }
     }
+    // also restore the inplace binary ops (e.g. residual aten::add_) so that
+    // the binary fusion patterns can match them; the ones failed to be fused
+    // will be turned back by replaceOpsWithAtenInplaceOps
+    for (auto it = aten_binary_ops_args_mapping.begin();
+         !is_support && it != aten_binary_ops_args_mapping.end();
+         it++) {
+      if (std::string(n->kind().toQualString()).compare(it->first + "_") == 0) {
+        is_support = true;
+      }
+    }
     if (!is_support) {
       continue;
     }
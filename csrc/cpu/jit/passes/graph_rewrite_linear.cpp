@@ -1,4 +1,5 @@
 #include <ATen/code_template.h>
+#include "op_symbol_table.h"
 #include <ideep.hpp>
 #include "passes/utils.h"
 
@@ -26,9 +27,9 @@ void replaceFrozenIPEXLinearWithAtenLinear(
     }
 
     bool is_ipex_linear =
-        n->kind() == Symbol::fromQualString("torch_ipex::ipex_linear");
+        n->kind() == torch_ipex::jit::ipex_op_symbols().torch_ipex_ipex_linear;
     bool is_mkl_sgemm =
-        n->kind() == Symbol::fromQualString("torch_ipex::ipex_MKLSGEMM");
+        n->kind() == torch_ipex::jit::ipex_op_symbols().torch_ipex_ipex_MKLSGEMM;
     if (is_ipex_linear || is_mkl_sgemm) {
       // mkl sgemm does not support grad mode
       bool mkl_sgemm_and_grad_mode =
@@ -159,8 +160,8 @@ void replaceAtenLinearWithPrepackNode(
   auto use_mkl_sgemm_ =
       use_mkl_sgemm && weight_dtype_option.value() == at::ScalarType::Float;
   auto prepack_node = graph->create(
-      use_mkl_sgemm_ ? Symbol::fromQualString("ipex_prepack::mkl_sgemm_prepack")
-                     : Symbol::fromQualString("ipex_prepack::linear_prepack"),
+      use_mkl_sgemm_ ? torch_ipex::jit::ipex_op_symbols().ipex_prepack_mkl_sgemm_prepack
+                     : torch_ipex::jit::ipex_op_symbols().ipex_prepack_linear_prepack,
       1);
   for (auto i = 1; i < n->inputs().size(); ++i) {
     Value* v = n->inputs().at(i);
@@ -174,8 +175,8 @@ void replaceAtenLinearWithPrepackNode(
                 "__torch__.torch.classes.ipex_prepack.LinearOpContext"));
   graph->insertNode(prepack_node);
   auto prepack_linear = graph->insertNode(graph->create(
-      use_mkl_sgemm_ ? Symbol::fromQualString("ipex_prepack::mkl_sgemm_run")
-                     : Symbol::fromQualString("ipex_prepack::linear_run"),
+      use_mkl_sgemm_ ? torch_ipex::jit::ipex_op_symbols().ipex_prepack_mkl_sgemm_run
+                     : torch_ipex::jit::ipex_op_symbols().ipex_prepack_linear_run,
       1));
   prepack_linear->addInput(n->inputs().at(0));
   prepack_linear->addInput(prepack_node->output());
@@ -188,12 +189,12 @@ void replaceIpexLinearWithLinearRunNode(Node* n) {
   WithInsertPoint guard(n);
   auto graph = n->owningGraph();
   auto use_mkl_sgemm =
-      n->kind() == Symbol::fromQualString("torch_ipex::ipex_MKLSGEMM");
+      n->kind() == torch_ipex::jit::ipex_op_symbols().torch_ipex_ipex_MKLSGEMM;
   auto get_data_handle_node = n->inputs().at(3)->node();
   auto linear_ctx = get_data_handle_node->inputs().at(0);
   auto linear_run = graph->insertNode(graph->create(
-      use_mkl_sgemm ? Symbol::fromQualString("ipex_prepack::mkl_sgemm_run")
-                    : Symbol::fromQualString("ipex_prepack::linear_run"),
+      use_mkl_sgemm ? torch_ipex::jit::ipex_op_symbols().ipex_prepack_mkl_sgemm_run
+                    : torch_ipex::jit::ipex_op_symbols().ipex_prepack_linear_run,
       1));
   linear_run->addInput(n->inputs().at(0));
   linear_run->addInput(linear_ctx);
@@ -213,8 +214,8 @@ void insertPrePackedLinearOp(
     if (n->kind() == aten::linear) {
       replaceAtenLinearWithPrepackNode(n, aten_linear, use_mkl_sgemm);
     } else if (
-        n->kind() == Symbol::fromQualString("torch_ipex::ipex_linear") ||
-        n->kind() == Symbol::fromQualString("torch_ipex::ipex_MKLSGEMM")) {
+        n->kind() == torch_ipex::jit::ipex_op_symbols().torch_ipex_ipex_linear ||
+        n->kind() == torch_ipex::jit::ipex_op_symbols().torch_ipex_ipex_MKLSGEMM) {
       replaceIpexLinearWithLinearRunNode(n);
     } else {
       continue;
@@ -241,7 +242,7 @@ void RecordAtenLinearNodes(
     if (n->kind() == aten::linear) {
       aten_linear.insert(n);
     }
-    if (n->kind() == Symbol::fromQualString("torch_ipex::ipex_MKLSGEMM")) {
+    if (n->kind() == torch_ipex::jit::ipex_op_symbols().torch_ipex_ipex_MKLSGEMM) {
       use_mkl_sgemm = true;
     }
   }
@@ -504,6 +505,162 @@ void fuseLinearMulAdd(std::shared_ptr<Graph>& graph) {
   rewriter_add_operand_on_the_left.runOnGraph(graph, fuse_binary_add_filter);
 }
 
+// Maps a candidate chain node onto an epilogue step name understood by
+// ipex_prepack::linear_epilogue_run. Parameterless eltwise ops reuse the
+// attr key from supported_unary_post_op_fusion_set(); gelu is resolved to
+// gelu_erf/gelu_tanh from its constant approximate argument.
+static bool unaryEpilogueStep(Node* n, std::string& step) {
+  auto kind = std::string(n->kind().toQualString());
+  if (kind == "aten::gelu" || kind == "aten::gelu_") {
+    if (n->inputs().size() < 2) {
+      return false;
+    }
+    auto approximate = toIValue(n->input(1));
+    if (!approximate.has_value() || !approximate.value().isString()) {
+      return false;
+    }
+    auto mode = approximate.value().toStringRef();
+    if (mode == "none") {
+      step = "gelu_erf";
+      return true;
+    } else if (mode == "tanh") {
+      step = "gelu_tanh";
+      return true;
+    }
+    return false;
+  }
+  auto& fusion_set = utils::supported_unary_post_op_fusion_set();
+  auto it = fusion_set.find(kind);
+  if (it == fusion_set.end()) {
+    return false;
+  }
+  step = it->second.ipex_op_name;
+  return true;
+}
+
+// onednn binary post ops do not broadcast here, so only accept operands
+// whose profiled shape provably equals the linear output shape.
+static bool epilogueShapesMatch(Value* chain_out, Value* operand) {
+  auto t1 = chain_out->type()->cast<TensorType>();
+  auto t2 = operand->type()->cast<TensorType>();
+  if (!t1 || !t2) {
+    return false;
+  }
+  auto size1 = t1->sizes().concrete_sizes();
+  auto size2 = t2->sizes().concrete_sizes();
+  return size1.has_value() && size2.has_value() && !size1.value().empty() &&
+      size1.value() == size2.value();
+}
+
+static bool epilogueAlphaIsOne(Value* alpha) {
+  auto val = toIValue(alpha);
+  if (!val.has_value()) {
+    return false;
+  }
+  if (val.value().isDouble()) {
+    return val.value().toDouble() == 1.0;
+  } else if (val.value().isInt()) {
+    return val.value().toInt() == 1;
+  }
+  return false;
+}
+
+static bool fuseLinearEpilogueChainOnBlock(Block* block) {
+  bool changed = false;
+  std::vector<Node*> linear_run_nodes;
+  for (Node* n : block->nodes()) {
+    for (Block* sub : n->blocks()) {
+      changed |= fuseLinearEpilogueChainOnBlock(sub);
+    }
+    if (n->kind() ==
+        Symbol::fromQualString("ipex_prepack::linear_run")) {
+      linear_run_nodes.push_back(n);
+    }
+  }
+
+  for (Node* linear : linear_run_nodes) {
+    // Walk forward through single-use pointwise users: any number of
+    // parameterless unaries, then at most one trailing elementwise
+    // add/mul. The binary must stay last so the fused node reads its
+    // extra operand at the same graph position the original op did.
+    std::vector<std::string> steps;
+    std::vector<Value*> extra_inputs;
+    std::vector<Node*> chain;
+    Value* cur = linear->output();
+    while (cur->uses().size() == 1) {
+      Node* user = cur->uses()[0].user;
+      if (user->owningBlock() != block) {
+        break;
+      }
+      std::string step;
+      if (user->inputs().size() >= 1 && user->input(0) == cur &&
+          unaryEpilogueStep(user, step)) {
+        steps.push_back(step);
+        chain.push_back(user);
+        cur = user->output();
+        continue;
+      }
+      bool is_add = user->kind() == aten::add || user->kind() == aten::add_;
+      bool is_mul = user->kind() == aten::mul || user->kind() == aten::mul_;
+      if (is_add || is_mul) {
+        bool inplace =
+            user->kind() == aten::add_ || user->kind() == aten::mul_;
+        Value* operand = nullptr;
+        if (user->input(0) == cur) {
+          operand = user->input(1);
+        } else if (!inplace && user->input(1) == cur) {
+          // in-place variants mutate input(0), which must be the
+          // single-use intermediate, not the outside operand
+          operand = user->input(0);
+        }
+        if (operand != nullptr &&
+            (!is_add || user->inputs().size() < 3 ||
+             epilogueAlphaIsOne(user->input(2))) &&
+            epilogueShapesMatch(cur, operand)) {
+          steps.push_back(is_add ? "add" : "mul");
+          extra_inputs.push_back(operand);
+          chain.push_back(user);
+          cur = user->output();
+        }
+      }
+      break;
+    }
+
+    // Length-1 chains keep the existing bespoke fused ops
+    // (linear_relu_run, linear_mul_run, ...); the generic epilogue only
+    // pays off once at least two post ops collapse into one kernel call.
+    if (steps.size() < 2) {
+      continue;
+    }
+
+    Node* last = chain.back();
+    Graph* g = block->owningGraph();
+    WithInsertPoint guard(last);
+    Value* steps_const = g->insertConstant(steps);
+    Node* list = g->create(prim::ListConstruct, extra_inputs);
+    list->output()->setType(ListType::ofTensors());
+    g->insertNode(list);
+    Node* fused = g->create(
+        Symbol::fromQualString("ipex_prepack::linear_epilogue_run"),
+        {linear->input(0), steps_const, list->output(), linear->input(1)});
+    fused->output()->setType(last->output()->type());
+    g->insertNode(fused);
+    last->output()->replaceAllUsesWith(fused->output());
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+      (*it)->destroy();
+    }
+    linear->destroy();
+    changed = true;
+  }
+  return changed;
+}
+
+void fuseLinearEpilogueChain(std::shared_ptr<Graph>& graph) {
+  while (fuseLinearEpilogueChainOnBlock(graph->block())) {
+  }
+  EliminateDeadCode(graph);
+}
+
 } // namespace graph_rewrite
 } // namespace jit
 } // namespace torch_ipex
@@ -293,6 +293,86 @@ auto split_replace_filter =
       return true;
     };
 
+auto rotary_embedding_half_filter =
+    [](const Match& match,
+       const std::unordered_map<std::string, Value*>& vmap) {
+      const auto& match_vmap = match.values_map;
+      auto get_int = [&](const char* name, int64_t& out) {
+        auto ival =
+            graph_rewrite_helper::getIValue(name, match_vmap, vmap);
+        if (!ival.has_value() || !ival.value().isInt()) {
+          return false;
+        }
+        out = ival.value().toInt();
+        return true;
+      };
+      int64_t dim1, dim2, zero, half1, half2, end, step1, step2, cat_dim,
+          alpha;
+      if (!get_int("dim1", dim1) || !get_int("dim2", dim2) ||
+          !get_int("zero", zero) || !get_int("half1", half1) ||
+          !get_int("half2", half2) || !get_int("end", end) ||
+          !get_int("step1", step1) || !get_int("step2", step2) ||
+          !get_int("cat_dim", cat_dim) || !get_int("alpha", alpha)) {
+        return false;
+      }
+      // the two slices must split the last dim of a 4-D [bs, head, seq,
+      // head_dim] tensor in halves; the traced end of the open slice is
+      // INT64_MAX, so only its lower bound is checked
+      auto is_last_dim = [](int64_t d) { return d == 3 || d == -1; };
+      if (!is_last_dim(dim1) || dim1 != dim2 || !is_last_dim(cat_dim) ||
+          zero != 0 || step1 != 1 || step2 != 1 || alpha != 1 ||
+          half1 != half2 || half1 <= 0 || end < half1) {
+        return false;
+      }
+      auto x = graph_rewrite_helper::getValue("x", match_vmap, vmap)
+                   ->type()
+                   ->cast<TensorType>();
+      if (!x->scalarType().has_value() ||
+          (x->scalarType().value() != at::kFloat &&
+           x->scalarType().value() != at::kBFloat16)) {
+        return false;
+      }
+      if (x->sizes().concrete_sizes().has_value()) {
+        auto sizes = x->sizes().concrete_sizes().value();
+        if (sizes.size() != 4 || sizes[3] != 2 * half1) {
+          return false;
+        }
+      }
+      return true;
+    };
+
+auto repeat_kv_filter =
+    [](const Match& match,
+       const std::unordered_map<std::string, Value*>& vmap) {
+      const auto& match_vmap = match.values_map;
+      auto two_value =
+          graph_rewrite_helper::getIValue("two", match_vmap, vmap);
+      auto implicit_value =
+          graph_rewrite_helper::getIValue("implicit", match_vmap, vmap);
+      auto elist_value =
+          graph_rewrite_helper::getIValue("elist", match_vmap, vmap);
+      auto rlist_value =
+          graph_rewrite_helper::getIValue("rlist", match_vmap, vmap);
+      if (!two_value.has_value() || !two_value.value().isInt() ||
+          two_value.value().toInt() != 2 || !implicit_value.has_value() ||
+          !implicit_value.value().isBool() ||
+          implicit_value.value().toBool() || !elist_value.has_value() ||
+          !elist_value.value().isIntList() || !rlist_value.has_value() ||
+          !rlist_value.value().isIntList()) {
+        return false;
+      }
+      auto elist = elist_value.value().toIntVector();
+      auto rlist = rlist_value.value().toIntVector();
+      // [bs, kv_head, n_rep, seq, head_dim] expanded then merged into
+      // [bs, kv_head * n_rep, seq, head_dim]
+      if (elist.size() != 5 || rlist.size() != 4 || elist[2] < 1 ||
+          rlist[0] != elist[0] || rlist[1] != elist[1] * elist[2] ||
+          rlist[2] != elist[3] || rlist[3] != elist[4]) {
+        return false;
+      }
+      return true;
+    };
+
 // aten::matmul - always applies contiguous to the input tensors
 // ipex::matmul - allows non-contiguous input tensors with the conditions:
 // 1. tensor1.dim1 == tensor2.dim2
@@ -583,6 +663,53 @@ void FusedTransFreeMha(std::shared_ptr<Graph>& graph) {
       bmm_outtrans_pattern_v2, fused_bmm_outtrans_pattern_v2);
   bmm_outtrans_fusion_v2.runOnGraph(graph, bmm_outtrans_filter_v2);
 }
+
+// The Llama-family attention frontend applies RoPE as
+// x * cos + rotate_half(x) * sin and repeats the key/value heads for
+// grouped queries with unsqueeze + expand + reshape. Both subgraphs
+// materialize several temporaries per layer; they are folded into the
+// single-pass ipex::rotary_embedding_half / ipex::repeat_kv kernels
+// here so the following MHA matmuls run on the fused outputs.
+void FuseRopeAndRepeatKV(std::shared_ptr<Graph>& graph) {
+  std::string rotate_half_rope_pattern = R"(
+      graph(%x: Tensor, %cos: Tensor, %sin: Tensor, %dim1: int, %dim2: int, %zero: int, %half1: int, %half2: int, %end: int, %step1: int, %step2: int, %cat_dim: int, %alpha: int):
+        %mul_cos = aten::mul(%x, %cos)
+        %x2 = aten::slice(%x, %dim2, %half2, %end, %step2)
+        %neg_x2 = aten::neg(%x2)
+        %x1 = aten::slice(%x, %dim1, %zero, %half1, %step1)
+        %rot_list = prim::ListConstruct(%neg_x2, %x1)
+        %rot = aten::cat(%rot_list, %cat_dim)
+        %mul_sin = aten::mul(%rot, %sin)
+        %out = aten::add(%mul_cos, %mul_sin, %alpha)
+        return (%out) )";
+
+  std::string fused_rope_pattern = R"(
+      graph(%x: Tensor, %cos: Tensor, %sin: Tensor, %dim1: int, %dim2: int, %zero: int, %half1: int, %half2: int, %end: int, %step1: int, %step2: int, %cat_dim: int, %alpha: int):
+        %out = ipex::rotary_embedding_half(%x, %cos, %sin)
+        return (%out) )";
+
+  SubgraphRewriter rope_fusion;
+  rope_fusion.RegisterRewritePattern(
+      rotate_half_rope_pattern, fused_rope_pattern);
+  rope_fusion.runOnGraph(graph, rotary_embedding_half_filter);
+
+  std::string repeat_kv_pattern = R"(
+      graph(%x: Tensor, %two: int, %elist: int[], %implicit: bool, %rlist: int[]):
+        %unsqueezed = aten::unsqueeze(%x, %two)
+        %expanded = aten::expand(%unsqueezed, %elist, %implicit)
+        %out = aten::reshape(%expanded, %rlist)
+        return (%out) )";
+
+  std::string fused_repeat_kv_pattern = R"(
+      graph(%x: Tensor, %two: int, %elist: int[], %implicit: bool, %rlist: int[]):
+        %out = ipex::repeat_kv(%x, %elist)
+        return (%out) )";
+
+  SubgraphRewriter repeat_kv_fusion;
+  repeat_kv_fusion.RegisterRewritePattern(
+      repeat_kv_pattern, fused_repeat_kv_pattern);
+  repeat_kv_fusion.runOnGraph(graph, repeat_kv_filter);
+}
 } // namespace graph_rewrite
 } // namespace jit
 } // namespace torch_ipex
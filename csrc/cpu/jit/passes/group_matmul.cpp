@@ -0,0 +1,204 @@
+#include "group_matmul.h"
+#include "op_symbol_table.h"
+#include <torch/csrc/jit/ir/alias_analysis.h>
+#include <torch/csrc/jit/ir/ir.h>
+#include <torch/csrc/jit/jit_log.h>
+#include <unordered_set>
+#include <vector>
+
+namespace torch_ipex {
+namespace jit {
+namespace {
+
+using namespace torch::jit;
+
+// Matmuls above this many flops (2*M*N*K, batch included) parallelize
+// well enough on their own; grouping them would only pay the stack copy
+// for nothing. 2^24 corresponds to e.g. a 256x256 @ 256x128 GEMM.
+constexpr int64_t kSmallMatmulFlops = 1LL << 24;
+
+class GroupMatmulLayers {
+ public:
+  explicit GroupMatmulLayers(std::shared_ptr<Graph> graph)
+      : graph_(std::move(graph)) {}
+
+  bool run() {
+    handleBlockAndSubblocks(graph_->block());
+    return graph_modified_;
+  }
+
+ private:
+  AliasDb* getAliasDb() {
+    if (!aliasDb_) {
+      aliasDb_ = std::make_unique<AliasDb>(graph_);
+    }
+    return aliasDb_.get();
+  }
+
+  static c10::optional<std::vector<int64_t>> concreteSizes(Value* v) {
+    auto tensor_type = v->type()->cast<TensorType>();
+    if (!tensor_type) {
+      return c10::nullopt;
+    }
+    return tensor_type->sizes().concrete_sizes();
+  }
+
+  // A candidate is a matmul whose operand shapes are statically known
+  // (the pass runs on profiled frozen graphs, so shapes usually are),
+  // floating point, and small enough that a single such GEMM cannot use
+  // more than a core or two.
+  bool isCandidate(Node* n) {
+    if (n->kind() != aten::matmul && n->kind() != aten::bmm) {
+      return false;
+    }
+    auto self_sizes = concreteSizes(n->inputs().at(0));
+    auto mat2_sizes = concreteSizes(n->inputs().at(1));
+    if (!self_sizes.has_value() || !mat2_sizes.has_value()) {
+      return false;
+    }
+    if (self_sizes->size() < 2 || self_sizes->size() != mat2_sizes->size()) {
+      return false;
+    }
+    auto scalar_type =
+        n->inputs().at(0)->type()->cast<TensorType>()->scalarType();
+    if (!scalar_type.has_value() || !c10::isFloatingType(*scalar_type)) {
+      return false;
+    }
+    int64_t flops = 2;
+    for (auto d : *self_sizes) {
+      flops *= d;
+    }
+    flops *= mat2_sizes->back();
+    return flops > 0 && flops <= kSmallMatmulFlops;
+  }
+
+  // Two candidates belong to the same group when stacking their operands
+  // yields a well-formed batch: same op, same operand shapes, same dtype
+  // and device.
+  bool sameGroup(Node* a, Node* b) {
+    if (a->kind() != b->kind()) {
+      return false;
+    }
+    for (size_t i = 0; i < 2; i++) {
+      auto type_a = a->inputs().at(i)->type()->cast<TensorType>();
+      auto type_b = b->inputs().at(i)->type()->cast<TensorType>();
+      if (concreteSizes(a->inputs().at(i)) !=
+              concreteSizes(b->inputs().at(i)) ||
+          type_a->scalarType() != type_b->scalarType() ||
+          type_a->device() != type_b->device()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void mergeMatmuls(std::vector<Node*>& group) {
+    graph_modified_ = true;
+    Node* base_node = group[0];
+
+    std::vector<Value*> selfs;
+    std::vector<Value*> mat2s;
+    for (Node* n : group) {
+      selfs.push_back(n->inputs().at(0));
+      mat2s.push_back(n->inputs().at(1));
+    }
+    Node* self_list = graph_->createList(TensorType::get(), selfs);
+    self_list->insertBefore(base_node);
+    Node* mat2_list = graph_->createList(TensorType::get(), mat2s);
+    mat2_list->insertBefore(base_node);
+
+    Node* grouped = graph_->create(
+        torch_ipex::jit::ipex_op_symbols().torch_ipex_matmul_group,
+        {self_list->output(), mat2_list->output()});
+    grouped->output(0)->setType(ListType::ofTensors());
+    grouped->insertBefore(base_node);
+
+    Node* unpack = graph_->create(
+        prim::ListUnpack, {grouped->output(0)}, group.size());
+    unpack->insertAfter(grouped);
+
+    for (size_t i = 0; i < group.size(); i++) {
+      unpack->output(i)->setType(group[i]->output(0)->type());
+      group[i]->output(0)->replaceAllUsesWith(unpack->output(i));
+      group[i]->destroy();
+    }
+  }
+
+  void collectAndMergeMatmuls(std::vector<Node*>& candidates) {
+    std::unordered_set<Node*> checked_nodes;
+
+    for (size_t i = 0; i < candidates.size(); i++) {
+      Node* base_node = candidates[i];
+      if (checked_nodes.count(base_node) != 0) {
+        continue;
+      }
+
+      std::vector<Node*> group;
+      group.push_back(base_node);
+
+      for (size_t j = i + 1; j < candidates.size(); j++) {
+        Node* node = candidates[j];
+        if (checked_nodes.count(node) != 0 || !sameGroup(base_node, node)) {
+          continue;
+        }
+        // The move both proves the matmuls are independent (it fails on
+        // any data or aliasing dependence) and lines the node up at the
+        // insertion point, so its operands are visible there.
+        bool can_move_before_all = true;
+        for (Node* n : group) {
+          can_move_before_all &=
+              getAliasDb()->moveBeforeTopologicallyValid(node, n);
+        }
+        if (!can_move_before_all) {
+          continue;
+        }
+        group.push_back(node);
+        checked_nodes.insert(node);
+      }
+      if (group.size() == 1) {
+        continue; // nothing to group with
+      }
+      mergeMatmuls(group);
+      // The rewrite created and destroyed nodes; rebuild alias info
+      // before reasoning about further moves.
+      aliasDb_.reset();
+    }
+  }
+
+  void handleBlockAndSubblocks(Block* block) {
+    for (auto node : block->nodes()) {
+      for (Block* subblock : node->blocks()) {
+        handleBlockAndSubblocks(subblock);
+      }
+    }
+
+    // Collect first, merge after: mergeMatmuls destroys nodes and must
+    // not run while iterating the block.
+    std::vector<Node*> candidates;
+    for (Node* n : block->nodes()) {
+      if (isCandidate(n)) {
+        candidates.push_back(n);
+      }
+    }
+    collectAndMergeMatmuls(candidates);
+  }
+
+  std::shared_ptr<Graph> graph_;
+  bool graph_modified_ = false;
+  std::unique_ptr<AliasDb> aliasDb_ = nullptr;
+};
+
+} // namespace
+
+bool GroupMatmul(std::shared_ptr<Graph>& graph) {
+  GroupMatmulLayers group_matmuls(graph);
+  GRAPH_DUMP("Before GroupMatmul", graph);
+  bool changed = group_matmuls.run();
+  if (changed) {
+    GRAPH_DUMP("After GroupMatmul", graph);
+  }
+  return changed;
+}
+
+} // namespace jit
+} // namespace torch_ipex
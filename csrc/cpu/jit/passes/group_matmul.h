@@ -0,0 +1,18 @@
+#pragma once
+
+#include <Macros.h>
+#include <torch/csrc/jit/ir/ir.h>
+
+namespace torch_ipex {
+namespace jit {
+
+// Harvests independent small same-shape aten::matmul/aten::bmm nodes in
+// a block and rewrites each group into a single torch_ipex::matmul_group
+// call, so the whole group runs as one strided batched GEMM. Only
+// matmuls whose operand shapes are statically known and too small to
+// keep the machine busy on their own are grouped; everything else is
+// left for the regular kernels.
+IPEX_API bool GroupMatmul(std::shared_ptr<torch::jit::Graph>& graph);
+
+} // namespace jit
+} // namespace torch_ipex
@@ -1,3 +1,4 @@
+#include <ATen/Parallel.h>
 #include <torch/csrc/jit/passes/constant_propagation.h>
 #include "cpu/kernels/OpContext.h"
 
@@ -38,36 +39,132 @@ static const std::set<std::string> prepack_foldable_ops = {
     "ipex_prepack::mkl_sgemm_prepack",
 };
 
+// Build a value-identity key for a foldable prepack node so that tied
+// weights (shared input/output embeddings, ALBERT-style sharing) are packed
+// once and the packed constant is reused by every consumer in the block.
+// Tensors are keyed by the identity of their underlying buffer plus the view
+// on it; the remaining (scalar/list) args are keyed by value. Returns an
+// empty string when any input cannot be keyed reliably.
+static std::string prepackNodeCacheKey(Node* n) {
+  std::ostringstream key;
+  key << n->kind().toQualString();
+  for (auto* input : n->inputs()) {
+    auto iv = toIValue(input);
+    if (!iv) {
+      return "";
+    }
+    key << '|';
+    if (iv->isTensor()) {
+      const auto& tensor = iv->toTensor();
+      if (!tensor.defined()) {
+        key << "undef";
+        continue;
+      }
+      key << tensor.unsafeGetTensorImpl()->storage().data() << '/'
+          << tensor.storage_offset() << '/' << tensor.sizes() << '/'
+          << tensor.strides() << '/' << tensor.scalar_type();
+    } else if (
+        iv->isNone() || iv->isInt() || iv->isDouble() || iv->isBool() ||
+        iv->isString() || iv->isIntList() || iv->isDoubleList() ||
+        iv->isBoolList()) {
+      key << *iv;
+    } else {
+      return "";
+    }
+  }
+  return key.str();
+}
+
 void PrePackingOpsFolder(Block* b) {
   auto is_foldable_op = [](const Node* n) -> bool {
     return prepack_foldable_ops.find(n->kind().toQualString()) !=
         prepack_foldable_ops.end();
   };
 
-  std::unordered_set<Node*> nodes_to_delete;
+  // One pack job per distinct weight/arg key; nodes whose key matches an
+  // earlier job (tied weights, shared input/output embeddings) reuse its
+  // packed constant instead of packing the tensor again.
+  struct PackJob {
+    Node* node;
+    c10::optional<Stack> outputs;
+    Value* packed = nullptr;
+  };
+  std::vector<PackJob> jobs;
+  std::unordered_map<std::string, size_t> job_by_key;
+  // every foldable node in block order, pointing at the job it folds to
+  std::vector<std::pair<Node*, size_t>> folds;
+
+  // Phase 1 (serial): recurse into sub-blocks and collect the pack jobs.
   for (Node* n : b->nodes()) {
     for (Block* block : n->blocks()) {
       PrePackingOpsFolder(block);
     }
-    if (is_foldable_op(n)) {
-      auto optional_outputs = torch::jit::runNodeIfInputsAreConstant(n);
-      if (optional_outputs) {
-        auto outputs = optional_outputs.value();
-        TORCH_CHECK(outputs.size() == 1, "Prepack ops have single output");
-        Value* prepack_op_value = n->output(0);
-        auto graph = n->owningGraph();
-        WithInsertPoint ins(prepack_op_value->node());
-        // make sure objects inserted into the graph do not holding owning
-        // reference, see more details in
-        // https://github.com/pytorch/pytorch/pull/65442, so there we convert
-        // the object to to weak_compilation.
-        auto weak_class_obj =
-            outputs[0].toObject()->copy_to_weak_compilation_ref();
-        Value* packed_weight = graph->insertConstant(weak_class_obj)
-                                   ->setType(n->output(0)->type());
-        prepack_op_value->replaceAllUsesWith(packed_weight);
-        nodes_to_delete.insert(n);
+    if (!is_foldable_op(n)) {
+      continue;
+    }
+    auto cache_key = prepackNodeCacheKey(n);
+    if (!cache_key.empty()) {
+      auto it = job_by_key.find(cache_key);
+      if (it != job_by_key.end()) {
+        folds.emplace_back(n, it->second);
+        continue;
+      }
+    }
+    bool constant_inputs =
+        std::all_of(n->inputs().begin(), n->inputs().end(), [](Value* v) {
+          return toIValue(v).has_value();
+        });
+    if (!constant_inputs) {
+      continue;
+    }
+    jobs.push_back({n, c10::nullopt, nullptr});
+    if (!cache_key.empty()) {
+      job_by_key.emplace(std::move(cache_key), jobs.size() - 1);
+    }
+    folds.emplace_back(n, jobs.size() - 1);
+  }
+
+  // Phase 2 (parallel): run the packs. The jobs are independent — each
+  // one reads its own constant inputs and produces a fresh op context —
+  // so they spread over the thread pool with no ordering constraints.
+  // The weight reorders dominate ipex.optimize() preparation time on big
+  // models, and serially they leave all but one core idle.
+  at::parallel_for(
+      0, static_cast<int64_t>(jobs.size()), 1, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; ++i) {
+          jobs[i].outputs = torch::jit::runNodeIfInputsAreConstant(jobs[i].node);
+        }
+      });
+
+  // Phase 3 (serial): mutate the graph in block order. A job's primary
+  // node precedes every node folding to it, so the constant inserted at
+  // the primary node's position dominates all reuses.
+  std::unordered_set<Node*> nodes_to_delete;
+  for (auto& fold : folds) {
+    Node* n = fold.first;
+    PackJob& job = jobs[fold.second];
+    if (n == job.node) {
+      if (!job.outputs) {
+        continue;
       }
+      auto& outputs = job.outputs.value();
+      TORCH_CHECK(outputs.size() == 1, "Prepack ops have single output");
+      Value* prepack_op_value = n->output(0);
+      auto graph = n->owningGraph();
+      WithInsertPoint ins(prepack_op_value->node());
+      // make sure objects inserted into the graph do not holding owning
+      // reference, see more details in
+      // https://github.com/pytorch/pytorch/pull/65442, so there we convert
+      // the object to to weak_compilation.
+      auto weak_class_obj =
+          outputs[0].toObject()->copy_to_weak_compilation_ref();
+      job.packed = graph->insertConstant(weak_class_obj)
+                       ->setType(n->output(0)->type());
+      prepack_op_value->replaceAllUsesWith(job.packed);
+      nodes_to_delete.insert(n);
+    } else if (job.packed != nullptr) {
+      n->output(0)->replaceAllUsesWith(job.packed);
+      nodes_to_delete.insert(n);
     }
   }
   for (auto n : nodes_to_delete) {
@@ -13,11 +13,101 @@ namespace jit {
 
 using namespace torch::jit;
 
+namespace {
+
+// Tries to fold a constant zero pad feeding a convolution into the conv's
+// own padding argument. This removes the materialized padded activation
+// (a full write + read around every padded quantized conv): the oneDNN
+// convolution fills its implicit border with the source zero point, which
+// dequantizes to 0, so the result is identical to an explicit constant-0
+// pad. Only symmetric, non-negative spatial pads on a non-transposed conv
+// qualify; everything else keeps the materializing path below.
+bool tryFoldPadIntoConvolution(Node* n) {
+  auto output = n->output();
+  if (output->uses().size() != 1) {
+    return false;
+  }
+  Node* conv_node = output->uses().at(0).user;
+  if (conv_node->kind() != aten::_convolution ||
+      conv_node->inputs().at(0) != output) {
+    return false;
+  }
+  if (n->inputs().at(0)->node()->kind() != aten::dequantize) {
+    return false;
+  }
+
+  auto pad_ivalue = toIValue(n->inputs().at(1));
+  if (!pad_ivalue.has_value() || !pad_ivalue->isIntList()) {
+    return false;
+  }
+  auto pad = pad_ivalue->toIntVector();
+  if (pad.size() % 2 != 0) {
+    return false;
+  }
+  if (n->kind() == aten::pad) {
+    auto mode = toIValue(n->inputs().at(2));
+    if (!mode.has_value() || !mode->isString() ||
+        mode->toStringRef() != "constant") {
+      return false;
+    }
+    auto value = toIValue(n->inputs().at(3));
+    if (!value.has_value() ||
+        (!value->isNone() && value->toScalar().toDouble() != 0.0)) {
+      return false;
+    }
+  } else { // aten::constant_pad_nd
+    auto value = toIValue(n->inputs().at(2));
+    if (!value.has_value() || value->toScalar().toDouble() != 0.0) {
+      return false;
+    }
+  }
+
+  auto transposed = toIValue(conv_node->inputs().at(6));
+  if (!transposed.has_value() || transposed->toBool()) {
+    return false;
+  }
+  auto conv_pad_ivalue = toIValue(conv_node->inputs().at(4));
+  if (!conv_pad_ivalue.has_value() || !conv_pad_ivalue->isIntList()) {
+    return false;
+  }
+  auto conv_pad = conv_pad_ivalue->toIntVector();
+  size_t spatial_dims = conv_pad.size();
+  if (pad.size() / 2 > spatial_dims) {
+    return false;
+  }
+  // conv padding is symmetric per dim, so the folded pad must be too; the
+  // pad list pairs run from the last spatial dim backwards
+  for (size_t j = 0; j < pad.size() / 2; ++j) {
+    if (pad[2 * j] != pad[2 * j + 1] || pad[2 * j] < 0) {
+      return false;
+    }
+  }
+  for (size_t j = 0; j < pad.size() / 2; ++j) {
+    conv_pad[spatial_dims - 1 - j] += pad[2 * j];
+  }
+
+  auto g = n->owningGraph();
+  WithInsertPoint guard(conv_node);
+  auto new_conv_pad = g->insertConstant(conv_pad);
+  conv_node->replaceInput(4, new_conv_pad);
+  conv_node->replaceInputWith(n->output(), n->inputs().at(0));
+  return true;
+}
+
+} // anonymous namespace
+
 void QPaddingConversion(Block* b) {
   for (Node* n : b->nodes()) {
     for (Block* block : n->blocks()) {
       QPaddingConversion(block);
     }
+    // fold constant zero pads directly into the conv's padding when
+    // possible; the pad node goes dead and is cleaned up by DCE
+    if (n->kind() == aten::pad || n->kind() == aten::constant_pad_nd) {
+      if (tryFoldPadIntoConvolution(n)) {
+        continue;
+      }
+    }
     // convert q->dq->aten::pad->aten::_convolution to
     // q->dq->aten::pad->q-dq->aten::_convolution.
     if (n->kind() == aten::pad) {
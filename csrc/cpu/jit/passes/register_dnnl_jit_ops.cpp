@@ -4,7 +4,9 @@
 #include <torch/csrc/jit/runtime/operator.h>
 
 #include "aten/AddLayerNorm.h"
+#include "aten/BatchNormAddRelu.h"
 #include "aten/ConcatBnRelu.h"
+#include "aten/EltwiseChain.h"
 #include "aten/MergedEmbCat.h"
 #include "aten/RMSNorm.h"
 #include "cpu/kernels/ConvPacked.h"
@@ -23,7 +25,9 @@
 #include "cpu/kernels/RNN.h"
 #include "cpu/kernels/Shuffle.h"
 #include "cpu/kernels/Softmax.h"
+#include "cpu/kernels/TrustedLayout.h"
 #include "ideep/IDeepConversions.h"
+#include "utils/hot_trace.h"
 namespace torch_ipex {
 namespace jit {
 
@@ -42,6 +46,15 @@ at::Tensor toOptionalTensor(const IValue& v) {
   return v.isNone() ? at::Tensor() : v.toTensor();
 }
 
+// Resolved once at Operation-creation time: the fusion pass stamps the
+// attribute on nodes whose input layout it proved from profiled types,
+// so the per-call cost of the trusted path is a single thread-local
+// store instead of the full shape/contiguity validation.
+bool nodeHasTrustedLayout(const Node* node) {
+  return node != nullptr &&
+      node->hasAttribute(Symbol::attr(kTrustedLayoutAttr));
+}
+
 #define CONV_PREPACK_ARGS                         \
   "Tensor W, Tensor? B, "                         \
   "int[] stride, int[] padding, int[] dilation, " \
@@ -81,7 +94,9 @@ at::Tensor toOptionalTensor(const IValue& v) {
       "__torch__.torch.classes.ipex_prepack.ConvolutionOpContext " \
       "W_prepack) -> Tensor",                                      \
       [](const Node* node) -> Operation {                          \
-        return [](Stack* stack) {                                  \
+        bool trusted = nodeHasTrustedLayout(node);                 \
+        return [trusted](Stack* stack) {                           \
+          TrustedLayoutScope trusted_scope(trusted);               \
           auto result = convolution_##FUSED_OP(                    \
               (std::move(peek(stack, 0, 2))).toTensor(),           \
               (std::move(peek(stack, 1, 2)))                       \
@@ -130,7 +145,9 @@ at::Tensor toOptionalTensor(const IValue& v) {
       "__torch__.torch.classes.ipex_prepack.ConvolutionOpContext "     \
       "W_prepack) -> Tensor",                                          \
       [](const Node* node) -> Operation {                              \
-        return [](Stack* stack) {                                      \
+        bool trusted = nodeHasTrustedLayout(node);                     \
+        return [trusted](Stack* stack) {                               \
+          TrustedLayoutScope trusted_scope(trusted);                   \
           auto output = (std::move(peek(stack, 1, 4))).toTensor();     \
           auto result = convolution_##FUSED_OP(                        \
               (std::move(peek(stack, 0, 4))).toTensor(),               \
@@ -152,7 +169,9 @@ at::Tensor toOptionalTensor(const IValue& v) {
       "__torch__.torch.classes.ipex_prepack.LinearOpContext " \
       "W_prepack) -> Tensor",                                 \
       [](const Node* node) -> Operation {                     \
-        return [](Stack* stack) {                             \
+        bool trusted = nodeHasTrustedLayout(node);            \
+        return [trusted](Stack* stack) {                      \
+          TrustedLayoutScope trusted_scope(trusted);          \
           auto result = linear_##FUSED_OP(                    \
               (std::move(peek(stack, 0, 2))).toTensor(),      \
               (std::move(peek(stack, 1, 2)))                  \
@@ -171,7 +190,9 @@ at::Tensor toOptionalTensor(const IValue& v) {
       "__torch__.torch.classes.ipex_prepack.ConvTransposeOpContext " \
       "W_prepack) -> Tensor",                                        \
       [](const Node* node) -> Operation {                            \
-        return [](Stack* stack) {                                    \
+        bool trusted = nodeHasTrustedLayout(node);                   \
+        return [trusted](Stack* stack) {                             \
+          TrustedLayoutScope trusted_scope(trusted);                 \
           auto result = conv_transpose_##FUSED_OP(                   \
               (std::move(peek(stack, 0, 2))).toTensor(),             \
               (std::move(peek(stack, 1, 2)))                         \
@@ -682,6 +703,25 @@ torch::jit::RegisterOperators op({
           };
         },
         aliasAnalysisFromSchema()),
+    Operator(
+        "ipex_prepack::linear_epilogue_run(Tensor input, str[] epilogue, "
+        "Tensor[] extra_inputs, "
+        "__torch__.torch.classes.ipex_prepack.LinearOpContext W_prepack) "
+        "-> Tensor",
+        [](const Node* node) -> Operation {
+          return [](Stack* stack) {
+            auto result = linear_epilogue_run(
+                (std::move(peek(stack, 0, 4))).toTensor(),
+                (std::move(peek(stack, 1, 4))).to<std::vector<std::string>>(),
+                (std::move(peek(stack, 2, 4))).toTensorVector(),
+                (std::move(peek(stack, 3, 4)))
+                    .toCustomClass<LinearOpContext>());
+            drop(stack, 4);
+            torch::jit::pack(stack, std::move(result));
+            return 0;
+          };
+        },
+        aliasAnalysisFromSchema()),
     Operator(
         "ipex_prepack::mkl_sgemm_run(Tensor input, "
         "__torch__.torch.classes.ipex_prepack.MKLOpContext "
@@ -1276,6 +1316,28 @@ torch::jit::RegisterOperators op({
         },
         aliasAnalysisFromSchema()),
 
+    Operator(
+        "ipex::rotary_embedding_half(Tensor x, Tensor cos, Tensor sin) -> Tensor",
+        [](Stack& stack) {
+          auto result = dil_rotary_embedding_half(
+              peek(stack, 0, 3).toTensor(),
+              peek(stack, 1, 3).toTensor(),
+              peek(stack, 2, 3).toTensor());
+          drop(stack, 3);
+          torch::jit::pack(stack, std::move(result));
+        },
+        aliasAnalysisFromSchema()),
+
+    Operator(
+        "ipex::repeat_kv(Tensor hidden_states, int[] expand_list) -> Tensor",
+        [](Stack& stack) {
+          auto result = dil_repeat_kv(
+              peek(stack, 0, 2).toTensor(), peek(stack, 1, 2).toIntVector());
+          drop(stack, 2);
+          torch::jit::pack(stack, std::move(result));
+        },
+        aliasAnalysisFromSchema()),
+
     Operator(
         "ipex::linear_swish_customized(Tensor x, Tensor weight, Tensor ? bias) -> Tensor",
         [](Stack& stack) {
@@ -1292,6 +1354,7 @@ torch::jit::RegisterOperators op({
         "ipex::softmax(Tensor self, int dim, ScalarType ? dtype) -> Tensor",
         [](const Node* node) -> Operation {
           return [](Stack* stack) {
+            IPEX_HOT_TRACE_SCOPE("jit::ipex::softmax");
             auto result = dil_softmax(
                 (std::move(peek(stack, 0, 3))).toTensor(),
                 (std::move(peek(stack, 1, 3))).toInt(),
@@ -1445,11 +1508,31 @@ torch::jit::RegisterOperators op({
           };
         },
         aliasAnalysisFromSchema()),
+    Operator(
+        "ipex::shuffle_2d_split("
+        "  Tensor input,"
+        "  int[5] view_shape,"
+        "  int trans_dim0,"
+        "  int trans_dim1) -> Tensor[]",
+        [](const Node* node) -> Operation {
+          return [](Stack* stack) {
+            auto result = dil_shuffle_split(
+                (std::move(peek(stack, 0, 4))).toTensor(),
+                (std::move(peek(stack, 1, 4))).toIntVector(),
+                (std::move(peek(stack, 2, 4))).toInt(),
+                (std::move(peek(stack, 3, 4))).toInt());
+            drop(stack, 4);
+            torch::jit::pack(stack, std::move(result));
+            return 0;
+          };
+        },
+        aliasAnalysisFromSchema()),
     Operator(
         "ipex::RMSNorm(Tensor a, Tensor b, float eps) -> "
         "Tensor",
         [](const Node* node) -> Operation {
           return [](Stack* stack) {
+            IPEX_HOT_TRACE_SCOPE("jit::ipex::RMSNorm");
             auto result = dil_RMSNorm(
                 (std::move(peek(stack, 0, 3))).toTensor(),
                 (std::move(peek(stack, 1, 3))).toTensor(),
@@ -1460,6 +1543,26 @@ torch::jit::RegisterOperators op({
           };
         },
         aliasAnalysisFromSchema()),
+    Operator(
+        "ipex::rmsnorm_quant(Tensor a, Tensor b, float eps, Tensor? smooth, "
+        "float o_scale, int o_zp, ScalarType o_dtype) -> "
+        "Tensor",
+        [](const Node* node) -> Operation {
+          return [](Stack* stack) {
+            auto result = dil_RMSNormQuant(
+                (std::move(peek(stack, 0, 7))).toTensor(),
+                (std::move(peek(stack, 1, 7))).toTensor(),
+                (std::move(peek(stack, 2, 7))).toDouble(),
+                (std::move(peek(stack, 3, 7))).toOptional<at::Tensor>(),
+                (std::move(peek(stack, 4, 7))).toDouble(),
+                (std::move(peek(stack, 5, 7))).toInt(),
+                (std::move(peek(stack, 6, 7))).toScalarType());
+            drop(stack, 7);
+            torch::jit::pack(stack, std::move(result));
+            return 0;
+          };
+        },
+        aliasAnalysisFromSchema()),
     Operator(
         "ipex::add_layernorm(Tensor a, Tensor b, int alpha, int[] "
         "normalized_shape, Tensor ? "
@@ -1467,6 +1570,7 @@ torch::jit::RegisterOperators op({
         "Tensor",
         [](const Node* node) -> Operation {
           return [](Stack* stack) {
+            IPEX_HOT_TRACE_SCOPE("jit::ipex::add_layernorm");
             auto result = dil_add_layernorm(
                 (std::move(peek(stack, 0, 8))).toTensor(),
                 (std::move(peek(stack, 1, 8))).toTensor(),
@@ -1507,6 +1611,58 @@ torch::jit::RegisterOperators op({
           };
         },
         aliasAnalysisFromSchema()),
+    Operator(
+        "ipex::batch_norm_add_relu(Tensor input, Tensor bn_scale, Tensor bn_beta, "
+        "Tensor? add_input, Tensor? weight, Tensor? bias, Tensor? running_mean, Tensor? running_var, bool training, float momentum, float eps, bool cudnn_enabled) -> "
+        "Tensor",
+        [](const Node* node) -> Operation {
+          return [](Stack* stack) {
+            auto result = BatchNormAddRelu(
+                (std::move(peek(stack, 0, 12))).toTensor(),
+                (std::move(peek(stack, 1, 12))).toTensor(),
+                (std::move(peek(stack, 2, 12))).toTensor(),
+                toOptionalTensor(std::move(peek(stack, 3, 12))),
+                toOptionalTensor(std::move(peek(stack, 4, 12))),
+                toOptionalTensor(std::move(peek(stack, 5, 12))),
+                toOptionalTensor(std::move(peek(stack, 6, 12))),
+                toOptionalTensor(std::move(peek(stack, 7, 12))),
+                (std::move(peek(stack, 8, 12))).toBool(),
+                (std::move(peek(stack, 9, 12))).toDouble(),
+                (std::move(peek(stack, 10, 12))).toDouble(),
+                (std::move(peek(stack, 11, 12))).toBool());
+            drop(stack, 12);
+            torch::jit::pack(stack, std::move(result));
+            return 0;
+          };
+        },
+        aliasAnalysisFromSchema()),
+    Operator(
+        "ipex::eltwise_chain(Tensor input, int[] ops, float[] alphas) -> Tensor",
+        [](const Node* node) -> Operation {
+          return [](Stack* stack) {
+            auto alphas = (std::move(peek(stack, 2, 3))).toDoubleVector();
+            auto ops = (std::move(peek(stack, 1, 3))).toIntVector();
+            auto result = dil_eltwise_chain(
+                (std::move(peek(stack, 0, 3))).toTensor(), ops, alphas);
+            drop(stack, 3);
+            torch::jit::pack(stack, std::move(result));
+            return 0;
+          };
+        },
+        aliasAnalysisFromSchema()),
+    Operator(
+        "ipex::einsum(str equation, Tensor[] tensors) -> Tensor",
+        [](const Node* node) -> Operation {
+          return [](Stack* stack) {
+            auto result = dil_einsum(
+                (std::move(peek(stack, 0, 2))).toStringView(),
+                (std::move(peek(stack, 1, 2))).toTensorList());
+            drop(stack, 2);
+            torch::jit::pack(stack, std::move(result));
+            return 0;
+          };
+        },
+        aliasAnalysisFromSchema()),
     Operator(
         "ipex::einsum_binary(str equation, Tensor[] tensors, Tensor add_arg, Scalar alpha) -> Tensor",
         [](const Node* node) -> Operation {
@@ -1,4 +1,5 @@
 #include <torch/csrc/jit/runtime/profiling_record.h>
+#include "op_symbol_table.h"
 
 namespace torch {
 namespace jit {
@@ -41,10 +42,10 @@ bool canFuseNode(const Node* node) {
       node->kind() == Symbol::aten("mul") ||
       node->kind() == Symbol::aten("flatten") ||
       node->kind() ==
-          Symbol::fromQualString("torch_ipex::convolution_forward") ||
-      node->kind() == Symbol::fromQualString("torch_ipex::ipex_linear") ||
-      node->kind() == Symbol::fromQualString("torch_ipex::conv_transpose") ||
-      node->kind() == Symbol::fromQualString("torch_ipex::ipex_MKLSGEMM"));
+          torch_ipex::jit::ipex_op_symbols().torch_ipex_convolution_forward ||
+      node->kind() == torch_ipex::jit::ipex_op_symbols().torch_ipex_ipex_linear ||
+      node->kind() == torch_ipex::jit::ipex_op_symbols().torch_ipex_conv_transpose ||
+      node->kind() == torch_ipex::jit::ipex_op_symbols().torch_ipex_ipex_MKLSGEMM);
 }
 
 namespace {
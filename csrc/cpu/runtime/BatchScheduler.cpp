@@ -0,0 +1,138 @@
+#include "BatchScheduler.h"
+
+namespace torch_ipex {
+namespace runtime {
+
+BatchScheduler::BatchScheduler(
+    std::function<at::Tensor(const at::Tensor&)> forward_fn,
+    std::shared_ptr<TaskExecutor> task_executor,
+    size_t max_batch_size,
+    size_t batch_window_us)
+    : forward_fn(std::move(forward_fn)),
+      task_executor(std::move(task_executor)),
+      max_batch_size(max_batch_size),
+      batch_window(batch_window_us) {
+  if (this->max_batch_size == 0) {
+    throw std::runtime_error(
+        "Fail to init BatchScheduler. max_batch_size must be at least 1.");
+  }
+  this->batcher =
+      std::make_shared<std::thread>([this] { this->batcher_main(); });
+}
+
+bool BatchScheduler::is_compatible(const at::Tensor& a, const at::Tensor& b) {
+  if (a.scalar_type() != b.scalar_type() || a.dim() != b.dim()) {
+    return false;
+  }
+  for (int64_t d = 1; d < a.dim(); d++) {
+    if (a.size(d) != b.size(d)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::future<at::Tensor> BatchScheduler::submit(const at::Tensor& input) {
+  PendingRequest request;
+  request.input = input;
+  request.promise = std::make_shared<std::promise<at::Tensor>>();
+  std::future<at::Tensor> result = request.promise->get_future();
+  {
+    std::unique_lock<std::mutex> lock(this->pending_mutex);
+    if (this->stop) {
+      throw std::runtime_error("Request submit on stopped BatchScheduler");
+    }
+    this->pending_requests.emplace_back(std::move(request));
+  }
+  this->pending_condition.notify_one();
+  return result;
+}
+
+void BatchScheduler::flush_batch(std::vector<PendingRequest>&& batch) {
+  auto shared_batch =
+      std::make_shared<std::vector<PendingRequest>>(std::move(batch));
+  this->task_executor->submit([this, shared_batch]() {
+    try {
+      std::vector<at::Tensor> inputs;
+      inputs.reserve(shared_batch->size());
+      for (auto& request : *shared_batch) {
+        inputs.emplace_back(request.input);
+      }
+      at::Tensor batched_output = this->forward_fn(at::cat(inputs, 0));
+      // Scatter the rows of the batched output back to the requests.
+      int64_t row_offset = 0;
+      for (auto& request : *shared_batch) {
+        int64_t rows = request.input.size(0);
+        request.promise->set_value(
+            batched_output.narrow(0, row_offset, rows));
+        row_offset += rows;
+      }
+    } catch (...) {
+      for (auto& request : *shared_batch) {
+        request.promise->set_exception(std::current_exception());
+      }
+    }
+  });
+}
+
+void BatchScheduler::batcher_main() {
+  while (true) {
+    std::vector<PendingRequest> batch;
+    {
+      std::unique_lock<std::mutex> lock(this->pending_mutex);
+      this->pending_condition.wait(lock, [this] {
+        return this->stop || !this->pending_requests.empty();
+      });
+      if (this->stop && this->pending_requests.empty()) {
+        return;
+      }
+      // Let the window elapse from the first arrival so followers can
+      // join the batch, unless it is already full.
+      if (this->pending_requests.size() < this->max_batch_size &&
+          this->batch_window.count() != 0) {
+        this->pending_condition.wait_for(lock, this->batch_window, [this] {
+          return this->stop ||
+              this->pending_requests.size() >= this->max_batch_size;
+        });
+      }
+      // Take the head request plus every compatible follower; requests
+      // with a different shape class stay queued for the next round.
+      batch.emplace_back(std::move(this->pending_requests.front()));
+      this->pending_requests.pop_front();
+      for (auto it = this->pending_requests.begin();
+           it != this->pending_requests.end() &&
+           batch.size() < this->max_batch_size;) {
+        if (is_compatible(batch.front().input, it->input)) {
+          batch.emplace_back(std::move(*it));
+          it = this->pending_requests.erase(it);
+        } else {
+          ++it;
+        }
+      }
+    }
+    this->flush_batch(std::move(batch));
+  }
+}
+
+void BatchScheduler::stop_scheduler() {
+  bool should_wait_batcher_join = false;
+  {
+    std::unique_lock<std::mutex> lock(this->pending_mutex);
+    if (this->stop == false) {
+      should_wait_batcher_join = true;
+      this->stop = true;
+    }
+  }
+  if (should_wait_batcher_join) {
+    this->pending_condition.notify_all();
+    this->batcher->join();
+  }
+  return;
+}
+
+BatchScheduler::~BatchScheduler() {
+  this->stop_scheduler();
+}
+
+} // namespace runtime
+} // namespace torch_ipex
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <ATen/ATen.h>
+#include <ATen/core/ivalue.h>
+#include <Macros.h>
+#include "TaskExecutor.h"
+
+namespace torch_ipex {
+namespace runtime {
+
+// BatchScheduler coalesces small inference requests: submissions with
+// compatible shape/dtype that arrive within a configurable microsecond
+// window are concatenated along dim 0, run through one forward, and
+// the outputs are scattered back to the per-request futures. This
+// keeps AMX tiles fed when the serving tier sends single-sample
+// requests.
+class IPEX_API BatchScheduler {
+ public:
+  explicit BatchScheduler(
+      std::function<at::Tensor(const at::Tensor&)> forward_fn,
+      std::shared_ptr<TaskExecutor> task_executor,
+      size_t max_batch_size,
+      size_t batch_window_us);
+  // Queue one request. The returned future resolves to this request's
+  // slice of the batched output.
+  std::future<at::Tensor> submit(const at::Tensor& input);
+  void stop_scheduler();
+  ~BatchScheduler();
+
+ private:
+  struct PendingRequest {
+    at::Tensor input;
+    std::shared_ptr<std::promise<at::Tensor>> promise;
+  };
+
+  // Requests are compatible when everything except the batch dimension
+  // matches.
+  static bool is_compatible(const at::Tensor& a, const at::Tensor& b);
+  void batcher_main();
+  void flush_batch(std::vector<PendingRequest>&& batch);
+
+  std::function<at::Tensor(const at::Tensor&)> forward_fn;
+  std::shared_ptr<TaskExecutor> task_executor;
+  size_t max_batch_size;
+  std::chrono::microseconds batch_window;
+
+  std::deque<PendingRequest> pending_requests;
+  std::shared_ptr<std::thread> batcher;
+  bool stop{false};
+  std::mutex pending_mutex;
+  std::condition_variable pending_condition;
+
+  // Put the deleted function in the private.
+  BatchScheduler(const BatchScheduler& batch_scheduler) = delete;
+  BatchScheduler(BatchScheduler&& batch_scheduler) = delete;
+  BatchScheduler& operator=(const BatchScheduler& batch_scheduler) = delete;
+  BatchScheduler& operator=(BatchScheduler&& batch_scheduler) = delete;
+};
+
+} // namespace runtime
+} // namespace torch_ipex
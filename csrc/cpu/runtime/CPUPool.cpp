@@ -4,9 +4,19 @@
 #include <Windows.h>
 #else
 #include <dlfcn.h>
+#include <sched.h>
+#include <sys/syscall.h>
 #include <unistd.h>
+#include <fstream>
+#include <sstream>
 #endif
 
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <limits>
+#include <thread>
+
 namespace torch_ipex {
 namespace runtime {
 
@@ -27,10 +37,160 @@ std::once_flag
                                         // symbol loaded once globally
 std::atomic<bool> iomp_symbol_loaded{false};
 
+// libnuma symbols, loaded lazily the same way as the IOMP ones. We
+// only need the preferred-node policy for task-scope allocations.
+typedef int (*numa_available_p)();
+typedef void (*numa_set_preferred_p)(int);
+numa_available_p numa_available_ext;
+numa_set_preferred_p numa_set_preferred_ext;
+std::once_flag numa_symbol_loading_call_once_flag;
+std::atomic<bool> numa_symbol_loaded{false};
+
 // current_cpu_core_list is only used to cache the cpu_core_list setting
 // of _pin_cpu_cores. It's thread_local, so different task thread can have
 // different settings to support task API.
 thread_local std::vector<int32_t> current_cpu_core_list{-1};
+
+#ifndef _WIN32
+// Affinity watchdog state. Every _pin_cpu_cores call records the kernel
+// tid and target core of each worker it pinned; the watchdog thread
+// sweeps these records to detect and repair drift.
+constexpr uint64_t kMigrationsUnknown = std::numeric_limits<uint64_t>::max();
+
+struct PinnedThreadRecord {
+  pid_t tid;
+  int32_t core_id;
+  uint64_t last_nr_migrations;
+};
+
+std::mutex watchdog_mutex; // guards the records and watchdog_running
+std::vector<PinnedThreadRecord> pinned_thread_records;
+bool watchdog_running = false;
+std::condition_variable watchdog_cv;
+std::thread watchdog_thread;
+std::mutex watchdog_thread_mutex; // serializes start/stop
+
+std::atomic<uint64_t> watchdog_checks{0};
+std::atomic<uint64_t> watchdog_drift_events{0};
+std::atomic<uint64_t> watchdog_repin_events{0};
+std::atomic<uint64_t> watchdog_migrations{0};
+
+// Parse se.nr_migrations from /proc/self/task/<tid>/sched. Returns
+// kMigrationsUnknown when the file or the field is not available (e.g.
+// kernels built without CONFIG_SCHED_DEBUG).
+uint64_t read_nr_migrations(pid_t tid) {
+  std::ostringstream sched_path;
+  sched_path << "/proc/self/task/" << tid << "/sched";
+  std::ifstream sched_file(sched_path.str());
+  if (!sched_file.is_open()) {
+    return kMigrationsUnknown;
+  }
+  std::string line;
+  while (std::getline(sched_file, line)) {
+    if (line.compare(0, 16, "se.nr_migrations") == 0) {
+      size_t colon_pos = line.find(':');
+      if (colon_pos == std::string::npos) {
+        return kMigrationsUnknown;
+      }
+      try {
+        return std::stoull(line.substr(colon_pos + 1));
+      } catch (const std::exception&) {
+        return kMigrationsUnknown;
+      }
+    }
+  }
+  return kMigrationsUnknown;
+}
+
+void register_pinned_team(
+    const std::vector<pid_t>& tids,
+    const std::vector<int32_t>& cpu_core_list) {
+  std::lock_guard<std::mutex> guard(watchdog_mutex);
+  for (size_t i = 0; i < tids.size(); i++) {
+    if (tids[i] == 0) {
+      continue;
+    }
+    auto it = std::find_if(
+        pinned_thread_records.begin(),
+        pinned_thread_records.end(),
+        [&](const PinnedThreadRecord& record) {
+          return record.tid == tids[i];
+        });
+    if (it != pinned_thread_records.end()) {
+      // Re-pin of an existing worker (e.g. a task thread switching
+      // pools): update the target core and restart the migration base.
+      it->core_id = cpu_core_list[i];
+      it->last_nr_migrations = read_nr_migrations(tids[i]);
+    } else {
+      pinned_thread_records.push_back(
+          {tids[i], cpu_core_list[i], read_nr_migrations(tids[i])});
+    }
+  }
+}
+
+void unregister_pinned_threads(const std::vector<pid_t>& tids) {
+  std::lock_guard<std::mutex> guard(watchdog_mutex);
+  pinned_thread_records.erase(
+      std::remove_if(
+          pinned_thread_records.begin(),
+          pinned_thread_records.end(),
+          [&](const PinnedThreadRecord& record) {
+            return std::find(tids.begin(), tids.end(), record.tid) !=
+                tids.end();
+          }),
+      pinned_thread_records.end());
+}
+
+void affinity_watchdog_loop(int64_t interval_ms) {
+  std::unique_lock<std::mutex> lock(watchdog_mutex);
+  while (watchdog_running) {
+    watchdog_cv.wait_for(
+        lock, std::chrono::milliseconds(interval_ms), []() {
+          return !watchdog_running;
+        });
+    if (!watchdog_running) {
+      break;
+    }
+    watchdog_checks++;
+    for (auto it = pinned_thread_records.begin();
+         it != pinned_thread_records.end();) {
+      cpu_set_t actual_set;
+      CPU_ZERO(&actual_set);
+      if (sched_getaffinity(it->tid, sizeof(cpu_set_t), &actual_set) != 0) {
+        // The worker is gone (task executor shut down); drop the record.
+        it = pinned_thread_records.erase(it);
+        continue;
+      }
+      if (!CPU_ISSET(it->core_id, &actual_set) ||
+          CPU_COUNT(&actual_set) != 1) {
+        watchdog_drift_events++;
+        cpu_set_t wanted_set;
+        CPU_ZERO(&wanted_set);
+        CPU_SET(it->core_id, &wanted_set);
+        if (sched_setaffinity(it->tid, sizeof(cpu_set_t), &wanted_set) == 0) {
+          watchdog_repin_events++;
+        }
+      }
+      uint64_t nr_migrations = read_nr_migrations(it->tid);
+      if (nr_migrations != kMigrationsUnknown) {
+        if (it->last_nr_migrations != kMigrationsUnknown &&
+            nr_migrations > it->last_nr_migrations) {
+          watchdog_migrations += nr_migrations - it->last_nr_migrations;
+        }
+        it->last_nr_migrations = nr_migrations;
+      }
+      ++it;
+    }
+  }
+}
+
+// Join the watchdog thread before static destruction tears its state down.
+struct AffinityWatchdogShutdown {
+  ~AffinityWatchdogShutdown() {
+    stop_affinity_watchdog();
+  }
+} affinity_watchdog_shutdown;
+#endif
 } // namespace
 
 void* open_iomp_library() {
@@ -89,6 +249,140 @@ void loading_iomp_symbol() {
   return;
 }
 
+void loading_numa_symbol() {
+#ifndef _WIN32
+  void* handle = dlopen("libnuma.so.1", RTLD_NOW | RTLD_GLOBAL);
+  if (handle == NULL ||
+      get_func_from_library(handle, "numa_available") == NULL ||
+      get_func_from_library(handle, "numa_set_preferred") == NULL) {
+    numa_symbol_loaded = false;
+    return;
+  }
+  numa_available_ext =
+      (numa_available_p)get_func_from_library(handle, "numa_available");
+  numa_set_preferred_ext =
+      (numa_set_preferred_p)get_func_from_library(handle, "numa_set_preferred");
+  if (numa_available_ext() < 0) {
+    numa_symbol_loaded = false;
+    return;
+  }
+  numa_symbol_loaded = true;
+#else
+  numa_symbol_loaded = false;
+#endif
+  return;
+}
+
+#ifndef _WIN32
+// Read the SMT sibling group of one logical CPU from
+// /sys/devices/system/cpu/cpu<N>/topology/thread_siblings_list (format
+// "0,64" or "0-1"). Empty when the topology is not exposed.
+static std::vector<int32_t> read_thread_siblings(int32_t core_id) {
+  std::vector<int32_t> siblings;
+  std::ostringstream siblings_path;
+  siblings_path << "/sys/devices/system/cpu/cpu" << core_id
+                << "/topology/thread_siblings_list";
+  std::ifstream siblings_file(siblings_path.str());
+  if (!siblings_file.is_open()) {
+    return siblings;
+  }
+  std::string range;
+  while (std::getline(siblings_file, range, ',')) {
+    size_t dash_pos = range.find('-');
+    try {
+      if (dash_pos == std::string::npos) {
+        siblings.emplace_back(std::stoi(range));
+      } else {
+        int32_t range_begin = std::stoi(range.substr(0, dash_pos));
+        int32_t range_end = std::stoi(range.substr(dash_pos + 1));
+        for (int32_t id = range_begin; id <= range_end; id++) {
+          siblings.emplace_back(id);
+        }
+      }
+    } catch (const std::exception&) {
+      continue;
+    }
+  }
+  return siblings;
+}
+#endif
+
+std::vector<int32_t> get_smt_siblings_for_cores(
+    const std::vector<int32_t>& cpu_core_list) {
+  std::vector<int32_t> expanded_core_list(cpu_core_list);
+#ifndef _WIN32
+  for (auto core_id : cpu_core_list) {
+    std::vector<int32_t> siblings = read_thread_siblings(core_id);
+    expanded_core_list.insert(
+        expanded_core_list.end(), siblings.begin(), siblings.end());
+  }
+#endif
+  std::sort(expanded_core_list.begin(), expanded_core_list.end());
+  expanded_core_list.erase(
+      std::unique(expanded_core_list.begin(), expanded_core_list.end()),
+      expanded_core_list.end());
+  return expanded_core_list;
+}
+
+std::vector<int32_t> get_numa_nodes_for_cores(
+    const std::vector<int32_t>& cpu_core_list) {
+  std::vector<int32_t> numa_node_list;
+#ifndef _WIN32
+  // Walk /sys/devices/system/node/node<N>/cpulist (format "0-15,32-47")
+  // and record every node owning at least one core of the list.
+  for (int32_t node_id = 0;; node_id++) {
+    std::ostringstream cpulist_path;
+    cpulist_path << "/sys/devices/system/node/node" << node_id << "/cpulist";
+    std::ifstream cpulist_file(cpulist_path.str());
+    if (!cpulist_file.is_open()) {
+      break;
+    }
+    std::string range;
+    bool node_has_core = false;
+    while (std::getline(cpulist_file, range, ',') && !node_has_core) {
+      int32_t range_begin = -1;
+      int32_t range_end = -1;
+      size_t dash_pos = range.find('-');
+      try {
+        if (dash_pos == std::string::npos) {
+          range_begin = range_end = std::stoi(range);
+        } else {
+          range_begin = std::stoi(range.substr(0, dash_pos));
+          range_end = std::stoi(range.substr(dash_pos + 1));
+        }
+      } catch (const std::exception&) {
+        continue;
+      }
+      for (auto core_id : cpu_core_list) {
+        if (core_id >= range_begin && core_id <= range_end) {
+          node_has_core = true;
+          break;
+        }
+      }
+    }
+    if (node_has_core) {
+      numa_node_list.emplace_back(node_id);
+    }
+  }
+#endif
+  return numa_node_list;
+}
+
+void _bind_numa_memory_node(const CPUPool& cpu_pool) {
+  std::call_once(numa_symbol_loading_call_once_flag, loading_numa_symbol);
+  if (!numa_symbol_loaded) {
+    return;
+  }
+  const std::vector<int32_t>& numa_node_list = cpu_pool.get_numa_node_list();
+  // Only a single-node pool has an unambiguous local node. A pool
+  // spanning sockets keeps the default first-touch policy; users who
+  // want locality shard one MultiStreamModule stream per socket.
+  if (numa_node_list.size() == 1) {
+    numa_set_preferred_ext(numa_node_list[0]);
+  }
+  return;
+}
+
 std::vector<int32_t> get_process_available_cores() {
   return torch_ipex::runtime::available_cpu_cores;
 }
@@ -214,6 +508,55 @@ void init_runtime_ext() {
   return;
 }
 
+void start_affinity_watchdog(int64_t interval_ms) {
+#ifndef _WIN32
+  if (interval_ms <= 0) {
+    interval_ms = 2000;
+  }
+  std::lock_guard<std::mutex> guard(watchdog_thread_mutex);
+  {
+    std::lock_guard<std::mutex> state_guard(watchdog_mutex);
+    if (watchdog_running) {
+      return;
+    }
+    watchdog_running = true;
+  }
+  watchdog_thread = std::thread(affinity_watchdog_loop, interval_ms);
+#endif
+  return;
+}
+
+void stop_affinity_watchdog() {
+#ifndef _WIN32
+  std::lock_guard<std::mutex> guard(watchdog_thread_mutex);
+  {
+    std::lock_guard<std::mutex> state_guard(watchdog_mutex);
+    if (!watchdog_running) {
+      return;
+    }
+    watchdog_running = false;
+  }
+  watchdog_cv.notify_all();
+  if (watchdog_thread.joinable()) {
+    watchdog_thread.join();
+  }
+#endif
+  return;
+}
+
+AffinityWatchdogStats get_affinity_watchdog_stats() {
+  AffinityWatchdogStats stats;
+#ifndef _WIN32
+  stats.checks = watchdog_checks;
+  stats.drift_events = watchdog_drift_events;
+  stats.repin_events = watchdog_repin_events;
+  stats.migrations = watchdog_migrations;
+  std::lock_guard<std::mutex> guard(watchdog_mutex);
+  stats.watched_threads = pinned_thread_records.size();
+#endif
+  return stats;
+}
+
 void _pin_cpu_cores(const torch_ipex::runtime::CPUPool& cpu_pool) {
   const std::vector<int32_t>& cpu_core_list = cpu_pool.get_cpu_core_list();
   if (!is_runtime_ext_enabled()) {
@@ -221,6 +564,9 @@ void _pin_cpu_cores(const torch_ipex::runtime::CPUPool& cpu_pool) {
         "Didn't preload IOMP before using the runtime API");
   }
 
+#ifndef _WIN32
+  std::vector<pid_t> team_tids(cpu_core_list.size(), 0);
+#endif
   // Create the OMP thread pool and bind to cores of cpu_pools one by one
   omp_set_num_threads(cpu_core_list.size());
 #pragma omp parallel num_threads(cpu_core_list.size())
@@ -233,7 +579,32 @@ void _pin_cpu_cores(const torch_ipex::runtime::CPUPool& cpu_pool) {
     kmp_set_affinity_mask_proc_ext(phy_core_id, &mask);
     kmp_set_affinity_ext(&mask);
     kmp_destroy_affinity_mask_ext(&mask);
+#ifndef _WIN32
+    // Record the kernel tid so the affinity watchdog can verify and
+    // repair this worker's pinning later.
+    team_tids[thread_id] = (pid_t)syscall(SYS_gettid);
+#endif
+  }
+#ifndef _WIN32
+  register_pinned_team(team_tids, cpu_core_list);
+  // Opt-in auto start so production deployments get drift repair without
+  // a code change.
+  static bool watchdog_auto_start = []() {
+    char* enabled = std::getenv("IPEX_CPU_POOL_WATCHDOG");
+    return enabled != nullptr && enabled[0] == '1';
+  }();
+  if (watchdog_auto_start) {
+    int64_t interval_ms = 2000;
+    char* interval_env = std::getenv("IPEX_CPU_POOL_WATCHDOG_INTERVAL_MS");
+    if (interval_env != nullptr) {
+      try {
+        interval_ms = std::stoll(interval_env);
+      } catch (const std::exception&) {
+      }
+    }
+    start_affinity_watchdog(interval_ms);
   }
+#endif
   // Cache the cpu_core_list for query.
   current_cpu_core_list = cpu_core_list;
   return;
@@ -270,20 +641,101 @@ void set_mask_affinity_from_cpu_pool(const CPUPool& cpu_pool) {
   std::vector<kmp_affinity_mask_t> threads_mask =
       cpu_pool.get_cpu_affinity_mask();
   omp_set_num_threads(threads_mask.size());
+#ifndef _WIN32
+  std::vector<pid_t> team_tids(threads_mask.size(), 0);
+#endif
 #pragma omp parallel num_threads(threads_mask.size())
   {
     // we will destory the mask inside the CPUPool deconstructor
     int thread_id = omp_get_thread_num();
     kmp_affinity_mask_t mask = threads_mask[thread_id];
     kmp_set_affinity_ext(&mask);
+#ifndef _WIN32
+    team_tids[thread_id] = (pid_t)syscall(SYS_gettid);
+#endif
+  }
+#ifndef _WIN32
+  // This team is no longer pinned core-per-thread; stop watching it so
+  // the watchdog does not fight the restored mask affinity.
+  unregister_pinned_threads(team_tids);
+#endif
+}
+
+// Rewrite a core list according to the sibling policy before the usual
+// affinity filtering. kPhysicalCoreOnly keeps the lowest logical CPU of
+// every sibling group in the list; kSMTPaired expands the list with all
+// siblings the process may use.
+static std::vector<int32_t> apply_sibling_policy(
+    const std::vector<int32_t>& cpu_core_list,
+    SiblingPolicy sibling_policy) {
+  if (sibling_policy == SiblingPolicy::kUniform) {
+    return cpu_core_list;
+  }
+  if (sibling_policy == SiblingPolicy::kSMTPaired) {
+    return get_smt_siblings_for_cores(cpu_core_list);
+  }
+  // kPhysicalCoreOnly
+  std::vector<int32_t> sorted_core_list(cpu_core_list);
+  std::sort(sorted_core_list.begin(), sorted_core_list.end());
+  sorted_core_list.erase(
+      std::unique(sorted_core_list.begin(), sorted_core_list.end()),
+      sorted_core_list.end());
+  std::vector<int32_t> physical_only;
+  std::vector<int32_t> claimed_siblings;
+  for (auto core_id : sorted_core_list) {
+    if (std::find(
+            claimed_siblings.begin(), claimed_siblings.end(), core_id) !=
+        claimed_siblings.end()) {
+      continue;
+    }
+    physical_only.emplace_back(core_id);
+#ifndef _WIN32
+    std::vector<int32_t> siblings = read_thread_siblings(core_id);
+    claimed_siblings.insert(
+        claimed_siblings.end(), siblings.begin(), siblings.end());
+#endif
+  }
+  return physical_only;
+}
+
+void CPUPool::init_sibling_views() {
+  // Walk the core list in pool order grouping members that share a
+  // physical core. The first member seen of each group is the physical
+  // representative, later members are siblings. Without topology every
+  // core is its own group, so the physical view is the whole list and
+  // the sibling view is empty.
+  std::vector<int32_t> claimed_siblings;
+  for (auto core_id : this->cpu_core_list) {
+    if (std::find(
+            claimed_siblings.begin(), claimed_siblings.end(), core_id) !=
+        claimed_siblings.end()) {
+      this->smt_sibling_list.emplace_back(core_id);
+      continue;
+    }
+    this->physical_core_list.emplace_back(core_id);
+#ifndef _WIN32
+    std::vector<int32_t> siblings = read_thread_siblings(core_id);
+    for (auto sibling_id : siblings) {
+      if (sibling_id != core_id) {
+        claimed_siblings.emplace_back(sibling_id);
+      }
+    }
+#endif
   }
 }
 
 CPUPool::CPUPool(const std::vector<int32_t>& cpu_core_list) {
   this->cpu_core_list = filter_cores_by_thread_affinity(cpu_core_list);
   this->cpu_core_list_initialized_ = true;
+  this->numa_node_list = get_numa_nodes_for_cores(this->cpu_core_list);
+  this->init_sibling_views();
 }
 
+CPUPool::CPUPool(
+    const std::vector<int32_t>& cpu_core_list,
+    SiblingPolicy sibling_policy)
+    : CPUPool(apply_sibling_policy(cpu_core_list, sibling_policy)) {}
+
 CPUPool::CPUPool(std::vector<kmp_affinity_mask_t>&& cpu_core_mask) {
   // Notice: We shouldn't load iomp symbol in sub_thread, otherwise race
   // condition happens.
@@ -305,6 +757,12 @@ CPUPool::CPUPool(CPUPool&& source_cpu_pool) {
     this->cpu_core_list = std::move(
         const_cast<std::vector<int32_t>&>(source_cpu_pool.get_cpu_core_list()));
     this->cpu_core_list_initialized_ = true;
+    this->numa_node_list = std::move(const_cast<std::vector<int32_t>&>(
+        source_cpu_pool.get_numa_node_list()));
+    this->physical_core_list = std::move(const_cast<std::vector<int32_t>&>(
+        source_cpu_pool.get_physical_core_list()));
+    this->smt_sibling_list = std::move(const_cast<std::vector<int32_t>&>(
+        source_cpu_pool.get_smt_sibling_list()));
   } else {
     this->cpu_affinity_mask =
         std::move(const_cast<std::vector<kmp_affinity_mask_t>&>(
@@ -329,6 +787,18 @@ const std::vector<kmp_affinity_mask_t>& CPUPool::get_cpu_affinity_mask() const {
   return this->cpu_affinity_mask;
 }
 
+const std::vector<int32_t>& CPUPool::get_numa_node_list() const {
+  return this->numa_node_list;
+}
+
+const std::vector<int32_t>& CPUPool::get_physical_core_list() const {
+  return this->physical_core_list;
+}
+
+const std::vector<int32_t>& CPUPool::get_smt_sibling_list() const {
+  return this->smt_sibling_list;
+}
+
 bool CPUPool::is_cpu_core_list_initialized() const {
   return this->cpu_core_list_initialized_;
 }
@@ -2,6 +2,7 @@
 #include <omp.h>
 #include <algorithm>
 #include <atomic>
+#include <cstdint>
 #include <mutex>
 #include <vector>
 
@@ -19,14 +20,43 @@ typedef void (*kmp_destroy_affinity_mask_p)(kmp_affinity_mask_t*);
 typedef int (*kmp_get_affinity_p)(kmp_affinity_mask_t*);
 typedef int (*kmp_get_affinity_max_proc_p)();
 
+// Placement policy for the SMT siblings of the cores handed to a pool.
+// Gather-dominated kernels (embedding lookup, MoE routing) gain from
+// running on both hyperthreads of a physical core; compute-dominated
+// kernels (GEMM) lose full-core ownership to port contention. A pool can
+// therefore be constructed physical-core-only or SMT-paired, and every
+// core-list pool exposes both views so callers can dispatch by kernel
+// class.
+enum class SiblingPolicy : int32_t {
+  kUniform = 0, // use the core list exactly as given
+  kPhysicalCoreOnly, // keep one logical CPU per physical core
+  kSMTPaired, // expand the list with the SMT siblings of every core
+};
+
 class IPEX_API CPUPool {
  public:
   explicit CPUPool(const std::vector<int32_t>& cpu_core_list);
+  CPUPool(
+      const std::vector<int32_t>& cpu_core_list,
+      SiblingPolicy sibling_policy);
   explicit CPUPool(std::vector<kmp_affinity_mask_t>&& cpu_core_mask);
   CPUPool(CPUPool&& source_cpu_pool);
 
   const std::vector<int32_t>& get_cpu_core_list() const;
   const std::vector<kmp_affinity_mask_t>& get_cpu_affinity_mask() const;
+  // NUMA node ids covered by the cores of this pool, derived from the
+  // core list at construction. Empty when the pool is expressed as an
+  // affinity mask or when the topology can't be queried.
+  const std::vector<int32_t>& get_numa_node_list() const;
+  // One logical CPU per physical core of this pool (the lowest pool
+  // member of each sibling group) - the view compute kernels should own.
+  // Equals the full core list when SMT is off or the topology can't be
+  // queried; empty when the pool is expressed as an affinity mask.
+  const std::vector<int32_t>& get_physical_core_list() const;
+  // The remaining hyperthread siblings of this pool - the view gather
+  // work can run on without evicting a compute worker from its core.
+  // Disjoint from the physical view; the two together are the core list.
+  const std::vector<int32_t>& get_smt_sibling_list() const;
   bool is_cpu_core_list_initialized() const;
   bool is_cpu_affinity_mask_initialized() const;
   ~CPUPool();
@@ -39,6 +69,12 @@ class IPEX_API CPUPool {
   bool cpu_core_list_initialized_{false};
   std::vector<kmp_affinity_mask_t> cpu_affinity_mask;
   bool cpu_affinity_mask_initialized_{false};
+  std::vector<int32_t> numa_node_list;
+  std::vector<int32_t> physical_core_list;
+  std::vector<int32_t> smt_sibling_list;
+
+  // Split the core list into the physical and sibling views above.
+  void init_sibling_views();
 
   // Put deleted function into private.
   CPUPool() = delete;
@@ -61,6 +97,46 @@ IPEX_API bool is_same_core_affinity_setting(
     const std::vector<int32_t>& cpu_core_list);
 IPEX_API CPUPool get_cpu_pool_from_mask_affinity();
 IPEX_API void set_mask_affinity_from_cpu_pool(const CPUPool& cpu_pool);
+// Map core ids to the NUMA nodes they live on by walking
+// /sys/devices/system/node. Returns an empty vector when the topology
+// is not exposed (non-Linux or single unknown node).
+IPEX_API std::vector<int32_t> get_numa_nodes_for_cores(
+    const std::vector<int32_t>& cpu_core_list);
+// Expand core ids to the full SMT sibling groups they belong to by
+// walking /sys/devices/system/cpu/cpu<N>/topology/thread_siblings_list.
+// Returns a sorted, de-duplicated list including the input cores; just
+// the input cores when the topology is not exposed.
+IPEX_API std::vector<int32_t> get_smt_siblings_for_cores(
+    const std::vector<int32_t>& cpu_core_list);
+// Prefer node-local DRAM for allocations made by the calling thread
+// when the pool maps onto exactly one NUMA node. No-op when libnuma is
+// unavailable or the pool spans several nodes.
+IPEX_API void _bind_numa_memory_node(const CPUPool& cpu_pool);
+
+// Counters accumulated by the affinity watchdog since process start.
+// drift_events counts sweeps that found a worker whose kernel affinity
+// mask no longer matches the core it was pinned to; repin_events counts
+// the successful re-pins; migrations aggregates the se.nr_migrations
+// deltas observed on watched workers.
+struct IPEX_API AffinityWatchdogStats {
+  uint64_t checks{0};
+  uint64_t drift_events{0};
+  uint64_t repin_events{0};
+  uint64_t migrations{0};
+  uint64_t watched_threads{0};
+};
+
+// Background watchdog against silent affinity loss: when another process
+// rewrites our cpuset, the OMP workers pinned by _pin_cpu_cores keep
+// running but drift across cores until the next explicit pin. The
+// watchdog periodically compares each recorded worker's actual kernel
+// affinity with the core it was pinned to, re-pins on drift and tracks
+// the counters above. Linux only; a no-op elsewhere. Set
+// IPEX_CPU_POOL_WATCHDOG=1 to start it automatically on the first
+// _pin_cpu_cores call (interval from IPEX_CPU_POOL_WATCHDOG_INTERVAL_MS).
+IPEX_API void start_affinity_watchdog(int64_t interval_ms = 2000);
+IPEX_API void stop_affinity_watchdog();
+IPEX_API AffinityWatchdogStats get_affinity_watchdog_stats();
 
 class IPEX_API WithCPUPool {
  public:
@@ -0,0 +1,223 @@
+#include "DecodeSlabAllocator.h"
+
+#include <c10/core/Allocator.h>
+#include <c10/util/Exception.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace torch_ipex {
+namespace runtime {
+
+namespace {
+
+// blocks are carved in power-of-two classes between these bounds; larger
+// requests delegate to the wrapped default allocator
+constexpr size_t kMinBlockBytes = 64;
+constexpr size_t kMaxBlockBytes = 256 * 1024;
+constexpr size_t kChunkBytes = 1024 * 1024;
+constexpr int kNumClasses = 13; // 64B .. 256KB
+
+// depth of active DecodeSlabScopes on this thread; the installed
+// allocator only routes to the slab while this is non-zero, so the
+// global install never affects threads outside a scope
+thread_local int slab_scope_depth = 0;
+
+std::atomic<bool> task_slab_enabled{[]() {
+  char* val = std::getenv("IPEX_TASK_SLAB_ALLOCATOR");
+  return val != NULL && std::string(val) == "1";
+}()};
+
+// the allocator that was installed before the slab wrapper; delegated
+// allocations and raw frees of non-slab pointers go through it
+at::Allocator* slab_fallback_allocator = nullptr;
+
+std::mutex slab_mutex;
+std::vector<void*> slab_chunks; // whole chunks, for release
+std::vector<std::vector<void*>> free_lists(kNumClasses);
+std::unordered_map<void*, int> block_class; // carved block -> class
+std::atomic<uint64_t> stat_hits{0};
+std::atomic<uint64_t> stat_misses{0};
+std::atomic<uint64_t> stat_delegated{0};
+uint64_t reserved_bytes = 0; // guarded by slab_mutex
+uint64_t outstanding_blocks = 0; // guarded by slab_mutex
+
+inline int size_class_of(size_t nbytes) {
+  size_t size = kMinBlockBytes;
+  int cls = 0;
+  while (size < nbytes) {
+    size <<= 1;
+    cls++;
+  }
+  return cls;
+}
+
+inline size_t class_bytes(int cls) {
+  return kMinBlockBytes << cls;
+}
+
+void slab_free(void* ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> guard(slab_mutex);
+    auto it = block_class.find(ptr);
+    if (it != block_class.end()) {
+      free_lists[it->second].emplace_back(ptr);
+      outstanding_blocks--;
+      return;
+    }
+  }
+  // Not a slab block. Raw allocations lose the per-DataPtr deleter
+  // pairing, so callers that raw_allocate through the installed slab
+  // allocator (LLGA allocator hooks, scratchpad arenas) land here with
+  // pointers allocate() delegated to the wrapped allocator - forward
+  // them to its deleter.
+  TORCH_INTERNAL_ASSERT(
+      slab_fallback_allocator != nullptr,
+      "DecodeSlabAllocator: freeing before install");
+  slab_fallback_allocator->raw_deallocate(ptr);
+}
+
+void* slab_allocate(size_t nbytes) {
+  int cls = size_class_of(nbytes);
+  std::lock_guard<std::mutex> guard(slab_mutex);
+  auto& list = free_lists[cls];
+  if (!list.empty()) {
+    void* ptr = list.back();
+    list.pop_back();
+    stat_hits++;
+    outstanding_blocks++;
+    return ptr;
+  }
+  // carve a fresh chunk into blocks of this class; the first block is
+  // returned, the rest seed the free list for the next decode step
+  size_t block_bytes = class_bytes(cls);
+  size_t chunk_bytes = std::max(kChunkBytes, block_bytes);
+  void* chunk = nullptr;
+  int err = posix_memalign(&chunk, kMinBlockBytes, chunk_bytes);
+  TORCH_CHECK(
+      err == 0 && chunk != nullptr,
+      "DecodeSlabAllocator: failed to reserve a ",
+      chunk_bytes,
+      " byte slab chunk");
+  slab_chunks.emplace_back(chunk);
+  reserved_bytes += chunk_bytes;
+  auto num_blocks = chunk_bytes / block_bytes;
+  for (size_t i = 1; i < num_blocks; i++) {
+    void* block = static_cast<char*>(chunk) + i * block_bytes;
+    block_class.emplace(block, cls);
+    list.emplace_back(block);
+  }
+  block_class.emplace(chunk, cls);
+  stat_misses++;
+  outstanding_blocks++;
+  return chunk;
+}
+
+// Wraps the default CPU allocator: requests from a thread inside a
+// DecodeSlabScope and small enough for a slab block are served from the
+// free lists, everything else passes straight through. Each DataPtr
+// carries its own deleter, so allocations from before the install are
+// freed correctly by their original allocator and vice versa.
+class DecodeSlabAllocator final : public at::Allocator {
+ public:
+  explicit DecodeSlabAllocator(at::Allocator* fallback)
+      : fallback_(fallback) {}
+
+  at::DataPtr allocate(size_t nbytes) const override {
+    if (slab_scope_depth == 0 || nbytes == 0 || nbytes > kMaxBlockBytes) {
+      stat_delegated++;
+      return fallback_->allocate(nbytes);
+    }
+    void* ptr = slab_allocate(nbytes);
+    return {ptr, ptr, &slab_free, at::Device(at::DeviceType::CPU)};
+  }
+
+  at::DeleterFnPtr raw_deleter() const override {
+    return &slab_free;
+  }
+
+  void copy_data(void* dest, const void* src, std::size_t count)
+      const override {
+    default_copy_data(dest, src, count);
+  }
+
+ private:
+  at::Allocator* fallback_;
+};
+
+std::once_flag install_once;
+
+void ensure_installed() {
+  std::call_once(install_once, []() {
+    slab_fallback_allocator = c10::GetAllocator(c10::DeviceType::CPU);
+    static DecodeSlabAllocator allocator(slab_fallback_allocator);
+    c10::SetAllocator(c10::DeviceType::CPU, &allocator);
+  });
+}
+
+} // namespace
+
+DecodeSlabScope::DecodeSlabScope(bool active) : active_(active) {
+  if (active_) {
+    ensure_installed();
+    slab_scope_depth++;
+  }
+}
+
+DecodeSlabScope::~DecodeSlabScope() {
+  if (active_) {
+    slab_scope_depth--;
+  }
+}
+
+void set_task_slab_allocator_enabled(bool enabled) {
+  task_slab_enabled = enabled;
+}
+
+bool is_task_slab_allocator_enabled() {
+  return task_slab_enabled;
+}
+
+DecodeSlabStats get_decode_slab_stats() {
+  DecodeSlabStats stats;
+  stats.slab_hits = stat_hits;
+  stats.slab_misses = stat_misses;
+  stats.delegated = stat_delegated;
+  {
+    std::lock_guard<std::mutex> guard(slab_mutex);
+    stats.reserved_bytes = reserved_bytes;
+    stats.outstanding_blocks = outstanding_blocks;
+  }
+  return stats;
+}
+
+void release_decode_slab_memory() {
+  std::lock_guard<std::mutex> guard(slab_mutex);
+  if (outstanding_blocks != 0) {
+    TORCH_WARN(
+        "release_decode_slab_memory: ",
+        outstanding_blocks,
+        " slab blocks are still in use; keeping the slab chunks");
+    return;
+  }
+  for (auto* chunk : slab_chunks) {
+    free(chunk);
+  }
+  slab_chunks.clear();
+  block_class.clear();
+  for (auto& list : free_lists) {
+    list.clear();
+  }
+  reserved_bytes = 0;
+}
+
+} // namespace runtime
+} // namespace torch_ipex
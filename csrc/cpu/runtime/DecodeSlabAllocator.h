@@ -0,0 +1,55 @@
+#pragma once
+
+#include <Macros.h>
+#include <cstdint>
+
+namespace torch_ipex {
+namespace runtime {
+
+struct IPEX_API DecodeSlabStats {
+  // allocations served from a recycled slab block
+  uint64_t slab_hits;
+  // allocations that carved a fresh block out of a slab chunk
+  uint64_t slab_misses;
+  // allocations delegated to the default CPU allocator (scope inactive
+  // or size above the slab block limit)
+  uint64_t delegated;
+  // bytes currently reserved in slab chunks
+  uint64_t reserved_bytes;
+  // slab blocks currently handed out and not yet freed
+  uint64_t outstanding_blocks;
+};
+
+// Scoped slab allocator for the per-token tensor population of decode
+// steps. While a scope is active on a thread, small CPU allocations on
+// that thread are served from power-of-two free lists backed by large
+// slab chunks; frees return blocks to the lists instead of the default
+// allocator's size classes, so after the first decode iteration the
+// whole token-step allocation pattern is recycled without touching
+// malloc. Other threads and large allocations keep the default
+// allocator. TaskModule wraps its submitted work in a scope when
+// enabled (set_task_slab_allocator_enabled or IPEX_TASK_SLAB_ALLOCATOR=1).
+class IPEX_API DecodeSlabScope {
+ public:
+  explicit DecodeSlabScope(bool active = true);
+  ~DecodeSlabScope();
+
+ private:
+  bool active_;
+
+  DecodeSlabScope(const DecodeSlabScope&) = delete;
+  DecodeSlabScope& operator=(const DecodeSlabScope&) = delete;
+};
+
+IPEX_API void set_task_slab_allocator_enabled(bool enabled);
+
+IPEX_API bool is_task_slab_allocator_enabled();
+
+IPEX_API DecodeSlabStats get_decode_slab_stats();
+
+// Return all cached slab chunks to the system. A no-op (with a warning)
+// while slab blocks are still outstanding.
+IPEX_API void release_decode_slab_memory();
+
+} // namespace runtime
+} // namespace torch_ipex
@@ -0,0 +1,304 @@
+#include "KVCacheTier.h"
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace torch_ipex {
+namespace runtime {
+
+namespace {
+
+#ifndef _WIN32
+// A file-backed MAP_SHARED region: the kernel may write its pages back
+// and evict them under memory pressure, so spilled blocks do not count
+// against the resident set. The file is unlinked right away; placing it
+// on a CXL-backed or disk mount is controlled by IPEX_KV_TIER_DIR.
+void* map_tier_file(size_t size) {
+  const char* dir = std::getenv("IPEX_KV_TIER_DIR");
+  std::string path(dir != nullptr ? dir : "/tmp");
+  path += "/ipex_kv_tier_XXXXXX";
+  std::vector<char> tmpl(path.begin(), path.end());
+  tmpl.push_back('\0');
+  int fd = mkstemp(tmpl.data());
+  TORCH_CHECK(fd >= 0, "KVCacheTierManager: cannot create tier file in ", path);
+  unlink(tmpl.data());
+  if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+    close(fd);
+    TORCH_CHECK(false, "KVCacheTierManager: cannot size tier file");
+  }
+  void* data =
+      mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  TORCH_CHECK(
+      data != MAP_FAILED, "KVCacheTierManager: cannot map tier file");
+  return data;
+}
+
+// Drop the page-aligned interior of [data, data + nbytes) from DRAM.
+// Partial pages at the edges are shared with neighbouring blocks and
+// stay resident.
+void drop_pages(char* data, size_t nbytes) {
+  static const size_t page_size = sysconf(_SC_PAGESIZE);
+  auto base = reinterpret_cast<uintptr_t>(data);
+  auto first = (base + page_size - 1) & ~(static_cast<uintptr_t>(page_size) - 1);
+  auto last = (base + nbytes) & ~(static_cast<uintptr_t>(page_size) - 1);
+  if (last > first) {
+    madvise(reinterpret_cast<void*>(first), last - first, MADV_DONTNEED);
+  }
+}
+#endif
+
+} // namespace
+
+KVCacheTierManager::KVCacheTierManager() {
+  this->worker =
+      std::make_shared<std::thread>([this] { this->worker_main(); });
+}
+
+KVCacheTierManager::~KVCacheTierManager() {
+  {
+    std::unique_lock<std::mutex> lock(this->jobs_mutex);
+    this->stop = true;
+  }
+  this->jobs_condition.notify_all();
+  this->worker->join();
+  std::unique_lock<std::mutex> lock(this->state_mutex);
+  this->release_tier_locked();
+}
+
+void KVCacheTierManager::register_cache(
+    const std::vector<at::Tensor>& caches) {
+  TORCH_CHECK(
+      !caches.empty(), "KVCacheTierManager: expect at least one cache tensor");
+  int64_t blocks = caches[0].size(0);
+  std::vector<at::Tensor> held;
+  held.reserve(caches.size());
+  for (auto& cache : caches) {
+    TORCH_CHECK(
+        cache.device().is_cpu() && cache.is_contiguous(),
+        "KVCacheTierManager only handles contiguous CPU tensors");
+    TORCH_CHECK(
+        cache.dim() >= 1 && cache.size(0) == blocks,
+        "KVCacheTierManager: all cache tensors must share the block count");
+    held.emplace_back(cache);
+  }
+  this->wait();
+  std::unique_lock<std::mutex> lock(this->state_mutex);
+  this->release_tier_locked();
+  this->caches = std::move(held);
+  this->block_count = blocks;
+  this->last_touch.assign(blocks, 0);
+  this->spilled.assign(blocks, 0);
+  this->tiers.clear();
+  for (auto& cache : this->caches) {
+    TierRegion region;
+    region.block_bytes =
+        static_cast<size_t>(cache.nbytes() / std::max<int64_t>(blocks, 1));
+    region.size = region.block_bytes * static_cast<size_t>(blocks);
+#ifndef _WIN32
+    region.data = region.size > 0 ? map_tier_file(region.size) : nullptr;
+#endif
+    this->tiers.emplace_back(region);
+  }
+}
+
+void KVCacheTierManager::clear() {
+  {
+    std::unique_lock<std::mutex> lock(this->jobs_mutex);
+    this->jobs.clear();
+  }
+  this->wait();
+  std::unique_lock<std::mutex> lock(this->state_mutex);
+  this->release_tier_locked();
+  this->caches.clear();
+  this->last_touch.clear();
+  this->spilled.clear();
+  this->block_count = 0;
+  this->spill_bytes.store(0, std::memory_order_relaxed);
+  this->fetch_bytes.store(0, std::memory_order_relaxed);
+}
+
+void KVCacheTierManager::touch(
+    const std::vector<int64_t>& block_ids,
+    int64_t step) {
+  std::unique_lock<std::mutex> lock(this->state_mutex);
+  for (auto block_id : block_ids) {
+    if (block_id >= 0 && block_id < this->block_count) {
+      this->last_touch[block_id] = step;
+    }
+  }
+}
+
+void KVCacheTierManager::spill_older_than(int64_t step_threshold) {
+  {
+    std::unique_lock<std::mutex> lock(this->jobs_mutex);
+    Job job;
+    job.kind = JobKind::SPILL_OLDER_THAN;
+    job.step_threshold = step_threshold;
+    this->jobs.emplace_back(std::move(job));
+  }
+  this->jobs_condition.notify_one();
+}
+
+void KVCacheTierManager::prefetch(const std::vector<int64_t>& block_ids) {
+  {
+    std::unique_lock<std::mutex> lock(this->jobs_mutex);
+    Job job;
+    job.kind = JobKind::FETCH;
+    job.block_ids = block_ids;
+    this->jobs.emplace_back(std::move(job));
+  }
+  this->jobs_condition.notify_one();
+}
+
+void KVCacheTierManager::wait() {
+  std::unique_lock<std::mutex> lock(this->jobs_mutex);
+  this->idle_condition.wait(
+      lock, [this] { return this->jobs.empty() && !this->busy; });
+}
+
+size_t KVCacheTierManager::num_blocks() const {
+  std::unique_lock<std::mutex> lock(this->state_mutex);
+  return static_cast<size_t>(this->block_count);
+}
+
+size_t KVCacheTierManager::spilled_blocks() const {
+  std::unique_lock<std::mutex> lock(this->state_mutex);
+  size_t count = 0;
+  for (auto flag : this->spilled) {
+    count += flag != 0;
+  }
+  return count;
+}
+
+uint64_t KVCacheTierManager::bytes_spilled() const {
+  return this->spill_bytes.load(std::memory_order_relaxed);
+}
+
+uint64_t KVCacheTierManager::bytes_fetched() const {
+  return this->fetch_bytes.load(std::memory_order_relaxed);
+}
+
+void KVCacheTierManager::worker_main() {
+  while (true) {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(this->jobs_mutex);
+      this->jobs_condition.wait(
+          lock, [this] { return this->stop || !this->jobs.empty(); });
+      if (this->stop) {
+        break;
+      }
+      job = std::move(this->jobs.front());
+      this->jobs.pop_front();
+      this->busy = true;
+    }
+    this->run_job(job);
+    {
+      std::unique_lock<std::mutex> lock(this->jobs_mutex);
+      this->busy = false;
+    }
+    this->idle_condition.notify_all();
+  }
+}
+
+void KVCacheTierManager::run_job(const Job& job) {
+  if (job.kind == JobKind::SPILL_OLDER_THAN) {
+    // Snapshot the candidate set, then spill block by block so touch()
+    // and the stats calls never wait behind a long copy.
+    std::vector<int64_t> cold;
+    {
+      std::unique_lock<std::mutex> lock(this->state_mutex);
+      for (int64_t b = 0; b < this->block_count; b++) {
+        if (this->spilled[b] == 0 &&
+            this->last_touch[b] < job.step_threshold) {
+          cold.emplace_back(b);
+        }
+      }
+    }
+    for (auto block_id : cold) {
+      this->spill_block(block_id);
+    }
+  } else {
+    for (auto block_id : job.block_ids) {
+      this->fetch_block(block_id);
+    }
+  }
+}
+
+void KVCacheTierManager::spill_block(int64_t block_id) {
+#ifdef _WIN32
+  // No file-backed mmap tier on Windows: every block stays resident, so
+  // spill requests are no-ops and prefetches find nothing to fetch.
+  (void)block_id;
+#else
+  std::unique_lock<std::mutex> lock(this->state_mutex);
+  if (block_id < 0 || block_id >= this->block_count ||
+      this->spilled[block_id] != 0) {
+    return;
+  }
+  for (size_t c = 0; c < this->caches.size(); c++) {
+    auto& region = this->tiers[c];
+    if (region.block_bytes == 0) {
+      continue;
+    }
+    auto* src = static_cast<char*>(this->caches[c].data_ptr()) +
+        static_cast<size_t>(block_id) * region.block_bytes;
+    auto* dst =
+        static_cast<char*>(region.data) +
+        static_cast<size_t>(block_id) * region.block_bytes;
+    std::memcpy(dst, src, region.block_bytes);
+    drop_pages(src, region.block_bytes);
+    this->spill_bytes.fetch_add(region.block_bytes, std::memory_order_relaxed);
+  }
+  this->spilled[block_id] = 1;
+#endif
+}
+
+void KVCacheTierManager::fetch_block(int64_t block_id) {
+  std::unique_lock<std::mutex> lock(this->state_mutex);
+  if (block_id < 0 || block_id >= this->block_count ||
+      this->spilled[block_id] == 0) {
+    return;
+  }
+  for (size_t c = 0; c < this->caches.size(); c++) {
+    auto& region = this->tiers[c];
+    if (region.block_bytes == 0) {
+      continue;
+    }
+    auto* src =
+        static_cast<const char*>(region.data) +
+        static_cast<size_t>(block_id) * region.block_bytes;
+    auto* dst = static_cast<char*>(this->caches[c].data_ptr()) +
+        static_cast<size_t>(block_id) * region.block_bytes;
+    std::memcpy(dst, src, region.block_bytes);
+    this->fetch_bytes.fetch_add(region.block_bytes, std::memory_order_relaxed);
+  }
+  this->spilled[block_id] = 0;
+}
+
+void KVCacheTierManager::release_tier_locked() {
+#ifndef _WIN32
+  for (auto& region : this->tiers) {
+    if (region.data != nullptr) {
+      munmap(region.data, region.size);
+    }
+  }
+#endif
+  this->tiers.clear();
+}
+
+KVCacheTierManager& get_kv_cache_tier_manager() {
+  static KVCacheTierManager instance;
+  return instance;
+}
+
+} // namespace runtime
+} // namespace torch_ipex
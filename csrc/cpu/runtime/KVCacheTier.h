@@ -0,0 +1,113 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <ATen/ATen.h>
+#include <Macros.h>
+
+namespace torch_ipex {
+namespace runtime {
+
+// KVCacheTierManager shrinks the resident KV footprint of long-lived
+// sequences to the active working set. It works on the block structure
+// of the paged KV caches (dim 0 of each registered cache tensor is the
+// block index): the serving loop reports which blocks each step touched,
+// and a background thread spills blocks that have gone cold to a
+// file-backed mmap tier (which the kernel can write back and evict, or
+// which can live on a CXL-backed mount) while dropping their DRAM pages
+// with madvise(MADV_DONTNEED). When the scheduler re-activates a
+// sequence it prefetches the blocks back before attention reads them.
+//
+// The tier copy is authoritative for a spilled block; reading a spilled
+// block through the cache tensor without a prefetch returns dropped
+// (zeroed) pages. Spill and fetch requests are queued and never dropped;
+// wait() drains the queue for callers that need the fetch completed.
+class IPEX_API KVCacheTierManager {
+ public:
+  KVCacheTierManager();
+  ~KVCacheTierManager();
+
+  // Register the paged cache tensors (e.g. key_cache and value_cache).
+  // All tensors must be contiguous CPU tensors sharing the same block
+  // count on dim 0. Replaces any previously registered cache.
+  void register_cache(const std::vector<at::Tensor>& caches);
+  void clear();
+
+  // Bookkeeping only: record that `block_ids` were read or written at
+  // scheduler step `step`.
+  void touch(const std::vector<int64_t>& block_ids, int64_t step);
+
+  // Asynchronously spill every resident block whose last touch is older
+  // than `step_threshold`.
+  void spill_older_than(int64_t step_threshold);
+
+  // Asynchronously copy the given blocks back into the cache tensors.
+  void prefetch(const std::vector<int64_t>& block_ids);
+
+  // Block until all queued spill/fetch work has completed.
+  void wait();
+
+  size_t num_blocks() const;
+  size_t spilled_blocks() const;
+  uint64_t bytes_spilled() const;
+  uint64_t bytes_fetched() const;
+
+ private:
+  struct TierRegion {
+    void* data{nullptr};
+    size_t size{0};
+    size_t block_bytes{0};
+  };
+
+  enum class JobKind { SPILL_OLDER_THAN, FETCH };
+  struct Job {
+    JobKind kind;
+    int64_t step_threshold{0};
+    std::vector<int64_t> block_ids;
+  };
+
+  void worker_main();
+  void run_job(const Job& job);
+  void spill_block(int64_t block_id);
+  void fetch_block(int64_t block_id);
+  void release_tier_locked();
+
+  std::vector<at::Tensor> caches;
+  std::vector<TierRegion> tiers;
+  std::vector<int64_t> last_touch;
+  std::vector<char> spilled;
+  int64_t block_count{0};
+  mutable std::mutex state_mutex;
+
+  std::shared_ptr<std::thread> worker;
+  std::deque<Job> jobs;
+  bool busy{false};
+  bool stop{false};
+  std::mutex jobs_mutex;
+  std::condition_variable jobs_condition;
+  std::condition_variable idle_condition;
+  std::atomic<uint64_t> spill_bytes{0};
+  std::atomic<uint64_t> fetch_bytes{0};
+
+  // Put the deleted function in the private.
+  KVCacheTierManager(const KVCacheTierManager& kv_cache_tier_manager) = delete;
+  KVCacheTierManager(KVCacheTierManager&& kv_cache_tier_manager) = delete;
+  KVCacheTierManager& operator=(
+      const KVCacheTierManager& kv_cache_tier_manager) = delete;
+  KVCacheTierManager& operator=(KVCacheTierManager&& kv_cache_tier_manager) =
+      delete;
+};
+
+// Process-wide instance used by the python bindings; serving processes
+// host one paged KV cache, so one tiering manager is enough.
+IPEX_API KVCacheTierManager& get_kv_cache_tier_manager();
+
+} // namespace runtime
+} // namespace torch_ipex
@@ -0,0 +1,183 @@
+#include "PersistentTeam.h"
+
+#include <immintrin.h>
+#include <algorithm>
+#include <cstdlib>
+
+#include <ATen/Parallel.h>
+
+namespace torch_ipex {
+namespace runtime {
+
+PersistentTeam::PersistentTeam(
+    const torch_ipex::runtime::CPUPool& cpu_pool,
+    size_t num_workers) {
+  this->stop = false;
+  // One worker per core of the pool by default; the caller thread of
+  // run() participates as well, so its own core stays busy too.
+  if (num_workers == 0) {
+    if (cpu_pool.is_cpu_core_list_initialized()) {
+      num_workers = cpu_pool.get_cpu_core_list().size();
+    } else {
+      num_workers = 1;
+    }
+  }
+  this->workers.reserve(num_workers);
+  for (size_t worker_id = 0; worker_id < num_workers; ++worker_id) {
+    this->workers.emplace_back(std::make_shared<std::thread>(
+        [&cpu_pool, this] { this->worker_main(cpu_pool); }));
+  }
+}
+
+void PersistentTeam::work_on(RangeJob* job) {
+  while (true) {
+    int64_t chunk = job->next_chunk.fetch_add(1, std::memory_order_relaxed);
+    if (chunk >= job->num_chunks) {
+      return;
+    }
+    int64_t chunk_begin = job->begin + chunk * job->chunk_size;
+    int64_t chunk_end = std::min(chunk_begin + job->chunk_size, job->end);
+    (*job->fn)(chunk_begin, chunk_end);
+    job->remaining_chunks.fetch_sub(1, std::memory_order_release);
+  }
+}
+
+void PersistentTeam::run(
+    int64_t begin,
+    int64_t end,
+    int64_t grain_size,
+    const std::function<void(int64_t, int64_t)>& fn) {
+  if (begin >= end) {
+    return;
+  }
+  if (this->stop.load(std::memory_order_acquire)) {
+    throw std::runtime_error("run() on a stopped PersistentTeam");
+  }
+  std::unique_lock<std::mutex> run_lock(this->run_mutex);
+  auto job = std::make_shared<RangeJob>();
+  job->fn = &fn;
+  job->begin = begin;
+  job->end = end;
+  // Enough chunks for the whole team (workers + caller) but never
+  // smaller than the requested grain.
+  int64_t range = end - begin;
+  int64_t min_chunk = std::max<int64_t>(grain_size, 1);
+  int64_t team_size = static_cast<int64_t>(this->workers.size()) + 1;
+  job->chunk_size = std::max<int64_t>(min_chunk, (range + team_size - 1) / team_size);
+  job->num_chunks = (range + job->chunk_size - 1) / job->chunk_size;
+  job->remaining_chunks.store(job->num_chunks, std::memory_order_relaxed);
+  std::atomic_store(&this->current_job, job);
+  this->job_epoch.fetch_add(1, std::memory_order_release);
+  // Wake workers only when somebody is actually parked; in steady
+  // state the workers spin through the epoch check and this branch is
+  // never taken.
+  if (this->sleeping_worker_count.load(std::memory_order_acquire) != 0) {
+    std::unique_lock<std::mutex> lock(this->team_mutex);
+    this->team_condition.notify_all();
+  }
+  // The caller is part of the team.
+  work_on(job.get());
+  // Wait for the chunks claimed by the workers.
+  while (job->remaining_chunks.load(std::memory_order_acquire) != 0) {
+    _mm_pause();
+  }
+  std::atomic_store(&this->current_job, std::shared_ptr<RangeJob>());
+}
+
+void PersistentTeam::worker_main(
+    const torch_ipex::runtime::CPUPool& cpu_pool) {
+  if (is_runtime_ext_enabled()) {
+    _pin_cpu_cores(cpu_pool);
+  }
+  uint64_t seen_epoch = this->job_epoch.load(std::memory_order_acquire);
+  int spin_count = 0;
+  while (!this->stop.load(std::memory_order_acquire)) {
+    uint64_t epoch = this->job_epoch.load(std::memory_order_acquire);
+    if (epoch != seen_epoch) {
+      seen_epoch = epoch;
+      spin_count = 0;
+      auto job = std::atomic_load(&this->current_job);
+      if (job != nullptr) {
+        work_on(job.get());
+      }
+      continue;
+    }
+    if (++spin_count < kSpinBeforeSleep) {
+      _mm_pause();
+      continue;
+    }
+    // Park until the next job; re-check the epoch under the lock so a
+    // publish between the spin and the wait is not missed.
+    this->sleeping_worker_count.fetch_add(1, std::memory_order_release);
+    {
+      std::unique_lock<std::mutex> lock(this->team_mutex);
+      this->team_condition.wait(lock, [this, seen_epoch] {
+        return this->stop.load(std::memory_order_acquire) ||
+            this->job_epoch.load(std::memory_order_acquire) != seen_epoch;
+      });
+    }
+    this->sleeping_worker_count.fetch_sub(1, std::memory_order_release);
+    spin_count = 0;
+  }
+}
+
+size_t PersistentTeam::get_num_workers() const {
+  return this->workers.size();
+}
+
+void PersistentTeam::stop_team() {
+  bool should_wait_worker_join = false;
+  {
+    std::unique_lock<std::mutex> lock(this->team_mutex);
+    if (this->stop == false) {
+      should_wait_worker_join = true;
+      this->stop = true;
+    }
+  }
+  if (should_wait_worker_join) {
+    this->team_condition.notify_all();
+    for (auto& worker : this->workers) {
+      worker->join();
+    }
+  }
+  return;
+}
+
+PersistentTeam::~PersistentTeam() {
+  this->stop_team();
+}
+
+bool persistent_team_enabled() {
+  static int enabled = []() {
+    auto* env = getenv("IPEX_PERSISTENT_TEAM");
+    return env != nullptr ? atoi(env) : 0;
+  }();
+  return enabled != 0;
+}
+
+PersistentTeam* get_default_persistent_team() {
+  // Leaked on purpose: workers must outlive every kernel call and
+  // static destruction order at process exit is not worth the risk.
+  static PersistentTeam* team = []() {
+    static torch_ipex::runtime::CPUPool pool(get_process_available_cores());
+    return new PersistentTeam(pool);
+  }();
+  return team;
+}
+
+void persistent_parallel_for(
+    int64_t begin,
+    int64_t end,
+    int64_t grain_size,
+    const std::function<void(int64_t, int64_t)>& fn) {
+  // Inside an existing parallel region the team is busy by definition;
+  // let at::parallel_for run the range serially as it would anyway.
+  if (persistent_team_enabled() && !at::in_parallel_region()) {
+    get_default_persistent_team()->run(begin, end, grain_size, fn);
+    return;
+  }
+  at::parallel_for(begin, end, grain_size, fn);
+}
+
+} // namespace runtime
+} // namespace torch_ipex
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <Macros.h>
+#include "CPUPool.h"
+
+namespace torch_ipex {
+namespace runtime {
+
+// PersistentTeam keeps one worker per core of a CPUPool alive in a run
+// loop so a sequence of small range kernels does not pay an omp
+// fork/join per op. run() splits [begin, end) into grain-sized chunks
+// that the workers and the calling thread claim with one fetch_add
+// each; the call returns when every chunk is done. Workers spin for a
+// while between jobs and then park on a condition variable, so a team
+// idle between decode steps does not burn its cores forever.
+class IPEX_API PersistentTeam {
+ public:
+  explicit PersistentTeam(
+      const torch_ipex::runtime::CPUPool& cpu_pool,
+      size_t num_workers = 0);
+  // Run fn(chunk_begin, chunk_end) over [begin, end) on the team. The
+  // caller participates and blocks until the whole range is covered.
+  // Nested run() calls from inside fn are not supported.
+  void run(
+      int64_t begin,
+      int64_t end,
+      int64_t grain_size,
+      const std::function<void(int64_t, int64_t)>& fn);
+  size_t get_num_workers() const;
+  void stop_team();
+  ~PersistentTeam();
+
+ private:
+  // One range job, heap allocated per run() and handed to the workers
+  // through an atomic shared_ptr slot: a worker that observes the epoch
+  // late still holds a live object and simply finds no chunk left.
+  struct RangeJob {
+    const std::function<void(int64_t, int64_t)>* fn{nullptr};
+    int64_t begin{0};
+    int64_t end{0};
+    int64_t chunk_size{1};
+    int64_t num_chunks{0};
+    std::atomic<int64_t> next_chunk{0};
+    std::atomic<int64_t> remaining_chunks{0};
+  };
+
+  // Pops a worker spins through before parking on team_condition.
+  static constexpr int kSpinBeforeSleep = 8192;
+
+  void worker_main(const torch_ipex::runtime::CPUPool& cpu_pool);
+  static void work_on(RangeJob* job);
+
+  std::shared_ptr<RangeJob> current_job;
+  std::atomic<uint64_t> job_epoch{0};
+  std::atomic<size_t> sleeping_worker_count{0};
+  std::atomic<bool> stop;
+  std::mutex team_mutex;
+  std::condition_variable team_condition;
+  // serializes concurrent run() callers; the team handles one job at a
+  // time
+  std::mutex run_mutex;
+  std::vector<std::shared_ptr<std::thread>> workers;
+
+  // Put the deleted function in the private.
+  PersistentTeam(const PersistentTeam& team) = delete;
+  PersistentTeam(PersistentTeam&& team) = delete;
+  PersistentTeam& operator=(const PersistentTeam& team) = delete;
+  PersistentTeam& operator=(PersistentTeam&& team) = delete;
+};
+
+// True when IPEX_PERSISTENT_TEAM=1: persistent_parallel_for then routes
+// range kernels through a process-wide team built from the cores
+// available to the process instead of opening an omp region per op.
+IPEX_API bool persistent_team_enabled();
+IPEX_API PersistentTeam* get_default_persistent_team();
+// Drop-in replacement for at::parallel_for(begin, end, grain, fn) used
+// by kernels that want to amortize team wakeup across many small ops.
+// Falls back to at::parallel_for when the team mode is off.
+IPEX_API void persistent_parallel_for(
+    int64_t begin,
+    int64_t end,
+    int64_t grain_size,
+    const std::function<void(int64_t, int64_t)>& fn);
+
+} // namespace runtime
+} // namespace torch_ipex
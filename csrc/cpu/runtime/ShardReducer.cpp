@@ -0,0 +1,160 @@
+#include "ShardReducer.h"
+
+#include <ATen/WrapDimUtils.h>
+
+namespace torch_ipex {
+namespace runtime {
+
+ShardReducer::ShardReducer(size_t num_shards, ReduceOp op, int64_t cat_dim)
+    : num_shards_(num_shards), op_(op), cat_dim_(cat_dim) {
+  TORCH_CHECK(
+      num_shards_ >= 1, "ShardReducer needs at least one shard, got 0.");
+  if (op_ == ReduceOp::kSum) {
+    // Pad the leaf count to a power of two so every level halves the
+    // index range; nodes whose subtree holds a single real shard just
+    // pass the carry upward.
+    size_t padded = 1;
+    while (padded < num_shards_) {
+      padded <<= 1;
+      num_levels_++;
+    }
+    size_t node_count = 0;
+    for (size_t level = 0; level < num_levels_; level++) {
+      level_base_.push_back(node_count);
+      node_count += padded >> (level + 1);
+    }
+    tree_nodes_ = std::vector<TreeNode>(node_count);
+    for (size_t level = 0; level < num_levels_; level++) {
+      for (size_t i = 0; i < (padded >> (level + 1)); i++) {
+        size_t low_leaf = i << (level + 1);
+        size_t high_leaf = low_leaf + (static_cast<size_t>(1) << level);
+        int expected = 0;
+        if (low_leaf < num_shards_) {
+          expected++;
+        }
+        if (high_leaf < num_shards_) {
+          expected++;
+        }
+        tree_nodes_[level_base_[level] + i].expected_arrivals = expected;
+      }
+    }
+  } else {
+    shards_.resize(num_shards_);
+    offsets_.resize(num_shards_, 0);
+  }
+}
+
+void ShardReducer::submit(size_t shard_id, const at::Tensor& shard) {
+  TORCH_CHECK(
+      shard_id < num_shards_,
+      "ShardReducer::submit got shard_id ",
+      shard_id,
+      " but the reducer was built for ",
+      num_shards_,
+      " shards.");
+  TORCH_CHECK(
+      shard.defined(), "ShardReducer::submit got an undefined tensor.");
+  if (op_ == ReduceOp::kSum) {
+    submit_sum(shard_id, shard);
+  } else {
+    submit_concat(shard_id, shard);
+  }
+}
+
+void ShardReducer::submit_sum(size_t shard_id, const at::Tensor& shard) {
+  at::Tensor carry = shard;
+  for (size_t level = 0; level < num_levels_; level++) {
+    TreeNode& node =
+        tree_nodes_[level_base_[level] + (shard_id >> (level + 1))];
+    if (node.expected_arrivals == 1) {
+      // The partner subtree has no real shard; climb without parking.
+      continue;
+    }
+    std::lock_guard<std::mutex> guard(node.mutex);
+    if (!node.parked.defined()) {
+      // First arriver parks its partial sum and leaves; the partner
+      // carries the combined result upward.
+      node.parked = carry;
+      return;
+    }
+    // Accumulate into the arriving worker's own (NUMA-local) buffer so
+    // only the parked half is pulled across the interconnect.
+    carry.add_(node.parked);
+    node.parked.reset();
+  }
+  publish_result(std::move(carry));
+}
+
+void ShardReducer::submit_concat(size_t shard_id, const at::Tensor& shard) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  TORCH_CHECK(
+      !shards_[shard_id].defined(),
+      "ShardReducer::submit got shard ",
+      shard_id,
+      " twice in one iteration.");
+  shards_[shard_id] = shard;
+  arrived_++;
+  if (arrived_ == num_shards_) {
+    // Last arriver sizes the output once; everyone then copies its own
+    // slice in parallel from its own pool.
+    int64_t dim = at::maybe_wrap_dim(cat_dim_, shards_[0].dim());
+    int64_t total_size = 0;
+    for (size_t i = 0; i < num_shards_; i++) {
+      offsets_[i] = total_size;
+      total_size += shards_[i].size(dim);
+    }
+    auto out_sizes = shards_[0].sizes().vec();
+    out_sizes[dim] = total_size;
+    concat_out_ = at::empty(out_sizes, shards_[0].options());
+    alloc_done_ = true;
+    cv_.notify_all();
+  } else {
+    cv_.wait(lock, [this]() { return alloc_done_; });
+  }
+  lock.unlock();
+  int64_t dim = at::maybe_wrap_dim(cat_dim_, concat_out_.dim());
+  concat_out_.narrow(dim, offsets_[shard_id], shards_[shard_id].size(dim))
+      .copy_(shards_[shard_id]);
+  if (copies_done_.fetch_add(1) + 1 == num_shards_) {
+    publish_result(concat_out_);
+  }
+}
+
+void ShardReducer::publish_result(at::Tensor result) {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    result_ = std::move(result);
+    done_ = true;
+  }
+  cv_.notify_all();
+}
+
+at::Tensor ShardReducer::wait_and_get() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [this]() { return done_; });
+  return result_;
+}
+
+void ShardReducer::reset() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  for (auto& node : tree_nodes_) {
+    node.parked.reset();
+  }
+  for (auto& shard : shards_) {
+    shard.reset();
+  }
+  std::fill(offsets_.begin(), offsets_.end(), 0);
+  arrived_ = 0;
+  alloc_done_ = false;
+  concat_out_.reset();
+  copies_done_ = 0;
+  done_ = false;
+  result_.reset();
+}
+
+size_t ShardReducer::get_num_shards() const {
+  return num_shards_;
+}
+
+} // namespace runtime
+} // namespace torch_ipex
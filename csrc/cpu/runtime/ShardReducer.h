@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include <ATen/ATen.h>
+#include <Macros.h>
+
+namespace torch_ipex {
+namespace runtime {
+
+// ShardReducer merges the per-stream outputs of a MultiStreamModule /
+// TaskExecutor ensemble without funneling every byte through one thread.
+// Each worker calls submit() with its shard index and tensor from its
+// own pool; the combining work is done by the submitting workers
+// themselves, so it runs on threads that are already pinned to the
+// shard's NUMA node:
+//
+//  * kSum uses a binary combining tree: of each pair of shards, the
+//    later arriver accumulates the parked partner into its own
+//    NUMA-local buffer and climbs to the next level, so an 8-stream
+//    merge does 3 parallel rounds of adds instead of 7 serial ones.
+//  * kConcat is two-phase: the last arriver sizes and allocates the
+//    output once, then every worker copies its own slice in parallel.
+//
+// The orchestrator calls wait_and_get() to block for the merged result
+// and reset() to reuse the reducer for the next iteration. Submitted
+// shards are consumed: kSum accumulates in place into submitted
+// buffers, so callers must not reuse them afterwards.
+class IPEX_API ShardReducer {
+ public:
+  enum class ReduceOp { kSum, kConcat };
+
+  ShardReducer(size_t num_shards, ReduceOp op, int64_t cat_dim = 0);
+
+  // Deposit one shard and take part in the merge. Each shard_id in
+  // [0, num_shards) must be submitted exactly once per iteration.
+  // Thread-safe; blocks at most for the phase barrier of kConcat.
+  void submit(size_t shard_id, const at::Tensor& shard);
+
+  // Block until every shard has been submitted and merged.
+  at::Tensor wait_and_get();
+
+  // Make the reducer ready for the next iteration. Must not race with
+  // in-flight submit() calls.
+  void reset();
+
+  size_t get_num_shards() const;
+
+ private:
+  void submit_sum(size_t shard_id, const at::Tensor& shard);
+  void submit_concat(size_t shard_id, const at::Tensor& shard);
+  void publish_result(at::Tensor result);
+
+  // One combining-tree node per shard pair and level. expected_arrivals
+  // is precomputed from the (power-of-two padded) leaf layout: 2 means
+  // park-then-combine, 1 means pass the carry straight up, 0 marks a
+  // node no real shard ever visits.
+  struct TreeNode {
+    std::mutex mutex;
+    at::Tensor parked;
+    int expected_arrivals{0};
+  };
+
+  size_t num_shards_;
+  ReduceOp op_;
+  int64_t cat_dim_;
+
+  // kSum state
+  size_t num_levels_{0};
+  std::vector<size_t> level_base_;
+  std::vector<TreeNode> tree_nodes_;
+
+  // kConcat state
+  std::vector<at::Tensor> shards_;
+  std::vector<int64_t> offsets_;
+  size_t arrived_{0};
+  bool alloc_done_{false};
+  at::Tensor concat_out_;
+  std::atomic<size_t> copies_done_{0};
+
+  // result hand-off
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool done_{false};
+  at::Tensor result_;
+
+  ShardReducer() = delete;
+  ShardReducer(const ShardReducer&) = delete;
+  ShardReducer& operator=(const ShardReducer&) = delete;
+};
+
+} // namespace runtime
+} // namespace torch_ipex
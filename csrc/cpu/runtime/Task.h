@@ -21,7 +21,10 @@ namespace runtime {
 template <class F, class... Args>
 class IPEX_API Task {
  public:
-  explicit Task(F&& f, std::shared_ptr<TaskExecutor> task_executor);
+  explicit Task(
+      F&& f,
+      std::shared_ptr<TaskExecutor> task_executor,
+      TaskPriority priority = TaskPriority::kNormal);
   Task(const Task& task) = delete;
   Task(Task&& task) = delete;
   Task& operator=(const Task& task) = delete;
@@ -33,12 +36,17 @@ class IPEX_API Task {
  private:
   F f;
   std::shared_ptr<TaskExecutor> task_executor;
+  TaskPriority priority;
 };
 
 template <class F, class... Args>
-Task<F, Args...>::Task(F&& f, std::shared_ptr<TaskExecutor> task_executor) {
+Task<F, Args...>::Task(
+    F&& f,
+    std::shared_ptr<TaskExecutor> task_executor,
+    TaskPriority priority) {
   this->f = f;
   this->task_executor = task_executor;
+  this->priority = priority;
 }
 
 template <class F, class... Args>
@@ -54,21 +62,15 @@ auto Task<F, Args...>::operator()(Args&&... args)
       });
   std::future<return_type> res = task->get_future();
   auto grad_mode = at::GradMode::is_enabled();
-  {
-    std::unique_lock<std::mutex> lock(this->task_executor->get_mutex());
-    // submit task to a stopping the pool is not allowed
-    if (this->task_executor->is_stop())
-      throw std::runtime_error("Task submit on stopped ThreadPool");
-    this->task_executor->get_tasks().emplace([task, grad_mode]() {
-      // set the thread local status, such as the grad mode before execuating
-      // the status
-      at::GradMode::set_enabled(grad_mode);
-      // execuate the task
-      (*task)();
-    });
-  }
-
-  this->task_executor->get_condition().notify_one();
+  this->task_executor->submit(
+      [task, grad_mode]() {
+        // set the thread local status, such as the grad mode before execuating
+        // the status
+        at::GradMode::set_enabled(grad_mode);
+        // execuate the task
+        (*task)();
+      },
+      this->priority);
   return res;
 }
 
@@ -1,9 +1,19 @@
 #include "TaskExecutor.h"
+#include "utils/hot_trace.h"
 
 namespace torch_ipex {
 namespace runtime {
 
-TaskExecutor::TaskExecutor(const torch_ipex::runtime::CPUPool& cpu_pool) {
+namespace {
+// Executor the current thread is a worker of, for preemption_point().
+thread_local TaskExecutor* current_worker_executor = nullptr;
+// Guards against re-entrant preemption while already servicing one.
+thread_local bool in_preemption = false;
+} // namespace
+
+TaskExecutor::TaskExecutor(
+    const torch_ipex::runtime::CPUPool& cpu_pool,
+    size_t num_workers) {
   // Notice: We shouldn't load iomp symbol in sub_thread, otherwise race
   // condition happens.
   if (!is_runtime_ext_enabled()) {
@@ -13,40 +23,179 @@ TaskExecutor::TaskExecutor(const torch_ipex::runtime::CPUPool& cpu_pool) {
   }
   this->stop = false;
 
-  this->worker = std::make_shared<std::thread>([&, this] {
-    _pin_cpu_cores(cpu_pool);
-    while (true) {
-      std::function<void()> task;
-      {
-        std::unique_lock<std::mutex> lock(this->worker_mutex);
-        this->worker_condition.wait(
-            lock, [this] { return this->stop || !this->tasks.empty(); });
+  // By default spawn one worker per core of the pool (capped to the pool
+  // size) so independent tasks can run concurrently. num_workers == 0
+  // means "derive from the pool"; an explicit value overrides it.
+  if (num_workers == 0) {
+    if (cpu_pool.is_cpu_core_list_initialized()) {
+      num_workers = cpu_pool.get_cpu_core_list().size();
+    } else {
+      num_workers = 1;
+    }
+  }
 
-        if (this->stop && this->tasks.empty())
-          return;
+  this->worker_queues.reserve(num_workers);
+  for (size_t worker_id = 0; worker_id < num_workers; ++worker_id) {
+    this->worker_queues.emplace_back(std::make_unique<WorkerQueue>());
+  }
+  this->workers.reserve(num_workers);
+  for (size_t worker_id = 0; worker_id < num_workers; ++worker_id) {
+    this->workers.emplace_back(std::make_shared<std::thread>(
+        [&cpu_pool, worker_id, this] { this->worker_main(cpu_pool, worker_id); }));
+  }
+}
 
-        task = std::move(this->tasks.front());
-        this->tasks.pop();
-      }
-      task();
+void TaskExecutor::submit(
+    std::function<void()>&& task,
+    TaskPriority priority) {
+  IPEX_HOT_TRACE_SCOPE("runtime::TaskExecutor::submit");
+  // submit task to a stopping the pool is not allowed
+  if (this->stop.load(std::memory_order_acquire)) {
+    throw std::runtime_error("Task submit on stopped ThreadPool");
+  }
+  if (priority == TaskPriority::kHigh) {
+    // Front-of-line queue: every worker drains it before its own work,
+    // and bulk tasks polling preemption_point() service it mid-kernel.
+    {
+      std::unique_lock<std::mutex> high_lock(this->high_mutex);
+      this->high_tasks.emplace_back(std::move(task));
+    }
+    this->high_pending_count.fetch_add(1, std::memory_order_release);
+    this->pending_task_count.fetch_add(1, std::memory_order_release);
+    if (this->idle_worker_count.load(std::memory_order_acquire) != 0) {
+      std::unique_lock<std::mutex> lock(this->worker_mutex);
+      this->worker_condition.notify_one();
     }
-  });
+    return;
+  }
+  // Round-robin distribution keeps the producers spread across the
+  // per-worker queues; imbalance is fixed up by stealing.
+  size_t queue_id = this->submit_index.fetch_add(1, std::memory_order_relaxed) %
+      this->worker_queues.size();
+  // Fast path: lock-free hand-off through the worker's ring. Only when
+  // the ring is full do we fall back to the mutex-guarded deque.
+  if (!this->worker_queues[queue_id]->ring.try_push(std::move(task))) {
+    std::unique_lock<std::mutex> queue_lock(
+        this->worker_queues[queue_id]->mutex);
+    this->worker_queues[queue_id]->tasks.emplace_back(std::move(task));
+  }
+  this->pending_task_count.fetch_add(1, std::memory_order_release);
+  // Wake a worker only when one is actually sleeping; in steady state
+  // the workers spin through pop_task and this branch is never taken.
+  if (this->idle_worker_count.load(std::memory_order_acquire) != 0) {
+    std::unique_lock<std::mutex> lock(this->worker_mutex);
+    this->worker_condition.notify_one();
+  }
+}
+
+bool TaskExecutor::try_run_one_high_priority() {
+  if (this->high_pending_count.load(std::memory_order_relaxed) == 0) {
+    return false;
+  }
+  std::function<void()> task;
+  {
+    std::unique_lock<std::mutex> high_lock(this->high_mutex);
+    if (this->high_tasks.empty()) {
+      return false;
+    }
+    task = std::move(this->high_tasks.front());
+    this->high_tasks.pop_front();
+  }
+  this->high_pending_count.fetch_sub(1, std::memory_order_release);
+  this->pending_task_count.fetch_sub(1, std::memory_order_release);
+  {
+    IPEX_HOT_TRACE_SCOPE("runtime::TaskExecutor::high_priority_task");
+    task();
+  }
+  return true;
 }
 
-std::mutex& TaskExecutor::get_mutex() {
-  return this->worker_mutex;
+std::function<void()> TaskExecutor::pop_task(size_t worker_id) {
+  std::function<void()> ring_task;
+  // Priority path: the shared front-of-line queue beats everything,
+  // including the worker's own backlog. The empty check is one relaxed
+  // load, so kNormal-only workloads do not touch the mutex.
+  if (this->high_pending_count.load(std::memory_order_relaxed) != 0) {
+    std::unique_lock<std::mutex> high_lock(this->high_mutex);
+    if (!this->high_tasks.empty()) {
+      auto task = std::move(this->high_tasks.front());
+      this->high_tasks.pop_front();
+      this->high_pending_count.fetch_sub(1, std::memory_order_release);
+      return task;
+    }
+  }
+  // Fast path: drain the worker's own ring first.
+  if (this->worker_queues[worker_id]->ring.try_pop(ring_task)) {
+    return ring_task;
+  }
+  // Overflow path: pop the youngest task from the worker's own deque.
+  {
+    std::unique_lock<std::mutex> queue_lock(
+        this->worker_queues[worker_id]->mutex);
+    if (!this->worker_queues[worker_id]->tasks.empty()) {
+      auto task = std::move(this->worker_queues[worker_id]->tasks.back());
+      this->worker_queues[worker_id]->tasks.pop_back();
+      return task;
+    }
+  }
+  // Steal path: take the oldest task from any other worker. The ring
+  // pop is CAS based, so a stealing consumer is safe there as well.
+  for (size_t i = 1; i < this->worker_queues.size(); ++i) {
+    size_t victim_id = (worker_id + i) % this->worker_queues.size();
+    if (this->worker_queues[victim_id]->ring.try_pop(ring_task)) {
+      return ring_task;
+    }
+    std::unique_lock<std::mutex> queue_lock(
+        this->worker_queues[victim_id]->mutex);
+    if (!this->worker_queues[victim_id]->tasks.empty()) {
+      auto task = std::move(this->worker_queues[victim_id]->tasks.front());
+      this->worker_queues[victim_id]->tasks.pop_front();
+      return task;
+    }
+  }
+  return nullptr;
 }
 
-std::condition_variable& TaskExecutor::get_condition() {
-  return this->worker_condition;
+void TaskExecutor::worker_main(
+    const torch_ipex::runtime::CPUPool& cpu_pool,
+    size_t worker_id) {
+  _pin_cpu_cores(cpu_pool);
+  // Keep task-scope allocations on the DRAM of the pool's node.
+  _bind_numa_memory_node(cpu_pool);
+  current_worker_executor = this;
+  while (true) {
+    std::function<void()> task = this->pop_task(worker_id);
+    if (task == nullptr) {
+      this->idle_worker_count.fetch_add(1, std::memory_order_release);
+      {
+        std::unique_lock<std::mutex> lock(this->worker_mutex);
+        this->worker_condition.wait(lock, [this] {
+          return this->stop.load(std::memory_order_acquire) ||
+              this->pending_task_count.load(std::memory_order_acquire) != 0;
+        });
+      }
+      this->idle_worker_count.fetch_sub(1, std::memory_order_release);
+      // Drain the remaining tasks before exiting on stop.
+      if (this->stop.load(std::memory_order_acquire) &&
+          this->pending_task_count.load(std::memory_order_acquire) == 0) {
+        return;
+      }
+      continue;
+    }
+    this->pending_task_count.fetch_sub(1, std::memory_order_release);
+    {
+      IPEX_HOT_TRACE_SCOPE("runtime::TaskExecutor::task");
+      task();
+    }
+  }
 }
 
 bool TaskExecutor::is_stop() {
   return this->stop;
 }
 
-std::queue<std::function<void()>>& TaskExecutor::get_tasks() {
-  return this->tasks;
+size_t TaskExecutor::get_num_workers() const {
+  return this->workers.size();
 }
 
 void TaskExecutor::stop_executor() {
@@ -60,7 +209,9 @@ void TaskExecutor::stop_executor() {
   }
   if (should_wait_worker_join) {
     this->worker_condition.notify_all();
-    this->worker->join();
+    for (auto& worker : this->workers) {
+      worker->join();
+    }
   }
   return;
 }
@@ -69,5 +220,18 @@ TaskExecutor::~TaskExecutor() {
   this->stop_executor();
 }
 
+void preemption_point() {
+  TaskExecutor* executor = current_worker_executor;
+  if (executor == nullptr || in_preemption) {
+    return;
+  }
+  if (executor->is_stop()) {
+    return;
+  }
+  in_preemption = true;
+  executor->try_run_one_high_priority();
+  in_preemption = false;
+}
+
 } // namespace runtime
 } // namespace torch_ipex
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <omp.h>
+#include <atomic>
 #include <cassert>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <future>
 #include <iostream>
@@ -18,26 +20,73 @@
 #include <torch/csrc/autograd/profiler.h>
 #include <torch/csrc/jit/api/module.h>
 #include "CPUPool.h"
+#include "TaskRing.h"
 
 namespace torch_ipex {
 namespace runtime {
 
+// Priority class of a submitted task. kHigh tasks (latency-critical
+// decode requests) overtake all queued kNormal work: workers drain the
+// high-priority queue before touching their own rings, and long-running
+// kNormal tasks can additionally poll preemption_point() so a high
+// priority arrival does not have to wait for a bulk kernel to finish.
+enum class TaskPriority { kNormal = 0, kHigh = 1 };
+
 class IPEX_API TaskExecutor {
  public:
-  explicit TaskExecutor(const torch_ipex::runtime::CPUPool& cpu_pool);
-  std::mutex& get_mutex();
-  std::condition_variable& get_condition();
+  explicit TaskExecutor(
+      const torch_ipex::runtime::CPUPool& cpu_pool,
+      size_t num_workers = 0);
+  // Submit a task for asynchronous execution. kNormal tasks are
+  // distributed round-robin onto the per-worker deques; idle workers
+  // steal from the other workers so independent submissions scale across
+  // the pool instead of serializing on one dispatcher thread. kHigh
+  // tasks go to a shared front-of-line queue every worker checks first.
+  void submit(
+      std::function<void()>&& task,
+      TaskPriority priority = TaskPriority::kNormal);
+  // Runs one queued high-priority task inline on the calling thread if
+  // any is pending. Returns whether a task was run. The check is a
+  // single relaxed atomic load when the queue is empty.
+  bool try_run_one_high_priority();
   bool is_stop();
-  std::queue<std::function<void()>>& get_tasks();
+  size_t get_num_workers() const;
   void stop_executor();
   ~TaskExecutor();
 
  private:
-  std::queue<std::function<void()>> tasks;
-  std::shared_ptr<std::thread> worker;
+  // Each worker owns a lock-free ring, used as the submission fast
+  // path, plus a deque guarded by its own mutex as the overflow path
+  // when the ring is full. The owner pops its deque from the back
+  // (LIFO, cache friendly); thieves steal from the front (FIFO, oldest
+  // task first).
+  struct WorkerQueue {
+    WorkerQueue() : ring(kTaskRingCapacity) {}
+    TaskRing<std::function<void()>> ring;
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  static constexpr size_t kTaskRingCapacity = 1024;
+
+  std::function<void()> pop_task(size_t worker_id);
+  void worker_main(const torch_ipex::runtime::CPUPool& cpu_pool, size_t worker_id);
 
-  // Synchronization
-  bool stop;
+  std::vector<std::unique_ptr<WorkerQueue>> worker_queues;
+  // Front-of-line queue shared by all workers; kHigh traffic is sparse
+  // and latency-bound, so one mutex-guarded FIFO beats distributing it.
+  std::mutex high_mutex;
+  std::deque<std::function<void()>> high_tasks;
+  std::atomic<size_t> high_pending_count{0};
+  std::vector<std::shared_ptr<std::thread>> workers;
+  std::atomic<size_t> submit_index{0};
+  std::atomic<size_t> pending_task_count{0};
+  std::atomic<size_t> idle_worker_count{0};
+
+  // Synchronization for idle workers (slow path only). The submission
+  // fast path never touches worker_mutex; it only grabs it to notify
+  // when idle_worker_count says somebody is actually sleeping.
+  std::atomic<bool> stop;
   std::mutex worker_mutex;
   std::condition_variable worker_condition;
 
@@ -52,5 +101,15 @@ class IPEX_API TaskExecutor {
       delete; // Not support copy or move construtor.
 };
 
+// Cooperative preemption point for long-running work executing on a
+// TaskExecutor worker. If a high-priority task is queued on the worker's
+// executor, it runs inline on the calling thread before this returns.
+// Fused kernels with bulk outer loops (scoring, prefill) should call it
+// between row blocks; the no-pending fast path is one relaxed atomic
+// load, so polling every few hundred microseconds of work is free.
+// Outside executor workers (or while already servicing a preemption)
+// this is a no-op.
+IPEX_API void preemption_point();
+
 } // namespace runtime
 } // namespace torch_ipex
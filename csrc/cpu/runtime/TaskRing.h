@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace torch_ipex {
+namespace runtime {
+
+// Bounded lock-free ring used for the task submission fast path
+// (Dmitry Vyukov's bounded queue). Producers claim a slot with a single
+// CAS on enqueue_pos; the consumer advances dequeue_pos the same way,
+// so occasional stealing consumers are also safe. Each slot carries a
+// sequence number which tells both sides whether the slot is ready.
+template <typename T>
+class TaskRing {
+ public:
+  explicit TaskRing(size_t capacity) : capacity_mask_(capacity - 1) {
+    // Capacity has to be a power of two so the index math can mask
+    // instead of taking a modulo.
+    assert(capacity >= 2 && (capacity & (capacity - 1)) == 0);
+    slots_ = std::make_unique<Slot[]>(capacity);
+    for (size_t i = 0; i < capacity; ++i) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    enqueue_pos_.store(0, std::memory_order_relaxed);
+    dequeue_pos_.store(0, std::memory_order_relaxed);
+  }
+
+  // Returns false when the ring is full; the caller falls back to the
+  // locked queue in that case.
+  bool try_push(T&& value) {
+    Slot* slot;
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+      slot = &slots_[pos & capacity_mask_];
+      size_t sequence = slot->sequence.load(std::memory_order_acquire);
+      intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(
+                pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    slot->value = std::move(value);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool try_pop(T& value) {
+    Slot* slot;
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+      slot = &slots_[pos & capacity_mask_];
+      size_t sequence = slot->sequence.load(std::memory_order_acquire);
+      intptr_t diff = (intptr_t)sequence - (intptr_t)(pos + 1);
+      if (diff == 0) {
+        if (dequeue_pos_.compare_exchange_weak(
+                pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    value = std::move(slot->value);
+    slot->sequence.store(pos + capacity_mask_ + 1, std::memory_order_release);
+    return true;
+  }
+
+ private:
+  struct Slot {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  static constexpr size_t cacheline_size = 64;
+
+  std::unique_ptr<Slot[]> slots_;
+  size_t capacity_mask_;
+  alignas(cacheline_size) std::atomic<size_t> enqueue_pos_;
+  alignas(cacheline_size) std::atomic<size_t> dequeue_pos_;
+
+  TaskRing(const TaskRing&) = delete;
+  TaskRing& operator=(const TaskRing&) = delete;
+};
+
+} // namespace runtime
+} // namespace torch_ipex
@@ -0,0 +1,145 @@
+#include "WeightPrefetcher.h"
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace torch_ipex {
+namespace runtime {
+
+WeightPrefetcher::WeightPrefetcher() {
+  this->prefetcher =
+      std::make_shared<std::thread>([this] { this->prefetcher_main(); });
+}
+
+WeightPrefetcher::~WeightPrefetcher() {
+  {
+    std::unique_lock<std::mutex> lock(this->pending_mutex);
+    this->stop = true;
+  }
+  this->pending_condition.notify_all();
+  this->prefetcher->join();
+}
+
+void WeightPrefetcher::register_layer(const std::vector<at::Tensor>& weights) {
+  std::vector<at::Tensor> layer;
+  layer.reserve(weights.size());
+  for (auto& weight : weights) {
+    TORCH_CHECK(
+        weight.device().is_cpu(),
+        "WeightPrefetcher only handles CPU tensors, got ",
+        weight.device());
+    layer.emplace_back(weight);
+  }
+  std::unique_lock<std::mutex> lock(this->layers_mutex);
+  this->layers.emplace_back(std::move(layer));
+}
+
+void WeightPrefetcher::clear_layers() {
+  {
+    std::unique_lock<std::mutex> pending_lock(this->pending_mutex);
+    this->requested_layer = -1;
+  }
+  std::unique_lock<std::mutex> lock(this->layers_mutex);
+  this->layers.clear();
+  this->bytes_streamed.store(0, std::memory_order_relaxed);
+}
+
+size_t WeightPrefetcher::num_layers() const {
+  std::unique_lock<std::mutex> lock(this->layers_mutex);
+  return this->layers.size();
+}
+
+void WeightPrefetcher::advance(size_t layer_idx) {
+  size_t layer_count = this->num_layers();
+  if (layer_count == 0) {
+    return;
+  }
+  {
+    std::unique_lock<std::mutex> lock(this->pending_mutex);
+    // Only the freshest request matters: if the compute loop outran the
+    // prefetch thread, warming a stale layer would just waste near-tier
+    // capacity.
+    this->requested_layer = static_cast<int64_t>((layer_idx + 1) % layer_count);
+  }
+  this->pending_condition.notify_one();
+}
+
+uint64_t WeightPrefetcher::prefetched_bytes() const {
+  return this->bytes_streamed.load(std::memory_order_relaxed);
+}
+
+void WeightPrefetcher::prefetcher_main() {
+  while (true) {
+    int64_t layer_idx = -1;
+    {
+      std::unique_lock<std::mutex> lock(this->pending_mutex);
+      this->pending_condition.wait(lock, [this] {
+        return this->stop || this->requested_layer >= 0;
+      });
+      if (this->stop) {
+        break;
+      }
+      layer_idx = this->requested_layer;
+      this->requested_layer = -1;
+    }
+    this->warm_layer(static_cast<size_t>(layer_idx));
+  }
+}
+
+void WeightPrefetcher::warm_layer(size_t layer_idx) {
+  // Copy the tensor handles out so the layers lock is not held across
+  // the (potentially long) streaming reads.
+  std::vector<at::Tensor> layer;
+  {
+    std::unique_lock<std::mutex> lock(this->layers_mutex);
+    if (layer_idx >= this->layers.size()) {
+      return;
+    }
+    layer = this->layers[layer_idx];
+  }
+
+#ifndef _WIN32
+  static const size_t page_size = sysconf(_SC_PAGESIZE);
+#endif
+  for (auto& weight : layer) {
+    auto* data = static_cast<const char*>(weight.data_ptr());
+    size_t nbytes = weight.nbytes();
+    if (data == nullptr || nbytes == 0) {
+      continue;
+    }
+
+#ifndef _WIN32
+    // Hint the tiering/paging layer first so promotion can start ahead
+    // of the reads. Windows has no madvise; the streaming reads below
+    // still do the actual warming there.
+    auto base = reinterpret_cast<uintptr_t>(data);
+    auto aligned = base & ~(static_cast<uintptr_t>(page_size) - 1);
+    madvise(
+        reinterpret_cast<void*>(aligned), nbytes + (base - aligned),
+        MADV_WILLNEED);
+#endif
+
+    // madvise is only a hint; a streaming read per cache line actually
+    // pulls the pages into the near tier (and the shared LLC), which is
+    // what unstalls the GEMM on boxes without hardware tiering. The
+    // volatile loads keep the loop from being optimized away.
+    uint64_t sink = 0;
+    for (size_t offset = 0; offset < nbytes; offset += 64) {
+      sink += static_cast<uint64_t>(
+          *static_cast<const volatile char*>(data + offset));
+    }
+    (void)sink;
+
+    this->bytes_streamed.fetch_add(nbytes, std::memory_order_relaxed);
+  }
+}
+
+WeightPrefetcher& get_weight_prefetcher() {
+  static WeightPrefetcher instance;
+  return instance;
+}
+
+} // namespace runtime
+} // namespace torch_ipex
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <ATen/ATen.h>
+#include <Macros.h>
+
+namespace torch_ipex {
+namespace runtime {
+
+// WeightPrefetcher warms the packed weights of the next layer while the
+// current one computes. On memory-tiered boxes (CXL-attached DRAM, or
+// weights demoted by the kernel's tiering daemon) cold weight tiles
+// stall the decode GEMMs; a single host thread that walks the layer
+// order one step ahead and issues madvise(MADV_WILLNEED) plus a
+// streaming read keeps the GEMM input set resident in the near tier.
+//
+// Layers are registered once, in execution order, as the set of weight
+// tensors each layer reads. The compute loop then calls advance(n) when
+// layer n starts; the prefetcher asynchronously touches layer n+1
+// (wrapping at the end, which matches the steady decode loop). advance
+// never blocks the caller; if the prefetch thread is still busy, only
+// the most recent request is kept.
+class IPEX_API WeightPrefetcher {
+ public:
+  WeightPrefetcher();
+  ~WeightPrefetcher();
+
+  // Append one layer's weight tensors in execution order. Tensors must
+  // live on CPU; they are held alive by the prefetcher until
+  // clear_layers().
+  void register_layer(const std::vector<at::Tensor>& weights);
+  void clear_layers();
+  size_t num_layers() const;
+
+  // Layer `layer_idx` is starting to compute: request an asynchronous
+  // warm-up of layer layer_idx + 1 (modulo the layer count).
+  void advance(size_t layer_idx);
+
+  // Total bytes streamed by the prefetch thread since construction or
+  // the last clear_layers().
+  uint64_t prefetched_bytes() const;
+
+ private:
+  void prefetcher_main();
+  void warm_layer(size_t layer_idx);
+
+  std::vector<std::vector<at::Tensor>> layers;
+  mutable std::mutex layers_mutex;
+
+  std::shared_ptr<std::thread> prefetcher;
+  int64_t requested_layer{-1};
+  bool stop{false};
+  std::mutex pending_mutex;
+  std::condition_variable pending_condition;
+  std::atomic<uint64_t> bytes_streamed{0};
+
+  // Put the deleted function in the private.
+  WeightPrefetcher(const WeightPrefetcher& weight_prefetcher) = delete;
+  WeightPrefetcher(WeightPrefetcher&& weight_prefetcher) = delete;
+  WeightPrefetcher& operator=(const WeightPrefetcher& weight_prefetcher) =
+      delete;
+  WeightPrefetcher& operator=(WeightPrefetcher&& weight_prefetcher) = delete;
+};
+
+// Process-wide instance used by the python bindings; serving processes
+// host one model, so one prefetch walker is enough.
+IPEX_API WeightPrefetcher& get_weight_prefetcher();
+
+} // namespace runtime
+} // namespace torch_ipex
@@ -1,5 +1,6 @@
 #include "sklearn.h"
 #include <ATen/Dispatch.h>
+#include <algorithm>
 #ifdef _WIN32
 #include <ppl.h>
 #define IPEX_PARALLEL_SORT concurrency::parallel_sort
@@ -22,7 +23,6 @@ std::vector<double> roc_auc_score_(
     bool only_score = true) {
   T* actual = self.data_ptr<T>();
   T* prediction = other.data_ptr<T>();
-  std::vector<T> predictedRank(size, 0.0);
   int nPos = 0, nNeg = 0;
 #pragma omp parallel for reduction(+ : nPos)
   for (int i = 0; i < size; i++)
@@ -40,30 +40,25 @@ std::vector<double> roc_auc_score_(
     return left.first < right.first;
   });
 
-  int r = 1;
-  int n = 1;
-  size_t i = 0;
-  while (i < size) {
-    size_t j = i;
-    while ((j < (v_sort.size() - 1)) &&
-           (v_sort[j].first == v_sort[j + 1].first)) {
-      j++;
-    }
-    n = j - i + 1;
-    for (size_t j = 0; j < n; ++j) {
-      int idx = v_sort[i + j].second;
-      predictedRank[idx] = r + ((n - 1) * 0.5);
-    }
-    r += n;
-    i += n;
-  }
-
+  // Accumulate the rank sum of the positive samples directly from the
+  // sorted order instead of materializing a per-sample rank array and
+  // re-reading it. Runs of tied predictions share the averaged rank
+  // (i+1 .. j averaged to (i+j+1)/2); only the first element of a run
+  // processes it, so every run is counted exactly once no matter how the
+  // iterations are split across threads.
   double filteredRankSum = 0;
 #pragma omp parallel for reduction(+ : filteredRankSum)
-  for (size_t i = 0; i < size; ++i) {
-    if (actual[i] == 1) {
-      filteredRankSum += predictedRank[i];
+  for (long i = 0; i < size; ++i) {
+    if (i > 0 && v_sort[i].first == v_sort[i - 1].first)
+      continue;
+    long j = i;
+    long posInRun = 0;
+    while (j < size && v_sort[j].first == v_sort[i].first) {
+      if (actual[v_sort[j].second] == 1)
+        posInRun++;
+      j++;
     }
+    filteredRankSum += (double)(i + j + 1) * 0.5 * posInRun;
   }
   double score = (filteredRankSum - ((double)nPos * ((nPos + 1.0) / 2.0))) /
       ((double)nPos * nNeg);
@@ -87,6 +82,61 @@ std::vector<double> roc_auc_score_(
   return {score, log_loss, accuracy};
 }
 
+// Approximate AUC by bucketing predictions into a fixed histogram instead
+// of sorting: O(n) over the data with per-thread histograms, so huge eval
+// tensors do not pay the sort at all. The result is exact for predictions
+// quantized to the bin resolution; tied values inside a bin use the same
+// trapezoidal (averaged-rank) correction as the exact path.
+template <typename T>
+double roc_auc_score_bucketed_(
+    at::Tensor self,
+    at::Tensor other,
+    long size,
+    long bins) {
+  T* actual = self.data_ptr<T>();
+  T* prediction = other.data_ptr<T>();
+  T lo = prediction[0], hi = prediction[0];
+#pragma omp parallel for reduction(min : lo) reduction(max : hi)
+  for (long i = 0; i < size; i++) {
+    lo = std::min(lo, prediction[i]);
+    hi = std::max(hi, prediction[i]);
+  }
+  if (!(hi > lo))
+    return 0.5; // all predictions identical
+  const double scale = (double)bins / ((double)hi - (double)lo);
+  std::vector<double> pos(bins, 0.0), neg(bins, 0.0);
+#pragma omp parallel
+  {
+    std::vector<double> pos_local(bins, 0.0), neg_local(bins, 0.0);
+#pragma omp for nowait
+    for (long i = 0; i < size; i++) {
+      long b = std::min(
+          (long)(((double)prediction[i] - (double)lo) * scale), bins - 1);
+      if (actual[i] == 1)
+        pos_local[b] += 1.0;
+      else
+        neg_local[b] += 1.0;
+    }
+#pragma omp critical
+    {
+      for (long b = 0; b < bins; b++) {
+        pos[b] += pos_local[b];
+        neg[b] += neg_local[b];
+      }
+    }
+  }
+  double nPos = 0, nNeg = 0, negBelow = 0, weightedPairs = 0;
+  for (long b = 0; b < bins; b++) {
+    weightedPairs += pos[b] * (negBelow + 0.5 * neg[b]);
+    negBelow += neg[b];
+    nPos += pos[b];
+    nNeg += neg[b];
+  }
+  if (nPos == 0 || nNeg == 0)
+    return 0.5;
+  return weightedPairs / (nPos * nNeg);
+}
+
 std::vector<double> roc_auc_score(at::Tensor self, at::Tensor other) {
   TORCH_INTERNAL_ASSERT_DEBUG_ONLY(self.dim() == 1);
   TORCH_INTERNAL_ASSERT_DEBUG_ONLY(other.dim() == 1);
@@ -98,6 +148,20 @@ std::vector<double> roc_auc_score(at::Tensor self, at::Tensor other) {
   });
 }
 
+double roc_auc_score_approx(at::Tensor self, at::Tensor other, int64_t bins) {
+  TORCH_INTERNAL_ASSERT_DEBUG_ONLY(self.dim() == 1);
+  TORCH_INTERNAL_ASSERT_DEBUG_ONLY(other.dim() == 1);
+  TORCH_INTERNAL_ASSERT_DEBUG_ONLY(self.dtype() == other.dtype());
+  TORCH_INTERNAL_ASSERT_DEBUG_ONLY(self.numel() == other.numel());
+  TORCH_CHECK(bins > 0, "roc_auc_score_approx: bins should be positive");
+
+  return AT_DISPATCH_FLOATING_TYPES(
+      self.scalar_type(), "roc_auc_score_approx", [&]() {
+        return roc_auc_score_bucketed_<scalar_t>(
+            self, other, self.numel(), bins);
+      });
+}
+
 std::vector<double> roc_auc_score_all(at::Tensor self, at::Tensor other) {
   TORCH_INTERNAL_ASSERT_DEBUG_ONLY(self.dim() == 1);
   TORCH_INTERNAL_ASSERT_DEBUG_ONLY(other.dim() == 1);
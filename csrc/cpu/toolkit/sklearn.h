@@ -4,5 +4,9 @@
 
 namespace toolkit {
 std::vector<double> roc_auc_score(at::Tensor actual, at::Tensor predict);
+double roc_auc_score_approx(
+    at::Tensor actual,
+    at::Tensor predict,
+    int64_t bins);
 std::vector<double> roc_auc_score_all(at::Tensor actual, at::Tensor predict);
 } // namespace toolkit
@@ -10,6 +10,96 @@
 #endif
 namespace torch_ipex {
 namespace tpp {
+
+#ifndef _WIN32
+namespace {
+
+// Directory for the persistent kernel cache. When set, compiled shared
+// objects are kept across process restarts and loaded back with dlopen
+// (which maps them executable), so a warm start skips the compiler.
+const char* jit_cache_dir() {
+  static const char* dir = getenv("IPEX_TPP_JIT_CACHE_DIR");
+  return dir;
+}
+
+uint64_t jit_cache_hash(const std::string& s) {
+  uint64_t h = 0xcbf29ce484222325ULL;
+  for (unsigned char c : s) {
+    h = (h ^ c) * 0x100000001b3ULL;
+  }
+  return h;
+}
+
+// The cached binary is only valid for the ISA it was compiled for, so a
+// coarse ISA tag goes into the file name in case the cache directory is
+// shared between heterogeneous machines. The compile flags are part of
+// the hash and cover the rest.
+const char* jit_cache_isa_tag() {
+#if defined(__x86_64__)
+  if (__builtin_cpu_supports("avx512f"))
+    return "avx512";
+  if (__builtin_cpu_supports("avx2"))
+    return "avx2";
+#endif
+  return "base";
+}
+
+std::string jit_cache_path(const std::string& src, const std::string& flags) {
+  char name[100];
+  snprintf(
+      name,
+      sizeof(name),
+      "/tpp_%s_%016lx.so",
+      jit_cache_isa_tag(),
+      (unsigned long)jit_cache_hash(src + "\n" + flags));
+  return std::string(jit_cache_dir()) + name;
+}
+
+std::string read_file(const std::string& filename) {
+  std::string src;
+  FILE* fp = fopen(filename.c_str(), "r");
+  if (!fp)
+    return src;
+  char buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), fp)) > 0)
+    src.append(buf, n);
+  fclose(fp);
+  return src;
+}
+
+void* load_func(const std::string& libname, const std::string& func_name) {
+  auto handle = dlopen(libname.c_str(), RTLD_LAZY | RTLD_NODELETE);
+  if (!handle)
+    return NULL;
+  void* func = dlsym(handle, func_name.c_str());
+  dlclose(handle);
+  return func;
+}
+
+// Compile into the cache, going through a process-private temporary name
+// so a concurrent reader never sees a partially written library.
+bool jit_compile_to_cache(
+    const std::string& filename,
+    const std::string& flags,
+    const std::string& cache_path) {
+  auto tmp_path = cache_path + ".tmp." + std::to_string(getpid());
+  auto cmd = std::string("g++ -shared -fPIC -x c++ ") + flags;
+  cmd = cmd + " -o " + tmp_path + " " + filename;
+  printf("JIT COMPILE: %s\n", cmd.c_str());
+  int ret = system(cmd.c_str());
+  if (ret != 0)
+    return false;
+  if (rename(tmp_path.c_str(), cache_path.c_str()) != 0) {
+    remove(tmp_path.c_str());
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+#endif
+
 void* jit_compile_and_load(
     const std::string filename,
     const std::string flags) {
@@ -42,6 +132,24 @@ void* jit_from_file(
     const std::string flags,
     const std::string func_name) {
 #ifndef _WIN32
+  if (jit_cache_dir() != NULL) {
+    auto src = read_file(filename);
+    if (!src.empty()) {
+      auto cache_path = jit_cache_path(src, flags);
+      void* func = load_func(cache_path, func_name);
+      if (func != NULL)
+        return func;
+      if (jit_compile_to_cache(filename, flags, cache_path)) {
+        func = load_func(cache_path, func_name);
+        if (func != NULL)
+          return func;
+        printf(
+            "Unable to find '%s' symbol in JIT COMPILE\n", func_name.c_str());
+        return NULL;
+      }
+      // fall through to the uncached path if the cache is not writable
+    }
+  }
   void* handle = jit_compile_and_load(filename, flags);
   if (handle == NULL)
     return NULL;
@@ -75,4 +183,4 @@ void* jit_from_str(
 #endif
 }
 } // namespace tpp
-} // namespace torch_ipex
\ No newline at end of file
+} // namespace torch_ipex
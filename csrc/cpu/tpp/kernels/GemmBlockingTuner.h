@@ -0,0 +1,199 @@
+#pragma once
+
+#include <cstdio>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "tpp/utils.h"
+
+namespace torch_ipex {
+namespace tpp {
+
+// Shape-keyed autotuner for the BLOCK_M (BSb) choice of the TPP GEMM
+// kernels. The hard-coded 64 is a good default on most parts but
+// measurably wrong on others, and the best value shifts with core count
+// and cache sizes. When IPEX_TPP_BLOCKING_PROFILE is set to a file path,
+// the first calls for each (kernel, BS, C, K, type size) run a short
+// calibration over a few BLOCK_M candidates; the winner is frozen and
+// persisted to the profile file, which is reloaded on the next startup
+// so deployments converge once and then always run with their own best
+// blockings. Without the env var every kernel keeps its static default.
+//
+// The per-candidate minimum over several samples is kept, so the one-off
+// libxsmm JIT-compile cost of a fresh blocking does not distort the
+// comparison.
+class GemmBlockingTuner {
+ public:
+  GemmBlockingTuner(
+      const char* kernel,
+      long BS,
+      long C,
+      long K,
+      long type_size,
+      long default_bsb)
+      : block_m_(default_bsb) {
+    if (!enabled() || BS < kMinTunableBS) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mutex());
+    load_profile_once();
+    key_ = make_key(kernel, BS, C, K, type_size);
+    auto& entry = table()[key_];
+    if (entry.candidates.empty() && entry.frozen_bsb == 0) {
+      for (long c : {32L, 48L, 64L, 96L, 128L}) {
+        if (c <= BS) {
+          entry.candidates.push_back(c);
+        }
+      }
+      entry.best_time.assign(
+          entry.candidates.size(), std::numeric_limits<double>::infinity());
+      entry.samples.assign(entry.candidates.size(), 0);
+    }
+    if (entry.frozen_bsb > 0) {
+      block_m_ = entry.frozen_bsb;
+      return;
+    }
+    // Calibrating: pick the least-sampled candidate for this call.
+    size_t pick = 0;
+    for (size_t i = 1; i < entry.candidates.size(); i++) {
+      if (entry.samples[i] < entry.samples[pick]) {
+        pick = i;
+      }
+    }
+    block_m_ = entry.candidates[pick];
+    candidate_idx_ = (long)pick;
+    calibrating_ = true;
+  }
+
+  long block_m() const {
+    return block_m_;
+  }
+
+  void start() {
+    if (calibrating_) {
+      t_start_ = getTime();
+    }
+  }
+
+  void stop() {
+    if (!calibrating_) {
+      return;
+    }
+    double elapsed = getTime() - t_start_;
+    std::lock_guard<std::mutex> lock(mutex());
+    auto& entry = table()[key_];
+    if (entry.frozen_bsb > 0) {
+      return; // another thread froze this shape meanwhile
+    }
+    if (elapsed < entry.best_time[candidate_idx_]) {
+      entry.best_time[candidate_idx_] = elapsed;
+    }
+    entry.samples[candidate_idx_]++;
+    for (auto s : entry.samples) {
+      if (s < kSamplesPerCandidate) {
+        return;
+      }
+    }
+    // All candidates measured: freeze the fastest and persist.
+    size_t best = 0;
+    for (size_t i = 1; i < entry.candidates.size(); i++) {
+      if (entry.best_time[i] < entry.best_time[best]) {
+        best = i;
+      }
+    }
+    entry.frozen_bsb = entry.candidates[best];
+    save_profile();
+  }
+
+ private:
+  static constexpr long kMinTunableBS = 32;
+  static constexpr long kSamplesPerCandidate = 3;
+
+  struct Entry {
+    long frozen_bsb = 0;
+    std::vector<long> candidates;
+    std::vector<double> best_time;
+    std::vector<long> samples;
+  };
+
+  static const char* profile_path() {
+    static const char* path = getenv("IPEX_TPP_BLOCKING_PROFILE");
+    return path;
+  }
+
+  static bool enabled() {
+    return profile_path() != nullptr;
+  }
+
+  static std::mutex& mutex() {
+    static std::mutex m;
+    return m;
+  }
+
+  static std::unordered_map<std::string, Entry>& table() {
+    static std::unordered_map<std::string, Entry> t;
+    return t;
+  }
+
+  static std::string make_key(
+      const char* kernel,
+      long BS,
+      long C,
+      long K,
+      long type_size) {
+    char buf[256];
+    snprintf(
+        buf, sizeof(buf), "%s %ld %ld %ld %ld", kernel, BS, C, K, type_size);
+    return std::string(buf);
+  }
+
+  // Profile file format: one frozen entry per line,
+  //   <kernel> <BS> <C> <K> <type_size> <block_m>
+  // Caller holds the mutex.
+  static void load_profile_once() {
+    static bool loaded = []() {
+      FILE* f = fopen(profile_path(), "r");
+      if (!f) {
+        return true; // first run, nothing to load
+      }
+      char kernel[128];
+      long BS, C, K, ts, bsb;
+      while (fscanf(
+                 f, "%127s %ld %ld %ld %ld %ld", kernel, &BS, &C, &K, &ts, &bsb) == 6) {
+        if (bsb > 0) {
+          table()[make_key(kernel, BS, C, K, ts)].frozen_bsb = bsb;
+        }
+      }
+      fclose(f);
+      return true;
+    }();
+    (void)loaded;
+  }
+
+  // Rewrites the whole profile from the frozen entries. Caller holds the
+  // mutex; freezes are rare (a handful per deployment lifetime), so the
+  // rewrite cost is irrelevant.
+  static void save_profile() {
+    FILE* f = fopen(profile_path(), "w");
+    if (!f) {
+      return; // profile is an optimization; never fail the op over it
+    }
+    for (auto& kv : table()) {
+      if (kv.second.frozen_bsb > 0) {
+        fprintf(f, "%s %ld\n", kv.first.c_str(), kv.second.frozen_bsb);
+      }
+    }
+    fclose(f);
+  }
+
+  long block_m_ = 0;
+  long candidate_idx_ = -1;
+  bool calibrating_ = false;
+  double t_start_ = 0.0;
+  std::string key_;
+};
+
+} // namespace tpp
+} // namespace torch_ipex
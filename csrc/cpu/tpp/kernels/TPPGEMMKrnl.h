@@ -10,6 +10,7 @@
 #include "tpp/threaded_loops.h"
 #endif
 #include <cstdint>
+#include "tpp/kernels/GemmBlockingTuner.h"
 #include "tpp/tensor_helper.h"
 #include "tpp/xsmm_functors.h"
 
@@ -44,9 +45,18 @@ REGISTER_LOCAL_SCOPE(
 REGISTER_LOCAL_SCOPE(
     tpp_fused_gate_up_proj_krnl,
     "tpp_fused_gate_up_proj_krnl"); // fused gate_proj and up_proj
+REGISTER_LOCAL_SCOPE(
+    tpp_fused_qkv_krnl,
+    "tpp_fused_qkv_krnl"); // fused Q/K/V projections
+REGISTER_LOCAL_SCOPE(
+    tpp_fused_gated_mlp_krnl,
+    "tpp_fused_gated_mlp_krnl"); // fused gate/up/SiLU-mul/down
 REGISTER_LOCAL_SCOPE(
     tpp_linear_relu_krnl,
     "tpp_linear_relu_krnl"); // linear bias + relu
+REGISTER_LOCAL_SCOPE(
+    tpp_linear_argmax_krnl,
+    "tpp_linear_argmax_krnl"); // linear bias + greedy argmax
 
 REGISTER_LOCAL_SCOPE(fftkn, "fftkn");
 
@@ -124,8 +134,10 @@ inline void tpp_linear_bias(
   auto out = GetVLAPtr<T>(t_out, {Nk, Hk});
 
   auto Ncb = Nc;
-  auto BSb = 64L;
-  auto rem = BS % 64;
+  GemmBlockingTuner tuner(
+      "tpp_linear_krnl", BS, C, K, (long)sizeof(T), 64L);
+  auto BSb = tuner.block_m();
+  auto rem = BS % BSb;
   if (large_cache_opt)
     Ncb = NCB_BLOCK_SIZE;
 
@@ -139,6 +151,7 @@ inline void tpp_linear_bias(
   auto brgemm_tpp_rem = SCOPEITGEMM(
       (BrgemmTPP<T, T>(rem, Hk, Hc, Hc, Hk * Hc, C, Hk, K, 1.0, 0, Ncb)));
 
+  tuner.start();
   {
     RECORD_SCOPE(tpp_linear_krnl, {t_in, t_wt_V});
     auto loop_scheme = large_cache_opt ? GEMM_LOOP_SCHEME : "aCb";
@@ -173,6 +186,7 @@ inline void tpp_linear_bias(
         [&]() { brgemm_tpp.config(); },
         [&]() { brgemm_tpp.release(); });
   }
+  tuner.stop();
 }
 
 template <typename T, typename Tout = T>
@@ -207,7 +221,9 @@ inline void tpp_linear_no_bias(
   auto out = GetVLAPtr<Tout>(t_out, {Nk, Hk});
 
   auto Ncb = Nc;
-  auto BSb = 64L;
+  GemmBlockingTuner tuner(
+      "tpp_linear_krnl", BS, C, K, (long)sizeof(T), 64L);
+  auto BSb = tuner.block_m();
   auto rem = BS % BSb;
   if (large_cache_opt)
     Ncb = NCB_BLOCK_SIZE;
@@ -219,6 +235,7 @@ inline void tpp_linear_no_bias(
   auto brgemm_tpp_rem = SCOPEITGEMM(
       (BrgemmTPP<T, Tout>(rem, Hk, Hc, Hc, Hk * Hc, C, Hk, K, 1.0, 0, Ncb)));
 
+  tuner.start();
   {
     RECORD_SCOPE(tpp_linear_krnl, {t_in, t_wt_V});
     auto loop_scheme = large_cache_opt ? GEMM_LOOP_SCHEME : "aCb";
@@ -245,6 +262,7 @@ inline void tpp_linear_no_bias(
         [&]() { brgemm_tpp.config(); },
         [&]() { brgemm_tpp.release(); });
   }
+  tuner.stop();
 }
 
 template <typename T>
@@ -281,8 +299,10 @@ inline void tpp_linear_mul(
   auto out = GetVLAPtr<T>(t_out, {Nk, Hk});
 
   auto Ncb = Nc;
-  auto BSb = 64L;
-  auto rem = BS % 64;
+  GemmBlockingTuner tuner(
+      "tpp_linear_mul_krnl", BS, C, K, (long)sizeof(T), 64L);
+  auto BSb = tuner.block_m();
+  auto rem = BS % BSb;
   if (large_cache_opt)
     Ncb = NCB_BLOCK_SIZE;
 
@@ -298,6 +318,7 @@ inline void tpp_linear_mul(
   auto mul_tpp = SCOPEIT((MulTPP<T, T>(BSb, Hk, K, K)), EW_MUL);
   auto mul_tpp_rem = SCOPEIT((MulTPP<T, T>(rem, Hk, K, K)), EW_MUL);
 
+  tuner.start();
   {
     RECORD_SCOPE(tpp_linear_mul_krnl, {t_in, t_wt_V});
 
@@ -339,6 +360,7 @@ inline void tpp_linear_mul(
         [&]() { brgemm_tpp.config(); },
         [&]() { brgemm_tpp.release(); });
   }
+  tuner.stop();
 }
 
 template <typename T>
@@ -378,8 +400,10 @@ inline void tpp_linear_add_add(
   auto out = GetVLAPtr<T>(t_out, {Nk, Hk});
 
   auto Ncb = Nc;
-  auto BSb = 64L;
-  auto rem = BS % 64;
+  GemmBlockingTuner tuner(
+      "tpp_linear_add_add_krnl", BS, C, K, (long)sizeof(T), 64L);
+  auto BSb = tuner.block_m();
+  auto rem = BS % BSb;
   if (large_cache_opt)
     Ncb = NCB_BLOCK_SIZE;
   bool with_bias = (t_bias.numel() > 0);
@@ -396,6 +420,7 @@ inline void tpp_linear_add_add(
   auto sadd_tpp = SCOPEIT((ScaleAddTPP<T, T>(BSb, Hk, K, K)), EW_ADD);
   auto sadd_tpp_rem = SCOPEIT((ScaleAddTPP<T, T>(rem, Hk, K, K)), EW_ADD);
 
+  tuner.start();
   {
     RECORD_SCOPE(tpp_linear_add_add_krnl, {t_in, t_wt_V});
 
@@ -439,6 +464,7 @@ inline void tpp_linear_add_add(
         [&]() { brgemm_tpp.config(); },
         [&]() { brgemm_tpp.release(); });
   }
+  tuner.stop();
 }
 
 template <typename T>
@@ -473,8 +499,10 @@ inline void tpp_linear_gelu(
   auto out = GetVLAPtr<T>(t_out, {Nk, Hk});
 
   auto Ncb = Nc;
-  auto BSb = 64L;
-  auto rem = BS % 64;
+  GemmBlockingTuner tuner(
+      "tpp_linear_gelu_krnl", BS, C, K, (long)sizeof(T), 64L);
+  auto BSb = tuner.block_m();
+  auto rem = BS % BSb;
   if (large_cache_opt)
     Ncb = NCB_BLOCK_SIZE;
   bool with_bias = (t_bias.numel() > 0);
@@ -489,6 +517,7 @@ inline void tpp_linear_gelu(
   auto gelu_fwd_tpp = SCOPEIT(GeluFwdTPP<T>(BSb, Hk, K, K), ACT);
   auto gelu_fwd_tpp_rem = SCOPEIT(GeluFwdTPP<T>(rem, Hk, K, K), ACT);
 
+  tuner.start();
   {
     RECORD_SCOPE(tpp_linear_gelu_krnl, {t_in, t_wt_V});
 
@@ -530,6 +559,7 @@ inline void tpp_linear_gelu(
         [&]() { brgemm_tpp.config(); },
         [&]() { brgemm_tpp.release(); });
   }
+  tuner.stop();
 }
 
 // Fused kernel for the gate_proj and the up_proj related computation in the MLP
@@ -586,8 +616,10 @@ inline void tpp_fused_gate_up_proj(
   auto out_tmp = GetVLAPtr<T>(t_out_tmp, {Nk, Hk});
 
   auto Ncb = Nc;
-  auto BSb = 64L;
-  auto rem = BS % 64;
+  GemmBlockingTuner tuner(
+      "tpp_fused_gate_up_proj_krnl", BS, C, K, (long)sizeof(T), 64L);
+  auto BSb = tuner.block_m();
+  auto rem = BS % BSb;
   if (large_cache_opt)
     Ncb = NCB_BLOCK_SIZE;
 
@@ -606,6 +638,7 @@ inline void tpp_fused_gate_up_proj(
   auto mul_tpp = SCOPEIT((MulTPP<T, T>(BSb, Hk, K, K)), EW_MUL);
   auto mul_tpp_rem = SCOPEIT((MulTPP<T, T>(rem, Hk, K, K)), EW_MUL);
 
+  tuner.start();
   {
     RECORD_SCOPE(tpp_fused_gate_up_proj_krnl, {t_in, t_wt_gate_V});
 
@@ -666,6 +699,353 @@ inline void tpp_fused_gate_up_proj(
         [&]() { brgemm_tpp.config(); },
         [&]() { brgemm_tpp.release(); });
   }
+  tuner.stop();
+}
+
+// Fully fused gated MLP (LLaMA-style FFN): gate-proj, up-proj, SiLU-mul
+// and down-proj in one kernel. Each thread computes the complete
+// intermediate row block for its M-tile into a private buffer sized
+// BSb x K_intermediate (a few MB, L2/L3 resident), applies SiLU-mul
+// while the tile is hot and immediately consumes it in the
+// down-projection, so the wide intermediate never round-trips DRAM.
+// Weights are re-read per M-tile, which is the right trade at small and
+// medium batch where the op is bandwidth bound on the intermediate.
+// When t_res is defined it is added to the down-projection result while
+// the output tile is still hot, fusing the decoder-layer residual
+// connection into the same pass.
+template <typename T>
+inline void tpp_fused_gated_mlp_add(
+    const at::Tensor& t_in,
+    const at::Tensor& t_res,
+    const at::Tensor& t_wt_gate,
+    const at::Tensor& t_bias_gate,
+    const at::Tensor& t_wt_up,
+    const at::Tensor& t_bias_up,
+    const at::Tensor& t_wt_down,
+    const at::Tensor& t_bias_down,
+    at::Tensor& t_out) {
+  auto t_wt_gate_ = t_wt_gate;
+  auto t_wt_up_ = t_wt_up;
+  auto t_wt_down_ = t_wt_down;
+  auto in_sizes = t_in.sizes();
+  auto BS = in_sizes[0] * in_sizes[1];
+  if (BS > FT_OPT_SIZE) { // first token compute
+    t_wt_gate_ = wt_tensor_for_first_token<T>(t_wt_gate_);
+    t_wt_up_ = wt_tensor_for_first_token<T>(t_wt_up_);
+    t_wt_down_ = wt_tensor_for_first_token<T>(t_wt_down_);
+  }
+
+  auto wt_sizes = t_wt_gate_.sizes();
+  auto C = in_sizes[2];
+
+  auto Nc = wt_sizes[1];
+  auto Hc = C / Nc;
+  auto Nk = wt_sizes[0];
+  auto Hk = wt_sizes[3];
+  auto Ki = Nk * Hk; // intermediate width
+
+  auto wd_sizes = t_wt_down_.sizes();
+  auto Ncd = wd_sizes[1];
+  auto Hcd = Ki / Ncd;
+  auto Nkd = wd_sizes[0];
+  auto Hkd = wd_sizes[3];
+  auto Kd = Nkd * Hkd;
+
+  auto t_wt_gate_V =
+      torch_ipex::tpp::wt_tensor_for_fwd(Nk, Hk, Nc, Hc, t_wt_gate_);
+  auto t_wt_up_V = torch_ipex::tpp::wt_tensor_for_fwd(Nk, Hk, Nc, Hc, t_wt_up_);
+  auto t_wt_down_V =
+      torch_ipex::tpp::wt_tensor_for_fwd(Nkd, Hkd, Ncd, Hcd, t_wt_down_);
+
+  auto BSb = 64L;
+  auto rem = BS % 64;
+
+  // Thread-private intermediate tiles: gate result (later SiLU*up) and
+  // the raw up-proj result.
+  auto nThreads = (long)omp_get_max_threads();
+  auto t_int_gate = t_in.new_empty({nThreads, BSb, Ki});
+  auto t_int_up = t_in.new_empty({nThreads, BSb, Ki});
+
+  auto in = GetVLAPtr<T>(t_in, {Nc, Hc});
+  auto wt_gate_V = GetVLAPtr<T>(t_wt_gate_V, {Nc, Hc * Hk});
+  auto wt_up_V = GetVLAPtr<T>(t_wt_up_V, {Nc, Hc * Hk});
+  auto wt_down_V = GetVLAPtr<T>(t_wt_down_V, {Ncd, Hcd * Hkd});
+  auto bias_gate = GetVLAPtr<T>(t_bias_gate, {Hk});
+  auto bias_up = GetVLAPtr<T>(t_bias_up, {Hk});
+  auto bias_down = GetVLAPtr<T>(t_bias_down, {Hkd});
+  auto out = GetVLAPtr<T>(t_out, {Nkd, Hkd});
+  auto res = GetVLAPtr<T>(t_res, {Nkd, Hkd});
+  auto int_gate = GetVLAPtr<T>(t_int_gate, {BSb * Ki});
+  auto int_up = GetVLAPtr<T>(t_int_up, {BSb * Ki});
+
+  bool with_res = t_res.defined() && t_res.numel() > 0;
+  bool with_bias_gate = (t_bias_gate.numel() > 0);
+  bool with_bias_up = (t_bias_up.numel() > 0);
+  bool with_bias_down = (t_bias_down.numel() > 0);
+  auto copy_bias_tpp = SCOPEIT(CpyBiasTPP<T>(BSb, Hk, Ki), BIAS);
+  auto copy_bias_tpp_rem = SCOPEIT(CpyBiasTPP<T>(rem, Hk, Ki), BIAS);
+  auto zero_tpp = SCOPEIT(SetZeroTPP<T>(BSb, Hk, Ki), EW_ZERO);
+  auto zero_tpp_rem = SCOPEIT(SetZeroTPP<T>(rem, Hk, Ki), EW_ZERO);
+  auto copy_bias_down_tpp = SCOPEIT(CpyBiasTPP<T>(BSb, Hkd, Kd), BIAS);
+  auto copy_bias_down_tpp_rem = SCOPEIT(CpyBiasTPP<T>(rem, Hkd, Kd), BIAS);
+  auto zero_down_tpp = SCOPEIT(SetZeroTPP<T>(BSb, Hkd, Kd), EW_ZERO);
+  auto zero_down_tpp_rem = SCOPEIT(SetZeroTPP<T>(rem, Hkd, Kd), EW_ZERO);
+  auto brgemm_tpp = SCOPEITGEMM(
+      (BrgemmTPP<T, T>(BSb, Hk, Hc, Hc, Hk * Hc, C, Hk, Ki, 1.0, 0, Nc)));
+  auto brgemm_tpp_rem = SCOPEITGEMM(
+      (BrgemmTPP<T, T>(rem, Hk, Hc, Hc, Hk * Hc, C, Hk, Ki, 1.0, 0, Nc)));
+  auto brgemm_down_tpp = SCOPEITGEMM((
+      BrgemmTPP<T, T>(BSb, Hkd, Hcd, Hcd, Hkd * Hcd, Ki, Hkd, Kd, 1.0, 0, Ncd)));
+  auto brgemm_down_tpp_rem = SCOPEITGEMM((
+      BrgemmTPP<T, T>(rem, Hkd, Hcd, Hcd, Hkd * Hcd, Ki, Hkd, Kd, 1.0, 0, Ncd)));
+  auto silu_fwd_tpp = SCOPEIT(SiLUFwdTPP<T>(BSb, Hk, Ki, Ki), ACT);
+  auto silu_fwd_tpp_rem = SCOPEIT(SiLUFwdTPP<T>(rem, Hk, Ki, Ki), ACT);
+  auto mul_tpp = SCOPEIT((MulTPP<T, T>(BSb, Hk, Ki, Ki)), EW_MUL);
+  auto mul_tpp_rem = SCOPEIT((MulTPP<T, T>(rem, Hk, Ki, Ki)), EW_MUL);
+  auto res_add_tpp = SCOPEIT((AddTPP<T, T>(BSb, Hkd, Kd, Kd)), EW_ADD);
+  auto res_add_tpp_rem = SCOPEIT((AddTPP<T, T>(rem, Hkd, Kd, Kd)), EW_ADD);
+
+  {
+    RECORD_SCOPE(tpp_fused_gated_mlp_krnl, {t_in, t_wt_gate_V});
+
+    auto mlp_loop =
+        torch_ipex::tpp::ThreadedLoop<1>({{0, BS, BSb}}, "A");
+    mlp_loop(
+        [&](int* ind) {
+          int s1 = ind[0];
+          int tid = omp_get_thread_num();
+          T* gbuf = int_gate[tid];
+          T* ubuf = int_up[tid];
+          bool is_rem = (s1 + BSb > BS);
+          if (!is_rem) {
+            brgemm_tpp.config();
+            for (int nk = 0; nk < Nk; nk++) {
+              if (with_bias_gate) {
+                copy_bias_tpp(bias_gate[nk], gbuf + nk * Hk);
+              } else {
+                zero_tpp(gbuf + nk * Hk);
+              }
+              if (with_bias_up) {
+                copy_bias_tpp(bias_up[nk], ubuf + nk * Hk);
+              } else {
+                zero_tpp(ubuf + nk * Hk);
+              }
+              brgemm_tpp(in[s1][0], wt_gate_V[nk][0], gbuf + nk * Hk, Nc, true);
+              brgemm_tpp(in[s1][0], wt_up_V[nk][0], ubuf + nk * Hk, Nc, true);
+              silu_fwd_tpp(gbuf + nk * Hk, gbuf + nk * Hk);
+              mul_tpp(gbuf + nk * Hk, ubuf + nk * Hk, gbuf + nk * Hk);
+            }
+            brgemm_down_tpp.config();
+            for (int nkd = 0; nkd < Nkd; nkd++) {
+              if (with_bias_down) {
+                copy_bias_down_tpp(bias_down[nkd], out[s1][nkd]);
+              } else {
+                zero_down_tpp(out[s1][nkd]);
+              }
+              brgemm_down_tpp(gbuf, wt_down_V[nkd][0], out[s1][nkd], Ncd, true);
+              if (with_res) {
+                res_add_tpp(res[s1][nkd], out[s1][nkd], out[s1][nkd]);
+              }
+            }
+          } else {
+            for (int nk = 0; nk < Nk; nk++) {
+              if (with_bias_gate) {
+                copy_bias_tpp_rem(bias_gate[nk], gbuf + nk * Hk);
+              } else {
+                zero_tpp_rem(gbuf + nk * Hk);
+              }
+              if (with_bias_up) {
+                copy_bias_tpp_rem(bias_up[nk], ubuf + nk * Hk);
+              } else {
+                zero_tpp_rem(ubuf + nk * Hk);
+              }
+              brgemm_tpp_rem(
+                  in[s1][0], wt_gate_V[nk][0], gbuf + nk * Hk, Nc, false);
+              brgemm_tpp_rem(
+                  in[s1][0], wt_up_V[nk][0], ubuf + nk * Hk, Nc, false);
+              silu_fwd_tpp_rem(gbuf + nk * Hk, gbuf + nk * Hk);
+              mul_tpp_rem(gbuf + nk * Hk, ubuf + nk * Hk, gbuf + nk * Hk);
+            }
+            for (int nkd = 0; nkd < Nkd; nkd++) {
+              if (with_bias_down) {
+                copy_bias_down_tpp_rem(bias_down[nkd], out[s1][nkd]);
+              } else {
+                zero_down_tpp_rem(out[s1][nkd]);
+              }
+              brgemm_down_tpp_rem(
+                  gbuf, wt_down_V[nkd][0], out[s1][nkd], Ncd, false);
+              if (with_res) {
+                res_add_tpp_rem(res[s1][nkd], out[s1][nkd], out[s1][nkd]);
+              }
+            }
+          }
+        },
+        [&]() {},
+        [&]() { brgemm_down_tpp.release(); });
+  }
+}
+
+template <typename T>
+inline void tpp_fused_gated_mlp(
+    const at::Tensor& t_in,
+    const at::Tensor& t_wt_gate,
+    const at::Tensor& t_bias_gate,
+    const at::Tensor& t_wt_up,
+    const at::Tensor& t_bias_up,
+    const at::Tensor& t_wt_down,
+    const at::Tensor& t_bias_down,
+    at::Tensor& t_out) {
+  tpp_fused_gated_mlp_add<T>(
+      t_in,
+      at::Tensor(),
+      t_wt_gate,
+      t_bias_gate,
+      t_wt_up,
+      t_bias_up,
+      t_wt_down,
+      t_bias_down,
+      t_out);
+}
+
+// Fused Q/K/V projections: the three weights must share one blocked
+// shape (multi-head attention; grouped-query models with smaller K/V
+// still go through separate tpp_linear calls). Each activation tile is
+// loaded once and multiplied against all three weights before moving on,
+// saving two activation passes per block compared to three tpp_linear
+// calls -- the win at small batch where the op is bandwidth bound.
+template <typename T>
+inline void tpp_fused_qkv_gemm(
+    const at::Tensor& t_in,
+    const at::Tensor& t_wt_q,
+    const at::Tensor& t_bias_q,
+    const at::Tensor& t_wt_k,
+    const at::Tensor& t_bias_k,
+    const at::Tensor& t_wt_v,
+    const at::Tensor& t_bias_v,
+    at::Tensor& t_out_q,
+    at::Tensor& t_out_k,
+    at::Tensor& t_out_v) {
+  auto t_wt_q_ = t_wt_q;
+  auto t_wt_k_ = t_wt_k;
+  auto t_wt_v_ = t_wt_v;
+  auto in_sizes = t_in.sizes();
+  auto BS = in_sizes[0] * in_sizes[1];
+  bool large_cache_opt = false;
+  if (BS > FT_OPT_SIZE) { // first token compute
+    t_wt_q_ = wt_tensor_for_first_token<T>(t_wt_q_);
+    t_wt_k_ = wt_tensor_for_first_token<T>(t_wt_k_);
+    t_wt_v_ = wt_tensor_for_first_token<T>(t_wt_v_);
+    large_cache_opt = true;
+  }
+
+  auto wt_sizes = t_wt_q_.sizes();
+  auto C = in_sizes[2];
+
+  auto Nc = wt_sizes[1];
+  auto Hc = C / Nc;
+  auto Nk = wt_sizes[0];
+  auto Hk = wt_sizes[3];
+  auto K = Nk * Hk;
+
+  auto t_wt_q_V = torch_ipex::tpp::wt_tensor_for_fwd(Nk, Hk, Nc, Hc, t_wt_q_);
+  auto t_wt_k_V = torch_ipex::tpp::wt_tensor_for_fwd(Nk, Hk, Nc, Hc, t_wt_k_);
+  auto t_wt_v_V = torch_ipex::tpp::wt_tensor_for_fwd(Nk, Hk, Nc, Hc, t_wt_v_);
+
+  auto in = GetVLAPtr<T>(t_in, {Nc, Hc});
+  auto wt_q_V = GetVLAPtr<T>(t_wt_q_V, {Nc, Hc * Hk});
+  auto wt_k_V = GetVLAPtr<T>(t_wt_k_V, {Nc, Hc * Hk});
+  auto wt_v_V = GetVLAPtr<T>(t_wt_v_V, {Nc, Hc * Hk});
+  auto bias_q = GetVLAPtr<T>(t_bias_q, {Hk});
+  auto bias_k = GetVLAPtr<T>(t_bias_k, {Hk});
+  auto bias_v = GetVLAPtr<T>(t_bias_v, {Hk});
+  auto out_q = GetVLAPtr<T>(t_out_q, {Nk, Hk});
+  auto out_k = GetVLAPtr<T>(t_out_k, {Nk, Hk});
+  auto out_v = GetVLAPtr<T>(t_out_v, {Nk, Hk});
+
+  auto Ncb = Nc;
+  GemmBlockingTuner tuner(
+      "tpp_fused_qkv_krnl", BS, C, K, (long)sizeof(T), 64L);
+  auto BSb = tuner.block_m();
+  auto rem = BS % BSb;
+  if (large_cache_opt)
+    Ncb = NCB_BLOCK_SIZE;
+
+  bool with_bias_q = (t_bias_q.numel() > 0);
+  bool with_bias_k = (t_bias_k.numel() > 0);
+  bool with_bias_v = (t_bias_v.numel() > 0);
+  auto copy_bias_tpp = SCOPEIT(CpyBiasTPP<T>(BSb, Hk, K), BIAS);
+  auto copy_bias_tpp_rem = SCOPEIT(CpyBiasTPP<T>(rem, Hk, K), BIAS);
+  auto zero_tpp = SCOPEIT(SetZeroTPP<T>(BSb, Hk, K), EW_ZERO);
+  auto zero_tpp_rem = SCOPEIT(SetZeroTPP<T>(rem, Hk, K), EW_ZERO);
+  auto brgemm_tpp = SCOPEITGEMM(
+      (BrgemmTPP<T, T>(BSb, Hk, Hc, Hc, Hk * Hc, C, Hk, K, 1.0, 0, Ncb)));
+  auto brgemm_tpp_rem = SCOPEITGEMM(
+      (BrgemmTPP<T, T>(rem, Hk, Hc, Hc, Hk * Hc, C, Hk, K, 1.0, 0, Ncb)));
+
+  tuner.start();
+  {
+    RECORD_SCOPE(tpp_fused_qkv_krnl, {t_in, t_wt_q_V});
+
+    auto loop_scheme = large_cache_opt ? GEMM_LOOP_SCHEME : "aCb";
+    auto qkv_loop = torch_ipex::tpp::ThreadedLoop<3>(
+        {{0, Nc, Ncb, false}, {0, BS, BSb}, {Nk}}, loop_scheme);
+    qkv_loop(
+        [&](int* ind) {
+          int nc = ind[0], s1 = ind[1], nk = ind[2];
+          auto count = nc + Ncb < Nc ? Ncb : Nc - nc;
+          bool is_rem = (s1 + BSb > BS);
+          if (!is_rem) {
+            if (nc == 0) {
+              if (with_bias_q) {
+                copy_bias_tpp(bias_q[nk], out_q[s1][nk]);
+              } else {
+                zero_tpp(out_q[s1][nk]);
+              }
+              if (with_bias_k) {
+                copy_bias_tpp(bias_k[nk], out_k[s1][nk]);
+              } else {
+                zero_tpp(out_k[s1][nk]);
+              }
+              if (with_bias_v) {
+                copy_bias_tpp(bias_v[nk], out_v[s1][nk]);
+              } else {
+                zero_tpp(out_v[s1][nk]);
+              }
+            }
+            brgemm_tpp(in[s1][nc], wt_q_V[nk][nc], out_q[s1][nk], count, true);
+            brgemm_tpp(in[s1][nc], wt_k_V[nk][nc], out_k[s1][nk], count, true);
+            brgemm_tpp(in[s1][nc], wt_v_V[nk][nc], out_v[s1][nk], count, true);
+          } else {
+            if (nc == 0) {
+              if (with_bias_q) {
+                copy_bias_tpp_rem(bias_q[nk], out_q[s1][nk]);
+              } else {
+                zero_tpp_rem(out_q[s1][nk]);
+              }
+              if (with_bias_k) {
+                copy_bias_tpp_rem(bias_k[nk], out_k[s1][nk]);
+              } else {
+                zero_tpp_rem(out_k[s1][nk]);
+              }
+              if (with_bias_v) {
+                copy_bias_tpp_rem(bias_v[nk], out_v[s1][nk]);
+              } else {
+                zero_tpp_rem(out_v[s1][nk]);
+              }
+            }
+            brgemm_tpp_rem(
+                in[s1][nc], wt_q_V[nk][nc], out_q[s1][nk], count, false);
+            brgemm_tpp_rem(
+                in[s1][nc], wt_k_V[nk][nc], out_k[s1][nk], count, false);
+            brgemm_tpp_rem(
+                in[s1][nc], wt_v_V[nk][nc], out_v[s1][nk], count, false);
+            brgemm_tpp.config();
+          }
+        },
+        [&]() { brgemm_tpp.config(); },
+        [&]() { brgemm_tpp.release(); });
+  }
+  tuner.stop();
 }
 
 template <typename T>
@@ -703,8 +1083,10 @@ inline void tpp_linear_add(
   auto out = GetVLAPtr<T>(t_out, {Nk, Hk});
 
   auto Ncb = Nc;
-  auto BSb = 64L;
-  auto rem = BS % 64;
+  GemmBlockingTuner tuner(
+      "tpp_linear_add_krnl", BS, C, K, (long)sizeof(T), 64L);
+  auto BSb = tuner.block_m();
+  auto rem = BS % BSb;
   if (large_cache_opt)
     Ncb = NCB_BLOCK_SIZE;
 
@@ -720,6 +1102,7 @@ inline void tpp_linear_add(
   auto sadd_tpp = SCOPEIT((ScaleAddTPP<T, T>(BSb, Hk, K, K)), EW_ADD);
   auto sadd_tpp_rem = SCOPEIT((ScaleAddTPP<T, T>(rem, Hk, K, K)), EW_ADD);
 
+  tuner.start();
   {
     RECORD_SCOPE(tpp_linear_add_krnl, {t_in, t_wt_V});
 
@@ -761,6 +1144,7 @@ inline void tpp_linear_add(
         [&]() { brgemm_tpp.config(); },
         [&]() { brgemm_tpp.release(); });
   }
+  tuner.stop();
 }
 
 template <typename T>
@@ -795,8 +1179,10 @@ inline void tpp_linear_silu(
   auto out = GetVLAPtr<T>(t_out, {Nk, Hk});
 
   auto Ncb = Nc;
-  auto BSb = 64L;
-  auto rem = BS % 64;
+  GemmBlockingTuner tuner(
+      "tpp_linear_silu_krnl", BS, C, K, (long)sizeof(T), 64L);
+  auto BSb = tuner.block_m();
+  auto rem = BS % BSb;
   if (large_cache_opt)
     Ncb = NCB_BLOCK_SIZE;
 
@@ -812,6 +1198,7 @@ inline void tpp_linear_silu(
   auto silu_fwd_tpp = SCOPEIT(SiLUFwdTPP<T>(BSb, Hk, K, K), ACT);
   auto silu_fwd_tpp_rem = SCOPEIT(SiLUFwdTPP<T>(rem, Hk, K, K), ACT);
 
+  tuner.start();
   {
     RECORD_SCOPE(tpp_linear_silu_krnl, {t_in, t_wt_V});
 
@@ -853,6 +1240,7 @@ inline void tpp_linear_silu(
         [&]() { brgemm_tpp.config(); },
         [&]() { brgemm_tpp.release(); });
   }
+  tuner.stop();
 }
 
 template <typename T>
@@ -887,8 +1275,10 @@ inline void tpp_linear_relu(
   auto out = GetVLAPtr<T>(t_out, {Nk, Hk});
 
   auto Ncb = Nc;
-  auto BSb = 64L;
-  auto rem = BS % 64;
+  GemmBlockingTuner tuner(
+      "tpp_linear_relu_krnl", BS, C, K, (long)sizeof(T), 64L);
+  auto BSb = tuner.block_m();
+  auto rem = BS % BSb;
   if (large_cache_opt)
     Ncb = NCB_BLOCK_SIZE;
 
@@ -904,6 +1294,7 @@ inline void tpp_linear_relu(
   auto relu_fwd_tpp = SCOPEIT(ReLUFwdTPP<T>(BSb, Hk, K, K, false), ACT);
   auto relu_fwd_tpp_rem = SCOPEIT(ReLUFwdTPP<T>(rem, Hk, K, K, false), ACT);
 
+  tuner.start();
   {
     RECORD_SCOPE(tpp_linear_relu_krnl, {t_in, t_wt_V});
 
@@ -945,6 +1336,133 @@ inline void tpp_linear_relu(
         [&]() { brgemm_tpp.config(); },
         [&]() { brgemm_tpp.release(); });
   }
+  tuner.stop();
+}
+
+/*
+ * Greedy-decode epilogue: last-layer linear straight to token ids. Each
+ * (row-block, N-tile) logit tile is computed into a thread-private
+ * buffer and reduced to a per-row max and index on the spot, so the
+ * BS x vocab logit tensor is never written to memory - only the
+ * BS x Nk tile partials and the final int64 token ids. The tile is
+ * computed in the weight dtype, so the result matches argmax over the
+ * unfused tpp_linear output exactly. Ascending scan order keeps the
+ * first of tied maxima, both within a tile and across tiles.
+ */
+template <typename T>
+inline void tpp_linear_argmax(
+    const at::Tensor& t_in,
+    const at::Tensor& t_wt,
+    const at::Tensor& t_bias,
+    at::Tensor& t_out) {
+  auto t_wt_ = t_wt;
+  auto in_sizes = t_in.sizes();
+  auto wt_sizes = t_wt_.sizes();
+  auto BS = in_sizes[0] * in_sizes[1];
+  auto C = in_sizes[2];
+
+  auto Nc = wt_sizes[1];
+  auto Hc = C / Nc;
+  auto Nk = wt_sizes[0];
+  auto Hk = wt_sizes[3];
+  auto K = Nk * Hk;
+
+  auto t_wt_V = torch_ipex::tpp::wt_tensor_for_fwd(Nk, Hk, Nc, Hc, t_wt_);
+
+  GemmBlockingTuner tuner(
+      "tpp_linear_argmax_krnl", BS, C, K, (long)sizeof(T), 64L);
+  auto BSb = tuner.block_m();
+  auto rem = BS % BSb;
+
+  // Thread-private logit tile plus the per-(row, N-tile) partials - the
+  // only cross-tile state, BS x Nk values instead of the BS x K logits.
+  auto nThreads = (long)omp_get_max_threads();
+  auto t_scratch = t_in.new_empty({nThreads, BSb * Hk});
+  auto t_part_val = t_in.new_empty({BS, Nk});
+  auto t_part_idx = at::empty({BS, Nk}, t_in.options().dtype(at::kLong));
+
+  auto in = GetVLAPtr<T>(t_in, {Nc, Hc});
+  auto wt_V = GetVLAPtr<T>(t_wt_V, {Nc, Hc * Hk});
+  auto bias = GetVLAPtr<T>(t_bias, {Hk});
+  auto scratch = GetVLAPtr<T>(t_scratch, {BSb * Hk});
+  auto part_val = GetVLAPtr<T>(t_part_val, {Nk});
+  auto part_idx = GetVLAPtr<int64_t>(t_part_idx, {Nk});
+  auto out = t_out.data_ptr<int64_t>();
+
+  bool with_bias = (t_bias.numel() > 0);
+  auto copy_bias_tpp = SCOPEIT(CpyBiasTPP<T>(BSb, Hk, Hk), BIAS);
+  auto copy_bias_tpp_rem = SCOPEIT(CpyBiasTPP<T>(rem, Hk, Hk), BIAS);
+  auto zero_tpp = SCOPEIT(SetZeroTPP<T>(BSb, Hk, Hk), EW_ZERO);
+  auto zero_tpp_rem = SCOPEIT(SetZeroTPP<T>(rem, Hk, Hk), EW_ZERO);
+  auto brgemm_tpp = SCOPEITGEMM(
+      (BrgemmTPP<T, T>(BSb, Hk, Hc, Hc, Hk * Hc, C, Hk, Hk, 1.0, 0, Nc)));
+  auto brgemm_tpp_rem = SCOPEITGEMM(
+      (BrgemmTPP<T, T>(rem, Hk, Hc, Hc, Hk * Hc, C, Hk, Hk, 1.0, 0, Nc)));
+
+  tuner.start();
+  {
+    RECORD_SCOPE(tpp_linear_argmax_krnl, {t_in, t_wt_V});
+
+    auto gemm_loop =
+        torch_ipex::tpp::ThreadedLoop<2>({{0, BS, BSb, false}, {Nk}}, "AB");
+    gemm_loop(
+        [&](int* ind) {
+          int s1 = ind[0], nk = ind[1];
+          int tid = omp_get_thread_num();
+          T* buf = scratch[tid];
+          bool is_rem = (s1 + BSb > BS);
+          long rows = is_rem ? rem : BSb;
+          if (!is_rem) {
+            if (with_bias) {
+              copy_bias_tpp(bias[nk], buf);
+            } else {
+              zero_tpp(buf);
+            }
+            brgemm_tpp(in[s1][0], wt_V[nk][0], buf, Nc, true);
+          } else {
+            if (with_bias) {
+              copy_bias_tpp_rem(bias[nk], buf);
+            } else {
+              zero_tpp_rem(buf);
+            }
+            brgemm_tpp_rem(in[s1][0], wt_V[nk][0], buf, Nc, false);
+            brgemm_tpp.config();
+          }
+          // reduce the tile to its per-row max and global index while it
+          // is still hot in the thread's cache
+          for (long r = 0; r < rows; r++) {
+            float best = (float)buf[r * Hk];
+            long best_h = 0;
+            for (long h = 1; h < Hk; h++) {
+              float v = (float)buf[r * Hk + h];
+              if (v > best) {
+                best = v;
+                best_h = h;
+              }
+            }
+            part_val[s1 + r][nk] = (T)best;
+            part_idx[s1 + r][nk] = (int64_t)nk * Hk + best_h;
+          }
+        },
+        [&]() { brgemm_tpp.config(); },
+        [&]() { brgemm_tpp.release(); });
+  }
+  tuner.stop();
+
+  // fold the N-tile partials of each row into the emitted token id
+#pragma omp parallel for
+  for (long s = 0; s < BS; s++) {
+    float best = (float)part_val[s][0];
+    int64_t best_idx = part_idx[s][0];
+    for (long nk = 1; nk < Nk; nk++) {
+      float v = (float)part_val[s][nk];
+      if (v > best) {
+        best = v;
+        best_idx = part_idx[s][nk];
+      }
+    }
+    out[s] = best_idx;
+  }
 }
 
 } // namespace tpp
@@ -73,6 +73,7 @@ REGISTER_SCOPE(dense_sparse_add, "sprse_add");
 REGISTER_SCOPE(fused_adamw, "fused_adamw");
 REGISTER_SCOPE(fused_lamb, "fused_lamb");
 REGISTER_SCOPE(splt_adamw, "splt_adamw");
+REGISTER_SCOPE(splt_adam, "splt_adam");
 REGISTER_SCOPE(splt_lamb, "splt_lamb");
 REGISTER_SCOPE(grad_norm, "grad_norm");
 
@@ -352,6 +353,82 @@ void fused_split_adamw(
   }
 }
 
+void fused_split_adam(
+    at::Tensor& t_data_hi,
+    at::Tensor& t_data_lo,
+    at::Tensor& t_grad,
+    at::Tensor& t_exp_avg,
+    at::Tensor& t_exp_avg_sq,
+    float beta1,
+    float beta2,
+    float step_size,
+    float lr,
+    float weight_decay,
+    float eps) {
+  GlobalPass _gp(UPD);
+  RECORD_SCOPE(splt_adam, {t_data_hi});
+  typedef bfloat16 T;
+  auto data_hi = t_data_hi.data_ptr<T>();
+  auto data_lo = t_data_lo.data_ptr<T>();
+  auto grad = t_grad.data_ptr<T>();
+  auto exp_avg = t_exp_avg.data_ptr<T>();
+  auto exp_avg_sq = t_exp_avg_sq.data_ptr<T>();
+  long sz = t_data_hi.numel();
+  constexpr int BS = 64;
+
+  // Classic Adam applies weight decay as L2 on the gradient before the
+  // moment updates rather than AdamW's decoupled decay on the weights.
+  // The hi half of the split weight is itself the bf16 rounding of the
+  // fp32 master value, so grad + wd * hi carries the same precision as
+  // the incoming bf16 gradient; the moments and the weight update then
+  // reuse the split AdamW equations with decay disabled.
+  auto grad_cpy_tpp = SCOPEIT(CpyTPP<T>(BS), EW_COPY);
+  auto grad_l2_tpp = SCOPEIT((ScaleAddTPP<T, T>(BS)), OPTIM);
+  auto split_adam_tpp =
+      SCOPEIT(FusedSplitAdamWTPP(BS, beta1, beta2, 0.0f, eps), OPTIM);
+
+  long i;
+#pragma omp parallel for lastprivate(i)
+  for (i = 0; i < ALIGNDOWN(sz, BS); i += BS) {
+    T g[BS];
+    T* gp = &grad[i];
+    if (weight_decay > 0.0f) {
+      grad_cpy_tpp(&grad[i], g);
+      grad_l2_tpp(&data_hi[i], g, weight_decay);
+      gp = g;
+    }
+    split_adam_tpp(
+        &data_hi[i],
+        &data_lo[i],
+        gp,
+        &exp_avg[i],
+        &exp_avg_sq[i],
+        step_size,
+        lr);
+  }
+  if (i < sz) {
+    T g[BS];
+    T* gp = &grad[i];
+    if (weight_decay > 0.0f) {
+      auto grad_cpy_tpp = SCOPEIT(CpyTPP<T>(sz - i), EW_COPY);
+      auto grad_l2_tpp = SCOPEIT((ScaleAddTPP<T, T>(sz - i)), OPTIM);
+      grad_cpy_tpp(&grad[i], g);
+      grad_l2_tpp(&data_hi[i], g, weight_decay);
+      gp = g;
+    }
+    auto split_adam_tpp =
+        SCOPEIT(FusedSplitAdamWTPP(sz - i, beta1, beta2, 0.0f, eps), OPTIM);
+    split_adam_tpp(
+        &data_hi[i],
+        &data_lo[i],
+        gp,
+        &exp_avg[i],
+        &exp_avg_sq[i],
+        step_size,
+        lr);
+  }
+}
+
 template <typename T>
 double norm2(T* ptr, long N) {
   constexpr int BS = 256;
@@ -40,6 +40,19 @@ void fused_split_adamw(
     float weight_decay,
     float eps);
 
+void fused_split_adam(
+    at::Tensor& t_data_hi,
+    at::Tensor& t_data_lo,
+    at::Tensor& t_grad,
+    at::Tensor& t_exp_avg,
+    at::Tensor& t_exp_avg_sq,
+    float beta1,
+    float beta2,
+    float step_size,
+    float lr,
+    float weight_decay,
+    float eps);
+
 double clip_grad_norm(std::vector<at::Tensor>& grads, double max_norm);
 
 float fused_lamb(
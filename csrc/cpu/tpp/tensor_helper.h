@@ -1,6 +1,9 @@
 #ifndef _TENSOR_HELPER_H_
 #define _TENSOR_HELPER_H_
 
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
 #include "utils.h"
 
 namespace torch_ipex {
@@ -149,6 +152,56 @@ inline at::Tensor wt_tensor_trans_v2v_compact(
 #endif
 }
 
+// On multi-socket machines a blocked weight allocated by a single thread
+// (e.g. during prepack) has all its pages on one NUMA node and remote
+// threads stall on the interconnect. When IPEX_TPP_NUMA_WT_PLACEMENT=1 we
+// re-materialize such weights once with a statically partitioned parallel
+// copy over the Nk blocks: each thread first-touches the contiguous span
+// of N-blocks it will later stream in the threaded loops (which partition
+// the parallel Nk loop the same way), so with OMP_PROC_BIND set every
+// socket reads its own half of the weight locally. The placed copy is
+// cached by storage pointer; weights are assumed frozen for inference.
+inline bool wt_numa_placement_enabled() {
+  static int enabled = env2int("IPEX_TPP_NUMA_WT_PLACEMENT", 0);
+  return enabled != 0;
+}
+
+template <typename T>
+inline at::Tensor wt_numa_place_copy(long Nk, at::Tensor& input) {
+  auto output = input.new_empty(input.sizes());
+  auto blk = input.numel() / Nk;
+  auto in = GetVLAPtr<T>(input, {blk});
+  auto out = GetVLAPtr<T>(output, {blk});
+  RECORD_FUNCTION("parallel_for", std::vector<c10::IValue>());
+#pragma omp parallel for schedule(static)
+  for (int n = 0; n < Nk; n++) {
+    memcpy(out[n], in[n], blk * sizeof(T));
+  }
+  return output;
+}
+
+inline at::Tensor wt_numa_placed(long Nk, at::Tensor& input) {
+  static std::mutex mutex;
+  static std::unordered_map<const void*, at::Tensor> placed;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = placed.find(input.data_ptr());
+    if (it != placed.end())
+      return it->second;
+  }
+  at::Tensor output;
+  if (input.dtype() == at::kBFloat16) {
+    output = wt_numa_place_copy<bfloat16>(Nk, input);
+  } else if (input.dtype() == at::kFloat) {
+    output = wt_numa_place_copy<float>(Nk, input);
+  } else {
+    return input;
+  }
+  std::lock_guard<std::mutex> lock(mutex);
+  placed.emplace(input.data_ptr(), output);
+  return output;
+}
+
 USING_SCOPE(w_vnni);
 
 inline at::Tensor wt_tensor_for_fwd(
@@ -160,6 +213,8 @@ inline at::Tensor wt_tensor_for_fwd(
   RECORD_SCOPE(w_vnni, {input});
   if (input.dtype() != at::kFloat) {
     if (input.dim() == 5) {
+      if (wt_numa_placement_enabled())
+        return wt_numa_placed(Nk, input);
       return input;
     } else {
       if (input.dtype() == at::kBFloat16) {
@@ -169,6 +224,8 @@ inline at::Tensor wt_tensor_for_fwd(
       }
     }
   } else {
+    if (wt_numa_placement_enabled())
+      return wt_numa_placed(Nk, input);
     return input;
   }
 }
@@ -1,15 +1,21 @@
 #ifndef _THREADED_LOOPS_H_
 #define _THREADED_LOOPS_H_
 
+#include <omp.h>
 #include <stdio.h>
+#include <algorithm>
 #include <array>
 #include <cassert>
+#include <chrono>
 #include <fstream>
+#include <functional>
 #include <initializer_list>
 #include <iostream>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include "jit_compile.h"
 #include "par_loop_generator.h"
 
@@ -247,6 +253,124 @@ inline LoopingScheme* getLoopingScheme(std::string scheme) {
   return kernel;
 }
 
+inline bool loop_autotune_enabled() {
+  static bool enabled = []() {
+    auto env = getenv("IPEX_TPP_LOOP_AUTOTUNE");
+    return env != NULL && atoi(env) != 0;
+  }();
+  return enabled;
+}
+
+// Searches for the fastest loop order per (scheme, bounds, thread count)
+// key: the first invocations of a key each time one candidate permutation
+// of the caller's scheme, then the winner is locked in for the rest of
+// the process. Only pure-letter schemes are searched; permuting them is
+// semantics-preserving because the body indexes by logical loop id, and
+// the last character is kept fixed to stay within the scheme grammar.
+// Winners can be persisted across runs via IPEX_TPP_LOOP_TUNING_FILE.
+class LoopAutotuner {
+ public:
+  static LoopAutotuner& instance() {
+    static LoopAutotuner tuner;
+    return tuner;
+  }
+
+  // Scheme to run for the next invocation of this key.
+  std::string pick(const std::string& key, const std::string& scheme) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& entry = table_[key];
+    if (entry.candidates.empty())
+      init_entry(entry, key, scheme);
+    if (entry.done)
+      return entry.best_scheme;
+    return entry.candidates[entry.next];
+  }
+
+  // Report the time of the invocation returned by pick().
+  void record(const std::string& key, const std::string& scheme, double secs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& entry = table_[key];
+    if (entry.done || entry.candidates.empty() ||
+        scheme != entry.candidates[entry.next])
+      return;
+    if (secs < entry.best_time) {
+      entry.best_time = secs;
+      entry.best_scheme = scheme;
+    }
+    entry.next++;
+    if (entry.next >= (int)entry.candidates.size()) {
+      entry.done = true;
+      persist(key, entry.best_scheme);
+    }
+  }
+
+ private:
+  struct Entry {
+    std::vector<std::string> candidates;
+    int next = 0;
+    bool done = false;
+    double best_time = 1e30;
+    std::string best_scheme;
+  };
+
+  static constexpr int MAX_CANDIDATES = 8;
+
+  LoopAutotuner() {
+    auto env = getenv("IPEX_TPP_LOOP_TUNING_FILE");
+    if (env != NULL) {
+      tuning_file_ = env;
+      std::ifstream ifs(tuning_file_);
+      std::string key, scheme;
+      while (ifs >> key >> scheme)
+        tuned_[key] = scheme;
+    }
+  }
+
+  void init_entry(Entry& entry, const std::string& key, std::string scheme) {
+    auto tuned = tuned_.find(key);
+    if (tuned != tuned_.end()) {
+      entry.candidates = {tuned->second};
+      entry.best_scheme = tuned->second;
+      entry.done = true;
+      return;
+    }
+    bool pure_letters = !scheme.empty() &&
+        std::all_of(scheme.begin(), scheme.end(), [](unsigned char c) {
+          return isalpha(c);
+        });
+    if (!pure_letters) {
+      entry.candidates = {scheme};
+      entry.best_scheme = scheme;
+      entry.done = true;
+      return;
+    }
+    // Permute all but the last character (candidates stay in the same
+    // grammar position) and make sure the caller's scheme is tried first.
+    entry.candidates.push_back(scheme);
+    std::string prefix = scheme.substr(0, scheme.size() - 1);
+    std::sort(prefix.begin(), prefix.end());
+    do {
+      auto candidate = prefix + scheme.back();
+      if (candidate != scheme)
+        entry.candidates.push_back(candidate);
+    } while ((int)entry.candidates.size() < MAX_CANDIDATES &&
+             std::next_permutation(prefix.begin(), prefix.end()));
+    entry.best_scheme = scheme;
+  }
+
+  void persist(const std::string& key, const std::string& scheme) {
+    if (tuning_file_.empty())
+      return;
+    std::ofstream ofs(tuning_file_, std::ofstream::app);
+    ofs << key << " " << scheme << std::endl;
+  }
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, Entry> table_;
+  std::unordered_map<std::string, std::string> tuned_;
+  std::string tuning_file_;
+};
+
 template <int N>
 class ThreadedLoop {
  public:
@@ -271,14 +395,24 @@ class ThreadedLoop {
     if (scheme == "")
       scheme = getDefaultScheme();
     loopScheme = getLoopingScheme(scheme);
+    if (loop_autotune_enabled())
+      tuneKey = buildTuneKey(scheme);
   }
 
   template <class T>
   void operator()(T func) {
+    if (!tuneKey.empty()) {
+      tunedCall(func, NULL, NULL);
+      return;
+    }
     loopScheme->call(bounds, func, NULL, NULL);
   }
   template <class T, class Ti, class Tf>
   void operator()(T func, Ti init, Tf fini) {
+    if (!tuneKey.empty()) {
+      tunedCall(func, init, fini);
+      return;
+    }
     loopScheme->call(bounds, func, init, fini);
   }
 
@@ -294,8 +428,39 @@ class ThreadedLoop {
   }
 
  private:
+  // The key carries everything that shapes the timing at this layer: the
+  // scheme, the loop bounds/blockings (which encode the blocked problem
+  // shape) and the thread count.
+  std::string buildTuneKey(const std::string& scheme) {
+    std::ostringstream key;
+    key << scheme;
+    for (int i = 0; i < N; i++) {
+      key << "_" << bounds[i].start << ":" << bounds[i].end << ":"
+          << bounds[i].step;
+      for (int j = 0; j < bounds[i].nBlockingLevels; j++)
+        key << "b" << bounds[i].block_size[j];
+    }
+    key << "_t" << omp_get_max_threads();
+    return key.str();
+  }
+
+  void tunedCall(
+      std::function<void(int*)> func,
+      std::function<void()> init,
+      std::function<void()> fini) {
+    auto& tuner = LoopAutotuner::instance();
+    auto candidate = tuner.pick(tuneKey, loopScheme->scheme);
+    auto* candidateScheme = getLoopingScheme(candidate);
+    auto t0 = std::chrono::steady_clock::now();
+    candidateScheme->call(bounds, func, init, fini);
+    auto t1 = std::chrono::steady_clock::now();
+    tuner.record(
+        tuneKey, candidate, std::chrono::duration<double>(t1 - t0).count());
+  }
+
   LoopSpecs bounds[N];
   std::string scheme;
+  std::string tuneKey;
   LoopingScheme* loopScheme;
 };
 } // namespace tpp
@@ -1,6 +1,13 @@
 #ifndef _BERT_TIMING_H_
 #define _BERT_TIMING_H_
 
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #include "utils.h"
 namespace torch_ipex {
 namespace tpp {
@@ -158,6 +165,151 @@ class GlobalPass {
   double start;
 };
 
+// Hierarchical latency histograms. Unlike the PROFILE_TPP timers above,
+// which accumulate global totals per kernel type, these record the full
+// distribution of wall time per nested scope path (e.g.
+// "request/layer3/qkv_gemm") so tail latency can be attributed without
+// an external profiler. Accumulation is per-thread with no locking on
+// the hot path; a global lock is only taken once per thread to register
+// its state and by snapshot/reset. Collection is off by default and
+// driven from Python via _tpp_hist_* bindings, or from C++ with
+// TPP_HIST_SCOPE.
+constexpr int HIST_NUM_BUCKETS = 44; // log2(ns) buckets, covers > 4 hours
+
+struct ScopeHistogram {
+  uint64_t count = 0;
+  double total = 0.0; // seconds
+  uint64_t buckets[HIST_NUM_BUCKETS] = {0};
+  void add(double secs) {
+    count++;
+    total += secs;
+    auto ns = (uint64_t)(secs * 1e9);
+    int b = 0;
+    while ((ns >> (b + 1)) != 0 && b < HIST_NUM_BUCKETS - 1)
+      b++;
+    buckets[b]++;
+  }
+  void merge(const ScopeHistogram& other) {
+    count += other.count;
+    total += other.total;
+    for (int i = 0; i < HIST_NUM_BUCKETS; i++)
+      buckets[i] += other.buckets[i];
+  }
+  // Approximate percentile (0..100) as the upper bound of the bucket
+  // holding the requested rank, in seconds.
+  double percentile(double pct) const {
+    if (count == 0)
+      return 0.0;
+    // Nearest-rank percentile: the smallest bucket whose cumulative
+    // count reaches ceil(pct/100 * count) samples.
+    auto rank = (uint64_t)std::ceil(pct / 100.0 * count);
+    if (rank == 0)
+      rank = 1;
+    uint64_t seen = 0;
+    for (int i = 0; i < HIST_NUM_BUCKETS; i++) {
+      seen += buckets[i];
+      if (seen >= rank)
+        return (double)(2ULL << i) * 1e-9;
+    }
+    return (double)(2ULL << (HIST_NUM_BUCKETS - 1)) * 1e-9;
+  }
+};
+
+struct HistThreadState {
+  std::unordered_map<std::string, ScopeHistogram> hists;
+  // (parent path length, start time) per open scope.
+  std::vector<std::pair<size_t, double>> stack;
+  std::string path;
+};
+
+inline std::mutex& hist_mutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+inline std::vector<HistThreadState*>& hist_thread_states() {
+  static std::vector<HistThreadState*> states;
+  return states;
+}
+
+inline HistThreadState& hist_local_state() {
+  static thread_local HistThreadState* state = []() {
+    auto* s = new HistThreadState();
+    std::lock_guard<std::mutex> lock(hist_mutex());
+    hist_thread_states().push_back(s);
+    return s;
+  }();
+  return *state;
+}
+
+inline std::atomic<bool>& hist_enabled_flag() {
+  static std::atomic<bool> enabled{false};
+  return enabled;
+}
+
+inline bool hist_enabled() {
+  return hist_enabled_flag().load(std::memory_order_relaxed);
+}
+
+inline void hist_set_enabled(bool enabled) {
+  hist_enabled_flag().store(enabled, std::memory_order_relaxed);
+}
+
+inline void hist_scope_enter(const std::string& name) {
+  if (!hist_enabled())
+    return;
+  auto& state = hist_local_state();
+  state.stack.emplace_back(state.path.size(), getTime());
+  if (!state.path.empty())
+    state.path += "/";
+  state.path += name;
+}
+
+inline void hist_scope_exit() {
+  if (!hist_enabled())
+    return;
+  auto& state = hist_local_state();
+  if (state.stack.empty())
+    return;
+  auto secs = getTime() - state.stack.back().second;
+  state.hists[state.path].add(secs);
+  state.path.resize(state.stack.back().first);
+  state.stack.pop_back();
+}
+
+inline void hist_reset() {
+  std::lock_guard<std::mutex> lock(hist_mutex());
+  for (auto* state : hist_thread_states())
+    state->hists.clear();
+}
+
+// Merged view across threads. Counts may lag scopes still being recorded
+// on other threads; good enough for telemetry.
+inline std::vector<std::pair<std::string, ScopeHistogram>> hist_snapshot() {
+  std::unordered_map<std::string, ScopeHistogram> merged;
+  {
+    std::lock_guard<std::mutex> lock(hist_mutex());
+    for (auto* state : hist_thread_states()) {
+      for (auto& kv : state->hists)
+        merged[kv.first].merge(kv.second);
+    }
+  }
+  return std::vector<std::pair<std::string, ScopeHistogram>>(
+      merged.begin(), merged.end());
+}
+
+class HistScope {
+ public:
+  HistScope(const std::string& name) {
+    hist_scope_enter(name);
+  }
+  ~HistScope() {
+    hist_scope_exit();
+  }
+};
+
+#define TPP_HIST_SCOPE(name) torch_ipex::tpp::HistScope hist_scope_(name)
+
 #ifdef DEBUG_TRACE_TPP
 static thread_local std::string prev_class_name = "";
 #endif
@@ -28,6 +28,9 @@ struct VecOps {
   static VT set_nf4_lut() {
     TLA_ASSERT(false, "should not reach here");
   }
+  static VT set_fp4_lut() {
+    TLA_ASSERT(false, "should not reach here");
+  }
   static VT mul() {
     TLA_ASSERT(false, "should not reach here");
   }
@@ -99,6 +102,25 @@ struct VecOps<__m512> {
         -0.6961928009986877,
         -1.0f);
   }
+  static inline __m512 set_fp4_lut() {
+    return _mm512_set_ps(
+        -1.0f,
+        -0.6666666666666666,
+        -0.5f,
+        -0.3333333333333333,
+        -0.25f,
+        -0.16666666666666666,
+        -0.08333333333333333,
+        -0.0f,
+        1.0f,
+        0.6666666666666666,
+        0.5f,
+        0.3333333333333333,
+        0.25f,
+        0.16666666666666666,
+        0.08333333333333333,
+        0.0f);
+  }
 };
 
 template <>
@@ -201,6 +223,41 @@ struct VecOps<__m512h> {
         -0.6961928009986877,
         -1.0f);
   }
+  static inline __m512h set_fp4_lut() {
+    return _mm512_set_ph(
+        -1.0f,
+        -0.6666666666666666,
+        -0.5f,
+        -0.3333333333333333,
+        -0.25f,
+        -0.16666666666666666,
+        -0.08333333333333333,
+        -0.0f,
+        1.0f,
+        0.6666666666666666,
+        0.5f,
+        0.3333333333333333,
+        0.25f,
+        0.16666666666666666,
+        0.08333333333333333,
+        0.0f,
+        -1.0f,
+        -0.6666666666666666,
+        -0.5f,
+        -0.3333333333333333,
+        -0.25f,
+        -0.16666666666666666,
+        -0.08333333333333333,
+        -0.0f,
+        1.0f,
+        0.6666666666666666,
+        0.5f,
+        0.3333333333333333,
+        0.25f,
+        0.16666666666666666,
+        0.08333333333333333,
+        0.0f);
+  }
 };
 
 template <>
@@ -9,6 +9,7 @@
 #include <libxsmm_intrinsics_x86.h>
 #include <string>
 #include <unordered_map>
+#include "utils/math_precision.h"
 
 namespace torch_ipex {
 namespace tpp {
@@ -2145,6 +2146,18 @@ class GeluFwdTPP {
   }
   void ref(Tin* in, Tout* out) {
 #ifdef __AVX512F__
+    // The minimax approximation is the tuned default (MEDIUM/LOW); a
+    // HIGH precision scope forces the full-precision erff form at
+    // scalar speed.
+    if (get_math_precision() == MathPrecisionClass::HIGH) {
+      for (int j = 0; j < M; j++) {
+        for (int i = 0; i < N; i++) {
+          float x = in[j * ldi + i];
+          out[j * ldo + i] = (erff(x / sqrtf(2.0)) + 1.0) * 0.5 * x;
+        }
+      }
+      return;
+    }
     for (int j = 0; j < M; j++) {
       int i;
       for (i = 0; i < ALIGNDOWN(N, 16); i += 16) {
@@ -1,5 +1,11 @@
 #include "SysUtil.h"
 
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#include <stdint.h>
+
 void* ipex_alloc_aligned(size_t nbytes, size_t alignment) {
 #ifdef _WIN32
   return _aligned_malloc(nbytes, alignment);
@@ -16,4 +22,59 @@ void ipex_free_aligned(void* data) {
 #else
   free(data);
 #endif
-}
\ No newline at end of file
+}
+
+// 2M transparent huge page helpers. Large long-lived allocations (packed
+// weights, KV caches) backed by 4K pages burn dTLB entries during decode;
+// advising the kernel to collapse them into 2M pages lets the weight
+// working set fit in a few hundred TLB entries. Opt-in via
+// IPEX_THP_ALLOC=1 or the Python-side switch.
+static const size_t kHugePageSize = 2 * 1024 * 1024;
+
+static bool thp_alloc_enabled = []() {
+  const char* env = getenv("IPEX_THP_ALLOC");
+  return env != NULL && atoi(env) > 0;
+}();
+
+bool ipex_thp_alloc_enabled() {
+  return thp_alloc_enabled;
+}
+
+void ipex_set_thp_alloc_enabled(bool enabled) {
+  thp_alloc_enabled = enabled;
+}
+
+void* ipex_alloc_thp(size_t nbytes) {
+#ifdef _WIN32
+  return NULL;
+#else
+  size_t len = (nbytes + kHugePageSize - 1) & ~(kHugePageSize - 1);
+  void* p_ptr = mmap(
+      NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (p_ptr == MAP_FAILED)
+    return NULL;
+#ifdef MADV_HUGEPAGE
+  madvise(p_ptr, len, MADV_HUGEPAGE);
+#endif
+  return p_ptr;
+#endif
+}
+
+void ipex_free_thp(void* data, size_t nbytes) {
+#ifndef _WIN32
+  size_t len = (nbytes + kHugePageSize - 1) & ~(kHugePageSize - 1);
+  munmap(data, len);
+#endif
+}
+
+void ipex_madvise_hugepage(void* data, size_t nbytes) {
+#if !defined(_WIN32) && defined(MADV_HUGEPAGE)
+  // madvise wants page-aligned addresses and khugepaged only collapses
+  // fully covered 2M-aligned ranges, so shrink to the contained ones.
+  uintptr_t begin =
+      ((uintptr_t)data + kHugePageSize - 1) & ~(kHugePageSize - 1);
+  uintptr_t end = ((uintptr_t)data + nbytes) & ~(kHugePageSize - 1);
+  if (end > begin)
+    madvise((void*)begin, end - begin, MADV_HUGEPAGE);
+#endif
+}
@@ -9,4 +9,16 @@
 #endif
 
 void* ipex_alloc_aligned(size_t nbytes, size_t alignment);
-void ipex_free_aligned(void* data);
\ No newline at end of file
+void ipex_free_aligned(void* data);
+
+// Transparent huge page (2M) support for large long-lived allocations
+// such as packed weights and KV caches. ipex_alloc_thp returns a fresh
+// MADV_HUGEPAGE mapping (NULL on failure/unsupported platforms) and must
+// be released with ipex_free_thp using the same size.
+// ipex_madvise_hugepage advises an existing allocation in place so
+// khugepaged can collapse its 2M-aligned interior into huge pages.
+bool ipex_thp_alloc_enabled();
+void ipex_set_thp_alloc_enabled(bool enabled);
+void* ipex_alloc_thp(size_t nbytes);
+void ipex_free_thp(void* data, size_t nbytes);
+void ipex_madvise_hugepage(void* data, size_t nbytes);
\ No newline at end of file
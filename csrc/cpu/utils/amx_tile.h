@@ -0,0 +1,87 @@
+#pragma once
+
+#if defined(CPU_CAPABILITY_AMX)
+
+#include <immintrin.h>
+
+#include <cstdint>
+#include <cstring>
+
+namespace torch_ipex {
+namespace cpu {
+
+// The 64-byte XTILECFG payload consumed by ldtilecfg. Field layout follows
+// the SDM; zero-initialize and fill palette_id/rows/colb before loading.
+struct alignas(64) TileConfig {
+  uint8_t palette_id;
+  uint8_t startRow;
+  uint8_t reserved[14];
+  uint16_t colb[16];
+  uint8_t rows[16];
+
+  bool operator==(const TileConfig& other) const {
+    return std::memcmp(this, &other, sizeof(TileConfig)) == 0;
+  }
+  bool operator!=(const TileConfig& other) const {
+    return !(*this == other);
+  }
+};
+
+static_assert(sizeof(TileConfig) == 64, "XTILECFG payload must be 64 bytes");
+
+namespace detail {
+struct TileConfigCache {
+  TileConfig config;
+  bool valid = false;
+};
+
+inline TileConfigCache& tile_config_cache() {
+  thread_local TileConfigCache cache;
+  return cache;
+}
+} // namespace detail
+
+// Forget what this thread has loaded. Must be called whenever code outside
+// the caller's control (oneDNN, libxsmm, ...) may have reconfigured or
+// released the tiles, so the next load_tile_config_cached() reloads.
+inline void invalidate_tile_config_cache() {
+  detail::tile_config_cache().valid = false;
+}
+
+// Loads the tile configuration, skipping the ldtilecfg when the requested
+// configuration is the one already active on this thread. Reconfiguring is
+// not free, and in loops issuing thousands of small tile GEMMs per token the
+// redundant reloads are measurable. Only valid between the cache
+// invalidations issued by TileConfigRegion (or manual
+// invalidate_tile_config_cache() calls); outside of such a region the active
+// configuration is unknown.
+inline void load_tile_config_cached(const TileConfig& config) {
+  auto& cache = detail::tile_config_cache();
+  if (cache.valid && cache.config == config) {
+    return;
+  }
+  _tile_loadconfig(&config);
+  cache.config = config;
+  cache.valid = true;
+}
+
+// Marks a region whose AMX usage is exclusively driven through
+// load_tile_config_cached(), e.g. the body of one parallel_for task. The
+// cache is invalidated on entry (a foreign kernel may have left its own
+// configuration behind) and on exit (so later cached loads do not trust a
+// configuration this region may no longer own).
+struct TileConfigRegion {
+  TileConfigRegion() {
+    invalidate_tile_config_cache();
+  }
+  ~TileConfigRegion() {
+    invalidate_tile_config_cache();
+  }
+  TileConfigRegion(const TileConfigRegion&) = delete;
+  TileConfigRegion& operator=(const TileConfigRegion&) = delete;
+};
+
+} // namespace cpu
+} // namespace torch_ipex
+
+#endif // CPU_CAPABILITY_AMX
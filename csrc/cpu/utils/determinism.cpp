@@ -0,0 +1,28 @@
+#include "determinism.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+namespace torch_ipex {
+
+namespace {
+
+std::atomic<bool> deterministic_reductions{[]() {
+  static char* val = getenv("IPEX_DETERMINISTIC_REDUCTIONS");
+  return val != NULL &&
+      (strcmp(val, "1") == 0 || strcmp(val, "ON") == 0 ||
+       strcmp(val, "on") == 0);
+}()};
+
+} // anonymous namespace
+
+bool isDeterministicReductionsEnabled() {
+  return deterministic_reductions.load(std::memory_order_relaxed);
+}
+
+void setDeterministicReductions(bool enabled) {
+  deterministic_reductions.store(enabled, std::memory_order_relaxed);
+}
+
+} // namespace torch_ipex
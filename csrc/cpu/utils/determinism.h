@@ -0,0 +1,21 @@
+#pragma once
+
+#include <Macros.h>
+
+namespace torch_ipex {
+
+// Run-to-run deterministic parallel reductions. When enabled, the
+// reduction-bearing kernels switch to static chunk assignment and
+// fixed-shape pairwise combination trees whose layout depends only on the
+// input length — not on thread count, scheduling, or buffer alignment —
+// so identical requests produce bitwise-identical results at full
+// parallelism. Kernels without a deterministic variant fall back to their
+// statically partitioned path.
+//
+// Defaults to off; `IPEX_DETERMINISTIC_REDUCTIONS=1` enables it at
+// process start, and the frontend can flip it at runtime.
+IPEX_API bool isDeterministicReductionsEnabled();
+
+IPEX_API void setDeterministicReductions(bool enabled);
+
+} // namespace torch_ipex
@@ -2,6 +2,7 @@
 #include <ideep.hpp>
 #include <exception>
 #include <iostream>
+#include <vector>
 #include "csrc/cpu/ideep/IDeepConversions.h"
 
 namespace torch_ipex {
@@ -40,4 +41,61 @@ FP32MathMode getFP32MathModeCpu() {
   }
 }
 
+namespace {
+
+struct FpMathPolicy {
+  dnnl_fpmath_mode_t modes[4];
+};
+
+// Scoped policies are consulted on the thread that runs the oneDNN
+// primitive, so the stack is thread-local like the frontend usage
+// (wrapping a forward call) expects.
+thread_local std::vector<FpMathPolicy> fpmath_policy_stack;
+
+dnnl_fpmath_mode_t to_dnnl_fpmath_mode(FP32MathMode m) {
+  // CPU supports strict and BF16 math only; TF32 falls back to strict,
+  // matching setFP32MathModeCpu.
+  return m == FP32MathMode::BF32 ? dnnl_fpmath_mode_bf16
+                                 : dnnl_fpmath_mode_strict;
+}
+
+} // namespace
+
+void pushFP32MathModePolicyCpu(
+    FP32MathMode conv_mode,
+    FP32MathMode linear_mode,
+    FP32MathMode matmul_mode,
+    FP32MathMode rnn_mode) {
+  FpMathPolicy policy;
+  policy.modes[FpMathOpCategory::CONV] = to_dnnl_fpmath_mode(conv_mode);
+  policy.modes[FpMathOpCategory::LINEAR] = to_dnnl_fpmath_mode(linear_mode);
+  policy.modes[FpMathOpCategory::MATMUL] = to_dnnl_fpmath_mode(matmul_mode);
+  policy.modes[FpMathOpCategory::RNN] = to_dnnl_fpmath_mode(rnn_mode);
+  fpmath_policy_stack.push_back(policy);
+}
+
+void popFP32MathModePolicyCpu() {
+  if (fpmath_policy_stack.empty()) {
+    throw std::runtime_error(
+        "popFP32MathModePolicyCpu: no active fpmath policy scope on this thread.");
+  }
+  fpmath_policy_stack.pop_back();
+}
+
+dnnl_fpmath_mode_t get_fpmath_mode(FpMathOpCategory category) {
+  if (!fpmath_policy_stack.empty()) {
+    return fpmath_policy_stack.back().modes[category];
+  }
+  return torch_ipex::fpmath_mode;
+}
+
+FP32MathMode getFP32MathModePolicyCpu(FpMathOpCategory category) {
+  switch (get_fpmath_mode(category)) {
+    case dnnl_fpmath_mode_bf16:
+      return FP32MathMode::BF32;
+    default:
+      return FP32MathMode::FP32;
+  }
+}
+
 } // namespace torch_ipex
@@ -5,8 +5,35 @@ namespace torch_ipex {
 
 enum IPEX_API FP32MathMode : int { FP32 = 0, TF32 = 1, BF32 = 2 };
 
+// Op categories the scoped fpmath policy can target separately. The
+// global mode set by setFP32MathModeCpu stays all-or-nothing; a pushed
+// policy overrides it per category for the pushing thread, so e.g. a
+// feature extractor can run BF16-math FP32 while the logit head stays
+// strict.
+enum IPEX_API FpMathOpCategory : int {
+  CONV = 0,
+  LINEAR = 1,
+  MATMUL = 2,
+  RNN = 3,
+};
+
 IPEX_API void setFP32MathModeCpu(FP32MathMode mode = FP32MathMode::FP32);
 
 IPEX_API FP32MathMode getFP32MathModeCpu();
 
+// Push/pop a thread-local per-category policy scope. Scopes nest; the
+// innermost one wins. Intended to wrap module forwards from the
+// frontend (ipex.fp32_math_mode_scope).
+IPEX_API void pushFP32MathModePolicyCpu(
+    FP32MathMode conv_mode,
+    FP32MathMode linear_mode,
+    FP32MathMode matmul_mode,
+    FP32MathMode rnn_mode);
+
+IPEX_API void popFP32MathModePolicyCpu();
+
+// Effective mode for one category: the innermost active policy on this
+// thread, or the global mode when no scope is active.
+IPEX_API FP32MathMode getFP32MathModePolicyCpu(FpMathOpCategory category);
+
 } // namespace torch_ipex
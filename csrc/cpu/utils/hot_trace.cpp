@@ -0,0 +1,168 @@
+#include "hot_trace.h"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(_M_X64)
+#include <x86intrin.h>
+#endif
+
+namespace torch_ipex {
+namespace utils {
+namespace hot_trace {
+
+namespace detail {
+
+std::atomic<bool> g_enabled{false};
+
+uint64_t now() {
+#if defined(__x86_64__) || defined(_M_X64)
+  return __rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#endif
+}
+
+namespace {
+
+struct Event {
+  uint64_t start;
+  uint64_t end;
+  const char* name;
+};
+
+constexpr uint64_t kRingCapacity = 1 << 15;
+
+struct ThreadBuffer {
+  std::vector<Event> events{kRingCapacity};
+  uint64_t head{0};
+  int tid{0};
+};
+
+struct Registry {
+  std::mutex mutex;
+  // shared_ptr keeps the events alive for export after a thread exits
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  // calibration sample: {tsc, wall-clock us} taken at enable() so the
+  // exporter can convert TSC ticks to microseconds
+  uint64_t tsc_base{0};
+  double wall_base_us{0};
+};
+
+Registry& registry() {
+  static Registry r;
+  return r;
+}
+
+double wall_us() {
+  return std::chrono::duration_cast<std::chrono::duration<double, std::micro>>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+ThreadBuffer& thread_buffer() {
+  thread_local std::shared_ptr<ThreadBuffer> buffer = [] {
+    auto b = std::make_shared<ThreadBuffer>();
+    auto& r = registry();
+    std::lock_guard<std::mutex> guard(r.mutex);
+    b->tid = static_cast<int>(r.buffers.size());
+    r.buffers.push_back(b);
+    return b;
+  }();
+  return *buffer;
+}
+
+} // namespace
+
+void record(const char* name, uint64_t start, uint64_t end) {
+  if (!g_enabled.load(std::memory_order_relaxed)) {
+    return;
+  }
+  auto& buffer = thread_buffer();
+  buffer.events[buffer.head % kRingCapacity] = {start, end, name};
+  buffer.head++;
+}
+
+} // namespace detail
+
+void enable(bool enabled) {
+  if (enabled) {
+    reset();
+    auto& r = detail::registry();
+    std::lock_guard<std::mutex> guard(r.mutex);
+    r.tsc_base = detail::now();
+    r.wall_base_us = detail::wall_us();
+  }
+  detail::g_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool is_enabled() {
+  return detail::g_enabled.load(std::memory_order_relaxed);
+}
+
+void reset() {
+  auto& r = detail::registry();
+  std::lock_guard<std::mutex> guard(r.mutex);
+  for (auto& buffer : r.buffers) {
+    buffer->head = 0;
+  }
+}
+
+uint64_t dropped_events() {
+  auto& r = detail::registry();
+  std::lock_guard<std::mutex> guard(r.mutex);
+  uint64_t dropped = 0;
+  for (auto& buffer : r.buffers) {
+    if (buffer->head > detail::kRingCapacity) {
+      dropped += buffer->head - detail::kRingCapacity;
+    }
+  }
+  return dropped;
+}
+
+std::string dump_chrome_trace() {
+  auto& r = detail::registry();
+  std::lock_guard<std::mutex> guard(r.mutex);
+  // second calibration sample; ticks-per-us between the two samples gives
+  // the conversion factor for every recorded TSC stamp
+  auto tsc_now = detail::now();
+  auto wall_now_us = detail::wall_us();
+  double ticks_per_us = tsc_now > r.tsc_base
+      ? static_cast<double>(tsc_now - r.tsc_base) /
+          (wall_now_us - r.wall_base_us)
+      : 1.0;
+  std::ostringstream oss;
+  oss << "{\"traceEvents\":[";
+  bool first = true;
+  for (auto& buffer : r.buffers) {
+    uint64_t begin = buffer->head > detail::kRingCapacity
+        ? buffer->head - detail::kRingCapacity
+        : 0;
+    for (uint64_t i = begin; i < buffer->head; i++) {
+      const auto& event = buffer->events[i % detail::kRingCapacity];
+      double ts =
+          static_cast<double>(event.start - r.tsc_base) / ticks_per_us;
+      double dur = static_cast<double>(event.end - event.start) / ticks_per_us;
+      if (!first) {
+        oss << ",";
+      }
+      first = false;
+      oss << "{\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer->tid
+          << ",\"name\":\"" << event.name << "\",\"ts\":" << ts
+          << ",\"dur\":" << dur << "}";
+    }
+  }
+  oss << "]}";
+  return oss.str();
+}
+
+} // namespace hot_trace
+} // namespace utils
+} // namespace torch_ipex
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <Macros.h>
+#include <c10/macros/Macros.h>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Low-overhead hot-path event tracing: per-thread ring buffers of
+// TSC-stamped spans, exported as chrome://tracing JSON. Designed so that
+// instrumentation points cost one relaxed atomic load when tracing is off
+// and two TSC reads plus a ring-buffer store when on - cheap enough to
+// leave in task queues and kernel hot paths where attaching an external
+// profiler would perturb the very timing being debugged. Define
+// IPEX_DISABLE_HOT_TRACE to compile the instrumentation out entirely.
+
+namespace torch_ipex {
+namespace utils {
+namespace hot_trace {
+
+namespace detail {
+
+extern std::atomic<bool> g_enabled;
+
+uint64_t now();
+void record(const char* name, uint64_t start, uint64_t end);
+
+} // namespace detail
+
+// Enables/disables collection. Enabling resets the buffers and takes the
+// TSC/wall-clock calibration sample used by the exporter.
+IPEX_API void enable(bool enabled);
+IPEX_API bool is_enabled();
+IPEX_API void reset();
+// Number of events overwritten because a thread's ring wrapped.
+IPEX_API uint64_t dropped_events();
+// Serializes all recorded events as a chrome://tracing JSON document.
+IPEX_API std::string dump_chrome_trace();
+
+// RAII span. The name must be a string literal (it is stored by pointer).
+class Scope {
+ public:
+  explicit Scope(const char* name) {
+#ifndef IPEX_DISABLE_HOT_TRACE
+    if (C10_UNLIKELY(detail::g_enabled.load(std::memory_order_relaxed))) {
+      name_ = name;
+      start_ = detail::now();
+    }
+#endif
+  }
+  ~Scope() {
+#ifndef IPEX_DISABLE_HOT_TRACE
+    if (C10_UNLIKELY(name_ != nullptr)) {
+      detail::record(name_, start_, detail::now());
+    }
+#endif
+  }
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+
+ private:
+  const char* name_ = nullptr;
+  uint64_t start_ = 0;
+};
+
+} // namespace hot_trace
+} // namespace utils
+} // namespace torch_ipex
+
+#define IPEX_HOT_TRACE_SCOPE(name) \
+  torch_ipex::utils::hot_trace::Scope _ipex_hot_trace_scope_(name)
@@ -0,0 +1,89 @@
+#include "io_tensor.h"
+
+#include <ATen/Functions.h>
+#include <c10/util/Exception.h>
+
+#include <cstdint>
+
+namespace torch_ipex {
+namespace utils {
+
+namespace {
+
+constexpr size_t kAlignment = 64;
+
+bool is_aligned(const void* ptr) {
+  return reinterpret_cast<uintptr_t>(ptr) % kAlignment == 0;
+}
+
+} // namespace
+
+at::Tensor wrap_buffer(
+    void* data,
+    at::IntArrayRef sizes,
+    at::ScalarType dtype,
+    std::function<void(void*)> deleter) {
+  TORCH_CHECK(data != nullptr, "wrap_buffer: data must not be null");
+  TORCH_CHECK(
+      is_aligned(data),
+      "wrap_buffer: data must be 64-byte aligned, got ",
+      data);
+  auto options = at::TensorOptions().dtype(dtype).device(at::kCPU);
+  if (deleter) {
+    return at::from_blob(data, sizes, std::move(deleter), options);
+  }
+  return at::from_blob(data, sizes, options);
+}
+
+OutputArena::OutputArena(void* data, size_t bytes)
+    : base_(static_cast<char*>(data)), bytes_(bytes), offset_(0) {
+  TORCH_CHECK(data != nullptr, "OutputArena: data must not be null");
+  TORCH_CHECK(
+      is_aligned(data),
+      "OutputArena: data must be 64-byte aligned, got ",
+      data);
+}
+
+at::Tensor OutputArena::allocate(at::IntArrayRef sizes, at::ScalarType dtype) {
+  int64_t numel = 1;
+  for (auto size : sizes) {
+    TORCH_CHECK(size >= 0, "OutputArena: negative dimension ", size);
+    numel *= size;
+  }
+  size_t nbytes = static_cast<size_t>(numel) * at::elementSize(dtype);
+  // Every allocation starts on its own cache line.
+  size_t aligned_offset = (offset_ + kAlignment - 1) / kAlignment * kAlignment;
+  TORCH_CHECK(
+      aligned_offset + nbytes <= bytes_,
+      "OutputArena: out of space; capacity ",
+      bytes_,
+      " bytes, used ",
+      offset_,
+      " bytes, requested ",
+      nbytes,
+      " bytes");
+  offset_ = aligned_offset + nbytes;
+  auto options = at::TensorOptions().dtype(dtype).device(at::kCPU);
+  return at::from_blob(base_ + aligned_offset, sizes, options);
+}
+
+at::Tensor OutputArena::emit(const at::Tensor& src) {
+  auto dst = allocate(src.sizes(), src.scalar_type());
+  dst.copy_(src);
+  return dst;
+}
+
+void OutputArena::reset() {
+  offset_ = 0;
+}
+
+size_t OutputArena::used() const {
+  return offset_;
+}
+
+size_t OutputArena::capacity() const {
+  return bytes_;
+}
+
+} // namespace utils
+} // namespace torch_ipex
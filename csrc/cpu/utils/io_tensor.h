@@ -0,0 +1,73 @@
+#pragma once
+
+#include <ATen/Tensor.h>
+#include <Macros.h>
+
+#include <cstddef>
+#include <functional>
+
+namespace torch_ipex {
+namespace utils {
+
+// Zero-copy I/O tensors for C++ serving (the example-app/gRPC style
+// deployment): wrap caller-owned input buffers as tensors and emit model
+// outputs into caller-provided arenas, so a request does not pay a
+// memcpy on the way in and another on the way out.
+//
+//   alignas(64) char request_blob[4 << 20];
+//   auto input = torch_ipex::utils::wrap_buffer(
+//       request_blob, {1, 1024, 1024}, at::kFloat);
+//   torch_ipex::utils::OutputArena arena(response_blob, response_bytes);
+//   auto output = arena.emit(module.forward({input}).toTensor());
+//   // output's storage is response_blob; serialize it directly.
+
+// Wraps a caller-owned buffer as a contiguous CPU tensor without
+// copying. `data` must be 64-byte aligned (enforced) so downstream
+// vectorized kernels take their aligned paths and no cache line is
+// split across the buffer boundary.
+//
+// Lifetime contract: the buffer must stay valid until the returned
+// tensor and every view or alias derived from it are destroyed. When a
+// `deleter` is supplied it is called with `data` once the last alias
+// drops; without one the caller manages the buffer and must outlive the
+// tensor by other means (e.g. a per-request arena freed after the
+// response is serialized).
+IPEX_API at::Tensor wrap_buffer(
+    void* data,
+    at::IntArrayRef sizes,
+    at::ScalarType dtype,
+    std::function<void(void*)> deleter = {});
+
+// Bump allocator over a caller-owned buffer for model outputs. Tensors
+// allocated from the arena alias the buffer directly; `emit` copies a
+// model output into the arena in one pass, which is the single copy a
+// serving stack cannot avoid (the graph owns its output storage).
+//
+// The arena is not thread safe and, like wrap_buffer, the buffer must
+// outlive every tensor handed out. reset() recycles the arena for the
+// next request once those tensors are dropped.
+class IPEX_API OutputArena {
+ public:
+  // `data` must be 64-byte aligned; `bytes` is the arena capacity.
+  OutputArena(void* data, size_t bytes);
+
+  // Returns an uninitialized tensor of the given shape backed by the
+  // arena. Throws if the arena cannot fit it.
+  at::Tensor allocate(at::IntArrayRef sizes, at::ScalarType dtype);
+
+  // Copies `src` (any layout) into a freshly allocated contiguous
+  // tensor in the arena and returns it.
+  at::Tensor emit(const at::Tensor& src);
+
+  void reset();
+  size_t used() const;
+  size_t capacity() const;
+
+ private:
+  char* base_;
+  size_t bytes_;
+  size_t offset_;
+};
+
+} // namespace utils
+} // namespace torch_ipex
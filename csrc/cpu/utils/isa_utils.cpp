@@ -36,5 +36,9 @@ bool isa_has_avx2_support() {
   return cpu::CPUFeature::get_instance().isa_level_avx2();
 }
 
+bool is_hybrid_cpu() {
+  return cpu::CPUFeature::get_instance().cpuid_hybrid();
+}
+
 } // namespace utils
 } // namespace torch_ipex
@@ -12,6 +12,7 @@ IPEX_API bool isa_has_avx512_vnni_support();
 IPEX_API bool isa_has_avx512_support();
 IPEX_API bool isa_has_avx2_vnni_support();
 IPEX_API bool isa_has_avx2_support();
+IPEX_API bool is_hybrid_cpu();
 
 } // namespace utils
 } // namespace torch_ipex
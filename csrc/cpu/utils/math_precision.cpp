@@ -0,0 +1,59 @@
+#include "math_precision.h"
+#include <atomic>
+#include <cstdlib>
+#include <exception>
+#include <string>
+#include <vector>
+
+namespace torch_ipex {
+
+namespace {
+
+std::atomic<int> global_math_precision{[]() {
+  int precision = MathPrecisionClass::MEDIUM;
+  char* val = std::getenv("IPEX_MATH_PRECISION");
+  if (val != NULL) {
+    std::string precision_str = val;
+    if (precision_str.compare("HIGH") == 0) {
+      precision = MathPrecisionClass::HIGH;
+    } else if (precision_str.compare("LOW") == 0) {
+      precision = MathPrecisionClass::LOW;
+    }
+  }
+  return precision;
+}()};
+
+// Scoped classes are consulted on the thread that launches the kernel,
+// so the stack is thread-local like the fpmath policy scope.
+thread_local std::vector<MathPrecisionClass> math_precision_stack;
+
+} // namespace
+
+void setMathPrecisionClassCpu(MathPrecisionClass precision) {
+  global_math_precision = precision;
+}
+
+MathPrecisionClass getMathPrecisionClassCpu() {
+  return static_cast<MathPrecisionClass>(global_math_precision.load());
+}
+
+void pushMathPrecisionClassCpu(MathPrecisionClass precision) {
+  math_precision_stack.push_back(precision);
+}
+
+void popMathPrecisionClassCpu() {
+  if (math_precision_stack.empty()) {
+    throw std::runtime_error(
+        "popMathPrecisionClassCpu: no active math precision scope on this thread.");
+  }
+  math_precision_stack.pop_back();
+}
+
+MathPrecisionClass get_math_precision() {
+  if (!math_precision_stack.empty()) {
+    return math_precision_stack.back();
+  }
+  return getMathPrecisionClassCpu();
+}
+
+} // namespace torch_ipex
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <Macros.h>
+
+namespace torch_ipex {
+
+// Precision class for transcendental math in the hand-written activation
+// kernels (tanh/sigmoid in the eltwise chain, the TPP GELU reference
+// path). Each kernel maps the class onto the implementations it has:
+//
+//  * HIGH   -- full-precision routines everywhere, even where the kernel
+//              normally prefers a tuned approximation.
+//  * MEDIUM -- the kernel's tuned default; at most a few ulp looser than
+//              HIGH where a faster variant exists, identical otherwise.
+//  * LOW    -- the fastest available approximation (absolute error up to
+//              ~1e-3), for inference paths that tolerate it.
+//
+// MEDIUM is the process default, so current numerics are unchanged until
+// a user opts in via set_math_precision / the scope API / the
+// IPEX_MATH_PRECISION environment variable.
+enum IPEX_API MathPrecisionClass : int { HIGH = 0, MEDIUM = 1, LOW = 2 };
+
+IPEX_API void setMathPrecisionClassCpu(MathPrecisionClass precision);
+
+IPEX_API MathPrecisionClass getMathPrecisionClassCpu();
+
+// Push/pop a thread-local precision scope. Scopes nest; the innermost
+// one wins over the global setting. Intended to wrap module forwards
+// from the frontend so one submodule can run looser math than the rest.
+IPEX_API void pushMathPrecisionClassCpu(MathPrecisionClass precision);
+
+IPEX_API void popMathPrecisionClassCpu();
+
+// Effective class for the calling thread: the innermost active scope,
+// or the global setting when no scope is active. Kernels resolve this
+// once per op on the launching thread, not inside parallel regions.
+IPEX_API MathPrecisionClass get_math_precision();
+
+} // namespace torch_ipex
@@ -1,10 +1,175 @@
 #include "onednn_utils.h"
 
+#include <c10/core/Allocator.h>
+#include <c10/util/Exception.h>
 #include <ideep.hpp>
 
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
 namespace torch_ipex {
 namespace utils {
 
+namespace {
+
+// Each arena block carries a 64-byte header so deallocate can recover the
+// block base and usable size without a global table; 64 bytes keeps the
+// payload at the alignment the CPU allocator already guarantees.
+constexpr size_t kArenaHeaderBytes = 64;
+constexpr uint64_t kArenaMagic = 0x4950455841524E41ULL; // "IPEXARNA"
+// Blocks above this size are returned to the allocator immediately; per
+// thread we keep at most a handful of blocks so idle threads do not pin
+// large amounts of scratch memory.
+constexpr size_t kArenaMaxCachedBlockBytes = 256 * 1024 * 1024;
+constexpr size_t kArenaMaxCachedBlocksPerThread = 4;
+
+struct ArenaBlockHeader {
+  uint64_t magic;
+  size_t size; // usable payload bytes
+};
+
+std::atomic<uint64_t> g_arena_hits{0};
+std::atomic<uint64_t> g_arena_misses{0};
+std::atomic<uint64_t> g_arena_hit_bytes{0};
+std::atomic<uint64_t> g_arena_miss_bytes{0};
+
+struct ArenaThreadCache {
+  struct Block {
+    void* base;
+    size_t size;
+  };
+  std::vector<Block> blocks;
+
+  ~ArenaThreadCache() {
+    for (auto& b : blocks) {
+      c10::GetAllocator(c10::DeviceType::CPU)->raw_deallocate(b.base);
+    }
+  }
+};
+
+thread_local ArenaThreadCache g_arena_cache;
+
+struct VerboseStat {
+  uint64_t count = 0;
+  double total_ms = 0.0;
+};
+
+struct VerboseAggState {
+  std::thread drainer;
+  int saved_stdout = -1;
+  bool active = false;
+  std::mutex mutex; // guards table; writer is the single drainer thread
+  std::unordered_map<std::string, VerboseStat> table;
+};
+
+VerboseAggState& verbose_agg_state() {
+  static VerboseAggState state;
+  return state;
+}
+
+// Parses one oneDNN verbose execution line. Both the v2 layout
+// (onednn_verbose,exec,cpu,kind,impl,...,shape,ms) and the v3 layout with
+// extra leading fields are handled by locating the "exec" marker; the
+// timing is always the last field and the problem descriptor the one
+// before it.
+bool parse_verbose_exec_line(
+    const std::string& line,
+    std::string& kind,
+    std::string& impl,
+    std::string& shape,
+    double& ms) {
+  constexpr const char kPrefix[] = "onednn_verbose,";
+  if (line.compare(0, sizeof(kPrefix) - 1, kPrefix) != 0) {
+    return false;
+  }
+  std::vector<std::string> fields;
+  size_t pos = 0;
+  while (pos <= line.size()) {
+    size_t next = line.find(',', pos);
+    if (next == std::string::npos) {
+      fields.push_back(line.substr(pos));
+      break;
+    }
+    fields.push_back(line.substr(pos, next - pos));
+    pos = next + 1;
+  }
+  size_t exec_idx = 0;
+  for (size_t i = 1; i < fields.size() && i <= 3; i++) {
+    if (fields[i] == "exec") {
+      exec_idx = i;
+      break;
+    }
+  }
+  if (exec_idx == 0 || fields.size() < exec_idx + 5) {
+    return false;
+  }
+  const std::string& time_field = fields.back();
+  char* end = nullptr;
+  ms = std::strtod(time_field.c_str(), &end);
+  if (end == time_field.c_str() || *end != '\0') {
+    return false;
+  }
+  kind = fields[exec_idx + 2];
+  impl = fields[exec_idx + 3];
+  shape = fields[fields.size() - 2];
+  return true;
+}
+
+#ifndef _WIN32
+void verbose_agg_record(
+    const std::string& kind,
+    const std::string& impl,
+    const std::string& shape,
+    double ms) {
+  auto& state = verbose_agg_state();
+  auto key = kind + '\x1f' + impl + '\x1f' + shape;
+  std::lock_guard<std::mutex> lock(state.mutex);
+  auto& stat = state.table[key];
+  stat.count++;
+  stat.total_ms += ms;
+}
+
+void verbose_agg_drain(int read_fd, int passthrough_fd) {
+  std::string pending;
+  char buf[4096];
+  ssize_t n;
+  while ((n = read(read_fd, buf, sizeof(buf))) > 0) {
+    pending.append(buf, (size_t)n);
+    size_t start = 0;
+    size_t eol;
+    while ((eol = pending.find('\n', start)) != std::string::npos) {
+      std::string line = pending.substr(start, eol - start);
+      start = eol + 1;
+      std::string kind, impl, shape;
+      double ms;
+      if (parse_verbose_exec_line(line, kind, impl, shape, ms)) {
+        verbose_agg_record(kind, impl, shape, ms);
+      } else {
+        // not a verbose execution line: hand it to the real stdout
+        line.push_back('\n');
+        auto rc = write(passthrough_fd, line.data(), line.size());
+        (void)rc;
+      }
+    }
+    pending.erase(0, start);
+  }
+  close(read_fd);
+}
+#endif
+
+} // namespace
+
 int onednn_set_verbose(int level) {
   return ideep::utils::set_verbose(level);
 }
@@ -41,5 +206,161 @@ bool onednn_has_fp8_type_support() {
   return true;
 }
 
+int onednn_get_primitive_cache_capacity() {
+  return dnnl::get_primitive_cache_capacity();
+}
+
+void onednn_set_primitive_cache_capacity(int capacity) {
+  dnnl::set_primitive_cache_capacity(capacity);
+}
+
+void onednn_clear_primitive_cache() {
+  // Dropping the capacity to zero evicts every cached primitive; restoring
+  // it leaves the configured capacity unchanged.
+  int capacity = dnnl::get_primitive_cache_capacity();
+  dnnl::set_primitive_cache_capacity(0);
+  dnnl::set_primitive_cache_capacity(capacity);
+}
+
+void* onednn_arena_allocate(size_t size) {
+  // Best fit among the few cached blocks; reject blocks that would waste
+  // more than 4x the request so one large burst does not get pinned to
+  // serve small allocations forever.
+  auto& blocks = g_arena_cache.blocks;
+  size_t best = blocks.size();
+  for (size_t i = 0; i < blocks.size(); i++) {
+    if (blocks[i].size >= size && blocks[i].size <= 4 * size &&
+        (best == blocks.size() || blocks[i].size < blocks[best].size)) {
+      best = i;
+    }
+  }
+  if (best != blocks.size()) {
+    void* base = blocks[best].base;
+    blocks[best] = blocks.back();
+    blocks.pop_back();
+    g_arena_hits.fetch_add(1, std::memory_order_relaxed);
+    g_arena_hit_bytes.fetch_add(size, std::memory_order_relaxed);
+    return (char*)base + kArenaHeaderBytes;
+  }
+
+  void* base = c10::GetAllocator(c10::DeviceType::CPU)
+                   ->raw_allocate(kArenaHeaderBytes + size);
+  ArenaBlockHeader header{kArenaMagic, size};
+  std::memcpy(base, &header, sizeof(header));
+  g_arena_misses.fetch_add(1, std::memory_order_relaxed);
+  g_arena_miss_bytes.fetch_add(size, std::memory_order_relaxed);
+  return (char*)base + kArenaHeaderBytes;
+}
+
+void onednn_arena_deallocate(void* p) {
+  if (p == nullptr) {
+    return;
+  }
+  void* base = (char*)p - kArenaHeaderBytes;
+  ArenaBlockHeader header;
+  std::memcpy(&header, base, sizeof(header));
+  TORCH_INTERNAL_ASSERT(
+      header.magic == kArenaMagic,
+      "onednn_arena_deallocate: unexpected block header");
+  auto& blocks = g_arena_cache.blocks;
+  if (header.size <= kArenaMaxCachedBlockBytes &&
+      blocks.size() < kArenaMaxCachedBlocksPerThread) {
+    blocks.push_back({base, header.size});
+    return;
+  }
+  c10::GetAllocator(c10::DeviceType::CPU)->raw_deallocate(base);
+}
+
+OnednnArenaStats onednn_arena_stats() {
+  return {
+      g_arena_hits.load(std::memory_order_relaxed),
+      g_arena_misses.load(std::memory_order_relaxed),
+      g_arena_hit_bytes.load(std::memory_order_relaxed),
+      g_arena_miss_bytes.load(std::memory_order_relaxed)};
+}
+
+void onednn_reset_arena_stats() {
+  g_arena_hits.store(0, std::memory_order_relaxed);
+  g_arena_misses.store(0, std::memory_order_relaxed);
+  g_arena_hit_bytes.store(0, std::memory_order_relaxed);
+  g_arena_miss_bytes.store(0, std::memory_order_relaxed);
+}
+
+bool onednn_verbose_aggregation_begin() {
+#ifdef _WIN32
+  return false;
+#else
+  auto& state = verbose_agg_state();
+  if (state.active) {
+    return false;
+  }
+  int pipe_fds[2];
+  if (pipe(pipe_fds) != 0) {
+    return false;
+  }
+  // Flush anything queued for the current stdout before swapping the fd,
+  // so earlier output is not replayed through the drainer.
+  fflush(stdout);
+  state.saved_stdout = dup(STDOUT_FILENO);
+  if (state.saved_stdout < 0 || dup2(pipe_fds[1], STDOUT_FILENO) < 0) {
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+    if (state.saved_stdout >= 0) {
+      close(state.saved_stdout);
+      state.saved_stdout = -1;
+    }
+    return false;
+  }
+  close(pipe_fds[1]);
+  state.drainer = std::thread(
+      verbose_agg_drain, pipe_fds[0], state.saved_stdout);
+  state.active = true;
+  ideep::utils::set_verbose(1);
+  return true;
+#endif
+}
+
+void onednn_verbose_aggregation_end() {
+#ifndef _WIN32
+  auto& state = verbose_agg_state();
+  if (!state.active) {
+    return;
+  }
+  ideep::utils::set_verbose(0);
+  fflush(stdout);
+  // Restoring stdout drops the last write end of the pipe; the drainer
+  // sees EOF after consuming every line written before this point.
+  dup2(state.saved_stdout, STDOUT_FILENO);
+  close(state.saved_stdout);
+  state.saved_stdout = -1;
+  state.drainer.join();
+  state.active = false;
+#endif
+}
+
+std::vector<OnednnVerboseEntry> onednn_verbose_aggregation_snapshot() {
+  auto& state = verbose_agg_state();
+  std::vector<OnednnVerboseEntry> entries;
+  std::lock_guard<std::mutex> lock(state.mutex);
+  entries.reserve(state.table.size());
+  for (auto& kv : state.table) {
+    size_t first = kv.first.find('\x1f');
+    size_t second = kv.first.find('\x1f', first + 1);
+    entries.push_back(
+        {kv.first.substr(0, first),
+         kv.first.substr(first + 1, second - first - 1),
+         kv.first.substr(second + 1),
+         kv.second.count,
+         kv.second.total_ms});
+  }
+  return entries;
+}
+
+void onednn_verbose_aggregation_reset() {
+  auto& state = verbose_agg_state();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  state.table.clear();
+}
+
 } // namespace utils
 } // namespace torch_ipex
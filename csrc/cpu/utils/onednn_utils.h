@@ -9,5 +9,53 @@ IPEX_API bool onednn_has_bf16_type_support();
 IPEX_API bool onednn_has_fp16_type_support();
 IPEX_API bool onednn_has_fp8_type_support();
 
+// Control of the process-wide oneDNN primitive cache, so its capacity can be
+// tuned (and the cache flushed) at runtime instead of only through
+// ONEDNN_PRIMITIVE_CACHE_CAPACITY at startup.
+IPEX_API int onednn_get_primitive_cache_capacity();
+IPEX_API void onednn_set_primitive_cache_capacity(int capacity);
+IPEX_API void onednn_clear_primitive_cache();
+
+// Thread-aware arena backing the allocator registered with the oneDNN CPU
+// engine: short-lived scratchpad blocks are parked in a small per-thread
+// cache and reused by the next primitive execution instead of going back to
+// the system allocator on every call.
+IPEX_API void* onednn_arena_allocate(size_t size);
+IPEX_API void onednn_arena_deallocate(void* p);
+
+struct OnednnArenaStats {
+  uint64_t hits; // allocations served from the per-thread cache
+  uint64_t misses; // allocations that fell through to the CPU allocator
+  uint64_t hit_bytes;
+  uint64_t miss_bytes;
+};
+
+IPEX_API OnednnArenaStats onednn_arena_stats();
+IPEX_API void onednn_reset_arena_stats();
+
+// In-process aggregation of oneDNN verbose output. oneDNN exposes no
+// callback for its verbose stream, so while aggregation is active stdout
+// is routed through a pipe to a drainer thread that folds every
+// "exec" line into a (primitive kind, impl, shape) -> {count, total ms}
+// table and forwards everything else to the real stdout. Primitive-level
+// telemetry stays available in long-running services without the I/O
+// cost of the per-invocation firehose.
+struct OnednnVerboseEntry {
+  std::string kind;
+  std::string impl;
+  std::string shape;
+  uint64_t count;
+  double total_ms;
+};
+
+// Returns false if aggregation was already active (or is unsupported on
+// this platform). Enables verbose level 1 as a side effect.
+IPEX_API bool onednn_verbose_aggregation_begin();
+// Restores stdout and verbose level 0, then joins the drainer so every
+// line written before the call is accounted for.
+IPEX_API void onednn_verbose_aggregation_end();
+IPEX_API std::vector<OnednnVerboseEntry> onednn_verbose_aggregation_snapshot();
+IPEX_API void onednn_verbose_aggregation_reset();
+
 } // namespace utils
 } // namespace torch_ipex
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+
+/*
+ Philox4x32-10 counter-based random number generator (Salmon et al.,
+ "Parallel Random Numbers: As Easy as 1, 2, 3"). Every draw is a pure
+ function of (seed, subsequence, offset), so kernels can derive
+ per-element randomness without sharing mutable generator state across
+ threads or serializing on it within a row: thread i simply constructs
+ its engine at the counter it owns. Matches the reference Random123
+ implementation bit-for-bit.
+
+ Usage:
+
+ torch_ipex::Philox4x32 rng(seed, row);
+ for (...) {
+   uint32_t draw = rng();
+ }
+*/
+
+namespace torch_ipex {
+
+constexpr uint32_t kPhiloxM0 = 0xD2511F53;
+constexpr uint32_t kPhiloxM1 = 0xCD9E8D57;
+constexpr uint32_t kPhiloxW0 = 0x9E3779B9;
+constexpr uint32_t kPhiloxW1 = 0xBB67AE85;
+
+class Philox4x32 {
+ public:
+  Philox4x32(uint64_t seed, uint64_t subsequence, uint64_t offset = 0) {
+    key_[0] = static_cast<uint32_t>(seed);
+    key_[1] = static_cast<uint32_t>(seed >> 32);
+    counter_[0] = static_cast<uint32_t>(offset);
+    counter_[1] = static_cast<uint32_t>(offset >> 32);
+    counter_[2] = static_cast<uint32_t>(subsequence);
+    counter_[3] = static_cast<uint32_t>(subsequence >> 32);
+  }
+
+  uint32_t operator()() {
+    if (pos_ == 4) {
+      generate();
+    }
+    return out_[pos_++];
+  }
+
+ private:
+  void generate() {
+    uint32_t c0 = counter_[0];
+    uint32_t c1 = counter_[1];
+    uint32_t c2 = counter_[2];
+    uint32_t c3 = counter_[3];
+    uint32_t k0 = key_[0];
+    uint32_t k1 = key_[1];
+    for (int round = 0; round < 10; round++) {
+      uint64_t p0 = static_cast<uint64_t>(kPhiloxM0) * c0;
+      uint64_t p1 = static_cast<uint64_t>(kPhiloxM1) * c2;
+      uint32_t lo0 = static_cast<uint32_t>(p0);
+      uint32_t hi0 = static_cast<uint32_t>(p0 >> 32);
+      uint32_t lo1 = static_cast<uint32_t>(p1);
+      uint32_t hi1 = static_cast<uint32_t>(p1 >> 32);
+      c0 = hi1 ^ c1 ^ k0;
+      c1 = lo1;
+      c2 = hi0 ^ c3 ^ k1;
+      c3 = lo0;
+      k0 += kPhiloxW0;
+      k1 += kPhiloxW1;
+    }
+    out_[0] = c0;
+    out_[1] = c1;
+    out_[2] = c2;
+    out_[3] = c3;
+    // bump the 64-bit offset half of the counter for the next block
+    if (++counter_[0] == 0) {
+      ++counter_[1];
+    }
+    pos_ = 0;
+  }
+
+  uint32_t counter_[4];
+  uint32_t key_[2];
+  uint32_t out_[4];
+  int pos_ = 4;
+};
+
+} // namespace torch_ipex
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace torch_ipex {
+namespace cpu {
+
+// Maps an IEEE-754 bit pattern to an unsigned key whose ascending unsigned
+// order equals the DESCENDING order of the original values: flip all bits
+// of negative values and the sign bit of non-negative ones (the classic
+// order-preserving transform), then complement to reverse the direction.
+template <typename T>
+struct DescendingRadixKey;
+
+template <>
+struct DescendingRadixKey<float> {
+  using key_t = uint32_t;
+  static inline key_t to_key(float v) {
+    key_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    key_t asc = bits ^ ((bits >> 31) ? ~key_t(0) : (key_t(1) << 31));
+    return ~asc;
+  }
+};
+
+template <>
+struct DescendingRadixKey<double> {
+  using key_t = uint64_t;
+  static inline key_t to_key(double v) {
+    key_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    key_t asc = bits ^ ((bits >> 63) ? ~key_t(0) : (key_t(1) << 63));
+    return ~asc;
+  }
+};
+
+// Fills order[0..n) with the indices of scores sorted in descending order.
+// LSD radix sort over (key, index) pairs, one byte per pass; all pass
+// histograms are gathered in a single sweep and passes whose byte is
+// constant across the input are skipped (typical detection scores occupy a
+// narrow exponent range, so most runs do one or two scatter passes). The
+// sort is stable, so tied scores keep their original relative order.
+// Replaces the comparison sort in the NMS kernels, where ordering 100k
+// proposal scores otherwise rivals the suppression loop itself.
+template <typename T>
+inline void radix_sort_descending_indices(
+    const T* scores,
+    int64_t* order,
+    int64_t n) {
+  using key_t = typename DescendingRadixKey<T>::key_t;
+  constexpr int num_passes = sizeof(key_t);
+
+  if (n <= 0) {
+    return;
+  }
+
+  std::vector<key_t> keys_buf(2 * n);
+  std::vector<int64_t> idx_buf(2 * n);
+  key_t* keys = keys_buf.data();
+  key_t* keys_tmp = keys_buf.data() + n;
+  int64_t* idx = idx_buf.data();
+  int64_t* idx_tmp = idx_buf.data() + n;
+
+  int64_t hist[num_passes][256] = {{0}};
+  for (int64_t i = 0; i < n; i++) {
+    key_t k = DescendingRadixKey<T>::to_key(scores[i]);
+    keys[i] = k;
+    idx[i] = i;
+    for (int p = 0; p < num_passes; p++) {
+      hist[p][(k >> (8 * p)) & 0xff]++;
+    }
+  }
+
+  for (int p = 0; p < num_passes; p++) {
+    // skip passes where every key shares the same byte
+    if (hist[p][(keys[0] >> (8 * p)) & 0xff] == n) {
+      continue;
+    }
+    int64_t offset = 0;
+    int64_t bucket_pos[256];
+    for (int b = 0; b < 256; b++) {
+      bucket_pos[b] = offset;
+      offset += hist[p][b];
+    }
+    for (int64_t i = 0; i < n; i++) {
+      int64_t pos = bucket_pos[(keys[i] >> (8 * p)) & 0xff]++;
+      keys_tmp[pos] = keys[i];
+      idx_tmp[pos] = idx[i];
+    }
+    std::swap(keys, keys_tmp);
+    std::swap(idx, idx_tmp);
+  }
+
+  std::memcpy(order, idx, n * sizeof(int64_t));
+}
+
+} // namespace cpu
+} // namespace torch_ipex
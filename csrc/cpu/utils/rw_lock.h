@@ -1,6 +1,8 @@
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
+#include <memory>
 #include <mutex>
 
 /*
@@ -117,4 +119,53 @@ class UniqueWriteLock {
  private:
   _ReadWriteLock* m_ptr_rw_lock = nullptr;
 };
+
+/*
+ RCU-style snapshot holder for read-mostly lookup structures (kernel and
+ weight caches that are populated during warmup and then read on every op
+ call). Even an uncontended ReadWriteMutex costs a mutex acquisition plus
+ a condition check per lookup; here a reader only bumps a shared_ptr
+ refcount and never waits on or blocks a writer. Writers are serialized
+ and publish a fresh copy of the whole structure, so they pay the copy --
+ acceptable for warmup-time insertions, wrong for write-heavy data.
+
+ Usage:
+
+ torch_ipex::ReadMostly<MapType> cache;
+
+ reader:
+     auto snap = cache.snapshot();
+     auto it = snap->find(key);  // snap stays valid while held
+
+ writer:
+     cache.update([&](MapType& m) { m.emplace(key, value); });
+*/
+template <typename T>
+class ReadMostly {
+ public:
+  ReadMostly() : m_current(std::make_shared<const T>()) {}
+
+  ReadMostly(const ReadMostly&) = delete;
+  ReadMostly& operator=(const ReadMostly&) = delete;
+
+  std::shared_ptr<const T> snapshot() const {
+    return std::atomic_load_explicit(&m_current, std::memory_order_acquire);
+  }
+
+  template <typename Fn>
+  void update(Fn&& fn) {
+    std::lock_guard<std::mutex> guard(m_write_mutex);
+    auto next = std::make_shared<T>(
+        *std::atomic_load_explicit(&m_current, std::memory_order_acquire));
+    fn(*next);
+    std::atomic_store_explicit(
+        &m_current,
+        std::shared_ptr<const T>(std::move(next)),
+        std::memory_order_release);
+  }
+
+ private:
+  std::shared_ptr<const T> m_current;
+  mutable std::mutex m_write_mutex;
+};
 } // namespace torch_ipex
\ No newline at end of file
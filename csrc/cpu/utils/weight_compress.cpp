@@ -0,0 +1,373 @@
+#include "weight_compress.h"
+
+#include <ATen/ATen.h>
+#include <ATen/Parallel.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace torch_ipex {
+namespace utils {
+
+namespace {
+
+// Container layout (little-endian, x86 only like the rest of the packed
+// weight machinery): header, ndim 64-bit dims, one 64-bit compressed size
+// per chunk (equal to the raw chunk size when a chunk is stored
+// uncompressed), then the chunk payloads back to back.
+constexpr uint64_t kWeightContainerMagic = 0x574B504358455049ULL; // IPEXCPKW
+constexpr uint32_t kWeightContainerVersion = 1;
+constexpr uint64_t kCompressChunkBytes = 1 << 20;
+// Skip blobs where the fixed costs dominate and give up on blobs that do
+// not shrink by at least 1/16; packed fp32/bf16 weights typically do much
+// better than that.
+constexpr uint64_t kCompressMinBytes = 1 << 20;
+
+struct ContainerHeader {
+  uint64_t magic;
+  uint32_t version;
+  int32_t dtype;
+  uint32_t ndim;
+  uint32_t pad;
+  uint64_t chunk_bytes;
+  uint64_t num_chunks;
+};
+
+inline uint32_t read32(const uint8_t* p) {
+  uint32_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline uint32_t lz4_hash(uint32_t v) {
+  return (v * 2654435761u) >> 16;
+}
+
+// Greedy LZ4 block compressor. Returns the compressed size, or 0 when the
+// output would not fit in dst_cap (the caller then stores the chunk raw).
+size_t lz4_compress_block(
+    const uint8_t* src,
+    size_t n,
+    uint8_t* dst,
+    size_t dst_cap,
+    uint32_t* table) {
+  std::memset(table, 0, (1 << 16) * sizeof(uint32_t));
+  size_t ip = 0;
+  size_t anchor = 0;
+  size_t op = 0;
+
+  auto emit_sequence = [&](size_t lit, size_t mlen, size_t offset) -> bool {
+    // worst case: token + extended lengths + literals + offset
+    size_t need = 1 + lit / 255 + 1 + lit + 2 + (mlen ? mlen / 255 + 1 : 0);
+    if (op + need > dst_cap) {
+      return false;
+    }
+    size_t token_pos = op++;
+    uint8_t token = 0;
+    if (lit >= 15) {
+      token = 15 << 4;
+      size_t rest = lit - 15;
+      while (rest >= 255) {
+        dst[op++] = 255;
+        rest -= 255;
+      }
+      dst[op++] = (uint8_t)rest;
+    } else {
+      token = (uint8_t)(lit << 4);
+    }
+    std::memcpy(dst + op, src + anchor, lit);
+    op += lit;
+    if (mlen > 0) {
+      dst[op++] = (uint8_t)offset;
+      dst[op++] = (uint8_t)(offset >> 8);
+      size_t mcode = mlen - 4;
+      if (mcode >= 15) {
+        token |= 15;
+        size_t rest = mcode - 15;
+        while (rest >= 255) {
+          dst[op++] = 255;
+          rest -= 255;
+        }
+        dst[op++] = (uint8_t)rest;
+      } else {
+        token |= (uint8_t)mcode;
+      }
+    }
+    dst[token_pos] = token;
+    return true;
+  };
+
+  if (n > 16) {
+    // matches may neither start within the last 12 bytes nor run into the
+    // last 5, per the block format's decoder guarantees
+    const size_t match_limit = n - 12;
+    const size_t match_end_limit = n - 5;
+    while (ip < match_limit) {
+      uint32_t h = lz4_hash(read32(src + ip));
+      size_t ref = table[h] == 0 ? SIZE_MAX : (size_t)(table[h] - 1);
+      table[h] = (uint32_t)(ip + 1);
+      if (ref != SIZE_MAX && ip - ref <= 0xffff &&
+          read32(src + ref) == read32(src + ip)) {
+        size_t mlen = 4;
+        while (ip + mlen < match_end_limit &&
+               src[ref + mlen] == src[ip + mlen]) {
+          mlen++;
+        }
+        if (!emit_sequence(ip - anchor, mlen, ip - ref)) {
+          return 0;
+        }
+        ip += mlen;
+        anchor = ip;
+      } else {
+        ip++;
+      }
+    }
+  }
+  if (!emit_sequence(n - anchor, 0, 0)) {
+    return 0;
+  }
+  return op;
+}
+
+// LZ4 block decoder with full bounds checking; returns false on any
+// malformed input instead of reading or writing out of range.
+bool lz4_decompress_block(
+    const uint8_t* src,
+    size_t n,
+    uint8_t* dst,
+    size_t raw) {
+  size_t ip = 0;
+  size_t op = 0;
+  while (ip < n) {
+    uint8_t token = src[ip++];
+    size_t lit = token >> 4;
+    if (lit == 15) {
+      uint8_t b;
+      do {
+        if (ip >= n) {
+          return false;
+        }
+        b = src[ip++];
+        lit += b;
+      } while (b == 255);
+    }
+    if (ip + lit > n || op + lit > raw) {
+      return false;
+    }
+    std::memcpy(dst + op, src + ip, lit);
+    ip += lit;
+    op += lit;
+    if (ip >= n) {
+      break; // final sequence carries literals only
+    }
+    if (ip + 2 > n) {
+      return false;
+    }
+    size_t offset = (size_t)src[ip] | ((size_t)src[ip + 1] << 8);
+    ip += 2;
+    if (offset == 0 || offset > op) {
+      return false;
+    }
+    size_t mlen = (size_t)(token & 15) + 4;
+    if ((token & 15) == 15) {
+      uint8_t b;
+      do {
+        if (ip >= n) {
+          return false;
+        }
+        b = src[ip++];
+        mlen += b;
+      } while (b == 255);
+    }
+    if (op + mlen > raw) {
+      return false;
+    }
+    // byte-wise copy keeps overlapping matches (offset < mlen) correct
+    const uint8_t* match = dst + op - offset;
+    for (size_t i = 0; i < mlen; i++) {
+      dst[op + i] = match[i];
+    }
+    op += mlen;
+  }
+  return op == raw;
+}
+
+std::atomic<bool> g_compress_enabled{[]() {
+  const char* env = std::getenv("IPEX_COMPRESS_PACKED_WEIGHTS");
+  return env != nullptr && std::strcmp(env, "1") == 0;
+}()};
+
+} // namespace
+
+void set_packed_weight_compression(bool enabled) {
+  g_compress_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool packed_weight_compression_enabled() {
+  return g_compress_enabled.load(std::memory_order_relaxed);
+}
+
+at::Tensor compress_packed_weight(const at::Tensor& weight) {
+  if (!packed_weight_compression_enabled()) {
+    return weight;
+  }
+  if (!weight.defined() || !weight.device().is_cpu() ||
+      weight.layout() != c10::kStrided || weight.is_quantized()) {
+    return weight;
+  }
+  auto src_tensor = weight.contiguous();
+  uint64_t nbytes = (uint64_t)src_tensor.nbytes();
+  if (nbytes < kCompressMinBytes) {
+    return weight;
+  }
+  const uint8_t* src = (const uint8_t*)src_tensor.data_ptr();
+  uint64_t num_chunks =
+      (nbytes + kCompressChunkBytes - 1) / kCompressChunkBytes;
+
+  std::vector<std::vector<uint8_t>> payloads(num_chunks);
+  at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+    std::vector<uint32_t> table(1 << 16);
+    for (auto c = begin; c < end; c++) {
+      uint64_t off = (uint64_t)c * kCompressChunkBytes;
+      size_t raw = (size_t)std::min(kCompressChunkBytes, nbytes - off);
+      // cap below raw: a chunk that does not shrink is stored raw
+      payloads[c].resize(raw);
+      size_t comp = lz4_compress_block(
+          src + off, raw, payloads[c].data(), raw - 1, table.data());
+      if (comp == 0) {
+        std::memcpy(payloads[c].data(), src + off, raw);
+      } else {
+        payloads[c].resize(comp);
+      }
+    }
+  });
+
+  uint64_t payload_bytes = 0;
+  for (auto& p : payloads) {
+    payload_bytes += p.size();
+  }
+  if (payload_bytes >= nbytes - nbytes / 16) {
+    return weight;
+  }
+
+  uint64_t ndim = (uint64_t)src_tensor.dim();
+  uint64_t meta_bytes = sizeof(ContainerHeader) + ndim * sizeof(int64_t) +
+      num_chunks * sizeof(uint64_t);
+  auto out = at::empty(
+      {(int64_t)(meta_bytes + payload_bytes)},
+      at::TensorOptions().dtype(at::kByte));
+  uint8_t* dst = out.data_ptr<uint8_t>();
+
+  ContainerHeader header{
+      kWeightContainerMagic,
+      kWeightContainerVersion,
+      (int32_t)src_tensor.scalar_type(),
+      (uint32_t)ndim,
+      0,
+      kCompressChunkBytes,
+      num_chunks};
+  std::memcpy(dst, &header, sizeof(header));
+  size_t pos = sizeof(header);
+  for (uint64_t d = 0; d < ndim; d++) {
+    int64_t dim = src_tensor.size(d);
+    std::memcpy(dst + pos, &dim, sizeof(dim));
+    pos += sizeof(dim);
+  }
+  for (auto& p : payloads) {
+    uint64_t comp = p.size();
+    std::memcpy(dst + pos, &comp, sizeof(comp));
+    pos += sizeof(comp);
+  }
+  for (auto& p : payloads) {
+    std::memcpy(dst + pos, p.data(), p.size());
+    pos += p.size();
+  }
+  return out;
+}
+
+at::Tensor maybe_decompress_packed_weight(const at::Tensor& weight) {
+  if (!weight.defined() || weight.scalar_type() != at::kByte ||
+      weight.dim() != 1 || weight.device().is_cpu() == false ||
+      (uint64_t)weight.numel() < sizeof(ContainerHeader)) {
+    return weight;
+  }
+  auto src_tensor = weight.contiguous();
+  const uint8_t* src = src_tensor.data_ptr<uint8_t>();
+  ContainerHeader header;
+  std::memcpy(&header, src, sizeof(header));
+  if (header.magic != kWeightContainerMagic) {
+    return weight;
+  }
+  TORCH_CHECK(
+      header.version == kWeightContainerVersion,
+      "packed weight container: unsupported version ",
+      header.version);
+  uint64_t total = (uint64_t)src_tensor.numel();
+  // Validate the header fields before they feed any arithmetic: a zero
+  // chunk size would divide by zero below, and oversized counts would
+  // wrap the metadata size computation.
+  TORCH_CHECK(
+      header.chunk_bytes > 0 &&
+          (uint64_t)header.ndim <= total / sizeof(int64_t) &&
+          header.num_chunks <= total / sizeof(uint64_t),
+      "packed weight container: corrupt header");
+  uint64_t meta_bytes = sizeof(ContainerHeader) +
+      (uint64_t)header.ndim * sizeof(int64_t) +
+      header.num_chunks * sizeof(uint64_t);
+  TORCH_CHECK(
+      total >= meta_bytes, "packed weight container: truncated metadata");
+
+  std::vector<int64_t> sizes(header.ndim);
+  std::memcpy(
+      sizes.data(),
+      src + sizeof(ContainerHeader),
+      header.ndim * sizeof(int64_t));
+  std::vector<uint64_t> comp_sizes(header.num_chunks);
+  std::memcpy(
+      comp_sizes.data(),
+      src + sizeof(ContainerHeader) + header.ndim * sizeof(int64_t),
+      header.num_chunks * sizeof(uint64_t));
+  std::vector<uint64_t> payload_offsets(header.num_chunks);
+  uint64_t pos = meta_bytes;
+  for (uint64_t c = 0; c < header.num_chunks; c++) {
+    payload_offsets[c] = pos;
+    // Bound each chunk against the bytes that are left so a corrupt size
+    // cannot wrap `pos` around and slip past the check below.
+    TORCH_CHECK(
+        comp_sizes[c] <= total - pos,
+        "packed weight container: truncated payload");
+    pos += comp_sizes[c];
+  }
+  TORCH_CHECK(pos == total, "packed weight container: truncated payload");
+
+  auto out = at::empty(
+      sizes, at::TensorOptions().dtype((at::ScalarType)header.dtype));
+  uint64_t nbytes = (uint64_t)out.nbytes();
+  TORCH_CHECK(
+      (nbytes + header.chunk_bytes - 1) / header.chunk_bytes ==
+          header.num_chunks,
+      "packed weight container: chunk count does not match tensor size");
+  uint8_t* dst = (uint8_t*)out.data_ptr();
+
+  at::parallel_for(0, header.num_chunks, 1, [&](int64_t begin, int64_t end) {
+    for (auto c = begin; c < end; c++) {
+      uint64_t off = (uint64_t)c * header.chunk_bytes;
+      size_t raw = (size_t)std::min(header.chunk_bytes, nbytes - off);
+      const uint8_t* payload = src + payload_offsets[c];
+      if (comp_sizes[c] == raw) {
+        std::memcpy(dst + off, payload, raw);
+      } else {
+        TORCH_CHECK(
+            lz4_decompress_block(payload, comp_sizes[c], dst + off, raw),
+            "packed weight container: corrupt chunk ",
+            c);
+      }
+    }
+  });
+  return out;
+}
+
+} // namespace utils
+} // namespace torch_ipex
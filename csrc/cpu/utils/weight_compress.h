@@ -0,0 +1,40 @@
+#pragma once
+
+#include <ATen/Tensor.h>
+#include <Macros.h>
+
+namespace torch_ipex {
+namespace utils {
+
+// Optional compression of prepacked weight blobs inside the OpContext
+// pickle path. With compression enabled, __getstate__ replaces the weight
+// tensor with a one-dimensional uint8 container holding independently
+// compressed chunks plus the original dtype and shape; __setstate__
+// recognizes the container by its magic header and decompresses all
+// chunks in parallel straight into the freshly allocated destination
+// tensor, so artifact load time is bounded by network read rather than a
+// serial inflate. Blobs that are small, non-CPU, quantized or that do not
+// compress meaningfully are stored as-is, and containers from older
+// artifacts (plain tensors) pass through untouched, so the format stays
+// backward and forward compatible.
+//
+// The chunk payloads use the LZ4 block format: self-contained, byte
+// oriented and decodable at memory speed, which keeps this file free of
+// external dependencies.
+
+// Process-wide switch for compress-on-save; seeded from the
+// IPEX_COMPRESS_PACKED_WEIGHTS environment variable. Decompress-on-load
+// is always active since it only triggers on the magic header.
+IPEX_API void set_packed_weight_compression(bool enabled);
+IPEX_API bool packed_weight_compression_enabled();
+
+// Returns the compressed container, or `weight` unchanged when
+// compression is off or not worthwhile for this tensor.
+IPEX_API at::Tensor compress_packed_weight(const at::Tensor& weight);
+
+// Inverse of compress_packed_weight: expands a container back to the
+// original tensor and passes every other tensor through unchanged.
+IPEX_API at::Tensor maybe_decompress_packed_weight(const at::Tensor& weight);
+
+} // namespace utils
+} // namespace torch_ipex
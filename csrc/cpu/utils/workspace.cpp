@@ -0,0 +1,48 @@
+#include "workspace.h"
+#include "SysUtil.h"
+
+namespace torch_ipex {
+namespace cpu {
+
+namespace {
+
+constexpr size_t kWorkspaceAlignment = 64;
+constexpr size_t kMinWorkspaceBytes = 1024;
+
+struct ThreadWorkspace {
+  void* data = nullptr;
+  size_t capacity = 0;
+  ~ThreadWorkspace() {
+    if (data != nullptr) {
+      ipex_free_aligned(data);
+    }
+  }
+};
+
+// Round the request up to a power-of-two shape class so small run-to-run
+// jitter in the requested size does not trigger a reallocation.
+size_t workspace_shape_class(size_t nbytes) {
+  size_t capacity = kMinWorkspaceBytes;
+  while (capacity < nbytes) {
+    capacity <<= 1;
+  }
+  return capacity;
+}
+
+} // namespace
+
+void* get_thread_local_workspace(size_t nbytes) {
+  thread_local ThreadWorkspace workspace;
+  if (workspace.capacity < nbytes) {
+    size_t new_capacity = workspace_shape_class(nbytes);
+    if (workspace.data != nullptr) {
+      ipex_free_aligned(workspace.data);
+    }
+    workspace.data = ipex_alloc_aligned(new_capacity, kWorkspaceAlignment);
+    workspace.capacity = new_capacity;
+  }
+  return workspace.data;
+}
+
+} // namespace cpu
+} // namespace torch_ipex
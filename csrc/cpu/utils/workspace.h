@@ -0,0 +1,21 @@
+#pragma once
+
+#include <stddef.h>
+
+namespace torch_ipex {
+namespace cpu {
+
+// Returns a thread-local scratch buffer of at least nbytes bytes, 64-byte
+// aligned. The buffer is cached per thread and only reallocated when the
+// request outgrows its power-of-two shape class, so kernels that need
+// similarly sized scratch on every call (attention qk/max/sum blocks,
+// softmax and layernorm row buffers) reuse the same memory instead of
+// hitting the allocator from inside at::parallel_for.
+//
+// The returned memory is uninitialized and owned by the calling thread; it
+// stays valid until the same thread requests a larger workspace. Do not
+// share the pointer across threads or hold it across calls.
+void* get_thread_local_workspace(size_t nbytes);
+
+} // namespace cpu
+} // namespace torch_ipex
@@ -107,6 +107,110 @@ inline void apply_rope_along_head_kernel(
     out_ptr_start[h + offset] = out1;
   }
 }
+
+// Interleaved (GPT-J/CodeGen/ChatGLM/Qwen) rotary layout: each rotated
+// pair sits on neighboring elements (2*h2, 2*h2+1), i.e. the offset-1
+// case of rotate_every_two. Vectorized by deinterleaving a block of
+// pairs into an x and a y lane vector, rotating in the pair domain
+// against the contiguous sin/cos entries, and interleaving back - no
+// gathers or permute passes over the head.
+template <typename scalar_t>
+inline void apply_rope_interleaved_kernel(
+    scalar_t* in_ptr_start,
+    scalar_t* out_ptr_start,
+    float* cos_start,
+    float* sin_start,
+    int64_t rotary_ndims) {
+  for (auto h2 = 0; h2 < rotary_ndims / 2; h2++) {
+    float x = in_ptr_start[2 * h2];
+    float y = in_ptr_start[2 * h2 + 1];
+    float sin = sin_start[h2];
+    float cos = cos_start[h2];
+    out_ptr_start[2 * h2] = x * cos - y * sin;
+    out_ptr_start[2 * h2 + 1] = y * cos + x * sin;
+  }
+}
+
+template <>
+inline void apply_rope_interleaved_kernel(
+    float* in_ptr_start,
+    float* out_ptr_start,
+    float* cos_start,
+    float* sin_start,
+    int64_t rotary_ndims) {
+  auto h2 = 0;
+  using Vec = Vectorized<float>;
+  const int vec_size = Vec::size();
+  for (h2 = 0; h2 <= rotary_ndims / 2 - vec_size; h2 += vec_size) {
+    auto a = Vec::loadu(in_ptr_start + 2 * h2);
+    auto b = Vec::loadu(in_ptr_start + 2 * h2 + vec_size);
+    Vec x, y;
+    std::tie(x, y) = deinterleave2(a, b);
+    auto sin = Vec::loadu(sin_start + h2);
+    auto cos = Vec::loadu(cos_start + h2);
+    auto out0 = x * cos - y * sin;
+    auto out1 = y * cos + x * sin;
+    Vec lo, hi;
+    std::tie(lo, hi) = interleave2(out0, out1);
+    lo.store(out_ptr_start + 2 * h2);
+    hi.store(out_ptr_start + 2 * h2 + vec_size);
+  }
+  for (; h2 < rotary_ndims / 2; h2++) {
+    float x = in_ptr_start[2 * h2];
+    float y = in_ptr_start[2 * h2 + 1];
+    float sin = sin_start[h2];
+    float cos = cos_start[h2];
+    out_ptr_start[2 * h2] = x * cos - y * sin;
+    out_ptr_start[2 * h2 + 1] = y * cos + x * sin;
+  }
+}
+
+template <>
+inline void apply_rope_interleaved_kernel(
+    at::BFloat16* in_ptr_start,
+    at::BFloat16* out_ptr_start,
+    float* cos_start,
+    float* sin_start,
+    int64_t rotary_ndims) {
+  auto h2 = 0;
+  using bVec = Vectorized<at::BFloat16>;
+  using fVec = Vectorized<float>;
+  const int fvec_size = fVec::size();
+  const int bvec_size = bVec::size();
+  for (h2 = 0; h2 <= rotary_ndims / 2 - bvec_size; h2 += bvec_size) {
+    bVec a = bVec::loadu(in_ptr_start + 2 * h2);
+    bVec b = bVec::loadu(in_ptr_start + 2 * h2 + bvec_size);
+    fVec a0, a1, b0, b1;
+    std::tie(a0, a1) = convert_bfloat16_float(a);
+    std::tie(b0, b1) = convert_bfloat16_float(b);
+    fVec x0, y0, x1, y1;
+    std::tie(x0, y0) = deinterleave2(a0, a1);
+    std::tie(x1, y1) = deinterleave2(b0, b1);
+    fVec s0 = fVec::loadu(sin_start + h2);
+    fVec c0 = fVec::loadu(cos_start + h2);
+    fVec s1 = fVec::loadu(sin_start + h2 + fvec_size);
+    fVec c1 = fVec::loadu(cos_start + h2 + fvec_size);
+    fVec x_out0 = x0 * c0 - y0 * s0;
+    fVec y_out0 = y0 * c0 + x0 * s0;
+    fVec x_out1 = x1 * c1 - y1 * s1;
+    fVec y_out1 = y1 * c1 + x1 * s1;
+    fVec lo0, hi0, lo1, hi1;
+    std::tie(lo0, hi0) = interleave2(x_out0, y_out0);
+    std::tie(lo1, hi1) = interleave2(x_out1, y_out1);
+    bVec out_a = convert_float_bfloat16(lo0, hi0);
+    bVec out_b = convert_float_bfloat16(lo1, hi1);
+    out_a.store(out_ptr_start + 2 * h2);
+    out_b.store(out_ptr_start + 2 * h2 + bvec_size);
+  }
+  for (; h2 < rotary_ndims / 2; h2++) {
+    float x = in_ptr_start[2 * h2];
+    float y = in_ptr_start[2 * h2 + 1];
+    float sin = sin_start[h2];
+    float cos = cos_start[h2];
+    out_ptr_start[2 * h2] = x * cos - y * sin;
+    out_ptr_start[2 * h2 + 1] = y * cos + x * sin;
+  }
+}
 } // namespace kernel
 } // namespace cpu
 } // namespace torch_ipex
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/cpu/vec/functional.h>
+#include <ATen/cpu/vec/vec.h>
+#include <utility>
+
+// Width-agnostic implementations of the fused add + layernorm helpers,
+// written against at::vec::Vectorized so the per-ISA build compiles them at
+// whatever vector width the translation unit targets. The vec512 tree keeps
+// its hand-tuned AVX-512 versions (opmask tails, full-width bf16 converts);
+// this layer is what the non-AVX512 builds include, so a fused kernel
+// written once here reaches AVX2 machines without a second port.
+//
+// Reduced-precision rows are processed at Vectorized<float> width: each step
+// loads float-lane-count elements of T and widens them, which costs half the
+// convert throughput of the tuned 512-bit path but keeps one code path for
+// every dtype and width.
+
+namespace torch_ipex {
+namespace cpu {
+namespace kernel {
+
+namespace vec_generic {
+
+using fVec = at::vec::Vectorized<float>;
+
+template <typename T>
+inline fVec _load_fvec(const T* ptr, int count = fVec::size());
+
+template <>
+inline fVec _load_fvec<float>(const float* ptr, int count) {
+  return fVec::loadu(ptr, count);
+}
+
+template <>
+inline fVec _load_fvec<at::BFloat16>(const at::BFloat16* ptr, int count) {
+  auto v = at::vec::Vectorized<at::BFloat16>::loadu(ptr, count);
+  return std::get<0>(at::vec::convert_bfloat16_float(v));
+}
+
+template <>
+inline fVec _load_fvec<at::Half>(const at::Half* ptr, int count) {
+  auto v = at::vec::Vectorized<at::Half>::loadu(ptr, count);
+  return std::get<0>(at::vec::convert_half_float(v));
+}
+
+template <typename T>
+inline void _store_fvec(T* ptr, fVec v, int count = fVec::size());
+
+template <>
+inline void _store_fvec<float>(float* ptr, fVec v, int count) {
+  v.store(ptr, count);
+}
+
+template <>
+inline void _store_fvec<at::BFloat16>(at::BFloat16* ptr, fVec v, int count) {
+  at::vec::convert_float_bfloat16(v, v).store(ptr, count);
+}
+
+template <>
+inline void _store_fvec<at::Half>(at::Half* ptr, fVec v, int count) {
+  at::vec::convert_float_half(v, v).store(ptr, count);
+}
+
+inline float _reduce_add(fVec v) {
+  return at::vec::vec_reduce_all<float>(
+      [](fVec& x, fVec& y) { return x + y; }, v);
+}
+
+} // namespace vec_generic
+
+// Contract matches the vec512 version: computes out = a + b, returns
+// {sum(out) / size, sum(out * out)} — the caller turns the raw sum of
+// squares into a variance.
+template <typename T>
+std::pair<float, float> _add_and_compute_mean_var(
+    const T* a_ptr,
+    const T* b_ptr,
+    const int& size,
+    float* out) {
+  using namespace vec_generic;
+  auto vec_acc_mean = fVec(0.0f);
+  auto vec_acc_pow = fVec(0.0f);
+
+  int i = 0;
+  for (; i <= size - fVec::size(); i += fVec::size()) {
+    auto vec_add = _load_fvec(a_ptr + i) + _load_fvec(b_ptr + i);
+    vec_acc_mean = vec_acc_mean + vec_add;
+    vec_add.store(out + i);
+    vec_acc_pow = at::vec::fmadd(vec_add, vec_add, vec_acc_pow);
+  }
+  if (i < size) {
+    int rem = size - i;
+    // partial loads zero-fill the upper lanes, which contribute nothing to
+    // either accumulator
+    auto vec_add = _load_fvec(a_ptr + i, rem) + _load_fvec(b_ptr + i, rem);
+    vec_acc_mean = vec_acc_mean + vec_add;
+    vec_add.store(out + i, rem);
+    vec_acc_pow = at::vec::fmadd(vec_add, vec_add, vec_acc_pow);
+  }
+  float mean_var = _reduce_add(vec_acc_mean) / float(size);
+  float var_val = _reduce_add(vec_acc_pow);
+  return std::make_pair(mean_var, var_val);
+}
+
+// three-input variant, used by the fused embedding + layernorm kernel
+// (token + position + segment rows)
+template <typename T>
+std::pair<float, float> _add3_and_compute_mean_var(
+    const T* a_ptr,
+    const T* b_ptr,
+    const T* c_ptr,
+    const int& size,
+    float* out) {
+  using namespace vec_generic;
+  auto vec_acc_mean = fVec(0.0f);
+  auto vec_acc_pow = fVec(0.0f);
+
+  int i = 0;
+  for (; i <= size - fVec::size(); i += fVec::size()) {
+    auto vec_add =
+        _load_fvec(a_ptr + i) + _load_fvec(b_ptr + i) + _load_fvec(c_ptr + i);
+    vec_acc_mean = vec_acc_mean + vec_add;
+    vec_add.store(out + i);
+    vec_acc_pow = at::vec::fmadd(vec_add, vec_add, vec_acc_pow);
+  }
+  if (i < size) {
+    int rem = size - i;
+    auto vec_add = _load_fvec(a_ptr + i, rem) + _load_fvec(b_ptr + i, rem) +
+        _load_fvec(c_ptr + i, rem);
+    vec_acc_mean = vec_acc_mean + vec_add;
+    vec_add.store(out + i, rem);
+    vec_acc_pow = at::vec::fmadd(vec_add, vec_add, vec_acc_pow);
+  }
+  float mean_var = _reduce_add(vec_acc_mean) / float(size);
+  float var_val = _reduce_add(vec_acc_pow);
+  return std::make_pair(mean_var, var_val);
+}
+
+// out = ((input * scale + bias) * gamma + beta), gamma/beta optional
+template <typename T, typename T1>
+void _normalize_kernel(
+    T* out_ptr,
+    const float* input_ptr,
+    const int& size,
+    float scale,
+    float bias,
+    const T1* gamma_ptr,
+    const T1* beta_ptr) {
+  using namespace vec_generic;
+  auto vec_one = fVec(1.0f);
+  auto vec_zero = fVec(0.0f);
+  auto vec_scale = fVec(scale);
+  auto vec_bias = fVec(bias);
+  int i = 0;
+  for (; i <= size - fVec::size(); i += fVec::size()) {
+    auto vec_input = fVec::loadu(input_ptr + i);
+    auto vec_gamma = gamma_ptr ? _load_fvec(gamma_ptr + i) : vec_one;
+    auto vec_beta = beta_ptr ? _load_fvec(beta_ptr + i) : vec_zero;
+    auto vec_norm = at::vec::fmadd(vec_input, vec_scale, vec_bias);
+    auto vec_res = at::vec::fmadd(vec_norm, vec_gamma, vec_beta);
+    _store_fvec(out_ptr + i, vec_res);
+  }
+  if (i < size) {
+    int rem = size - i;
+    auto vec_input = fVec::loadu(input_ptr + i, rem);
+    auto vec_gamma = gamma_ptr ? _load_fvec(gamma_ptr + i, rem) : vec_one;
+    auto vec_beta = beta_ptr ? _load_fvec(beta_ptr + i, rem) : vec_zero;
+    auto vec_norm = at::vec::fmadd(vec_input, vec_scale, vec_bias);
+    auto vec_res = at::vec::fmadd(vec_norm, vec_gamma, vec_beta);
+    _store_fvec(out_ptr + i, vec_res, rem);
+  }
+}
+
+} // namespace kernel
+} // namespace cpu
+} // namespace torch_ipex
@@ -17,6 +17,22 @@ IPEX_FORCE_INLINE void add_ker(
   }
 }
 
+// Strided form for non-contiguous views (e.g. sliced KV-cache buffers).
+// Strides are element strides; ISA-specific gather/scatter specializations
+// live under vec256/vec512.
+template <typename dst_type, typename src_type>
+IPEX_FORCE_INLINE void add_ker_stride(
+    dst_type* inout,
+    const src_type* in,
+    int64_t len,
+    int64_t inout_stride,
+    int64_t in_stride) {
+#pragma omp simd
+  for (int64_t i = 0; i < len; i++) {
+    *(inout + i * inout_stride) += *(in + i * in_stride);
+  }
+}
+
 } // namespace kernel
 } // namespace cpu
 } // namespace torch_ipex
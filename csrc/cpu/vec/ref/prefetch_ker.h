@@ -0,0 +1,27 @@
+#pragma once
+
+#include <immintrin.h>
+#include "utils/SysUtil.h"
+
+namespace torch_ipex {
+namespace cpu {
+namespace kernel {
+
+// How many indices ahead the gather loops prefetch. Embedding lookups
+// issue dependent loads through an index array, so without software
+// prefetch every row pays a full DRAM latency; callers prefetch the row
+// for index i + kRowPrefetchDistance while accumulating row i.
+constexpr int64_t kRowPrefetchDistance = 8;
+
+// Prefetch one embedding row (len elements) into all cache levels.
+template <typename T>
+IPEX_FORCE_INLINE void prefetch_row_ker(const T* row, int64_t len) {
+  constexpr int64_t elems_per_line = 64 / sizeof(T);
+  for (int64_t i = 0; i < len; i += elems_per_line) {
+    _mm_prefetch(reinterpret_cast<const char*>(row + i), _MM_HINT_T0);
+  }
+}
+
+} // namespace kernel
+} // namespace cpu
+} // namespace torch_ipex
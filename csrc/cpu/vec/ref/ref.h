@@ -1,4 +1,5 @@
 #include "add_ker.h"
 #include "move_ker.h"
+#include "prefetch_ker.h"
 #include "prefix_sum_ker.h"
 #include "zero_ker.h"
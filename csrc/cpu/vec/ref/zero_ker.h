@@ -14,6 +14,17 @@ IPEX_FORCE_INLINE void zero_ker(T* out, int64_t len) {
   }
 }
 
+// Strided form for non-contiguous views (e.g. sliced KV-cache buffers).
+// The stride is an element stride; ISA-specific scatter specializations
+// live under vec256/vec512.
+template <typename T>
+IPEX_FORCE_INLINE void zero_ker_stride(T* out, int64_t len, int64_t stride) {
+#pragma omp simd
+  for (int64_t i = 0; i < len; i++) {
+    *(out + i * stride) = 0;
+  }
+}
+
 } // namespace kernel
 } // namespace cpu
 } // namespace torch_ipex
@@ -0,0 +1,5 @@
+#pragma once
+
+// The 256-bit build takes the width-agnostic Vectorized implementation; only
+// the vec512 tree carries a hand-tuned intrinsic version of these helpers.
+#include "vec/perf_kernel/add_layernorm.h"
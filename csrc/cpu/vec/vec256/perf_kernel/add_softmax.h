@@ -0,0 +1,284 @@
+#pragma once
+
+#include <immintrin.h>
+
+#include <ATen/ATen.h>
+#include <ATen/ExpandUtils.h>
+#include <ATen/Parallel.h>
+#include <c10/util/SmallVector.h>
+#include <torch/types.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "utils.h"
+
+// AVX2 port of vec512/perf_kernel/add_softmax.h so the one-pass fused
+// softmax kernels (AddSoftmaxKrnl.cpp / DivSoftmaxKrnl.cpp) are available on
+// pre-AVX512 machines. The algorithms are identical; the vector width drops
+// from 16 to 8 floats and the masked remainder handling is replaced with
+// scalar tail loops.
+
+namespace torch_ipex {
+namespace cpu {
+namespace kernel {
+
+inline __m256 _dil_exp_kernel(__m256 vec_src) {
+  static __m256 vec_factorial_1 =
+      _mm256_set1_ps(0.999999701f); // 1/factorial(1)
+  static __m256 vec_factorial_2 =
+      _mm256_set1_ps(0.499991506f); // 1/factorial(2)
+  static __m256 vec_factorial_3 =
+      _mm256_set1_ps(0.166676521f); // 1/factorial(3)
+  static __m256 vec_factorial_4 =
+      _mm256_set1_ps(0.0418978221f); // 1/factorial(4)
+  static __m256 vec_factorial_5 =
+      _mm256_set1_ps(0.00828929059f); // 1/factorial(5)
+  static __m256 vec_exp_log2ef =
+      _mm256_castsi256_ps(_mm256_set1_epi32(0x3fb8aa3b)); // log2(e)
+  static __m256 vec_half = _mm256_set1_ps(0.5f);
+  static __m256 vec_one = _mm256_set1_ps(1.f);
+  static __m256 vec_zero = _mm256_set1_ps(0.f);
+  static __m256 vec_two = _mm256_set1_ps(2.f);
+  static __m256 vec_ln2f =
+      _mm256_castsi256_ps(_mm256_set1_epi32(0x3f317218)); // ln(2)
+  static __m256 vec_ln_flt_min =
+      _mm256_castsi256_ps(_mm256_set1_epi32(0xc2aeac50));
+  static __m256 vec_ln_flt_max =
+      _mm256_castsi256_ps(_mm256_set1_epi32(0x42b17218));
+  static __m256i vec_127 = _mm256_set1_epi32(0x0000007f);
+  static int n_mantissa_bits = 23;
+
+  // exp(x) =
+  // = exp(n * ln(2) + r) // divide x by ln(2) and get quot and rem
+  // = 2^n * exp(r) // simplify the exp(n*ln(2)) expression
+
+  auto less_ln_flt_min_mask =
+      _mm256_cmp_ps(vec_src, vec_ln_flt_min, 1 /*_CMP_LT_OS*/);
+  vec_src = _mm256_min_ps(vec_src, vec_ln_flt_max);
+  vec_src = _mm256_max_ps(vec_src, vec_ln_flt_min);
+
+  // fx = floorf(x * log2ef + 0.5)
+  auto vec_fx = _mm256_fmadd_ps(vec_src, vec_exp_log2ef, vec_half);
+  vec_fx = _mm256_floor_ps(vec_fx);
+
+  // x = x - fx * ln2
+  auto vec_exp_poly = _mm256_fnmadd_ps(vec_fx, vec_ln2f, vec_src);
+
+  // compute polynomial
+  auto vec_res =
+      _mm256_fmadd_ps(vec_exp_poly, vec_factorial_5, vec_factorial_4);
+  vec_res = _mm256_fmadd_ps(vec_exp_poly, vec_res, vec_factorial_3);
+  vec_res = _mm256_fmadd_ps(vec_exp_poly, vec_res, vec_factorial_2);
+  vec_res = _mm256_fmadd_ps(vec_exp_poly, vec_res, vec_factorial_1);
+  vec_res = _mm256_fmadd_ps(vec_exp_poly, vec_res, vec_one);
+
+  // compute 2^(n-1)
+  auto vec_exp_number = _mm256_sub_ps(vec_fx, vec_one);
+  auto vec_exp_number_i = _mm256_cvtps_epi32(vec_exp_number);
+  auto vec_two_pow_n_i = _mm256_add_epi32(vec_exp_number_i, vec_127);
+  vec_two_pow_n_i = _mm256_slli_epi32(vec_two_pow_n_i, n_mantissa_bits);
+  auto vec_two_pow_n = _mm256_castsi256_ps(vec_two_pow_n_i);
+  vec_two_pow_n =
+      _mm256_blendv_ps(vec_two_pow_n, vec_zero, less_ln_flt_min_mask);
+
+  // y = y * 2^n
+  vec_res = _mm256_mul_ps(vec_res, vec_two_pow_n);
+  vec_res = _mm256_mul_ps(vec_res, vec_two);
+  return vec_res;
+}
+
+// Scalar replica of _dil_exp_kernel for the tail elements, so the remainder
+// follows the same approximation as the vector body.
+inline float _dil_exp_kernel_scalar(float src) {
+  static float ln_flt_min = -87.3365479f;
+  static float ln_flt_max = 88.7228394f;
+  if (src < ln_flt_min) {
+    return 0.f;
+  }
+  src = std::min(src, ln_flt_max);
+
+  // fx = floorf(x * log2ef + 0.5)
+  float fx = std::floor(src * 1.442695041f + 0.5f);
+
+  // x = x - fx * ln2
+  float exp_poly = src - fx * 0.693147181f;
+
+  float res = exp_poly * 0.00828929059f + 0.0418978221f;
+  res = exp_poly * res + 0.166676521f;
+  res = exp_poly * res + 0.499991506f;
+  res = exp_poly * res + 0.999999701f;
+  res = exp_poly * res + 1.f;
+
+  // y = y * 2^(n-1) * 2
+  return res * std::exp2(fx - 1.f) * 2.f;
+}
+
+template <typename scalar_a, typename scalar_b>
+inline void _dil_div_add_reduce_max_fusion_kernel(
+    const scalar_a* a,
+    const scalar_b* b,
+    const float& dim_per_head,
+    const int& size,
+    float* out,
+    float& max) {
+  auto vec_ps_min = _mm256_set1_ps(std::numeric_limits<float>::lowest());
+  auto vec_a = vec_ps_min;
+  auto vec_b = vec_ps_min;
+  auto vec_out = vec_ps_min;
+
+  int i = 0;
+  float r_dim_per_head = 1.0 / dim_per_head;
+  auto vec_r_dim_per_head = _mm256_set1_ps(r_dim_per_head);
+  for (; i <= size - 8; i += 8) {
+    vec_a = _loadu(a + i);
+    vec_b = _loadu(b + i);
+    vec_out = _mm256_fmadd_ps(vec_a, vec_r_dim_per_head, vec_b);
+    vec_ps_min = _mm256_max_ps(vec_ps_min, vec_out);
+    _mm256_storeu_ps(out + i, vec_out);
+  }
+
+  float tail_max = _mm256_reduce_max_ps(vec_ps_min);
+  for (; i < size; i++) {
+    out[i] = float(a[i]) * r_dim_per_head + float(b[i]);
+    tail_max = std::max(tail_max, out[i]);
+  }
+
+  max = tail_max;
+}
+
+template <typename scalar_t>
+inline void _dil_maskedfill_div_max_fusion_kernel(
+    const scalar_t* a,
+    const float* b,
+    const float& fill_value,
+    const float& dim_per_head,
+    const int& size,
+    float* out,
+    float& max) {
+  auto vec_fill = _mm256_set1_ps(fill_value);
+  auto vec_ps_min = vec_fill;
+  auto mask_c = _mm256_set1_ps(1.0);
+  auto vec_dim_per_head = _mm256_set1_ps(dim_per_head);
+
+  auto vec_a = vec_ps_min;
+  auto vec_b = vec_ps_min;
+  auto vec_out = vec_ps_min;
+
+  int i = 0;
+  for (; i <= size - 8; i += 8) {
+    vec_a = _loadu(a + i);
+    vec_b = _loadu(b + i);
+    auto fill_mask = _mm256_cmp_ps(vec_b, mask_c, 12 /*_CMP_NEQ_OQ*/);
+    vec_out = _mm256_blendv_ps(
+        vec_fill, _mm256_div_ps(vec_a, vec_dim_per_head), fill_mask);
+    vec_ps_min = _mm256_max_ps(vec_ps_min, vec_out);
+    _mm256_storeu_ps(out + i, vec_out);
+  }
+
+  float tail_max = _mm256_reduce_max_ps(vec_ps_min);
+  for (; i < size; i++) {
+    out[i] = (b[i] != 1.0f) ? float(a[i]) / dim_per_head : fill_value;
+    tail_max = std::max(tail_max, out[i]);
+  }
+
+  max = tail_max;
+}
+
+inline void _dil_exp_reduce_sum_fusion_kernel(
+    float* a,
+    const int& size,
+    float* out,
+    float& val) {
+  auto vec_max = _mm256_set1_ps(val);
+  auto vec_sum = _mm256_set1_ps(0.f);
+  __m256 vec_a = {};
+  __m256 vec_out = {};
+
+  int i = 0;
+  for (; i <= size - 8; i += 8) {
+    vec_a = _mm256_loadu_ps(a + i);
+    vec_out = _mm256_sub_ps(vec_a, vec_max);
+    vec_out = _dil_exp_kernel(vec_out);
+    vec_sum = _mm256_add_ps(vec_sum, vec_out);
+    _mm256_storeu_ps(out + i, vec_out);
+  }
+
+  float tail_sum = _mm256_reduce_add_ps(vec_sum);
+  for (; i < size; i++) {
+    out[i] = _dil_exp_kernel_scalar(a[i] - val);
+    tail_sum += out[i];
+  }
+
+  val = tail_sum;
+}
+
+template <typename scalar_t>
+inline void _dil_normalization_kernel(
+    const float* a,
+    const float& sum,
+    const int& size,
+    scalar_t* out) {
+  auto vec_sum = _mm256_set1_ps(sum);
+
+  int i = 0;
+  for (; i <= size - 8; i += 8) {
+    auto vec_a = _mm256_loadu_ps(a + i);
+    auto vec_out = _mm256_div_ps(vec_a, vec_sum);
+    _storeu(out + i, vec_out);
+  }
+
+  for (; i < size; i++) {
+    out[i] = scalar_t(a[i] / sum);
+  }
+}
+
+template <typename scalar_t>
+inline void _dil_add_kernel(const scalar_t* src, float* dst, const int& size) {
+  __m256 vec_a = {};
+  __m256 vec_out = {};
+
+  int j = 0;
+  for (; j <= size - 8; j += 8) {
+    vec_a = _loadu(src + j);
+    vec_out = _loadu(dst + j);
+    vec_out = _mm256_add_ps(vec_a, vec_out);
+    _storeu(dst + j, vec_out);
+  }
+
+  for (; j < size; j++) {
+    dst[j] += float(src[j]);
+  }
+}
+
+inline void _dil_add_reduce_max_fusion_kernel(
+    float* a,
+    const float* b,
+    const int& size,
+    float* out,
+    float& max) {
+  auto vec_ps_min = _mm256_set1_ps(std::numeric_limits<float>::lowest());
+  auto vec_a = vec_ps_min;
+  auto vec_b = vec_ps_min;
+  auto vec_out = vec_ps_min;
+
+  int i = 0;
+  for (; i <= size - 8; i += 8) {
+    vec_a = _loadu(a + i);
+    vec_b = _loadu(b + i);
+    vec_out = _mm256_add_ps(vec_a, vec_b);
+    vec_ps_min = _mm256_max_ps(vec_ps_min, vec_out);
+    _mm256_storeu_ps(out + i, vec_out);
+  }
+
+  float tail_max = _mm256_reduce_max_ps(vec_ps_min);
+  for (; i < size; i++) {
+    out[i] = a[i] + b[i];
+    tail_max = std::max(tail_max, out[i]);
+  }
+
+  max = tail_max;
+}
+
+} // namespace kernel
+} // namespace cpu
+} // namespace torch_ipex
@@ -0,0 +1,2 @@
+#include "add_layernorm.h"
+#include "add_softmax.h"
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <immintrin.h>
+
+#include <ATen/ATen.h>
+
+// 256-bit counterparts of the generic load/store helpers in
+// vec512/perf_kernel/utils.h. AVX2 has no opmask registers, so there are no
+// masked variants here; the perf kernels handle the remainder elements with
+// scalar tail loops instead.
+
+inline __m256 _cvt_bf16_to_fp32(__m128i src) {
+  return _mm256_castsi256_ps(
+      _mm256_slli_epi32(_mm256_cvtepu16_epi32(src), 16));
+}
+
+inline __m128i _cvt_fp32_to_bf16(__m256 src) {
+  // Round-to-nearest-even, with NaN inputs forced to a quiet bf16 NaN.
+  __m256i value = _mm256_castps_si256(src);
+  __m256i nan = _mm256_set1_epi32(0xffff);
+  __m256i mask =
+      _mm256_castps_si256(_mm256_cmp_ps(src, src, 7 /*_CMP_ORD_Q*/));
+  __m256i ones = _mm256_set1_epi32(0x1);
+  __m256i vec_bias = _mm256_set1_epi32(0x7fff);
+  // uint32_t lsb = (input >> 16) & 1;
+  auto t_value = _mm256_and_si256(_mm256_srli_epi32(value, 16), ones);
+  // uint32_t rounding_bias = 0x7fff + lsb;
+  t_value = _mm256_add_epi32(t_value, vec_bias);
+  // input += rounding_bias;
+  t_value = _mm256_add_epi32(t_value, value);
+  // input = input >> 16;
+  t_value = _mm256_srli_epi32(t_value, 16);
+  t_value = _mm256_blendv_epi8(nan, t_value, mask);
+  t_value = _mm256_packus_epi32(t_value, t_value);
+  t_value = _mm256_permute4x64_epi64(t_value, 0xd8);
+  return _mm256_castsi256_si128(t_value);
+}
+
+// below is for unaligned data load
+inline __m256 _loadu(const float* data_base) {
+  return _mm256_loadu_ps(data_base);
+}
+
+inline __m256 _loadu(const at::BFloat16* data_base) {
+  return _cvt_bf16_to_fp32(_mm_loadu_si128((__m128i*)data_base));
+}
+
+inline __m256 _loadu(const at::Half* data_base) {
+  return _mm256_cvtph_ps(_mm_loadu_si128((__m128i*)data_base));
+}
+
+// below is for unaligned data store
+inline void _storeu(float* data_base, __m256 a) {
+  _mm256_storeu_ps(data_base, a);
+}
+
+inline void _storeu(at::BFloat16* data_base, __m256 a) {
+  _mm_storeu_si128((__m128i*)data_base, _cvt_fp32_to_bf16(a));
+}
+
+inline void _storeu(at::Half* data_base, __m256 a) {
+  _mm_storeu_si128(
+      (__m128i*)data_base,
+      _mm256_cvtps_ph(a, (_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)));
+}
+
+// horizontal reductions (AVX2 has no _mm256_reduce_* instructions)
+inline float _mm256_reduce_max_ps(__m256 a) {
+  __m128 hi = _mm256_extractf128_ps(a, 1);
+  __m128 lo = _mm256_castps256_ps128(a);
+  lo = _mm_max_ps(lo, hi);
+  lo = _mm_max_ps(lo, _mm_movehl_ps(lo, lo));
+  lo = _mm_max_ss(lo, _mm_shuffle_ps(lo, lo, 1));
+  return _mm_cvtss_f32(lo);
+}
+
+inline float _mm256_reduce_add_ps(__m256 a) {
+  __m128 hi = _mm256_extractf128_ps(a, 1);
+  __m128 lo = _mm256_castps256_ps128(a);
+  lo = _mm_add_ps(lo, hi);
+  lo = _mm_add_ps(lo, _mm_movehl_ps(lo, lo));
+  lo = _mm_add_ss(lo, _mm_shuffle_ps(lo, lo, 1));
+  return _mm_cvtss_f32(lo);
+}
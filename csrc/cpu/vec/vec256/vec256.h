@@ -1,3 +1,6 @@
 #include "vec256_bfloat16.h"
 #include "vec256_int8.h"
 #include "vec256_prefix_sum_ker.h"
+#include "vec256_strided_ker.h"
+
+#include "perf_kernel/kernel.h"
@@ -117,6 +117,90 @@ inline void packed_bf16_add_ker(
   }
 }
 
+// Fused add-cast: accumulate an FP32 source straight into a (top, bot) split
+// pair, so gradient accumulation does not need a separate FP32 buffer.
+inline void packed_bf16_add_ker(
+    at::BFloat16* a1,
+    at::BFloat16* a2,
+    const float* b,
+    int len,
+    float alpha) {
+  for (int i = 0; i < len; i++) {
+    uint32_t hi = (a1 + i)->x;
+    uint32_t lo = (a2 + i)->x;
+    uint32_t merge = hi << 16 | lo;
+    float a_val = *((float*)&merge);
+    float res = a_val + b[i] * alpha;
+    (a1 + i)->x = (uint16_t)((*((uint32_t*)(&res))) >> 16);
+    (a2 + i)->x = *((uint16_t*)(&res));
+  }
+}
+
+// All-ones in the lanes below rem (rem in [1, 8)); maskload/maskstore and
+// masked gathers key off the lane MSB.
+static IPEX_FORCE_INLINE __m256i _mm256_tail_mask(int64_t rem) {
+  auto iota = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  return _mm256_cmpgt_epi32(_mm256_set1_epi32((int)rem), iota);
+}
+
+template <>
+IPEX_FORCE_INLINE void move_ker(float* out, const float* in, int64_t len) {
+  int64_t i = 0;
+#pragma unroll(4)
+  for (i = 0; i < len - 7; i += 8) {
+    auto in0 = _mm256_loadu_ps(in + i);
+    _mm256_storeu_ps(out + i, in0);
+  }
+
+  if (i < len) {
+    auto mask = _mm256_tail_mask(len - i);
+    auto in0 = _mm256_maskload_ps(in + i, mask);
+    _mm256_maskstore_ps(out + i, mask, in0);
+  }
+}
+
+template <>
+IPEX_FORCE_INLINE void add_ker(float* inout, const float* in, int64_t len) {
+  int64_t i = 0;
+#pragma unroll(2)
+  for (i = 0; i < len - 15; i += 16) {
+    auto out1 = _mm256_loadu_ps(inout + i);
+    auto out2 = _mm256_loadu_ps(inout + i + 8);
+    auto in1 = _mm256_loadu_ps(in + i);
+    auto in2 = _mm256_loadu_ps(in + i + 8);
+    _mm256_storeu_ps(inout + i, _mm256_add_ps(out1, in1));
+    _mm256_storeu_ps(inout + i + 8, _mm256_add_ps(out2, in2));
+  }
+
+  if (i < len - 7) {
+    auto out1 = _mm256_loadu_ps(inout + i);
+    auto in1 = _mm256_loadu_ps(in + i);
+    _mm256_storeu_ps(inout + i, _mm256_add_ps(out1, in1));
+    i += 8;
+  }
+
+  if (i < len) {
+    auto mask = _mm256_tail_mask(len - i);
+    auto out1 = _mm256_maskload_ps(inout + i, mask);
+    auto in1 = _mm256_maskload_ps(in + i, mask);
+    _mm256_maskstore_ps(inout + i, mask, _mm256_add_ps(out1, in1));
+  }
+}
+
+static IPEX_FORCE_INLINE void zero_ker(float* out, int64_t len) {
+  int64_t i = 0;
+  auto zero_256 = _mm256_setzero_ps();
+#pragma unroll(4)
+  for (i = 0; i < len - 7; i += 8) {
+    _mm256_storeu_ps(out + i, zero_256);
+  }
+
+  if (i < len) {
+    auto mask = _mm256_tail_mask(len - i);
+    _mm256_maskstore_ps(out + i, mask, zero_256);
+  }
+}
+
 static IPEX_FORCE_INLINE void move_ker_load_aligned(
     at::BFloat16* out,
     const float* in,
@@ -0,0 +1,94 @@
+#pragma once
+#include <immintrin.h>
+
+#include "utils/SysUtil.h"
+
+namespace torch_ipex {
+namespace cpu {
+namespace kernel {
+
+// AVX2 specializations of the strided move/add primitives. AVX2 has
+// gathers but no scatters, so the strided-input/contiguous-output case is
+// fully vectorized while a strided output falls back to the scalar loop.
+// Strides are element strides. Per-lane offsets are computed as 32-bit
+// integers, which covers any stride below 2^28 elements.
+//
+// 16-bit element types (BFloat16/Half) have no gather support in the ISA
+// and keep using the generic ref form.
+
+static IPEX_FORCE_INLINE __m256i _mm256_stride_idx(int64_t stride) {
+  auto iota = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  return _mm256_mullo_epi32(iota, _mm256_set1_epi32((int)stride));
+}
+
+template <>
+IPEX_FORCE_INLINE void move_ker_stride(
+    float* out,
+    const float* in,
+    int64_t len,
+    int64_t out_stride,
+    int64_t in_stride) {
+  if (out_stride != 1) {
+    for (int64_t i = 0; i < len; i++) {
+      *(out + i * out_stride) = *(in + i * in_stride);
+    }
+    return;
+  }
+
+  auto in_idx = _mm256_stride_idx(in_stride);
+  int64_t i = 0;
+  for (; i < len - 7; i += 8) {
+    auto in0 = _mm256_i32gather_ps(in + i * in_stride, in_idx, 4);
+    _mm256_storeu_ps(out + i, in0);
+  }
+
+  if (i < len) {
+    auto mask = _mm256_tail_mask(len - i);
+    auto in0 = _mm256_mask_i32gather_ps(
+        _mm256_setzero_ps(),
+        in + i * in_stride,
+        in_idx,
+        _mm256_castsi256_ps(mask),
+        4);
+    _mm256_maskstore_ps(out + i, mask, in0);
+  }
+}
+
+template <>
+IPEX_FORCE_INLINE void add_ker_stride(
+    float* inout,
+    const float* in,
+    int64_t len,
+    int64_t inout_stride,
+    int64_t in_stride) {
+  if (inout_stride != 1) {
+    for (int64_t i = 0; i < len; i++) {
+      *(inout + i * inout_stride) += *(in + i * in_stride);
+    }
+    return;
+  }
+
+  auto in_idx = _mm256_stride_idx(in_stride);
+  int64_t i = 0;
+  for (; i < len - 7; i += 8) {
+    auto in0 = _mm256_i32gather_ps(in + i * in_stride, in_idx, 4);
+    auto out0 = _mm256_loadu_ps(inout + i);
+    _mm256_storeu_ps(inout + i, _mm256_add_ps(out0, in0));
+  }
+
+  if (i < len) {
+    auto mask = _mm256_tail_mask(len - i);
+    auto in0 = _mm256_mask_i32gather_ps(
+        _mm256_setzero_ps(),
+        in + i * in_stride,
+        in_idx,
+        _mm256_castsi256_ps(mask),
+        4);
+    auto out0 = _mm256_maskload_ps(inout + i, mask);
+    _mm256_maskstore_ps(inout + i, mask, _mm256_add_ps(out0, in0));
+  }
+}
+
+} // namespace kernel
+} // namespace cpu
+} // namespace torch_ipex
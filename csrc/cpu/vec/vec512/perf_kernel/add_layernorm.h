@@ -50,6 +50,45 @@ std::pair<float, float> _add_and_compute_mean_var(
   return std::make_pair(mean_var, var_val);
 }
 
+template <typename T>
+std::pair<float, float> _add3_and_compute_mean_var(
+    const T* a_ptr,
+    const T* b_ptr,
+    const T* c_ptr,
+    const int& size,
+    float* out) {
+  // three-input variant of _add_and_compute_mean_var, used by the fused
+  // embedding + layernorm kernel (token + position + segment rows)
+  auto vec_acc_mean = _mm512_set1_ps(0.0);
+  auto vec_acc_pow = _mm512_set1_ps(0.0);
+
+  int i = 0;
+  for (; i <= size - 16; i += 16) {
+    auto vec_a = _loadu(a_ptr + i);
+    auto vec_b = _loadu(b_ptr + i);
+    auto vec_c = _loadu(c_ptr + i);
+    auto vec_add = _mm512_add_ps(_mm512_add_ps(vec_a, vec_b), vec_c);
+    vec_acc_mean = _mm512_add_ps(vec_add, vec_acc_mean);
+    _mm512_storeu_ps(out + i, vec_add);
+    vec_acc_pow = _mm512_fmadd_ps(vec_add, vec_add, vec_acc_pow);
+  }
+
+  if (i < size) {
+    __mmask16 mask = (1 << (size - i)) - 1;
+    auto vec_a = _maskz_loadu(a_ptr + i, mask);
+    auto vec_b = _maskz_loadu(b_ptr + i, mask);
+    auto vec_c = _maskz_loadu(c_ptr + i, mask);
+    auto vec_add = _mm512_add_ps(_mm512_add_ps(vec_a, vec_b), vec_c);
+
+    vec_acc_mean = _mm512_add_ps(vec_add, vec_acc_mean);
+    _mm512_mask_storeu_ps(out + i, mask, vec_add);
+    vec_acc_pow = _mm512_fmadd_ps(vec_add, vec_add, vec_acc_pow);
+  }
+  float mean_var = _mm512_reduce_add_ps(vec_acc_mean) / float(size);
+  float var_val = _mm512_reduce_add_ps(vec_acc_pow);
+  return std::make_pair(mean_var, var_val);
+}
+
 template <typename T, typename T1>
 void _normalize_kernel(
     T* out_ptr,
@@ -662,6 +662,68 @@ void _reduce_head(
   }
 }
 
+// Quantized-cache variant of _reduce_head: the key block holds int8
+// values with one scale per token/head entry, dequantized on the fly
+// inside the AVX-512 inner loop.
+template <typename QT>
+void _reduce_head_quant(
+    const QT* q_ptr_start,
+    const int8_t* k_cache_start,
+    const float& k_scale,
+    float* attn_w_pos,
+    int64_t head_size) {
+  auto hsi = 0;
+  auto vec_size = 16; // 512/32
+  auto vec_k_scale = _mm512_set1_ps(k_scale);
+  auto qk_sum_vec = _mm512_setzero_ps();
+  for (hsi = 0; hsi <= head_size - vec_size; hsi += vec_size) {
+    auto q_vec = _loadu(q_ptr_start + hsi);
+    auto k_vec_i32 = _mm512_cvtepi8_epi32(
+        _mm_loadu_si128((__m128i const*)(k_cache_start + hsi)));
+    auto k_vec = _mm512_mul_ps(_mm512_cvtepi32_ps(k_vec_i32), vec_k_scale);
+    qk_sum_vec = _mm512_fmadd_ps(q_vec, k_vec, qk_sum_vec);
+  }
+  attn_w_pos[0] += _mm512_reduce_add_ps(qk_sum_vec);
+  for (; hsi < head_size; hsi++) {
+    attn_w_pos[0] +=
+        (float)q_ptr_start[hsi] * (float)k_cache_start[hsi] * k_scale;
+  }
+}
+
+// Quantized-cache variant of _mul_and_accumulate.
+template <typename OT>
+inline void _mul_and_accumulate_quant(
+    const float& attn_w,
+    const int8_t* v_cache_start,
+    const float& v_scale,
+    OT* attn_out_start,
+    int64_t head_size,
+    int accumulated) {
+  auto vec_size = 16; // 512/32
+  auto hsi = 0;
+  auto attn_w_vec = _mm512_set1_ps(attn_w * v_scale);
+  for (hsi = 0; hsi <= head_size - vec_size; hsi += vec_size) {
+    auto v_vec_i32 = _mm512_cvtepi8_epi32(
+        _mm_loadu_si128((__m128i const*)(v_cache_start + hsi)));
+    auto v_vec = _mm512_cvtepi32_ps(v_vec_i32);
+    if (accumulated) {
+      auto attn_out_vec = _loadu(attn_out_start + hsi);
+      auto attn_out_vec_new = _mm512_fmadd_ps(attn_w_vec, v_vec, attn_out_vec);
+      _storeu(attn_out_start + hsi, attn_out_vec_new);
+    } else {
+      auto attn_out_vec_new = _mm512_mul_ps(attn_w_vec, v_vec);
+      _storeu(attn_out_start + hsi, attn_out_vec_new);
+    }
+  }
+  for (; hsi < head_size; hsi++) {
+    if (accumulated) {
+      attn_out_start[hsi] += attn_w * v_scale * (float)v_cache_start[hsi];
+    } else {
+      attn_out_start[hsi] = attn_w * v_scale * (float)v_cache_start[hsi];
+    }
+  }
+}
+
 template <typename VT, typename OT, typename CT>
 inline void _mul_and_accumulate(
     const float& attn_w,
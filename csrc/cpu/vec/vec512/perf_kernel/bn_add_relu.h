@@ -0,0 +1,130 @@
+#pragma once
+
+#include <immintrin.h>
+
+#include <ATen/ATen.h>
+#include <ATen/Parallel.h>
+#include <limits>
+#include "utils.h"
+
+namespace torch_ipex {
+namespace cpu {
+namespace kernel {
+
+//  Single-pass frozen BatchNorm inference with an optional residual add
+//  and ReLU: out = max(0, in * scale + beta [+ add]). The per-channel
+//  scale/beta constants are precomputed at graph-rewrite time, so the
+//  three eager passes (bn, add, relu) collapse into one read of the
+//  activations. Channels-last only: the channel dimension is innermost
+//  and maps directly onto the vector lanes; tails are masked.
+template <typename T, typename ACC_T>
+static typename std::enable_if<!is_reduced_floating_point_v<T>, void>::type
+_bn_add_relu_kernel_channels_last(
+    const T* in_ptr,
+    const T* add_ptr,
+    T* out_ptr,
+    const ACC_T* scale_ptr,
+    const ACC_T* beta_ptr,
+    int64_t total_size_except_channels,
+    int64_t channels) {
+  auto zero = _mm512_set1_ps(0.0);
+#ifdef _OPENMP
+#if (_OPENMP >= 201307)
+#pragma omp parallel for simd schedule( \
+    static) if (omp_get_max_threads() > 1 && !omp_in_parallel())
+#else
+#pragma omp parallel for schedule( \
+    static) if (omp_get_max_threads() > 1 && !omp_in_parallel())
+#endif
+#endif
+  for (int64_t i = 0; i < total_size_except_channels; ++i) {
+    int64_t k = 0;
+    for (; k + 16 <= channels; k += 16) {
+      auto in = _mm512_loadu_ps(in_ptr + i * channels + k);
+      auto beta = _mm512_loadu_ps(beta_ptr + k);
+      auto scale = _mm512_loadu_ps(scale_ptr + k);
+      auto bn_out = _mm512_add_ps(beta, _mm512_mul_ps(scale, in));
+      if (add_ptr != nullptr) {
+        bn_out = _mm512_add_ps(
+            bn_out, _mm512_loadu_ps(add_ptr + i * channels + k));
+      }
+      auto out = _mm512_max_ps(zero, bn_out);
+      _mm512_storeu_ps(out_ptr + i * channels + k, out);
+    }
+    //  Masked tail for channel counts not divisible by the vector width.
+    if (k < channels) {
+      __mmask16 mask = (1 << (channels - k)) - 1;
+      auto in = _mm512_maskz_loadu_ps(mask, in_ptr + i * channels + k);
+      auto beta = _mm512_maskz_loadu_ps(mask, beta_ptr + k);
+      auto scale = _mm512_maskz_loadu_ps(mask, scale_ptr + k);
+      auto bn_out = _mm512_add_ps(beta, _mm512_mul_ps(scale, in));
+      if (add_ptr != nullptr) {
+        bn_out = _mm512_add_ps(
+            bn_out, _mm512_maskz_loadu_ps(mask, add_ptr + i * channels + k));
+      }
+      auto out = _mm512_max_ps(zero, bn_out);
+      _mm512_mask_storeu_ps(out_ptr + i * channels + k, mask, out);
+    }
+  }
+}
+
+template <typename T, typename ACC_T>
+static typename std::enable_if<is_reduced_floating_point_v<T>, void>::type
+_bn_add_relu_kernel_channels_last(
+    const T* in_ptr,
+    const T* add_ptr,
+    T* out_ptr,
+    const float* scale_ptr,
+    const float* beta_ptr,
+    int64_t total_size_except_channels,
+    int64_t channels) {
+  auto zero = _mm512_set1_ps(0.0);
+#ifdef _OPENMP
+#if (_OPENMP >= 201307)
+#pragma omp parallel for simd schedule( \
+    static) if (omp_get_max_threads() > 1 && !omp_in_parallel())
+#else
+#pragma omp parallel for schedule( \
+    static) if (omp_get_max_threads() > 1 && !omp_in_parallel())
+#endif
+#endif
+  for (int64_t i = 0; i < total_size_except_channels; ++i) {
+    int64_t k = 0;
+    for (; k + 16 <= channels; k += 16) {
+      auto in = cvt_to_fp32<T>(
+          _mm256_loadu_si256((__m256i*)(in_ptr + i * channels + k)));
+      auto beta = _mm512_loadu_ps(beta_ptr + k);
+      auto scale = _mm512_loadu_ps(scale_ptr + k);
+      auto bn_out = _mm512_add_ps(beta, _mm512_mul_ps(scale, in));
+      if (add_ptr != nullptr) {
+        auto add = cvt_to_fp32<T>(
+            _mm256_loadu_si256((__m256i*)(add_ptr + i * channels + k)));
+        bn_out = _mm512_add_ps(bn_out, add);
+      }
+      auto out = _mm512_max_ps(zero, bn_out);
+      _mm256_storeu_si256(
+          (__m256i*)(out_ptr + i * channels + k), cvt_from_fp32<T>(out));
+    }
+    //  Masked tail for channel counts not divisible by the vector width.
+    if (k < channels) {
+      __mmask16 mask = (1 << (channels - k)) - 1;
+      auto in = cvt_to_fp32<T>(
+          _mm256_maskz_loadu_epi16(mask, (__m256i*)(in_ptr + i * channels + k)));
+      auto beta = _mm512_maskz_loadu_ps(mask, beta_ptr + k);
+      auto scale = _mm512_maskz_loadu_ps(mask, scale_ptr + k);
+      auto bn_out = _mm512_add_ps(beta, _mm512_mul_ps(scale, in));
+      if (add_ptr != nullptr) {
+        auto add = cvt_to_fp32<T>(_mm256_maskz_loadu_epi16(
+            mask, (__m256i*)(add_ptr + i * channels + k)));
+        bn_out = _mm512_add_ps(bn_out, add);
+      }
+      auto out = _mm512_max_ps(zero, bn_out);
+      _mm256_mask_storeu_epi16(
+          (__m256i*)(out_ptr + i * channels + k), mask, cvt_from_fp32<T>(out));
+    }
+  }
+}
+
+} // namespace kernel
+} // namespace cpu
+} // namespace torch_ipex
@@ -53,7 +53,8 @@ _concat_bn_relu_kernel_channels_last(
   for (int64_t i = 0; i < total_size_except_channels; ++i) {
     for (int64_t j = 0; j < in_ptr.size(); ++j) {
       auto concat_in_ptr = in_ptr[j] + i * in_ch[j + 1] - (i + 1) * in_ch[j];
-      for (int64_t k = in_ch[j]; k < in_ch[j + 1]; k += 16) {
+      int64_t k = in_ch[j];
+      for (; k + 16 <= in_ch[j + 1]; k += 16) {
         auto in = _mm512_loadu_ps(concat_in_ptr + k);
         auto beta = _mm512_loadu_ps(beta_ptr + k);
         auto scale = _mm512_loadu_ps(scale_ptr + k);
@@ -61,6 +62,16 @@ _concat_bn_relu_kernel_channels_last(
         auto out = _mm512_max_ps(zero, bn_out);
         _mm512_storeu_ps(out_ptr + i * co + k, out);
       }
+      //  Masked tail for channel counts not divisible by the vector width.
+      if (k < in_ch[j + 1]) {
+        __mmask16 mask = (1 << (in_ch[j + 1] - k)) - 1;
+        auto in = _mm512_maskz_loadu_ps(mask, concat_in_ptr + k);
+        auto beta = _mm512_maskz_loadu_ps(mask, beta_ptr + k);
+        auto scale = _mm512_maskz_loadu_ps(mask, scale_ptr + k);
+        auto bn_out = _mm512_add_ps(beta, _mm512_mul_ps(scale, in));
+        auto out = _mm512_max_ps(zero, bn_out);
+        _mm512_mask_storeu_ps(out_ptr + i * co + k, mask, out);
+      }
     }
   }
 }
@@ -89,7 +100,8 @@ _concat_bn_relu_kernel_channels_last(
   for (int64_t i = 0; i < total_size_except_channels; ++i) {
     for (int64_t j = 0; j < in_ptr.size(); ++j) {
       auto concat_in_ptr = in_ptr[j] + i * in_ch[j + 1] - (i + 1) * in_ch[j];
-      for (int64_t k = in_ch[j]; k < in_ch[j + 1]; k += 16) {
+      int64_t k = in_ch[j];
+      for (; k + 16 <= in_ch[j + 1]; k += 16) {
         auto in =
             cvt_to_fp32<T>(_mm256_loadu_si256((__m256i*)(concat_in_ptr + k)));
         auto beta = _mm512_loadu_ps(beta_ptr + k);
@@ -99,6 +111,18 @@ _concat_bn_relu_kernel_channels_last(
         _mm256_storeu_si256(
             (__m256i*)(out_ptr + i * co + k), cvt_from_fp32<T>(out));
       }
+      //  Masked tail for channel counts not divisible by the vector width.
+      if (k < in_ch[j + 1]) {
+        __mmask16 mask = (1 << (in_ch[j + 1] - k)) - 1;
+        auto in = cvt_to_fp32<T>(
+            _mm256_maskz_loadu_epi16(mask, (__m256i*)(concat_in_ptr + k)));
+        auto beta = _mm512_maskz_loadu_ps(mask, beta_ptr + k);
+        auto scale = _mm512_maskz_loadu_ps(mask, scale_ptr + k);
+        auto bn_out = _mm512_add_ps(beta, _mm512_mul_ps(scale, in));
+        auto out = _mm512_max_ps(zero, bn_out);
+        _mm256_mask_storeu_epi16(
+            (__m256i*)(out_ptr + i * co + k), mask, cvt_from_fp32<T>(out));
+      }
     }
   }
 }
@@ -0,0 +1,275 @@
+#pragma once
+
+#include <immintrin.h>
+
+#include <ATen/ATen.h>
+#include <cstdint>
+#include "utils.h"
+#include "utils/philox_rand.h"
+
+namespace torch_ipex {
+namespace cpu {
+namespace kernel {
+
+// Row kernels for the fused dropout + residual add + layernorm op. The
+// dropout mask is kept bit-packed (bit j of byte k covers element 8k+j,
+// set when the element is kept) so training does not materialize a full
+// RNG tensor; the backward kernels fuse the mask apply into the layernorm
+// input-gradient pass.
+
+// Runs four Philox4x32-10 blocks (counters block .. block+3) keyed by
+// (seed, subsequence) in the 128-bit sublanes of one zmm register and
+// returns their 16 outputs; lane l holds draw 4 * block + l of the
+// stream. The two 32x32 multiplies of each round land in the even lanes
+// via _mm512_mul_epu32, and the output permutation plus key injection
+// fold into one shuffle and two xors per round.
+inline __m512i _philox4x32x4(
+    uint64_t seed,
+    uint64_t subsequence,
+    uint32_t block) {
+  const __m512i vec_mul =
+      _mm512_set4_epi32(0, (int)kPhiloxM1, 0, (int)kPhiloxM0);
+  const __m512i vec_w = _mm512_set4_epi32(0, (int)kPhiloxW1, 0, (int)kPhiloxW0);
+  uint32_t sub_lo = (uint32_t)subsequence;
+  uint32_t sub_hi = (uint32_t)(subsequence >> 32);
+  __m512i vec_ctr = _mm512_set_epi32(
+      sub_hi,
+      sub_lo,
+      0,
+      (int)(block + 3),
+      sub_hi,
+      sub_lo,
+      0,
+      (int)(block + 2),
+      sub_hi,
+      sub_lo,
+      0,
+      (int)(block + 1),
+      sub_hi,
+      sub_lo,
+      0,
+      (int)block);
+  __m512i vec_key = _mm512_set4_epi32(
+      0, (int)(uint32_t)(seed >> 32), 0, (int)(uint32_t)seed);
+  for (int round = 0; round < 10; round++) {
+    // 32-lane view per counter block: products are [lo0, hi0, lo1, hi1],
+    // the next counter is [hi1 ^ c1 ^ k0, lo1, hi0 ^ c3 ^ k1, lo0]
+    __m512i vec_prod = _mm512_mul_epu32(vec_ctr, vec_mul);
+    __m512i vec_shuf_prod = _mm512_shuffle_epi32(
+        vec_prod, (_MM_PERM_ENUM)_MM_SHUFFLE(0, 1, 2, 3));
+    __m512i vec_shuf_ctr = _mm512_maskz_shuffle_epi32(
+        (__mmask16)0x5555, vec_ctr, (_MM_PERM_ENUM)_MM_SHUFFLE(0, 3, 0, 1));
+    vec_ctr = _mm512_xor_si512(
+        _mm512_xor_si512(vec_shuf_prod, vec_shuf_ctr), vec_key);
+    vec_key = _mm512_add_epi32(vec_key, vec_w);
+  }
+  return vec_ctr;
+}
+
+// Computes out = dropout(a) + b where dropout keeps element e of the row
+// when Philox draw e of the (seed, row) stream is >= threshold, and
+// scales kept elements by scale (1 / (1 - p)). The draws are
+// position-addressed with no shared generator state, so the mask depends
+// only on (seed, row) -- not on thread partitioning -- and all 16 keep
+// decisions of a vector come from one _philox4x32x4 call plus an
+// unsigned compare. Stores the fp32 result to out, packs the keep bits
+// into mask_ptr and returns (mean, raw sum of squares) of out, matching
+// _add_and_compute_mean_var.
+template <typename T>
+std::pair<float, float> _dropout_add_and_compute_mean_var(
+    const T* a_ptr,
+    const T* b_ptr,
+    const int& size,
+    float scale,
+    uint32_t threshold,
+    uint64_t seed,
+    uint64_t row,
+    uint8_t* mask_ptr,
+    float* out) {
+  auto vec_acc_mean = _mm512_set1_ps(0.0);
+  auto vec_acc_pow = _mm512_set1_ps(0.0);
+  auto vec_scale = _mm512_set1_ps(scale);
+  auto vec_threshold = _mm512_set1_epi32((int)threshold);
+
+  int i = 0;
+  for (; i <= size - 16; i += 16) {
+    __m512i vec_draw = _philox4x32x4(seed, row, (uint32_t)(i / 4));
+    __mmask16 keep = _mm512_cmpge_epu32_mask(vec_draw, vec_threshold);
+    mask_ptr[i / 8] = (uint8_t)(keep & 0xff);
+    mask_ptr[i / 8 + 1] = (uint8_t)(keep >> 8);
+    auto vec_a = _maskz_loadu(a_ptr + i, keep);
+    auto vec_b = _loadu(b_ptr + i);
+    auto vec_add = _mm512_fmadd_ps(vec_a, vec_scale, vec_b);
+    vec_acc_mean = _mm512_add_ps(vec_add, vec_acc_mean);
+    _mm512_storeu_ps(out + i, vec_add);
+    vec_acc_pow = _mm512_fmadd_ps(vec_add, vec_add, vec_acc_pow);
+  }
+
+  if (i < size) {
+    int rem = size - i;
+    __mmask16 tail = (1 << rem) - 1;
+    __m512i vec_draw = _philox4x32x4(seed, row, (uint32_t)(i / 4));
+    __mmask16 keep = _mm512_cmpge_epu32_mask(vec_draw, vec_threshold) & tail;
+    mask_ptr[i / 8] = (uint8_t)(keep & 0xff);
+    if (rem > 8) {
+      mask_ptr[i / 8 + 1] = (uint8_t)(keep >> 8);
+    }
+    auto vec_a = _maskz_loadu(a_ptr + i, keep);
+    auto vec_b = _maskz_loadu(b_ptr + i, tail);
+    auto vec_add = _mm512_fmadd_ps(vec_a, vec_scale, vec_b);
+    vec_acc_mean = _mm512_add_ps(vec_add, vec_acc_mean);
+    _mm512_mask_storeu_ps(out + i, tail, vec_add);
+    vec_acc_pow = _mm512_fmadd_ps(vec_add, vec_add, vec_acc_pow);
+  }
+  float mean_var = _mm512_reduce_add_ps(vec_acc_mean) / float(size);
+  float var_val = _mm512_reduce_add_ps(vec_acc_pow);
+  return std::make_pair(mean_var, var_val);
+}
+
+// First backward pass over one row: with g = dy * gamma and
+// xhat = (x - mean) * rstd, returns (sum(g * xhat), sum(g)).
+template <typename T, typename T1>
+std::pair<float, float> _ln_bwd_reduce(
+    const T* dy_ptr,
+    const T* x_ptr,
+    const T1* gamma_ptr,
+    const int& size,
+    float mean,
+    float rstd) {
+  auto vec_mean = _mm512_set1_ps(mean);
+  auto vec_rstd = _mm512_set1_ps(rstd);
+  auto vec_acc_gx = _mm512_set1_ps(0.0);
+  auto vec_acc_g = _mm512_set1_ps(0.0);
+
+  int i = 0;
+  for (; i <= size - 16; i += 16) {
+    auto vec_g = _loadu(dy_ptr + i);
+    if (gamma_ptr) {
+      vec_g = _mm512_mul_ps(vec_g, _loadu(gamma_ptr + i));
+    }
+    auto vec_x = _loadu(x_ptr + i);
+    auto vec_xhat = _mm512_mul_ps(_mm512_sub_ps(vec_x, vec_mean), vec_rstd);
+    vec_acc_gx = _mm512_fmadd_ps(vec_g, vec_xhat, vec_acc_gx);
+    vec_acc_g = _mm512_add_ps(vec_g, vec_acc_g);
+  }
+  if (i < size) {
+    __mmask16 mask = (1 << (size - i)) - 1;
+    auto vec_g = _maskz_loadu(dy_ptr + i, mask);
+    if (gamma_ptr) {
+      vec_g = _mm512_mul_ps(vec_g, _maskz_loadu(gamma_ptr + i, mask));
+    }
+    auto vec_x = _maskz_loadu(x_ptr + i, mask);
+    auto vec_xhat = _mm512_maskz_mul_ps(
+        mask, _mm512_sub_ps(vec_x, vec_mean), vec_rstd);
+    vec_acc_gx = _mm512_fmadd_ps(vec_g, vec_xhat, vec_acc_gx);
+    vec_acc_g = _mm512_add_ps(vec_g, vec_acc_g);
+  }
+  return std::make_pair(
+      _mm512_reduce_add_ps(vec_acc_gx), _mm512_reduce_add_ps(vec_acc_g));
+}
+
+// Second backward pass over one row: dx = (g - c1 * xhat - c2) * rstd is
+// the gradient of the dropout-add output, which flows unchanged to the
+// residual (db) and through the bit-packed dropout mask, rescaled, to the
+// dropped-out input (da).
+template <typename T, typename T1>
+void _ln_dropout_bwd_apply(
+    T* da_ptr,
+    T* db_ptr,
+    const T* dy_ptr,
+    const T* x_ptr,
+    const T1* gamma_ptr,
+    const uint8_t* mask_ptr,
+    const int& size,
+    float mean,
+    float rstd,
+    float c1,
+    float c2,
+    float scale) {
+  auto vec_mean = _mm512_set1_ps(mean);
+  auto vec_rstd = _mm512_set1_ps(rstd);
+  auto vec_c1 = _mm512_set1_ps(c1);
+  auto vec_c2 = _mm512_set1_ps(c2);
+  auto vec_scale = _mm512_set1_ps(scale);
+
+  int i = 0;
+  for (; i <= size - 16; i += 16) {
+    __mmask16 keep =
+        (__mmask16)mask_ptr[i / 8] | ((__mmask16)mask_ptr[i / 8 + 1] << 8);
+    auto vec_g = _loadu(dy_ptr + i);
+    if (gamma_ptr) {
+      vec_g = _mm512_mul_ps(vec_g, _loadu(gamma_ptr + i));
+    }
+    auto vec_x = _loadu(x_ptr + i);
+    auto vec_xhat = _mm512_mul_ps(_mm512_sub_ps(vec_x, vec_mean), vec_rstd);
+    auto vec_dx = _mm512_sub_ps(
+        _mm512_sub_ps(vec_g, _mm512_mul_ps(vec_c1, vec_xhat)), vec_c2);
+    vec_dx = _mm512_mul_ps(vec_dx, vec_rstd);
+    _storeu(db_ptr + i, vec_dx);
+    auto vec_da = _mm512_maskz_mul_ps(keep, vec_dx, vec_scale);
+    _storeu(da_ptr + i, vec_da);
+  }
+  if (i < size) {
+    int rem = size - i;
+    __mmask16 tail = (1 << rem) - 1;
+    __mmask16 keep = (__mmask16)mask_ptr[i / 8];
+    if (rem > 8) {
+      keep |= (__mmask16)mask_ptr[i / 8 + 1] << 8;
+    }
+    keep &= tail;
+    auto vec_g = _maskz_loadu(dy_ptr + i, tail);
+    if (gamma_ptr) {
+      vec_g = _mm512_mul_ps(vec_g, _maskz_loadu(gamma_ptr + i, tail));
+    }
+    auto vec_x = _maskz_loadu(x_ptr + i, tail);
+    auto vec_xhat = _mm512_mul_ps(_mm512_sub_ps(vec_x, vec_mean), vec_rstd);
+    auto vec_dx = _mm512_sub_ps(
+        _mm512_sub_ps(vec_g, _mm512_mul_ps(vec_c1, vec_xhat)), vec_c2);
+    vec_dx = _mm512_mul_ps(vec_dx, vec_rstd);
+    _mask_storeu(db_ptr + i, vec_dx, tail);
+    auto vec_da = _mm512_maskz_mul_ps(keep, vec_dx, vec_scale);
+    _mask_storeu(da_ptr + i, vec_da, tail);
+  }
+}
+
+// Accumulates the affine-parameter gradients of one row into fp32 thread
+// buffers: dgamma_acc += dy * xhat and dbeta_acc += dy.
+template <typename T>
+void _ln_param_grad_acc(
+    float* dgamma_acc,
+    float* dbeta_acc,
+    const T* dy_ptr,
+    const T* x_ptr,
+    const int& size,
+    float mean,
+    float rstd) {
+  auto vec_mean = _mm512_set1_ps(mean);
+  auto vec_rstd = _mm512_set1_ps(rstd);
+
+  int i = 0;
+  for (; i <= size - 16; i += 16) {
+    auto vec_dy = _loadu(dy_ptr + i);
+    auto vec_x = _loadu(x_ptr + i);
+    auto vec_xhat = _mm512_mul_ps(_mm512_sub_ps(vec_x, vec_mean), vec_rstd);
+    auto vec_dg = _mm512_loadu_ps(dgamma_acc + i);
+    auto vec_db = _mm512_loadu_ps(dbeta_acc + i);
+    _mm512_storeu_ps(dgamma_acc + i, _mm512_fmadd_ps(vec_dy, vec_xhat, vec_dg));
+    _mm512_storeu_ps(dbeta_acc + i, _mm512_add_ps(vec_dy, vec_db));
+  }
+  if (i < size) {
+    __mmask16 mask = (1 << (size - i)) - 1;
+    auto vec_dy = _maskz_loadu(dy_ptr + i, mask);
+    auto vec_x = _maskz_loadu(x_ptr + i, mask);
+    auto vec_xhat = _mm512_mul_ps(_mm512_sub_ps(vec_x, vec_mean), vec_rstd);
+    auto vec_dg = _mm512_maskz_loadu_ps(mask, dgamma_acc + i);
+    auto vec_db = _mm512_maskz_loadu_ps(mask, dbeta_acc + i);
+    _mm512_mask_storeu_ps(
+        dgamma_acc + i, mask, _mm512_fmadd_ps(vec_dy, vec_xhat, vec_dg));
+    _mm512_mask_storeu_ps(
+        dbeta_acc + i, mask, _mm512_add_ps(vec_dy, vec_db));
+  }
+}
+
+} // namespace kernel
+} // namespace cpu
+} // namespace torch_ipex
@@ -1,6 +1,8 @@
 #include "add_layernorm.h"
 #include "add_softmax.h"
 #include "add_swish.h"
+#include "bn_add_relu.h"
 #include "concat_bn_relu.h"
+#include "dropout_add_layernorm.h"
 #include "rmsnorm.h"
 #include "update_batch.h"
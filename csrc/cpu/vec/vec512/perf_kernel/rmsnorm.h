@@ -55,6 +55,79 @@ void _compute_rmsnorm(
   }
 }
 
+// Fused rmsnorm + per-tensor affine quantization over one row. Reuses
+// the rmsnorm math above but folds the optional per-channel smoothing
+// factors (smooth-quant) and the int8 conversion into the second pass,
+// so the normalized values never leave the registers before they are
+// quantized. qmin/qmax carry the output range (int8 or uint8); the
+// clamp runs in float so the plain truncating byte store is exact.
+template <typename T, typename T1, typename Tq>
+void _compute_rmsnorm_quant(
+    const T* a_ptr,
+    const int& size,
+    float eps,
+    const T1* gamma_ptr,
+    const float* smooth_ptr,
+    float inv_scale,
+    int32_t zero_point,
+    float qmin,
+    float qmax,
+    Tq* out_ptr) {
+  auto vec_acc_pow = _mm512_set1_ps(0.0);
+  int i;
+  for (i = 0; i <= size - 16; i += 16) {
+    auto vec_a = _loadu(a_ptr + i);
+    auto s = vec_a * vec_a;
+    vec_acc_pow += s;
+  }
+  if (i < size) {
+    __mmask16 mask = (1 << (size - i)) - 1;
+    auto vec_a = _maskz_loadu(a_ptr + i, mask);
+    auto s = vec_a * vec_a;
+    vec_acc_pow += s;
+  }
+  float var_val = _mm512_reduce_add_ps(vec_acc_pow) / static_cast<float>(size);
+  float scale = float(1.0) / std::sqrt(var_val + eps);
+  auto vec_scale = _mm512_set1_ps(scale);
+  auto vec_inv_qscale = _mm512_set1_ps(inv_scale);
+  auto vec_zp = _mm512_set1_ps(static_cast<float>(zero_point));
+  auto vec_qmin = _mm512_set1_ps(qmin);
+  auto vec_qmax = _mm512_set1_ps(qmax);
+  for (i = 0; i <= size - 16; i += 16) {
+    auto vec_input = _loadu(a_ptr + i);
+    auto vec_gamma = _mm512_set1_ps(1.0);
+    if (gamma_ptr) {
+      vec_gamma = _loadu(gamma_ptr + i);
+    }
+    auto vec_res = vec_input * vec_scale * vec_gamma;
+    if (smooth_ptr) {
+      vec_res = vec_res * _mm512_loadu_ps(smooth_ptr + i);
+    }
+    auto vec_q = vec_res * vec_inv_qscale + vec_zp;
+    vec_q = _mm512_min_ps(_mm512_max_ps(vec_q, vec_qmin), vec_qmax);
+    auto vec_i32 = _mm512_cvt_roundps_epi32(
+        vec_q, (_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+    _mm512_mask_cvtepi32_storeu_epi8(out_ptr + i, 0xffff, vec_i32);
+  }
+  if (i < size) {
+    __mmask16 mask = (1 << (size - i)) - 1;
+    auto vec_input = _maskz_loadu(a_ptr + i, mask);
+    auto vec_gamma = _mm512_set1_ps(1.0);
+    if (gamma_ptr) {
+      vec_gamma = _maskz_loadu(gamma_ptr + i, mask);
+    }
+    auto vec_res = vec_input * vec_scale * vec_gamma;
+    if (smooth_ptr) {
+      vec_res = vec_res * _mm512_maskz_loadu_ps(mask, smooth_ptr + i);
+    }
+    auto vec_q = vec_res * vec_inv_qscale + vec_zp;
+    vec_q = _mm512_min_ps(_mm512_max_ps(vec_q, vec_qmin), vec_qmax);
+    auto vec_i32 = _mm512_cvt_roundps_epi32(
+        vec_q, (_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+    _mm512_mask_cvtepi32_storeu_epi8(out_ptr + i, mask, vec_i32);
+  }
+}
+
 } // namespace kernel
 } // namespace cpu
 } // namespace torch_ipex
@@ -255,6 +255,34 @@ inline bool should_update_feature(const at::Tensor& blankness_out, int len) {
   return false;
 }
 
+// Compacts the indices of nonzero lanes of an int32 flag vector into idx
+// (e.g. the batch positions whose symbol was not blank). Returns the number
+// of indices written. The compress store keeps the indices in batch order,
+// matching the scalar push_back formulation it replaces.
+inline int64_t compact_nonzero_idx(
+    const int32_t* flags,
+    int32_t* idx,
+    int64_t len) {
+  int64_t n = 0;
+  int64_t i = 0;
+  __m512i iota = _mm512_set_epi32(
+      15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+  __m512i zero = _mm512_setzero_si512();
+  for (; i <= len - 16; i += 16) {
+    __m512i flags_epi32 = _mm512_loadu_si512(flags + i);
+    __mmask16 mask = _mm512_cmpneq_epi32_mask(flags_epi32, zero);
+    __m512i lane_idx = _mm512_add_epi32(iota, _mm512_set1_epi32((int32_t)i));
+    _mm512_mask_compressstoreu_epi32(idx + n, mask, lane_idx);
+    n += _mm_popcnt_u32(mask);
+  }
+  for (; i < len; i++) {
+    if (flags[i] != 0) {
+      idx[n++] = (int32_t)i;
+    }
+  }
+  return n;
+}
+
 inline bool all_time_idxs_processed_kernel(
     const at::Tensor& blankvec_out,
     int len) {
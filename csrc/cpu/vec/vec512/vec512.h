@@ -1,4 +1,6 @@
 #include "vec512_int8.h"
 #include "vec512_lower_precision.h"
+#include "vec512_prefix_sum_ker.h"
+#include "vec512_strided_ker.h"
 
 #include "perf_kernel/kernel.h"
@@ -211,6 +211,66 @@ inline void packed_bf16_add_ker(
   }
 }
 
+// Fused add-cast: accumulate an FP32 source straight into a (top, bot) split
+// pair, so gradient accumulation does not need a separate FP32 buffer.
+inline void packed_bf16_add_ker(
+    at::BFloat16* a1,
+    at::BFloat16* a2,
+    const float* b,
+    int len,
+    float alpha) {
+  auto vAlpha = _mm512_set1_ps(alpha);
+  int i = 0;
+  for (; i < len - 31; i += 32) {
+    auto x10 = _mm256_loadu_si256((__m256i*)(a1 + i));
+    auto x11 = _mm256_loadu_si256((__m256i*)(a1 + i + 16));
+    auto x20 = _mm256_loadu_si256((__m256i*)(a2 + i));
+    auto x21 = _mm256_loadu_si256((__m256i*)(a2 + i + 16));
+    auto z20 = _mm512_loadu_ps(b + i);
+    auto z21 = _mm512_loadu_ps(b + i + 16);
+
+    auto z10 = pack_bf16_to_fp32(x10, x20);
+    z10 = _mm512_fmadd_ps(vAlpha, z20, z10);
+    auto z11 = pack_bf16_to_fp32(x11, x21);
+    z11 = _mm512_fmadd_ps(vAlpha, z21, z11);
+    // Update result back to split input tensors.
+    _mm256_storeu_si256((__m256i*)(a1 + i), trunc_fp32_to_bf16(z10));
+    _mm256_storeu_si256(
+        (__m256i*)(a2 + i), _mm512_cvtepi32_epi16(_mm512_castps_si512(z10)));
+    _mm256_storeu_si256((__m256i*)(a1 + i + 16), trunc_fp32_to_bf16(z11));
+    _mm256_storeu_si256(
+        (__m256i*)(a2 + i + 16),
+        _mm512_cvtepi32_epi16(_mm512_castps_si512(z11)));
+  }
+
+  if (i < len) {
+    for (; i < len - 15; i += 16) {
+      auto x1 = _mm256_loadu_si256((__m256i*)(a1 + i));
+      auto x2 = _mm256_loadu_si256((__m256i*)(a2 + i));
+      auto z2 = _mm512_loadu_ps(b + i);
+
+      auto z1 = pack_bf16_to_fp32(x1, x2);
+      z1 = _mm512_fmadd_ps(vAlpha, z2, z1);
+      // Update result back to split input tensors.
+      _mm256_storeu_si256((__m256i*)(a1 + i), trunc_fp32_to_bf16(z1));
+      _mm256_storeu_si256(
+          (__m256i*)(a2 + i), _mm512_cvtepi32_epi16(_mm512_castps_si512(z1)));
+    }
+
+    __mmask16 mask = (1 << (len - i)) - 1;
+    auto x1 = _mm256_maskz_loadu_epi16(mask, a1 + i);
+    auto x2 = _mm256_maskz_loadu_epi16(mask, a2 + i);
+    auto z2 = _mm512_maskz_loadu_ps(mask, b + i);
+
+    auto z1 = pack_bf16_to_fp32(x1, x2);
+    z1 = _mm512_fmadd_ps(vAlpha, z2, z1);
+    // Update result back to split input tensors.
+    _mm256_mask_storeu_epi16(a1 + i, mask, trunc_fp32_to_bf16(z1));
+    _mm256_mask_storeu_epi16(
+        a2 + i, mask, _mm512_cvtepi32_epi16(_mm512_castps_si512(z1)));
+  }
+}
+
 template <>
 IPEX_FORCE_INLINE void add_ker(
     at::BFloat16* inout,
@@ -0,0 +1,91 @@
+#pragma once
+
+namespace torch_ipex {
+namespace cpu {
+namespace kernel {
+
+// In-register Kogge-Stone scans: at each step a copy of the running
+// vector is shifted up by k lanes (zeros shifted in) and added, doubling
+// the scanned span; the last lane is then broadcast as the carry for the
+// next vector. AVX2 counterparts live in vec256_prefix_sum_ker.h.
+
+template <>
+inline void prefix_sum<int64_t>(
+    const int64_t* src,
+    int64_t* dst,
+    int64_t init,
+    int64_t n) {
+  int64_t i;
+  __m512i offset = _mm512_set1_epi64(init);
+  __m512i zero = _mm512_setzero_si512();
+  for (i = 0; i <= (n - 8); i += 8) {
+    __m512i x = _mm512_loadu_si512(src + i);
+    x = _mm512_add_epi64(x, _mm512_alignr_epi64(x, zero, 8 - 1));
+    x = _mm512_add_epi64(x, _mm512_alignr_epi64(x, zero, 8 - 2));
+    x = _mm512_add_epi64(x, _mm512_alignr_epi64(x, zero, 8 - 4));
+    __m512i y = _mm512_add_epi64(offset, x);
+    _mm512_storeu_si512(dst + i, y);
+    offset = _mm512_permutexvar_epi64(_mm512_set1_epi64(7), y);
+  }
+  int64_t offset_v = i == 0 ? init : dst[i - 1];
+  for (; i < n; i++) {
+    offset_v += src[i];
+    dst[i] = offset_v;
+  }
+}
+
+template <>
+inline void prefix_sum<int32_t>(
+    const int32_t* src,
+    int32_t* dst,
+    int32_t init,
+    int64_t n) {
+  int64_t i;
+  __m512i offset = _mm512_set1_epi32(init);
+  __m512i zero = _mm512_setzero_si512();
+  for (i = 0; i <= (n - 16); i += 16) {
+    __m512i x = _mm512_loadu_si512(src + i);
+    x = _mm512_add_epi32(x, _mm512_alignr_epi32(x, zero, 16 - 1));
+    x = _mm512_add_epi32(x, _mm512_alignr_epi32(x, zero, 16 - 2));
+    x = _mm512_add_epi32(x, _mm512_alignr_epi32(x, zero, 16 - 4));
+    x = _mm512_add_epi32(x, _mm512_alignr_epi32(x, zero, 16 - 8));
+    __m512i y = _mm512_add_epi32(offset, x);
+    _mm512_storeu_si512(dst + i, y);
+    offset = _mm512_permutexvar_epi32(_mm512_set1_epi32(15), y);
+  }
+  int32_t offset_v = i == 0 ? init : dst[i - 1];
+  for (; i < n; i++) {
+    offset_v += src[i];
+    dst[i] = offset_v;
+  }
+}
+
+template <>
+inline void prefix_sum<float>(const float* src, float* dst, float init, int64_t n) {
+  int64_t i;
+  __m512 offset = _mm512_set1_ps(init);
+  __m512i zero = _mm512_setzero_si512();
+#define IPEX_PS_SHIFT_UP(x, k) \
+  _mm512_castsi512_ps(         \
+      _mm512_alignr_epi32(_mm512_castps_si512(x), zero, 16 - (k)))
+  for (i = 0; i <= (n - 16); i += 16) {
+    __m512 x = _mm512_loadu_ps(src + i);
+    x = _mm512_add_ps(x, IPEX_PS_SHIFT_UP(x, 1));
+    x = _mm512_add_ps(x, IPEX_PS_SHIFT_UP(x, 2));
+    x = _mm512_add_ps(x, IPEX_PS_SHIFT_UP(x, 4));
+    x = _mm512_add_ps(x, IPEX_PS_SHIFT_UP(x, 8));
+    __m512 y = _mm512_add_ps(offset, x);
+    _mm512_storeu_ps(dst + i, y);
+    offset = _mm512_permutexvar_ps(_mm512_set1_epi32(15), y);
+  }
+#undef IPEX_PS_SHIFT_UP
+  float offset_v = i == 0 ? init : dst[i - 1];
+  for (; i < n; i++) {
+    offset_v += src[i];
+    dst[i] = offset_v;
+  }
+}
+
+} // namespace kernel
+} // namespace cpu
+} // namespace torch_ipex
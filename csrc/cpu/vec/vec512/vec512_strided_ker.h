@@ -0,0 +1,119 @@
+#pragma once
+#include <immintrin.h>
+
+#include "utils/SysUtil.h"
+
+namespace torch_ipex {
+namespace cpu {
+namespace kernel {
+
+// Gather/scatter based specializations of the strided move/add/zero
+// primitives, so kernels walking non-contiguous views (e.g. sliced
+// KV-cache buffers) stay vectorized instead of dropping to scalar loops.
+// Strides are element strides. Per-lane offsets are computed as 32-bit
+// integers, which covers any stride below 2^27 elements; the generic ref
+// form remains available for anything beyond that.
+//
+// 16-bit element types (BFloat16/Half) have no gather/scatter support in
+// the ISA and keep using the generic ref form.
+
+static IPEX_FORCE_INLINE __m512i _mm512_stride_idx(int64_t stride) {
+  auto iota = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  return _mm512_mullo_epi32(iota, _mm512_set1_epi32((int)stride));
+}
+
+template <>
+IPEX_FORCE_INLINE void move_ker_stride(
+    float* out,
+    const float* in,
+    int64_t len,
+    int64_t out_stride,
+    int64_t in_stride) {
+  auto in_idx = _mm512_stride_idx(in_stride);
+  auto out_idx = _mm512_stride_idx(out_stride);
+  int64_t i = 0;
+  for (; i < len - 15; i += 16) {
+    auto in0 = _mm512_i32gather_ps(in_idx, in + i * in_stride, 4);
+    _mm512_i32scatter_ps(out + i * out_stride, out_idx, in0, 4);
+  }
+
+  if (i < len) {
+    __mmask16 mask = (1 << (len - i)) - 1;
+    auto in0 = _mm512_mask_i32gather_ps(
+        _mm512_setzero_ps(), mask, in_idx, in + i * in_stride, 4);
+    _mm512_mask_i32scatter_ps(out + i * out_stride, mask, out_idx, in0, 4);
+  }
+}
+
+template <>
+IPEX_FORCE_INLINE void move_ker_stride(
+    int32_t* out,
+    const int32_t* in,
+    int64_t len,
+    int64_t out_stride,
+    int64_t in_stride) {
+  auto in_idx = _mm512_stride_idx(in_stride);
+  auto out_idx = _mm512_stride_idx(out_stride);
+  int64_t i = 0;
+  for (; i < len - 15; i += 16) {
+    auto in0 = _mm512_i32gather_epi32(in_idx, in + i * in_stride, 4);
+    _mm512_i32scatter_epi32(out + i * out_stride, out_idx, in0, 4);
+  }
+
+  if (i < len) {
+    __mmask16 mask = (1 << (len - i)) - 1;
+    auto in0 = _mm512_mask_i32gather_epi32(
+        _mm512_setzero_si512(), mask, in_idx, in + i * in_stride, 4);
+    _mm512_mask_i32scatter_epi32(out + i * out_stride, mask, out_idx, in0, 4);
+  }
+}
+
+template <>
+IPEX_FORCE_INLINE void add_ker_stride(
+    float* inout,
+    const float* in,
+    int64_t len,
+    int64_t inout_stride,
+    int64_t in_stride) {
+  auto in_idx = _mm512_stride_idx(in_stride);
+  auto inout_idx = _mm512_stride_idx(inout_stride);
+  int64_t i = 0;
+  for (; i < len - 15; i += 16) {
+    auto in0 = _mm512_i32gather_ps(in_idx, in + i * in_stride, 4);
+    auto out0 = _mm512_i32gather_ps(inout_idx, inout + i * inout_stride, 4);
+    out0 = _mm512_add_ps(out0, in0);
+    _mm512_i32scatter_ps(inout + i * inout_stride, inout_idx, out0, 4);
+  }
+
+  if (i < len) {
+    __mmask16 mask = (1 << (len - i)) - 1;
+    auto in0 = _mm512_mask_i32gather_ps(
+        _mm512_setzero_ps(), mask, in_idx, in + i * in_stride, 4);
+    auto out0 = _mm512_mask_i32gather_ps(
+        _mm512_setzero_ps(), mask, inout_idx, inout + i * inout_stride, 4);
+    out0 = _mm512_add_ps(out0, in0);
+    _mm512_mask_i32scatter_ps(
+        inout + i * inout_stride, mask, inout_idx, out0, 4);
+  }
+}
+
+static IPEX_FORCE_INLINE void zero_ker_stride(
+    float* out,
+    int64_t len,
+    int64_t stride) {
+  auto out_idx = _mm512_stride_idx(stride);
+  auto zero_512 = _mm512_setzero_ps();
+  int64_t i = 0;
+  for (; i < len - 15; i += 16) {
+    _mm512_i32scatter_ps(out + i * stride, out_idx, zero_512, 4);
+  }
+
+  if (i < len) {
+    __mmask16 mask = (1 << (len - i)) - 1;
+    _mm512_mask_i32scatter_ps(out + i * stride, mask, out_idx, zero_512, 4);
+  }
+}
+
+} // namespace kernel
+} // namespace cpu
+} // namespace torch_ipex
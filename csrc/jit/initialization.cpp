@@ -8,6 +8,7 @@
 #include <string>
 #include "auto_opt_config.h"
 #include "fusion_pass.h"
+#include "op_symbol_table.h"
 #include "version.h"
 
 namespace torch_ipex {
@@ -41,6 +42,7 @@ InitIPEX::~InitIPEX() = default;
 InitIPEX::InitIPEX(InitIPEX&&) noexcept = default;
 
 static auto init = InitIPEX()
+                       .init(&torch_ipex::jit::init_op_symbol_table)
                        .init(&init_jit_fusion_pass)
                        .init(&disable_autocast_for_jit_script)
                        .init(&enable_onednn_graph_constant_tensor_cache);
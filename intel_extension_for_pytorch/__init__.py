@@ -129,26 +129,46 @@ from . import _dynamo
 from . import _meta_registrations
 from ._init_on_device import OnDevice
 
-try:
-    from .cpu import tpp
-except BaseException:
-    warnings.warn(
-        "Please install transformers repo when you want to use fast_bert API."
-    )
-
 from .frontend import optimize
-from .transformers import (
-    optimize_transformers,
-    _set_optimized_model_for_generation,
-)
-from . import llm
 from .frontend import enable_auto_channels_last, disable_auto_channels_last
 from .frontend import set_fp32_math_mode, get_fp32_math_mode, FP32MathMode
+from .frontend import fp32_math_mode_scope
+from .frontend import set_math_precision, get_math_precision, MathPrecisionClass
+from .frontend import math_precision_scope
 from .cpu._auto_kernel_selection import _enable_dnnl, _disable_dnnl, _using_dnnl
 from .cpu.utils.verbose import verbose
-from .cpu.tpp.fused_bert import fast_bert
 from ._inductor.compiler import _set_compiler_backend, _get_compiler_backend, compile
 from .cpu.onednn_fusion import enable_onednn_fusion
+from .cpu.graph_warmup import warmup_jit
+
+# The LLM/BERT frontends pull in the (large) transformers package and model
+# rewrites. They are imported on first use (PEP 562) instead of at package
+# import so that deployments which never touch them do not pay the import
+# latency on every process start.
+_lazy_submodules = ("llm", "transformers")
+_lazy_attributes = {
+    "optimize_transformers": ".transformers",
+    "_set_optimized_model_for_generation": ".transformers",
+    "fast_bert": ".cpu.tpp.fused_bert",
+}
+
+
+def __getattr__(name):
+    import importlib
+
+    if name in _lazy_submodules:
+        return importlib.import_module("." + name, __name__)
+    if name in _lazy_attributes:
+        try:
+            module = importlib.import_module(_lazy_attributes[name], __name__)
+        except BaseException:
+            if name == "fast_bert":
+                warnings.warn(
+                    "Please install transformers repo when you want to use fast_bert API."
+                )
+            raise
+        return getattr(module, name)
+    raise AttributeError(f"module '{__name__}' has no attribute '{name}'")
 
 from . import _C
 
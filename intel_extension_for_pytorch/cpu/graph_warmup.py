@@ -0,0 +1,127 @@
+import threading
+import warnings
+
+import torch
+
+
+class JitWarmupHandle(object):
+    r"""
+    Handle returned by :func:`warmup_jit`. Wraps the background warmup thread
+    so the caller can synchronize with it before opening traffic.
+    """
+
+    def __init__(self):
+        self._thread = None
+        self._exception = None
+        self._done = threading.Event()
+
+    @property
+    def done(self):
+        """Whether the warmup runs have finished (successfully or not)."""
+        return self._done.is_set()
+
+    @property
+    def exception(self):
+        """The exception raised during warmup, or ``None``."""
+        return self._exception
+
+    def wait(self, timeout=None):
+        r"""
+        Block until the warmup runs have finished.
+
+        Args:
+            timeout (float): Optional timeout in seconds.
+
+        Returns:
+            bool: ``True`` if the warmup finished within the timeout.
+        """
+        finished = self._done.wait(timeout)
+        if finished and self._exception is not None:
+            warnings.warn(
+                "JIT warmup failed: {}. The first serving requests will "
+                "compile inline instead.".format(self._exception)
+            )
+        return finished
+
+
+def warmup_jit(model, example_inputs, warmup_runs=3, background=True):
+    r"""
+    Run the profiling executions of a TorchScript (or graph-mode) model ahead
+    of time, so the serving threads never pay for the fusion passes and oneDNN
+    partition compilation on the first real requests.
+
+    TorchScript compiles lazily: the first executions for every input
+    configuration run the profiling/fusion pipeline inline, which can take
+    seconds for large models. The optimized execution plan is cached per input
+    configuration inside the script module and shared across threads, and the
+    executor swaps it in under its own lock — so executing the model a few
+    times with representative inputs from a background thread is enough to
+    move the whole compilation off the serving path.
+
+    Args:
+        model: the model to warm up. A ``ScriptModule`` (traced/frozen), or a
+            model returned by ``ipex.optimize(..., graph_mode=True)``.
+        example_inputs: a tuple of example inputs, or a list of such tuples
+            when several input configurations (e.g. batch sizes or sequence
+            lengths) should be warmed up. A single tensor is treated as a
+            one-element tuple.
+        warmup_runs (int): how many times each input configuration is
+            executed. The profiling executor needs more than one run before it
+            produces the optimized plan, so this should be at least 2.
+            Default value is ``3``.
+        background (bool): run the warmup on a daemon thread and return
+            immediately. If ``False``, the warmup runs synchronously before
+            returning. Default value is ``True``.
+
+    Returns:
+        JitWarmupHandle: call ``wait()`` on it before opening traffic to
+        guarantee the serving threads only ever see the optimized plan.
+
+    Examples:
+
+        >>> import intel_extension_for_pytorch as ipex
+        >>> model = ipex.optimize(model, dtype=torch.bfloat16)
+        >>> model = torch.jit.freeze(torch.jit.trace(model, x))
+        >>> handle = ipex.warmup_jit(model, [(x,), (x_large,)])
+        >>> # load the rest of the service while warmup proceeds ...
+        >>> handle.wait()
+    """
+    if warmup_runs < 2:
+        warnings.warn(
+            "warmup_jit: the profiling executor produces the optimized plan "
+            "only after the profiling runs; warmup_runs < 2 will leave part "
+            "of the compilation on the serving path."
+        )
+
+    if isinstance(example_inputs, torch.Tensor):
+        input_configs = [(example_inputs,)]
+    elif isinstance(example_inputs, tuple):
+        input_configs = [example_inputs]
+    else:
+        input_configs = [
+            (config,) if isinstance(config, torch.Tensor) else tuple(config)
+            for config in example_inputs
+        ]
+
+    handle = JitWarmupHandle()
+
+    def run_warmup():
+        try:
+            with torch.no_grad():
+                for config in input_configs:
+                    for _ in range(max(warmup_runs, 1)):
+                        model(*config)
+        except Exception as e:
+            handle._exception = e
+        finally:
+            handle._done.set()
+
+    if background:
+        thread = threading.Thread(
+            target=run_warmup, name="ipex_jit_warmup", daemon=True
+        )
+        handle._thread = thread
+        thread.start()
+    else:
+        run_warmup()
+    return handle
@@ -0,0 +1,87 @@
+import torch
+from torch.autograd import Function
+
+
+def dropout_add_layer_norm(
+    a,
+    b,
+    p,
+    normalized_shape,
+    weight=None,
+    bias=None,
+    eps=1e-5,
+    training=True,
+):
+    r"""
+    Fused ``layer_norm(dropout(a, p) + b)`` for eager-mode training.
+
+    Compared with running the three ops separately, the fused op keeps the
+    dropout mask bit-packed instead of materializing an RNG tensor, and the
+    backward applies the mask inside the layernorm input-gradient pass, so
+    the elementwise passes read/write each tensor once.
+
+    Args:
+        a (torch.Tensor): input to dropout (e.g. a dense layer output).
+        b (torch.Tensor): residual branch, added after dropout. Must have
+            the same shape as ``a``.
+        p (float): dropout probability, in ``[0, 1)``.
+        normalized_shape (list or tuple of ints): as in
+            :func:`torch.nn.functional.layer_norm`.
+        weight (torch.Tensor, optional): layernorm affine weight.
+        bias (torch.Tensor, optional): layernorm affine bias.
+        eps (float): layernorm epsilon.
+        training (bool): when ``False``, dropout is disabled.
+
+    Returns:
+        torch.Tensor: the normalized output.
+    """
+    if not training:
+        p = 0.0
+    if torch.is_grad_enabled() and (
+        a.requires_grad
+        or b.requires_grad
+        or (weight is not None and weight.requires_grad)
+        or (bias is not None and bias.requires_grad)
+    ):
+        return DropoutAddLayerNormFunc.apply(
+            a, b, p, normalized_shape, weight, bias, eps
+        )
+    out, _, _, _, _ = torch.ops.torch_ipex.dropout_add_layernorm(
+        a, b, p, normalized_shape, weight, bias, eps
+    )
+    return out
+
+
+class DropoutAddLayerNormFunc(Function):
+    @staticmethod
+    def forward(ctx, a, b, p, normalized_shape, weight, bias, eps):
+        out, x, mask, mean, rstd = torch.ops.torch_ipex.dropout_add_layernorm(
+            a, b, p, normalized_shape, weight, bias, eps
+        )
+        ctx.save_for_backward(x, mask, mean, rstd, weight)
+        ctx.p = p
+        ctx.normalized_shape = normalized_shape
+        return out
+
+    @staticmethod
+    def backward(ctx, grad_out):
+        x, mask, mean, rstd, weight = ctx.saved_tensors
+        (
+            grad_a,
+            grad_b,
+            grad_weight,
+            grad_bias,
+        ) = torch.ops.torch_ipex.dropout_add_layernorm_backward(
+            grad_out.contiguous(),
+            x,
+            mask,
+            mean,
+            rstd,
+            ctx.p,
+            ctx.normalized_shape,
+            weight,
+        )
+        if weight is None:
+            grad_weight = None
+            grad_bias = None
+        return grad_a, grad_b, None, None, grad_weight, grad_bias, None
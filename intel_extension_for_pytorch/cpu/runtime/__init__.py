@@ -6,4 +6,13 @@ from .multi_stream import (
     MultiStreamModuleHint,
     _MultiStreamBenchmarkModule,
 )
-from .runtime_utils import get_core_list_of_node_id
+from .runtime_utils import (
+    get_core_list_of_node_id,
+    get_core_list_of_core_type,
+    parse_cpu_list,
+)
+from .parallel import (
+    ParallelModule,
+    calibrate_branch_weights,
+    get_weighted_core_allocation,
+)
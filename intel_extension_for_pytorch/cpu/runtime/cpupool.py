@@ -1,7 +1,7 @@
 import functools
 import warnings
 import intel_extension_for_pytorch as ipex
-from .runtime_utils import get_core_list_of_node_id
+from .runtime_utils import get_core_list_of_node_id, get_core_list_of_core_type
 
 
 class CPUPool(object):
@@ -12,19 +12,26 @@ class CPUPool(object):
         core_ids (list): A list of CPU cores' ids used for intra-op parallelism.
         node_id (int): A numa node id with all CPU cores on the numa node.
             ``node_id`` doesn't work if ``core_ids`` is set.
+        core_type (str): ``"performance"`` or ``"efficiency"``, selecting one
+            core class of a hybrid (P-core/E-core) client platform. Lets
+            compute-bound work be pinned to the P-cores while bandwidth-bound
+            work (e.g. embedding gather) runs on the E-cores. Ignored when
+            ``core_ids`` or ``node_id`` is set.
 
     Returns:
         intel_extension_for_pytorch.cpu.runtime.CPUPool: Generated
         intel_extension_for_pytorch.cpu.runtime.CPUPool object.
     """
 
-    def __init__(self, core_ids: list = None, node_id: int = None):
+    def __init__(
+        self, core_ids: list = None, node_id: int = None, core_type: str = None
+    ):
         if not ipex._C._has_cpu():
             return
         if core_ids is not None:
-            if node_id is not None:
+            if node_id is not None or core_type is not None:
                 warnings.warn(
-                    "Both of core_ids and node_id are inputed. core_ids will be used with priority."
+                    "Both of core_ids and node_id/core_type are inputed. core_ids will be used with priority."
                 )
             if type(core_ids) is range:
                 core_ids = list(core_ids)
@@ -33,7 +40,13 @@ class CPUPool(object):
             ), "Input of core_ids must be the type of list[Int]"
             self.core_ids = core_ids
         elif node_id is not None:
+            if core_type is not None:
+                warnings.warn(
+                    "Both of node_id and core_type are inputed. node_id will be used with priority."
+                )
             self.core_ids = get_core_list_of_node_id(node_id)
+        elif core_type is not None:
+            self.core_ids = get_core_list_of_core_type(core_type)
         else:
             # Default case, we will use all the cores available for current process.
             # Please note:
@@ -0,0 +1,178 @@
+import time
+import warnings
+
+import torch
+import torch.nn as nn
+
+from .cpupool import CPUPool
+from .task import Task
+
+
+def get_weighted_core_allocation(core_list, weights):
+    r"""
+    Split ``core_list`` into disjoint slices whose sizes are proportional to
+    ``weights``, with every slice receiving at least one core. Cores left over
+    by the proportional rounding are handed to the slices with the largest
+    rounding remainder, mirroring how MultiStreamModule distributes the
+    remainder cores between streams.
+
+    Args:
+        core_list (list): A list of CPU cores' ids to be divided.
+        weights (list): A list of positive numbers, one per slice, giving the
+            estimated relative cost (e.g. FLOPs) of the work scheduled on the
+            slice.
+
+    Returns:
+        list: A list of core id lists, one disjoint slice per weight.
+    """
+    num_slices = weights.__len__()
+    assert num_slices > 0, "weights must not be empty"
+    assert all(w > 0 for w in weights), "weights must be positive"
+    assert (
+        core_list.__len__() >= num_slices
+    ), "Number of cores ({}) must be at least the number of slices ({})".format(
+        core_list.__len__(), num_slices
+    )
+    total_weight = sum(weights)
+    # Each slice gets one core up front so no slice is starved; the remaining
+    # cores are distributed proportionally to the weights.
+    spare_cores = core_list.__len__() - num_slices
+    shares = [w * spare_cores / total_weight for w in weights]
+    slice_sizes = [1 + int(share) for share in shares]
+    remainders = sorted(
+        range(num_slices), key=lambda i: shares[i] - int(shares[i]), reverse=True
+    )
+    for i in remainders[: core_list.__len__() - sum(slice_sizes)]:
+        slice_sizes[i] += 1
+
+    core_allocation = []
+    start_core_list_idx = 0
+    for size in slice_sizes:
+        core_allocation.append(
+            core_list[start_core_list_idx : start_core_list_idx + size]
+        )
+        start_core_list_idx += size
+    return core_allocation
+
+
+def calibrate_branch_weights(modules, example_inputs, runs=3):
+    r"""
+    Measure the relative cost of independent branches by timing each of them
+    sequentially, so the measured wall times can be fed to ``ParallelModule``
+    as ``weights``. The first run of every branch is treated as warm-up and
+    discarded.
+
+    Args:
+        modules (list): A list of torch.nn.Module or torch.jit.ScriptModule
+            objects, one per branch.
+        example_inputs (list): A list with one entry per branch; each entry is
+            the tuple of positional arguments of the branch (a single tensor
+            is treated as a one-element tuple).
+        runs (int): How many timed executions each branch gets after the
+            warm-up run. Default value is ``3``.
+
+    Returns:
+        list: The measured average wall time per branch, usable as the
+        ``weights`` argument of ``ParallelModule``.
+    """
+    assert modules.__len__() == example_inputs.__len__(), (
+        "calibrate_branch_weights expects one example input per branch, but "
+        "got {} branches and {} example inputs".format(
+            modules.__len__(), example_inputs.__len__()
+        )
+    )
+    weights = []
+    with torch.no_grad():
+        for module, inputs in zip(modules, example_inputs):
+            if isinstance(inputs, torch.Tensor):
+                inputs = (inputs,)
+            module(*inputs)
+            start = time.time()
+            for _ in range(max(runs, 1)):
+                module(*inputs)
+            weights.append((time.time() - start) / max(runs, 1))
+    return weights
+
+
+class ParallelModule(nn.Module):
+    r"""
+    ParallelModule executes independent branches (e.g. the two towers of a
+    two-tower ranking model) concurrently, each on a disjoint slice of the
+    given CPU pool, instead of running them one after another with every
+    branch under-utilizing the full pool. Each branch becomes an
+    intel_extension_for_pytorch.cpu.runtime.Task pinned to its slice; the
+    slices are sized proportionally to ``weights`` so a heavier tower gets
+    more cores.
+
+    Args:
+        modules (list): A list of torch.nn.Module or torch.jit.ScriptModule
+            objects, one per independent branch.
+        cpu_pool (intel_extension_for_pytorch.cpu.runtime.CPUPool): An
+            intel_extension_for_pytorch.cpu.runtime.CPUPool object whose cores
+            are divided between the branches.
+        weights (list): Optional estimated relative cost per branch (e.g.
+            FLOPs, or wall times from
+            :func:`calibrate_branch_weights`). Default is ``None``, which
+            divides the cores equally.
+
+    Returns:
+        intel_extension_for_pytorch.cpu.runtime.ParallelModule: Generated
+        intel_extension_for_pytorch.cpu.runtime.ParallelModule object.
+
+    Examples:
+
+        >>> towers = [user_tower, item_tower]
+        >>> weights = ipex.cpu.runtime.calibrate_branch_weights(
+        >>>     towers, [(user_x,), (item_x,)])
+        >>> model = ipex.cpu.runtime.ParallelModule(
+        >>>     towers, ipex.cpu.runtime.CPUPool(node_id=0), weights)
+        >>> user_emb, item_emb = model((user_x,), (item_x,))
+    """
+
+    def __init__(self, modules: list, cpu_pool: CPUPool = None, weights: list = None):
+        super(ParallelModule, self).__init__()
+        assert modules.__len__() > 0, "modules must not be empty"
+        if cpu_pool is None:
+            cpu_pool = CPUPool()
+        assert type(cpu_pool) is CPUPool
+        if weights is None:
+            weights = [1] * modules.__len__()
+        assert modules.__len__() == weights.__len__(), (
+            "ParallelModule expects one weight per branch, but got {} "
+            "branches and {} weights".format(modules.__len__(), weights.__len__())
+        )
+
+        self.num_branches = modules.__len__()
+        if cpu_pool.core_ids.__len__() < self.num_branches:
+            # Not enough cores to give every branch its own slice: fall back
+            # to the sequential execution the caller would have had anyway.
+            warnings.warn(
+                "The number of branches is larger than the number of cores. "
+                "The branches will run sequentially on the full pool."
+            )
+            self.tasks = None
+            self.branches = modules
+            return
+        self.tasks = []
+        self.branches = modules
+        core_allocation = get_weighted_core_allocation(cpu_pool.core_ids, weights)
+        for module, cores in zip(modules, core_allocation):
+            self.tasks.append(Task(module, CPUPool(cores)))
+
+    def forward(self, *inputs):
+        assert inputs.__len__() == self.num_branches, (
+            "ParallelModule expects one input tuple per branch, but got {} "
+            "inputs for {} branches".format(inputs.__len__(), self.num_branches)
+        )
+        branch_inputs = [
+            (args,) if isinstance(args, torch.Tensor) else tuple(args)
+            for args in inputs
+        ]
+        if self.tasks is None:
+            return tuple(
+                branch(*args) for branch, args in zip(self.branches, branch_inputs)
+            )
+        futures = [
+            task(*args) for task, args in zip(self.tasks, branch_inputs)
+        ]
+        return tuple(future.get() for future in futures)
@@ -36,3 +36,64 @@ def get_core_list_of_node_id(node_id):
     )
     num_cores_per_node = get_num_cores_per_node()
     return list(range(num_cores_per_node * node_id, num_cores_per_node * (node_id + 1)))
+
+
+def parse_cpu_list(cpu_list_str):
+    r"""
+    Helper function to parse a kernel cpulist string (e.g. "0-7,16-23") into
+    a list of CPU cores' ids.
+
+    Args:
+        cpu_list_str (str): A cpulist formatted string, as found in sysfs
+            files such as ``/sys/devices/cpu_core/cpus``.
+
+    Returns:
+        list: List of the CPU cores' ids described by the string.
+    """
+
+    core_ids = []
+    for piece in cpu_list_str.strip().split(","):
+        if not piece:
+            continue
+        if "-" in piece:
+            begin, end = piece.split("-")
+            core_ids.extend(range(int(begin), int(end) + 1))
+        else:
+            core_ids.append(int(piece))
+    return core_ids
+
+
+def get_core_list_of_core_type(core_type):
+    r"""
+    Helper function to get the CPU cores' ids of the input core type on
+    hybrid (P-core/E-core) client platforms. The core classes are read from
+    the sysfs topology (``/sys/devices/cpu_core/cpus`` and
+    ``/sys/devices/cpu_atom/cpus``) which the kernel exposes on hybrid
+    machines.
+
+    Args:
+        core_type (str): ``"performance"`` for the P-cores or
+            ``"efficiency"`` for the E-cores.
+
+    Returns:
+        list: List of CPU cores' ids of this core type.
+    """
+
+    sysfs_path = {
+        "performance": "/sys/devices/cpu_core/cpus",
+        "efficiency": "/sys/devices/cpu_atom/cpus",
+    }
+    assert (
+        core_type in sysfs_path
+    ), 'Input of core_type must be "performance" or "efficiency"'
+    try:
+        with open(sysfs_path[core_type]) as f:
+            return parse_cpu_list(f.read())
+    except FileNotFoundError:
+        raise AssertionError(
+            "Core type {} is not exposed by this machine. The platform is "
+            "not hybrid, or the kernel does not publish the core classes "
+            "under /sys/devices/cpu_core and /sys/devices/cpu_atom.".format(
+                core_type
+            )
+        )
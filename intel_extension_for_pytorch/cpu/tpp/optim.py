@@ -259,6 +259,143 @@ class AdamW(Optimizer):
         return loss
 
 
+class Adam(Optimizer):
+    """
+    Implements the classic Adam algorithm with L2 regularization, i.e. weight
+    decay is added to the gradient before the moment updates (unlike the
+    decoupled decay in :class:`AdamW`). BF16 parameters use the split
+    (trail-bits) representation so no FP32 master copy is kept.
+
+    Parameters:
+        params (:obj:`Iterable[torch.nn.parameter.Parameter]`):
+            Iterable of parameters to optimize or dictionaries defining parameter groups.
+        lr (:obj:`float`, `optional`, defaults to 1e-3):
+            The learning rate to use.
+        betas (:obj:`Tuple[float,float]`, `optional`, defaults to (0.9, 0.999)):
+            Adam's betas parameters (b1, b2).
+        eps (:obj:`float`, `optional`, defaults to 1e-6):
+            Adam's epsilon for numerical stability.
+        weight_decay (:obj:`float`, `optional`, defaults to 0):
+            L2 regularization coefficient applied to the gradient.
+        correct_bias (:obj:`bool`, `optional`, defaults to `True`):
+            Whether ot not to correct bias in Adam (for instance, in Bert TF repository they use :obj:`False`).
+    """
+
+    def __init__(
+        self,
+        params: Iterable[torch.nn.parameter.Parameter],
+        lr: float = 1e-3,
+        betas: Tuple[float, float] = (0.9, 0.999),
+        eps: float = 1e-6,
+        weight_decay: float = 0.0,
+        correct_bias: bool = True,
+    ):
+        if lr < 0.0:
+            raise ValueError("Invalid learning rate: {} - should be >= 0.0".format(lr))
+        if not 0.0 <= betas[0] < 1.0:
+            raise ValueError(
+                "Invalid beta parameter: {} - should be in [0.0, 1.0[".format(betas[0])
+            )
+        if not 0.0 <= betas[1] < 1.0:
+            raise ValueError(
+                "Invalid beta parameter: {} - should be in [0.0, 1.0[".format(betas[1])
+            )
+        if not 0.0 <= eps:
+            raise ValueError("Invalid epsilon value: {} - should be >= 0.0".format(eps))
+        defaults = dict(
+            lr=lr,
+            betas=betas,
+            eps=eps,
+            weight_decay=weight_decay,
+            correct_bias=correct_bias,
+        )
+        super().__init__(params, defaults)
+
+    def step(self, closure: Callable = None):
+        """
+        Performs a single optimization step.
+
+        Arguments:
+            closure (:obj:`Callable`, `optional`): A closure that reevaluates the model and returns the loss.
+        """
+        loss = None
+        if closure is not None:
+            loss = closure()
+
+        for group in self.param_groups:
+            for p in group["params"]:
+                if p.grad is None:
+                    continue
+                grad = p.grad.data
+                data = p.data
+                if grad.is_sparse:
+                    raise RuntimeError(
+                        "Adam does not support sparse gradients, please consider SparseAdam instead"
+                    )
+
+                state = self.state[p]
+
+                # State initialization
+                if len(state) == 0:
+                    state["step"] = 0
+                    # Exponential moving average of gradient values
+                    state["exp_avg"] = torch.zeros_like(data)
+                    # Exponential moving average of squared gradient values
+                    state["exp_avg_sq"] = torch.zeros_like(data)
+                    # Lower bits for bf16 params
+                    if p.data.dtype == torch.bfloat16:
+                        state["low_bits"] = torch.zeros_like(p.data)
+
+                exp_avg, exp_avg_sq = state["exp_avg"], state["exp_avg_sq"]
+                if data.dtype == torch.bfloat16:
+                    low_bits = state["low_bits"]
+                beta1, beta2 = group["betas"]
+
+                state["step"] += 1
+
+                step_size = group["lr"]
+                if group["correct_bias"]:  # No bias correction for Bert
+                    bias_correction1 = 1.0 - beta1 ** state["step"]
+                    bias_correction2 = 1.0 - beta2 ** state["step"]
+                    step_size = (
+                        step_size * math.sqrt(bias_correction2) / bias_correction1
+                    )
+
+                if data.dtype == torch.bfloat16:
+                    ipex_cpp.tpp_fused_split_adam(
+                        data,
+                        low_bits,
+                        grad.contiguous(),
+                        exp_avg,
+                        exp_avg_sq,
+                        beta1,
+                        beta2,
+                        step_size,
+                        group["lr"],
+                        group["weight_decay"],
+                        group["eps"],
+                    )
+                else:
+                    # L2 on the gradient, then reuse the fused AdamW kernel
+                    # with the decoupled decay disabled.
+                    if group["weight_decay"] > 0.0:
+                        grad = grad.add(data, alpha=group["weight_decay"])
+                    ipex_cpp.tpp_fused_adamw(
+                        data,
+                        grad.contiguous(),
+                        exp_avg,
+                        exp_avg_sq,
+                        beta1,
+                        beta2,
+                        step_size,
+                        group["lr"],
+                        0.0,
+                        group["eps"],
+                    )
+
+        return loss
+
+
 def clip_grad_norm_(parameters, max_norm, norm_type=2, grad_list=False):
     r"""Clips gradient norm of an iterable of parameters.
 
@@ -15,6 +15,8 @@
 #include <torch/csrc/jit/runtime/custom_operator.h>
 #include <torch/csrc/jit/runtime/operator_options.h>
 #include "jit/fusion_pass.h"
+#include "jit/graph_replay.h"
+#include "jit/graph_snapshot.h"
 
 #include <cstring>
 #include <sstream>
@@ -22,10 +24,19 @@
 #include <vector>
 
 #include "jit/auto_opt_config.h"
+#include "jit/cpu/kernels/LinearMKLPacked.h"
+#include "jit/cpu/kernels/OpContextStats.h"
+#include "jit/cpu/kernels/RooflineCounters.h"
+#include "jit/memory_planner.h"
 #include "jit/cpu/tensorexpr/nnc_fuser_register.h"
+#include "utils/SysUtil.h"
+#include "utils/determinism.h"
 #include "utils/fpmath_mode.h"
+#include "utils/math_precision.h"
+#include "utils/hot_trace.h"
 #include "utils/isa_utils.h"
 #include "utils/module_version.h"
+#include "utils/weight_compress.h"
 #include "utils/onednn_utils.h"
 
 #include <c10/core/DeviceType.h>
@@ -34,12 +45,18 @@
 #include <torch/csrc/jit/passes/pass_manager.h>
 #include "aten/GradScaler.h"
 
+#include "PipelinedTaskModule.h"
 #include "TaskModule.h"
 #include "aten/EmbeddingBag.h"
 #include "runtime/CPUPool.h"
+#include "runtime/DecodeSlabAllocator.h"
+#include "runtime/ShardReducer.h"
 #include "runtime/TaskExecutor.h"
+#include "runtime/KVCacheTier.h"
+#include "runtime/WeightPrefetcher.h"
 #include "toolkit/sklearn.h"
 #include "tpp/optim.h"
+#include "tpp/timing.h"
 #include "tpp/utils.h"
 
 namespace torch_ipex {
@@ -85,6 +102,141 @@ void InitIpexModuleBindings(py::module m) {
     return get_highest_binary_support_isa_level();
   });
 
+  m.def(
+      "_is_hybrid_cpu", []() { return torch_ipex::utils::is_hybrid_cpu(); });
+
+  m.def("_list_dispatch_stubs", []() {
+    using namespace torch_ipex::cpu;
+    py::dict result;
+    for (auto& info : list_dispatch_stubs()) {
+      py::dict stub;
+      stub["chosen_isa"] = info.chosen_isa;
+      stub["override_isa"] = info.override_isa;
+      result[py::str(info.name)] = std::move(stub);
+    }
+    return result;
+  });
+
+  m.def(
+      "_set_dispatch_stub_override",
+      [](const std::string& name, const std::string& isa) {
+        using namespace torch_ipex::cpu;
+        set_dispatch_stub_override(name, isa);
+      });
+
+  m.def("_get_cpu_uarch", []() {
+    using namespace torch_ipex::cpu;
+    return std::string(CPUUarchToString(get_cpu_uarch()));
+  });
+
+  m.def("_list_size_class_thresholds", []() {
+    using namespace torch_ipex::cpu;
+    py::dict result;
+    for (auto& info : list_size_class_thresholds()) {
+      py::dict thresholds;
+      thresholds["small_limit"] = info.small_limit;
+      thresholds["medium_limit"] = info.medium_limit;
+      result[py::str(info.name)] = std::move(thresholds);
+    }
+    return result;
+  });
+
+  m.def(
+      "_set_size_class_thresholds",
+      [](const std::string& name, int64_t small_limit, int64_t medium_limit) {
+        using namespace torch_ipex::cpu;
+        set_size_class_thresholds(name, small_limit, medium_limit);
+      });
+
+  m.def("_set_deterministic_reductions", [](bool enabled) {
+    torch_ipex::setDeterministicReductions(enabled);
+  });
+  m.def("_get_deterministic_reductions", []() {
+    return torch_ipex::isDeterministicReductionsEnabled();
+  });
+
+  m.def("_tpp_hist_enable", [](bool enable) {
+    torch_ipex::tpp::hist_set_enabled(enable);
+  });
+  m.def("_tpp_hist_reset", []() { torch_ipex::tpp::hist_reset(); });
+  m.def("_tpp_hist_enter", [](const std::string& name) {
+    torch_ipex::tpp::hist_scope_enter(name);
+  });
+  m.def("_tpp_hist_exit", []() { torch_ipex::tpp::hist_scope_exit(); });
+  m.def("_tpp_hist_snapshot", []() {
+    py::dict result;
+    for (auto& entry : torch_ipex::tpp::hist_snapshot()) {
+      auto& hist = entry.second;
+      py::dict scope;
+      scope["count"] = hist.count;
+      scope["total"] = hist.total;
+      scope["p50"] = hist.percentile(50.0);
+      scope["p90"] = hist.percentile(90.0);
+      scope["p99"] = hist.percentile(99.0);
+      py::list buckets;
+      for (auto b : hist.buckets)
+        buckets.append(b);
+      scope["buckets"] = buckets;
+      result[py::str(entry.first)] = scope;
+    }
+    return result;
+  });
+
+  m.def("_enable_op_context_stats", [](bool enable) {
+    torch_ipex::cpu::op_context_stats::set_enabled(enable);
+  });
+  m.def("_reset_op_context_stats", []() {
+    torch_ipex::cpu::op_context_stats::reset();
+  });
+  m.def("_get_op_context_stats", []() {
+    py::list result;
+    for (auto& entry : torch_ipex::cpu::op_context_stats::snapshot()) {
+      auto& record = entry.second;
+      py::dict stats;
+      stats["handle"] = entry.first;
+      stats["kind"] = record.kind;
+      stats["weight_shape"] = record.weight_shape;
+      stats["invocations"] = record.invocations;
+      stats["total_cycles"] = record.total_cycles;
+      py::dict m_histogram;
+      for (auto& bucket : record.m_histogram) {
+        m_histogram[py::int_(bucket.first)] = bucket.second;
+      }
+      stats["m_histogram"] = m_histogram;
+      result.append(stats);
+    }
+    return result;
+  });
+
+  m.def("_enable_roofline_counters", [](bool enable) {
+    torch_ipex::cpu::roofline::set_enabled(enable);
+  });
+  m.def("_reset_roofline_counters", []() {
+    torch_ipex::cpu::roofline::reset();
+  });
+  m.def("_get_roofline_counters", []() {
+    py::dict result;
+    for (auto& entry : torch_ipex::cpu::roofline::snapshot()) {
+      auto& counter = entry.second;
+      py::dict stats;
+      stats["invocations"] = counter.invocations;
+      stats["bytes"] = counter.bytes;
+      stats["flops"] = counter.flops;
+      result[py::str(entry.first)] = stats;
+    }
+    return result;
+  });
+
+  m.def("_set_thp_alloc_enabled", [](bool enable) {
+    ipex_set_thp_alloc_enabled(enable);
+  });
+  m.def("_is_thp_alloc_enabled", []() { return ipex_thp_alloc_enabled(); });
+  m.def("_madvise_hugepage", [](const at::Tensor& tensor) {
+    // Advise an existing long-lived allocation (e.g. a KV cache) so the
+    // kernel can collapse its interior into 2M pages.
+    ipex_madvise_hugepage(tensor.data_ptr(), tensor.nbytes());
+  });
+
   m.def("mkldnn_set_verbose", &torch_ipex::utils::onednn_set_verbose);
   m.def("onednn_has_bf16_support", []() {
     return torch_ipex::utils::onednn_has_bf16_type_support();
@@ -95,6 +247,68 @@ void InitIpexModuleBindings(py::module m) {
   m.def("onednn_has_fp8_support", []() {
     return torch_ipex::utils::onednn_has_fp8_type_support();
   });
+  m.def("_get_onednn_primitive_cache_capacity", []() {
+    return torch_ipex::utils::onednn_get_primitive_cache_capacity();
+  });
+  m.def("_set_onednn_primitive_cache_capacity", [](int capacity) {
+    torch_ipex::utils::onednn_set_primitive_cache_capacity(capacity);
+  });
+  m.def("_clear_onednn_primitive_cache", []() {
+    torch_ipex::utils::onednn_clear_primitive_cache();
+  });
+  m.def("_get_onednn_arena_stats", []() {
+    auto stats = torch_ipex::utils::onednn_arena_stats();
+    py::dict result;
+    result["hits"] = stats.hits;
+    result["misses"] = stats.misses;
+    result["hit_bytes"] = stats.hit_bytes;
+    result["miss_bytes"] = stats.miss_bytes;
+    return result;
+  });
+  m.def("_reset_onednn_arena_stats", []() {
+    torch_ipex::utils::onednn_reset_arena_stats();
+  });
+  m.def("_onednn_verbose_aggregation_begin", []() {
+    return torch_ipex::utils::onednn_verbose_aggregation_begin();
+  });
+  m.def("_onednn_verbose_aggregation_end", []() {
+    torch_ipex::utils::onednn_verbose_aggregation_end();
+  });
+  m.def("_onednn_verbose_aggregation_snapshot", []() {
+    py::list result;
+    for (auto& entry :
+         torch_ipex::utils::onednn_verbose_aggregation_snapshot()) {
+      py::dict item;
+      item["kind"] = entry.kind;
+      item["impl"] = entry.impl;
+      item["shape"] = entry.shape;
+      item["count"] = entry.count;
+      item["total_ms"] = entry.total_ms;
+      result.append(item);
+    }
+    return result;
+  });
+  m.def("_onednn_verbose_aggregation_reset", []() {
+    torch_ipex::utils::onednn_verbose_aggregation_reset();
+  });
+  m.def("_set_packed_weight_compression", [](bool enabled) {
+    torch_ipex::utils::set_packed_weight_compression(enabled);
+  });
+  m.def("_get_packed_weight_compression", []() {
+    return torch_ipex::utils::packed_weight_compression_enabled();
+  });
+  m.def("_get_mkl_sgemm_pack_cache_stats", []() {
+    auto stats =
+        torch_ipex::cpu::detail::mkl_sgemm::get_pack_cache_stats();
+    py::dict result;
+    result["hits"] = stats.hits;
+    result["repacks"] = stats.repacks;
+    result["fallbacks"] = stats.fallbacks;
+    return result;
+  });
+  m.def("_reset_mkl_sgemm_pack_cache_stats", []() {
+    torch_ipex::cpu::detail::mkl_sgemm::reset_pack_cache_stats();
+  });
 
   m.def("isa_has_amx_fp16_support", []() {
     return torch_ipex::utils::isa_has_amx_fp16_support();
@@ -127,6 +341,19 @@ void InitIpexModuleBindings(py::module m) {
 
   m.def("get_fp32_math_mode", &torch_ipex::getFP32MathModeCpu);
 
+  m.def(
+      "push_fp32_math_mode_policy",
+      [](FP32MathMode conv_mode,
+         FP32MathMode linear_mode,
+         FP32MathMode matmul_mode,
+         FP32MathMode rnn_mode) {
+        torch_ipex::pushFP32MathModePolicyCpu(
+            conv_mode, linear_mode, matmul_mode, rnn_mode);
+      });
+  m.def("pop_fp32_math_mode_policy", &torch_ipex::popFP32MathModePolicyCpu);
+  m.def(
+      "get_fp32_math_mode_policy", &torch_ipex::getFP32MathModePolicyCpu);
+
   m.def("_amp_update_scale_", &torch_ipex::cpu::_amp_update_scale_cpu_);
   m.def(
       "_amp_foreach_non_finite_check_and_unscale_",
@@ -146,6 +373,120 @@ void InitIpexModuleBindings(py::module m) {
       "_jit_llga_weight_cache_enabled",
       &torch_ipex::jit::fuser::onednn::getLlgaWeightCacheEnabled);
 
+  // warm-start graph snapshots
+  m.def(
+      "_jit_save_optimized_graph",
+      [](std::shared_ptr<torch::jit::Graph> graph) {
+        return py::bytes(torch_ipex::jit::SaveOptimizedGraph(graph));
+      });
+  m.def("_jit_load_optimized_graph", [](const std::string& payload) {
+    return torch_ipex::jit::LoadOptimizedGraph(payload);
+  });
+  m.def("_jit_graph_snapshot_fingerprint", []() {
+    return torch_ipex::jit::GraphSnapshotFingerprint();
+  });
+
+  // capture/replay of decode graphs as flat call lists
+  py::class_<
+      torch_ipex::jit::GraphReplay,
+      std::shared_ptr<torch_ipex::jit::GraphReplay>>(m, "GraphReplay")
+      .def(py::init([](std::shared_ptr<torch::jit::Graph> graph) {
+        return std::make_shared<torch_ipex::jit::GraphReplay>(
+            std::move(graph));
+      }))
+      .def(
+          "run",
+          [](torch_ipex::jit::GraphReplay& self, py::args args) {
+            std::vector<c10::IValue> inputs;
+            inputs.reserve(args.size());
+            for (auto& arg : args) {
+              inputs.push_back(torch::jit::toTypeInferredIValue(arg));
+            }
+            auto outputs = self.run(std::move(inputs));
+            if (outputs.size() == 1) {
+              return torch::jit::toPyObject(std::move(outputs[0]));
+            }
+            py::tuple result(outputs.size());
+            for (size_t i = 0; i < outputs.size(); ++i) {
+              result[i] = torch::jit::toPyObject(std::move(outputs[i]));
+            }
+            return py::object(result);
+          })
+      .def("num_steps", &torch_ipex::jit::GraphReplay::num_steps);
+  m.def(
+      "_jit_graph_is_replayable",
+      [](std::shared_ptr<torch::jit::Graph> graph) {
+        return torch_ipex::jit::GraphReplay::IsReplayable(graph);
+      });
+
+  // hot-path event tracing
+  m.def("_hot_trace_enable", &torch_ipex::utils::hot_trace::enable);
+  m.def("_hot_trace_is_enabled", &torch_ipex::utils::hot_trace::is_enabled);
+  m.def("_hot_trace_reset", &torch_ipex::utils::hot_trace::reset);
+  m.def(
+      "_hot_trace_dropped_events",
+      &torch_ipex::utils::hot_trace::dropped_events);
+  m.def(
+      "_hot_trace_dump_chrome_trace",
+      &torch_ipex::utils::hot_trace::dump_chrome_trace);
+
+  // layer-ahead weight prefetcher for memory-tiered systems
+  m.def(
+      "_weight_prefetcher_register_layer",
+      [](const std::vector<at::Tensor>& weights) {
+        torch_ipex::runtime::get_weight_prefetcher().register_layer(weights);
+      });
+  m.def("_weight_prefetcher_clear", []() {
+    torch_ipex::runtime::get_weight_prefetcher().clear_layers();
+  });
+  m.def("_weight_prefetcher_num_layers", []() {
+    return torch_ipex::runtime::get_weight_prefetcher().num_layers();
+  });
+  m.def("_weight_prefetcher_advance", [](size_t layer_idx) {
+    torch_ipex::runtime::get_weight_prefetcher().advance(layer_idx);
+  });
+  m.def("_weight_prefetcher_prefetched_bytes", []() {
+    return torch_ipex::runtime::get_weight_prefetcher().prefetched_bytes();
+  });
+
+  // KV cache tiering between DRAM and a file-backed far tier
+  m.def(
+      "_kv_tier_register_cache", [](const std::vector<at::Tensor>& caches) {
+        torch_ipex::runtime::get_kv_cache_tier_manager().register_cache(
+            caches);
+      });
+  m.def("_kv_tier_clear", []() {
+    torch_ipex::runtime::get_kv_cache_tier_manager().clear();
+  });
+  m.def(
+      "_kv_tier_touch",
+      [](const std::vector<int64_t>& block_ids, int64_t step) {
+        torch_ipex::runtime::get_kv_cache_tier_manager().touch(
+            block_ids, step);
+      });
+  m.def("_kv_tier_spill_older_than", [](int64_t step_threshold) {
+    torch_ipex::runtime::get_kv_cache_tier_manager().spill_older_than(
+        step_threshold);
+  });
+  m.def("_kv_tier_prefetch", [](const std::vector<int64_t>& block_ids) {
+    torch_ipex::runtime::get_kv_cache_tier_manager().prefetch(block_ids);
+  });
+  m.def("_kv_tier_wait", []() {
+    torch_ipex::runtime::get_kv_cache_tier_manager().wait();
+  });
+  m.def("_kv_tier_num_blocks", []() {
+    return torch_ipex::runtime::get_kv_cache_tier_manager().num_blocks();
+  });
+  m.def("_kv_tier_spilled_blocks", []() {
+    return torch_ipex::runtime::get_kv_cache_tier_manager().spilled_blocks();
+  });
+  m.def("_kv_tier_bytes_spilled", []() {
+    return torch_ipex::runtime::get_kv_cache_tier_manager().bytes_spilled();
+  });
+  m.def("_kv_tier_bytes_fetched", []() {
+    return torch_ipex::runtime::get_kv_cache_tier_manager().bytes_fetched();
+  });
+
   m.def("enable_jit_opt", []() {
     AutoOptConfig::singleton().set_jit_fuse(true);
   });
@@ -166,6 +507,22 @@ void InitIpexModuleBindings(py::module m) {
     return AutoOptConfig::singleton().get_jit_repack_for_linear();
   });
 
+  // graph memory planner
+  m.def("_jit_memory_planner_enter", [](const std::string& tag) {
+    torch_ipex::jit::enter_memory_planning_region(tag);
+  });
+  m.def("_jit_memory_planner_exit", []() {
+    torch_ipex::jit::exit_memory_planning_region();
+  });
+  m.def("_jit_memory_planner_stats", [](const std::string& tag) {
+    auto* planner = torch_ipex::jit::get_memory_planner(tag);
+    auto py_dict = py::dict();
+    py_dict["arena_nbytes"] = planner->get_arena_nbytes();
+    py_dict["planned_allocations"] = planner->get_planned_alloc_count();
+    py_dict["delegated_allocations"] = planner->get_delegated_alloc_count();
+    return py_dict;
+  });
+
   // BF32
   py::enum_<FP32MathMode>(m, "FP32MathMode")
       .value("FP32", FP32MathMode::FP32)
@@ -173,6 +530,31 @@ void InitIpexModuleBindings(py::module m) {
       .value("BF32", FP32MathMode::BF32)
       .export_values();
 
+  py::enum_<torch_ipex::FpMathOpCategory>(m, "FpMathOpCategory")
+      .value("CONV", torch_ipex::FpMathOpCategory::CONV)
+      .value("LINEAR", torch_ipex::FpMathOpCategory::LINEAR)
+      .value("MATMUL", torch_ipex::FpMathOpCategory::MATMUL)
+      .value("RNN", torch_ipex::FpMathOpCategory::RNN)
+      .export_values();
+
+  py::enum_<torch_ipex::MathPrecisionClass>(m, "MathPrecisionClass")
+      .value("HIGH", torch_ipex::MathPrecisionClass::HIGH)
+      .value("MEDIUM", torch_ipex::MathPrecisionClass::MEDIUM)
+      .value("LOW", torch_ipex::MathPrecisionClass::LOW)
+      .export_values();
+
+  m.def("set_math_precision", [](torch_ipex::MathPrecisionClass precision) {
+    torch_ipex::setMathPrecisionClassCpu(precision);
+  });
+  m.def("get_math_precision", &torch_ipex::getMathPrecisionClassCpu);
+  m.def(
+      "push_math_precision_scope",
+      [](torch_ipex::MathPrecisionClass precision) {
+        torch_ipex::pushMathPrecisionClassCpu(precision);
+      });
+  m.def(
+      "pop_math_precision_scope", &torch_ipex::popMathPrecisionClassCpu);
+
   // runtime
   py::class_<torch_ipex::runtime::FutureTensor>(m, "FutureTensor")
       .def("get", &torch_ipex::runtime::FutureTensor::get);
@@ -187,8 +569,23 @@ void InitIpexModuleBindings(py::module m) {
         return std::make_shared<torch_ipex::runtime::CPUPool>(
             py::cast<std::vector<int32_t>>(core_list));
       }))
+      // sibling_policy: 0 uniform, 1 physical-core-only, 2 SMT-paired
+      .def(py::init([](const py::list& core_list, int32_t sibling_policy) {
+        return std::make_shared<torch_ipex::runtime::CPUPool>(
+            py::cast<std::vector<int32_t>>(core_list),
+            static_cast<torch_ipex::runtime::SiblingPolicy>(sibling_policy));
+      }))
       .def("get_core_list", [](torch_ipex::runtime::CPUPool& self) {
         return self.get_cpu_core_list();
+      })
+      .def("get_node_list", [](torch_ipex::runtime::CPUPool& self) {
+        return self.get_numa_node_list();
+      })
+      .def("get_physical_core_list", [](torch_ipex::runtime::CPUPool& self) {
+        return self.get_physical_core_list();
+      })
+      .def("get_smt_sibling_list", [](torch_ipex::runtime::CPUPool& self) {
+        return self.get_smt_sibling_list();
       });
 
   py::class_<
@@ -224,6 +621,62 @@ void InitIpexModuleBindings(py::module m) {
             return self.run_async(std::move(args), std::move(kwargs));
           });
 
+  py::class_<
+      torch_ipex::runtime::PipelinedTaskModule,
+      std::shared_ptr<torch_ipex::runtime::PipelinedTaskModule>>(
+      m, "PipelinedTaskModule")
+      .def(py::init(
+          [](const std::vector<torch::jit::Module>& stage_modules,
+             const std::vector<
+                 std::shared_ptr<torch_ipex::runtime::CPUPool>>& cpu_pools,
+             size_t max_in_flight) {
+            return std::make_shared<torch_ipex::runtime::PipelinedTaskModule>(
+                stage_modules, cpu_pools, max_in_flight);
+          }))
+      .def(
+          "run_sync",
+          [](torch_ipex::runtime::PipelinedTaskModule& self,
+             py::args& args,
+             py::kwargs& kwargs) {
+            return self.run_sync(std::move(args), std::move(kwargs));
+          })
+      .def(
+          "run_async",
+          [](torch_ipex::runtime::PipelinedTaskModule& self,
+             py::args& args,
+             py::kwargs& kwargs) {
+            return self.run_async(std::move(args), std::move(kwargs));
+          });
+
+  py::class_<
+      torch_ipex::runtime::ShardReducer,
+      std::shared_ptr<torch_ipex::runtime::ShardReducer>>(m, "ShardReducer")
+      .def(py::init([](size_t num_shards, bool concat, int64_t cat_dim) {
+        return std::make_shared<torch_ipex::runtime::ShardReducer>(
+            num_shards,
+            concat ? torch_ipex::runtime::ShardReducer::ReduceOp::kConcat
+                   : torch_ipex::runtime::ShardReducer::ReduceOp::kSum,
+            cat_dim);
+      }))
+      .def(
+          "submit",
+          [](torch_ipex::runtime::ShardReducer& self,
+             size_t shard_id,
+             const at::Tensor& shard) {
+            py::gil_scoped_release release;
+            self.submit(shard_id, shard);
+          })
+      .def(
+          "wait_and_get",
+          [](torch_ipex::runtime::ShardReducer& self) {
+            py::gil_scoped_release release;
+            return self.wait_and_get();
+          })
+      .def("reset", &torch_ipex::runtime::ShardReducer::reset)
+      .def(
+          "get_num_shards",
+          &torch_ipex::runtime::ShardReducer::get_num_shards);
+
   m.def(
       "get_process_available_cores",
       &torch_ipex::runtime::get_process_available_cores);
@@ -251,8 +704,46 @@ void InitIpexModuleBindings(py::module m) {
         torch_ipex::runtime::set_mask_affinity_from_cpu_pool((*cpu_pool));
         return;
       });
+  m.def(
+      "start_affinity_watchdog",
+      [](int64_t interval_ms) {
+        torch_ipex::runtime::start_affinity_watchdog(interval_ms);
+      },
+      py::arg("interval_ms") = 2000);
+  m.def(
+      "stop_affinity_watchdog", &torch_ipex::runtime::stop_affinity_watchdog);
+  m.def("get_affinity_watchdog_stats", []() {
+    auto stats = torch_ipex::runtime::get_affinity_watchdog_stats();
+    py::dict result;
+    result["checks"] = stats.checks;
+    result["drift_events"] = stats.drift_events;
+    result["repin_events"] = stats.repin_events;
+    result["migrations"] = stats.migrations;
+    result["watched_threads"] = stats.watched_threads;
+    return result;
+  });
+  m.def(
+      "set_task_slab_allocator_enabled",
+      &torch_ipex::runtime::set_task_slab_allocator_enabled);
+  m.def(
+      "is_task_slab_allocator_enabled",
+      &torch_ipex::runtime::is_task_slab_allocator_enabled);
+  m.def("get_decode_slab_stats", []() {
+    auto stats = torch_ipex::runtime::get_decode_slab_stats();
+    py::dict result;
+    result["slab_hits"] = stats.slab_hits;
+    result["slab_misses"] = stats.slab_misses;
+    result["delegated"] = stats.delegated;
+    result["reserved_bytes"] = stats.reserved_bytes;
+    result["outstanding_blocks"] = stats.outstanding_blocks;
+    return result;
+  });
+  m.def(
+      "release_decode_slab_memory",
+      &torch_ipex::runtime::release_decode_slab_memory);
 
   m.def("roc_auc_score", &toolkit::roc_auc_score);
+  m.def("roc_auc_score_approx", &toolkit::roc_auc_score_approx);
   m.def("roc_auc_score_all", &toolkit::roc_auc_score_all);
 
   // libxsmm
@@ -264,6 +755,7 @@ void InitIpexModuleBindings(py::module m) {
   m.def("tpp_bf16_split_add_", &torch_ipex::tpp::bf16_split_add_);
   m.def("tpp_fused_adamw", &torch_ipex::tpp::fused_adamw);
   m.def("tpp_fused_split_adamw", &torch_ipex::tpp::fused_split_adamw);
+  m.def("tpp_fused_split_adam", &torch_ipex::tpp::fused_split_adam);
   m.def("tpp_clip_grad_norm", &torch_ipex::tpp::clip_grad_norm);
   m.def("tpp_fused_lamb", &torch_ipex::tpp::fused_lamb);
   m.def("tpp_fused_lamb_v2", &torch_ipex::tpp::fused_lamb_v2);
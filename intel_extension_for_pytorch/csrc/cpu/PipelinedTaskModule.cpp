@@ -0,0 +1,140 @@
+#include "PipelinedTaskModule.h"
+
+namespace torch_ipex {
+namespace runtime {
+
+PipelinedTaskModule::PipelinedTaskModule(
+    const std::vector<torch::jit::Module>& stage_modules,
+    const std::vector<std::shared_ptr<torch_ipex::runtime::CPUPool>>& cpu_pools,
+    size_t max_in_flight)
+    : max_in_flight(max_in_flight) {
+  if (stage_modules.size() == 0) {
+    throw std::runtime_error(
+        "Fail to init PipelinedTaskModule with zero stages.");
+  }
+  if (stage_modules.size() != cpu_pools.size()) {
+    throw std::runtime_error(
+        "Fail to init PipelinedTaskModule. Each stage module needs its own CPUPool.");
+  }
+  if (this->max_in_flight == 0) {
+    throw std::runtime_error(
+        "Fail to init PipelinedTaskModule. max_in_flight must be at least 1.");
+  }
+  for (size_t stage_id = 0; stage_id < stage_modules.size(); stage_id++) {
+    auto stage = std::make_shared<Stage>();
+    stage->module = stage_modules[stage_id];
+    stage->task_executor = std::make_shared<TaskExecutor>(*cpu_pools[stage_id]);
+    this->stages.emplace_back(std::move(stage));
+  }
+}
+
+PipelinedTaskModule::~PipelinedTaskModule() {
+  pybind11::gil_scoped_release no_gil_guard;
+  // Stop back to front so an upstream stage can't hand a frame to an
+  // already-stopped downstream executor.
+  for (auto stage = this->stages.rbegin(); stage != this->stages.rend();
+       ++stage) {
+    (*stage)->task_executor->stop_executor();
+  }
+}
+
+void PipelinedTaskModule::acquire_in_flight_slot() {
+  std::unique_lock<std::mutex> lock(this->in_flight_mutex);
+  this->in_flight_condition.wait(
+      lock, [this] { return this->in_flight < this->max_in_flight; });
+  this->in_flight++;
+}
+
+void PipelinedTaskModule::release_in_flight_slot() {
+  {
+    std::unique_lock<std::mutex> lock(this->in_flight_mutex);
+    this->in_flight--;
+  }
+  this->in_flight_condition.notify_one();
+}
+
+void PipelinedTaskModule::submit_to_stage(
+    size_t stage_id,
+    std::vector<c10::IValue>&& stage_inputs,
+    std::shared_ptr<std::promise<c10::IValue>> result_promise,
+    bool grad_mode) {
+  auto stage = this->stages[stage_id];
+  // Capture the inputs by value inside a shared_ptr: std::function
+  // requires the callable to be copyable.
+  auto inputs = std::make_shared<std::vector<c10::IValue>>(
+      std::move(stage_inputs));
+  stage->task_executor->submit(
+      [this, stage, stage_id, inputs, result_promise, grad_mode]() {
+        // set the thread local status, such as the grad mode before
+        // execuating the status
+        at::GradMode::set_enabled(grad_mode);
+        try {
+          c10::IValue stage_output = stage->module.forward(std::move(*inputs));
+          if (stage_id + 1 < this->stages.size()) {
+            // Hand the frame to the next stage. A tuple output feeds
+            // the next stage's inputs positionally.
+            std::vector<c10::IValue> next_inputs;
+            if (stage_output.isTuple()) {
+              for (auto& element : stage_output.toTupleRef().elements()) {
+                next_inputs.emplace_back(element);
+              }
+            } else {
+              next_inputs.emplace_back(std::move(stage_output));
+            }
+            this->submit_to_stage(
+                stage_id + 1, std::move(next_inputs), result_promise, grad_mode);
+          } else {
+            result_promise->set_value(std::move(stage_output));
+            this->release_in_flight_slot();
+          }
+        } catch (...) {
+          result_promise->set_exception(std::current_exception());
+          this->release_in_flight_slot();
+        }
+      });
+}
+
+std::unique_ptr<FutureTensor> PipelinedTaskModule::run_async(
+    py::args&& args,
+    py::kwargs&& kwargs) {
+  std::unique_ptr<FutureTensor> future_tensor_result =
+      std::make_unique<FutureTensor>();
+
+  // Get the thread_local status such as grad_mode and set it into the Async
+  // thread
+  auto grad_mode = at::GradMode::is_enabled();
+  {
+    pybind11::gil_scoped_release no_gil_guard;
+    this->acquire_in_flight_slot();
+  }
+  auto& first_stage_module = this->stages.front()->module;
+  auto& function = first_stage_module.get_method("forward").function();
+  std::vector<at::IValue> stack = torch::jit::createStackForSchema(
+      function.getSchema(),
+      std::move(args),
+      // NOLINTNEXTLINE(performance-move-const-arg)
+      std::move(kwargs),
+      first_stage_module._ivalue());
+  // createStackForSchema prepends self; Module::forward prepends it
+  // again inside the stage, so drop it here.
+  stack.erase(stack.begin());
+
+  auto result_promise = std::make_shared<std::promise<c10::IValue>>();
+  future_tensor_result->script_module_initialized_ = true;
+  future_tensor_result->future_script_tensor = result_promise->get_future();
+  {
+    pybind11::gil_scoped_release no_gil_guard;
+    this->submit_to_stage(0, std::move(stack), result_promise, grad_mode);
+  }
+  return future_tensor_result;
+}
+
+py::object PipelinedTaskModule::run_sync(py::args&& args, py::kwargs&& kwargs) {
+  // sync API to run application inside the pipeline
+  std::unique_ptr<FutureTensor> future_tensor_result =
+      this->run_async(std::move(args), std::move(kwargs));
+  return future_tensor_result->get();
+}
+
+} // namespace runtime
+} // namespace torch_ipex
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cassert>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include <ATen/core/ivalue.h>
+#include <Macros.h>
+#include <torch/csrc/jit/api/module.h>
+#include <torch/csrc/jit/python/pybind_utils.h>
+#include <torch/csrc/utils/pybind.h>
+#include "TaskExecutor.h"
+#include "TaskModule.h"
+
+namespace torch_ipex {
+namespace runtime {
+
+/*PipelinedTaskModule splits a model into script-module stages. Each
+stage owns its own TaskExecutor/CPUPool, and a frame is handed from
+stage to stage through the executors, so preprocessing, backbone and
+head run concurrently on disjoint core sets. A bounded in-flight
+window provides backpressure: run_async blocks once max_in_flight
+frames are inside the pipeline.*/
+class PipelinedTaskModule {
+ public:
+  explicit PipelinedTaskModule(
+      const std::vector<torch::jit::Module>& stage_modules,
+      const std::vector<std::shared_ptr<torch_ipex::runtime::CPUPool>>&
+          cpu_pools,
+      size_t max_in_flight);
+  PipelinedTaskModule(const PipelinedTaskModule& pipelined_task_module) =
+      delete;
+  PipelinedTaskModule(PipelinedTaskModule&& pipelined_task_module) = delete;
+  PipelinedTaskModule& operator=(
+      const PipelinedTaskModule& pipelined_task_module) = delete;
+  PipelinedTaskModule& operator=(PipelinedTaskModule&& pipelined_task_module) =
+      delete;
+  ~PipelinedTaskModule();
+  py::object run_sync(py::args&& args, py::kwargs&& kwargs);
+  std::unique_ptr<FutureTensor> run_async(
+      py::args&& args,
+      py::kwargs&& kwargs);
+
+ private:
+  struct Stage {
+    torch::jit::Module module;
+    std::shared_ptr<TaskExecutor> task_executor;
+  };
+
+  // Run stage_id on inputs and forward the result to the next stage,
+  // fulfilling result_promise after the last one.
+  void submit_to_stage(
+      size_t stage_id,
+      std::vector<c10::IValue>&& stage_inputs,
+      std::shared_ptr<std::promise<c10::IValue>> result_promise,
+      bool grad_mode);
+  void acquire_in_flight_slot();
+  void release_in_flight_slot();
+
+  std::vector<std::shared_ptr<Stage>> stages;
+
+  // Backpressure between the submitting thread and the pipeline.
+  size_t max_in_flight;
+  size_t in_flight{0};
+  std::mutex in_flight_mutex;
+  std::condition_variable in_flight_condition;
+};
+
+} // namespace runtime
+} // namespace torch_ipex
@@ -1,10 +1,60 @@
 #include "Event.h"
 #include <torch/csrc/THP.h>
 #include <torch/csrc/utils/python_arg_parser.h>
+#include <mutex>
+#include <vector>
 #include "Stream.h"
 
 namespace xpu {
 
+namespace {
+
+// Free list of completed events. Creating a SYCL-backed event is not free,
+// and pipelines that fence every small kernel allocate thousands of short
+// lived wrappers per second; recycling the finished ones makes event
+// construction a vector pop in the steady state. Bounded so an allocation
+// burst cannot pin events forever.
+constexpr size_t kMaxPooledEvents = 64;
+std::mutex event_pool_mutex;
+std::vector<std::shared_ptr<xpu::dpcpp::DPCPPEventBase>> event_pool;
+
+std::shared_ptr<xpu::dpcpp::DPCPPEventBase> acquire_dpcpp_event() {
+  {
+    std::lock_guard<std::mutex> guard(event_pool_mutex);
+    if (!event_pool.empty()) {
+      auto event = std::move(event_pool.back());
+      event_pool.pop_back();
+      return event;
+    }
+  }
+  return xpu::dpcpp::create_dpcpp_event();
+}
+
+void release_dpcpp_event(
+    std::shared_ptr<xpu::dpcpp::DPCPPEventBase>&& event) noexcept {
+  // Only recycle events this wrapper owned exclusively and whose work has
+  // completed; an in-flight event must keep its identity until it fires.
+  if (!event || event.use_count() != 1) {
+    event.reset();
+    return;
+  }
+  try {
+    if (!event->query()) {
+      event.reset();
+      return;
+    }
+  } catch (...) {
+    event.reset();
+    return;
+  }
+  std::lock_guard<std::mutex> guard(event_pool_mutex);
+  if (event_pool.size() < kMaxPooledEvents) {
+    event_pool.push_back(std::move(event));
+  }
+}
+
+} // anonymous namespace
+
 PyObject* THDPEventClass = nullptr;
 
 static PyObject* THDPEvent_pynew(
@@ -34,7 +84,7 @@ static PyObject* THDPEvent_pynew(
   //    (enable_timing ? xpuEventDefault : xpuEventDisableTiming) |
   //    (interprocess ? xpuEventInterprocess : xpuEventDefault);
 
-  self->dpcpp_event = xpu::dpcpp::create_dpcpp_event();
+  self->dpcpp_event = acquire_dpcpp_event();
 
   return (PyObject*)ptr.release();
   END_HANDLE_TH_ERRORS
@@ -69,13 +119,14 @@ static PyObject* THDPEvent_from_ipc_handle(
 
   //  xpuIpcEventHandle_t handle;
   //  std::memcpy(&handle, handle_string.c_str(), handle_string.size());
-  self->dpcpp_event = xpu::dpcpp::create_dpcpp_event();
+  self->dpcpp_event = acquire_dpcpp_event();
 
   return (PyObject*)ptr.release();
   END_HANDLE_TH_ERRORS
 }
 
 static void THDPEvent_dealloc(THDPEvent* self) {
+  release_dpcpp_event(std::move(self->dpcpp_event));
   self->dpcpp_event.reset();
   Py_TYPE(self)->tp_free((PyObject*)self);
 }
@@ -110,6 +161,36 @@ static PyObject* THDPEvent_wait(THDPEvent* self, THDPStream* stream) {
   END_HANDLE_TH_ERRORS
 }
 
+// Enqueue a wait on `stream` for every event in a sequence with a single
+// Python call; per-event `wait` calls add measurable dispatch overhead when
+// small-kernel graphs fence against many producers at once.
+static PyObject* THDPEvent_wait_events(PyObject* _unused, PyObject* args) {
+  HANDLE_TH_ERRORS
+  PyObject* py_stream = nullptr;
+  PyObject* py_events = nullptr;
+  if (!PyArg_ParseTuple(args, "OO", &py_stream, &py_events)) {
+    return nullptr;
+  }
+  TORCH_CHECK(
+      THDPStream_Check(py_stream),
+      "wait_events: first argument must be an XPU stream");
+  auto* stream = (THDPStream*)py_stream;
+  THPObjectPtr seq(
+      PySequence_Fast(py_events, "wait_events: events must be a sequence"));
+  if (!seq) {
+    return nullptr;
+  }
+  Py_ssize_t num_events = PySequence_Fast_GET_SIZE(seq.get());
+  for (Py_ssize_t i = 0; i < num_events; i++) {
+    PyObject* item = PySequence_Fast_GET_ITEM(seq.get(), i);
+    TORCH_CHECK(
+        THDPEvent_Check(item), "wait_events: expected a sequence of XPU events");
+    ((THDPEvent*)item)->dpcpp_event->block(stream->dpcpp_stream);
+  }
+  Py_RETURN_NONE;
+  END_HANDLE_TH_ERRORS
+}
+
 static PyObject* THDPEvent_query(THDPEvent* self, PyObject* noargs) {
   HANDLE_TH_ERRORS
   return PyBool_FromLong(self->dpcpp_event->query());
@@ -157,6 +238,10 @@ static PyMethodDef THDPEvent_methods[] = {
      nullptr},
     {(char*)"record", (PyCFunction)THDPEvent_record, METH_O, nullptr},
     {(char*)"wait", (PyCFunction)THDPEvent_wait, METH_O, nullptr},
+    {(char*)"wait_events",
+     (PyCFunction)(void (*)(void))THDPEvent_wait_events,
+     METH_STATIC | METH_VARARGS,
+     nullptr},
     {(char*)"query", (PyCFunction)THDPEvent_query, METH_NOARGS, nullptr},
     {(char*)"elapsed_time",
      (PyCFunction)THDPEvent_elapsed_time,
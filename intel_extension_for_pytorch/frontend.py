@@ -728,3 +728,123 @@ def get_fp32_math_mode(device="cpu"):
         raise RuntimeError(
             "Unexpected device type {}. ".format(device) + "Supported are 'cpu', 'xpu'."
         )
+
+
+class fp32_math_mode_scope(object):
+    r"""
+    Context manager scoping the fpmath mode per op category (CPU ONLY).
+
+    Unlike ``set_fp32_math_mode``, which toggles implicit conversion
+    globally, this pushes a thread-local policy that the oneDNN
+    convolution/linear/matmul/rnn paths consult while the scope is
+    active, so different parts of a model can run with different math
+    modes -- e.g. the feature extractor with ``FP32MathMode.BF32`` while
+    the logit head stays strict. Scopes nest; the innermost one wins,
+    and ops not covered by a category keep the global mode.
+
+    Args:
+        conv_mode (FP32MathMode): mode for convolution ops. Default: ``FP32MathMode.FP32``.
+        linear_mode (FP32MathMode): mode for linear/inner-product ops. Default: ``FP32MathMode.FP32``.
+        matmul_mode (FP32MathMode): mode for matmul/einsum ops. Default: ``FP32MathMode.FP32``.
+        rnn_mode (FP32MathMode): mode for rnn ops. Default: ``FP32MathMode.FP32``.
+
+    Examples:
+
+        >>> import intel_extension_for_pytorch as ipex
+        >>> with ipex.fp32_math_mode_scope(conv_mode=ipex.FP32MathMode.BF32):
+        >>>     features = backbone(x)
+        >>> logits = head(features)  # strict again outside the scope
+    """
+
+    def __init__(
+        self,
+        conv_mode=FP32MathMode.FP32,
+        linear_mode=FP32MathMode.FP32,
+        matmul_mode=FP32MathMode.FP32,
+        rnn_mode=FP32MathMode.FP32,
+    ):
+        self.conv_mode = core.FP32MathMode(int(conv_mode))
+        self.linear_mode = core.FP32MathMode(int(linear_mode))
+        self.matmul_mode = core.FP32MathMode(int(matmul_mode))
+        self.rnn_mode = core.FP32MathMode(int(rnn_mode))
+
+    def __enter__(self):
+        core.push_fp32_math_mode_policy(
+            self.conv_mode, self.linear_mode, self.matmul_mode, self.rnn_mode
+        )
+        return self
+
+    def __exit__(self, exc_type, exc_value, traceback):
+        core.pop_fp32_math_mode_policy()
+        return False
+
+
+class MathPrecisionClass(IntEnum):
+    HIGH = int(core.MathPrecisionClass.HIGH)
+    MEDIUM = int(core.MathPrecisionClass.MEDIUM)
+    LOW = int(core.MathPrecisionClass.LOW)
+
+
+def set_math_precision(precision=MathPrecisionClass.MEDIUM):
+    r"""
+    Set the global precision class for transcendental math in the
+    hand-written activation kernels (CPU ONLY).
+
+    Args:
+        precision (MathPrecisionClass): ``MathPrecisionClass.HIGH`` forces
+            full-precision routines everywhere, ``MathPrecisionClass.MEDIUM``
+            (the default) keeps each kernel's tuned default, and
+            ``MathPrecisionClass.LOW`` selects the fastest available
+            approximations (absolute error up to ~1e-3) for inference paths
+            that tolerate it.
+
+    Examples:
+
+        >>> import intel_extension_for_pytorch as ipex
+        >>> ipex.set_math_precision(ipex.MathPrecisionClass.LOW)
+    """
+
+    core.set_math_precision(core.MathPrecisionClass(int(precision)))
+
+
+def get_math_precision():
+    r"""
+    Return the global :class:`MathPrecisionClass` (CPU ONLY).
+    """
+
+    return MathPrecisionClass(int(core.get_math_precision()))
+
+
+class math_precision_scope(object):
+    r"""
+    Context manager scoping the transcendental math precision class
+    (CPU ONLY).
+
+    Unlike ``set_math_precision``, which switches the precision class
+    globally, this pushes a thread-local scope that the activation
+    kernels consult while it is active, so one submodule can run looser
+    math than the rest of the model. Scopes nest; the innermost one
+    wins.
+
+    Args:
+        precision (MathPrecisionClass): precision class for the scope.
+            Default: ``MathPrecisionClass.LOW``.
+
+    Examples:
+
+        >>> import intel_extension_for_pytorch as ipex
+        >>> with ipex.math_precision_scope(ipex.MathPrecisionClass.LOW):
+        >>>     encoded = encoder(x)  # fast tanh/GELU approximations
+        >>> logits = head(encoded)  # tuned default again outside
+    """
+
+    def __init__(self, precision=MathPrecisionClass.LOW):
+        self.precision = core.MathPrecisionClass(int(precision))
+
+    def __enter__(self):
+        core.push_math_precision_scope(self.precision)
+        return self
+
+    def __exit__(self, exc_type, exc_value, traceback):
+        core.pop_math_precision_scope()
+        return False
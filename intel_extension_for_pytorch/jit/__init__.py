@@ -1 +1,33 @@
 from . import _trace
+
+
+def save_optimized_graph(graph, f):
+    r"""Snapshot a post-fusion optimized TorchScript graph so a new process
+    can skip the fusion/profiling warmup.
+
+    Args:
+        graph: the optimized graph of a warmed-up model, e.g.
+            ``traced_model.graph_for(*example_inputs)``.
+        f: destination file path.
+    """
+    from intel_extension_for_pytorch import _C
+
+    payload = _C._jit_save_optimized_graph(graph)
+    with open(f, "wb") as out:
+        out.write(payload)
+
+
+def load_optimized_graph(f):
+    r"""Reload a graph snapshot produced by :func:`save_optimized_graph`.
+
+    The snapshot records a fingerprint of the producing build (snapshot
+    format, ISA level, oneDNN version) and loading fails if the current
+    process does not match. Returns the optimized ``torch.Graph`` with the
+    fusion groups re-formed; oneDNN partition kernels are recompiled lazily
+    on the first run.
+    """
+    from intel_extension_for_pytorch import _C
+
+    with open(f, "rb") as inp:
+        payload = inp.read()
+    return _C._jit_load_optimized_graph(payload)
@@ -1,4 +1,5 @@
 from ...cpu.nn import _embeddingbag
 from . import _tensor_method
 from ...cpu.nn.interaction import interaction, InteractionFunc
+from ...cpu.nn.dropout_add_layernorm import dropout_add_layer_norm
 from ...cpu.nn import _roi_align_helper
@@ -5,5 +5,6 @@ from .merged_embeddingbag import MergedEmbeddingBag
 from .merged_embeddingbag import MergedEmbeddingBagWithCat
 from .merged_embeddingbag import MergedEmbeddingBagWithAdaGrad
 from .merged_embeddingbag import DistMergeEmbeddingBagWithAdaGrad
+from .merged_embeddingbag import DistEmbOverlapScheduler
 from ...cpu.nn.linear_fuse_eltwise import IPEXLinearEltwise
 from .weight_only_quantization import WeightOnlyQuantizedLinear
@@ -58,6 +58,21 @@ def merged_embeddingbag_with_cat(
     )
 
 
+def merged_embeddingbag_with_interaction(
+    weights,
+    indices,
+    offsets,
+    dense_feature,
+):
+    if torch.is_grad_enabled():
+        raise NotImplementedError(
+            "do not support training for merged_embeddingbag_with_interaction"
+        )
+    return torch.ops.torch_ipex.merged_embeddingbag_interaction_forward(
+        weights, indices, offsets, dense_feature
+    )
+
+
 def merged_embeddingbag_sgd(
     weights, indices, offsets, pooling_mode, include_last_offset, sgd_args
 ):
@@ -307,6 +322,9 @@ class MergedEmbeddingBag(nn.Module):
                 weight = torch.empty((num_embeddings, embedding_dim), dtype=dtype)
             self.weights[i] = nn.Parameter(weight)
 
+        self.quantized = False
+        self.quantized_output_dtype = None
+
     @classmethod
     def from_embeddingbag_list(
         cls,
@@ -342,6 +360,48 @@ class MergedEmbeddingBag(nn.Module):
                 s += "\n"
         return s
 
+    def quantize_for_inference(self, int4_tables=None, output_dtype=None):
+        r"""
+        Convert the tables to row-wise quantized inference-only storage:
+        INT8 by default, packed INT4 for the tables listed in
+        ``int4_tables`` (typically cold tables where the extra quantization
+        error is acceptable). Each row keeps one fp32 scale and
+        dequantization is fused into the lookup accumulation, so table
+        memory (and lookup bandwidth) shrinks ~4x/~8x vs fp32. The fp32
+        weights are dropped; the module can no longer be trained.
+
+        Args:
+            int4_tables (List[int], optional): table ids to store as INT4.
+            output_dtype (torch.dtype, optional): dtype of the lookup
+                outputs (``torch.float32`` if not given).
+        """
+        assert not self.quantized, "tables are already quantized"
+        int4_tables = set(int4_tables) if int4_tables is not None else set()
+        eps = torch.finfo(torch.float32).eps
+        for i in range(self.n_tables):
+            w = self.weights[i].detach().float()
+            if i in int4_tables:
+                assert (
+                    self.embedding_dim % 2 == 0
+                ), "INT4 tables require an even embedding_dim"
+                scale = w.abs().amax(dim=1).clamp(min=eps) / 7.0
+                q = torch.round(w / scale.unsqueeze(1)).clamp(-7, 7).to(torch.int16)
+                # two signed nibbles per byte, low nibble first
+                qweight = ((q[:, 1::2] & 0xF) << 4 | (q[:, 0::2] & 0xF)).to(
+                    torch.uint8
+                )
+            else:
+                scale = w.abs().amax(dim=1).clamp(min=eps) / 127.0
+                qweight = (
+                    torch.round(w / scale.unsqueeze(1)).clamp(-127, 127).to(torch.int8)
+                )
+            self.register_buffer("qweight_{}".format(i), qweight.contiguous())
+            self.register_buffer("qscale_{}".format(i), scale.contiguous())
+            # free the fp32 copy
+            self.weights[i] = nn.Parameter(torch.empty(0, dtype=self.dtype))
+        self.quantized = True
+        self.quantized_output_dtype = output_dtype
+
     def forward(self, indices, offsets):
         r"""
         Args:
@@ -352,6 +412,23 @@ class MergedEmbeddingBag(nn.Module):
         Returns:
             List[Tensor] output shape of `(batch_size, embedding_dim)` which length = num of tables.
         """
+        if self.quantized:
+            qweights = [
+                getattr(self, "qweight_{}".format(i)) for i in range(self.n_tables)
+            ]
+            qscales = [
+                getattr(self, "qscale_{}".format(i)) for i in range(self.n_tables)
+            ]
+            return torch.ops.torch_ipex.merged_embeddingbag_forward_quantized(
+                qweights,
+                qscales,
+                indices,
+                offsets,
+                self.embedding_dim,
+                self.pooling_mode,
+                self.include_last_offset,
+                self.quantized_output_dtype,
+            )
         assert self.dense
         return merged_embeddingbag(
             self.weights, indices, offsets, self.pooling_mode, self.include_last_offset
@@ -831,3 +908,74 @@ class DistMergeEmbeddingBagWithAdaGrad(MergedEmbeddingBagWithAdaGrad):
         s += f"world_size: {self._size}, rank_id: {self._rank}\n"
         s += super(DistMergeEmbeddingBagWithAdaGrad, self).extra_repr()
         return s
+
+
+class DistEmbOverlapScheduler(object):
+    r"""
+    Overlap the embedding exchange of `DistMergeEmbeddingBagWithAdaGrad`
+    with dense compute. The lookup + sparse all-to-all + merge for a batch
+    is submitted to a dedicated `intel_extension_for_pytorch.cpu.runtime.CPUPool`
+    through the runtime `Task` API, so the communication for batch n+1 runs
+    while the caller computes the dense towers of batch n on the remaining
+    cores. Results are returned in submission order through double-buffered
+    request slots.
+
+    Only the inference/eval path is scheduled: in training, the fused
+    AdaGrad update in backward would make a prefetched lookup read
+    pre-update weights.
+
+    Example usage:
+
+        >>> pool = ipex.cpu.runtime.CPUPool([62, 63])
+        >>> scheduler = DistEmbOverlapScheduler(distributed_emb, pool)
+        >>> scheduler.prefetch(indices[0], offsets[0])
+        >>> for n in range(num_batch):
+        >>>     if n + 1 < num_batch:
+        >>>         scheduler.prefetch(indices[n + 1], offsets[n + 1])
+        >>>     dense_out = dense_towers(dense_input[n])
+        >>>     emb_out = scheduler.wait()
+        >>>     out = top_mlp(interact(dense_out, emb_out))
+    """
+
+    def __init__(self, emb_module, cpu_pool=None, num_slots: int = 2):
+        from ...cpu.runtime import CPUPool, Task
+
+        assert isinstance(emb_module, DistMergeEmbeddingBagWithAdaGrad)
+        assert num_slots >= 1, "need at least 1 request slot"
+        self._emb = emb_module
+        if cpu_pool is None:
+            cpu_pool = CPUPool()
+        self._num_slots = num_slots
+        self._task = Task(self._exchange, cpu_pool)
+        self._inflight = []
+
+    def _exchange(self, indices, offsets):
+        # runs on the dedicated pool; serialized with other slots by the
+        # single task worker, so the process group sees one exchange at a time
+        with torch.no_grad():
+            return self._emb(indices, offsets)
+
+    def prefetch(self, indices: List[torch.Tensor], offsets: List[torch.Tensor]):
+        r"""
+        Launch the embedding exchange for a future batch. Blocks only when
+        all request slots are already in flight (the oldest slot is then
+        drained first).
+        """
+        assert (
+            not self._emb.training
+        ), "DistEmbOverlapScheduler only schedules the inference path"
+        if len(self._inflight) == self._num_slots:
+            # all slots busy: turn the oldest future into a ready result
+            if not isinstance(self._inflight[0], torch.Tensor):
+                self._inflight[0] = self._inflight[0].get()
+        self._inflight.append(self._task(indices, offsets))
+
+    def wait(self):
+        r"""
+        Return the oldest in-flight exchange result (submission order).
+        """
+        assert len(self._inflight) > 0, "no prefetched batch in flight"
+        out = self._inflight.pop(0)
+        if not isinstance(out, torch.Tensor):
+            out = out.get()
+        return out
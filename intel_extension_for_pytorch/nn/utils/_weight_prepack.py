@@ -1,3 +1,4 @@
+import os
 import torch
 import torch.nn as nn
 import torch.nn.functional as F
@@ -103,6 +104,12 @@ if "deepspeed" in installed_pkg:
     ds_comm_lib_cpu.impl("all_reduce", _all_reduce)
 
 
+# Number of N-chunks the tensor-parallel TPP linear is split into so the
+# allreduce of each finished chunk overlaps with the GEMM of the next one.
+# 0/1 keeps the single GEMM followed by one blocking allreduce.
+_tp_overlap_chunks = int(os.environ.get("IPEX_TP_OVERLAP_ALLREDUCE", "0"))
+
+
 def _all_reduce_and_bias_add(mp_group, original_bias, output):
     if mp_group is not None:
         torch.ops.deepspeed_comm.all_reduce(output)
@@ -333,20 +340,71 @@ class _IPEXLinearAllreduce(_IPEXLinear):
     def __init__(self):
         super(_IPEXLinearAllreduce, self).__init__()
 
+    def _use_overlapped_allreduce(self, x):
+        # The blocked weight is [Nk][Nc][Hc][Hk] (or its VNNI 5D form), so
+        # narrowing dim 0 yields a contiguous weight for Hk-wide output
+        # chunks. A padded out_features would make the chunk arithmetic
+        # ambiguous, so only take the overlapped path for the exact shape.
+        return (
+            _tp_overlap_chunks > 1
+            and self.use_tpp
+            and not self.tpp_fallback
+            and self.mp_group is not None
+            and "deepspeed" in installed_pkg
+            and self.weight.dim() >= 4
+            and (
+                self.out_features is None
+                or self.out_features == self.weight.size(0) * self.weight.size(3)
+            )
+        )
+
+    def _overlapped_tpp_forward(self, x):
+        from deepspeed import comm
+
+        x = self.pre_ipex_gemm(x)
+        x = x.to(self.weight.dtype).contiguous()
+        weight = self.weight.detach()
+        Nk = weight.size(0)
+        Hk = weight.size(3)
+        chunks = min(_tp_overlap_chunks, Nk)
+        outputs = []
+        handles = []
+        nk0 = 0
+        for c in range(chunks):
+            nkc = (Nk - nk0 + chunks - c - 1) // (chunks - c)
+            out_c = torch.ops.torch_ipex.tpp_linear(
+                x, weight.narrow(0, nk0, nkc), nkc * Hk
+            )
+            # Kick off the reduction of this chunk while the next chunk's
+            # GEMM runs; inference_all_reduce reduces out_c in place and
+            # returns a handle (or None when it completed synchronously).
+            handles.append(comm.inference_all_reduce(out_c, async_op=True))
+            outputs.append(out_c)
+            nk0 += nkc
+        for h in handles:
+            if h is not None:
+                h.wait()
+        output = torch.cat(outputs, dim=-1)
+        if self.original_bias is not None:
+            output += self.original_bias
+        return output
+
+    def forward(self, x):
+        if self._use_overlapped_allreduce(x):
+            return self._overlapped_tpp_forward(x)
+        return super(_IPEXLinearAllreduce, self).forward(x)
+
     def post_ipex_gemm(self, output):
         return _all_reduce_and_bias_add(self.mp_group, self.original_bias, output)
 
 
-class _IPEXLmHeadLinearAllreduce(_IPEXLinear):
+class _IPEXLmHeadLinearAllreduce(_IPEXLinearAllreduce):
     def __init__(self):
         super(_IPEXLmHeadLinearAllreduce, self).__init__()
 
     def pre_ipex_gemm(self, input):
         return _pre_ipex_gemm(input, self.world_size, self.rank)
 
-    def post_ipex_gemm(self, output):
-        return _all_reduce_and_bias_add(self.mp_group, self.original_bias, output)
-
 
 class _IPEXConvTransposeNd(_IPEXPrepackModule):
     __constants__ = [
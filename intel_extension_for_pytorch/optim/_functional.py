@@ -63,7 +63,11 @@ def _single_tensor_adagrad(
         step_t += 1
         step = step_t.item()
         grad = grad if not maximize else -grad
-        if not (grad.is_sparse or torch.is_complex(param)):
+        # sparse grads take the fused row-sparse path unless weight_decay is
+        # set, which sparse Adagrad does not support
+        if not torch.is_complex(param) and not (
+            grad.is_sparse and weight_decay != 0
+        ):
             torch.ops.torch_ipex.adagrad_fused_step(
                 param, grad, state_sum, param2, step, lr, weight_decay, lr_decay, eps
             )
@@ -1036,21 +1040,32 @@ def _multi_tensor_adam(
     if maximize:
         grads = torch._foreach_neg(tuple(grads))  # type: ignore[assignment]
 
-    _single_tensor_adam(
+    # update steps
+    steps = []
+    for step_t in state_steps:
+        step_t += 1
+        steps.append(step_t.item())
+
+    if amsgrad:
+        max_exp_avg_sq_list = max_exp_avg_sqs
+    else:
+        max_exp_avg_sq_list = [torch.Tensor() for _ in params]
+
+    # single fused kernel launch over the whole parameter group
+    torch.ops.torch_ipex.adam_fused_step_list(
         params,
-        params2,
-        grads,
         exp_avgs,
         exp_avg_sqs,
-        max_exp_avg_sqs,
-        state_steps,
-        amsgrad=amsgrad,
-        beta1=beta1,
-        beta2=beta2,
-        lr=lr,
-        weight_decay=weight_decay,
-        eps=eps,
-        maximize=False,
+        max_exp_avg_sq_list,
+        grads,
+        params2,
+        amsgrad,
+        steps,
+        beta1,
+        beta2,
+        lr,
+        weight_decay,
+        eps,
     )
 
 
@@ -5,60 +5,62 @@ import math
 from torch.nn import functional as F
 
 
+# Every decoder layer instantiates its own RotaryEmbedding, but the sin/cos
+# tables only depend on (max positions, rotary dim, backbone, base). Share
+# one position-indexed table per key so N layers reference a single cache
+# instead of recomputing and storing N identical copies.
+_rope_table_cache = {}
+
+
+def _get_rope_tables(max_seq_len, dim, model_backbone, base):
+    key = (max_seq_len, dim, model_backbone, base)
+    if key not in _rope_table_cache:
+        inv_freq = 1.0 / (base ** (torch.arange(0, dim, 2).float() / dim))
+        t = torch.arange(max_seq_len, dtype=inv_freq.dtype)
+        freqs = torch.einsum("i,j->ij", t, inv_freq)
+        if model_backbone in ["FalconForCausalLM", "RWForCausalLM"]:
+            sin_cos = torch.cat(
+                (freqs.sin().repeat(1, 2), freqs.cos().repeat(1, 2)), dim=-1
+            )
+            emb = torch.cat((freqs, freqs), dim=-1).float()
+            cos_cached = emb.cos()[None, :, :]
+            sin_cached = emb.sin()[None, :, :]
+        else:
+            sin_cos = torch.cat((torch.sin(freqs), torch.cos(freqs)), dim=1)
+            emb = torch.cat((freqs, freqs), dim=-1)
+            cos_cached = emb.cos()[None, None, :, :]
+            sin_cached = emb.sin()[None, None, :, :]
+        _rope_table_cache[key] = (inv_freq, sin_cos, emb, sin_cached, cos_cached)
+    return _rope_table_cache[key]
+
+
 class RotaryEmbedding(torch.nn.Module):
     def __init__(self, max_position_embeddings, dim, backbone, base=10000):
         super().__init__()
-        inv_freq = 1.0 / (base ** (torch.arange(0, dim, 2).float() / dim))
-        self.register_buffer("inv_freq", inv_freq, persistent=False)
         self.max_seq_len_cached = max_position_embeddings
-        t = torch.arange(
-            self.max_seq_len_cached,
-            dtype=self.inv_freq.dtype,
-        )
         self.model_backbone = str(backbone)
-        freqs = torch.einsum("i,j->ij", t, self.inv_freq)
+        self.base = base
+        inv_freq, self.sin_cos, self.emb, sin_cached, cos_cached = _get_rope_tables(
+            self.max_seq_len_cached, dim, self.model_backbone, base
+        )
+        self.register_buffer("inv_freq", inv_freq, persistent=False)
         if (
             self.model_backbone == "FalconForCausalLM"
             or self.model_backbone == "RWForCausalLM"
         ):
-            self.sin_cos = torch.cat(
-                (freqs.sin().repeat(1, 2), freqs.cos().repeat(1, 2)), dim=-1
-            )
-            self.emb = torch.cat((freqs, freqs), dim=-1).float()
-            self.cos_cached = self.emb.cos()[None, :, :]
-            self.sin_cached = self.emb.sin()[None, :, :]
+            self.cos_cached = cos_cached
+            self.sin_cached = sin_cached
         else:
-            self.sin_cos = torch.cat((torch.sin(freqs), torch.cos(freqs)), dim=1)
-            self.emb = torch.cat((freqs, freqs), dim=-1)
-            self.register_buffer(
-                "cos_cached", self.emb.cos()[None, None, :, :], persistent=False
-            )
-            self.register_buffer(
-                "sin_cached", self.emb.sin()[None, None, :, :], persistent=False
-            )
+            self.register_buffer("cos_cached", cos_cached, persistent=False)
+            self.register_buffer("sin_cached", sin_cached, persistent=False)
 
     def forward(self, seq_len=None):
         if seq_len is not None and seq_len > self.max_seq_len_cached:
             self.max_seq_len_cached = seq_len
-            t = torch.arange(self.max_seq_len_cached, dtype=self.inv_freq.dtype)
-            freqs = torch.einsum("i,j->ij", t, self.inv_freq)
-            if (
-                self.model_backbone == "FalconForCausalLM"
-                or self.model_backbone == "RWForCausalLM"
-            ):
-                self.sin_cos = torch.cat(
-                    (freqs.sin().repeat(1, 2), freqs.cos().repeat(1, 2)), dim=-1
-                )
-                self.emb = torch.cat((freqs, freqs), dim=-1).float()
-                self.cos_cached = self.emb.cos()[None, :, :]
-                self.sin_cached = self.emb.sin()[None, :, :]
-            else:
-                self.sin_cos = torch.cat((torch.sin(freqs), torch.cos(freqs)), dim=1)
-                self.emb = torch.cat((freqs, freqs), dim=-1)
-                self.cos_cached = self.emb.cos()[None, None, :, :]
-                self.sin_cached = self.emb.sin()[None, None, :, :]
-                self.cos_cached[:, :, :seq_len, ...]
-                self.sin_cached[:, :, :seq_len, ...]
+            dim = self.inv_freq.shape[0] * 2
+            _, self.sin_cos, self.emb, self.sin_cached, self.cos_cached = (
+                _get_rope_tables(seq_len, dim, self.model_backbone, self.base)
+            )
         return self.sin_cos, self.sin_cached, self.cos_cached
 
 
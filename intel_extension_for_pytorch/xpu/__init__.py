@@ -4,6 +4,7 @@ This package is lazily initialized, so you can always import it.
 
 from torch import serialization
 from torch.storage import _StorageBase
+import os
 import sys
 from typing import List, Optional, Tuple, Union, Dict
 import torch
@@ -536,6 +537,12 @@ if intel_extension_for_pytorch._C._has_xpu():
     serialization.register_package(30, _xpu_tag, _xpu_deserialize)
     torch._register_device_module("xpu", current_module)
     intel_extension_for_pytorch._C._postInitExtension()
+    if os.getenv("IPEX_XPU_EAGER_INIT", "0") == "1":
+        # Opt-in: start device bring-up on a background thread now so it
+        # overlaps with checkpoint loading; _lazy_init() joins it on first use.
+        from .lazy_init import _async_init
+
+        _async_init()
     if is_available():
         override_get_stream()
         override_recursive_to()
@@ -13,6 +13,8 @@ _tls = threading.local()
 _initialization_lock = threading.Lock()
 _queued_calls = []  # invoke these after initialization occurs
 _is_in_bad_fork = getattr(_C, "_xpu_isInBadFork", lambda: False)
+_async_thread = None  # background initializer started by _async_init()
+_async_error = None  # exception raised on that thread, replayed on first use
 
 
 class _LazySeedTracker:
@@ -48,10 +50,55 @@ class DeferredXPUCallError(Exception):
     pass
 
 
+def _async_init():
+    r"""Start XPU initialization on a background thread. Device enumeration and
+    context creation take seconds on multi-tile parts; kicking them off at
+    import time hides the bring-up behind checkpoint loading. The first real
+    XPU use goes through _lazy_init(), which joins the background thread, so
+    user-visible semantics (including initialization errors) are unchanged
+    apart from where the wait happens. Opt-in via IPEX_XPU_EAGER_INIT=1.
+    """
+    global _async_thread
+    if is_initialized() or _async_thread is not None:
+        return
+    if not hasattr(_C, "_getDeviceCount"):
+        # no XPU support compiled in; keep the descriptive error on first use
+        return
+
+    def _worker():
+        global _async_error
+        try:
+            _lazy_init()
+        except Exception as e:
+            _async_error = e
+
+    _async_thread = threading.Thread(
+        target=_worker, name="ipex_xpu_async_init", daemon=True
+    )
+    _async_thread.start()
+
+
+def _join_async_init():
+    global _async_thread, _async_error
+    thread = _async_thread
+    if thread is None or thread is threading.current_thread():
+        return
+    thread.join()
+    _async_thread = None
+    if _async_error is not None:
+        error, _async_error = _async_error, None
+        # _initialized is still False, so a retry falls back to the normal
+        # synchronous path and reproduces the failure in the caller's context.
+        raise error
+
+
 def _lazy_init():
     global _initialized, _queued_calls
     if is_initialized() or hasattr(_tls, "is_initializing"):
         return
+    _join_async_init()
+    if is_initialized():
+        return
     with _initialization_lock:
         # This test was was protected via GIL. Double-check whether XPU has
         # already been initialized. If a thread acquired the lock first,
@@ -0,0 +1,344 @@
+// Second-token latency benchmark for the attention kernel family:
+// FlashAttention (first token / prefill), MaskedMultiHeadAttention (decode)
+// and PagedAttention (decode). Sweeps batch, heads, head_size and context
+// length, reports tokens/s and bytes/token, and can diff against a CSV
+// produced by a previous build to catch regressions.
+//
+// Usage:
+//   ipex_attention_bench [--kernel flash|mha|paged|all] [--dtype float|bfloat16]
+//                        [--iters N] [--warmup N] [--csv out.csv]
+//                        [--baseline old.csv]
+//
+// The CSV key is kernel,batch,heads,head_size,context so two builds can be
+// compared with --baseline even if the sweep lists change between them.
+
+#include <torch/torch.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "csrc/cpu/aten/FlashAttention.h"
+#include "csrc/cpu/aten/MaskedMultiHeadAttention.h"
+#include "csrc/cpu/aten/PagedAttention.h"
+
+namespace {
+
+struct BenchConfig {
+  std::string kernel;
+  int64_t batch;
+  int64_t heads;
+  int64_t head_size;
+  int64_t context;
+};
+
+struct BenchResult {
+  double latency_ms;
+  double tokens_per_s;
+  double bytes_per_token;
+};
+
+std::string config_key(const BenchConfig& cfg) {
+  std::ostringstream oss;
+  oss << cfg.kernel << "," << cfg.batch << "," << cfg.heads << ","
+      << cfg.head_size << "," << cfg.context;
+  return oss.str();
+}
+
+double time_ms(const std::function<void()>& fn, int warmup, int iters) {
+  for (auto i = 0; i < warmup; i++) {
+    fn();
+  }
+  auto start = std::chrono::steady_clock::now();
+  for (auto i = 0; i < iters; i++) {
+    fn();
+  }
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count() /
+      iters;
+}
+
+// Prefill over the full prompt; tokens/s counts every prompt token.
+BenchResult bench_flash(
+    const BenchConfig& cfg,
+    at::ScalarType dtype,
+    int warmup,
+    int iters) {
+  auto options = at::TensorOptions().dtype(dtype);
+  auto query =
+      at::rand({cfg.batch, cfg.heads, cfg.context, cfg.head_size}, options);
+  auto key =
+      at::rand({cfg.batch, cfg.heads, cfg.context, cfg.head_size}, options);
+  auto value =
+      at::rand({cfg.batch, cfg.heads, cfg.context, cfg.head_size}, options);
+  auto ms = time_ms(
+      [&]() {
+        torch_ipex::cpu::flash_attention_kernel_stub(
+            at::kCPU,
+            query,
+            key,
+            value,
+            /* dropout */ 0.0,
+            /* is_causal */ true,
+            c10::nullopt,
+            c10::nullopt);
+      },
+      warmup,
+      iters);
+  auto tokens = static_cast<double>(cfg.batch * cfg.context);
+  // Q, K, V read + output written once per prompt token.
+  auto bytes_per_token =
+      static_cast<double>(4 * cfg.heads * cfg.head_size * query.element_size());
+  return {ms, tokens / (ms / 1e3), bytes_per_token};
+}
+
+// One decode step at offset context - 1; the KV cache is populated by a
+// first-token call, mirroring the generation flow.
+BenchResult bench_mha(
+    const BenchConfig& cfg,
+    at::ScalarType dtype,
+    int warmup,
+    int iters) {
+  auto options = at::TensorOptions().dtype(dtype);
+  auto prompt_len = cfg.context - 1;
+  auto max_positions = cfg.context + 1;
+  auto scale_attn = std::sqrt(static_cast<double>(cfg.head_size));
+
+  auto first_query =
+      at::rand({cfg.batch, prompt_len, cfg.heads, cfg.head_size}, options);
+  auto first_key =
+      at::rand({cfg.batch, prompt_len, cfg.heads, cfg.head_size}, options);
+  auto first_value =
+      at::rand({cfg.batch, prompt_len, cfg.heads, cfg.head_size}, options);
+  auto key_cache = at::empty({1, 1, 1, 1}, options);
+  auto value_cache = at::empty({1, 1, 1, 1}, options);
+  auto beam_idx = at::zeros({max_positions, cfg.batch}, at::kLong);
+  auto first_mask = at::zeros({cfg.batch, 1, prompt_len, prompt_len}, options);
+  auto first_out = torch_ipex::cpu::masked_multihead_self_attention_kernel_stub(
+      at::kCPU,
+      first_query,
+      first_key,
+      first_value,
+      key_cache,
+      value_cache,
+      beam_idx,
+      at::tensor({0L}, at::kLong),
+      scale_attn,
+      max_positions,
+      c10::nullopt,
+      first_mask,
+      true);
+  key_cache = std::get<2>(first_out);
+  value_cache = std::get<3>(first_out);
+  beam_idx = std::get<4>(first_out);
+
+  auto query = at::rand({cfg.batch, 1, cfg.heads, cfg.head_size}, options);
+  auto key = at::rand({cfg.batch, 1, cfg.heads, cfg.head_size}, options);
+  auto value = at::rand({cfg.batch, 1, cfg.heads, cfg.head_size}, options);
+  auto seq_info = at::tensor({prompt_len}, at::kLong);
+  auto mask = at::zeros({cfg.batch, 1, 1, cfg.context}, options);
+  auto ms = time_ms(
+      [&]() {
+        torch_ipex::cpu::masked_multihead_self_attention_kernel_stub(
+            at::kCPU,
+            query,
+            key,
+            value,
+            key_cache,
+            value_cache,
+            beam_idx,
+            seq_info,
+            scale_attn,
+            max_positions,
+            c10::nullopt,
+            mask,
+            true);
+      },
+      warmup,
+      iters);
+  auto tokens = static_cast<double>(cfg.batch);
+  // The decode step streams the whole K and V cache for every new token.
+  auto bytes_per_token = static_cast<double>(
+      2 * cfg.context * cfg.heads * cfg.head_size * query.element_size());
+  return {ms, tokens / (ms / 1e3), bytes_per_token};
+}
+
+// One decode step over a block-paged KV cache with dense context.
+BenchResult bench_paged(
+    const BenchConfig& cfg,
+    at::ScalarType dtype,
+    int warmup,
+    int iters) {
+  auto options = at::TensorOptions().dtype(dtype);
+  constexpr int64_t block_size = 16;
+  auto blocks_per_seq = (cfg.context + block_size - 1) / block_size;
+  auto num_blocks = cfg.batch * blocks_per_seq;
+  auto query = at::rand({cfg.batch, cfg.heads, cfg.head_size}, options);
+  auto out = at::empty_like(query);
+  auto key_cache =
+      at::rand({num_blocks, block_size, cfg.heads, cfg.head_size}, options);
+  auto value_cache =
+      at::rand({num_blocks, block_size, cfg.heads, cfg.head_size}, options);
+  auto head_mapping =
+      at::arange(cfg.heads, at::TensorOptions().dtype(at::kInt));
+  auto block_tables = at::arange(
+                          num_blocks, at::TensorOptions().dtype(at::kInt))
+                          .reshape({cfg.batch, blocks_per_seq})
+                          .contiguous();
+  auto context_lens = at::full(
+      {cfg.batch},
+      static_cast<int>(cfg.context),
+      at::TensorOptions().dtype(at::kInt));
+  auto scale = 1.0 / std::sqrt(static_cast<double>(cfg.head_size));
+  auto ms = time_ms(
+      [&]() {
+        torch_ipex::cpu::single_query_cached_kv_attention_kernel_stub(
+            at::kCPU,
+            out,
+            query,
+            key_cache,
+            value_cache,
+            head_mapping,
+            scale,
+            block_tables,
+            context_lens,
+            block_size,
+            cfg.context,
+            c10::nullopt);
+      },
+      warmup,
+      iters);
+  auto tokens = static_cast<double>(cfg.batch);
+  auto bytes_per_token = static_cast<double>(
+      2 * cfg.context * cfg.heads * cfg.head_size * query.element_size());
+  return {ms, tokens / (ms / 1e3), bytes_per_token};
+}
+
+std::map<std::string, double> load_baseline(const std::string& path) {
+  std::map<std::string, double> baseline;
+  std::ifstream file(path);
+  if (!file) {
+    std::cerr << "Warning: cannot open baseline file " << path << std::endl;
+    return baseline;
+  }
+  std::string line;
+  while (std::getline(file, line)) {
+    // kernel,batch,heads,head_size,context,latency_ms,tokens_per_s,...
+    auto pos = line.rfind(',');
+    pos = line.rfind(',', pos - 1);
+    pos = line.rfind(',', pos - 1);
+    auto key = line.substr(0, pos);
+    auto fields = line.substr(pos + 1);
+    std::istringstream iss(fields);
+    double latency_ms;
+    char comma;
+    if (iss >> latency_ms >> comma) {
+      baseline[key] = latency_ms;
+    }
+  }
+  return baseline;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  std::string kernel_filter = "all";
+  std::string dtype_name = "float";
+  std::string csv_path;
+  std::string baseline_path;
+  int iters = 20;
+  int warmup = 5;
+  for (auto i = 1; i < argc; i++) {
+    auto next = [&](const char* flag) -> std::string {
+      if (i + 1 >= argc) {
+        std::cerr << flag << " requires an argument" << std::endl;
+        std::exit(1);
+      }
+      return argv[++i];
+    };
+    if (std::strcmp(argv[i], "--kernel") == 0) {
+      kernel_filter = next("--kernel");
+    } else if (std::strcmp(argv[i], "--dtype") == 0) {
+      dtype_name = next("--dtype");
+    } else if (std::strcmp(argv[i], "--iters") == 0) {
+      iters = std::stoi(next("--iters"));
+    } else if (std::strcmp(argv[i], "--warmup") == 0) {
+      warmup = std::stoi(next("--warmup"));
+    } else if (std::strcmp(argv[i], "--csv") == 0) {
+      csv_path = next("--csv");
+    } else if (std::strcmp(argv[i], "--baseline") == 0) {
+      baseline_path = next("--baseline");
+    } else {
+      std::cerr << "Unknown option: " << argv[i] << std::endl;
+      return 1;
+    }
+  }
+  auto dtype = at::kFloat;
+  if (dtype_name == "bfloat16") {
+    dtype = at::kBFloat16;
+  } else if (dtype_name != "float") {
+    std::cerr << "Unsupported dtype: " << dtype_name << std::endl;
+    return 1;
+  }
+
+  const std::vector<int64_t> batches{1, 4, 16};
+  const std::vector<int64_t> head_nums{16, 32};
+  const std::vector<int64_t> head_sizes{64, 128};
+  const std::vector<int64_t> contexts{128, 512, 2048};
+  const std::vector<std::string> kernels{"flash", "mha", "paged"};
+
+  auto baseline = baseline_path.empty()
+      ? std::map<std::string, double>()
+      : load_baseline(baseline_path);
+  std::ofstream csv;
+  if (!csv_path.empty()) {
+    csv.open(csv_path);
+  }
+
+  std::cout << "kernel,batch,heads,head_size,context,latency_ms,tokens_per_s,"
+               "bytes_per_token"
+            << (baseline.empty() ? "" : ",vs_baseline") << std::endl;
+  for (const auto& kernel : kernels) {
+    if (kernel_filter != "all" && kernel_filter != kernel) {
+      continue;
+    }
+    for (auto batch : batches) {
+      for (auto heads : head_nums) {
+        for (auto head_size : head_sizes) {
+          for (auto context : contexts) {
+            BenchConfig cfg{kernel, batch, heads, head_size, context};
+            BenchResult result;
+            if (kernel == "flash") {
+              result = bench_flash(cfg, dtype, warmup, iters);
+            } else if (kernel == "mha") {
+              result = bench_mha(cfg, dtype, warmup, iters);
+            } else {
+              result = bench_paged(cfg, dtype, warmup, iters);
+            }
+            std::ostringstream row;
+            row << config_key(cfg) << "," << result.latency_ms << ","
+                << result.tokens_per_s << "," << result.bytes_per_token;
+            std::cout << row.str();
+            auto it = baseline.find(config_key(cfg));
+            if (it != baseline.end() && result.latency_ms > 0) {
+              auto speedup = it->second / result.latency_ms;
+              std::cout << "," << speedup << "x";
+            }
+            std::cout << std::endl;
+            if (csv.is_open()) {
+              csv << row.str() << std::endl;
+            }
+          }
+        }
+      }
+    }
+  }
+  return 0;
+}
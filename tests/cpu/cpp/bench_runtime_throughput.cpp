@@ -0,0 +1,289 @@
+// Load-generating benchmark for the runtime task path: drives one
+// TaskExecutor per core partition with a configurable request size
+// distribution and reports throughput, p50/p99 latency and queue depth
+// over time. TaskModule is a thin pybind wrapper over the same executor,
+// so this measures the C++ runtime behavior the Python-level tests hide.
+//
+// Usage:
+//   ipex_runtime_bench [--partition 0-3] [--partition 4-7] ...
+//                      [--dist fixed|uniform|bimodal] [--rows N] [--cols N]
+//                      [--requests N] [--qps N] [--csv out.csv]
+//                      [--baseline old.csv]
+//
+// Each --partition spawns its own TaskExecutor pinned to those cores;
+// requests are spread round-robin across partitions. --qps 0 (default)
+// runs closed-loop, submitting as fast as the executors absorb work;
+// a positive --qps paces submissions open-loop so queueing delay under a
+// fixed arrival rate becomes visible. The CSV key is
+// dist,rows,cols,partitions,qps so two builds can be diffed with
+// --baseline.
+
+#include <torch/torch.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "csrc/cpu/runtime/CPUPool.h"
+#include "csrc/cpu/runtime/TaskExecutor.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::vector<int32_t> parse_partition(const std::string& spec) {
+  // "0-3" or "0,2,4"
+  std::vector<int32_t> cores;
+  std::istringstream iss(spec);
+  std::string piece;
+  while (std::getline(iss, piece, ',')) {
+    auto dash = piece.find('-');
+    if (dash == std::string::npos) {
+      cores.push_back(std::stoi(piece));
+    } else {
+      auto lo = std::stoi(piece.substr(0, dash));
+      auto hi = std::stoi(piece.substr(dash + 1));
+      for (auto c = lo; c <= hi; c++) {
+        cores.push_back(c);
+      }
+    }
+  }
+  return cores;
+}
+
+// Request sizes (softmax rows) drawn per request. "bimodal" models the
+// serving mix that motivates the executor's stealing path: mostly small
+// requests with an occasional large one that would otherwise head-of-line
+// block a single queue.
+int64_t draw_rows(const std::string& dist, int64_t rows, std::mt19937& rng) {
+  if (dist == "uniform") {
+    std::uniform_int_distribution<int64_t> d(1, rows);
+    return d(rng);
+  }
+  if (dist == "bimodal") {
+    std::uniform_real_distribution<double> d(0.0, 1.0);
+    return d(rng) < 0.9 ? std::max<int64_t>(1, rows / 8) : rows;
+  }
+  return rows; // fixed
+}
+
+double percentile(std::vector<double>& sorted_values, double p) {
+  if (sorted_values.empty()) {
+    return 0;
+  }
+  auto idx = static_cast<size_t>(p * (sorted_values.size() - 1));
+  return sorted_values[idx];
+}
+
+std::map<std::string, double> load_baseline(const std::string& path) {
+  std::map<std::string, double> baseline;
+  std::ifstream file(path);
+  if (!file) {
+    std::cerr << "Warning: cannot open baseline file " << path << std::endl;
+    return baseline;
+  }
+  // dist,rows,cols,partitions,qps,throughput,p50_ms,p99_ms,...
+  std::string line;
+  while (std::getline(file, line)) {
+    std::vector<std::string> fields;
+    std::istringstream iss(line);
+    std::string field;
+    while (std::getline(iss, field, ',')) {
+      fields.push_back(field);
+    }
+    if (fields.size() >= 6) {
+      auto key = fields[0] + "," + fields[1] + "," + fields[2] + "," +
+          fields[3] + "," + fields[4];
+      try {
+        baseline[key] = std::stod(fields[5]);
+      } catch (const std::exception&) {
+      }
+    }
+  }
+  return baseline;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  std::vector<std::string> partition_specs;
+  std::string dist = "fixed";
+  int64_t rows = 64;
+  int64_t cols = 1024;
+  int64_t requests = 2000;
+  int64_t qps = 0;
+  std::string csv_path;
+  std::string baseline_path;
+  for (auto i = 1; i < argc; i++) {
+    auto next = [&](const char* flag) -> std::string {
+      if (i + 1 >= argc) {
+        std::cerr << flag << " requires an argument" << std::endl;
+        std::exit(1);
+      }
+      return argv[++i];
+    };
+    if (std::strcmp(argv[i], "--partition") == 0) {
+      partition_specs.push_back(next("--partition"));
+    } else if (std::strcmp(argv[i], "--dist") == 0) {
+      dist = next("--dist");
+    } else if (std::strcmp(argv[i], "--rows") == 0) {
+      rows = std::stoll(next("--rows"));
+    } else if (std::strcmp(argv[i], "--cols") == 0) {
+      cols = std::stoll(next("--cols"));
+    } else if (std::strcmp(argv[i], "--requests") == 0) {
+      requests = std::stoll(next("--requests"));
+    } else if (std::strcmp(argv[i], "--qps") == 0) {
+      qps = std::stoll(next("--qps"));
+    } else if (std::strcmp(argv[i], "--csv") == 0) {
+      csv_path = next("--csv");
+    } else if (std::strcmp(argv[i], "--baseline") == 0) {
+      baseline_path = next("--baseline");
+    } else {
+      std::cerr << "Unknown option: " << argv[i] << std::endl;
+      return 1;
+    }
+  }
+  if (dist != "fixed" && dist != "uniform" && dist != "bimodal") {
+    std::cerr << "Unsupported distribution: " << dist << std::endl;
+    return 1;
+  }
+  if (!torch_ipex::runtime::is_runtime_ext_enabled()) {
+    std::cerr << "The runtime extension requires IOMP to be preloaded; "
+                 "run with LD_PRELOAD=.../libiomp5.so"
+              << std::endl;
+    return 1;
+  }
+  if (partition_specs.empty()) {
+    partition_specs.push_back("0");
+  }
+
+  std::vector<std::shared_ptr<torch_ipex::runtime::TaskExecutor>> executors;
+  for (const auto& spec : partition_specs) {
+    torch_ipex::runtime::CPUPool cpu_pool(parse_partition(spec));
+    executors.push_back(
+        std::make_shared<torch_ipex::runtime::TaskExecutor>(cpu_pool));
+  }
+
+  // Pre-draw the request sizes and pre-build the inputs so the submit
+  // loop measures the runtime, not the allocator.
+  std::mt19937 rng(42);
+  std::vector<at::Tensor> inputs;
+  inputs.reserve(requests);
+  for (int64_t i = 0; i < requests; i++) {
+    inputs.push_back(at::rand({draw_rows(dist, rows, rng), cols}));
+  }
+
+  std::vector<Clock::time_point> submit_ts(requests);
+  std::vector<Clock::time_point> done_ts(requests);
+  std::atomic<int64_t> submitted{0};
+  std::atomic<int64_t> completed{0};
+
+  // Queue-depth sampler: in-flight requests every 10 ms until the run
+  // drains. Reported as a timeline so capacity planning can see queue
+  // growth under a fixed arrival rate, not just the final summary.
+  std::atomic<bool> sampling{true};
+  std::vector<std::pair<double, int64_t>> depth_timeline;
+  auto bench_start = Clock::now();
+  std::thread sampler([&]() {
+    while (sampling.load(std::memory_order_acquire)) {
+      auto now = Clock::now();
+      auto elapsed_ms =
+          std::chrono::duration<double, std::milli>(now - bench_start).count();
+      depth_timeline.emplace_back(
+          elapsed_ms,
+          submitted.load(std::memory_order_acquire) -
+              completed.load(std::memory_order_acquire));
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  });
+
+  auto inter_arrival = qps > 0
+      ? std::chrono::duration<double>(1.0 / static_cast<double>(qps))
+      : std::chrono::duration<double>(0);
+  auto next_submit = Clock::now();
+  for (int64_t i = 0; i < requests; i++) {
+    if (qps > 0) {
+      std::this_thread::sleep_until(next_submit);
+      next_submit += std::chrono::duration_cast<Clock::duration>(inter_arrival);
+    }
+    submit_ts[i] = Clock::now();
+    submitted.fetch_add(1, std::memory_order_release);
+    executors[i % executors.size()]->submit([&, i]() {
+      at::softmax(inputs[i], -1);
+      done_ts[i] = Clock::now();
+      completed.fetch_add(1, std::memory_order_release);
+    });
+  }
+  while (completed.load(std::memory_order_acquire) < requests) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  auto bench_end = Clock::now();
+  sampling.store(false, std::memory_order_release);
+  sampler.join();
+  for (auto& executor : executors) {
+    executor->stop_executor();
+  }
+
+  std::vector<double> latencies_ms(requests);
+  for (int64_t i = 0; i < requests; i++) {
+    latencies_ms[i] =
+        std::chrono::duration<double, std::milli>(done_ts[i] - submit_ts[i])
+            .count();
+  }
+  std::sort(latencies_ms.begin(), latencies_ms.end());
+  auto wall_s =
+      std::chrono::duration<double>(bench_end - bench_start).count();
+  auto throughput = static_cast<double>(requests) / wall_s;
+  auto p50 = percentile(latencies_ms, 0.50);
+  auto p99 = percentile(latencies_ms, 0.99);
+  int64_t max_depth = 0;
+  double depth_sum = 0;
+  for (const auto& sample : depth_timeline) {
+    max_depth = std::max(max_depth, sample.second);
+    depth_sum += static_cast<double>(sample.second);
+  }
+  auto mean_depth = depth_timeline.empty()
+      ? 0.0
+      : depth_sum / static_cast<double>(depth_timeline.size());
+
+  auto baseline = baseline_path.empty()
+      ? std::map<std::string, double>()
+      : load_baseline(baseline_path);
+
+  std::ostringstream key;
+  key << dist << "," << rows << "," << cols << "," << partition_specs.size()
+      << "," << qps;
+  std::ostringstream row;
+  row << key.str() << "," << throughput << "," << p50 << "," << p99 << ","
+      << mean_depth << "," << max_depth;
+
+  std::cout << "dist,rows,cols,partitions,qps,throughput,p50_ms,p99_ms,"
+               "mean_depth,max_depth"
+            << (baseline.empty() ? "" : ",vs_baseline") << std::endl;
+  std::cout << row.str();
+  auto it = baseline.find(key.str());
+  if (it != baseline.end() && it->second > 0) {
+    std::cout << "," << throughput / it->second << "x";
+  }
+  std::cout << std::endl;
+
+  std::cout << std::endl << "queue depth timeline (ms,in_flight)" << std::endl;
+  for (const auto& sample : depth_timeline) {
+    std::cout << sample.first << "," << sample.second << std::endl;
+  }
+
+  if (!csv_path.empty()) {
+    std::ofstream csv(csv_path);
+    csv << row.str() << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,459 @@
+// Self-checking microbenchmark for the SIMD primitive library under
+// csrc/cpu/vec: move_ker, add_ker, zero_ker, prefix_sum and the softmax
+// helper kernels, swept across sizes and dtype combinations. Every
+// primitive is first validated against a scalar reference (a wrong
+// result makes a GB/s number meaningless), then timed and reported as
+// GB/s of logical bytes moved.
+//
+// Usage:
+//   ipex_vec_bench [--primitive move|add|zero|prefix_sum|softmax|all]
+//                  [--iters-scale N] [--json out.json]
+//                  [--baseline old.json] [--threshold 0.85]
+//
+// --json writes one record per line so two runs diff cleanly; --baseline
+// reloads such a file and appends a vs_baseline ratio per record. With a
+// baseline, any record whose ratio falls below --threshold fails the run
+// (exit code 2) so CI can gate on it. The ISA variant is chosen at
+// compile time (see the vec bench target in CMakeLists.txt); run the
+// binary on a machine supporting the ISA it was built for.
+
+#include <c10/util/BFloat16.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "csrc/cpu/vec/vec.h"
+
+namespace {
+
+using torch_ipex::cpu::kernel::add_ker;
+using torch_ipex::cpu::kernel::move_ker;
+using torch_ipex::cpu::kernel::prefix_sum;
+using torch_ipex::cpu::kernel::zero_ker;
+
+struct Record {
+  std::string primitive;
+  int64_t size;
+  double gbps;
+};
+
+template <typename T>
+const char* dtype_name();
+template <>
+const char* dtype_name<float>() {
+  return "float";
+}
+template <>
+const char* dtype_name<at::BFloat16>() {
+  return "bfloat16";
+}
+template <>
+const char* dtype_name<int32_t>() {
+  return "int32";
+}
+template <>
+const char* dtype_name<int64_t>() {
+  return "int64";
+}
+
+// Lossy dtypes (bf16 round-to-nearest-even on store) get a loose bound;
+// everything else must match the scalar reference exactly.
+template <typename T>
+double check_tolerance() {
+  return 0.0;
+}
+template <>
+double check_tolerance<at::BFloat16>() {
+  return 1e-2;
+}
+
+bool almost_equal(double a, double b, double rel_tol) {
+  if (a == b) {
+    return true;
+  }
+  return std::abs(a - b) <= rel_tol * std::max(std::abs(a), std::abs(b));
+}
+
+void check_failed(const std::string& primitive, int64_t i, double got, double want) {
+  std::cerr << "Self-check FAILED for " << primitive << " at element " << i
+            << ": got " << got << ", want " << want << std::endl;
+  std::exit(1);
+}
+
+// Times fn and converts the per-iteration logical traffic to GB/s. The
+// iteration count is scaled so every size moves a comparable volume;
+// small sizes stay cache resident by design and report cache bandwidth.
+double bench_gbps(
+    const std::function<void()>& fn,
+    double bytes_per_iter,
+    int64_t size,
+    int iters_scale) {
+  int iters = static_cast<int>(
+      std::max<int64_t>(16, ((int64_t)1 << 26) / std::max<int64_t>(size, 1)));
+  iters *= iters_scale;
+  for (auto i = 0; i < iters / 4 + 1; i++) {
+    fn();
+  }
+  auto start = std::chrono::steady_clock::now();
+  for (auto i = 0; i < iters; i++) {
+    fn();
+  }
+  auto end = std::chrono::steady_clock::now();
+  auto seconds = std::chrono::duration<double>(end - start).count();
+  return bytes_per_iter * iters / seconds / 1e9;
+}
+
+template <typename dst_t, typename src_t>
+Record bench_move(int64_t n, int iters_scale) {
+  std::ostringstream name;
+  name << "move_ker<" << dtype_name<dst_t>() << "," << dtype_name<src_t>()
+       << ">";
+  std::vector<src_t> src(n);
+  std::vector<dst_t> dst(n);
+  for (int64_t i = 0; i < n; i++) {
+    src[i] = src_t(0.25f * static_cast<float>(i % 251));
+  }
+  move_ker(dst.data(), src.data(), n);
+  auto tol = std::max(check_tolerance<dst_t>(), check_tolerance<src_t>());
+  for (int64_t i = 0; i < n; i++) {
+    auto want = static_cast<double>(static_cast<dst_t>(src[i]));
+    if (!almost_equal(static_cast<double>(dst[i]), want, tol)) {
+      check_failed(name.str(), i, static_cast<double>(dst[i]), want);
+    }
+  }
+  auto bytes = static_cast<double>(n) * (sizeof(dst_t) + sizeof(src_t));
+  auto gbps = bench_gbps(
+      [&]() { move_ker(dst.data(), src.data(), n); }, bytes, n, iters_scale);
+  return {name.str(), n, gbps};
+}
+
+template <typename dst_t, typename src_t>
+Record bench_add(int64_t n, int iters_scale) {
+  std::ostringstream name;
+  name << "add_ker<" << dtype_name<dst_t>() << "," << dtype_name<src_t>()
+       << ">";
+  std::vector<src_t> src(n);
+  std::vector<dst_t> dst(n), ref(n);
+  for (int64_t i = 0; i < n; i++) {
+    src[i] = src_t(0.125f * static_cast<float>(i % 113));
+    dst[i] = dst_t(0.5f * static_cast<float>(i % 97));
+    ref[i] = dst[i];
+  }
+  add_ker(dst.data(), src.data(), n);
+  auto tol = std::max(check_tolerance<dst_t>(), check_tolerance<src_t>());
+  for (int64_t i = 0; i < n; i++) {
+    auto want = static_cast<double>(static_cast<dst_t>(
+        static_cast<float>(ref[i]) + static_cast<float>(src[i])));
+    if (!almost_equal(static_cast<double>(dst[i]), want, tol)) {
+      check_failed(name.str(), i, static_cast<double>(dst[i]), want);
+    }
+  }
+  // inout is read and written, in is read once.
+  auto bytes = static_cast<double>(n) * (2 * sizeof(dst_t) + sizeof(src_t));
+  auto gbps = bench_gbps(
+      [&]() { add_ker(dst.data(), src.data(), n); }, bytes, n, iters_scale);
+  return {name.str(), n, gbps};
+}
+
+template <typename T>
+Record bench_zero(int64_t n, int iters_scale) {
+  std::ostringstream name;
+  name << "zero_ker<" << dtype_name<T>() << ">";
+  std::vector<T> dst(n, T(1.0f));
+  zero_ker(dst.data(), n);
+  for (int64_t i = 0; i < n; i++) {
+    if (static_cast<float>(dst[i]) != 0.0f) {
+      check_failed(name.str(), i, static_cast<double>(dst[i]), 0.0);
+    }
+  }
+  auto bytes = static_cast<double>(n) * sizeof(T);
+  auto gbps = bench_gbps(
+      [&]() { zero_ker(dst.data(), n); }, bytes, n, iters_scale);
+  return {name.str(), n, gbps};
+}
+
+template <typename T>
+Record bench_prefix_sum(int64_t n, int iters_scale) {
+  std::ostringstream name;
+  name << "prefix_sum<" << dtype_name<T>() << ">";
+  std::vector<T> src(n), dst(n);
+  for (int64_t i = 0; i < n; i++) {
+    src[i] = static_cast<T>(i % 5);
+  }
+  prefix_sum(src.data(), dst.data(), T(0), n);
+  T sum = 0;
+  for (int64_t i = 0; i < n; i++) {
+    sum += src[i];
+    if (dst[i] != sum) {
+      check_failed(
+          name.str(),
+          i,
+          static_cast<double>(dst[i]),
+          static_cast<double>(sum));
+    }
+  }
+  auto bytes = static_cast<double>(n) * 2 * sizeof(T);
+  auto gbps = bench_gbps(
+      [&]() { prefix_sum(src.data(), dst.data(), T(0), n); },
+      bytes,
+      n,
+      iters_scale);
+  return {name.str(), n, gbps};
+}
+
+// The softmax helpers keep their data in float scratch buffers; sizes are
+// row lengths, so these are the cache-resident inner loops of the MHA
+// kernels rather than streaming primitives.
+Record bench_softmax_exp_sum(int64_t n, int iters_scale) {
+  std::string name = "_dil_exp_reduce_sum_fusion_kernel";
+  std::vector<float> a(n), out(n);
+  for (int64_t i = 0; i < n; i++) {
+    a[i] = 0.01f * static_cast<float>(i % 100) - 0.5f;
+  }
+  float max = 0.5f;
+  float val = max;
+  torch_ipex::cpu::kernel::_dil_exp_reduce_sum_fusion_kernel(
+      a.data(), static_cast<int>(n), out.data(), val);
+  double ref_sum = 0;
+  for (int64_t i = 0; i < n; i++) {
+    auto want = std::exp(static_cast<double>(a[i]) - max);
+    ref_sum += want;
+    // the vectorized exp is a polynomial approximation
+    if (!almost_equal(static_cast<double>(out[i]), want, 1e-3)) {
+      check_failed(name, i, static_cast<double>(out[i]), want);
+    }
+  }
+  if (!almost_equal(static_cast<double>(val), ref_sum, 1e-3)) {
+    check_failed(name, -1, static_cast<double>(val), ref_sum);
+  }
+  auto bytes = static_cast<double>(n) * 2 * sizeof(float);
+  auto gbps = bench_gbps(
+      [&]() {
+        float v = max;
+        torch_ipex::cpu::kernel::_dil_exp_reduce_sum_fusion_kernel(
+            a.data(), static_cast<int>(n), out.data(), v);
+      },
+      bytes,
+      n,
+      iters_scale);
+  return {name, n, gbps};
+}
+
+Record bench_softmax_add_max(int64_t n, int iters_scale) {
+  std::string name = "_dil_add_reduce_max_fusion_kernel";
+  std::vector<float> a(n), b(n), out(n);
+  for (int64_t i = 0; i < n; i++) {
+    a[i] = 0.25f * static_cast<float>(i % 89);
+    b[i] = -0.125f * static_cast<float>(i % 67);
+  }
+  float max = 0;
+  torch_ipex::cpu::kernel::_dil_add_reduce_max_fusion_kernel(
+      a.data(), b.data(), static_cast<int>(n), out.data(), max);
+  float ref_max = std::numeric_limits<float>::lowest();
+  for (int64_t i = 0; i < n; i++) {
+    auto want = a[i] + b[i];
+    ref_max = std::max(ref_max, want);
+    if (out[i] != want) {
+      check_failed(name, i, static_cast<double>(out[i]), want);
+    }
+  }
+  if (max != ref_max) {
+    check_failed(name, -1, static_cast<double>(max), ref_max);
+  }
+  auto bytes = static_cast<double>(n) * 3 * sizeof(float);
+  auto gbps = bench_gbps(
+      [&]() {
+        float m = 0;
+        torch_ipex::cpu::kernel::_dil_add_reduce_max_fusion_kernel(
+            a.data(), b.data(), static_cast<int>(n), out.data(), m);
+      },
+      bytes,
+      n,
+      iters_scale);
+  return {name, n, gbps};
+}
+
+template <typename T>
+Record bench_softmax_normalize(int64_t n, int iters_scale) {
+  std::ostringstream name;
+  name << "_dil_normalization_kernel<" << dtype_name<T>() << ">";
+  std::vector<float> a(n);
+  std::vector<T> out(n);
+  for (int64_t i = 0; i < n; i++) {
+    a[i] = 1.0f + 0.5f * static_cast<float>(i % 31);
+  }
+  float sum = 42.5f;
+  torch_ipex::cpu::kernel::_dil_normalization_kernel<T>(
+      a.data(), sum, static_cast<int>(n), out.data());
+  auto tol = std::max(check_tolerance<T>(), 1e-6);
+  for (int64_t i = 0; i < n; i++) {
+    auto want = static_cast<double>(T(a[i] / sum));
+    if (!almost_equal(static_cast<double>(out[i]), want, tol)) {
+      check_failed(name.str(), i, static_cast<double>(out[i]), want);
+    }
+  }
+  auto bytes = static_cast<double>(n) * (sizeof(float) + sizeof(T));
+  auto gbps = bench_gbps(
+      [&]() {
+        torch_ipex::cpu::kernel::_dil_normalization_kernel<T>(
+            a.data(), sum, static_cast<int>(n), out.data());
+      },
+      bytes,
+      n,
+      iters_scale);
+  return {name.str(), n, gbps};
+}
+
+std::string record_key(const Record& record) {
+  std::ostringstream oss;
+  oss << record.primitive << "," << record.size;
+  return oss.str();
+}
+
+std::string record_json(const Record& record) {
+  std::ostringstream oss;
+  oss << "{\"primitive\":\"" << record.primitive
+      << "\",\"size\":" << record.size << ",\"gbps\":" << record.gbps << "}";
+  return oss.str();
+}
+
+// Reads a file written by --json: one record object per line. Only the
+// primitive/size/gbps fields are consulted, so hand-edited baselines work
+// as long as the one-record-per-line shape is kept.
+std::map<std::string, double> load_baseline(const std::string& path) {
+  std::map<std::string, double> baseline;
+  std::ifstream file(path);
+  if (!file) {
+    std::cerr << "Warning: cannot open baseline file " << path << std::endl;
+    return baseline;
+  }
+  std::string line;
+  while (std::getline(file, line)) {
+    auto grab = [&](const char* field) -> std::string {
+      auto pos = line.find(field);
+      if (pos == std::string::npos) {
+        return "";
+      }
+      pos += std::strlen(field);
+      auto end = line.find_first_of(",}\"", pos);
+      return line.substr(pos, end - pos);
+    };
+    auto primitive = grab("\"primitive\":\"");
+    auto size = grab("\"size\":");
+    auto gbps = grab("\"gbps\":");
+    if (!primitive.empty() && !size.empty() && !gbps.empty()) {
+      baseline[primitive + "," + size] = std::stod(gbps);
+    }
+  }
+  return baseline;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  std::string primitive_filter = "all";
+  std::string json_path;
+  std::string baseline_path;
+  int iters_scale = 1;
+  double threshold = 0.85;
+  for (auto i = 1; i < argc; i++) {
+    auto next = [&](const char* flag) -> std::string {
+      if (i + 1 >= argc) {
+        std::cerr << flag << " requires an argument" << std::endl;
+        std::exit(1);
+      }
+      return argv[++i];
+    };
+    if (std::strcmp(argv[i], "--primitive") == 0) {
+      primitive_filter = next("--primitive");
+    } else if (std::strcmp(argv[i], "--iters-scale") == 0) {
+      iters_scale = std::stoi(next("--iters-scale"));
+    } else if (std::strcmp(argv[i], "--json") == 0) {
+      json_path = next("--json");
+    } else if (std::strcmp(argv[i], "--baseline") == 0) {
+      baseline_path = next("--baseline");
+    } else if (std::strcmp(argv[i], "--threshold") == 0) {
+      threshold = std::stod(next("--threshold"));
+    } else {
+      std::cerr << "Unknown option: " << argv[i] << std::endl;
+      return 1;
+    }
+  }
+
+  // Streaming primitives span L1 through DRAM; the softmax helpers sweep
+  // typical attention row lengths.
+  const std::vector<int64_t> stream_sizes{1024, 16384, 262144, 4194304};
+  const std::vector<int64_t> row_sizes{128, 512, 2048};
+
+  auto wants = [&](const char* primitive) {
+    return primitive_filter == "all" || primitive_filter == primitive;
+  };
+
+  std::vector<Record> records;
+  for (auto n : stream_sizes) {
+    if (wants("move")) {
+      records.push_back(bench_move<float, float>(n, iters_scale));
+      records.push_back(bench_move<at::BFloat16, float>(n, iters_scale));
+      records.push_back(bench_move<float, at::BFloat16>(n, iters_scale));
+      records.push_back(bench_move<at::BFloat16, at::BFloat16>(n, iters_scale));
+    }
+    if (wants("add")) {
+      records.push_back(bench_add<float, float>(n, iters_scale));
+      records.push_back(bench_add<float, at::BFloat16>(n, iters_scale));
+      records.push_back(bench_add<at::BFloat16, at::BFloat16>(n, iters_scale));
+    }
+    if (wants("zero")) {
+      records.push_back(bench_zero<float>(n, iters_scale));
+      records.push_back(bench_zero<at::BFloat16>(n, iters_scale));
+    }
+    if (wants("prefix_sum")) {
+      records.push_back(bench_prefix_sum<int32_t>(n, iters_scale));
+      records.push_back(bench_prefix_sum<int64_t>(n, iters_scale));
+    }
+  }
+  if (wants("softmax")) {
+    for (auto n : row_sizes) {
+      records.push_back(bench_softmax_exp_sum(n, iters_scale));
+      records.push_back(bench_softmax_add_max(n, iters_scale));
+      records.push_back(bench_softmax_normalize<float>(n, iters_scale));
+      records.push_back(bench_softmax_normalize<at::BFloat16>(n, iters_scale));
+    }
+  }
+
+  auto baseline = baseline_path.empty()
+      ? std::map<std::string, double>()
+      : load_baseline(baseline_path);
+  std::ofstream json;
+  if (!json_path.empty()) {
+    json.open(json_path);
+  }
+
+  bool regression = false;
+  std::cout << "primitive,size,gbps"
+            << (baseline.empty() ? "" : ",vs_baseline") << std::endl;
+  for (const auto& record : records) {
+    std::cout << record.primitive << "," << record.size << "," << record.gbps;
+    auto it = baseline.find(record_key(record));
+    if (it != baseline.end() && it->second > 0) {
+      auto ratio = record.gbps / it->second;
+      std::cout << "," << ratio << "x";
+      if (ratio < threshold) {
+        std::cout << " REGRESSION";
+        regression = true;
+      }
+    }
+    std::cout << std::endl;
+    if (json.is_open()) {
+      json << record_json(record) << std::endl;
+    }
+  }
+  return regression ? 2 : 0;
+}
@@ -0,0 +1,72 @@
+#include <torch/torch.h>
+#include "csrc/cpu/utils/io_tensor.h"
+#include "gtest/gtest.h"
+
+TEST(TestIOTensor, TestWrapBufferAliasesCallerMemory) {
+  alignas(64) float buffer[16];
+  for (auto i = 0; i < 16; i++) {
+    buffer[i] = static_cast<float>(i);
+  }
+  auto tensor = torch_ipex::utils::wrap_buffer(buffer, {4, 4}, at::kFloat);
+  ASSERT_EQ(tensor.data_ptr<float>(), buffer);
+  ASSERT_FLOAT_EQ(tensor[1][2].item<float>(), 6.0f);
+  // Writes through the tensor land in the caller's buffer: zero copy.
+  tensor.add_(1.0f);
+  ASSERT_FLOAT_EQ(buffer[0], 1.0f);
+  ASSERT_FLOAT_EQ(buffer[15], 16.0f);
+}
+
+TEST(TestIOTensor, TestWrapBufferRejectsMisaligned) {
+  alignas(64) char buffer[128];
+  ASSERT_THROW(
+      torch_ipex::utils::wrap_buffer(buffer + 4, {4}, at::kFloat),
+      c10::Error);
+  ASSERT_THROW(
+      torch_ipex::utils::wrap_buffer(nullptr, {4}, at::kFloat), c10::Error);
+}
+
+TEST(TestIOTensor, TestWrapBufferDeleter) {
+  alignas(64) static float buffer[8];
+  bool deleted = false;
+  {
+    auto tensor = torch_ipex::utils::wrap_buffer(
+        buffer, {8}, at::kFloat, [&deleted](void*) { deleted = true; });
+    ASSERT_FALSE(deleted);
+  }
+  ASSERT_TRUE(deleted);
+}
+
+TEST(TestIOTensor, TestOutputArenaEmit) {
+  alignas(64) char buffer[4096];
+  torch_ipex::utils::OutputArena arena(buffer, sizeof(buffer));
+  auto src = torch::rand({4, 8});
+  // Emit a non-contiguous view to exercise the layout-normalizing copy.
+  auto transposed = src.t();
+  auto out = arena.emit(transposed);
+  ASSERT_TRUE(out.is_contiguous());
+  ASSERT_TRUE(torch::equal(out, transposed.contiguous()));
+  ASSERT_GE(out.data_ptr<char>(), buffer);
+  ASSERT_LT(out.data_ptr<char>(), buffer + sizeof(buffer));
+  ASSERT_EQ(arena.used(), 4 * 8 * sizeof(float));
+
+  // Successive allocations start on distinct cache lines.
+  auto second = arena.emit(src);
+  ASSERT_EQ(
+      reinterpret_cast<uintptr_t>(second.data_ptr()) % 64,
+      static_cast<uintptr_t>(0));
+
+  arena.reset();
+  ASSERT_EQ(arena.used(), static_cast<size_t>(0));
+  auto third = arena.allocate({2, 2}, at::kFloat);
+  ASSERT_EQ(third.data_ptr(), static_cast<void*>(buffer));
+}
+
+TEST(TestIOTensor, TestOutputArenaOutOfSpace) {
+  alignas(64) char buffer[256];
+  torch_ipex::utils::OutputArena arena(buffer, sizeof(buffer));
+  ASSERT_THROW(arena.allocate({1024}, at::kFloat), c10::Error);
+  // A failed allocation must not consume arena space.
+  ASSERT_EQ(arena.used(), static_cast<size_t>(0));
+  auto ok = arena.allocate({64}, at::kFloat);
+  ASSERT_EQ(ok.numel(), 64);
+}
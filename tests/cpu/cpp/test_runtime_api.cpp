@@ -1,7 +1,13 @@
 #include <torch/torch.h>
+#include <chrono>
+#include <thread>
 #include "csrc/cpu/runtime/CPUPool.h"
+#include "csrc/cpu/runtime/DecodeSlabAllocator.h"
+#include "csrc/cpu/runtime/ShardReducer.h"
 #include "csrc/cpu/runtime/Task.h"
 #include "csrc/cpu/runtime/TaskExecutor.h"
+#include "csrc/cpu/runtime/KVCacheTier.h"
+#include "csrc/cpu/runtime/WeightPrefetcher.h"
 #include "gtest/gtest.h"
 
 #define ASSERT_VARIABLE_EQ(a, b) ASSERT_TRUE(torch::allclose((a), (b)))
@@ -47,6 +53,147 @@ TEST(TestRuntimeAPI, TestMainThreadCoreBindWithCPUPool) {
   auto res_ = at::softmax(input_tensor, -1);
 }
 
+TEST(TestRuntimeAPI, TestAffinityWatchdogLifecycle) {
+  // The watchdog itself has no IOMP dependency: start it, let it sweep at
+  // least once, check the counters move and that stop is idempotent.
+  auto before = torch_ipex::runtime::get_affinity_watchdog_stats();
+  torch_ipex::runtime::start_affinity_watchdog(/* interval_ms */ 10);
+  // A second start while running is a no-op.
+  torch_ipex::runtime::start_affinity_watchdog(10);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  torch_ipex::runtime::stop_affinity_watchdog();
+  auto after = torch_ipex::runtime::get_affinity_watchdog_stats();
+  EXPECT_GT(after.checks, before.checks);
+  // Nothing pinned by this test, so no drift should be reported on an
+  // empty record set.
+  EXPECT_EQ(after.drift_events, before.drift_events);
+  torch_ipex::runtime::stop_affinity_watchdog();
+}
+
+TEST(TestRuntimeAPI, TestAffinityWatchdogRepairsPinnedCores) {
+  if (!torch_ipex::runtime::is_runtime_ext_enabled()) {
+    GTEST_SKIP()
+        << "Skip TestRuntimeAPI::TestAffinityWatchdogRepairsPinnedCores. Didn't preload IOMP.";
+  }
+  torch_ipex::runtime::CPUPool previous_cpu_pool =
+      torch_ipex::runtime::get_cpu_pool_from_mask_affinity();
+  std::vector<int32_t> cpu_core_list({0});
+  torch_ipex::runtime::CPUPool cpu_pool(cpu_core_list);
+  torch_ipex::runtime::_pin_cpu_cores(cpu_pool);
+  auto stats = torch_ipex::runtime::get_affinity_watchdog_stats();
+  // The pin above must have registered the team with the watchdog.
+  EXPECT_GE(stats.watched_threads, cpu_core_list.size());
+  torch_ipex::runtime::set_mask_affinity_from_cpu_pool(previous_cpu_pool);
+}
+
+TEST(TestRuntimeAPI, TestCPUPoolSiblingViews) {
+  // The sibling views need no IOMP. The physical and sibling views must
+  // partition the pool's core list, and the placement policies must stay
+  // consistent with the views of a uniform pool over the same cores.
+  std::vector<int32_t> cores =
+      torch_ipex::runtime::get_process_available_cores();
+  torch_ipex::runtime::CPUPool pool(cores);
+  const auto& physical = pool.get_physical_core_list();
+  const auto& siblings = pool.get_smt_sibling_list();
+  EXPECT_EQ(
+      physical.size() + siblings.size(), pool.get_cpu_core_list().size());
+  for (auto core : siblings) {
+    EXPECT_EQ(
+        std::find(physical.begin(), physical.end(), core), physical.end());
+  }
+  torch_ipex::runtime::CPUPool physical_pool(
+      cores, torch_ipex::runtime::SiblingPolicy::kPhysicalCoreOnly);
+  EXPECT_EQ(physical_pool.get_cpu_core_list(), physical);
+  EXPECT_TRUE(physical_pool.get_smt_sibling_list().empty());
+  torch_ipex::runtime::CPUPool paired_pool(
+      cores, torch_ipex::runtime::SiblingPolicy::kSMTPaired);
+  EXPECT_GE(paired_pool.get_cpu_core_list().size(), physical.size());
+}
+
+TEST(TestRuntimeAPI, TestDecodeSlabAllocator) {
+  // The slab has no IOMP dependency: run two simulated decode steps on a
+  // plain thread and check that the second step recycles the first step's
+  // blocks instead of growing the reservation.
+  std::thread worker([]() {
+    torch_ipex::runtime::DecodeSlabScope slab_scope(/* active */ true);
+    for (int step = 0; step < 2; step++) {
+      std::vector<at::Tensor> tensors;
+      for (int i = 0; i < 8; i++) {
+        tensors.push_back(at::rand({32, 32}));
+      }
+    }
+  });
+  worker.join();
+  auto stats = torch_ipex::runtime::get_decode_slab_stats();
+  // The second step's allocations must have been served from blocks the
+  // first step returned to the free lists.
+  EXPECT_GT(stats.slab_hits, 0);
+  EXPECT_GT(stats.slab_misses, 0);
+  // Everything allocated inside the scope above has been freed again.
+  EXPECT_EQ(stats.outstanding_blocks, 0);
+}
+
+TEST(TestRuntimeAPI, TestShardReducerSum) {
+  // The reducer has no IOMP dependency; drive it with plain threads for
+  // every shard count that exercises padding (1, 3, 8).
+  for (size_t num_shards : {1, 3, 8}) {
+    torch_ipex::runtime::ShardReducer reducer(
+        num_shards, torch_ipex::runtime::ShardReducer::ReduceOp::kSum);
+    std::vector<at::Tensor> shards;
+    at::Tensor expected = at::zeros({16, 16});
+    for (size_t i = 0; i < num_shards; i++) {
+      shards.push_back(at::rand({16, 16}));
+      expected += shards.back();
+    }
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < num_shards; i++) {
+      workers.emplace_back(
+          [&reducer, &shards, i]() { reducer.submit(i, shards[i]); });
+    }
+    auto result = reducer.wait_and_get();
+    for (auto& worker : workers) {
+      worker.join();
+    }
+    ASSERT_VARIABLE_EQ(result, expected);
+  }
+}
+
+TEST(TestRuntimeAPI, TestShardReducerConcat) {
+  const size_t num_shards = 4;
+  torch_ipex::runtime::ShardReducer reducer(
+      num_shards,
+      torch_ipex::runtime::ShardReducer::ReduceOp::kConcat,
+      /* cat_dim */ 0);
+  std::vector<at::Tensor> shards;
+  for (size_t i = 0; i < num_shards; i++) {
+    // uneven batch shards, like an uneven MultiStreamModule split
+    shards.push_back(at::rand({(int64_t)(i + 1), 8}));
+  }
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < num_shards; i++) {
+    workers.emplace_back(
+        [&reducer, &shards, i]() { reducer.submit(i, shards[i]); });
+  }
+  auto result = reducer.wait_and_get();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  ASSERT_VARIABLE_EQ(result, at::cat(shards, 0));
+
+  // reset and run a second iteration with the same reducer
+  reducer.reset();
+  std::vector<std::thread> workers2;
+  for (size_t i = 0; i < num_shards; i++) {
+    workers2.emplace_back(
+        [&reducer, &shards, i]() { reducer.submit(i, shards[i]); });
+  }
+  auto result2 = reducer.wait_and_get();
+  for (auto& worker : workers2) {
+    worker.join();
+  }
+  ASSERT_VARIABLE_EQ(result2, at::cat(shards, 0));
+}
+
 TEST(TestRuntimeTaskAPI, TestTaskAPINativeTorchOperation) {
   if (!torch_ipex::runtime::is_runtime_ext_enabled()) {
     GTEST_SKIP()
@@ -430,3 +577,78 @@ TEST(TestRuntimeTaskAPI, TestTaskAPISameTasksMultiTensorInputs) {
   ASSERT_VARIABLE_EQ(res, res_ref);
   ASSERT_VARIABLE_EQ(res2, res_ref2);
 }
+
+TEST(TestWeightPrefetcher, TestLayerWalkAndCounters) {
+  // The prefetcher has no IOMP dependency: it only needs CPU tensors.
+  torch_ipex::runtime::WeightPrefetcher prefetcher;
+  at::Tensor w0 = at::rand({256, 256});
+  at::Tensor w1 = at::rand({256, 512});
+  at::Tensor w2 = at::rand({512, 256});
+  prefetcher.register_layer({w0});
+  prefetcher.register_layer({w1, w2});
+  ASSERT_EQ(prefetcher.num_layers(), 2);
+
+  // advance(0) warms layer 1; advance(1) wraps back to layer 0.
+  prefetcher.advance(0);
+  uint64_t expected = w1.nbytes() + w2.nbytes();
+  for (int i = 0; i < 200 && prefetcher.prefetched_bytes() < expected; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  ASSERT_EQ(prefetcher.prefetched_bytes(), expected);
+
+  prefetcher.advance(1);
+  expected += w0.nbytes();
+  for (int i = 0; i < 200 && prefetcher.prefetched_bytes() < expected; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  ASSERT_EQ(prefetcher.prefetched_bytes(), expected);
+
+  prefetcher.clear_layers();
+  ASSERT_EQ(prefetcher.num_layers(), 0);
+  ASSERT_EQ(prefetcher.prefetched_bytes(), 0);
+  // advance on an empty walk is a no-op, not an error.
+  prefetcher.advance(0);
+}
+
+TEST(TestKVCacheTier, TestSpillAndFetchRoundTrip) {
+  // The tiering manager has no IOMP dependency: it only needs CPU
+  // tensors and a writable temp dir for the tier file.
+  torch_ipex::runtime::KVCacheTierManager manager;
+  at::Tensor key_cache = at::rand({4, 2, 16});
+  at::Tensor value_cache = at::rand({4, 2, 16});
+  at::Tensor key_orig = key_cache.clone();
+  at::Tensor value_orig = value_cache.clone();
+  manager.register_cache({key_cache, value_cache});
+  ASSERT_EQ(manager.num_blocks(), 4);
+
+  // blocks 0 and 1 are hot, 2 and 3 went cold
+  manager.touch({0, 1}, 10);
+  manager.touch({2, 3}, 1);
+  manager.spill_older_than(5);
+  manager.wait();
+  ASSERT_EQ(manager.spilled_blocks(), 2);
+  uint64_t block_bytes = key_cache.nbytes() / 4 + value_cache.nbytes() / 4;
+  ASSERT_EQ(manager.bytes_spilled(), 2 * block_bytes);
+
+  // the hot blocks were never copied out and stay intact
+  ASSERT_TRUE(at::equal(key_cache[0], key_orig[0]));
+  ASSERT_TRUE(at::equal(value_cache[1], value_orig[1]));
+
+  // fetching restores the spilled blocks from the tier copy
+  manager.prefetch({2, 3});
+  manager.wait();
+  ASSERT_EQ(manager.spilled_blocks(), 0);
+  ASSERT_EQ(manager.bytes_fetched(), 2 * block_bytes);
+  ASSERT_TRUE(at::equal(key_cache, key_orig));
+  ASSERT_TRUE(at::equal(value_cache, value_orig));
+
+  // resident blocks are not refetched; unknown ids are ignored
+  manager.prefetch({0, 99});
+  manager.spill_older_than(-1);
+  manager.wait();
+  ASSERT_EQ(manager.spilled_blocks(), 0);
+
+  manager.clear();
+  ASSERT_EQ(manager.num_blocks(), 0);
+  ASSERT_EQ(manager.bytes_spilled(), 0);
+}
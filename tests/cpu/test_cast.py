@@ -0,0 +1,48 @@
+import unittest
+
+import torch
+
+import intel_extension_for_pytorch as ipex  # noqa F401
+
+from common_utils import TestCase
+
+
+class CastConvertTester(TestCase):
+    def test_narrow_and_widen(self):
+        for dtype in [torch.bfloat16, torch.half]:
+            for numel in [1, 15, 16, 17, 1000, 4096 + 7]:
+                x = torch.randn(numel)
+                y = torch.ops.torch_ipex.cast_convert(x, dtype)
+                self.assertEqual(y.dtype, dtype)
+                self.assertEqual(y, x.to(dtype))
+                back = torch.ops.torch_ipex.cast_convert(y, torch.float)
+                self.assertEqual(back.dtype, torch.float)
+                self.assertEqual(back, y.float())
+
+    def test_nan_and_inf(self):
+        x = torch.tensor([float("nan"), float("inf"), -float("inf"), 0.0])
+        for dtype in [torch.bfloat16, torch.half]:
+            y = torch.ops.torch_ipex.cast_convert(x, dtype)
+            self.assertTrue(torch.isnan(y[0]))
+            self.assertEqual(y[1:], x[1:].to(dtype))
+
+    def test_large_tensor_streaming_path(self):
+        # over the non-temporal threshold (> 32 MB combined)
+        x = torch.randn(8 * 1024 * 1024)
+        y = torch.ops.torch_ipex.cast_convert(x, torch.bfloat16)
+        self.assertEqual(y, x.to(torch.bfloat16))
+
+    def test_same_dtype_returns_copy(self):
+        x = torch.randn(64)
+        y = torch.ops.torch_ipex.cast_convert(x, torch.float)
+        self.assertEqual(y, x)
+        self.assertNotEqual(y.data_ptr(), x.data_ptr())
+
+    def test_non_contiguous_fallback(self):
+        x = torch.randn(64, 64).t()
+        y = torch.ops.torch_ipex.cast_convert(x, torch.bfloat16)
+        self.assertEqual(y, x.to(torch.bfloat16))
+
+
+if __name__ == "__main__":
+    test = unittest.main()
@@ -796,6 +796,10 @@ class CPUOPsTester(TestCase):
                 helper(self, (4, 40, 40, 40), 2, torch.channels_last, dtype, is_mixed)
                 helper(self, (2, 30, 50, 50), 3, torch.channels_last, dtype, is_mixed)
                 helper(self, (2, 60, 50, 50), 3, torch.channels_last, dtype, is_mixed)
+                # diffusion UNet configs: 32 groups, large feature map, hits
+                # the cache-resident single-pass path
+                helper(self, (1, 960, 32, 32), 32, torch.channels_last, dtype, is_mixed)
+                helper(self, (2, 640, 40, 40), 32, torch.channels_last, dtype, is_mixed)
                 helper(
                     self, (2, 9, 7, 11, 15), 3, torch.channels_last_3d, dtype, is_mixed
                 )
@@ -1018,7 +1022,13 @@ class CPUOPsTester(TestCase):
                 self.assertEqual(out, ref_out)
                 self.assertEqual(input.grad, ref_input.grad)
 
-        for dtype in [torch.int64, torch.float32, torch.double]:
+        for dtype in [
+            torch.int64,
+            torch.float32,
+            torch.double,
+            torch.bfloat16,
+            torch.float16,
+        ]:
             for contig in [True, False]:
                 for count_include_pad in [True, False]:
                     helper(
@@ -1483,6 +1493,158 @@ class CPUOPsTester(TestCase):
                         math_ref = math_ref.to(dtype)
                     torch.testing.assert_close(actual, math_ref, atol=atol, rtol=rtol)
 
+    def test_varlen_attention(self):
+        for dtype in [torch.float, torch.bfloat16]:
+            for causal in [False, True]:
+                atol = 1e-5 if dtype is torch.float else 2e-2
+                rtol = 5e-6 if dtype is torch.float else 2e-2
+                seqlens = [10, 1, 137, 64]
+                n_head, head_dim = 4, 16
+                total = sum(seqlens)
+                cu_seqlens = torch.tensor(
+                    [0] + list(itertools.accumulate(seqlens)), dtype=torch.int32
+                )
+                max_seqlen = max(seqlens)
+                q = torch.randn((total, n_head, head_dim), dtype=dtype)
+                k = torch.randn((total, n_head, head_dim), dtype=dtype)
+                v = torch.randn((total, n_head, head_dim), dtype=dtype)
+                packed_out = torch.ops.torch_ipex.varlen_attention(
+                    q,
+                    k,
+                    v,
+                    cu_seqlens,
+                    cu_seqlens,
+                    max_seqlen,
+                    max_seqlen,
+                    is_causal=causal,
+                )
+                # reference: per-sequence dense SDPA on the same tokens
+                for i, seqlen in enumerate(seqlens):
+                    start, end = cu_seqlens[i].item(), cu_seqlens[i + 1].item()
+                    q2 = q[start:end].transpose(0, 1).unsqueeze(0).float()
+                    k2 = k[start:end].transpose(0, 1).unsqueeze(0).float()
+                    v2 = v[start:end].transpose(0, 1).unsqueeze(0).float()
+                    math_ref = torch._scaled_dot_product_attention_math(
+                        q2, k2, v2, dropout_p=0.0, is_causal=causal
+                    )[0]
+                    math_ref = (
+                        math_ref.squeeze(0).transpose(0, 1).to(dtype)
+                    )
+                    torch.testing.assert_close(
+                        packed_out[start:end], math_ref, atol=atol, rtol=rtol
+                    )
+
+    def test_unpad_pad_input(self):
+        batch, seqlen, hidden = 3, 9, 8
+        lengths = [9, 2, 5]
+        mask = torch.zeros((batch, seqlen), dtype=torch.long)
+        for i, length in enumerate(lengths):
+            mask[i, :length] = 1
+        x = torch.randn((batch, seqlen, hidden))
+        packed, indices, cu_seqlens, max_seqlen = torch.ops.torch_ipex.unpad_input(
+            x, mask
+        )
+        self.assertEqual(packed.size(0), sum(lengths))
+        self.assertEqual(cu_seqlens.tolist(), [0, 9, 11, 16])
+        self.assertEqual(max_seqlen, 9)
+        for i, length in enumerate(lengths):
+            start = cu_seqlens[i].item()
+            self.assertEqual(packed[start : start + length], x[i, :length])
+        # pad_input restores the padded layout with zeros elsewhere
+        repadded = torch.ops.torch_ipex.pad_input(packed, indices, batch, seqlen)
+        self.assertEqual(repadded, x * mask.unsqueeze(-1))
+
+    def test_dynamic_quant_linear(self):
+        def reference(x, qweight, scales, comp, bias):
+            # Same math as the kernel: per-row asymmetric u8 activations,
+            # integer GEMM, dequant epilogue with zero-point compensation.
+            x2d = x.reshape(-1, x.size(-1))
+            out = torch.empty((x2d.size(0), qweight.size(0)))
+            for m in range(x2d.size(0)):
+                row = x2d[m]
+                mn = torch.clamp(row.min(), max=0.0)
+                mx = torch.clamp(row.max(), min=0.0)
+                scale = (mx - mn) / 255.0
+                if scale.item() < 1e-20:
+                    out[m] = bias if bias is not None else 0.0
+                    continue
+                inv = 1.0 / scale
+                zp = int(torch.round(-mn * inv).clamp(0, 255).item())
+                q = torch.round(row * inv).int().add(zp).clamp(0, 255)
+                acc = torch.matmul(
+                    q.to(torch.int32), qweight.t().to(torch.int32)
+                )
+                v = scale * scales * (acc - zp * comp).float()
+                out[m] = v + bias if bias is not None else v
+            return out.reshape(list(x.shape[:-1]) + [qweight.size(0)])
+
+        for shape, with_bias in itertools.product(
+            [(4, 64), (2, 3, 128), (1, 100)], [True, False]
+        ):
+            K = shape[-1]
+            N = 16
+            weight = torch.randn(N, K)
+            bias = torch.randn(N) if with_bias else None
+            x = torch.randn(shape)
+            # include a zero row and a constant row
+            x.reshape(-1, K)[0] = 0
+            if x.reshape(-1, K).size(0) > 1:
+                x.reshape(-1, K)[1] = 2.5
+            (
+                qweight,
+                w_scales,
+                w_comp,
+            ) = torch.ops.torch_ipex.dynamic_quant_linear_prepack(weight)
+            self.assertEqual(qweight.dtype, torch.int8)
+            out = torch.ops.torch_ipex.dynamic_quant_linear(
+                x, qweight, w_scales, w_comp, bias
+            )
+            ref = reference(x, qweight, w_scales, w_comp, bias)
+            self.assertEqual(out, ref, prec=1e-4)
+            # sanity: close to the fp32 linear within quantization noise
+            fp_ref = torch.nn.functional.linear(x, weight, bias)
+            self.assertEqual(out, fp_ref, prec=0.1 * K**0.5)
+
+    def test_sampling_softmax(self):
+        for shape, temperature, top_k in itertools.product(
+            [(1, 1000), (4, 333)], [1.0, 0.7], [0, 50]
+        ):
+            logits = torch.randn(shape)
+            probs = torch.ops.torch_ipex.sampling_softmax(
+                logits, temperature, top_k
+            )
+            scaled = logits / temperature
+            if top_k > 0:
+                thr = torch.topk(scaled, top_k, dim=-1).values[..., -1:]
+                scaled = scaled.masked_fill(scaled < thr, float("-inf"))
+            ref = torch.softmax(scaled, dim=-1)
+            self.assertEqual(probs, ref, prec=1e-5)
+            self.assertEqual(
+                probs.sum(-1), torch.ones(shape[:-1]), prec=1e-5
+            )
+            if top_k > 0:
+                self.assertEqual(
+                    (probs > 0).sum(-1),
+                    torch.full(shape[:-1], top_k, dtype=torch.int64),
+                )
+
+    def test_sample_token(self):
+        logits = torch.randn(8, 500)
+        probs = torch.ops.torch_ipex.sampling_softmax(logits, 1.0, 20)
+        # greedy mode matches argmax, including the output shape
+        greedy = torch.ops.torch_ipex.sample_token(probs, False)
+        self.assertEqual(greedy, torch.argmax(probs, dim=-1, keepdim=True))
+        # sampling only ever picks tokens with nonzero probability
+        sampled = torch.ops.torch_ipex.sample_token(probs, True)
+        self.assertEqual(sampled.shape, torch.Size([8, 1]))
+        self.assertTrue(torch.all(probs.gather(-1, sampled) > 0))
+        # deterministic under torch.manual_seed
+        torch.manual_seed(11)
+        first = torch.ops.torch_ipex.sample_token(probs, True)
+        torch.manual_seed(11)
+        second = torch.ops.torch_ipex.sample_token(probs, True)
+        self.assertEqual(first, second)
+
 
 if __name__ == "__main__":
     test = unittest.main()
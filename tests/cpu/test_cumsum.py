@@ -15,6 +15,22 @@ class TestCumSum(TestCase):
             torch.ops.torch_ipex.cumsum_(x, 1)
             self.assertEqual(res1, x)
 
+        for dtype in [torch.int, torch.long]:
+            # long 1-D scan, as produced by offset computations over index
+            # tensors, plus a batched variant covering the chunked path.
+            # Pass dtype explicitly: without it integer_upcast promotes the
+            # accumulation to int64 and the int32 kernel is never hit.
+            x = torch.randint(-8, 8, (1000000,), dtype=dtype)
+            self.assertEqual(
+                torch.ops.torch_ipex.cumsum(x, 0, dtype=dtype),
+                torch.cumsum(x, 0, dtype=dtype),
+            )
+            x = torch.randint(-8, 8, (3, 100001), dtype=dtype)
+            self.assertEqual(
+                torch.ops.torch_ipex.cumsum(x, 1, dtype=dtype),
+                torch.cumsum(x, 1, dtype=dtype),
+            )
+
         a = torch.tensor(
             [[True, False, True], [False, False, False], [True, True, True]]
         )
@@ -0,0 +1,137 @@
+import unittest
+
+import torch
+import torch.nn.functional as F
+
+import intel_extension_for_pytorch as ipex
+from intel_extension_for_pytorch.nn.functional import dropout_add_layer_norm
+
+from common_utils import TestCase
+
+
+def unpack_mask(mask, N):
+    # bit j of byte k covers element 8 * k + j, set when the element is kept
+    shifts = torch.arange(8, dtype=torch.uint8)
+    bits = (mask.unsqueeze(-1) >> shifts) & 1
+    return bits.view(mask.size(0), -1)[:, :N].float()
+
+
+class DropoutAddLayerNormTester(TestCase):
+    def test_forward_no_dropout(self):
+        for dtype, prec in [(torch.float, 1e-5), (torch.bfloat16, 1e-2)]:
+            a = torch.randn(4, 8, 32).to(dtype)
+            b = torch.randn(4, 8, 32).to(dtype)
+            weight = torch.randn(32).to(dtype)
+            bias = torch.randn(32).to(dtype)
+            y = dropout_add_layer_norm(a, b, 0.0, [32], weight, bias, 1e-5)
+            ref = F.layer_norm(a + b, [32], weight, bias, 1e-5)
+            self.assertEqual(y, ref, prec=prec)
+            # eval mode disables dropout even with p > 0
+            y_eval = dropout_add_layer_norm(
+                a, b, 0.5, [32], weight, bias, 1e-5, training=False
+            )
+            self.assertEqual(y_eval, ref, prec=prec)
+
+    def test_forward_mask_consistency(self):
+        p = 0.5
+        a = torch.randn(16, 64)
+        b = torch.randn(16, 64)
+        weight = torch.randn(64)
+        bias = torch.randn(64)
+        out, x, mask, mean, rstd = torch.ops.torch_ipex.dropout_add_layernorm(
+            a, b, p, [64], weight, bias, 1e-5
+        )
+        keep = unpack_mask(mask, 64)
+        # roughly half of the elements should be kept
+        self.assertTrue(0.3 < keep.mean().item() < 0.7)
+        # the saved dropout-add output and the final output must both match
+        # a reference built from the returned mask
+        x_ref = a * keep / (1 - p) + b
+        self.assertEqual(x, x_ref, prec=1e-5)
+        ref = F.layer_norm(x_ref, [64], weight, bias, 1e-5)
+        self.assertEqual(out, ref, prec=1e-4)
+
+    def test_determinism(self):
+        a = torch.randn(8, 32)
+        b = torch.randn(8, 32)
+        torch.manual_seed(42)
+        y1 = torch.ops.torch_ipex.dropout_add_layernorm(
+            a, b, 0.5, [32], None, None, 1e-5
+        )
+        torch.manual_seed(42)
+        y2 = torch.ops.torch_ipex.dropout_add_layernorm(
+            a, b, 0.5, [32], None, None, 1e-5
+        )
+        self.assertEqual(y1[0], y2[0])
+        self.assertEqual(y1[2], y2[2])
+
+    def test_backward_no_dropout(self):
+        for dtype, prec in [(torch.float, 1e-4), (torch.bfloat16, 2e-2)]:
+            a = torch.randn(4, 8, 32).to(dtype).requires_grad_()
+            b = torch.randn(4, 8, 32).to(dtype).requires_grad_()
+            weight = torch.randn(32).to(dtype).requires_grad_()
+            bias = torch.randn(32).to(dtype).requires_grad_()
+            refs = [t.detach().clone().requires_grad_() for t in (a, b, weight, bias)]
+
+            y = dropout_add_layer_norm(a, b, 0.0, [32], weight, bias, 1e-5)
+            grad_out = torch.randn_like(y)
+            y.backward(grad_out)
+
+            ref_y = F.layer_norm(refs[0] + refs[1], [32], refs[2], refs[3], 1e-5)
+            ref_y.backward(grad_out)
+
+            self.assertEqual(a.grad, refs[0].grad, prec=prec)
+            self.assertEqual(b.grad, refs[1].grad, prec=prec)
+            self.assertEqual(weight.grad, refs[2].grad, prec=prec)
+            self.assertEqual(bias.grad, refs[3].grad, prec=prec)
+
+    def test_backward_with_dropout(self):
+        # autograd-path smoke test; the numerical check against a
+        # same-mask reference lives in test_backward_matches_mask
+        p = 0.5
+        a = torch.randn(16, 64).requires_grad_()
+        b = torch.randn(16, 64).requires_grad_()
+        weight = torch.randn(64).requires_grad_()
+        bias = torch.randn(64).requires_grad_()
+
+        y = dropout_add_layer_norm(a, b, p, [64], weight, bias, 1e-5)
+        y.backward(torch.randn_like(y))
+
+        for t in (a, b, weight, bias):
+            self.assertTrue(t.grad is not None)
+            self.assertEqual(t.grad.shape, t.shape)
+            self.assertTrue(torch.isfinite(t.grad).all())
+
+    def test_backward_matches_mask(self):
+        # drive the raw ops directly so the reference uses the same mask
+        p = 0.5
+        a = torch.randn(16, 64)
+        b = torch.randn(16, 64)
+        weight = torch.randn(64)
+        bias = torch.randn(64)
+        out, x, mask, mean, rstd = torch.ops.torch_ipex.dropout_add_layernorm(
+            a, b, p, [64], weight, bias, 1e-5
+        )
+        grad_out = torch.randn_like(out)
+        da, db, dw, dbias = torch.ops.torch_ipex.dropout_add_layernorm_backward(
+            grad_out, x, mask, mean, rstd, p, [64], weight
+        )
+
+        keep = unpack_mask(mask, 64)
+        ref_a = a.clone().requires_grad_()
+        ref_b = b.clone().requires_grad_()
+        ref_w = weight.clone().requires_grad_()
+        ref_bias = bias.clone().requires_grad_()
+        ref_y = F.layer_norm(
+            ref_a * keep / (1 - p) + ref_b, [64], ref_w, ref_bias, 1e-5
+        )
+        ref_y.backward(grad_out)
+
+        self.assertEqual(da, ref_a.grad, prec=1e-4)
+        self.assertEqual(db, ref_b.grad, prec=1e-4)
+        self.assertEqual(dw, ref_w.grad, prec=1e-3)
+        self.assertEqual(dbias, ref_bias.grad, prec=1e-3)
+
+
+if __name__ == "__main__":
+    test = unittest.main()
@@ -0,0 +1,148 @@
+import unittest
+
+import torch
+import torch.nn.functional as F
+
+import intel_extension_for_pytorch as ipex
+
+from common_utils import TestCase
+
+
+def ref_embedding_layernorm(
+    indices,
+    word_weight,
+    position_weight,
+    token_type_weight=None,
+    position_ids=None,
+    token_type_ids=None,
+    weight=None,
+    bias=None,
+    eps=1e-12,
+):
+    if position_ids is None:
+        position_ids = torch.arange(indices.size(-1))
+    x = F.embedding(indices, word_weight) + F.embedding(
+        position_ids, position_weight
+    )
+    if token_type_weight is not None:
+        if token_type_ids is None:
+            token_type_ids = torch.zeros_like(indices)
+        x = x + F.embedding(token_type_ids, token_type_weight)
+    return F.layer_norm(x, [word_weight.size(1)], weight, bias, eps)
+
+
+class EmbeddingLayerNormTester(TestCase):
+    def test_forward(self):
+        for dtype, prec in [(torch.float, 1e-5), (torch.bfloat16, 2e-2)]:
+            word = torch.randn(100, 64).to(dtype)
+            pos = torch.randn(512, 64).to(dtype)
+            seg = torch.randn(2, 64).to(dtype)
+            weight = torch.randn(64).to(dtype)
+            bias = torch.randn(64).to(dtype)
+            indices = torch.randint(100, (4, 16))
+            token_type_ids = torch.randint(2, (4, 16))
+            y = torch.ops.torch_ipex.embedding_layernorm_dropout(
+                indices,
+                word,
+                pos,
+                seg,
+                None,
+                token_type_ids,
+                weight,
+                bias,
+                1e-12,
+                0.0,
+                False,
+            )
+            ref = ref_embedding_layernorm(
+                indices,
+                word,
+                pos,
+                seg,
+                token_type_ids=token_type_ids,
+                weight=weight,
+                bias=bias,
+            )
+            self.assertEqual(y, ref, prec=prec)
+
+    def test_forward_defaults(self):
+        # no segment embedding, default position ids, no affine params
+        word = torch.randn(50, 48)
+        pos = torch.randn(128, 48)
+        indices = torch.randint(50, (2, 8))
+        y = torch.ops.torch_ipex.embedding_layernorm_dropout(
+            indices, word, pos, None, None, None, None, None, 1e-12, 0.0, False
+        )
+        ref = ref_embedding_layernorm(indices, word, pos)
+        self.assertEqual(y, ref, prec=1e-5)
+
+    def test_explicit_position_ids(self):
+        word = torch.randn(50, 32)
+        pos = torch.randn(128, 32)
+        indices = torch.randint(50, (2, 8))
+        position_ids = torch.randint(128, (2, 8))
+        y = torch.ops.torch_ipex.embedding_layernorm_dropout(
+            indices,
+            word,
+            pos,
+            None,
+            position_ids,
+            None,
+            None,
+            None,
+            1e-12,
+            0.0,
+            False,
+        )
+        ref = ref_embedding_layernorm(
+            indices, word, pos, position_ids=position_ids
+        )
+        self.assertEqual(y, ref, prec=1e-5)
+
+    def test_int32_indices(self):
+        word = torch.randn(30, 32)
+        pos = torch.randn(64, 32)
+        indices = torch.randint(30, (3, 7), dtype=torch.int32)
+        y = torch.ops.torch_ipex.embedding_layernorm_dropout(
+            indices, word, pos, None, None, None, None, None, 1e-12, 0.0, False
+        )
+        ref = ref_embedding_layernorm(indices.long(), word, pos)
+        self.assertEqual(y, ref, prec=1e-5)
+
+    def test_out_of_range_index(self):
+        word = torch.randn(10, 32)
+        pos = torch.randn(64, 32)
+        indices = torch.tensor([[0, 10]])
+        with self.assertRaises(RuntimeError):
+            torch.ops.torch_ipex.embedding_layernorm_dropout(
+                indices,
+                word,
+                pos,
+                None,
+                None,
+                None,
+                None,
+                None,
+                1e-12,
+                0.0,
+                False,
+            )
+
+    def test_training_dropout(self):
+        # with training=True and p > 0 the zeroed positions follow a real
+        # dropout mask; with p = 0 the result matches the inference path
+        word = torch.randn(20, 32)
+        pos = torch.randn(64, 32)
+        indices = torch.randint(20, (8, 16))
+        y = torch.ops.torch_ipex.embedding_layernorm_dropout(
+            indices, word, pos, None, None, None, None, None, 1e-12, 0.5, True
+        )
+        ref = ref_embedding_layernorm(indices, word, pos)
+        zero_frac = (y == 0).float().mean().item()
+        self.assertTrue(0.3 < zero_frac < 0.7)
+        kept = y != 0
+        self.assertEqual(y[kept], ref[kept] / 0.5, prec=1e-4)
+
+
+if __name__ == "__main__":
+    test = unittest.main()
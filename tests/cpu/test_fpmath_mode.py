@@ -68,6 +68,34 @@ class TestFPMathCases(TestCase):
                     num4 > 0 and num5 > 0 and num3 >= 3 and num7 > 0
                 ), "The implicit FP32 to BF16 data type conversion failed to enable in backward pass."
 
+    @fpmath_mode_env
+    def test_fpmath_policy_scope(self):
+        core = ipex._C
+        cat = core.FpMathOpCategory
+        all_categories = [cat.CONV, cat.LINEAR, cat.MATMUL, cat.RNN]
+        # Without an active scope, every category follows the global mode.
+        ipex.set_fp32_math_mode(mode=ipex.FP32MathMode.BF32, device="cpu")
+        for c in all_categories:
+            assert core.get_fp32_math_mode_policy(c) == core.FP32MathMode.BF32
+        ipex.set_fp32_math_mode()
+        with ipex.fp32_math_mode_scope(conv_mode=ipex.FP32MathMode.BF32):
+            assert core.get_fp32_math_mode_policy(cat.CONV) == core.FP32MathMode.BF32
+            assert core.get_fp32_math_mode_policy(cat.LINEAR) == core.FP32MathMode.FP32
+            with ipex.fp32_math_mode_scope(linear_mode=ipex.FP32MathMode.BF32):
+                # The innermost scope wins and does not inherit the
+                # outer conv override.
+                assert core.get_fp32_math_mode_policy(cat.CONV) == core.FP32MathMode.FP32
+                assert (
+                    core.get_fp32_math_mode_policy(cat.LINEAR)
+                    == core.FP32MathMode.BF32
+                )
+            assert core.get_fp32_math_mode_policy(cat.CONV) == core.FP32MathMode.BF32
+        # Scope gone: back to the global mode.
+        for c in all_categories:
+            assert core.get_fp32_math_mode_policy(c) == core.FP32MathMode.FP32
+        with self.assertRaises(RuntimeError):
+            core.pop_fp32_math_mode_policy()
+
     @fpmath_mode_env
     def test_fpmath_strict(self):
         modes = ["jit", "imperative"]
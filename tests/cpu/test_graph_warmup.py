@@ -0,0 +1,74 @@
+import unittest
+import torch
+import torch.nn as nn
+import torch.nn.functional as F
+import intel_extension_for_pytorch as ipex
+from common_utils import TestCase
+
+
+class Conv_Bn_Relu(nn.Module):
+    def __init__(self):
+        super(Conv_Bn_Relu, self).__init__()
+
+        self.conv = torch.nn.Conv2d(6, 3, 3)
+        self.bn = torch.nn.BatchNorm2d(3, eps=0.001)
+
+    def forward(self, x):
+        return F.relu(self.bn(self.conv(x)), inplace=True)
+
+
+class TestGraphWarmup(TestCase):
+    def test_warmup_background(self):
+        model = Conv_Bn_Relu().eval()
+        x = torch.randn(1, 6, 16, 16)
+        with torch.no_grad():
+            res_ref = model(x)
+            model = ipex.optimize(model, dtype=torch.float32)
+            traced = torch.jit.trace(model, x)
+            traced = torch.jit.freeze(traced)
+
+            handle = ipex.warmup_jit(traced, (x,))
+            self.assertTrue(handle.wait(timeout=300))
+            self.assertTrue(handle.done)
+            self.assertTrue(handle.exception is None)
+
+            # the optimized plan must be in place: fusion already applied
+            trace_graph = traced.graph_for(x)
+            self.assertTrue(
+                any(
+                    n.kind().startswith("ipex_prepack::convolution")
+                    for n in trace_graph.nodes()
+                )
+            )
+            self.assertEqual(res_ref, traced(x))
+
+    def test_warmup_sync_multiple_configs(self):
+        model = Conv_Bn_Relu().eval()
+        x1 = torch.randn(1, 6, 16, 16)
+        x2 = torch.randn(4, 6, 16, 16)
+        with torch.no_grad():
+            model = ipex.optimize(model, dtype=torch.float32)
+            traced = torch.jit.trace(model, x1)
+            traced = torch.jit.freeze(traced)
+
+            handle = ipex.warmup_jit(traced, [(x1,), (x2,)], background=False)
+            self.assertTrue(handle.done)
+            self.assertTrue(handle.exception is None)
+
+    def test_warmup_propagates_failure(self):
+        model = Conv_Bn_Relu().eval()
+        x = torch.randn(1, 6, 16, 16)
+        bad_input = torch.randn(1, 2, 16, 16)
+        with torch.no_grad():
+            model = ipex.optimize(model, dtype=torch.float32)
+            traced = torch.jit.trace(model, x)
+            traced = torch.jit.freeze(traced)
+
+            handle = ipex.warmup_jit(traced, (bad_input,))
+            self.assertTrue(handle.wait(timeout=300))
+            self.assertTrue(handle.done)
+            self.assertTrue(handle.exception is not None)
+
+
+if __name__ == "__main__":
+    test = unittest.main()
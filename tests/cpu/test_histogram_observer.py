@@ -0,0 +1,48 @@
+import torch
+import unittest
+from common_utils import TestCase
+
+
+class TestHistogramObserver(TestCase):
+    def test_histogram_observe(self):
+        for dtype in [torch.float, torch.bfloat16]:
+            x = torch.randn(17, 4097).to(dtype)
+            hist = torch.zeros(2048, dtype=torch.int64)
+            hist_min, hist_max = -4.0, 4.0
+            x_min, x_max = torch.ops.torch_ipex.histogram_observe(
+                x, hist, hist_min, hist_max
+            )
+            x_fp32 = x.float()
+            self.assertEqual(x_min, x_fp32.min().item())
+            self.assertEqual(x_max, x_fp32.max().item())
+            # every value lands in exactly one bin; out-of-range values
+            # are clamped into the edge bins
+            self.assertEqual(hist.sum().item(), x.numel())
+            clamped = x_fp32.clamp(hist_min, hist_max)
+            ref = torch.histc(clamped, bins=2048, min=hist_min, max=hist_max)
+            # float vs double bin-edge rounding may move a value into the
+            # neighboring bin, so compare cumulative distributions
+            self.assertEqual(
+                hist.cumsum(0).float(), ref.cumsum(0), prec=x.numel() * 1e-3
+            )
+
+    def test_histogram_observe_accumulates(self):
+        hist = torch.zeros(128, dtype=torch.int64)
+        x = torch.randn(1000)
+        torch.ops.torch_ipex.histogram_observe(x, hist, -3.0, 3.0)
+        torch.ops.torch_ipex.histogram_observe(x, hist, -3.0, 3.0)
+        self.assertEqual(hist.sum().item(), 2 * x.numel())
+
+    def test_histogram_observe_clamps_outliers(self):
+        hist = torch.zeros(16, dtype=torch.int64)
+        x = torch.tensor([-100.0, -0.5, 0.5, 100.0])
+        x_min, x_max = torch.ops.torch_ipex.histogram_observe(x, hist, -1.0, 1.0)
+        self.assertEqual(x_min, -100.0)
+        self.assertEqual(x_max, 100.0)
+        self.assertEqual(hist[0].item(), 1)
+        self.assertEqual(hist[-1].item(), 1)
+        self.assertEqual(hist.sum().item(), 4)
+
+
+if __name__ == "__main__":
+    test = unittest.main()
@@ -1,6 +1,8 @@
 # Copyright (c) Facebook, Inc. and its affiliates. All Rights Reserved.
 import torch
 
+import intel_extension_for_pytorch as ipex  # noqa F401
+
 # import unittest
 from common_utils import TestCase
 from torch.nn import InstanceNorm2d, InstanceNorm3d, BatchNorm2d, BatchNorm3d
@@ -61,6 +63,32 @@ class InstanceNormTester(TestCase):
             self.assertEqual(x2.grad, x1.grad)
             self.assertTrue(x2.grad.is_contiguous(memory_format=memory_format))
 
+    def test_instance_norm_relu(self):
+        for dim in [2, 3]:
+            batch = 3
+            channel = 17
+
+            input_size = [batch, channel, 45, 35]
+            if dim == 2:
+                memory_format = torch.channels_last
+            else:
+                input_size += [20]
+                memory_format = torch.channels_last_3d
+
+            m = inst_m[dim](channel, affine=True).eval()
+
+            for dtype, prec in [(torch.float32, None), (torch.bfloat16, 0.1)]:
+                input = torch.randn(input_size).to(dtype) * 0.5 + 4
+                with torch.no_grad():
+                    for x in [input, input.to(memory_format=memory_format)]:
+                        ref = torch.relu(m(x.float())).to(dtype)
+                        y = torch.ops.torch_ipex.instance_norm_relu(
+                            x, m.weight, m.bias, None, None, True, 0.1, 1e-5
+                        )
+                        self.assertTrue(y.dtype == dtype)
+                        self.assertEqual(y, ref, prec=prec)
+                        self.assertTrue((y >= 0).all())
+
     def test_instance_norm_bfloat16(self):
         for dim in [2, 3]:
             batch = 10
@@ -803,6 +803,28 @@ class LinearMulAdd(nn.Module):
         return x_l
 
 
+class LinearScaleShiftChain(nn.Module):
+    def __init__(self, in_channels, out_channels, cast_dtype=None, **kwargs):
+        super(LinearScaleShiftChain, self).__init__()
+        seed = 2018
+        torch.manual_seed(seed)
+        self.linear = nn.Linear(in_channels, out_channels, **kwargs)
+        self.cast_dtype = cast_dtype
+        dtype = cast_dtype if cast_dtype is not None else torch.float32
+        self.register_buffer("scale1", (torch.rand(out_channels) + 0.5).to(dtype))
+        self.register_buffer("shift", torch.rand(out_channels).to(dtype))
+        self.register_buffer("scale2", (torch.rand(out_channels) + 0.5).to(dtype))
+
+    def forward(self, x):
+        x = self.linear(x)
+        if self.cast_dtype is not None:
+            x = x.to(self.cast_dtype)
+        x = x * self.scale1
+        x = x + self.shift
+        x = x * self.scale2
+        return x
+
+
 class LinearMul(nn.Module):
     def __init__(self, in_features, num_layers, low_rank):
         super(LinearMul, self).__init__()
@@ -1037,6 +1059,21 @@ class ChannelShuffle_with_Dynamic_Shape(nn.Module):
         return x
 
 
+class ChannelShuffleSplit(nn.Module):
+    def __init__(self, groups):
+        super(ChannelShuffleSplit, self).__init__()
+        self.groups = groups
+
+    def forward(self, x):
+        batchsize, num_channels, height, width = x.size()
+        channels_per_group = num_channels // self.groups
+        x = x.view(batchsize, self.groups, channels_per_group, height, width)
+        x = torch.transpose(x, 1, 2).contiguous()
+        x = x.view(batchsize, -1, height, width)
+        x1, x2 = x.chunk(2, dim=1)
+        return x1 + x2 * 2
+
+
 class NotChannelShuffle(nn.Module):
     def __init__(self, groups):
         super(NotChannelShuffle, self).__init__()
@@ -1178,6 +1215,14 @@ class BmmAdd(nn.Module):
         return res
 
 
+class MatmulGroup(nn.Module):
+    def __init__(self):
+        super(MatmulGroup, self).__init__()
+
+    def forward(self, x1, x2, x3, y1, y2, y3):
+        return torch.matmul(x1, y1) + torch.matmul(x2, y2) + torch.matmul(x3, y3)
+
+
 class MHAScoresCalculation(nn.Module):
     def __init__(self, dim_per_head, softmax_dim=-1):
         super(MHAScoresCalculation, self).__init__()
@@ -1407,6 +1452,32 @@ class ConcatBnReluV3(torch.nn.Module):
         return y + x
 
 
+class BatchNormAddRelu(torch.nn.Module):
+    def __init__(self, dim, in_channels, **kwargs):
+        super(BatchNormAddRelu, self).__init__()
+        self.bn = bn_module[dim](in_channels)
+        self.relu = torch.nn.ReLU()
+
+    def forward(self, x, y):
+        return self.relu(self.bn(x) + y)
+
+
+class BatchNormRelu(torch.nn.Module):
+    def __init__(self, dim, in_channels, **kwargs):
+        super(BatchNormRelu, self).__init__()
+        self.bn = bn_module[dim](in_channels)
+        self.relu = torch.nn.ReLU()
+
+    def forward(self, x):
+        return self.relu(self.bn(x))
+
+
+class EltwiseChainModel(torch.nn.Module):
+    def forward(self, x):
+        # mul-by-constant -> sigmoid -> add-constant -> clamp_max gating
+        return torch.clamp_max(torch.sigmoid(x * 2.0) + 0.5, 1.0)
+
+
 class ModMultLinear(nn.Module):
     def __init__(self, w1_dim, w2_dim):
         super(ModMultLinear, self).__init__()
@@ -1439,6 +1510,22 @@ class ModMultLinearWithOrWithoutBias(nn.Module):
         return res1, res2, res3, res4
 
 
+class ModMultLinearAcrossBranches(nn.Module):
+    def __init__(self):
+        super(ModMultLinearAcrossBranches, self).__init__()
+        self.linear1 = nn.Linear(5, 16)
+        self.linear2 = nn.Linear(5, 16)
+        self.linear3 = nn.Linear(5, 16)
+
+    def forward(self, x, flag: bool):
+        res1 = self.linear1(x)
+        if flag:
+            res2 = self.linear2(x) + 1
+        else:
+            res2 = self.linear3(x)
+        return res1, res2
+
+
 class LinearSwishNaive(nn.Module):
     def __init__(self, in_feature, out_feature):
         super(LinearSwishNaive, self).__init__()
@@ -1499,6 +1586,25 @@ class EinsumAdd(nn.Module):
         return torch.einsum(self.equation, input1, input2) + bias
 
 
+class EinsumPlain(nn.Module):
+    def __init__(self, equation):
+        super(EinsumPlain, self).__init__()
+        self.equation = equation
+
+    def forward(self, input1, input2):
+        return torch.einsum(self.equation, input1, input2)
+
+
+class EinsumConstOperand(nn.Module):
+    def __init__(self, equation, weight):
+        super(EinsumConstOperand, self).__init__()
+        self.equation = equation
+        self.weight = nn.Parameter(weight)
+
+    def forward(self, input1):
+        return torch.einsum(self.equation, input1, self.weight)
+
+
 class EinsumAddScalar(nn.Module):
     def __init__(self, equation):
         super(EinsumAddScalar, self).__init__()
@@ -1975,6 +2081,44 @@ class Tester(TestCase):
             )
             self.assertEqual(linear_count_ori_v1, 2)
 
+    def test_concat_linear_across_branches(self):
+        def check_op_count(graph_str, op_names=None):
+            if op_names is None:
+                op_names = []
+            count = 0
+            node_list = graph_str.strip().split("\n")
+            for node in node_list:
+                for op_name in op_names:
+                    if op_name in node:
+                        count += 1
+            return count
+
+        origin_model = ModMultLinearAcrossBranches().eval()
+        test_val1 = torch.rand([50, 5])
+        model = ipex.optimize(
+            origin_model,
+            concat_linear=False,
+            dtype=torch.float32,
+            weights_prepack=False,
+        )
+        with torch.no_grad():
+            ori_res_true = model(test_val1, True)
+            ori_res_false = model(test_val1, False)
+            # scripting keeps the prim::If so the branch linears sit in
+            # sub-blocks; they should be hoisted and merged with linear1
+            model_jit = torch.jit.script(model)
+            graph_ori = str(model_jit.graph_for(test_val1, True))
+            linear_count_ori = check_op_count(graph_ori, ["aten::linear"])
+            self.assertEqual(linear_count_ori, 3)
+            model_jit = torch.jit.freeze(model_jit)
+            jit_res_true = model_jit(test_val1, True)
+            jit_res_false = model_jit(test_val1, False)
+            self.assertEqual(ori_res_true, jit_res_true)
+            self.assertEqual(ori_res_false, jit_res_false)
+            graph_opt = str(model_jit.graph_for(test_val1, True))
+            linear_count_opt = check_op_count(graph_opt, ["aten::linear"])
+            self.assertEqual(linear_count_opt, 1)
+
     def test_add_layernorm(self):
         for dim in [768, 100]:
             with torch.no_grad():
@@ -2138,12 +2282,10 @@ class Tester(TestCase):
                         self.assertTrue(
                             tresult.is_contiguous(memory_format=suggest_memory_format)
                         )
-                    if (
-                        use_channels_last
-                        and a1.size(1) % 16 == 0
-                        and a2.size(1) % 16 == 0
-                        and a3.size(1) % 16 == 0
-                    ):
+                    # Channels-last inputs always fuse; the kernel handles
+                    # channel counts not divisible by the vector width with
+                    # masked tails.
+                    if use_channels_last:
                         self.assertTrue(
                             any(
                                 n.kind() == "ipex::concat_bn_relu"
@@ -2165,6 +2307,120 @@ class Tester(TestCase):
                 any(n.kind() != "ipex::concat_bn_relu" for n in trace_graph.nodes())
             )
 
+    def test_batch_norm_add_relu(self):
+        batch_size = 3
+        image_size = 16
+        dtypes = [torch.float32, torch.bfloat16]
+        if core.onednn_has_fp16_support():
+            dtypes.append(torch.float16)
+        options = itertools.product(
+            [2, 3],
+            [32, 17],
+            dtypes,
+            [True, False],
+        )
+        for dim, channels, dtype, use_channels_last in options:
+            input_size = [batch_size, channels, image_size, image_size]
+            if dim == 3:
+                input_size.append(image_size)
+            x = torch.randn(input_size, dtype=dtype)
+            y = torch.randn(input_size, dtype=dtype)
+
+            for with_add in [True, False]:
+                if with_add:
+                    model = BatchNormAddRelu(dim, channels).eval()
+                    inputs = (x, y)
+                else:
+                    model = BatchNormRelu(dim, channels).eval()
+                    inputs = (x,)
+                if use_channels_last:
+                    suggest_memory_format = (
+                        torch.channels_last if dim == 2 else torch.channels_last_3d
+                    )
+                    inputs = tuple(
+                        t.to(memory_format=suggest_memory_format) for t in inputs
+                    )
+                    model = model.to(memory_format=suggest_memory_format)
+
+                model = ipex.optimize(model, dtype=dtype)
+
+                with torch.cpu.amp.autocast(
+                    enabled=True if dtype in [torch.bfloat16, torch.half] else False,
+                    dtype=dtype,
+                ), torch.no_grad():
+                    result = model(*inputs)
+                    trace_model = torch.jit.trace(model, inputs).eval()
+                    trace_model = torch.jit.freeze(trace_model)
+
+                    tresult = trace_model(*inputs)
+                    trace_graph = trace_model.graph_for(*inputs)
+
+                    self.assertEqual(result, tresult)
+                    self.assertEqual(tresult.dtype, dtype)
+                    if use_channels_last:
+                        self.assertTrue(
+                            tresult.is_contiguous(memory_format=suggest_memory_format)
+                        )
+                        self.assertTrue(
+                            any(
+                                n.kind() == "ipex::batch_norm_add_relu"
+                                for n in trace_graph.nodes()
+                            )
+                        )
+                    else:
+                        self.assertTrue(
+                            all(
+                                n.kind() != "ipex::batch_norm_add_relu"
+                                for n in trace_graph.nodes()
+                            )
+                        )
+
+    def test_eltwise_chain(self):
+        model = EltwiseChainModel().eval()
+        for dtype, prec in [(torch.float32, None), (torch.bfloat16, 2e-2)]:
+            x = torch.randn(2, 3, 8, 8).to(dtype)
+            with torch.no_grad():
+                result = model(x)
+                trace_model = torch.jit.trace(model, x).eval()
+                trace_model = torch.jit.freeze(trace_model)
+                tresult = trace_model(x)
+                trace_graph = trace_model.graph_for(x)
+
+                self.assertEqual(result, tresult, prec=prec)
+                self.assertEqual(tresult.dtype, dtype)
+                self.assertTrue(
+                    any(
+                        n.kind() == "ipex::eltwise_chain"
+                        for n in trace_graph.nodes()
+                    )
+                )
+
+    def test_eltwise_chain_math_precision(self):
+        model = EltwiseChainModel().eval()
+        x = torch.randn(2, 3, 8, 8)
+        with torch.no_grad():
+            result = model(x)
+            trace_model = torch.jit.trace(model, x).eval()
+            trace_model = torch.jit.freeze(trace_model)
+            # LOW trades tanh/sigmoid accuracy (<= ~1e-3 absolute) for speed
+            with ipex.math_precision_scope(ipex.MathPrecisionClass.LOW):
+                tresult_low = trace_model(x)
+            self.assertEqual(result, tresult_low, prec=1e-2)
+            # outside the scope the tuned default is back and bit-exact
+            # against eager
+            tresult = trace_model(x)
+            self.assertEqual(result, tresult)
+            # global setter path
+            ipex.set_math_precision(ipex.MathPrecisionClass.LOW)
+            try:
+                self.assertEqual(
+                    ipex.get_math_precision(), ipex.MathPrecisionClass.LOW
+                )
+                tresult_low2 = trace_model(x)
+                self.assertEqual(result, tresult_low2, prec=1e-2)
+            finally:
+                ipex.set_math_precision(ipex.MathPrecisionClass.MEDIUM)
+
     def test_mha_scores_calculation(self):
         def _check_match_mha(
             trace_model, mat1, mat2, bias, node="ipex::mha_scores_calc"
@@ -4441,6 +4697,60 @@ class Tester(TestCase):
     def test_linear_non_unary_fusion(self):
         self._test_linear_unary_fusion(non_unary_PyTorch_op_to_IPEX_op_map)
 
+    def test_frozen_linear_fold_scale_shift_chain(self):
+        # the per-channel mul -> add -> mul chain (optionally behind a dtype
+        # cast) should fold entirely into the frozen linear weight and bias
+        for cast_dtype in [None, torch.bfloat16]:
+            model = LinearScaleShiftChain(8, 16, cast_dtype=cast_dtype).eval()
+            x = torch.randn(2, 8)
+            with torch.no_grad():
+                res_ref = model(x)
+                tr_model = torch.jit.trace(model, x)
+                tr_model = torch.jit.freeze(tr_model)
+                tr_model(x)
+                tr_model(x)
+                trace_graph = tr_model.graph_for(x)
+                res_jit = tr_model(x)
+                prec = 2e-2 if cast_dtype is not None else 1e-4
+                self.assertEqual(res_ref, res_jit, prec=prec)
+                self.assertFalse(
+                    any(
+                        n.kind() in ["aten::mul", "aten::add"]
+                        for n in trace_graph.nodes()
+                    )
+                )
+
+    def test_prepack_folding_shared_weight(self):
+        # tied weights must be packed once: both linear_run nodes should
+        # share a single packed op context constant
+        class TiedLinear(nn.Module):
+            def __init__(self, num_features):
+                super(TiedLinear, self).__init__()
+                self.weight = nn.Parameter(torch.randn(num_features, num_features))
+
+            def forward(self, x):
+                x = F.linear(x, self.weight)
+                return F.linear(x, self.weight)
+
+        model = TiedLinear(16).eval()
+        x = torch.randn(2, 16)
+        with torch.no_grad():
+            res_ref = model(x)
+            tr_model = torch.jit.trace(model, x)
+            tr_model = torch.jit.freeze(tr_model)
+            tr_model(x)
+            tr_model(x)
+            trace_graph = tr_model.graph_for(x)
+            res_jit = tr_model(x)
+            self.assertEqual(res_ref, res_jit)
+            op_context_constants = [
+                n
+                for n in trace_graph.nodes()
+                if n.kind() == "prim::Constant"
+                and "OpContext" in str(n.output().type())
+            ]
+            self.assertEqual(len(op_context_constants), 1)
+
     def test_linear_fusion_unsupported_case(self):
         batch_size = 3
         out_channels = 32
@@ -4611,6 +4921,14 @@ class Tester(TestCase):
             kind_not_in_graph="ipex::shuffle_2d",
         )
 
+    def test_channel_shuffle_split(self):
+        self._test_output(
+            ChannelShuffleSplit(4),
+            torch.rand(10, 16, 50, 50),
+            kind_in_graph="ipex::shuffle_2d_split",
+            kind_not_in_graph="ipex::shuffle_2d",
+        )
+
     def test_jit_function(self):
         # test hool trace and script can works for function
         def fn(input, weight, bias):
@@ -4842,6 +5160,57 @@ class Tester(TestCase):
                     )
                     self.assertEqual(out, expected, prec=1e-1)
 
+    def test_matmul_group(self):
+        model = MatmulGroup().eval()
+        xs = [torch.randn(64, 128) for _ in range(3)]
+        ys = [torch.randn(128, 128) for _ in range(3)]
+        inputs = xs + ys
+        expected = model(*inputs)
+        with torch.no_grad():
+            traced_mod = torch.jit.trace(model, inputs)
+            traced_mod = torch.jit.freeze(traced_mod)
+            # warm up so the profiled shapes the grouping pass needs are in place
+            traced_mod(*inputs)
+            out = traced_mod(*inputs)
+            fused_mod = traced_mod.graph_for(*inputs)
+            self.assertTrue(
+                any(n.kind() == "torch_ipex::matmul_group" for n in fused_mod.nodes())
+            )
+            self.assertEqual(out, expected, prec=1e-4)
+
+    def test_graph_snapshot_roundtrip(self):
+        import tempfile
+
+        model = MatmulGroup().eval()
+        xs = [torch.randn(64, 128) for _ in range(3)]
+        ys = [torch.randn(128, 128) for _ in range(3)]
+        inputs = xs + ys
+        with torch.no_grad():
+            traced_mod = torch.jit.trace(model, inputs)
+            traced_mod = torch.jit.freeze(traced_mod)
+            traced_mod(*inputs)
+            graph = traced_mod.graph_for(*inputs)
+            with tempfile.TemporaryDirectory() as tmp:
+                path = os.path.join(tmp, "graph.snapshot")
+                ipex.jit.save_optimized_graph(graph, path)
+                reloaded = ipex.jit.load_optimized_graph(path)
+                # fusion groups are re-formed on load
+                self.assertTrue(
+                    any(
+                        n.kind() == "torch_ipex::matmul_group"
+                        for n in reloaded.nodes()
+                    )
+                )
+                # a snapshot from a mismatching build/machine is rejected
+                with open(path, "rb") as f:
+                    lines = f.read().split(b"\n")
+                lines[1] = b"v0|bogus|dnnl-0.0.0"
+                bad_path = os.path.join(tmp, "graph.bad")
+                with open(bad_path, "wb") as f:
+                    f.write(b"\n".join(lines))
+                with self.assertRaises(RuntimeError):
+                    ipex.jit.load_optimized_graph(bad_path)
+
     def test_einsum_add(self):
         def _test_fp32(
             model_test,
@@ -4908,7 +5277,9 @@ class Tester(TestCase):
         input1 = torch.randn(4, 3, 768)
         input2 = torch.randn(768, 2304)
         model_v1 = EinsumAddInplaceV1("bsh,ho->bso")
-        _test_fp32(model_v1, input1, input2, bias, kind_in_graph="aten::einsum")
+        # the add_ output is aliased so the binary fusion must not happen,
+        # but the einsum itself is still lowered to the ipex contraction
+        _test_fp32(model_v1, input1, input2, bias, kind_in_graph="ipex::einsum")
 
         bias1 = torch.randn(2, 4, 128, 128)
         input3 = torch.randn(2, 4, 128, 768)
@@ -5102,6 +5473,39 @@ class Tester(TestCase):
         model_from_vit_alphafold2_v3 = EinsumAdd("bsh,bho->bso")
         _test_fp32(model_from_vit_alphafold2_v3, input1, input2, bias)
 
+    def test_einsum(self):
+        def _test_fp32(model_test, inputs, kind_in_graph="ipex::einsum", prec=1e-3):
+            model = copy.deepcopy(model_test)
+            model = model.eval()
+            model = ipex.optimize(model, dtype=torch.float32)
+            with torch.no_grad():
+                tr_model = torch.jit.trace(model, inputs)
+                tr_model = torch.jit.freeze(tr_model)
+                tr_model(*inputs)
+                tr_model(*inputs)
+                trace_graph = tr_model.graph_for(*inputs)
+                res_jit = tr_model(*inputs)
+                res_ref = model(*inputs)
+                self.assertEqual(res_ref, res_jit, prec)
+                self.assertTrue(
+                    any(n.kind() == kind_in_graph for n in trace_graph.nodes())
+                )
+
+        # batched 4D contraction from relative-position attention
+        input1 = torch.randn(8, 4, 49, 32)
+        input2 = torch.randn(8, 4, 49, 32)
+        _test_fp32(EinsumPlain("bhid,bhjd->bhij"), (input1, input2))
+
+        input1 = torch.randn(2, 3, 768)
+        input2 = torch.randn(768, 2304)
+        _test_fp32(EinsumPlain("bsh,ho->bso"), (input1, input2))
+
+        # the frozen constant operand is repacked at rewrite time into the
+        # layout the kernel permutes it into; results must be unchanged
+        weight = torch.randn(49, 8, 4, 32)
+        input1 = torch.randn(8, 4, 49, 32)
+        _test_fp32(EinsumConstOperand("bhid,jbhd->bhij", weight), (input1,))
+
     def test_ipex_softmax(self):
         self._test_output(
             AtenSoftmaxRepalce(), torch.rand(3, 4, 4), kind_in_graph="ipex::softmax"
@@ -5327,6 +5731,51 @@ class Tester(TestCase):
                 traced_y_outplace = traced_outplace(x)
                 self.assertEqual(y_outplace, traced_y_outplace)
 
+    def test_enable_inplace_add_gelu(self):
+        # the softmax makes the producer output inplace-able (see
+        # test_enable_inplace), the residual add should then write back
+        # into it instead of allocating a new buffer
+        class M_residual_inplace(nn.Module):
+            def forward(self, x, y):
+                x1 = nn.Softmax(dim=-1)(x)
+                return x1 + y
+
+        # the lhs broadcasts towards the rhs, so the result does not fit
+        # the lhs buffer and the add must stay outplace
+        class M_residual_outplace(nn.Module):
+            def forward(self, x, y):
+                x1 = nn.Softmax(dim=-1)(x)
+                return x1 + y
+
+        class M_gelu_inplace(nn.Module):
+            def forward(self, x):
+                x1 = nn.Softmax(dim=-1)(x)
+                return F.gelu(x1)
+
+        with torch.no_grad(), self._texpr_enable(False):
+            m = M_residual_inplace().eval()
+            x = torch.randn(1, 3, 16, 16)
+            y = torch.randn(1, 3, 16, 16)
+            traced = torch.jit.trace(m, (x, y))
+            trace_graph = traced.graph_for(x, y)
+            self.assertTrue(any(n.kind() == "aten::add_" for n in trace_graph.nodes()))
+            self.assertEqual(m(x, y), traced(x, y))
+
+            m = M_residual_outplace().eval()
+            x = torch.randn(16)
+            y = torch.randn(1, 3, 16, 16)
+            traced = torch.jit.trace(m, (x, y))
+            trace_graph = traced.graph_for(x, y)
+            self.assertTrue(any(n.kind() == "aten::add" for n in trace_graph.nodes()))
+            self.assertEqual(m(x, y), traced(x, y))
+
+            m = M_gelu_inplace().eval()
+            x = torch.randn(1, 3, 16, 16)
+            traced = torch.jit.trace(m, x)
+            trace_graph = traced.graph_for(x)
+            self.assertTrue(any(n.kind() == "aten::gelu_" for n in trace_graph.nodes()))
+            self.assertEqual(m(x), traced(x))
+
     @skipIfNoTorchVision
     def test_conv_torchvision_bn_folding(self):
         from torchvision.ops import misc as misc_nn_ops
@@ -160,6 +160,32 @@ class TestMergedEmbedding(TestCase):
                             dense = torch.randn(B, NUM_DIM, dtype=dtype)
                             self._test_inference(m, ref_m, (indices, offsets, dense))
 
+                            # test merged emb + cat fused with interaction
+                            weights = [emb.weight for emb in emb_list.list]
+                            with torch.no_grad():
+                                cat_out = (
+                                    torch.ops.torch_ipex.merged_embeddingbag_cat_forward(
+                                        weights, indices, offsets, dense
+                                    )
+                                )
+                                out = torch.ops.torch_ipex.merged_embeddingbag_interaction_forward(
+                                    weights, indices, offsets, dense
+                                )
+                            n_feature = NUM_TABLE + 1
+                            t = cat_out.double().reshape(B, n_feature, NUM_DIM)
+                            z = torch.bmm(t, t.transpose(1, 2))
+                            li, lj = torch.tril_indices(
+                                n_feature, n_feature, offset=-1
+                            )
+                            ref = torch.cat([dense.double(), z[:, li, lj]], dim=1)
+                            if dtype in (torch.bfloat16, torch.float16):
+                                rtol, atol = 0.02, 2.0
+                            elif dtype == torch.float32:
+                                rtol, atol = 1e-4, 0.1
+                            else:
+                                rtol, atol = 1e-10, 1e-8
+                            self.assertEqual(out.double(), ref, rtol=rtol, atol=atol)
+
     def test_training(self):
         B = 1029
         NUM_TABLE = 26
@@ -916,6 +916,152 @@ class TestFusedSteps(TestCase):
         self.assertEqual(exp_avg_sq, exp_avg_sq2)
         self.assertEqual(max_exp_avg_sq, max_exp_avg_sq2)
 
+    def test_adam_fused_step_list(self):
+        fused = torch.ops.torch_ipex.adam_fused_step
+        fused_list = torch.ops.torch_ipex.adam_fused_step_list
+
+        beta1 = 0.8
+        beta2 = 0.9
+        learning_rate = 0.1
+        weight_decay = 0.3
+        eps = 0.001
+        # mix of tiny and large tensors so the list kernel walks multiple
+        # chunks of some tensors and sub-chunk slices of others
+        shapes = [(3,), (31, 33), (7, 11, 13), (513,), (255, 255)]
+
+        for dtype in [torch.double, torch.float, torch.bfloat16]:
+            for amsgrad in [True, False]:
+                params, grads, exp_avgs, exp_avg_sqs, max_exp_avg_sqs = (
+                    [],
+                    [],
+                    [],
+                    [],
+                    [],
+                )
+                params2, steps = [], []
+                for i, shape in enumerate(shapes):
+                    params.append(torch.randn(shape).to(dtype=dtype))
+                    grads.append(torch.randn(shape).to(dtype=dtype))
+                    exp_avgs.append(torch.randn(shape).abs().float())
+                    exp_avg_sqs.append(torch.randn(shape).abs().float())
+                    if dtype == torch.double:
+                        exp_avgs[-1] = exp_avgs[-1].double()
+                        exp_avg_sqs[-1] = exp_avg_sqs[-1].double()
+                    if amsgrad:
+                        max_exp_avg_sqs.append(
+                            torch.randn(shape).abs().to(exp_avgs[-1].dtype)
+                        )
+                    else:
+                        max_exp_avg_sqs.append(
+                            torch.Tensor().to(exp_avgs[-1].dtype)
+                        )
+                    if dtype == torch.bfloat16:
+                        params2.append(torch.randn(shape).bfloat16())
+                    else:
+                        params2.append(torch.Tensor())
+                    # per-tensor step counts may differ within a group
+                    steps.append(10 + i)
+
+                # reference: one fused call per tensor
+                params_ref = [p.clone() for p in params]
+                exp_avgs_ref = [t.clone() for t in exp_avgs]
+                exp_avg_sqs_ref = [t.clone() for t in exp_avg_sqs]
+                max_exp_avg_sqs_ref = [t.clone() for t in max_exp_avg_sqs]
+                params2_ref = [t.clone() for t in params2]
+                for i in range(len(shapes)):
+                    fused(
+                        params_ref[i],
+                        exp_avgs_ref[i],
+                        exp_avg_sqs_ref[i],
+                        max_exp_avg_sqs_ref[i],
+                        grads[i],
+                        params2_ref[i],
+                        amsgrad,
+                        steps[i],
+                        beta1,
+                        beta2,
+                        learning_rate,
+                        weight_decay,
+                        eps,
+                    )
+
+                fused_list(
+                    params,
+                    exp_avgs,
+                    exp_avg_sqs,
+                    max_exp_avg_sqs,
+                    grads,
+                    params2,
+                    amsgrad,
+                    steps,
+                    beta1,
+                    beta2,
+                    learning_rate,
+                    weight_decay,
+                    eps,
+                )
+
+                for i in range(len(shapes)):
+                    self.assertEqual(params[i], params_ref[i])
+                    self.assertEqual(exp_avgs[i], exp_avgs_ref[i])
+                    self.assertEqual(exp_avg_sqs[i], exp_avg_sqs_ref[i])
+                    self.assertEqual(max_exp_avg_sqs[i], max_exp_avg_sqs_ref[i])
+                    self.assertEqual(params2[i], params2_ref[i])
+
+        # master weight case: fp32 param + bf16 grad + bf16 copy
+        params = [torch.randn(shape) for shape in shapes]
+        grads = [torch.randn(shape).bfloat16() for shape in shapes]
+        exp_avgs = [torch.randn(shape).abs() for shape in shapes]
+        exp_avg_sqs = [torch.randn(shape).abs() for shape in shapes]
+        max_exp_avg_sqs = [torch.randn(shape).abs() for shape in shapes]
+        params2 = [p.bfloat16() for p in params]
+        steps = [10 + i for i in range(len(shapes))]
+
+        params_ref = [p.clone() for p in params]
+        exp_avgs_ref = [t.clone() for t in exp_avgs]
+        exp_avg_sqs_ref = [t.clone() for t in exp_avg_sqs]
+        max_exp_avg_sqs_ref = [t.clone() for t in max_exp_avg_sqs]
+        params2_ref = [t.clone() for t in params2]
+        for i in range(len(shapes)):
+            fused(
+                params_ref[i],
+                exp_avgs_ref[i],
+                exp_avg_sqs_ref[i],
+                max_exp_avg_sqs_ref[i],
+                grads[i],
+                params2_ref[i],
+                True,
+                steps[i],
+                beta1,
+                beta2,
+                learning_rate,
+                weight_decay,
+                eps,
+            )
+
+        fused_list(
+            params,
+            exp_avgs,
+            exp_avg_sqs,
+            max_exp_avg_sqs,
+            grads,
+            params2,
+            True,
+            steps,
+            beta1,
+            beta2,
+            learning_rate,
+            weight_decay,
+            eps,
+        )
+
+        for i in range(len(shapes)):
+            self.assertEqual(params[i], params_ref[i])
+            self.assertEqual(exp_avgs[i], exp_avgs_ref[i])
+            self.assertEqual(exp_avg_sqs[i], exp_avg_sqs_ref[i])
+            self.assertEqual(max_exp_avg_sqs[i], max_exp_avg_sqs_ref[i])
+            self.assertEqual(params2[i], params2_ref[i])
+
     def test_adagrad_step(self):
         fused = torch.ops.torch_ipex.adagrad_fused_step
         non_fused = bench.custom_op_bench.optimizer.non_fused_adagrad
@@ -1045,6 +1191,97 @@ class TestFusedSteps(TestCase):
         self.assertEqual(param, param2)
         self.assertEqual(state_sum, state_sum2)
 
+    def test_adagrad_step_sparse(self):
+        # row-sparse grads (embedding tables) update only the touched rows;
+        # the result must match the dense fused step on the same grad
+        fused = torch.ops.torch_ipex.adagrad_fused_step
+        step = 10
+        learning_rate = 0.1
+        weight_decay = 0.0
+        lr_decay = 0.01
+        eps = 0.001
+
+        num_rows, emb_dim = 31, 33
+        values = torch.randn(8, emb_dim)
+        # duplicated row to exercise coalescing
+        indices = torch.tensor([[1, 3, 4, 7, 11, 20, 20, 30]])
+        sparse_grad = torch.sparse_coo_tensor(
+            indices, values, (num_rows, emb_dim)
+        )
+
+        # fp32 args
+        param = torch.randn(num_rows, emb_dim)
+        state_sum = torch.randn(num_rows, emb_dim).abs()
+        trail = torch.Tensor()
+
+        # dense reference: zero rows leave param and state_sum untouched
+        param2 = param.clone()
+        state_sum2 = state_sum.clone()
+
+        fused(
+            param,
+            sparse_grad,
+            state_sum,
+            trail,
+            step,
+            learning_rate,
+            weight_decay,
+            lr_decay,
+            eps,
+        )
+        fused(
+            param2,
+            sparse_grad.to_dense(),
+            state_sum2,
+            trail,
+            step,
+            learning_rate,
+            weight_decay,
+            lr_decay,
+            eps,
+        )
+
+        self.assertEqual(param, param2)
+        self.assertEqual(state_sum, state_sum2)
+
+        # bf16 args (master weight split)
+        param = torch.randn(num_rows, emb_dim)
+        state_sum = torch.randn(num_rows, emb_dim).abs()
+        param3, trail3 = torch.ops.torch_ipex.split_float_bfloat16(param)
+        state_sum3 = state_sum.clone()
+        param4, trail4 = torch.ops.torch_ipex.split_float_bfloat16(param)
+        state_sum4 = state_sum.clone()
+        sparse_grad_bf16 = torch.sparse_coo_tensor(
+            indices, values.bfloat16(), (num_rows, emb_dim)
+        )
+
+        fused(
+            param3,
+            sparse_grad_bf16,
+            state_sum3,
+            trail3,
+            step,
+            learning_rate,
+            weight_decay,
+            lr_decay,
+            eps,
+        )
+        fused(
+            param4,
+            sparse_grad_bf16.to_dense(),
+            state_sum4,
+            trail4,
+            step,
+            learning_rate,
+            weight_decay,
+            lr_decay,
+            eps,
+        )
+
+        self.assertEqual(param3, param4)
+        self.assertEqual(trail3, trail4)
+        self.assertEqual(state_sum3, state_sum4)
+
     def test_sgd_step(self):
         fused = torch.ops.torch_ipex.sgd_fused_step
         non_fused = bench.custom_op_bench.optimizer.non_fused_sgd
@@ -1229,6 +1466,31 @@ class TestFusedSteps(TestCase):
         grad2 = base_grad.bfloat16()[10:20, 10:20]
         self._test_packed_add(param, grad, param2, trail, grad2)
 
+    def test_packed_add_fp32_grad(self):
+        # FP32 grads accumulate straight into the (bf16, trail) pair, without
+        # a separate FP32 gradient buffer; the split pair holds the full FP32
+        # value so the result matches the plain FP32 update exactly
+        packed_add = torch.ops.torch_ipex.packed_add
+        learning_rate = 0.1
+
+        # dense case
+        param = torch.randn(31, 33)
+        grad = torch.randn(31, 33)
+        param2, trail = torch.ops.torch_ipex.split_float_bfloat16(param)
+        param.add_(grad, alpha=-learning_rate)
+        packed_add(param2, trail, grad, -learning_rate)
+        self.assertEqual(param, param2.float())
+
+        # sparse case
+        param = torch.randn(31, 33)
+        values = torch.randn(8, 33)
+        indices = torch.tensor([[1, 3, 4, 7, 11, 20, 25, 30]])
+        sparse_grad = torch.sparse_coo_tensor(indices, values, (31, 33))
+        param2, trail = torch.ops.torch_ipex.split_float_bfloat16(param)
+        param.add_(sparse_grad.to_dense(), alpha=-learning_rate)
+        packed_add(param2, trail, sparse_grad, -learning_rate)
+        self.assertEqual(param, param2.float())
+
 
 class TestPatchedMethod(TestCase):
     def test_zero_grad(self):
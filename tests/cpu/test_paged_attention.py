@@ -224,6 +224,115 @@ class PagedAttentionTest(TestCase):
                 seed,
             )
 
+    def _test_paged_attention_bias_func(
+        self,
+        num_seqs: int,
+        num_head: Tuple[int, int],
+        head_size: int,
+        num_blocks: int,
+        block_size: int,
+        dtype: torch.dtype,
+        seed: int,
+    ) -> None:
+        random.seed(seed)
+        torch.random.manual_seed(seed)
+        torch.manual_seed(seed)
+        max_seq_len = 512
+        scale = float(1.0 / (head_size**0.5))
+        num_query_heads, num_kv_head = num_head
+        query = torch.empty(
+            num_seqs, num_query_heads, head_size, dtype=dtype, device="cpu"
+        )
+        query.uniform_(-scale, scale)
+        assert num_query_heads % num_kv_head == 0
+        num_queries_per_kv = num_query_heads // num_kv_head
+        head_mapping = torch.repeat_interleave(
+            torch.arange(num_kv_head, dtype=torch.int32, device="cpu"),
+            num_queries_per_kv,
+        )
+
+        context_lens = [random.randint(1, max_seq_len) for _ in range(num_seqs)]
+        context_lens[-1] = max_seq_len
+        max_context_len = max(context_lens)
+        context_lens = torch.tensor(context_lens, dtype=torch.int, device="cpu")
+
+        max_num_blocks_per_seq = (max_context_len + block_size - 1) // block_size
+        block_tables = []
+        for _ in range(num_seqs):
+            block_table = [
+                random.randint(0, num_blocks - 1) for _ in range(max_num_blocks_per_seq)
+            ]
+            block_tables.append(block_table)
+        block_tables = torch.tensor(block_tables, dtype=torch.int, device="cpu")
+
+        key_caches, value_caches = self.create_kv_caches(
+            num_blocks, block_size, 1, num_kv_head, head_size, dtype, seed
+        )
+        key_cache, value_cache = key_caches[0], value_caches[0]
+
+        # Learned relative-position bias tile, [num_heads, max_context_len],
+        # indexed by the key token's distance from the current query token
+        # (T5-style relative attention bias pre-tiled at cache setup).
+        attn_bias = torch.randn(
+            num_query_heads, max_context_len, dtype=torch.float, device="cpu"
+        )
+
+        output = torch.empty_like(query)
+        torch.ops.torch_ipex.single_query_cached_kv_attention_bias(
+            output,
+            query,
+            key_cache,
+            value_cache,
+            head_mapping,
+            scale,
+            block_tables,
+            context_lens,
+            block_size,
+            max_context_len,
+            attn_bias,
+        )
+
+        # Reference: bias for key position j of a sequence with context_len
+        # tokens is tile[h, context_len - 1 - j].
+        ref_output = torch.empty_like(query)
+        block_tables_list = block_tables.cpu().tolist()
+        context_lens_list = context_lens.cpu().tolist()
+        for i in range(num_seqs):
+            q = query[i].unsqueeze(0)
+            block_table = block_tables_list[i]
+            context_len = int(context_lens_list[i])
+
+            keys = []
+            values = []
+            for j in range(context_len):
+                block_number = int(block_table[j // block_size])
+                block_offset = j % block_size
+                keys.append(
+                    key_cache[block_number, block_offset, :, :].reshape(
+                        num_kv_head, head_size
+                    )
+                )
+                values.append(value_cache[block_number, block_offset, :, :])
+            keys = torch.stack(keys, dim=0)
+            values = torch.stack(values, dim=0)
+            if num_queries_per_kv > 1:
+                keys = torch.repeat_interleave(keys, num_queries_per_kv, dim=1)
+                values = torch.repeat_interleave(values, num_queries_per_kv, dim=1)
+            rel = torch.arange(context_len - 1, -1, -1, device="cpu")
+            bias = attn_bias[:, rel].view(num_query_heads, 1, context_len)
+            out = self.ref_masked_attention(q, keys, values, scale, bias)
+            ref_output[i].copy_(out.view(num_query_heads, head_size))
+        assert torch.allclose(output, ref_output, atol=5e-3, rtol=1e-3)
+
+    def test_paged_attention_bias(self):
+        num_blocks = 128
+        for num_head, block_size, dtype in product(
+            [(40, 40), (64, 16)], [16, 32], [torch.bfloat16, torch.float]
+        ):
+            self._test_paged_attention_bias_func(
+                7, num_head, 64, num_blocks, block_size, dtype, 0
+            )
+
     def _test_reshape_and_cache_func(
         self,
         num_token: int,
@@ -300,6 +409,73 @@ class PagedAttentionTest(TestCase):
                 num_token, num_kv_head, head_size, block_size, num_blocks, dtype, seed
             )
 
+    def test_kv_cache_fork(self):
+        torch.random.manual_seed(0)
+        num_blocks = 16
+        block_size = 4
+        num_seqs = 3
+        max_blocks_per_seq = 4
+        key_cache = torch.randn(num_blocks, block_size, 8, 16)
+        value_cache = torch.randn(num_blocks, block_size, 8, 16)
+        block_tables = torch.zeros(
+            num_seqs, max_blocks_per_seq, dtype=torch.int
+        )
+        context_lens = torch.zeros(num_seqs, dtype=torch.int)
+        ref_counts = torch.zeros(num_blocks, dtype=torch.int)
+        # seq 0 owns blocks 1 and 2 with 6 tokens (block 2 half full)
+        block_tables[0, 0] = 1
+        block_tables[0, 1] = 2
+        context_lens[0] = 6
+        ref_counts[1] = 1
+        ref_counts[2] = 1
+
+        # fork is metadata only: shared table row, bumped refcounts
+        torch.ops.torch_ipex.kv_cache_fork(
+            block_tables, context_lens, ref_counts, 0, 1, block_size
+        )
+        self.assertEqual(block_tables[1], block_tables[0])
+        self.assertEqual(int(context_lens[1]), 6)
+        self.assertEqual(int(ref_counts[1]), 2)
+        self.assertEqual(int(ref_counts[2]), 2)
+
+        # appending to the forked seq copies only the shared partial block
+        key_orig = key_cache.clone()
+        used = torch.ops.torch_ipex.kv_cache_maybe_copy_on_write(
+            block_tables, context_lens, ref_counts, key_cache, value_cache, 1, block_size, 7
+        )
+        self.assertTrue(used)
+        self.assertEqual(int(block_tables[1, 1]), 7)
+        self.assertEqual(int(block_tables[0, 1]), 2)
+        self.assertEqual(int(ref_counts[2]), 1)
+        self.assertEqual(int(ref_counts[7]), 1)
+        self.assertEqual(key_cache[7], key_orig[2])
+        self.assertEqual(key_cache[2], key_orig[2])
+
+        # now exclusive: a second append needs no copy
+        used = torch.ops.torch_ipex.kv_cache_maybe_copy_on_write(
+            block_tables, context_lens, ref_counts, key_cache, value_cache, 1, block_size, 8
+        )
+        self.assertFalse(used)
+        # a boundary append goes to a fresh block, never a copy
+        context_lens[0] = 8
+        used = torch.ops.torch_ipex.kv_cache_maybe_copy_on_write(
+            block_tables, context_lens, ref_counts, key_cache, value_cache, 0, block_size, 8
+        )
+        self.assertFalse(used)
+
+        # releasing the fork frees only its exclusive block
+        freed = torch.ops.torch_ipex.kv_cache_release(
+            block_tables, context_lens, ref_counts, 1, block_size
+        )
+        self.assertEqual(freed.tolist(), [7])
+        self.assertEqual(int(ref_counts[1]), 1)
+        self.assertEqual(int(context_lens[1]), 0)
+        # releasing the parent frees the rest
+        freed = torch.ops.torch_ipex.kv_cache_release(
+            block_tables, context_lens, ref_counts, 0, block_size
+        )
+        self.assertEqual(freed.tolist(), [1, 2])
+
 
 if __name__ == "__main__":
     test = unittest.main()
@@ -45,6 +45,46 @@ class RMSNormTester(TestCase):
                 y1_bf16 = model(x_bf16)
                 fused_y1_bf16 = model(x_bf16, fused_rmsnorm=True)
                 self.assertEqual(y1_bf16, fused_y1_bf16, prec=1e-2)
+                x_fp16 = x.to(torch.half)
+                y1_fp16 = model(x_fp16)
+                fused_y1_fp16 = model(x_fp16, fused_rmsnorm=True)
+                self.assertEqual(y1_fp16, fused_y1_fp16, prec=1e-2)
+                # fp16 weight as well, as created by a model converted with
+                # model.half()
+                model_fp16 = RMSNorm(input_size).half().eval()
+                y2_fp16 = model_fp16(x_fp16)
+                fused_y2_fp16 = model_fp16(x_fp16, fused_rmsnorm=True)
+                self.assertEqual(y2_fp16, fused_y2_fp16, prec=1e-2)
+
+    def test_RMSNorm_quant(self):
+        hidden_size = 67  # odd size to exercise the vectorized tail
+        model = RMSNorm(hidden_size).eval()
+        scale, zero_points = 0.04, 2
+        with torch.no_grad():
+            for dtype in [torch.float32, torch.bfloat16]:
+                for smooth in [None, torch.rand(hidden_size) + 0.5]:
+                    x = torch.randn(4, 10, hidden_size).to(dtype)
+                    ref = model(x).to(torch.float32)
+                    if smooth is not None:
+                        ref = ref * smooth
+                    for qdtype in [torch.qint8, torch.quint8]:
+                        zp = zero_points if qdtype == torch.qint8 else 128
+                        y_ref = torch.quantize_per_tensor(ref, scale, zp, qdtype)
+                        y = torch.ops.torch_ipex.rmsnorm_quant(
+                            x,
+                            model.weight,
+                            model.variance_epsilon,
+                            smooth,
+                            scale,
+                            zp,
+                            qdtype,
+                        )
+                        self.assertEqual(y.dtype, qdtype)
+                        # compare in the dequantized domain; allow one ulp
+                        # of scale for rounding differences off fp32
+                        self.assertEqual(
+                            y.dequantize(), y_ref.dequantize(), prec=scale + 1e-2
+                        )
 
 
 if __name__ == "__main__":
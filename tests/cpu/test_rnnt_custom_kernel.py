@@ -249,6 +249,27 @@ class TestRNNTEmbedding(TestCase):
 
             self.assertEqual(y_embed_org, y_embed)
 
+    def test_rnnt_embedding_batched(self):
+        self._SOS = -1
+        for dtype in [torch.float, torch.bfloat16]:
+            vocab_size = 29
+            pred_n_hidden = 320
+            embedding = torch.nn.Embedding(vocab_size - 1, pred_n_hidden).to(dtype)
+            # whole beam at once: [batch_size, beam_width] with SOS mixed in
+            y_org = torch.tensor(
+                [[-1, 2, 15, -1, 5], [7, -1, 0, 27, 3], [-1, -1, -1, -1, -1]],
+                dtype=torch.long,
+            )
+
+            y = copy.deepcopy(y_org)
+
+            y_embed_org = self._test_org(y_org, embedding)
+            y_embed = torch.ops.torch_ipex.rnnt_embedding_batched(
+                embedding.weight, y, self._SOS
+            )
+
+            self.assertEqual(y_embed_org, y_embed)
+
 
 if __name__ == "__main__":
     test = unittest.main()
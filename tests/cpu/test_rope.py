@@ -22,6 +22,38 @@ class FusedROPETester(TestCase):
         ).float()
         return torch.cat((torch.sin(sinusoid_inp), torch.cos(sinusoid_inp)), dim=1)
 
+    def test_rope_scaling_table(self):
+        rotary_dim = 64
+        base = 10000.0
+        orig_max = 2048
+        none_table = torch.ops.torch_ipex.rotary_sincos_table(
+            orig_max, rotary_dim, base, "none", 1.0, orig_max
+        )
+        self.assertEqual(
+            none_table, self.create_sinusoidal_positions(none_table.size(0), rotary_dim)
+        )
+        # linear scaling: position p rotates like unscaled position p/factor
+        factor = 4.0
+        linear_table = torch.ops.torch_ipex.rotary_sincos_table(
+            orig_max * 4, rotary_dim, base, "linear", factor, orig_max
+        )
+        self.assertEqual(linear_table[4], none_table[1], prec=1e-6)
+        for scaling in ["dynamic", "yarn"]:
+            table = torch.ops.torch_ipex.rotary_sincos_table(
+                orig_max * 4, rotary_dim, base, scaling, factor, orig_max
+            )
+            self.assertTrue(table.size(0) >= orig_max * 4)
+            self.assertEqual(table.size(1), rotary_dim)
+            # sin^2 + cos^2 stays on the (attention-scaled) unit circle
+            norm = table[:, : rotary_dim // 2] ** 2 + table[:, rotary_dim // 2 :] ** 2
+            self.assertEqual(norm, torch.full_like(norm, norm[0][0]), prec=1e-4)
+        # cache is lazily extended: asking longer returns a larger table
+        longer = torch.ops.torch_ipex.rotary_sincos_table(
+            orig_max * 8, rotary_dim, base, "linear", factor, orig_max
+        )
+        self.assertTrue(longer.size(0) >= orig_max * 8)
+        self.assertEqual(longer[: linear_table.size(0)], linear_table)
+
     def test_rope(self):
         def _get_embed_positions(embed_positions, position_ids):
             if embed_positions.device != position_ids.device:
@@ -97,6 +97,27 @@ class TestCPUPool(TestCase):
         cpu_pool = ipex.cpu.runtime.CPUPool(core_list)
         self.assertEqual(cpu_pool.cpu_pool.get_core_list(), core_list)
 
+    def test_parse_cpu_list(self):
+        self.assertEqual(ipex.cpu.runtime.parse_cpu_list("0-3"), [0, 1, 2, 3])
+        self.assertEqual(
+            ipex.cpu.runtime.parse_cpu_list("0-2,8,12-13\n"), [0, 1, 2, 8, 12, 13]
+        )
+        self.assertEqual(ipex.cpu.runtime.parse_cpu_list("5"), [5])
+
+    @unittest.skipIf(
+        not (
+            ipex.cpu.runtime.is_runtime_ext_enabled()
+            and os.path.exists("/sys/devices/cpu_core/cpus")
+        ),
+        "Skip when the platform does not expose hybrid core classes",
+    )
+    def test_cpupool_core_type(self):
+        cpu_pool = ipex.cpu.runtime.CPUPool(core_type="performance")
+        self.assertEqual(
+            cpu_pool.core_ids,
+            ipex.cpu.runtime.get_core_list_of_core_type("performance"),
+        )
+
 
 class TestCoreBinding(TestCase):
     @unittest.skipIf(
@@ -641,6 +662,79 @@ class TestModuleMultiStreamModuleHint(TestCase):
         self.assertEqual(y_ref, y_runtime_res)
 
 
+class TestParallelModule(TestCase):
+    @unittest.skipIf(
+        not ipex.cpu.runtime.is_runtime_ext_enabled(),
+        "Skip when IPEX Runtime extension is not enabled",
+    )
+    def test_weighted_core_allocation(self):
+        core_list = [0, 1, 2, 3, 4, 5]
+        # Equal weights: equal disjoint slices.
+        allocation = ipex.cpu.runtime.get_weighted_core_allocation(core_list, [1, 1])
+        self.assertEqual(allocation, [[0, 1, 2], [3, 4, 5]])
+        # Weighted: the heavier branch gets more cores, but every branch
+        # gets at least one core.
+        allocation = ipex.cpu.runtime.get_weighted_core_allocation(
+            core_list, [1, 100, 1]
+        )
+        self.assertEqual(allocation[0].__len__(), 1)
+        self.assertEqual(allocation[1].__len__(), 4)
+        self.assertEqual(allocation[2].__len__(), 1)
+        self.assertEqual([c for cores in allocation for c in cores], core_list)
+
+    @unittest.skipIf(
+        not ipex.cpu.runtime.is_runtime_ext_enabled(),
+        "Skip when IPEX Runtime extension is not enabled",
+    )
+    @runtime_thread_affinity_test_env
+    def test_parallel_module_imperative_model(self):
+        branch1 = SimpleNet()
+        branch1.eval()
+        branch2 = SimpleNet_v2()
+        branch2.eval()
+        x1 = torch.rand(64, 64, 3, 3)
+        x2 = torch.rand(64, 3, 28, 28)
+        # Calculate the reference result
+        y1 = branch1(x1)
+        y2 = branch2(x2)
+
+        cpu_pool = ipex.cpu.runtime.CPUPool(node_id=0)
+        model = ipex.cpu.runtime.ParallelModule([branch1, branch2], cpu_pool)
+        y1_runtime, y2_runtime = model((x1,), (x2,))
+        self.assertEqual(y1, y1_runtime)
+        self.assertEqual(y2, y2_runtime)
+
+    @unittest.skipIf(
+        not ipex.cpu.runtime.is_runtime_ext_enabled(),
+        "Skip when IPEX Runtime extension is not enabled",
+    )
+    @runtime_thread_affinity_test_env
+    def test_parallel_module_jit_model_with_calibration(self):
+        branch1 = SimpleNet()
+        branch1.eval()
+        branch2 = SimpleNet_v2()
+        branch2.eval()
+        x1 = torch.rand(64, 64, 3, 3)
+        x2 = torch.rand(64, 3, 28, 28)
+        branch1 = torch.jit.trace(branch1, x1).eval()
+        branch1 = torch.jit.freeze(branch1)
+        branch2 = torch.jit.trace(branch2, x2).eval()
+        branch2 = torch.jit.freeze(branch2)
+        # Calculate the reference result
+        y1 = branch1(x1)
+        y2 = branch2(x2)
+
+        weights = ipex.cpu.runtime.calibrate_branch_weights(
+            [branch1, branch2], [(x1,), (x2,)]
+        )
+        self.assertEqual(weights.__len__(), 2)
+        cpu_pool = ipex.cpu.runtime.CPUPool(node_id=0)
+        model = ipex.cpu.runtime.ParallelModule([branch1, branch2], cpu_pool, weights)
+        y1_runtime, y2_runtime = model((x1,), (x2,))
+        self.assertEqual(y1, y1_runtime)
+        self.assertEqual(y2, y2_runtime)
+
+
 def is_numactl_available():
     numactl_available = False
     cmd = ["numactl", "-C", "0", "-m", "0", "ls"]
@@ -21,3 +21,22 @@ class ToolkitTester(TestCase):
         self.assertEqual(roc_auc_st, roc_auc_mt)
         self.assertEqual(roc_auc_st, roc_auc_mt_2)
         self.assertEqual(accuracy_st, accuracy_mt)
+
+    def test_multi_thread_sklearn_metric_eval_roc_auc_score_approx(self):
+        targets = np.random.randint(0, 2, size=1000)
+        scores = torch.rand(1000)
+        roc_auc_st = sklearn.metrics.roc_auc_score(targets, scores.numpy())
+        # with enough bins the histogram approximation converges to the
+        # exact score; tolerance covers the same-bin tie averaging
+        roc_auc_approx = ipex._C.roc_auc_score_approx(
+            torch.Tensor(targets), scores, 2**20
+        )
+        self.assertEqual(roc_auc_st, roc_auc_approx, prec=1e-3)
+        # ties within a bin fall back to the averaged-rank convention,
+        # so scores quantized to the bin grid are scored exactly
+        quantized = torch.round(scores * 64) / 64
+        roc_auc_q_st = sklearn.metrics.roc_auc_score(targets, quantized.numpy())
+        roc_auc_q = ipex._C.roc_auc_score_approx(
+            torch.Tensor(targets), quantized, 2**20
+        )
+        self.assertEqual(roc_auc_q_st, roc_auc_q, prec=1e-3)
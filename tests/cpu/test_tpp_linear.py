@@ -56,6 +56,24 @@ class Linear_Gate_Up(torch.nn.Module):
         return torch.nn.functional.silu(self.gate_proj(x)) * self.up_proj(x)
 
 
+class Gated_MLP_Block(torch.nn.Module):
+    def __init__(self, in_feature, hidden_feature, bias):
+        super(Gated_MLP_Block, self).__init__()
+        self.ln_weight = torch.nn.Parameter(torch.ones(in_feature))
+        self.eps = 1e-6
+        self.gate_proj = torch.nn.Linear(in_feature, hidden_feature, bias=bias)
+        self.up_proj = torch.nn.Linear(in_feature, hidden_feature, bias=bias)
+        self.down_proj = torch.nn.Linear(hidden_feature, in_feature, bias=bias)
+
+    def forward(self, x):
+        variance = x.to(torch.float32).pow(2).mean(-1, keepdim=True)
+        h = (x.to(torch.float32) * torch.rsqrt(variance + self.eps)).to(x.dtype)
+        h = self.ln_weight * h
+        return x + self.down_proj(
+            torch.nn.functional.silu(self.gate_proj(h)) * self.up_proj(h)
+        )
+
+
 class Linear_relu(torch.nn.Module):
     def __init__(self):
         super(Linear_relu, self).__init__()
@@ -185,6 +203,54 @@ class TestTPPlinear(TestCase):
                 self.assertEqual(out, ref_out)
                 _disable_tpp()
 
+    def test_tpp_fused_mlp_block(self):
+        in_feature = 64
+        hidden_feature = 128
+
+        x = torch.randn(1, 4, in_feature)
+        x_tpp = copy.deepcopy(x)
+
+        with torch.no_grad():
+            for dtype, bias in itertools.product(
+                [torch.float, torch.bfloat16], [False, True]
+            ):
+                model = Gated_MLP_Block(in_feature, hidden_feature, bias).eval()
+                if dtype == torch.bfloat16:
+                    x = x.to(torch.bfloat16)
+                    x_tpp = x_tpp.to(torch.bfloat16)
+                    model = model.to(torch.bfloat16)
+                ref_out = model(x)
+
+                _enable_tpp()
+                model = ipex.optimize(model, dtype=dtype)
+                out = torch.ops.torch_ipex.tpp_fused_mlp_block(
+                    x_tpp,
+                    model.ln_weight,
+                    model.eps,
+                    model.gate_proj.weight,
+                    model.gate_proj.bias,
+                    model.up_proj.weight,
+                    model.up_proj.bias,
+                    model.down_proj.weight,
+                    model.down_proj.bias,
+                )
+
+                normed = torch.ops.torch_ipex.rmsnorm(
+                    x_tpp, model.ln_weight, model.eps
+                )
+                out_tpp_ref = x_tpp + torch.ops.torch_ipex.tpp_fused_gated_mlp(
+                    normed,
+                    model.gate_proj.weight,
+                    model.gate_proj.bias,
+                    model.up_proj.weight,
+                    model.up_proj.bias,
+                    model.down_proj.weight,
+                    model.down_proj.bias,
+                )
+                self.assertEqual(out, out_tpp_ref)
+                self.assertEqual(out, ref_out, prec=1e-2)
+                _disable_tpp()
+
     def test_tpp_linear_gelu(self):
         x1 = torch.rand(1, 4, 4096)
         x2 = copy.deepcopy(x1)
@@ -245,6 +311,41 @@ class TestTPPlinear(TestCase):
                 self.assertEqual(out, ref_out)
                 _disable_tpp()
 
+    def test_tpp_linear_argmax(self):
+        # greedy-decode epilogue: must match argmax over the fused linear's
+        # own logits exactly, with and without bias
+        x1 = torch.rand(2, 3, 4096)
+        x2 = copy.deepcopy(x1)
+        with torch.no_grad():
+            for dtype in [torch.float, torch.bfloat16]:
+                model = Linear_with_bias().eval()
+                model_nb = Linear_without_bias().eval()
+                if dtype is torch.bfloat16:
+                    x1 = x1.to(torch.bfloat16)
+                    x2 = x2.to(torch.bfloat16)
+                    model = model.to(torch.bfloat16)
+                    model_nb = model_nb.to(torch.bfloat16)
+
+                _enable_tpp()
+                model = ipex.optimize(model, dtype=dtype)
+                model_nb = ipex.optimize(model_nb, dtype=dtype)
+                ref_out = torch.ops.torch_ipex.tpp_linear_bias(
+                    x1, model.mlp.weight, model.mlp.bias
+                ).argmax(dim=-1)
+                ref_out_nb = torch.ops.torch_ipex.tpp_linear(
+                    x1, model_nb.mlp.weight
+                ).argmax(dim=-1)
+                out = torch.ops.torch_ipex.tpp_linear_argmax(
+                    x2, model.mlp.weight, model.mlp.bias
+                )
+                out_nb = torch.ops.torch_ipex.tpp_linear_argmax(
+                    x2, model_nb.mlp.weight, x2.new_empty(0)
+                )
+                self.assertEqual(out.dtype, torch.int64)
+                self.assertEqual(out, ref_out)
+                self.assertEqual(out_nb, ref_out_nb)
+                _disable_tpp()
+
     def test_tpp_linear_mul(self):
         x1 = torch.rand(1, 4, 4096)
         x2 = copy.deepcopy(x1)